@@ -386,6 +386,9 @@ void Discreet3DSImporter::ConvertMeshes(aiScene* pcOut)
 
 			// allocate enough storage for faces
 			meshOut->mFaces = new aiFace[meshOut->mNumFaces];
+			if (bSharedFaceIndices) {
+				meshOut->mFaceIndices = new unsigned int[meshOut->mNumVertices];
+			}
 			iFaceCnt += meshOut->mNumFaces;
 
 			meshOut->mVertices = new aiVector3D[meshOut->mNumVertices];
@@ -399,7 +402,7 @@ void Discreet3DSImporter::ConvertMeshes(aiScene* pcOut)
 				register unsigned int index = aiSplit[p][q];
 				aiFace& face = meshOut->mFaces[q];
 
-				face.mIndices = new unsigned int[3];
+				face.mIndices = meshOut->mFaceIndices ? meshOut->mFaceIndices + base : new unsigned int[3];
 				face.mNumIndices = 3;
 
 				for (unsigned int a = 0; a < 3;++a,++base)
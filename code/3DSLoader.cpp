@@ -96,6 +96,7 @@ static const aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 Discreet3DSImporter::Discreet3DSImporter()
+: bSharedFaceIndices()
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -130,9 +131,9 @@ const aiImporterDesc* Discreet3DSImporter::GetInfo () const
 
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties
-void Discreet3DSImporter::SetupProperties(const Importer* /*pImp*/)
+void Discreet3DSImporter::SetupProperties(const Importer* pImp)
 {
-	// nothing to be done for the moment
+	bSharedFaceIndices = pImp->GetPropertyInteger(AI_CONFIG_GLOB_SHARED_FACE_INDICES,0) != 0;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -269,6 +269,9 @@ protected:
 
 	/** true if PRJ file */
 	bool bIsPrj;
+
+	/** Store the face indices in a single array per mesh */
+	bool bSharedFaceIndices;
 };
 
 } // end of namespace Assimp
@@ -154,6 +154,13 @@ const aiImporterDesc* AC3DImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Files start with one of these tokens
+void AC3DImporter::GetMagicTokens (std::vector<uint32_t>& tokens) const
+{
+	tokens.push_back(AI_MAKE_MAGIC("AC3D"));
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get a pointer to the next line from the file
 bool AC3DImporter::GetNextLine( )
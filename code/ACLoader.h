@@ -187,6 +187,11 @@ protected:
 	 * See #BaseImporter::GetInfo for the details */
 	const aiImporterDesc* GetInfo () const;
 
+	// -------------------------------------------------------------------
+	/** Return the tokens at the start of files in this format.
+	 * See #BaseImporter::GetMagicTokens for the details */
+	void GetMagicTokens (std::vector<uint32_t>& tokens) const;
+
 	// -------------------------------------------------------------------
 	/** Imports the given file into the given scene structure. 
 	 * See BaseImporter::InternReadFile() for details*/
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "StringComparison.h"
 #include "SkeletonMeshBuilder.h"
 #include "TargetAnimation.h"
+#include "ParallelFor.h"
 
 // utilities
 #include "fast_atof.h"
@@ -74,6 +75,10 @@ static const aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ASEImporter::ASEImporter()
+: configRecomputeNormals()
+, configThreads(1)
+, configParallelThreshold(AI_PARALLEL_DEFAULT_THRESHOLD)
+, configParallelChunk(AI_PARALLEL_DEFAULT_CHUNK)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -111,6 +116,10 @@ void ASEImporter::SetupProperties(const Importer* pImp)
 {
 	configRecomputeNormals = (pImp->GetPropertyInteger(
 		AI_CONFIG_IMPORT_ASE_RECONSTRUCT_NORMALS,1) ? true : false);
+
+	configThreads = GetWorkerThreadCount(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,-1));
+	configParallelThreshold = pImp->GetPropertyInteger(AI_CONFIG_GLOB_PARALLEL_THRESHOLD,AI_PARALLEL_DEFAULT_THRESHOLD);
+	configParallelChunk = std::max(1,pImp->GetPropertyInteger(AI_CONFIG_GLOB_PARALLEL_CHUNK,AI_PARALLEL_DEFAULT_CHUNK));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -150,7 +159,7 @@ void ASEImporter::InternReadFile( const std::string& pFile,
 	};
 
 	// Construct an ASE parser and parse the file
-	ASE::Parser parser(mBuffer,defaultFormat);
+	ASE::Parser parser(mBuffer,defaultFormat,configThreads,configParallelThreshold,configParallelChunk);
 	mParser = &parser;
 	mParser->Parse();
 
@@ -197,6 +197,14 @@ protected:
 	/** Config options: Recompute the normals in every case - WA
 	    for 3DS Max broken ASE normal export */
 	bool configRecomputeNormals;
+
+	/** Config options: number of threads to parse with */
+	unsigned int configThreads;
+
+	/** Config options: minimum number of faces to parse them in
+	 *  parallel and number of faces per job */
+	unsigned int configParallelThreshold;
+	unsigned int configParallelChunk;
 };
 
 } // end of namespace Assimp
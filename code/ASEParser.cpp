@@ -51,10 +51,168 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ASELoader.h"
 #include "MaterialSystem.h"
 #include "fast_atof.h"
+#include "ParallelFor.h"
 
 using namespace Assimp;
 using namespace Assimp::ASE;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Parse a *MESH_FACE element. Returns NULL on success, a warning message otherwise.
+const char* ParseMeshFace(const char* filePtr, ASE::Face& out)
+{	
+	// skip spaces and tabs
+	if(!SkipSpaces(&filePtr))
+	{
+		return "Unable to parse *MESH_FACE Element: Unexpected EOL [#1]";
+	}
+
+	// parse the face index
+	out.iFace = strtoul10(filePtr,&filePtr);
+
+	// next character should be ':'
+	if(!SkipSpaces(&filePtr))
+	{
+		// FIX: there are some ASE files which haven't got : here ....
+		return "Unable to parse *MESH_FACE Element: Unexpected EOL. \':\' expected [#2]";
+	}
+	// FIX: There are some ASE files which haven't got ':' here 
+	if(':' == *filePtr)++filePtr;
+
+	// Parse all mesh indices
+	for (unsigned int i = 0; i < 3;++i)
+	{
+		unsigned int iIndex = 0;
+		if(!SkipSpaces(&filePtr))
+		{
+			return "Unable to parse *MESH_FACE Element: Unexpected EOL";
+		}
+		switch (*filePtr)
+		{
+		case 'A':
+		case 'a':
+			break;
+		case 'B':
+		case 'b':
+			iIndex = 1;
+			break;
+		case 'C':
+		case 'c':
+			iIndex = 2;
+			break;
+		default: 
+			return "Unable to parse *MESH_FACE Element: Unexpected EOL. "
+				"A,B or C expected [#3]";
+		};
+		++filePtr;
+
+		// next character should be ':'
+		if(!SkipSpaces(&filePtr) || ':' != *filePtr)
+		{
+			return "Unable to parse *MESH_FACE Element: "
+				"Unexpected EOL. \':\' expected [#2]";
+		}
+
+		++filePtr;
+		if(!SkipSpaces(&filePtr))
+		{
+			return "Unable to parse *MESH_FACE Element: Unexpected EOL. "
+				"Vertex index ecpected [#4]";
+		}
+		out.mIndices[iIndex] = strtoul10(filePtr,&filePtr);
+	}
+
+	// now we need to skip the AB, BC, CA blocks. 
+	while (true)
+	{
+		if ('*' == *filePtr)break;
+		if (IsLineEnd(*filePtr))
+		{
+			return NULL;
+		}
+		filePtr++;
+	}
+
+	// parse the smoothing group of the face
+	if (TokenMatch(filePtr,"*MESH_SMOOTHING",15))
+	{
+		if(!SkipSpaces(&filePtr))
+		{
+			return "Unable to parse *MESH_SMOOTHING Element: "
+				"Unexpected EOL. Smoothing group(s) expected [#5]";
+		}
+		
+		// Parse smoothing groups until we don't anymore see commas
+		// FIX: There needn't always be a value, sad but true
+		while (true)
+		{
+			if (*filePtr < '9' && *filePtr >= '0')
+			{
+				out.iSmoothGroup |= (1 << strtoul10(filePtr,&filePtr));
+			}
+			SkipSpaces(&filePtr);
+			if (',' != *filePtr)
+			{
+				break;
+			}
+			++filePtr;
+			SkipSpaces(&filePtr);
+		}
+	}
+
+	// *MESH_MTLID  is optional, too
+	while (true)
+	{
+		if ('*' == *filePtr)break;
+		if (IsLineEnd(*filePtr))
+		{
+			return NULL;
+		}
+		filePtr++;
+	}
+
+	if (TokenMatch(filePtr,"*MESH_MTLID",11))
+	{
+		if(!SkipSpaces(&filePtr))
+		{
+			return "Unable to parse *MESH_MTLID Element: Unexpected EOL. "
+				"Material index expected [#6]";
+		}
+		out.iMaterial = strtoul10(filePtr,&filePtr);
+	}
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Parses one chunk of *MESH_FACE elements per job. Each element writes to its
+ *  own face, so the jobs can run in parallel. */
+class FaceJob
+{
+public:
+	FaceJob(std::vector<FaceRecord>& records, std::vector<ASE::Face>& faces, unsigned int chunk)
+		: records(records), faces(faces), chunk(chunk)
+	{}
+
+	unsigned int GetCount() const {
+		return static_cast<unsigned int>((records.size() + chunk - 1) / chunk);
+	}
+
+	void operator() (unsigned int i) {
+		const size_t end = std::min(records.size(),static_cast<size_t>(i+1)*chunk);
+		for (size_t n = static_cast<size_t>(i)*chunk; n < end; ++n) {
+			records[n].szWarning = ParseMeshFace(records[n].szData,faces[n]);
+		}
+	}
+
+private:
+	std::vector<FaceRecord>& records;
+	std::vector<ASE::Face>& faces;
+	unsigned int chunk;
+};
+
+} // ! anon namespace
+
 
 // ------------------------------------------------------------------------------------------------
 // Begin an ASE parsing function
@@ -116,7 +274,10 @@ using namespace Assimp::ASE;
 	++filePtr; 
 
 // ------------------------------------------------------------------------------------------------
-Parser::Parser (const char* szFile, unsigned int fileFormatDefault)
+Parser::Parser (const char* szFile, unsigned int fileFormatDefault, 
+	unsigned int numThreads /*= 1*/,
+	unsigned int parallelThreshold /*= AI_PARALLEL_DEFAULT_THRESHOLD*/,
+	unsigned int parallelChunk /*= AI_PARALLEL_DEFAULT_CHUNK*/)
 {
 	ai_assert(NULL != szFile);
 	filePtr = szFile;
@@ -133,18 +294,27 @@ Parser::Parser (const char* szFile, unsigned int fileFormatDefault)
 	iFrameSpeed = 30;        // use 30 as default value for this property
 	iTicksPerFrame = 1;      // use 1 as default value for this property
 	bLastWasEndLine = false; // need to handle \r\n seqs due to binary file mapping
+	iNumThreads = numThreads;
+	iParallelThreshold = parallelThreshold;
+	iParallelChunk = std::max(1u,parallelChunk);
 }
 
 // ------------------------------------------------------------------------------------------------
 void Parser::LogWarning(const char* szWarn)
+{
+	LogWarning(iLineNumber,szWarn);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Parser::LogWarning(unsigned int iLine, const char* szWarn)
 {
 	ai_assert(NULL != szWarn);
 
 	char szTemp[1024];
 #if _MSC_VER >= 1400
-	sprintf_s(szTemp,"Line %i: %s",iLineNumber,szWarn);
+	sprintf_s(szTemp,"Line %i: %s",iLine,szWarn);
 #else
-	snprintf(szTemp,1024,"Line %i: %s",iLineNumber,szWarn);
+	snprintf(szTemp,1024,"Line %i: %s",iLine,szWarn);
 #endif
 
 	// output the warning to the logger ...
@@ -1667,34 +1837,51 @@ void Parser::ParseLV3MeshVertexListBlock(
 // ------------------------------------------------------------------------------------------------
 void Parser::ParseLV3MeshFaceListBlock(unsigned int iNumFaces, ASE::Mesh& mesh)
 {
-	AI_ASE_PARSER_INIT();
-
 	// allocate enough storage in the face array
 	mesh.mFaces.resize(iNumFaces);
+
+	// locate all faces first, they don't depend on each other
+	std::vector<FaceRecord> records;
+	records.reserve(iNumFaces);
+	ScanLV3MeshFaceListBlock(records);
+
+	std::vector<ASE::Face> faces(records.size());
+	FaceJob job(records,faces,iParallelChunk);
+	ParallelFor(job.GetCount(),records.size() < iParallelThreshold ? 1 : iNumThreads,job);
+
+	for (unsigned int i = 0; i < records.size();++i)
+	{
+		if (records[i].szWarning)
+		{
+			LogWarning(records[i].iLine,records[i].szWarning);
+		}
+		if (faces[i].iFace >= iNumFaces)
+		{
+			LogWarning(records[i].iLine,"Face has an invalid index. It will be ignored");
+		}
+		else mesh.mFaces[faces[i].iFace] = faces[i];
+	}
+}
+// ------------------------------------------------------------------------------------------------
+void Parser::ScanLV3MeshFaceListBlock(std::vector<FaceRecord>& records)
+{
+	AI_ASE_PARSER_INIT();
 	while (true)
 	{
 		if ('*' == *filePtr)
 		{
 			++filePtr;
 
-			// Face entry
+			// Face entry. It extends to the end of the line.
 			if (TokenMatch(filePtr,"MESH_FACE" ,9))
 			{
-
-				ASE::Face mFace;
-				ParseLV4MeshFace(mFace);
-
-				if (mFace.iFace >= iNumFaces)
-				{
-					LogWarning("Face has an invalid index. It will be ignored");
-				}
-				else mesh.mFaces[mFace.iFace] = mFace;
+				records.push_back(FaceRecord(filePtr,iLineNumber));
+				while (!IsLineEnd(*filePtr))++filePtr;
 				continue;
 			}
 		}
 		AI_ASE_HANDLE_SECTION("3","*MESH_FACE_LIST");
 	}
-	return;
 }
 // ------------------------------------------------------------------------------------------------
 void Parser::ParseLV3MeshTListBlock(unsigned int iNumVertices,
@@ -1941,147 +2128,6 @@ void Parser::ParseLV3MeshNormalListBlock(ASE::Mesh& sMesh)
 	return;
 }
 // ------------------------------------------------------------------------------------------------
-void Parser::ParseLV4MeshFace(ASE::Face& out)
-{	
-	// skip spaces and tabs
-	if(!SkipSpaces(&filePtr))
-	{
-		LogWarning("Unable to parse *MESH_FACE Element: Unexpected EOL [#1]");
-		SkipToNextToken();
-		return;
-	}
-
-	// parse the face index
-	out.iFace = strtoul10(filePtr,&filePtr);
-
-	// next character should be ':'
-	if(!SkipSpaces(&filePtr))
-	{
-		// FIX: there are some ASE files which haven't got : here ....
-		LogWarning("Unable to parse *MESH_FACE Element: Unexpected EOL. \':\' expected [#2]");
-		SkipToNextToken();
-		return;
-	}
-	// FIX: There are some ASE files which haven't got ':' here 
-	if(':' == *filePtr)++filePtr;
-
-	// Parse all mesh indices
-	for (unsigned int i = 0; i < 3;++i)
-	{
-		unsigned int iIndex = 0;
-		if(!SkipSpaces(&filePtr))
-		{
-			LogWarning("Unable to parse *MESH_FACE Element: Unexpected EOL");
-			SkipToNextToken();
-			return;
-		}
-		switch (*filePtr)
-		{
-		case 'A':
-		case 'a':
-			break;
-		case 'B':
-		case 'b':
-			iIndex = 1;
-			break;
-		case 'C':
-		case 'c':
-			iIndex = 2;
-			break;
-		default: 
-			LogWarning("Unable to parse *MESH_FACE Element: Unexpected EOL. "
-				"A,B or C expected [#3]");
-			SkipToNextToken();
-			return;
-		};
-		++filePtr;
-
-		// next character should be ':'
-		if(!SkipSpaces(&filePtr) || ':' != *filePtr)
-		{
-			LogWarning("Unable to parse *MESH_FACE Element: "
-				"Unexpected EOL. \':\' expected [#2]");
-			SkipToNextToken();
-			return;
-		}
-
-		++filePtr;
-		if(!SkipSpaces(&filePtr))
-		{
-			LogWarning("Unable to parse *MESH_FACE Element: Unexpected EOL. "
-				"Vertex index ecpected [#4]");
-			SkipToNextToken();
-			return;
-		}
-		out.mIndices[iIndex] = strtoul10(filePtr,&filePtr);
-	}
-
-	// now we need to skip the AB, BC, CA blocks. 
-	while (true)
-	{
-		if ('*' == *filePtr)break;
-		if (IsLineEnd(*filePtr))
-		{
-			//iLineNumber++;
-			return;
-		}
-		filePtr++;
-	}
-
-	// parse the smoothing group of the face
-	if (TokenMatch(filePtr,"*MESH_SMOOTHING",15))
-	{
-		if(!SkipSpaces(&filePtr))
-		{
-			LogWarning("Unable to parse *MESH_SMOOTHING Element: "
-				"Unexpected EOL. Smoothing group(s) expected [#5]");
-			SkipToNextToken();
-			return;
-		}
-		
-		// Parse smoothing groups until we don't anymore see commas
-		// FIX: There needn't always be a value, sad but true
-		while (true)
-		{
-			if (*filePtr < '9' && *filePtr >= '0')
-			{
-				out.iSmoothGroup |= (1 << strtoul10(filePtr,&filePtr));
-			}
-			SkipSpaces(&filePtr);
-			if (',' != *filePtr)
-			{
-				break;
-			}
-			++filePtr;
-			SkipSpaces(&filePtr);
-		}
-	}
-
-	// *MESH_MTLID  is optional, too
-	while (true)
-	{
-		if ('*' == *filePtr)break;
-		if (IsLineEnd(*filePtr))
-		{
-			return;
-		}
-		filePtr++;
-	}
-
-	if (TokenMatch(filePtr,"*MESH_MTLID",11))
-	{
-		if(!SkipSpaces(&filePtr))
-		{
-			LogWarning("Unable to parse *MESH_MTLID Element: Unexpected EOL. "
-				"Material index expected [#6]");
-			SkipToNextToken();
-			return;
-		}
-		out.iMaterial = strtoul10(filePtr,&filePtr);
-	}
-	return;
-}
-// ------------------------------------------------------------------------------------------------
 void Parser::ParseLV4MeshLongTriple(unsigned int* apOut)
 {
 	ai_assert(NULL != apOut);
@@ -122,6 +122,24 @@ struct Face : public FaceWithSmoothingGroup
 	unsigned int iFace;
 };
 
+// ---------------------------------------------------------------------------
+/** Position of a not yet parsed *MESH_FACE element */
+struct FaceRecord
+{
+	FaceRecord(const char* szData, unsigned int iLine)
+		: szData(szData), iLine(iLine), szWarning()
+	{}
+
+	//! Start of the element data, after the *MESH_FACE token
+	const char* szData;
+
+	//! Line number, for warnings
+	unsigned int iLine;
+
+	//! Receives the parsing warning, if any
+	const char* szWarning;
+};
+
 // ---------------------------------------------------------------------------
 /** Helper structure to represent an ASE file bone */
 struct Bone
@@ -389,7 +407,14 @@ public:
 	//! @param fileFormatDefault Assumed file format version. If the
 	//!   file format is specified in the file the new value replaces
 	//!   the default value.
-	Parser (const char* szFile, unsigned int fileFormatDefault);
+	//! @param numThreads Number of threads to parse face lists with
+	//! @param parallelThreshold Minimum number of faces in a face list
+	//!   to parse it on multiple threads
+	//! @param parallelChunk Number of faces per job
+	Parser (const char* szFile, unsigned int fileFormatDefault,
+		unsigned int numThreads = 1, 
+		unsigned int parallelThreshold = AI_PARALLEL_DEFAULT_THRESHOLD,
+		unsigned int parallelChunk = AI_PARALLEL_DEFAULT_CHUNK);
 
 	// -------------------------------------------------------------------
 	//! Parses the file into the parsers internal representation
@@ -540,9 +565,9 @@ private:
 	void ParseLV4MeshBonesVertices(unsigned int iNumVertices,Mesh& mesh);
 
 	// -------------------------------------------------------------------
-	//! Parse a *MESH_FACE block in a file
-	//! \param out receive the face data
-	void ParseLV4MeshFace(ASE::Face& out);
+	//! Find all *MESH_FACE elements in a *MESH_FACE_LIST block
+	//! \param records Receives the position of each element
+	void ScanLV3MeshFaceListBlock(std::vector<FaceRecord>& records);
 
 	// -------------------------------------------------------------------
 	//! Parse a *MESH_VERT block in a file
@@ -593,6 +618,7 @@ private:
 	//! Output a warning to the logger
 	//! \param szWarn Warn message
 	void LogWarning(const char* szWarn);
+	void LogWarning(unsigned int iLine, const char* szWarn);
 
 	// -------------------------------------------------------------------
 	//! Output a message to the logger
@@ -660,6 +686,15 @@ public:
 
 	//! File format version
 	unsigned int iFileFormat;
+
+	//! Number of threads to parse face lists with
+	unsigned int iNumThreads;
+
+	//! Minimum number of faces to parse a face list in parallel
+	unsigned int iParallelThreshold;
+
+	//! Number of faces per job
+	unsigned int iParallelChunk;
 };
 
 
@@ -0,0 +1,738 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  AnimationEvaluator.cpp
+ *  @brief Implementation of the Assimp::AnimationEvaluator class.
+ */
+
+#include "AssimpPCH.h"
+#include "../include/assimp/AnimationEvaluator.hpp"
+#include "ParallelFor.h"
+
+#if !defined(ASSIMP_BUILD_NO_SSE) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#	define AI_ANIM_USE_SSE
+#	include <xmmintrin.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Keys of one track (positions, rotations or scalings) of an animation channel. The values
+ *  are stored component by component, so several channels can be blended at once. */
+template <unsigned int N>
+struct KeyTrack
+{
+	std::vector<double> times;
+	std::vector<float> values[N];
+
+	template <typename T>
+	void Set(const T* keys, unsigned int numKeys) {
+		times.resize(numKeys);
+		for (unsigned int c = 0; c < N; ++c) {
+			values[c].resize(numKeys);
+		}
+		for (unsigned int i = 0; i < numKeys; ++i) {
+			times[i] = keys[i].mTime;
+			Store(keys[i].mValue,i);
+		}
+	}
+
+private:
+	void Store(const aiVector3D& v, unsigned int i) {
+		values[0][i] = v.x; values[1][i] = v.y; values[2][i] = v.z;
+	}
+	void Store(const aiQuaternion& q, unsigned int i) {
+		values[0][i] = q.x; values[1][i] = q.y; values[2][i] = q.z; values[3][i] = q.w;
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Preprocessed aiNodeAnim */
+struct Channel
+{
+	//! Index of the animated node
+	unsigned int node;
+
+	aiAnimBehaviour preState, postState;
+
+	KeyTrack<3> position;
+	KeyTrack<4> rotation;
+	KeyTrack<3> scaling;
+
+	//! Components of the node's default transformation, for aiAnimBehaviour_DEFAULT
+	//! and for tracks without keys
+	float defPosition[3], defRotation[4], defScaling[3];
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Blend inputs and results of all channels for one point in time. Each stream holds one
+ *  component of all channels, the streams are padded to a multiple of four channels. */
+class BlendBuffer
+{
+public:
+	enum Stream {
+		POS_A = 0, POS_B = 3, POS_F = 6,
+		ROT_A = 7, ROT_B = 11, ROT_F = 15,
+		SCL_A = 16, SCL_B = 19, SCL_F = 22,
+		POS_OUT = 23, ROT_OUT = 26, SCL_OUT = 30,
+		NUM_STREAMS = 33
+	};
+
+	BlendBuffer(unsigned int numChannels, unsigned int numNodes)
+		: stride((numChannels + 3) & ~3u)
+		, data(stride * NUM_STREAMS,0.f)
+		, local(numNodes)
+	{}
+
+	float* operator[] (unsigned int stream) {
+		return data.empty() ? NULL : &data[stride * stream];
+	}
+
+	const unsigned int stride;
+	std::vector<float> data;
+
+	//! Local transformations if the caller doesn't need them
+	std::vector<aiMatrix4x4> local;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Coefficients for a polynomial approximation of the slerp weights (D. Eberly, 'A Fast and 
+ *  Accurate Algorithm for Computing SLERP'). With twelve terms and the last term corrected,
+ *  the weights differ less than 1e-6 from sin(t*theta)/sin(theta), the same as aiQuaternion::
+ *  Interpolate() computes. Only multiplications and additions are needed, so four slerps 
+ *  can be done at once. */
+struct SlerpCoefficients
+{
+	enum { NUM_TERMS = 12 };
+
+	SlerpCoefficients() {
+		for (unsigned int i = 0; i < NUM_TERMS; ++i) {
+			u[i] = 1.f / ((i+1) * (2*i+3));
+			v[i] = (i+1) / static_cast<float>(2*i+3);
+		}
+		static const float mu = 1.89364f;
+		u[NUM_TERMS-1] *= mu;
+		v[NUM_TERMS-1] *= mu;
+	}
+
+	float u[NUM_TERMS], v[NUM_TERMS];
+};
+
+static const SlerpCoefficients slerpCoefficients;
+
+#ifdef AI_ANIM_USE_SSE
+
+// ------------------------------------------------------------------------------------------------
+// out = a + (b-a)*f for n (a multiple of 4) values
+void LerpStream(const float* a, const float* b, const float* f, float* out, unsigned int n)
+{
+	for (unsigned int i = 0; i < n; i += 4) {
+		const __m128 va = _mm_loadu_ps(a+i);
+		const __m128 vb = _mm_loadu_ps(b+i);
+		_mm_storeu_ps(out+i,_mm_add_ps(va,_mm_mul_ps(_mm_sub_ps(vb,va),_mm_loadu_ps(f+i))));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Slerps n (a multiple of 4) quaternions, given as four streams each
+void SlerpStreams(const float* const a[4], const float* const b[4], const float* f, 
+	float* const out[4], unsigned int n)
+{
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 signMask = _mm_set1_ps(-0.f);
+
+	for (unsigned int i = 0; i < n; i += 4) {
+		__m128 va[4], vb[4];
+		for (unsigned int c = 0; c < 4; ++c) {
+			va[c] = _mm_loadu_ps(a[c]+i);
+			vb[c] = _mm_loadu_ps(b[c]+i);
+		}
+
+		// take the shorter arc: flip the sign of the weight of b if the dot product is negative
+		__m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(va[0],vb[0]),_mm_mul_ps(va[1],vb[1])),
+			_mm_add_ps(_mm_mul_ps(va[2],vb[2]),_mm_mul_ps(va[3],vb[3])));
+		const __m128 sign = _mm_and_ps(x,signMask);
+		x = _mm_xor_ps(x,sign);
+
+		const __m128 xm1 = _mm_sub_ps(x,one);
+		const __m128 t = _mm_loadu_ps(f+i);
+		const __m128 d = _mm_sub_ps(one,t);
+		const __m128 sqrT = _mm_mul_ps(t,t), sqrD = _mm_mul_ps(d,d);
+
+		__m128 ct = one, cd = one;
+		for (int k = SlerpCoefficients::NUM_TERMS-1; k >= 0; --k) {
+			const __m128 u = _mm_set1_ps(slerpCoefficients.u[k]);
+			const __m128 v = _mm_set1_ps(slerpCoefficients.v[k]);
+			ct = _mm_add_ps(one,_mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u,sqrT),v),xm1),ct));
+			cd = _mm_add_ps(one,_mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u,sqrD),v),xm1),cd));
+		}
+		ct = _mm_xor_ps(_mm_mul_ps(ct,t),sign);
+		cd = _mm_mul_ps(cd,d);
+
+		for (unsigned int c = 0; c < 4; ++c) {
+			_mm_storeu_ps(out[c]+i,_mm_add_ps(_mm_mul_ps(va[c],cd),_mm_mul_ps(vb[c],ct)));
+		}
+	}
+}
+
+#else
+
+// ------------------------------------------------------------------------------------------------
+void LerpStream(const float* a, const float* b, const float* f, float* out, unsigned int n)
+{
+	for (unsigned int i = 0; i < n; ++i) {
+		out[i] = a[i] + (b[i]-a[i])*f[i];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void SlerpStreams(const float* const a[4], const float* const b[4], const float* f, 
+	float* const out[4], unsigned int n)
+{
+	for (unsigned int i = 0; i < n; ++i) {
+		float x = a[0][i]*b[0][i] + a[1][i]*b[1][i] + a[2][i]*b[2][i] + a[3][i]*b[3][i];
+		const float sign = x < 0.f ? -1.f : 1.f;
+		x *= sign;
+
+		const float xm1 = x - 1.f, t = f[i], d = 1.f - t;
+		float ct = 1.f, cd = 1.f;
+		for (int k = SlerpCoefficients::NUM_TERMS-1; k >= 0; --k) {
+			ct = 1.f + (slerpCoefficients.u[k]*t*t - slerpCoefficients.v[k])*xm1*ct;
+			cd = 1.f + (slerpCoefficients.u[k]*d*d - slerpCoefficients.v[k])*xm1*cd;
+		}
+		ct *= t * sign;
+		cd *= d;
+
+		for (unsigned int c = 0; c < 4; ++c) {
+			out[c][i] = a[c][i]*cd + b[c][i]*ct;
+		}
+	}
+}
+
+#endif // !! AI_ANIM_USE_SSE
+
+// ------------------------------------------------------------------------------------------------
+/** Finds the keys to blend at a given time, honouring the pre and post states of the channel
+ *  outside the time range of the keys. Returns false if the default value is to be used. The
+ *  factor is only outside [0,1] for aiAnimBehaviour_LINEAR. */
+bool LocateKeys(const std::vector<double>& times, double t, aiAnimBehaviour preState,
+	aiAnimBehaviour postState, unsigned int& k0, unsigned int& k1, double& f)
+{
+	const unsigned int n = static_cast<unsigned int>(times.size());
+	const double first = times.front(), last = times.back();
+
+	f = 0.;
+	if (n == 1) {
+		// a single key holds at all times
+		k0 = k1 = 0;
+		return true;
+	}
+	if (t < first || t > last) {
+		switch (t < first ? preState : postState)
+		{
+		case aiAnimBehaviour_DEFAULT:
+			return false;
+
+		case aiAnimBehaviour_LINEAR:
+			k0 = t < first ? 0 : n-2;
+			k1 = k0+1;
+			if (times[k1] > times[k0]) {
+				f = (t - times[k0]) / (times[k1] - times[k0]);
+			}
+			return true;
+
+		case aiAnimBehaviour_REPEAT:
+			if (last > first) {
+				t = first + fmod(t - first,last - first);
+				if (t < first) {
+					t += last - first;
+				}
+				break;
+			}
+			k0 = k1 = 0;
+			return true;
+
+		default: // aiAnimBehaviour_CONSTANT
+			k0 = k1 = (t < first ? 0 : n-1);
+			return true;
+		};
+	}
+
+	k1 = static_cast<unsigned int>(std::upper_bound(times.begin(),times.end(),t) - times.begin());
+	if (k1 == n) {
+		k0 = k1 = n-1;
+		return true;
+	}
+	k0 = k1 ? k1-1 : 0;
+	if (times[k1] > times[k0]) {
+		f = (t - times[k0]) / (times[k1] - times[k0]);
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Fills the blend inputs of one track of one channel */
+template <unsigned int N>
+void SetupTrack(const KeyTrack<N>& track, const Channel& chan, const float* def, double t,
+	BlendBuffer& buffer, unsigned int streamA, unsigned int streamB, unsigned int streamF, unsigned int c)
+{
+	unsigned int k0, k1;
+	double f;
+	if (track.times.empty() || !LocateKeys(track.times,t,chan.preState,chan.postState,k0,k1,f)) {
+		for (unsigned int i = 0; i < N; ++i) {
+			buffer[streamA+i][c] = buffer[streamB+i][c] = def[i];
+		}
+		buffer[streamF][c] = 0.f;
+		return;
+	}
+	for (unsigned int i = 0; i < N; ++i) {
+		buffer[streamA+i][c] = track.values[i][k0];
+		buffer[streamB+i][c] = track.values[i][k1];
+	}
+	buffer[streamF][c] = static_cast<float>(f);
+
+	// extrapolated rotations are rare, compute them right away as the
+	// approximation used for blending is only valid in between two keys
+	if (N == 4 && (f < 0. || f > 1.)) {
+		aiQuaternion q;
+		aiQuaternion::Interpolate(q,
+			aiQuaternion(track.values[3][k0],track.values[0][k0],track.values[1][k0],track.values[2][k0]),
+			aiQuaternion(track.values[3][k1],track.values[0][k1],track.values[1][k1],track.values[2][k1]),
+			static_cast<float>(f));
+
+		buffer[streamA+0][c] = buffer[streamB+0][c] = q.x;
+		buffer[streamA+1][c] = buffer[streamB+1][c] = q.y;
+		buffer[streamA+2][c] = buffer[streamB+2][c] = q.z;
+		buffer[streamA+3][c] = buffer[streamB+3][c] = q.w;
+		buffer[streamF][c] = 0.f;
+	}
+}
+
+} // ! anon namespace
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Private data of an AnimationEvaluator */
+class AnimationEvaluatorPimpl
+{
+public:
+
+	AnimationEvaluatorPimpl(const aiScene* scene)
+		: scene(scene)
+		, anim()
+		, loop(true)
+	{}
+
+	// --------------------------------------------------------------------------------------------
+	// Numbers the nodes in depth-first order
+	void AddNode(const aiNode* node, unsigned int parent) {
+		const unsigned int index = static_cast<unsigned int>(nodes.size());
+		nodes.push_back(node);
+		parents.push_back(parent);
+		bind.push_back(node->mTransformation);
+		nodeIndices[node] = index;
+		nodesByName.insert(std::make_pair(std::string(node->mName.data),index));
+
+		for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+			AddNode(node->mChildren[i],index);
+		}
+	}
+
+	// --------------------------------------------------------------------------------------------
+	unsigned int FindNode(const aiString& name) const {
+		// if several nodes have the same name, the first one in depth-first order wins
+		const std::multimap<std::string,unsigned int>::const_iterator it = nodesByName.lower_bound(std::string(name.data));
+		return it == nodesByName.end() || (*it).first != name.data ? UINT_MAX : (*it).second;
+	}
+
+	// --------------------------------------------------------------------------------------------
+	// Preprocesses the channels of an animation
+	void SetAnimation(const aiAnimation* a) {
+		anim = a;
+		channels.clear();
+		if (!anim) {
+			return;
+		}
+
+		channels.reserve(anim->mNumChannels);
+		for (unsigned int i = 0; i < anim->mNumChannels; ++i) {
+			const aiNodeAnim* src = anim->mChannels[i];
+			const unsigned int node = FindNode(src->mNodeName);
+			if (node == UINT_MAX) {
+				DefaultLogger::get()->warn("AnimationEvaluator: there is no node for the animation channel " 
+					+ std::string(src->mNodeName.data));
+				continue;
+			}
+
+			channels.push_back(Channel());
+			Channel& chan = channels.back();
+			chan.node = node;
+			chan.preState = src->mPreState;
+			chan.postState = src->mPostState;
+			chan.position.Set(src->mPositionKeys,src->mNumPositionKeys);
+			chan.rotation.Set(src->mRotationKeys,src->mNumRotationKeys);
+			chan.scaling.Set(src->mScalingKeys,src->mNumScalingKeys);
+
+			aiVector3D scaling, position;
+			aiQuaternion rotation;
+			bind[node].Decompose(scaling,rotation,position);
+			chan.defPosition[0] = position.x; chan.defPosition[1] = position.y; chan.defPosition[2] = position.z;
+			chan.defRotation[0] = rotation.x; chan.defRotation[1] = rotation.y; 
+			chan.defRotation[2] = rotation.z; chan.defRotation[3] = rotation.w;
+			chan.defScaling[0] = scaling.x; chan.defScaling[1] = scaling.y; chan.defScaling[2] = scaling.z;
+		}
+	}
+
+	// --------------------------------------------------------------------------------------------
+	// Computes the pose at a given time in seconds, the local transformations are required
+	void Sample(double time, BlendBuffer& buffer, aiMatrix4x4* local, aiMatrix4x4* global) const {
+		std::copy(bind.begin(),bind.end(),local);
+
+		if (anim && !channels.empty()) {
+			double t = time * (anim->mTicksPerSecond != 0. ? anim->mTicksPerSecond : 25.);
+			if (loop && anim->mDuration > 0.) {
+				t = fmod(t,anim->mDuration);
+				if (t < 0.) {
+					t += anim->mDuration;
+				}
+			}
+
+			const unsigned int numChannels = static_cast<unsigned int>(channels.size());
+			for (unsigned int c = 0; c < numChannels; ++c) {
+				const Channel& chan = channels[c];
+				SetupTrack(chan.position,chan,chan.defPosition,t,buffer,
+					BlendBuffer::POS_A,BlendBuffer::POS_B,BlendBuffer::POS_F,c);
+				SetupTrack(chan.rotation,chan,chan.defRotation,t,buffer,
+					BlendBuffer::ROT_A,BlendBuffer::ROT_B,BlendBuffer::ROT_F,c);
+				SetupTrack(chan.scaling,chan,chan.defScaling,t,buffer,
+					BlendBuffer::SCL_A,BlendBuffer::SCL_B,BlendBuffer::SCL_F,c);
+			}
+
+			// blend all channels at once
+			const unsigned int n = buffer.stride;
+			for (unsigned int i = 0; i < 3; ++i) {
+				LerpStream(buffer[BlendBuffer::POS_A+i],buffer[BlendBuffer::POS_B+i],
+					buffer[BlendBuffer::POS_F],buffer[BlendBuffer::POS_OUT+i],n);
+				LerpStream(buffer[BlendBuffer::SCL_A+i],buffer[BlendBuffer::SCL_B+i],
+					buffer[BlendBuffer::SCL_F],buffer[BlendBuffer::SCL_OUT+i],n);
+			}
+			const float* const a[4] = {buffer[BlendBuffer::ROT_A],buffer[BlendBuffer::ROT_A+1],
+				buffer[BlendBuffer::ROT_A+2],buffer[BlendBuffer::ROT_A+3]};
+			const float* const b[4] = {buffer[BlendBuffer::ROT_B],buffer[BlendBuffer::ROT_B+1],
+				buffer[BlendBuffer::ROT_B+2],buffer[BlendBuffer::ROT_B+3]};
+			float* const out[4] = {buffer[BlendBuffer::ROT_OUT],buffer[BlendBuffer::ROT_OUT+1],
+				buffer[BlendBuffer::ROT_OUT+2],buffer[BlendBuffer::ROT_OUT+3]};
+			SlerpStreams(a,b,buffer[BlendBuffer::ROT_F],out,n);
+
+			// build the matrices: scaling, then rotation, then translation
+			for (unsigned int c = 0; c < numChannels; ++c) {
+				const aiQuaternion q(out[3][c],out[0][c],out[1][c],out[2][c]);
+				const float sx = buffer[BlendBuffer::SCL_OUT][c];
+				const float sy = buffer[BlendBuffer::SCL_OUT+1][c];
+				const float sz = buffer[BlendBuffer::SCL_OUT+2][c];
+
+				aiMatrix4x4& mat = local[channels[c].node];
+				mat = aiMatrix4x4(q.GetMatrix());
+				mat.a1 *= sx; mat.b1 *= sx; mat.c1 *= sx;
+				mat.a2 *= sy; mat.b2 *= sy; mat.c2 *= sy;
+				mat.a3 *= sz; mat.b3 *= sz; mat.c3 *= sz;
+				mat.a4 = buffer[BlendBuffer::POS_OUT][c]; 
+				mat.b4 = buffer[BlendBuffer::POS_OUT+1][c]; 
+				mat.c4 = buffer[BlendBuffer::POS_OUT+2][c];
+			}
+		}
+
+		// parents come before their children
+		if (global) {
+			for (unsigned int i = 0; i < nodes.size(); ++i) {
+				global[i] = parents[i] == UINT_MAX ? local[i] : global[parents[i]] * local[i];
+			}
+		}
+	}
+
+	// --------------------------------------------------------------------------------------------
+	// Resets the pose returned by GetLocalTransform() and GetGlobalTransform() to the bind pose
+	void ResetPose() {
+		local = bind;
+		global.resize(nodes.size());
+		for (unsigned int i = 0; i < nodes.size(); ++i) {
+			global[i] = parents[i] == UINT_MAX ? local[i] : global[parents[i]] * local[i];
+		}
+	}
+
+	// --------------------------------------------------------------------------------------------
+	void Sample(double time, aiMatrix4x4* local, aiMatrix4x4* global) const {
+		BlendBuffer buffer(static_cast<unsigned int>(channels.size()),static_cast<unsigned int>(nodes.size()));
+		Sample(time,buffer,local ? local : &buffer.local[0],global);
+	}
+
+public:
+
+	const aiScene* const scene;
+	const aiAnimation* anim;
+	bool loop;
+
+	//! All nodes in depth-first order, with the indices of their parents
+	std::vector<const aiNode*> nodes;
+	std::vector<unsigned int> parents;
+
+	//! Bind pose, the aiNode::mTransformation of all nodes
+	std::vector<aiMatrix4x4> bind;
+
+	std::map<const aiNode*,unsigned int> nodeIndices;
+	std::multimap<std::string,unsigned int> nodesByName;
+
+	//! Channels of the current animation, whose nodes could be found
+	std::vector<Channel> channels;
+
+	//! Node indices of the bones of all meshes
+	std::vector< std::vector<unsigned int> > boneNodes;
+
+	//! Pose computed by Evaluate() and bone matrices returned by GetBoneMatrices()
+	std::vector<aiMatrix4x4> local, global, palette;
+	aiMatrix4x4 identity;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Samples a block of poses for ParallelFor() */
+class SamplePosesJob
+{
+public:
+	enum { BLOCK_SIZE = 16 };
+
+	SamplePosesJob(const AnimationEvaluatorPimpl& pimpl, const double* times, unsigned int numTimes,
+		aiMatrix4x4* local, aiMatrix4x4* global)
+		: pimpl(pimpl)
+		, times(times)
+		, numTimes(numTimes)
+		, local(local)
+		, global(global)
+	{}
+
+	unsigned int GetCount() const {
+		return (numTimes + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	}
+
+	void operator() (unsigned int block) {
+		const size_t numNodes = pimpl.nodes.size();
+		BlendBuffer buffer(static_cast<unsigned int>(pimpl.channels.size()),static_cast<unsigned int>(numNodes));
+
+		const unsigned int end = std::min(numTimes,(block+1) * BLOCK_SIZE);
+		for (unsigned int i = block * BLOCK_SIZE; i < end; ++i) {
+			pimpl.Sample(times[i],buffer,local ? local + i * numNodes : &buffer.local[0],
+				global ? global + i * numNodes : NULL);
+		}
+	}
+
+private:
+	const AnimationEvaluatorPimpl& pimpl;
+	const double* const times;
+	const unsigned int numTimes;
+	aiMatrix4x4* const local;
+	aiMatrix4x4* const global;
+};
+
+} // ! Assimp
+
+// ------------------------------------------------------------------------------------------------
+AnimationEvaluator::AnimationEvaluator(const aiScene* pScene, unsigned int pAnimIndex)
+	: pimpl(new AnimationEvaluatorPimpl(pScene))
+{
+	ai_assert(NULL != pScene);
+	if (pScene->mRootNode) {
+		pimpl->AddNode(pScene->mRootNode,UINT_MAX);
+	}
+
+	// find the nodes of all bones once
+	pimpl->boneNodes.resize(pScene->mNumMeshes);
+	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+		const aiMesh* mesh = pScene->mMeshes[i];
+		pimpl->boneNodes[i].resize(mesh->mNumBones);
+		for (unsigned int n = 0; n < mesh->mNumBones; ++n) {
+			pimpl->boneNodes[i][n] = pimpl->FindNode(mesh->mBones[n]->mName);
+		}
+	}
+
+	SetAnimation(pAnimIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+AnimationEvaluator::~AnimationEvaluator()
+{
+	delete pimpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::SetAnimation(unsigned int pAnimIndex)
+{
+	const aiScene* scene = pimpl->scene;
+	pimpl->SetAnimation(pAnimIndex < scene->mNumAnimations ? scene->mAnimations[pAnimIndex] : NULL);
+
+	pimpl->ResetPose();
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiAnimation* AnimationEvaluator::GetAnimation() const
+{
+	return pimpl->anim;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::SetLooping(bool pLoop)
+{
+	pimpl->loop = pLoop;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool AnimationEvaluator::IsLooping() const
+{
+	return pimpl->loop;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationEvaluator::GetNumNodes() const
+{
+	return static_cast<unsigned int>(pimpl->nodes.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationEvaluator::GetNodeIndex(const aiNode* pNode) const
+{
+	const std::map<const aiNode*,unsigned int>::const_iterator it = pimpl->nodeIndices.find(pNode);
+	return it == pimpl->nodeIndices.end() ? UINT_MAX : (*it).second;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiNode* AnimationEvaluator::GetNode(unsigned int pIndex) const
+{
+	return pIndex < pimpl->nodes.size() ? pimpl->nodes[pIndex] : NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::SamplePose(double pTime, aiMatrix4x4* pLocal, aiMatrix4x4* pGlobal) const
+{
+	if (pimpl->nodes.empty()) {
+		return;
+	}
+	pimpl->Sample(pTime,pLocal,pGlobal);
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::SamplePoses(const double* pTimes, unsigned int pNumTimes, 
+	aiMatrix4x4* pLocal, aiMatrix4x4* pGlobal, int pNumThreads) const
+{
+	if (pimpl->nodes.empty() || !pNumTimes) {
+		return;
+	}
+	ai_assert(NULL != pTimes);
+
+	SamplePosesJob job(*pimpl,pTimes,pNumTimes,pLocal,pGlobal);
+	ParallelFor(job.GetCount(),GetWorkerThreadCount(pNumThreads),job);
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::GetBonePalette(const aiMatrix4x4* pGlobal, const aiNode* pNode,
+	unsigned int pMeshIndex, aiMatrix4x4* pOut) const
+{
+	ai_assert(NULL != pGlobal && NULL != pNode && NULL != pOut);
+	ai_assert(pMeshIndex < pNode->mNumMeshes);
+
+	const unsigned int meshIndex = pNode->mMeshes[pMeshIndex];
+	ai_assert(meshIndex < pimpl->scene->mNumMeshes);
+	const aiMesh* mesh = pimpl->scene->mMeshes[meshIndex];
+
+	// the inverse of the mesh's global transform
+	const unsigned int node = GetNodeIndex(pNode);
+	aiMatrix4x4 inverseMeshTransform;
+	if (node != UINT_MAX) {
+		inverseMeshTransform = pGlobal[node];
+		inverseMeshTransform.Inverse();
+	}
+
+	// Bone matrices transform from mesh coordinates in bind pose to mesh coordinates in the
+	// current pose, thus the formula is inverseMeshTransform * currentGlobalTransform * offsetMatrix
+	const std::vector<unsigned int>& boneNodes = pimpl->boneNodes[meshIndex];
+	for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
+		if (boneNodes[i] == UINT_MAX) {
+			pOut[i] = aiMatrix4x4();
+			continue;
+		}
+		pOut[i] = inverseMeshTransform * pGlobal[boneNodes[i]] * mesh->mBones[i]->mOffsetMatrix;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationEvaluator::Evaluate(double pTime)
+{
+	if (pimpl->nodes.empty()) {
+		return;
+	}
+	pimpl->Sample(pTime,&pimpl->local[0],&pimpl->global[0]);
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMatrix4x4& AnimationEvaluator::GetLocalTransform(const aiNode* pNode) const
+{
+	const unsigned int node = GetNodeIndex(pNode);
+	return node == UINT_MAX ? pimpl->identity : pimpl->local[node];
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMatrix4x4& AnimationEvaluator::GetGlobalTransform(const aiNode* pNode) const
+{
+	const unsigned int node = GetNodeIndex(pNode);
+	return node == UINT_MAX ? pimpl->identity : pimpl->global[node];
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMatrix4x4* AnimationEvaluator::GetBoneMatrices(const aiNode* pNode, unsigned int pMeshIndex)
+{
+	ai_assert(NULL != pNode && pMeshIndex < pNode->mNumMeshes);
+	const aiMesh* mesh = pimpl->scene->mMeshes[pNode->mMeshes[pMeshIndex]];
+	if (!mesh->mNumBones) {
+		return NULL;
+	}
+	pimpl->palette.resize(mesh->mNumBones);
+	GetBonePalette(&pimpl->global[0],pNode,pMeshIndex,&pimpl->palette[0]);
+	return &pimpl->palette[0];
+}
@@ -457,6 +457,16 @@ void aiGetMemoryRequirements(const C_STRUCT aiScene* pIn,
 	ASSIMP_END_EXCEPTION_REGION(void);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the detailed memory requirements of any scene
+void aiGetSceneMemoryRequirements(const C_STRUCT aiScene* pIn,
+	C_STRUCT aiSceneMemoryInfo* in)
+{
+	ASSIMP_BEGIN_EXCEPTION_REGION();
+	Importer::GetMemoryRequirements(pIn,*in);
+	ASSIMP_END_EXCEPTION_REGION(void);
+}
+
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API aiPropertyStore* aiCreatePropertyStore(void)
 {
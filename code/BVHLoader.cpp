@@ -117,6 +117,7 @@ void BVHLoader::InternReadFile( const std::string& pFile, aiScene* pScene, IOSys
 	// start reading
 	mReader = mBuffer.begin();
 	mLine = 1;
+	mNodes.clear();
 	ReadStructure( pScene);
 
 	// build a dummy mesh for the skeleton so that we see something at least
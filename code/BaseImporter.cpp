@@ -55,6 +55,7 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter()
 : progress()
+, importer()
 {
 	// nothing to do here
 }
@@ -72,6 +73,7 @@ aiScene* BaseImporter::ReadFile(const Importer* pImp, const std::string& pFile,
 {
 	progress = pImp->GetProgressHandler();
 	ai_assert(progress);
+	importer = pImp;
 
 	// Gather configuration properties for this run
 	SetupProperties( pImp );
@@ -85,20 +87,32 @@ aiScene* BaseImporter::ReadFile(const Importer* pImp, const std::string& pFile,
 	// dispatch importing
 	try
 	{
+		UpdateImporterProgress(ProgressHandler::Phase_Read,0,1);
 		InternReadFile( pFile, sc, &filter);
+		UpdateImporterProgress(ProgressHandler::Phase_Convert,1,1);
 
 	} catch( const std::exception& err )	{
 		// extract error description
 		mErrorText = err.what();
 		DefaultLogger::get()->error(mErrorText);
+		importer = NULL;
 		return NULL;
 	}
 
 	// return what we gathered from the import. 
+	importer = NULL;
 	sc.dismiss();
 	return sc;
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseImporter::UpdateImporterProgress(ProgressHandler::Phase phase, unsigned int current, unsigned int total) const
+{
+	if (importer && !importer->Pimpl()->UpdateProgress(phase,current,total)) {
+		throw DeadlyImportError("Import cancelled");
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseImporter::SetupProperties(const Importer* /*pImp*/)
 {
@@ -128,6 +142,12 @@ void BaseImporter::GetExtensionList(std::set<std::string>& extensions)
 	while(*ext++);
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseImporter::GetMagicTokens(std::vector<uint32_t>& /*tokens*/) const
+{
+	// no fixed file signature by default
+}
+
 // ------------------------------------------------------------------------------------------------
 /*static*/ bool BaseImporter::SearchFileHeaderForToken(IOSystem* pIOHandler,
 	const std::string&	pFile,
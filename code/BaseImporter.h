@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <map>
 #include <vector>
 #include "./../include/assimp/types.h"
+#include "./../include/assimp/ProgressHandler.hpp"
 
 struct aiScene;
 
@@ -106,7 +107,7 @@ private:
  * imports the given file. ReadFile is not overridable, it just calls 
  * InternReadFile() and catches any ImportErrorException that might occur.
  */
-class BaseImporter
+class ASSIMP_API BaseImporter
 {
 	friend class Importer;
 
@@ -202,6 +203,16 @@ public:
 	 *  @param extension set to collect file extensions in*/
 	void GetExtensionList(std::set<std::string>& extensions);
 
+	// -------------------------------------------------------------------
+	/** Called by #Importer to build its table of file signatures.
+	 *  Importers whose files start with a fixed four byte token append
+	 *  all possible tokens, as they would pass them to #CheckMagicToken.
+	 *  During signature-based detection, files starting with one of the
+	 *  tokens (in either byte order) are offered to these importers first.
+	 *  The default implementation adds nothing.
+	 *  @param tokens Vector to collect the tokens in */
+	virtual void GetMagicTokens(std::vector<uint32_t>& tokens) const;
+
 protected:
 
 	// -------------------------------------------------------------------
@@ -220,7 +231,9 @@ protected:
 	 * <li>the vertex data is stored in a pseudo-indexed "verbose" format.
 	 *   In fact this means that every vertex that is referenced by
 	 *   a face is unique. Or the other way round: a vertex index may
-	 *   not occur twice in a single aiMesh.</li>
+	 *   not occur twice in a single aiMesh. Loaders which share vertices
+	 *   between faces must set #AI_SCENE_FLAGS_NON_VERBOSE_FORMAT, the
+	 *   steps which need unique vertices per face split them then.</li>
 	 * <li>aiAnimation::mDuration may be -1. Assimp determines the length
 	 *   of the animation automatically in this case as the length of
 	 *   the longest animation channel.</li>
@@ -343,6 +356,22 @@ public: // static utilities
 		IOStream* stream,
 		std::vector<char>& data);
 
+public:
+
+	// -------------------------------------------------------------------
+	/** Report the progress of the current import phase. Loaders, and 
+	 *  parser classes on their behalf, should call this regularly from 
+	 *  their main loops, but not for every single element. Must only be
+	 *  called from the thread running the import. Does nothing if no 
+	 *  import is running.
+	 *  @param phase Current phase, usually ProgressHandler::Phase_Parse
+	 *  @param current Units of work done so far, e.g. bytes or lines
+	 *  @param total Total units of work, 0 if unknown
+	 *  @throw DeadlyImportError if the import has been cancelled */
+	void UpdateImporterProgress(ProgressHandler::Phase phase, 
+		unsigned int current, 
+		unsigned int total) const;
+
 protected:
 
 	/** Error description in case there was one. */
@@ -350,6 +379,9 @@ protected:
 
 	/** Currently set progress handler */
 	ProgressHandler* progress;
+
+	/** Importer running the current import, NULL if none is running */
+	const Importer* importer;
 };
 
 
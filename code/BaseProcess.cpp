@@ -54,6 +54,7 @@ using namespace Assimp;
 BaseProcess::BaseProcess()
 : shared()
 , progress()
+, importer()
 {
 }
 
@@ -71,15 +72,19 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
 
 	progress = pImp->GetProgressHandler();
 	ai_assert(progress);
+	importer = pImp;
 
 	SetupProperties( pImp );
 
 	// catch exceptions thrown inside the PostProcess-Step
 	try
 	{
+		CheckImportCancelled();
 		Execute(pImp->Pimpl()->mScene);
+		importer = NULL;
 
 	} catch( const std::exception& err )	{
+		importer = NULL;
 
 		// extract error description
 		pImp->Pimpl()->mErrorString = err.what();
@@ -91,6 +96,14 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::CheckImportCancelled() const
+{
+	if (importer && importer->Pimpl()->IsCancelled()) {
+		throw DeadlyImportError("Import cancelled");
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseProcess::SetupProperties(const Importer* /*pImp*/)
 {
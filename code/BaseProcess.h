@@ -201,6 +201,10 @@ private:
 
 #define AI_SPP_SPATIAL_SORT "$Spat"
 
+// std::vector<VertexInfluences>, one table per mesh. Set up by 
+// SplitByBoneCountProcess, consumed by LimitBoneWeightsProcess.
+#define AI_SPP_BONE_INFLUENCES "$BInf"
+
 // ---------------------------------------------------------------------------
 /** The BaseProcess defines a common interface for all post processing steps.
  * A post processing step is run after a successful import if the caller
@@ -279,6 +283,15 @@ public:
 		return shared;
 	}
 
+protected:
+
+	// -------------------------------------------------------------------
+	/** Abort the step if the import has been cancelled. Steps should call
+	 *  this regularly from their main loops, e.g. once per mesh. Does 
+	 *  nothing if the step is not run by an #Importer.
+	 *  @throw DeadlyImportError if the import has been cancelled */
+	void CheckImportCancelled() const;
+
 protected:
 
 	/** See the doc of #SharedPostProcessInfo for more details */
@@ -286,6 +299,10 @@ protected:
 
 	/** Currently active progress handler */
 	ProgressHandler* progress;
+
+	/** Importer running this step, NULL if the step is not executed
+	 *  through ExecuteOnScene() */
+	const Importer* importer;
 };
 
 
@@ -0,0 +1,511 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  BlenderBulkConvert.cpp
+ *  @brief Specialized Structure::ConvertArray implementations which decode
+ *    the large mesh arrays (vertices, edges, faces, uv and color layers)
+ *    straight from the memory of the input stream.
+ *
+ *  The generic conversion path looks up every field by name and seeks the
+ *  stream for every single element. For arrays with millions of elements
+ *  this dominates the import time, so the field layout is resolved once per
+ *  array and all elements are decoded in a tight loop instead. If the DNA
+ *  of the file does not match the expected layout, the generic path is used.
+ */
+#include "AssimpPCH.h"
+
+#ifndef ASSIMP_BUILD_NO_BLEND_IMPORTER
+#include "BlenderDNA.h"
+#include "BlenderScene.h"
+#include "BlenderSceneGen.h"
+#include "ParallelFor.h"
+
+using namespace Assimp;
+using namespace Assimp::Blender;
+
+namespace {
+
+// number of array elements per job if an array is decoded in parallel
+const size_t BULK_BLOCK_SIZE = 16384;
+
+// ------------------------------------------------------------------------------------------------
+/** Location and encoding of a primitive field within a structure */
+struct RawField
+{
+	enum Type {
+		Type_Char, Type_Short, Type_Int, Type_Float, Type_Double,
+
+		// field is not present, the destination is default-initialized
+		Type_Missing
+	};
+
+	Type type;
+	size_t offset;
+
+	// number of primitives present in the file and their size
+	size_t count;
+	size_t size;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Locate a field for bulk reading. 
+ *  @param rows, cols Dimensions of the destination, i.e. 1,1 for a scalar
+ *    destination and M,1 for a flat array. 
+ *  @param error_policy Policy of the field. Missing fields are default-
+ *    initialized unless the policy is ErrorPolicy_Fail, the warning for
+ *    ErrorPolicy_Warn is printed only once for the whole array.
+ *  @return false if the field can only be read by the generic code path,
+ *    which then also takes care of the error handling. */
+bool BindField(RawField& out, const Structure& s, const char* name, 
+	size_t rows, size_t cols, int error_policy, const FileDatabase& db)
+{
+	const Field* f = s.Get(name);
+	if (!f) {
+		out.type = RawField::Type_Missing;
+		out.offset = out.count = out.size = 0;
+
+		if (error_policy == ErrorPolicy_Warn) {
+			DefaultLogger::get()->warn((Formatter::format(),
+				"BlendDNA: Did not find a field named `",name,"` in structure `",s.name,"`"
+				));
+		}
+		return error_policy != ErrorPolicy_Fail;
+	}
+	if (f->flags & FieldFlag_Pointer) {
+		return false;
+	}
+
+	if (f->type == "char") {
+		out.type = RawField::Type_Char;
+	}
+	else if (f->type == "short") {
+		out.type = RawField::Type_Short;
+	}
+	else if (f->type == "int") {
+		out.type = RawField::Type_Int;
+	}
+	else if (f->type == "float") {
+		out.type = RawField::Type_Float;
+	}
+	else if (f->type == "double") {
+		out.type = RawField::Type_Double;
+	}
+	else return false;
+
+	out.offset = f->offset;
+	out.size = db.dna[f->type].size;
+
+	if (rows * cols == 1) {
+		// scalars just take the first element of an array
+		out.count = 1;
+	}
+	else if (!(f->flags & FieldFlag_Array)) {
+		return false;
+	}
+	else if (cols == 1) {
+		if (f->array_sizes[1] != 1) {
+			return false;
+		}
+		out.count = std::min(f->array_sizes[0],rows);
+	}
+	else {
+		// the generic code doesn't handle partial 2d arrays nicely, leave them to it
+		if (f->array_sizes[0] != rows || f->array_sizes[1] != cols) {
+			return false;
+		}
+		out.count = rows * cols;
+	}
+
+	if (f->offset + out.count * out.size > s.size) {
+		return false;
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T> inline T Load(const int8_t* p, bool swap)
+{
+	T v;
+	::memcpy(&v,p,sizeof(T));
+	if (swap) {
+		ByteSwap::Swap(&v);
+	}
+	return v;
+}
+
+template <> inline uint8_t Load<uint8_t>(const int8_t* p, bool /*swap*/)
+{
+	return *reinterpret_cast<const uint8_t*>(p);
+}
+
+template <> inline int8_t Load<int8_t>(const int8_t* p, bool /*swap*/)
+{
+	return *p;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Decode a single primitive. Conversions and rescaling exactly follow the
+// Structure::Convert specializations for primitive types in BlenderDNA.inl.
+template <typename T> 
+inline T DecodeInteger(const int8_t* p, RawField::Type type, bool swap, float scale)
+{
+	switch (type)
+	{
+	case RawField::Type_Char:
+		return static_cast_silent<T>()(Load<uint8_t>(p,swap));
+	case RawField::Type_Short:
+		return static_cast_silent<T>()(Load<uint16_t>(p,swap));
+	case RawField::Type_Int:
+		return static_cast_silent<T>()(Load<uint32_t>(p,swap));
+	case RawField::Type_Float:
+		return static_cast<T>(Load<float>(p,swap) * scale);
+	default:
+		return static_cast<T>(Load<double>(p,swap) * scale);
+	};
+}
+
+inline void Decode(int& out, const int8_t* p, RawField::Type type, bool swap)
+{
+	out = DecodeInteger<int>(p,type,swap,1.f);
+}
+
+inline void Decode(short& out, const int8_t* p, RawField::Type type, bool swap)
+{
+	out = DecodeInteger<short>(p,type,swap,32767.f);
+}
+
+inline void Decode(char& out, const int8_t* p, RawField::Type type, bool swap)
+{
+	out = DecodeInteger<char>(p,type,swap,255.f);
+}
+
+inline void Decode(float& out, const int8_t* p, RawField::Type type, bool swap)
+{
+	switch (type)
+	{
+	case RawField::Type_Char:
+		out = Load<int8_t>(p,swap) / 255.f;
+		break;
+	case RawField::Type_Short:
+		out = Load<int16_t>(p,swap) / 32767.f;
+		break;
+	case RawField::Type_Int:
+		out = static_cast<float>(Load<uint32_t>(p,swap));
+		break;
+	case RawField::Type_Float:
+		out = Load<float>(p,swap);
+		break;
+	default:
+		out = static_cast<float>(Load<double>(p,swap));
+	};
+}
+
+// ------------------------------------------------------------------------------------------------
+// Read a field of a single element, `elem` points to the start of the element
+template <typename T> 
+inline void Read(T* dest, size_t num, const RawField& f, const int8_t* elem, bool swap)
+{
+	size_t i = 0;
+	if (f.type != RawField::Type_Missing) {
+		const int8_t* p = elem + f.offset;
+		for (const size_t end = std::min(num,f.count); i < end; ++i, p += f.size) {
+			Decode(dest[i],p,f.type,swap);
+		}
+	}
+	for (; i < num; ++i) {
+		dest[i] = T();
+	}
+}
+
+template <typename T> 
+inline void Read(T& dest, const RawField& f, const int8_t* elem, bool swap)
+{
+	Read(&dest,1,f,elem,swap);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Decodes a block of array elements, for use with ParallelFor() */
+template <typename T, typename Decoder>
+struct DecodeJob
+{
+	DecodeJob(T* dest, size_t num, const int8_t* src, size_t stride, const Decoder& decoder)
+		: dest(dest), num(num), src(src), stride(stride), decoder(decoder)
+	{}
+
+	void operator() (unsigned int block) {
+		const size_t end = std::min(num, (block + 1) * BULK_BLOCK_SIZE);
+		for (size_t i = block * BULK_BLOCK_SIZE; i < end; ++i) {
+			decoder(dest[i],src + i * stride);
+		}
+	}
+
+	T* dest;
+	size_t num;
+	const int8_t* src;
+	size_t stride;
+	const Decoder& decoder;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Decode `num` elements starting at the current stream position, or fall back to 
+ *  element-wise conversion if the decoder could not be bound to the DNA. */
+template <typename T, typename Decoder>
+void DecodeArray(const Structure& s, T* dest, size_t num, const Decoder& decoder, 
+	bool bound, unsigned int fields, const FileDatabase& db)
+{
+	if (!bound || !s.size || db.reader->GetRemainingSizeToLimit() < num * s.size) {
+		for (size_t i = 0; i < num; ++i) {
+			s.Convert(dest[i],db);
+		}
+		return;
+	}
+
+	DecodeJob<T,Decoder> job(dest,num,db.reader->GetPtr(),s.size,decoder);
+	ParallelFor(static_cast<unsigned int>((num + BULK_BLOCK_SIZE - 1) / BULK_BLOCK_SIZE),db.num_threads,job);
+
+	db.reader->IncPtr(static_cast<int>(num * s.size));
+
+#ifndef ASSIMP_BUILD_BLENDER_NO_STATS
+	db.stats().fields_read += static_cast<unsigned int>(num * fields);
+#else
+	(void)fields;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// Byte order of the file differs from the host's?
+inline bool NeedsSwap(const FileDatabase& db)
+{
+#ifdef AI_BUILD_BIG_ENDIAN
+	return db.little;
+#else
+	return !db.little;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+struct MVertDecoder
+{
+	MVertDecoder(const Structure& s, const FileDatabase& db)
+		: swap(NeedsSwap(db))
+	{
+		bound = BindField(co,s,"co",3,1,ErrorPolicy_Fail,db) 
+			&& BindField(no,s,"no",3,1,ErrorPolicy_Fail,db)
+			&& BindField(flag,s,"flag",1,1,ErrorPolicy_Igno,db)
+			&& BindField(mat_nr,s,"mat_nr",1,1,ErrorPolicy_Warn,db)
+			&& BindField(bweight,s,"bweight",1,1,ErrorPolicy_Igno,db);
+	}
+
+	void operator() (MVert& dest, const int8_t* elem) const {
+		Read(dest.co,3,co,elem,swap);
+		Read(dest.no,3,no,elem,swap);
+		Read(dest.flag,flag,elem,swap);
+		Read(dest.mat_nr,mat_nr,elem,swap);
+		Read(dest.bweight,bweight,elem,swap);
+	}
+
+	RawField co, no, flag, mat_nr, bweight;
+	bool swap, bound;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct MEdgeDecoder
+{
+	MEdgeDecoder(const Structure& s, const FileDatabase& db)
+		: swap(NeedsSwap(db))
+	{
+		bound = BindField(v1,s,"v1",1,1,ErrorPolicy_Fail,db) 
+			&& BindField(v2,s,"v2",1,1,ErrorPolicy_Fail,db)
+			&& BindField(crease,s,"crease",1,1,ErrorPolicy_Igno,db)
+			&& BindField(bweight,s,"bweight",1,1,ErrorPolicy_Igno,db)
+			&& BindField(flag,s,"flag",1,1,ErrorPolicy_Igno,db);
+	}
+
+	void operator() (MEdge& dest, const int8_t* elem) const {
+		Read(dest.v1,v1,elem,swap);
+		Read(dest.v2,v2,elem,swap);
+		Read(dest.crease,crease,elem,swap);
+		Read(dest.bweight,bweight,elem,swap);
+		Read(dest.flag,flag,elem,swap);
+	}
+
+	RawField v1, v2, crease, bweight, flag;
+	bool swap, bound;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct MFaceDecoder
+{
+	MFaceDecoder(const Structure& s, const FileDatabase& db)
+		: swap(NeedsSwap(db))
+	{
+		bound = BindField(v1,s,"v1",1,1,ErrorPolicy_Fail,db) 
+			&& BindField(v2,s,"v2",1,1,ErrorPolicy_Fail,db)
+			&& BindField(v3,s,"v3",1,1,ErrorPolicy_Fail,db)
+			&& BindField(v4,s,"v4",1,1,ErrorPolicy_Fail,db)
+			&& BindField(mat_nr,s,"mat_nr",1,1,ErrorPolicy_Fail,db)
+			&& BindField(flag,s,"flag",1,1,ErrorPolicy_Igno,db);
+	}
+
+	void operator() (MFace& dest, const int8_t* elem) const {
+		Read(dest.v1,v1,elem,swap);
+		Read(dest.v2,v2,elem,swap);
+		Read(dest.v3,v3,elem,swap);
+		Read(dest.v4,v4,elem,swap);
+		Read(dest.mat_nr,mat_nr,elem,swap);
+		Read(dest.flag,flag,elem,swap);
+	}
+
+	RawField v1, v2, v3, v4, mat_nr, flag;
+	bool swap, bound;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct MTFaceDecoder
+{
+	MTFaceDecoder(const Structure& s, const FileDatabase& db)
+		: swap(NeedsSwap(db))
+	{
+		bound = BindField(uv,s,"uv",4,2,ErrorPolicy_Fail,db) 
+			&& BindField(flag,s,"flag",1,1,ErrorPolicy_Igno,db)
+			&& BindField(mode,s,"mode",1,1,ErrorPolicy_Igno,db)
+			&& BindField(tile,s,"tile",1,1,ErrorPolicy_Igno,db)
+			&& BindField(unwrap,s,"unwrap",1,1,ErrorPolicy_Igno,db);
+	}
+
+	void operator() (MTFace& dest, const int8_t* elem) const {
+		Read(&dest.uv[0][0],8,uv,elem,swap);
+		Read(dest.flag,flag,elem,swap);
+		Read(dest.mode,mode,elem,swap);
+		Read(dest.tile,tile,elem,swap);
+		Read(dest.unwrap,unwrap,elem,swap);
+	}
+
+	RawField uv, flag, mode, tile, unwrap;
+	bool swap, bound;
+};
+
+// ------------------------------------------------------------------------------------------------
+struct MColDecoder
+{
+	MColDecoder(const Structure& s, const FileDatabase& db)
+		: swap(NeedsSwap(db))
+	{
+		bound = BindField(r,s,"r",1,1,ErrorPolicy_Fail,db) 
+			&& BindField(g,s,"g",1,1,ErrorPolicy_Fail,db)
+			&& BindField(b,s,"b",1,1,ErrorPolicy_Fail,db)
+			&& BindField(a,s,"a",1,1,ErrorPolicy_Fail,db);
+	}
+
+	void operator() (MCol& dest, const int8_t* elem) const {
+		Read(dest.r,r,elem,swap);
+		Read(dest.g,g,elem,swap);
+		Read(dest.b,b,elem,swap);
+		Read(dest.a,a,elem,swap);
+	}
+
+	RawField r, g, b, a;
+	bool swap, bound;
+};
+
+} // ! anon namespace
+
+namespace Assimp {
+	namespace Blender {
+
+//--------------------------------------------------------------------------------
+template <> void Structure :: ConvertArray<MVert> (
+	MVert* dest, 
+	size_t num, 
+	const FileDatabase& db
+	) const
+{
+	const MVertDecoder decoder(*this,db);
+	DecodeArray(*this,dest,num,decoder,decoder.bound,5,db);
+}
+
+//--------------------------------------------------------------------------------
+template <> void Structure :: ConvertArray<MEdge> (
+	MEdge* dest, 
+	size_t num, 
+	const FileDatabase& db
+	) const
+{
+	const MEdgeDecoder decoder(*this,db);
+	DecodeArray(*this,dest,num,decoder,decoder.bound,5,db);
+}
+
+//--------------------------------------------------------------------------------
+template <> void Structure :: ConvertArray<MFace> (
+	MFace* dest, 
+	size_t num, 
+	const FileDatabase& db
+	) const
+{
+	const MFaceDecoder decoder(*this,db);
+	DecodeArray(*this,dest,num,decoder,decoder.bound,6,db);
+}
+
+//--------------------------------------------------------------------------------
+template <> void Structure :: ConvertArray<MTFace> (
+	MTFace* dest, 
+	size_t num, 
+	const FileDatabase& db
+	) const
+{
+	const MTFaceDecoder decoder(*this,db);
+	DecodeArray(*this,dest,num,decoder,decoder.bound,5,db);
+}
+
+//--------------------------------------------------------------------------------
+template <> void Structure :: ConvertArray<MCol> (
+	MCol* dest, 
+	size_t num, 
+	const FileDatabase& db
+	) const
+{
+	const MColDecoder decoder(*this,db);
+	DecodeArray(*this,dest,num,decoder,decoder.bound,4,db);
+}
+
+	} // ! Blender
+} // ! Assimp
+
+#endif // ASSIMP_BUILD_NO_BLEND_IMPORTER
@@ -250,6 +250,18 @@ public:
 	template <typename T> inline void Convert (T& dest,
 		const FileDatabase& db) const;
 
+	// --------------------------------------------------------
+	/** Read `num` consecutive instances of the structure from the
+	 *  stream and convert them to `T`. The generic version invokes
+	 *  #Convert for each element in turn, specializations for the
+	 *  large per-vertex and per-face arrays decode the whole block 
+	 *  at once (see BlenderBulkConvert.cpp).
+	 *  @param dest Destination array, at least `num` elements
+	 *  @param num Number of elements to be read
+	 *  @param db File database, including input stream. */
+	template <typename T> void ConvertArray (T* dest, size_t num,
+		const FileDatabase& db) const;
+
 
 
 	// --------------------------------------------------------
@@ -701,7 +713,8 @@ public:
 
 
 	FileDatabase()
-		: _cacheArrays(*this)
+		: num_threads(1)
+		, _cacheArrays(*this)
 		, _cache(*this)
 		, next_cache_idx()
 	{} 
@@ -712,6 +725,9 @@ public:
 	bool i64bit;
 	bool little;
 
+	// number of threads available for decoding large arrays
+	unsigned int num_threads;
+
 	DNA dna;
 	boost::shared_ptr< StreamReaderAny > reader;
 	vector< FileBlockHead > entries;
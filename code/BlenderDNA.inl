@@ -94,6 +94,17 @@ template <typename T> void Structure :: Convert(
 	Convert<T> (*static_cast<T*> ( in.get() ),db);
 }
 
+//--------------------------------------------------------------------------------
+template <typename T> void Structure :: ConvertArray(
+	T* dest,
+	size_t num,
+	const FileDatabase& db) const 
+{
+	for (size_t i = 0; i < num; ++i) {
+		Convert(dest[i],db);
+	}
+}
+
 //--------------------------------------------------------------------------------
 template <int error_policy, typename T, size_t M>
 void Structure :: ReadFieldArray(T (& out)[M], const char* name, const FileDatabase& db) const
@@ -334,9 +345,7 @@ void Structure :: ResolvePointer(TOUT<T>& out, const Pointer & ptrval, const Fil
 	// cache the object before we convert it to avoid cyclic recursion.
 	db.cache(out).set(s,out,ptrval); 
 
-	for (size_t i = 0; i < num; ++i,++o) {
-		s.Convert(*o,db);
-	}
+	s.ConvertArray(o,num,db);
 
 	db.reader->SetCurrentPos(pold);
 
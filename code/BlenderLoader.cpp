@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "StreamReader.h"
 #include "MemoryIOWrapper.h"
+#include "ParallelFor.h"
 
 // zlib is needed for compressed blend files 
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
@@ -89,6 +90,7 @@ static const aiImporterDesc blenderDesc = {
 // Constructor to be privately used by Importer
 BlenderImporter::BlenderImporter()
 : modifier_cache(new BlenderModifierShowcase())
+, numThreads(1)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -131,9 +133,9 @@ const aiImporterDesc* BlenderImporter::GetInfo () const
 
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties for the loader
-void BlenderImporter::SetupProperties(const Importer* /*pImp*/)
+void BlenderImporter::SetupProperties(const Importer* pImp)
 {
-	// nothing to be done for the moment
+	numThreads = GetWorkerThreadCount(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,-1));
 }
 
 struct free_it
@@ -256,6 +258,7 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
 void BlenderImporter::ParseBlendFile(FileDatabase& out, boost::shared_ptr<IOStream> stream) 
 {
 	out.reader = boost::shared_ptr<StreamReaderAny>(new StreamReaderAny(stream,out.little));
+	out.num_threads = numThreads;
 
 	DNAParser dna_reader(out);
 	const DNA* dna = NULL;
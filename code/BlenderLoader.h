@@ -216,6 +216,7 @@ private: // static stuff, mostly logging and error reporting.
 private:
 
 	Blender::BlenderModifierShowcase* modifier_cache;
+	unsigned int numThreads;
 
 }; // !class BlenderImporter
 
@@ -679,6 +679,13 @@ struct MTex : ElemBase {
 	//float zenupfac, zendownfac, blendfac;
 };
 
+// -------------------------------------------------------------------------------
+// Bulk converters for the large mesh arrays, see BlenderBulkConvert.cpp
+template <> void Structure :: ConvertArray<MVert> (MVert* dest, size_t num, const FileDatabase& db) const;
+template <> void Structure :: ConvertArray<MEdge> (MEdge* dest, size_t num, const FileDatabase& db) const;
+template <> void Structure :: ConvertArray<MFace> (MFace* dest, size_t num, const FileDatabase& db) const;
+template <> void Structure :: ConvertArray<MTFace> (MTFace* dest, size_t num, const FileDatabase& db) const;
+template <> void Structure :: ConvertArray<MCol> (MCol* dest, size_t num, const FileDatabase& db) const;
 
 	}
 }
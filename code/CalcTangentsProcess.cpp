@@ -57,6 +57,7 @@ using namespace Assimp;
 CalcTangentsProcess::CalcTangentsProcess()
 {
 	this->configMaxAngle = AI_DEG_TO_RAD(45.f);
+	this->configSourceUV = 0;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -91,9 +92,22 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("CalcTangentsProcess begin");
 
+	// some loaders return indexed vertices, tangents are computed per face so these
+	// need to be split first. JoinIdenticalVertices merges them again afterwards.
+	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) {
+		for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
+			if (!pScene->mMeshes[a]->mTangents) {
+				SplitSharedVertices(pScene,shared);
+				break;
+			}
+		}
+	}
+
 	bool bHas = false;
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
+	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
+		CheckImportCancelled();
 		if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
+	}
 
 	if (bHas)DefaultLogger::get()->info("CalcTangentsProcess finished. Tangents have been calculated");
 	else DefaultLogger::get()->debug("CalcTangentsProcess finished");
@@ -103,10 +117,9 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 // Calculates tangents and bitangents for the given mesh
 bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 {
-	// we assume that the mesh is still in the verbose vertex format where each face has its own set
-	// of vertices and no vertices are shared between faces. Sadly I don't know any quick test to 
-	// assert() it here.
-    //assert( must be verbose, dammit);
+	// we assume that the mesh is in the verbose vertex format where each face has its own set
+	// of vertices and no vertices are shared between faces. Execute() splits meshes flagged
+	// as non-verbose, but sadly I don't know any quick test to assert() it here.
 
 	if (pMesh->mTangents) // thisimplies that mBitangents is also there
 		return false;
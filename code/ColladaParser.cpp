@@ -71,8 +71,7 @@ ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
     throw DeadlyImportError( "Failed to open file " + pFile + ".");
 
 	// generate a XML reader for it
-  boost::scoped_ptr<CIrrXML_IOStreamReader> mIOWrapper( new CIrrXML_IOStreamReader( file.get()));
-	mReader = irr::io::createIrrXMLReader( mIOWrapper.get());
+	mReader = CreateIrrXMLReader( file.get());
 	if( !mReader)
 		ThrowException( "Collada: Unable to open file.");
 
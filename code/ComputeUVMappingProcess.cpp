@@ -391,8 +391,10 @@ void ComputeUVMappingProcess::Execute( aiScene* pScene)
 	DefaultLogger::get()->debug("GenUVCoordsProcess begin");
 	char buffer[1024];
 
-	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT)
-		throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
+	// some loaders return indexed vertices, these need to be split before seams can be fixed
+	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) {
+		SplitSharedVertices(pScene,shared);
+	}
 
 	std::list<MappingInfo> mappingStack;
 
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssimpPCH.h"
 #include "ConvertToLHProcess.h"
+#include "VertexTransform.h"
 
 using namespace Assimp;
 
@@ -129,17 +130,18 @@ void MakeLeftHandedProcess::ProcessNode( aiNode* pNode, const aiMatrix4x4& pPare
 // Converts a single mesh to left handed coordinates. 
 void MakeLeftHandedProcess::ProcessMesh( aiMesh* pMesh)
 {
-	// mirror positions, normals and stuff along the Z axis
-	for( size_t a = 0; a < pMesh->mNumVertices; ++a)
+	// mirror positions, normals and stuff along the Z axis. The bitangents
+	// are mirrored as well as they're derived from the texture coords, so
+	// their Z axis flips twice.
+	const aiVector3D mirrorZ( 1.0f, 1.0f, -1.0f), mirrorXY( -1.0f, -1.0f, 1.0f);
+	if( pMesh->HasPositions())
+		ScaleComponents( mirrorZ, pMesh->mVertices, pMesh->mNumVertices);
+	if( pMesh->HasNormals())
+		ScaleComponents( mirrorZ, pMesh->mNormals, pMesh->mNumVertices);
+	if( pMesh->HasTangentsAndBitangents())
 	{
-		pMesh->mVertices[a].z *= -1.0f;
-		if( pMesh->HasNormals())
-			pMesh->mNormals[a].z *= -1.0f;
-		if( pMesh->HasTangentsAndBitangents())
-		{
-			pMesh->mTangents[a].z *= -1.0f;
-			pMesh->mBitangents[a].z *= -1.0f;
-		}
+		ScaleComponents( mirrorZ, pMesh->mTangents, pMesh->mNumVertices);
+		ScaleComponents( mirrorXY, pMesh->mBitangents, pMesh->mNumVertices);
 	}
 
 	// mirror offset matrices of all bones
@@ -154,11 +156,19 @@ void MakeLeftHandedProcess::ProcessMesh( aiMesh* pMesh)
 		bone->mOffsetMatrix.c4 = -bone->mOffsetMatrix.c4;
 	}
 
-	// mirror bitangents as well as they're derived from the texture coords
-	if( pMesh->HasTangentsAndBitangents())
+	// and the same for all frames of the vertex animation
+	for( unsigned int i = 0; i < pMesh->mNumAnimMeshes; ++i)
 	{
-		for( unsigned int a = 0; a < pMesh->mNumVertices; a++)
-			pMesh->mBitangents[a] *= -1.0f;
+		aiAnimMesh* anim = pMesh->mAnimMeshes[i];
+		if( anim->HasPositions())
+			ScaleComponents( mirrorZ, anim->mVertices, anim->mNumVertices);
+		if( anim->HasNormals())
+			ScaleComponents( mirrorZ, anim->mNormals, anim->mNumVertices);
+		if( anim->HasTangentsAndBitangents())
+		{
+			ScaleComponents( mirrorZ, anim->mTangents, anim->mNumVertices);
+			ScaleComponents( mirrorXY, anim->mBitangents, anim->mNumVertices);
+		}
 	}
 }
 
@@ -266,8 +276,7 @@ void FlipUVsProcess::ProcessMesh( aiMesh* pMesh)
 		if( !pMesh->HasTextureCoords( a))
 			break;
 
-		for( unsigned int b = 0; b < pMesh->mNumVertices; b++)
-			pMesh->mTextureCoords[a][b].y = 1.0f - pMesh->mTextureCoords[a][b].y;
+		FlipUVCoords( pMesh->mTextureCoords[a], pMesh->mNumVertices);
 	}
 }
 
@@ -307,9 +316,23 @@ void FlipWindingOrderProcess::Execute( aiScene* pScene)
 void FlipWindingOrderProcess::ProcessMesh( aiMesh* pMesh)
 {
 	// invert the order of all faces in this mesh
-	for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
+	for( unsigned int a = 0; a < pMesh->mNumFaces; )
 	{
-		aiFace& face = pMesh->mFaces[a];
+		aiFace& face = pMesh->mFaces[a++];
+
+		// triangles stored back to back in the shared index array are flipped in one go
+		if( pMesh->HasSharedFaceIndices() && face.mNumIndices == 3)
+		{
+			unsigned int num = 1;
+			while( a < pMesh->mNumFaces && pMesh->mFaces[a].mNumIndices == 3 && 
+				pMesh->mFaces[a].mIndices == face.mIndices + num * 3)
+			{
+				++num;
+				++a;
+			}
+			ReverseTriangles( face.mIndices, num);
+			continue;
+		}
 		for( unsigned int b = 0; b < face.mNumIndices / 2; b++)
 			std::swap( face.mIndices[b], face.mIndices[ face.mNumIndices - 1 - b]);
 	}
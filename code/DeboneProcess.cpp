@@ -110,6 +110,11 @@ void DeboneProcess::Execute( aiScene* pScene)
 	}
 
 	if(numSplits)	{
+		// the bone influence tables shared by other steps won't match the meshes anymore
+		if(shared) {
+			shared->RemoveProperty(AI_SPP_BONE_INFLUENCES);
+		}
+
 		// we need to do something. Let's go.
 		mSubMeshIndices.clear();
 		mSubMeshIndices.resize(pScene->mNumMeshes);
@@ -54,7 +54,8 @@ class DefaultProgressHandler
 
 	
 	virtual bool Update(float /*percentage*/) {
-		return false;
+		// never abort the import
+		return true;
 	}
 
 
@@ -62,6 +62,8 @@ Here we implement only the C++ interface (Assimp::Exporter).
 
 #include "MakeVerboseFormat.h"
 #include "ConvertToLHProcess.h"
+#include "ParallelFor.h"
+#include "TinyFormatter.h"
 
 namespace Assimp {
 
@@ -73,7 +75,9 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out);
 void ExportSceneCollada(const char*,IOSystem*, const aiScene*);
 void ExportSceneObj(const char*,IOSystem*, const aiScene*);
 void ExportSceneSTL(const char*,IOSystem*, const aiScene*);
+void ExportSceneSTLBinary(const char*,IOSystem*, const aiScene*);
 void ExportScenePly(const char*,IOSystem*, const aiScene*);
+void ExportScenePlyBinary(const char*,IOSystem*, const aiScene*);
 void ExportScene3DS(const char*, IOSystem*, const aiScene*) {}
 
 // ------------------------------------------------------------------------------------------------
@@ -92,12 +96,18 @@ Exporter::ExportFormatEntry gExporters[] =
 	Exporter::ExportFormatEntry( "stl", "Stereolithography", "stl" , &ExportSceneSTL, 
 		aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_PreTransformVertices
 	),
+	Exporter::ExportFormatEntry( "stlb", "Stereolithography (binary)", "stl" , &ExportSceneSTLBinary, 
+		aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_PreTransformVertices
+	),
 #endif
 
 #ifndef ASSIMP_BUILD_NO_PLY_EXPORTER
 	Exporter::ExportFormatEntry( "ply", "Stanford Polygon Library", "ply" , &ExportScenePly, 
 		aiProcess_PreTransformVertices
 	),
+	Exporter::ExportFormatEntry( "plyb", "Stanford Polygon Library (binary)", "ply" , &ExportScenePlyBinary, 
+		aiProcess_PreTransformVertices
+	),
 #endif
 
 //#ifndef ASSIMP_BUILD_NO_3DS_EXPORTER
@@ -147,8 +157,229 @@ public:
 
 	/** Exporters, this includes those registered using #Assimp::Exporter::RegisterExporter */
 	std::vector<Exporter::ExportFormatEntry> mExporters;
+
+public:
+
+	/** Find a registered exporter by its format id, NULL if there is none */
+	const Exporter::ExportFormatEntry* FindExporter(const char* pFormatId) const;
+
+	/** Determine which post processing steps need to be run on (a copy of) 
+	 *  pScene before it is handed to a particular exporter. 
+	 *  @param verbosify Receives whether the scene needs to be converted 
+	 *    to verbose format first */
+	unsigned int GetPreprocessingSteps(const aiScene* pScene, const Exporter::ExportFormatEntry& exp,
+		unsigned int pPreprocessing, bool& verbosify) const;
+
+	/** Copy pScene and apply the given steps to the copy */
+	aiScene* PrepareScene(const aiScene* pScene, unsigned int pp, bool verbosify);
 };
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+// ------------------------------------------------------------------------------------------------
+/** IOSystem wrapper which serializes all calls to the wrapped IOSystem so exporters
+ *  running concurrently can share it. The returned streams are not wrapped. */
+class LockedIOSystem : public IOSystem
+{
+public:
+	LockedIOSystem(IOSystem* io) : io(io) {}
+
+	bool Exists( const char* pFile) const {
+		boost::mutex::scoped_lock lock(mutex);
+		return io->Exists(pFile);
+	}
+
+	char getOsSeparator() const {
+		return io->getOsSeparator();
+	}
+
+	IOStream* Open(const char* pFile, const char* pMode = "rb") {
+		boost::mutex::scoped_lock lock(mutex);
+		return io->Open(pFile,pMode);
+	}
+
+	void Close( IOStream* pFile) {
+		boost::mutex::scoped_lock lock(mutex);
+		io->Close(pFile);
+	}
+
+	bool ComparePaths (const char* one, const char* second) const {
+		boost::mutex::scoped_lock lock(mutex);
+		return io->ComparePaths(one,second);
+	}
+
+private:
+	IOSystem* const io;
+	mutable boost::mutex mutex;
+};
+#endif
+
+// ------------------------------------------------------------------------------------------------
+/** Processed copy of a scene shared by all targets of #Exporter::ExportMultiple which
+ *  need the same preprocessing */
+struct ExportGroup
+{
+	unsigned int pp;
+	bool verbosify;
+	boost::shared_ptr<aiScene> scene;
+	std::string error;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Runs the export functions of #Exporter::ExportMultiple, one job per target */
+class ExportJob
+{
+public:
+	ExportJob(IOSystem* io) : io(io) {}
+
+	void Add(const Exporter::ExportFormatEntry* exp, const aiScene* scene, Exporter::ExportTarget* target) {
+		Item item = {exp,scene,target};
+		items.push_back(item);
+	}
+
+	unsigned int GetCount() const {
+		return static_cast<unsigned int>(items.size());
+	}
+
+	void SetIOSystem(IOSystem* _io) {
+		io = _io;
+	}
+
+	void operator() (unsigned int i) {
+		const Item& item = items[i];
+		try {
+			item.exp->mExportFunction(item.target->mPath,io,item.scene);
+			item.target->mResult = AI_SUCCESS;
+		}
+		catch (std::bad_alloc&) {
+			item.target->mResult = aiReturn_OUTOFMEMORY;
+			item.target->mError = "Out of memory";
+		}
+		catch (const std::exception& err) {
+			item.target->mError = err.what();
+		}
+	}
+
+private:
+	struct Item {
+		const Exporter::ExportFormatEntry* exp;
+		const aiScene* scene;
+		Exporter::ExportTarget* target;
+	};
+
+	IOSystem* io;
+	std::vector<Item> items;
+};
+
+// ------------------------------------------------------------------------------------------------
+const Exporter::ExportFormatEntry* ExporterPimpl :: FindExporter(const char* pFormatId) const
+{
+	for (size_t i = 0; i < mExporters.size(); ++i) {
+		if (!strcmp(mExporters[i].mDescription.id,pFormatId)) {
+			return &mExporters[i];
+		}
+	}
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ExporterPimpl :: GetPreprocessingSteps(const aiScene* pScene, const Exporter::ExportFormatEntry& exp,
+	unsigned int pPreprocessing, bool& verbosify) const
+{
+	const ScenePrivateData* const priv = ScenePriv(pScene);
+
+	// steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
+	// original state before the step was applied first. When checking which steps we don't need
+	// to run, those are excluded.
+	const unsigned int nonIdempotentSteps = aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_MakeLeftHanded;
+
+	// Erase all pp steps that were already applied to this scene
+	unsigned int pp = (exp.mEnforcePP | pPreprocessing) & ~(priv 
+		? (priv->mPPStepsApplied & ~nonIdempotentSteps)
+		: 0u);
+
+	// If no extra postprocessing was specified, and we obtained this scene from an
+	// Assimp importer, apply the reverse steps automatically.
+	if (!pPreprocessing && priv) {
+		pp |= (nonIdempotentSteps & priv->mPPStepsApplied);
+	}
+
+	// If the input scene is not in verbose format, but there is at least postprocessing step that relies on it,
+	// we need to run the MakeVerboseFormat step first.
+	verbosify = false;
+	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) {
+		for( unsigned int a = 0; a < mPostProcessingSteps.size(); a++) {
+			BaseProcess* const p = mPostProcessingSteps[a];
+
+			if (p->IsActive(pp) && p->RequireVerboseFormat()) {
+				verbosify = true;
+				break;
+			}
+		}
+		verbosify = verbosify || (exp.mEnforcePP & aiProcess_JoinIdenticalVertices);
+	}
+	return pp;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene* ExporterPimpl :: PrepareScene(const aiScene* pScene, unsigned int pp, bool verbosify)
+{
+	// Always create a full copy of the scene. We might optimize this one day, 
+	// but for now it is the most pragmatic way.
+	aiScene* scenecopy_tmp;
+	SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
+
+	std::auto_ptr<aiScene> scenecopy(scenecopy_tmp);
+
+	if (verbosify) {
+		DefaultLogger::get()->debug("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
+
+		MakeVerboseFormatProcess proc;
+		proc.Execute(scenecopy.get());
+	}
+
+	if (pp) {
+		// the three 'conversion' steps need to be executed first because all other steps rely on the standard data layout
+		{
+			FlipWindingOrderProcess step;
+			if (step.IsActive(pp)) {
+				step.Execute(scenecopy.get());
+			}
+		}
+		
+		{
+			FlipUVsProcess step;
+			if (step.IsActive(pp)) {
+				step.Execute(scenecopy.get());
+			}
+		}
+
+		{
+			MakeLeftHandedProcess step;
+			if (step.IsActive(pp)) {
+				step.Execute(scenecopy.get());
+			}
+		}
+
+		// dispatch other processes
+		for( unsigned int a = 0; a < mPostProcessingSteps.size(); a++) {
+			BaseProcess* const p = mPostProcessingSteps[a];
+
+			if (p->IsActive(pp) 
+				&& !dynamic_cast<FlipUVsProcess*>(p) 
+				&& !dynamic_cast<FlipWindingOrderProcess*>(p) 
+				&& !dynamic_cast<MakeLeftHandedProcess*>(p)) {
+
+				p->Execute(scenecopy.get());
+			}
+		}
+		ScenePrivateData* const privOut = ScenePriv(scenecopy.get());
+		ai_assert(privOut);
+
+		privOut->mPPStepsApplied |= pp;
+	}
+	return scenecopy.release();
+}
+
 
 } // end of namespace Assimp
 
@@ -227,110 +458,98 @@ aiReturn Exporter :: Export( const aiScene* pScene, const char* pFormatId, const
 	ASSIMP_BEGIN_EXCEPTION_REGION();
 
 	pimpl->mError = "";
-	for (size_t i = 0; i < pimpl->mExporters.size(); ++i) {
-		const Exporter::ExportFormatEntry& exp = pimpl->mExporters[i];
-		if (!strcmp(exp.mDescription.id,pFormatId)) {
+	const Exporter::ExportFormatEntry* const exp = pimpl->FindExporter(pFormatId);
+	if (exp) {
+		try {
+			bool verbosify;
+			const unsigned int pp = pimpl->GetPreprocessingSteps(pScene,*exp,pPreprocessing,verbosify);
+
+			std::auto_ptr<aiScene> scenecopy(pimpl->PrepareScene(pScene,pp,verbosify));
+			exp->mExportFunction(pPath,pimpl->mIOSystem.get(),scenecopy.get());
+		}
+		catch (DeadlyExportError& err) {
+			pimpl->mError = err.what();
+			return AI_FAILURE;
+		}
+		return AI_SUCCESS;
+	}
 
-			try {
+	pimpl->mError = std::string("Found no exporter to handle this file format: ") + pFormatId;
+	ASSIMP_END_EXCEPTION_REGION(aiReturn);
+	return AI_FAILURE;
+}
+
+
+// ------------------------------------------------------------------------------------------------
+aiReturn Exporter :: ExportMultiple( const aiScene* pScene, ExportTarget* pTargets, size_t pNumTargets, 
+	unsigned int pPreprocessing, int pNumThreads)
+{
+	ASSIMP_BEGIN_EXCEPTION_REGION();
+
+	pimpl->mError = "";
+
+	// Targets which need the same preprocessing share one processed copy of the scene
+	std::vector<ExportGroup> groups;
+
+	ExportJob job(pimpl->mIOSystem.get());
+	for (size_t i = 0; i < pNumTargets; ++i) {
+		ExportTarget& target = pTargets[i];
+		target.mResult = AI_FAILURE;
+		target.mError = "";
 
-				// Always create a full copy of the scene. We might optimize this one day, 
-				// but for now it is the most pragmatic way.
-				aiScene* scenecopy_tmp;
-				SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
-
-				std::auto_ptr<aiScene> scenecopy(scenecopy_tmp);
-				const ScenePrivateData* const priv = ScenePriv(pScene);
-
-				// steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
-				// original state before the step was applied first. When checking which steps we don't need
-				// to run, those are excluded.
-				const unsigned int nonIdempotentSteps = aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_MakeLeftHanded;
-
-				// Erase all pp steps that were already applied to this scene
-				unsigned int pp = (exp.mEnforcePP | pPreprocessing) & ~(priv 
-					? (priv->mPPStepsApplied & ~nonIdempotentSteps)
-					: 0u);
-
-				// If no extra postprocessing was specified, and we obtained this scene from an
-				// Assimp importer, apply the reverse steps automatically.
-				if (!pPreprocessing && priv) {
-					pp |= (nonIdempotentSteps & priv->mPPStepsApplied);
-				}
-
-				// If the input scene is not in verbose format, but there is at least postprocessing step that relies on it,
-				// we need to run the MakeVerboseFormat step first.
-				if (scenecopy->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) {
-					
-					bool verbosify = false;
-					for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
-						BaseProcess* const p = pimpl->mPostProcessingSteps[a];
-
-						if (p->IsActive(pp) && p->RequireVerboseFormat()) {
-							verbosify = true;
-							break;
-						}
-					}
-
-					if (verbosify || (exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {
-						DefaultLogger::get()->debug("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
-
-						MakeVerboseFormatProcess proc;
-						proc.Execute(scenecopy.get());
-					}
-				}
-
-				if (pp) {
-					// the three 'conversion' steps need to be executed first because all other steps rely on the standard data layout
-					{
-						FlipWindingOrderProcess step;
-						if (step.IsActive(pp)) {
-							step.Execute(scenecopy.get());
-						}
-					}
-					
-					{
-						FlipUVsProcess step;
-						if (step.IsActive(pp)) {
-							step.Execute(scenecopy.get());
-						}
-					}
-
-					{
-						MakeLeftHandedProcess step;
-						if (step.IsActive(pp)) {
-							step.Execute(scenecopy.get());
-						}
-					}
-
-					// dispatch other processes
-					for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
-						BaseProcess* const p = pimpl->mPostProcessingSteps[a];
-
-						if (p->IsActive(pp) 
-							&& !dynamic_cast<FlipUVsProcess*>(p) 
-							&& !dynamic_cast<FlipWindingOrderProcess*>(p) 
-							&& !dynamic_cast<MakeLeftHandedProcess*>(p)) {
-
-							p->Execute(scenecopy.get());
-						}
-					}
-					ScenePrivateData* const privOut = ScenePriv(scenecopy.get());
-					ai_assert(privOut);
-
-					privOut->mPPStepsApplied |= pp;
-				}
-
-				exp.mExportFunction(pPath,pimpl->mIOSystem.get(),scenecopy.get());
+		const ExportFormatEntry* const exp = pimpl->FindExporter(target.mFormatId);
+		if (!exp) {
+			target.mError = std::string("Found no exporter to handle this file format: ") + target.mFormatId;
+			continue;
+		}
+
+		bool verbosify;
+		const unsigned int pp = pimpl->GetPreprocessingSteps(pScene,*exp,pPreprocessing,verbosify);
+
+		size_t g = 0;
+		while (g < groups.size() && (groups[g].pp != pp || groups[g].verbosify != verbosify)) {
+			++g;
+		}
+		if (g == groups.size()) {
+			ExportGroup group;
+			group.pp = pp;
+			group.verbosify = verbosify;
+			try {
+				group.scene = boost::shared_ptr<aiScene>(pimpl->PrepareScene(pScene,pp,verbosify));
 			}
 			catch (DeadlyExportError& err) {
-				pimpl->mError = err.what();
-				return AI_FAILURE;
+				group.error = err.what();
 			}
-			return AI_SUCCESS;
+			groups.push_back(group);
+		}
+
+		if (!groups[g].scene) {
+			target.mError = groups[g].error;
+			continue;
 		}
+		job.Add(exp,groups[g].scene.get(),&target);
 	}
 
-	pimpl->mError = std::string("Found no exporter to handle this file format: ") + pFormatId;
+	if (job.GetCount()) {
+		DefaultLogger::get()->debug((Formatter::format("export: writing "),job.GetCount(),
+			" file(s) from ",groups.size()," processed copies of the scene"));
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		LockedIOSystem io(pimpl->mIOSystem.get());
+		job.SetIOSystem(&io);
+#endif
+		ParallelFor(job.GetCount(),GetWorkerThreadCount(pNumThreads),job);
+	}
+
+	// report the first failure
+	for (size_t i = 0; i < pNumTargets; ++i) {
+		if (pTargets[i].mResult != AI_SUCCESS) {
+			pimpl->mError = pTargets[i].mError;
+			return pTargets[i].mResult;
+		}
+	}
+	return AI_SUCCESS;
+
 	ASSIMP_END_EXCEPTION_REGION(aiReturn);
 	return AI_FAILURE;
 }
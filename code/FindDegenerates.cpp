@@ -188,8 +188,11 @@ evil_jump_outside:
 				}
 			}
 			else {
-				// Otherwise delete it if we don't need this face
-				delete[] face_src.mIndices;
+				// Otherwise delete it if we don't need this face. Shared
+				// indices are left unreferenced in aiMesh::mFaceIndices.
+				if (!mesh->HasSharedFaceIndices()) {
+					delete[] face_src.mIndices;
+				}
 				face_src.mIndices = NULL;
 				face_src.mNumIndices = 0;
 			}
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssimpPCH.h"
 #include "GenFaceNormalsProcess.h"
+#include "ProcessHelper.h"
 
 
 using namespace Assimp;
@@ -76,8 +77,14 @@ void GenFaceNormalsProcess::Execute( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("GenFaceNormalsProcess begin");
 
+	// some loaders return indexed vertices, these need to be split before face normals can be assigned
 	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) {
-		throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
+		for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
+			if (!pScene->mMeshes[a]->HasNormals()) {
+				SplitSharedVertices(pScene,shared);
+				break;
+			}
+		}
 	}
 
 	bool bHas = false;
@@ -87,12 +87,20 @@ void GenVertexNormalsProcess::Execute( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("GenVertexNormalsProcess begin");
 
-	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT)
-		throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
+	// some loaders return indexed vertices, these need to be split before normals are smoothed
+	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) {
+		for( unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+			if (!pScene->mMeshes[a]->HasNormals()) {
+				SplitSharedVertices(pScene,shared);
+				break;
+			}
+		}
+	}
 
 	bool bHas = false;
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
 	{
+		CheckImportCancelled();
 		if(GenMeshVertexNormals( pScene->mMeshes[a],a))
 			bHas = true;
 	}
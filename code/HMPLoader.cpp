@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "HMPLoader.h"
 #include "MD2FileData.h"
+#include "TerrainMeshBuilder.h"
 
 using namespace Assimp;
 
@@ -66,6 +67,8 @@ static const aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 HMPImporter::HMPImporter()
+: configTileSize (0)
+, configLODLevels (0)
 {
 	// nothing to do here
 }
@@ -103,6 +106,26 @@ const aiImporterDesc* HMPImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Files start with one of these tokens
+void HMPImporter::GetMagicTokens (std::vector<uint32_t>& tokens) const
+{
+	tokens.push_back(AI_HMP_MAGIC_NUMBER_LE_4);
+	tokens.push_back(AI_HMP_MAGIC_NUMBER_LE_5);
+	tokens.push_back(AI_HMP_MAGIC_NUMBER_LE_7);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the loader
+void HMPImporter::SetupProperties(const Importer* pImp)
+{
+	MDLImporter::SetupProperties(pImp);
+
+	// AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE, AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS
+	configTileSize  = std::max(0,pImp->GetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE,0));
+	configLODLevels = std::max(0,pImp->GetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS,0));
+}
+
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure. 
 void HMPImporter::InternReadFile( const std::string& pFile, 
@@ -249,16 +272,13 @@ void HMPImporter::InternReadFile_HMP5( )
 	if (pcHeader->numskins)
 		GenerateTextureCoords(width,height);
 
-	// now build a list of faces
-	CreateOutputFaceList(width,height);	
-
 	// there is no nodegraph in HMP files. Simply assign the one mesh
-	// (no, not the one ring) to the root node
+	// (no, not the one ring) - or the terrain tiles - to the root node
 	pScene->mRootNode = new aiNode();
 	pScene->mRootNode->mName.Set("terrain_root");
-	pScene->mRootNode->mNumMeshes = 1;
-	pScene->mRootNode->mMeshes = new unsigned int[1];
-	pScene->mRootNode->mMeshes[0] = 0;
+
+	// now build a list of faces
+	CreateOutputFaceList(width,height);	
 }
 
 // ------------------------------------------------------------------------------------------------ 
@@ -318,16 +338,13 @@ void HMPImporter::InternReadFile_HMP7( )
 	// generate texture coordinates if necessary
 	if (pcHeader->numskins)GenerateTextureCoords(width,height);
 
-	// now build a list of faces
-	CreateOutputFaceList(width,height);	
-
 	// there is no nodegraph in HMP files. Simply assign the one mesh
-	// (no, not the One Ring) to the root node
+	// (no, not the One Ring) - or the terrain tiles - to the root node
 	pScene->mRootNode = new aiNode();
 	pScene->mRootNode->mName.Set("terrain_root");
-	pScene->mRootNode->mNumMeshes = 1;
-	pScene->mRootNode->mMeshes = new unsigned int[1];
-	pScene->mRootNode->mMeshes[0] = 0;
+
+	// now build a list of faces
+	CreateOutputFaceList(width,height);	
 }
 
 // ------------------------------------------------------------------------------------------------ 
@@ -377,64 +394,10 @@ void HMPImporter::CreateMaterial(const unsigned char* szCurrent,
 // ------------------------------------------------------------------------------------------------ 
 void HMPImporter::CreateOutputFaceList(unsigned int width,unsigned int height)
 {
-	aiMesh* const pcMesh = this->pScene->mMeshes[0];
-
-	// Allocate enough storage
-	pcMesh->mNumFaces = (width-1) * (height-1);
-	pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
-
-	pcMesh->mNumVertices   = pcMesh->mNumFaces*4;
-	aiVector3D* pcVertices = new aiVector3D[pcMesh->mNumVertices];
-	aiVector3D* pcNormals  = new aiVector3D[pcMesh->mNumVertices];
-
-	aiFace* pcFaceOut(pcMesh->mFaces);
-	aiVector3D* pcVertOut = pcVertices;
-	aiVector3D* pcNorOut = pcNormals;
-
-	aiVector3D* pcUVs = pcMesh->mTextureCoords[0] ? new aiVector3D[pcMesh->mNumVertices] : NULL;
-	aiVector3D* pcUVOut(pcUVs);
-
-	// Build the terrain square
-	unsigned int iCurrent = 0;
-	for (unsigned int y = 0; y < height-1;++y)	{
-		for (unsigned int x = 0; x < width-1;++x,++pcFaceOut)	{
-			pcFaceOut->mNumIndices = 4;
-			pcFaceOut->mIndices = new unsigned int[4];
-
-			*pcVertOut++ = pcMesh->mVertices[y*width+x];
-			*pcVertOut++ = pcMesh->mVertices[(y+1)*width+x];
-			*pcVertOut++ = pcMesh->mVertices[(y+1)*width+x+1];
-			*pcVertOut++ = pcMesh->mVertices[y*width+x+1];
-			
+	// the mesh holds the grid of vertices read from the file so far
+	pScene->mMeshes[0]->mNumVertices = width*height;
 
-			*pcNorOut++ = pcMesh->mNormals[y*width+x];
-			*pcNorOut++ = pcMesh->mNormals[(y+1)*width+x];
-			*pcNorOut++ = pcMesh->mNormals[(y+1)*width+x+1];
-			*pcNorOut++ = pcMesh->mNormals[y*width+x+1];
-
-			if (pcMesh->mTextureCoords[0])
-			{
-				*pcUVOut++ = pcMesh->mTextureCoords[0][y*width+x];
-				*pcUVOut++ = pcMesh->mTextureCoords[0][(y+1)*width+x];
-				*pcUVOut++ = pcMesh->mTextureCoords[0][(y+1)*width+x+1];
-				*pcUVOut++ = pcMesh->mTextureCoords[0][y*width+x+1];
-			}
-			
-			for (unsigned int i = 0; i < 4;++i)
-				pcFaceOut->mIndices[i] = iCurrent++;
-		}
-	}
-	delete[] pcMesh->mVertices;
-	pcMesh->mVertices = pcVertices;
-
-	delete[] pcMesh->mNormals;
-	pcMesh->mNormals = pcNormals;
-
-	if (pcMesh->mTextureCoords[0])
-	{
-		delete[] pcMesh->mTextureCoords[0];
-		pcMesh->mTextureCoords[0] = pcUVs;
-	}
+	TerrainMeshBuilder(configTileSize,configLODLevels).Build(pScene,width,height,pScene->mRootNode);
 }
 
 // ------------------------------------------------------------------------------------------------ 
@@ -76,6 +76,13 @@ public:
 	bool CanRead( const std::string& pFile, IOSystem* pIOHandler, 
 		bool checkSig) const;
 
+	// -------------------------------------------------------------------
+	/** Called prior to ReadFile().
+	* The function is a request to the importer to update its configuration
+	* basing on the Importer's configuration property list.
+	*/
+	void SetupProperties(const Importer* pImp);
+
 protected:
 
 
@@ -85,6 +92,12 @@ protected:
 	 */
 	const aiImporterDesc* GetInfo () const;
 
+	// -------------------------------------------------------------------
+	/** Return the tokens at the start of files in this format.
+	 * See #BaseImporter::GetMagicTokens for the details
+	 */
+	void GetMagicTokens (std::vector<uint32_t>& tokens) const;
+
 	// -------------------------------------------------------------------
 	/** Imports the given file into the given scene structure. 
 	* See BaseImporter::InternReadFile() for details
@@ -122,10 +135,11 @@ protected:
 		const unsigned char** szCurrentOut);
 
 	// -------------------------------------------------------------------
-	/** Build a list of output faces and vertices. The function 
-	 *  triangulates the height map read from the file
+	/** Build a list of output faces and vertices from the height map
+	 *  read from the file, either as a single mesh or as tiles, and 
+	 *  assign them to the root node. See TerrainMeshBuilder.
 	 * \param width Width of the height field
-	 * \param width Height of the height field
+	 * \param height Height of the height field
 	*/
 	void CreateOutputFaceList(unsigned int width,unsigned int height);
 
@@ -147,6 +161,8 @@ protected:
 
 private:
 
+	/** Configuration option: tile size and number of LOD levels for the terrain */
+	unsigned int configTileSize, configLODLevels;
 };
 
 } // end of namespace Assimp
@@ -899,8 +899,8 @@ void IRRImporter::InternReadFile( const std::string& pFile,
 		throw DeadlyImportError( "Failed to open IRR file " + pFile + "");
 
 	// Construct the irrXML parser
-	CIrrXML_IOStreamReader st(file.get());
-	reader = createIrrXMLReader((IFileReadCallBack*) &st);
+	boost::scoped_ptr<IrrXMLReader> read( CreateIrrXMLReader(file.get()) );
+	reader = read.get();
 
 	// The root node of the scene
 	Node* root = new Node(Node::DUMMY);
@@ -120,8 +120,7 @@ void IRRMeshImporter::InternReadFile( const std::string& pFile,
 		throw DeadlyImportError( "Failed to open IRRMESH file " + pFile + "");
 
 	// Construct the irrXML parser
-	CIrrXML_IOStreamReader st(file.get());
-	reader = createIrrXMLReader((IFileReadCallBack*) &st);
+	reader = CreateIrrXMLReader(file.get());
 
 	// final data
 	std::vector<aiMaterial*> materials;
@@ -71,6 +71,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "ScenePreprocessor.h"
 #include "MemoryIOWrapper.h"
+#include "ProbeIOWrapper.h"
+#include "SceneArena.h"
 #include "Profiler.h"
 #include "TinyFormatter.h"
 
@@ -78,6 +80,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #	include "ValidateDataStructure.h"
 #endif
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/thread.hpp>
+#	include <boost/thread/mutex.hpp>
+#endif
+
 using namespace Assimp::Profiling;
 using namespace Assimp::Formatter;
 
@@ -131,6 +138,212 @@ void AllocateFromAssimpHeap::operator delete[] ( void* data)	{
 	return ::operator delete[](data);
 }
 
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Cancellation flag and worker thread of an Importer, see Importer::ReadFileAsync() */
+struct ImportControl
+{
+	ImportControl()
+		: cancelled()
+		, async()
+		, reading()
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		, done()
+		, thread()
+#endif
+	{}
+
+	void SetCancelled(bool c) {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		boost::mutex::scoped_lock lock(mutex);
+#endif
+		cancelled = c;
+	}
+
+	bool IsCancelled() {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		boost::mutex::scoped_lock lock(mutex);
+#endif
+		return cancelled;
+	}
+
+	/** Set by Importer::CancelReadFile() or if the progress handler asks to abort */
+	bool cancelled;
+
+	/** An import started by Importer::ReadFileAsync() has not been collected yet. 
+	 *  Only accessed by the thread owning the Importer. */
+	bool async;
+
+	/** Importer::ReadFile() is running, only accessed by the importing thread */
+	bool reading;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	/** The worker thread has finished */
+	bool done;
+
+	boost::thread* thread;
+	boost::mutex mutex;
+#endif
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Marks the lifetime of an Importer::ReadFile() call */
+struct ReadingScope
+{
+	ReadingScope(ImportControl* control) : control(control) {
+		control->reading = true;
+	}
+	~ReadingScope() {
+		control->reading = false;
+	}
+	ImportControl* const control;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Worker of Importer::ReadFileAsync() */
+struct AsyncReadFile
+{
+	Importer* importer;
+	std::string file;
+	unsigned int flags;
+
+	void operator() () {
+		const aiScene* scene = importer->ReadFile(file.c_str(),flags);
+		importer->GetProgressHandler()->ReadFileFinished(scene);
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		ImportControl* const control = importer->Pimpl()->mControl;
+
+		boost::mutex::scoped_lock lock(control->mutex);
+		control->done = true;
+#endif
+	}
+};
+
+} // ! Assimp
+
+// ------------------------------------------------------------------------------------------------
+bool ImporterPimpl::UpdateProgress(ProgressHandler::Phase phase, unsigned int current, unsigned int total) const
+{
+	if (!mProgressHandler->UpdatePhase(phase,current,total)) {
+		mControl->SetCancelled(true);
+	}
+	return !mControl->IsCancelled();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImporterPimpl::IsCancelled() const
+{
+	return mControl->IsCancelled();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImporterPimpl::RecordStepMemory(unsigned int step, ai_uint64 before)
+{
+	aiStepMemoryInfo rec;
+	rec.step   = step;
+	rec.before = before;
+	Importer::GetMemoryRequirements(mScene,rec.detail);
+	rec.after  = rec.detail.total;
+
+	rec.highWater = std::max(rec.before,rec.after);
+	if (!mStepMemory.empty()) {
+		rec.highWater = std::max(rec.highWater,mStepMemory.back().highWater);
+	}
+	mStepMemory.push_back(rec);
+
+	DefaultLogger::get()->info((Formatter::format("Scene memory after step 0x"),std::hex,step,std::dec,
+		": ",rec.after," B (before: ",rec.before," B, high-water mark: ",rec.highWater," B)"));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Find the #aiPostProcessSteps flags a step has been activated by. Internal helper
+// steps, such as the spatial sort shared by several steps, respond to more than one.
+static unsigned int GetStepFlags(const BaseProcess* process, unsigned int pFlags)
+{
+	unsigned int flags = 0;
+	for (unsigned int bit = 1; bit && bit <= pFlags; bit <<= 1) {
+		if ((pFlags & bit) && process->IsActive(bit)) {
+			flags |= bit;
+		}
+	}
+	return flags;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Rebuild the extension lookup table from the aiImporterDesc of all importers and the 
+// signature lookup table from their magic tokens
+static void UpdateExtensionMap(ImporterPimpl* pimpl)
+{
+	pimpl->mExtensionMap.clear();
+	pimpl->mSignatureMap.clear();
+
+	std::set<std::string> str;
+	std::vector<uint32_t> tokens;
+	for (unsigned int a = 0; a < pimpl->mImporter.size(); ++a) {
+		str.clear();
+		pimpl->mImporter[a]->GetExtensionList(str);
+
+		for (std::set<std::string>::const_iterator it = str.begin(); it != str.end(); ++it) {
+			std::string ext = *it;
+			std::transform(ext.begin(),ext.end(),ext.begin(),::tolower);
+
+			pimpl->mExtensionMap[ext].push_back(a);
+		}
+
+		// CheckMagicToken() accepts four byte tokens in both byte orders
+		tokens.clear();
+		pimpl->mImporter[a]->GetMagicTokens(tokens);
+		for (std::vector<uint32_t>::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+			uint32_t swapped = *it;
+			ByteSwap::Swap(&swapped);
+
+			const uint32_t both[] = {*it,swapped};
+			for (unsigned int i = 0; i < 2; ++i) {
+				std::vector<unsigned int>& importers = pimpl->mSignatureMap[both[i]];
+				if (importers.empty() || importers.back() != a) {
+					importers.push_back(a);
+				}
+			}
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Delete the current scene, which might live in the scene arena
+static void DeleteScene(ImporterPimpl* pimpl)
+{
+	if (pimpl->mScene && ScenePriv(pimpl->mScene)->mArena) {
+		DestroyArenaScene(pimpl->mScene);
+		pimpl->mArena->Reset();
+	}
+	else delete pimpl->mScene;
+	pimpl->mScene = NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replace the current scene by a copy in the scene arena
+static void MoveSceneToArena(ImporterPimpl* pimpl)
+{
+	if (!pimpl->mArena) {
+		pimpl->mArena = new SceneArena();
+	}
+
+	aiScene* pooled = CopySceneToArena(pimpl->mScene,*pimpl->mArena);
+	delete pimpl->mScene;
+	pimpl->mScene = pooled;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replace the current scene by a regular heap-allocated copy
+static void MoveSceneToHeap(ImporterPimpl* pimpl)
+{
+	aiScene* s = CopySceneToHeap(pimpl->mScene);
+	DeleteScene(pimpl);
+	pimpl->mScene = s;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Importer constructor. 
 Importer::Importer() 
@@ -139,6 +352,7 @@ Importer::Importer()
 	pimpl = new ImporterPimpl();
 
 	pimpl->mScene = NULL;
+	pimpl->mArena = NULL;
 	pimpl->mErrorString = "";
 
 	// Allocate a default IO handler
@@ -149,8 +363,11 @@ Importer::Importer()
 	pimpl->mProgressHandler = new DefaultProgressHandler();
 	pimpl->mIsDefaultProgressHandler = true;
 
+	pimpl->mControl = new ImportControl();
+
 	GetImporterInstanceList(pimpl->mImporter);
 	GetPostProcessingStepInstanceList(pimpl->mPostProcessingSteps);
+	UpdateExtensionMap(pimpl);
 
 	// Allocate a SharedPostProcessInfo object and store pointers to it in all post-process steps in the list.
 	pimpl->mPPShared = new SharedPostProcessInfo();
@@ -166,6 +383,12 @@ Importer::Importer()
 // Destructor of Importer
 Importer::~Importer()
 {
+	// Abandon any pending asynchronous import
+	if (pimpl->mControl->async) {
+		CancelReadFile();
+		WaitForReadFile();
+	}
+
 	// Delete all import plugins
 	for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)
 		delete pimpl->mImporter[a];
@@ -179,11 +402,14 @@ Importer::~Importer()
 	delete pimpl->mProgressHandler;
 
 	// Kill imported scene. Destructors should do that recursivly
-	delete pimpl->mScene;
+	DeleteScene(pimpl);
+	delete pimpl->mArena;
 
 	// Delete shared post-processing data
 	delete pimpl->mPPShared;
 
+	delete pimpl->mControl;
+
 	// and finally the pimpl itself
 	delete pimpl;
 }
@@ -242,6 +468,7 @@ aiReturn Importer::RegisterLoader(BaseImporter* pImp)
 
 	// add the loader
 	pimpl->mImporter.push_back(pImp);
+	UpdateExtensionMap(pimpl);
 	DefaultLogger::get()->info("Registering custom importer for these file extensions: " + baked);
 	ASSIMP_END_EXCEPTION_REGION(aiReturn);
 	return AI_SUCCESS;
@@ -262,6 +489,7 @@ aiReturn Importer::UnregisterLoader(BaseImporter* pImp)
 
 	if (it != pimpl->mImporter.end())	{
 		pimpl->mImporter.erase(it);
+		UpdateExtensionMap(pimpl);
 
 		std::set<std::string> st;
 		pImp->GetExtensionList(st);
@@ -389,9 +617,9 @@ bool _ValidateFlags(unsigned int pFlags)
 void Importer::FreeScene( )
 {
 	ASSIMP_BEGIN_EXCEPTION_REGION();
-	delete pimpl->mScene;
-	pimpl->mScene = NULL;
+	DeleteScene(pimpl);
 
+	pimpl->mStepMemory.clear();
 	pimpl->mErrorString = "";
 	ASSIMP_END_EXCEPTION_REGION(void);
 }
@@ -422,9 +650,15 @@ const aiScene* Importer::GetScene() const
 // Orphan the current scene and return it.
 aiScene* Importer::GetOrphanedScene()
 {
-	aiScene* s = pimpl->mScene;
+	aiScene* s = NULL;
 
 	ASSIMP_BEGIN_EXCEPTION_REGION();
+	// the caller takes ownership, so the scene may not stay in our arena
+	if (pimpl->mScene && ScenePriv(pimpl->mScene)->mArena) {
+		MoveSceneToHeap(pimpl);
+	}
+
+	s = pimpl->mScene;
 	pimpl->mScene = NULL;
 
 	pimpl->mErrorString = ""; /* reset error string */
@@ -583,6 +817,12 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
 	WriteLogOpening(pFile);
 
+	// A cancellation request for an asynchronous import must not get lost
+	if (!pimpl->mControl->async) {
+		pimpl->mControl->SetCancelled(false);
+	}
+	ReadingScope reading(pimpl->mControl);
+
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
 	try
 #endif // ! ASSIMP_CATCH_GLOBAL_EXCEPTIONS
@@ -603,34 +843,77 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			return NULL;
 		}
 
+		pimpl->mStepMemory.clear();
+
 		boost::scoped_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
 		if (profiler) {
 			profiler->BeginRegion("total");
 		}
 
-		// Find an worker class which can handle the file
+		// Find an worker class which can handle the file. The importers which list
+		// the file extension in their description are asked first, then all others
+		// in case they accept extensions they don't list. Files without extension
+		// are left to signature-based detection.
 		BaseImporter* imp = NULL;
-		for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
+		const std::string extension = BaseImporter::GetExtension(pFile);
+		if (extension.length()) {
+			std::vector<bool> asked(pimpl->mImporter.size(),false);
 
-			if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, false)) {
-				imp = pimpl->mImporter[a];
-				break;
+			const ImporterPimpl::ExtensionMap::const_iterator ext = pimpl->mExtensionMap.find(extension);
+			if (ext != pimpl->mExtensionMap.end()) {
+				for (std::vector<unsigned int>::const_iterator it = (*ext).second.begin(); it != (*ext).second.end(); ++it) {
+
+					asked[*it] = true;
+					if( pimpl->mImporter[*it]->CanRead( pFile, pimpl->mIOHandler, false)) {
+						imp = pimpl->mImporter[*it];
+						break;
+					}
+				}
+			}
+
+			for( unsigned int a = 0; !imp && a < pimpl->mImporter.size(); a++)	{
+
+				if( !asked[a] && pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, false)) {
+					imp = pimpl->mImporter[a];
+				}
 			}
 		}
 
 		if (!imp)	{
 			// not so bad yet ... try format auto detection.
-			const std::string::size_type s = pFile.find_last_of('.');
-			if (s != std::string::npos) {
-				DefaultLogger::get()->info("File extension not known, trying signature-based detection");
-				for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
-
-					if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
-						imp = pimpl->mImporter[a];
-						break;
+			DefaultLogger::get()->info("File extension not known, trying signature-based detection");
+
+			// read the head of the file only once for all importers
+			ProbeIOSystem probe(pimpl->mIOHandler,pFile);
+			std::vector<bool> asked(pimpl->mImporter.size(),false);
+
+			// the importers which registered the first bytes of the file as magic token are
+			// asked first, then all others in registration order
+			const std::vector<uint8_t>& head = probe.GetHead();
+			if (head.size() >= 4) {
+				uint32_t token;
+				::memcpy(&token,&head[0],4);
+
+				const ImporterPimpl::SignatureMap::const_iterator sig = pimpl->mSignatureMap.find(token);
+				if (sig != pimpl->mSignatureMap.end()) {
+					for (std::vector<unsigned int>::const_iterator it = (*sig).second.begin(); it != (*sig).second.end(); ++it) {
+
+						asked[*it] = true;
+						if( pimpl->mImporter[*it]->CanRead( pFile, &probe, true)) {
+							imp = pimpl->mImporter[*it];
+							break;
+						}
 					}
 				}
 			}
+
+			for( unsigned int a = 0; !imp && a < pimpl->mImporter.size(); a++)	{
+
+				if( !asked[a] && pimpl->mImporter[a]->CanRead( pFile, &probe, true)) {
+					imp = pimpl->mImporter[a];
+				}
+			}
+
 			// Put a proper error message if no suitable importer was found
 			if( !imp)	{
 				pimpl->mErrorString = "No suitable reader found for the file format of file \"" + pFile + "\".";
@@ -641,14 +924,13 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
 		// Dispatch the reading to the worker class for this format
 		DefaultLogger::get()->info("Found a matching importer for this file format");
-		pimpl->mProgressHandler->Update();
 
 		if (profiler) {
 			profiler->BeginRegion("import");
 		}
 
+		// the importer reports the read, parse and convert phases
 		pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
-		pimpl->mProgressHandler->Update();
 
 		if (profiler) {
 			profiler->EndRegion("import");
@@ -677,11 +959,14 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			ScenePreprocessor pre(pimpl->mScene);
 			pre.ProcessScene();
 
-			pimpl->mProgressHandler->Update();
 			if (profiler) {
 				profiler->EndRegion("preprocess");
 			}
 
+			if (GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_MEMORY,0)) {
+				pimpl->RecordStepMemory(0,0);
+			}
+
 			// Ensure that the validation process won't be called twice
 			ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
 		}
@@ -693,6 +978,11 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 		// clear any data allocated by post-process steps
 		pimpl->mPPShared->Clean();
 
+		// move the final scene into the arena, if requested
+		if (pimpl->mScene && GetPropertyInteger(AI_CONFIG_GLOB_SCENE_POOL,0)) {
+			MoveSceneToArena(pimpl);
+		}
+
 		if (profiler) {
 			profiler->EndRegion("total");
 		}
@@ -708,7 +998,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 #endif
 
 		DefaultLogger::get()->error(pimpl->mErrorString);
-		delete pimpl->mScene; pimpl->mScene = NULL;
+		DeleteScene(pimpl);
 	}
 #endif // ! ASSIMP_CATCH_GLOBAL_EXCEPTIONS
 
@@ -718,6 +1008,80 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// Starts reading the given file on a worker thread
+bool Importer::ReadFileAsync( const char* pFile, unsigned int pFlags)
+{
+	ImportControl* const control = pimpl->mControl;
+	if (control->async) {
+		pimpl->mErrorString = "An asynchronous import is already pending";
+		DefaultLogger::get()->error(pimpl->mErrorString);
+		return false;
+	}
+
+	AsyncReadFile job;
+	job.importer = this;
+	job.file = pFile;
+	job.flags = pFlags;
+
+	control->SetCancelled(false);
+	control->async = true;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	control->done = false;
+	try {
+		control->thread = new boost::thread(job);
+	}
+	catch (const std::exception& e) {
+		control->async = false;
+		pimpl->mErrorString = std::string("Failed to start the import thread: ") + e.what();
+		DefaultLogger::get()->error(pimpl->mErrorString);
+		return false;
+	}
+#else
+	// no threading support, import synchronously
+	job();
+#endif
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether the asynchronous import has finished
+bool Importer::IsReadFileDone() const
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	ImportControl* const control = pimpl->mControl;
+	if (control->thread) {
+		boost::mutex::scoped_lock lock(control->mutex);
+		return control->done;
+	}
+#endif
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Waits for the asynchronous import to finish
+const aiScene* Importer::WaitForReadFile()
+{
+	ImportControl* const control = pimpl->mControl;
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	if (control->thread) {
+		control->thread->join();
+		delete control->thread;
+		control->thread = NULL;
+	}
+#endif
+	control->async = false;
+	return pimpl->mScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Requests the running import to stop
+void Importer::CancelReadFile()
+{
+	pimpl->mControl->SetCancelled(true);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Apply post-processing to the currently bound scene
 const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
@@ -737,6 +1101,17 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	ai_assert(_ValidateFlags(pFlags));
 	DefaultLogger::get()->info("Entering post processing pipeline");
 
+	// Called directly, not as part of an import
+	if (!pimpl->mControl->reading && !pimpl->mControl->async) {
+		pimpl->mControl->SetCancelled(false);
+	}
+
+	// Post-processing steps modify the scene, so it may not stay in the arena
+	const bool pooled = ScenePriv(pimpl->mScene)->mArena != NULL;
+	if (pooled) {
+		MoveSceneToHeap(pimpl);
+	}
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
 	// The ValidateDS process plays an exceptional role. It isn't contained in the global
 	// list of post-processing steps, so we need to call it manually.
@@ -763,22 +1138,40 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	}
 #endif // ! DEBUG
 
+	unsigned int numSteps = 0, curStep = 0;
+	for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)	{
+		numSteps += pimpl->mPostProcessingSteps[a]->IsActive(pFlags) ? 1 : 0;
+	}
+
 	boost::scoped_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
+	const bool measureMemory = GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_MEMORY,0) != 0;
 	for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)	{
 
 		BaseProcess* process = pimpl->mPostProcessingSteps[a];
 		if( process->IsActive( pFlags))	{
 
+			if (!pimpl->UpdateProgress(ProgressHandler::Phase_PostProcess,curStep++,numSteps)) {
+				break;
+			}
+
 			if (profiler) {
 				profiler->BeginRegion("postprocess");
 			}
 
+			aiSceneMemoryInfo before;
+			if (measureMemory) {
+				GetMemoryRequirements(pimpl->mScene,before);
+			}
+
 			process->ExecuteOnScene	( this );
-			pimpl->mProgressHandler->Update();
 
 			if (profiler) {
 				profiler->EndRegion("postprocess");
 			}
+
+			if (measureMemory && pimpl->mScene) {
+				pimpl->RecordStepMemory(GetStepFlags(process,pFlags),before.total);
+			}
 		}
 		if( !pimpl->mScene) {
 			break; 
@@ -803,12 +1196,23 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 #endif // ! DEBUG
 	}
 
+	// report completion, the progress handler may still decide to abandon the result
+	if (pimpl->mScene && (pimpl->IsCancelled() || !pimpl->UpdateProgress(ProgressHandler::Phase_PostProcess,numSteps,numSteps))) {
+		pimpl->mErrorString = "Import cancelled";
+		DefaultLogger::get()->error(pimpl->mErrorString);
+		DeleteScene(pimpl);
+	}
+
 	// update private scene flags
   if( pimpl->mScene )
   	ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
 
 	// clear any data allocated by post-process steps
 	pimpl->mPPShared->Clean();
+
+	if (pooled && pimpl->mScene) {
+		MoveSceneToArena(pimpl);
+	}
 	DefaultLogger::get()->info("Leaving post processing pipeline");
 
 	ASSIMP_END_EXCEPTION_REGION(const aiScene*);
@@ -870,16 +1274,9 @@ size_t Importer::GetImporterIndex (const char* szExtension) const
 	}
 	std::transform(ext.begin(),ext.end(), ext.begin(), tolower);
 
-	std::set<std::string> str;
-	for (std::vector<BaseImporter*>::const_iterator i =  pimpl->mImporter.begin();i != pimpl->mImporter.end();++i)	{
-		str.clear();
-
-		(*i)->GetExtensionList(str);
-		for (std::set<std::string>::const_iterator it = str.begin(); it != str.end(); ++it) {
-			if (ext == *it) {
-				return std::distance(static_cast< std::vector<BaseImporter*>::const_iterator >(pimpl->mImporter.begin()), i);
-			}
-		}
+	const ImporterPimpl::ExtensionMap::const_iterator it = pimpl->mExtensionMap.find(ext);
+	if (it != pimpl->mExtensionMap.end() && !(*it).second.empty()) {
+		return (*it).second.front();
 	}
 	ASSIMP_END_EXCEPTION_REGION(size_t);
 	return static_cast<size_t>(-1);
@@ -963,7 +1360,7 @@ const std::string& Importer::GetPropertyString(const char* szName,
 
 // ------------------------------------------------------------------------------------------------
 // Get the memory requirements of a single node
-inline void AddNodeWeight(unsigned int& iScene,const aiNode* pcNode)
+static void AddNodeWeight(ai_uint64& iScene,const aiNode* pcNode)
 {
 	iScene += sizeof(aiNode);
 	iScene += sizeof(unsigned int) * pcNode->mNumMeshes;
@@ -975,103 +1372,193 @@ inline void AddNodeWeight(unsigned int& iScene,const aiNode* pcNode)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Get the memory requirements of the scene
-void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
+// Get the memory requirements of the vertex streams of a mesh or an anim mesh
+template <typename T>
+static void AddVertexWeight(aiSceneMemoryInfo& in,const T* pcMesh)
 {
-	in = aiMemoryInfo();
-	aiScene* mScene = pimpl->mScene;
+	const ai_uint64 iNum = pcMesh->mNumVertices;
+	if (pcMesh->HasPositions()) {
+		in.positions += sizeof(aiVector3D) * iNum;
+	}
+	if (pcMesh->HasNormals()) {
+		in.normals += sizeof(aiVector3D) * iNum;
+	}
+	if (pcMesh->HasTangentsAndBitangents()) {
+		in.tangents += sizeof(aiVector3D) * iNum * 2;
+	}
+	for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS;++a) {
+		if (pcMesh->HasVertexColors(a)) {
+			in.colors += sizeof(aiColor4D) * iNum;
+		}
+	}
+	for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS;++a) {
+		if (pcMesh->HasTextureCoords(a)) {
+			in.textureCoords += sizeof(aiVector3D) * iNum;
+		}
+	}
+}
 
-	// return if we have no scene loaded
-	if (!pimpl->mScene)
+// ------------------------------------------------------------------------------------------------
+// Get the memory requirements of an arbitrary scene
+void Importer::GetMemoryRequirements(const aiScene* mScene, aiSceneMemoryInfo& in)
+{
+	in = aiSceneMemoryInfo();
+	if (!mScene) {
 		return;
-
-
-	in.total = sizeof(aiScene);
+	}
 
 	// add all meshes
-	for (unsigned int i = 0; i < mScene->mNumMeshes;++i)
-	{
+	in.meshes = sizeof(void*) * mScene->mNumMeshes;
+	for (unsigned int i = 0; i < mScene->mNumMeshes;++i) {
+		const aiMesh* pc = mScene->mMeshes[i];
 		in.meshes += sizeof(aiMesh);
-		if (mScene->mMeshes[i]->HasPositions()) {
-			in.meshes += sizeof(aiVector3D) * mScene->mMeshes[i]->mNumVertices;
-		}
-
-		if (mScene->mMeshes[i]->HasNormals()) {
-			in.meshes += sizeof(aiVector3D) * mScene->mMeshes[i]->mNumVertices;
-		}
-
-		if (mScene->mMeshes[i]->HasTangentsAndBitangents()) {
-			in.meshes += sizeof(aiVector3D) * mScene->mMeshes[i]->mNumVertices * 2;
-		}
+		AddVertexWeight(in,pc);
 
-		for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS;++a) {
-			if (mScene->mMeshes[i]->HasVertexColors(a)) {
-				in.meshes += sizeof(aiColor4D) * mScene->mMeshes[i]->mNumVertices;
+		in.faces += sizeof(aiFace) * pc->mNumFaces;
+		if (pc->mFaces) {
+			for (unsigned int a = 0; a < pc->mNumFaces;++a) {
+				in.indices += sizeof(unsigned int) * pc->mFaces[a].mNumIndices;
 			}
-			else break;
 		}
-		for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS;++a) {
-			if (mScene->mMeshes[i]->HasTextureCoords(a)) {
-				in.meshes += sizeof(aiVector3D) * mScene->mMeshes[i]->mNumVertices;
+
+		if (pc->HasBones()) {
+			in.bones += sizeof(void*) * pc->mNumBones;
+			for (unsigned int a = 0; a < pc->mNumBones;++a) {
+				in.bones += sizeof(aiBone);
+				in.boneWeights += sizeof(aiVertexWeight) * pc->mBones[a]->mNumWeights;
 			}
-			else break;
 		}
-		if (mScene->mMeshes[i]->HasBones()) {
-			in.meshes += sizeof(void*) * mScene->mMeshes[i]->mNumBones;
-			for (unsigned int p = 0; p < mScene->mMeshes[i]->mNumBones;++p) {
-				in.meshes += sizeof(aiBone);
-				in.meshes += mScene->mMeshes[i]->mBones[p]->mNumWeights * sizeof(aiVertexWeight);
+
+		if (pc->mNumAnimMeshes && pc->mAnimMeshes) {
+			aiSceneMemoryInfo anim;
+			anim.meshes = sizeof(void*) * pc->mNumAnimMeshes;
+			for (unsigned int a = 0; a < pc->mNumAnimMeshes;++a) {
+				anim.meshes += sizeof(aiAnimMesh);
+				AddVertexWeight(anim,pc->mAnimMeshes[a]);
 			}
+			in.animMeshes += anim.meshes + anim.positions + anim.normals + 
+				anim.tangents + anim.colors + anim.textureCoords;
 		}
-		in.meshes += (sizeof(aiFace) + 3 * sizeof(unsigned int))*mScene->mMeshes[i]->mNumFaces;
 	}
-    in.total += in.meshes;
 
 	// add all embedded textures
+	in.textures = sizeof(void*) * mScene->mNumTextures;
 	for (unsigned int i = 0; i < mScene->mNumTextures;++i) {
 		const aiTexture* pc = mScene->mTextures[i];
 		in.textures += sizeof(aiTexture);
 		if (pc->mHeight) {
-			in.textures += 4 * pc->mHeight * pc->mWidth;
+			in.texels += sizeof(aiTexel) * static_cast<ai_uint64>(pc->mHeight) * pc->mWidth;
 		}
-		else in.textures += pc->mWidth;
+		else in.texels += pc->mWidth;
 	}
-	in.total += in.textures;
 
 	// add all animations
+	in.animations = sizeof(void*) * mScene->mNumAnimations;
 	for (unsigned int i = 0; i < mScene->mNumAnimations;++i) {
 		const aiAnimation* pc = mScene->mAnimations[i];
 		in.animations += sizeof(aiAnimation);
 
-		// add all bone anims
+		// add all node anims
+		in.animations += sizeof(void*) * pc->mNumChannels;
 		for (unsigned int a = 0; a < pc->mNumChannels; ++a) {
-			const aiNodeAnim* pc2 = pc->mChannels[i];
+			const aiNodeAnim* pc2 = pc->mChannels[a];
 			in.animations += sizeof(aiNodeAnim);
-			in.animations += pc2->mNumPositionKeys * sizeof(aiVectorKey);
-			in.animations += pc2->mNumScalingKeys * sizeof(aiVectorKey);
-			in.animations += pc2->mNumRotationKeys * sizeof(aiQuatKey);
+			in.animationKeys += pc2->mNumPositionKeys * sizeof(aiVectorKey);
+			in.animationKeys += pc2->mNumScalingKeys * sizeof(aiVectorKey);
+			in.animationKeys += pc2->mNumRotationKeys * sizeof(aiQuatKey);
+		}
+
+		// add all mesh anims
+		in.animations += sizeof(void*) * pc->mNumMeshChannels;
+		for (unsigned int a = 0; a < pc->mNumMeshChannels; ++a) {
+			const aiMeshAnim* pc2 = pc->mMeshChannels[a];
+			in.animations += sizeof(aiMeshAnim);
+			in.animationKeys += pc2->mNumKeys * sizeof(aiMeshKey);
 		}
 	}
-	in.total += in.animations;
 
 	// add all cameras and all lights
-	in.total += in.cameras = sizeof(aiCamera) *  mScene->mNumCameras;
-	in.total += in.lights  = sizeof(aiLight)  *  mScene->mNumLights;
+	in.cameras = (sizeof(aiCamera) + sizeof(void*)) * mScene->mNumCameras;
+	in.lights  = (sizeof(aiLight)  + sizeof(void*)) * mScene->mNumLights;
 
 	// add all nodes
-	AddNodeWeight(in.nodes,mScene->mRootNode);
-	in.total += in.nodes;
+	if (mScene->mRootNode) {
+		AddNodeWeight(in.nodes,mScene->mRootNode);
+	}
 
 	// add all materials
+	in.materials = sizeof(void*) * mScene->mNumMaterials;
 	for (unsigned int i = 0; i < mScene->mNumMaterials;++i) {
 		const aiMaterial* pc = mScene->mMaterials[i];
 		in.materials += sizeof(aiMaterial);
 		in.materials += pc->mNumAllocated * sizeof(void*);
 
 		for (unsigned int a = 0; a < pc->mNumProperties;++a) {
-			in.materials += pc->mProperties[a]->mDataLength;
+			in.materials += sizeof(aiMaterialProperty);
+			in.materialData += pc->mProperties[a]->mDataLength;
 		}
 	}
-	in.total += in.materials;
+
+	in.total = sizeof(aiScene) + in.meshes + in.positions + in.normals + in.tangents + 
+		in.colors + in.textureCoords + in.faces + in.indices + in.bones + in.boneWeights + 
+		in.animMeshes + in.animations + in.animationKeys + in.materials + in.materialData + 
+		in.textures + in.texels + in.nodes + in.cameras + in.lights;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the memory requirements of the scene
+void Importer::GetMemoryRequirements(aiSceneMemoryInfo& in) const
+{
+	GetMemoryRequirements(pimpl->mScene,in);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Clamp a 64 bit size to the range of the legacy aiMemoryInfo fields
+inline unsigned int ClampMemorySize(ai_uint64 iSize)
+{
+	return static_cast<unsigned int>(std::min(iSize,static_cast<ai_uint64>(UINT_MAX)));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the memory requirements of the scene, legacy variant
+void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
+{
+	in = aiMemoryInfo();
+
+	// return if we have no scene loaded
+	if (!pimpl->mScene)
+		return;
+
+	aiSceneMemoryInfo info;
+	GetMemoryRequirements(pimpl->mScene,info);
+
+	in.meshes = ClampMemorySize(info.meshes + info.positions + info.normals + info.tangents + 
+		info.colors + info.textureCoords + info.faces + info.indices + info.bones + 
+		info.boneWeights + info.animMeshes);
+
+	in.textures   = ClampMemorySize(info.textures + info.texels);
+	in.animations = ClampMemorySize(info.animations + info.animationKeys);
+	in.materials  = ClampMemorySize(info.materials + info.materialData);
+	in.nodes      = ClampMemorySize(info.nodes);
+	in.cameras    = ClampMemorySize(info.cameras);
+	in.lights     = ClampMemorySize(info.lights);
+	in.total      = ClampMemorySize(info.total);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the number of per-step memory records of the last import
+size_t Importer::GetStepMemoryInfoCount() const
+{
+	return pimpl->mStepMemory.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get a per-step memory record of the last import
+const aiStepMemoryInfo* Importer::GetStepMemoryInfo(size_t iIndex) const
+{
+	if (iIndex >= pimpl->mStepMemory.size()) {
+		return NULL;
+	}
+	return &pimpl->mStepMemory[iIndex];
 }
 
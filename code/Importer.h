@@ -42,10 +42,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_IMPORTER_H
 #define INCLUDED_AI_IMPORTER_H
 
+#include "../include/assimp/ProgressHandler.hpp"
+
 namespace Assimp	{
 
 	class BaseImporter;
 	class BaseProcess;
+	class SceneArena;
+	struct ImportControl;
 
 	
 //! @cond never
@@ -69,6 +73,14 @@ public:
 	typedef std::map<KeyType, float> FloatPropertyMap;
 	typedef std::map<KeyType, std::string> StringPropertyMap;
 
+	// Maps a lower-case file extension to the indices of all importers
+	// listing it in their aiImporterDesc, in registration order
+	typedef std::map<std::string, std::vector<unsigned int> > ExtensionMap;
+
+	// Maps the first four bytes of a file to the indices of all importers
+	// reporting them as magic token, in registration order
+	typedef std::map<uint32_t, std::vector<unsigned int> > SignatureMap;
+
 public:
 
 	/** IO handler to use for all file accesses. */
@@ -82,12 +94,24 @@ public:
 	/** Format-specific importer worker objects - one for each format we can read.*/
 	std::vector< BaseImporter* > mImporter;
 
+	/** Lookup table to find the importers for a file extension. Needs to be 
+	 *  rebuilt whenever mImporter changes. */
+	ExtensionMap mExtensionMap;
+
+	/** Lookup table to find the importers for a file signature, rebuilt
+	 *  together with mExtensionMap. */
+	SignatureMap mSignatureMap;
+
 	/** Post processing steps we can apply at the imported data. */
 	std::vector< BaseProcess* > mPostProcessingSteps;
 
 	/** The imported data, if ReadFile() was successful, NULL otherwise. */
 	aiScene* mScene;
 
+	/** Memory pool for the scene if #AI_CONFIG_GLOB_SCENE_POOL is set, 
+	 *  allocated on first use and kept for subsequent imports. */
+	SceneArena* mArena;
+
 	/** The error description, if there was one. */
 	std::string mErrorString;
 
@@ -106,6 +130,28 @@ public:
 
 	/** Used by post-process steps to share data */
 	SharedPostProcessInfo* mPPShared;
+
+	/** Cancellation flag and state of asynchronous imports */
+	ImportControl* mControl;
+
+	/** Scene memory after the import and after each post-processing step,
+	 *  only recorded if #AI_CONFIG_GLOB_MEASURE_MEMORY is set */
+	std::vector<aiStepMemoryInfo> mStepMemory;
+
+public:
+
+	/** Report progress to the progress handler.
+	 *  @return false if the import has been cancelled, either by the 
+	 *    progress handler or through Importer::CancelReadFile() */
+	bool UpdateProgress(ProgressHandler::Phase phase, unsigned int current, unsigned int total) const;
+
+	/** Check whether the import has been cancelled */
+	bool IsCancelled() const;
+
+	/** Append a record to mStepMemory for the current scene
+	 *  @param step #aiPostProcessSteps flags of the step, 0 for the import
+	 *  @param before Total size of the scene before the step */
+	void RecordStepMemory(unsigned int step, ai_uint64 before);
 };
 //! @endcond
 
@@ -96,6 +96,7 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
 	float out = 0.f;
 	unsigned int numf = 0, numm = 0;
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++){
+		CheckImportCancelled();
 		const float res = ProcessMesh( pScene->mMeshes[a],a);
 		if (res) {
 			numf += pScene->mMeshes[a]->mNumFaces;
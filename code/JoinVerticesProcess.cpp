@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "JoinVerticesProcess.h"
 #include "ProcessHelper.h"
 #include "Vertex.h"
+#include "VertexInfluences.h"
 #include "TinyFormatter.h"
 
 using namespace Assimp;
@@ -88,8 +89,10 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
 
 	// execute the step
 	int iNumVertices = 0;
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
+	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
+		CheckImportCancelled();
 		iNumVertices +=	ProcessMesh( pScene->mMeshes[a],a);
+	}
 
 	// if logging is active, print detailed statistics
 	if (!DefaultLogger::isNullLogger())
@@ -111,6 +114,54 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
 	pScene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Checks whether two vertices of a mesh are also identical in all of its anim meshes
+template <typename T>
+inline bool IsEqualInAnim(const T* data, unsigned int a, unsigned int b, float squareEpsilon)
+{
+	return !data || (data[a] - data[b]).SquareLength() <= squareEpsilon;
+}
+
+inline bool AreAnimVerticesEqual( const aiMesh* pMesh, unsigned int a, unsigned int b, float squareEpsilon)
+{
+	for (unsigned int i = 0; i < pMesh->mNumAnimMeshes; ++i) {
+		const aiAnimMesh* anim = pMesh->mAnimMeshes[i];
+		if (!IsEqualInAnim(anim->mVertices,a,b,squareEpsilon) || 
+			!IsEqualInAnim(anim->mNormals,a,b,squareEpsilon) ||
+			!IsEqualInAnim(anim->mTangents,a,b,squareEpsilon) ||
+			!IsEqualInAnim(anim->mBitangents,a,b,squareEpsilon)) {
+			return false;
+		}
+		for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+			if (!IsEqualInAnim(anim->mTextureCoords[n],a,b,squareEpsilon)) {
+				return false;
+			}
+		}
+		for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+			if (anim->mColors[n] && GetColorDifference(anim->mColors[n][a],anim->mColors[n][b]) > squareEpsilon) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies the entries of a vertex component array which survived the join
+template <typename T>
+inline void RemapAnimArray(T*& data, const std::vector<unsigned int>& uniqueSource)
+{
+	if (!data) {
+		return;
+	}
+	T* old = data;
+	data = new T[uniqueSource.size()];
+	for (unsigned int a = 0; a < uniqueSource.size(); a++) {
+		data[a] = old[uniqueSource[a]];
+	}
+	delete[] old;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Unites identical vertices in the given mesh
 int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
@@ -170,6 +221,25 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 	// This should yield false in more than 99% of all imports ...
 	const bool complex = ( pMesh->GetNumColorChannels() > 0 || pMesh->GetNumUVChannels() > 1);
 
+	// Keep the bone influence table of the mesh up to date if another step shares it
+	VertexInfluences* influences = NULL;
+	if (shared && pMesh->mNumBones)	{
+		std::vector<VertexInfluences>* tables;
+		shared->GetProperty(AI_SPP_BONE_INFLUENCES,tables);
+		if (tables && meshIndex < tables->size() && (*tables)[meshIndex].IsValidFor(pMesh))	{
+			influences = &(*tables)[meshIndex];
+		}
+	}
+
+	// For vertex animated meshes, the original index of each unique vertex
+	// so we can pick the surviving vertices from the anim meshes later.
+	// The same goes for the rows of the influence table.
+	std::vector<unsigned int> uniqueSource;
+	const bool trackSource = pMesh->mNumAnimMeshes || influences;
+	if (trackSource) {
+		uniqueSource.reserve( pMesh->mNumVertices);
+	}
+
 	// Now check each vertex if it brings something new to the table
 	for( unsigned int a = 0; a < pMesh->mNumVertices; a++)	{
 		// collect the vertex data
@@ -251,6 +321,11 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 					continue;
 			}
 
+			// Vertex animations must not be affected either. The unique vertex
+			// is stored at the same index in the anim meshes as vidx.
+			if (pMesh->mNumAnimMeshes && !AreAnimVerticesEqual(pMesh,vidx,a,squareEpsilon))
+				continue;
+
 			// we're still here -> this vertex perfectly matches our given vertex
 			matchIndex = uidx;
 			break;
@@ -267,6 +342,9 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 			// no unique vertex matches it upto now -> so add it
 			replaceIndex[a] = (unsigned int)uniqueVertices.size();
 			uniqueVertices.push_back( v);
+			if (trackSource) {
+				uniqueSource.push_back( a);
+			}
 		}
 	}
 
@@ -345,6 +423,24 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 		}
 	}
 
+	// Anim meshes, if present
+	for( unsigned int a = 0; a < pMesh->mNumAnimMeshes; a++)
+	{
+		aiAnimMesh* anim = pMesh->mAnimMeshes[a];
+		anim->mNumVertices = pMesh->mNumVertices;
+
+		RemapAnimArray( anim->mVertices, uniqueSource);
+		RemapAnimArray( anim->mNormals, uniqueSource);
+		RemapAnimArray( anim->mTangents, uniqueSource);
+		RemapAnimArray( anim->mBitangents, uniqueSource);
+		for( unsigned int b = 0; b < AI_MAX_NUMBER_OF_TEXTURECOORDS; b++) {
+			RemapAnimArray( anim->mTextureCoords[b], uniqueSource);
+		}
+		for( unsigned int b = 0; b < AI_MAX_NUMBER_OF_COLOR_SETS; b++) {
+			RemapAnimArray( anim->mColors[b], uniqueSource);
+		}
+	}
+
 	// adjust the indices in all faces
 	for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
 	{
@@ -406,8 +502,19 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 
 			--a; 
 			DefaultLogger::get()->warn("Removing bone -> no weights remaining");
+
+			// the bone indices in the influence table are wrong now
+			if (influences) {
+				influences->Clear();
+				influences = NULL;
+			}
 		}
 	}
+
+	if (influences)	{
+		influences->Remap( uniqueSource);
+		influences->SetMesh( pMesh);
+	}
 	return pMesh->mNumVertices;
 }
 
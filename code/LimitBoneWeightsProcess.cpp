@@ -42,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssimpPCH.h"
 #include "LimitBoneWeightsProcess.h"
+#include "VertexInfluences.h"
 
 
 using namespace Assimp;
@@ -73,9 +74,27 @@ bool LimitBoneWeightsProcess::IsActive( unsigned int pFlags) const
 void LimitBoneWeightsProcess::Execute( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("LimitBoneWeightsProcess begin");
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-		ProcessMesh( pScene->mMeshes[a]);
 
+	// reuse the influence tables set up by SplitByBoneCount, if possible
+	std::vector<VertexInfluences>* tables = NULL;
+	if (shared)	{
+		shared->GetProperty(AI_SPP_BONE_INFLUENCES,tables);
+	}
+
+	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
+		aiMesh* mesh = pScene->mMeshes[a];
+
+		VertexInfluences* influences = NULL;
+		if (tables && a < tables->size() && (*tables)[a].IsValidFor(mesh))	{
+			influences = &(*tables)[a];
+		}
+		ProcessMesh( mesh, influences);
+	}
+
+	// we're the last step to use the tables, and they're out of date now
+	if (shared)	{
+		shared->RemoveProperty(AI_SPP_BONE_INFLUENCES);
+	}
 	DefaultLogger::get()->debug("LimitBoneWeightsProcess end");
 }
 
@@ -87,98 +106,71 @@ void LimitBoneWeightsProcess::SetupProperties(const Importer* pImp)
 	this->mMaxWeights = pImp->GetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS,AI_LMW_MAX_WEIGHTS);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Sorts bone influences by descending weight
+static bool IsHeavierInfluence(const VertexInfluences::Influence& a, const VertexInfluences::Influence& b)
+{
+	return a.mWeight > b.mWeight;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Unites identical vertices in the given mesh
-void LimitBoneWeightsProcess::ProcessMesh( aiMesh* pMesh)
+void LimitBoneWeightsProcess::ProcessMesh( aiMesh* pMesh, VertexInfluences* pInfluences)
 {
 	if( !pMesh->HasBones())
 		return;
 
-	// collect all bone weights per vertex
-	typedef std::vector< std::vector< Weight > > WeightsPerVertex;
-	WeightsPerVertex vertexWeights( pMesh->mNumVertices);
-
-	// collect all weights per vertex
-	for( unsigned int a = 0; a < pMesh->mNumBones; a++)
-	{
-		const aiBone* bone = pMesh->mBones[a];
-		for( unsigned int b = 0; b < bone->mNumWeights; b++)
-		{
-			const aiVertexWeight& w = bone->mWeights[b];
-			vertexWeights[w.mVertexId].push_back( Weight( a, w.mWeight));
-		}
+	// collect all bone weights per vertex, unless the caller did it for us
+	VertexInfluences localInfluences;
+	if (!pInfluences)	{
+		localInfluences.Build( pMesh);
+		pInfluences = &localInfluences;
 	}
+	VertexInfluences& vertexWeights = *pInfluences;
 
 	unsigned int removed = 0, old_bones = pMesh->mNumBones;
 
 	// now cut the weight count if it exceeds the maximum
 	bool bChanged = false;
-	for( WeightsPerVertex::iterator vit = vertexWeights.begin(); vit != vertexWeights.end(); ++vit)
+	for( unsigned int a = 0; a < vertexWeights.GetNumVertices(); a++)
 	{
-		if( vit->size() <= mMaxWeights)
+		const unsigned int m = vertexWeights.GetNumInfluences( a);
+		if( m <= mMaxWeights)
 			continue;
 
 		bChanged = true;
 
-		// more than the defined maximum -> first sort by weight in descending order. That's 
-		// why we defined the < operator in such a weird way.
-		std::sort( vit->begin(), vit->end());
+		// more than the defined maximum -> first sort by weight in descending order
+		VertexInfluences::Influence* vit = vertexWeights.GetInfluences( a);
+		std::sort( vit, vit + m, &IsHeavierInfluence);
 
 		// now kill everything beyond the maximum count
-		unsigned int m = vit->size();
-		vit->erase( vit->begin() + mMaxWeights, vit->end());
-		removed += m-vit->size();
+		vertexWeights.SetNumInfluences( a, mMaxWeights);
+		removed += m-mMaxWeights;
 
 		// and renormalize the weights
 		float sum = 0.0f;
-		for( std::vector<Weight>::const_iterator it = vit->begin(); it != vit->end(); ++it)
-			sum += it->mWeight;
-		for( std::vector<Weight>::iterator it = vit->begin(); it != vit->end(); ++it)
-			it->mWeight /= sum;
+		for( unsigned int b = 0; b < mMaxWeights; b++)
+			sum += vit[b].mWeight;
+		for( unsigned int b = 0; b < mMaxWeights; b++)
+			vit[b].mWeight /= sum;
 	}
 
 	if (bChanged)	{
-		// rebuild the vertex weight array for all bones 
-		typedef std::vector< std::vector< aiVertexWeight > > WeightsPerBone;
-		WeightsPerBone boneWeights( pMesh->mNumBones);
-		for( unsigned int a = 0; a < vertexWeights.size(); a++)
-		{
-			const std::vector<Weight>& vw = vertexWeights[a];
-			for( std::vector<Weight>::const_iterator it = vw.begin(); it != vw.end(); ++it)
-				boneWeights[it->mBone].push_back( aiVertexWeight( a, it->mWeight));
-		}
+		// rebuild the vertex weight arrays for all bones. There are less weights 
+		// than before, so the old arrays are reused.
+		vertexWeights.WriteBoneWeights( pMesh);
 
-		// and finally copy the vertex weight list over to the mesh's bones
+		// It is possible that all weights of a bone have been removed. 
 		std::vector<bool> abNoNeed(pMesh->mNumBones,false);
 		bChanged = false;
 
 		for( unsigned int a = 0; a < pMesh->mNumBones; a++)
 		{
-			const std::vector<aiVertexWeight>& bw = boneWeights[a];
-			aiBone* bone = pMesh->mBones[a];
-
-			// ignore the bone if no vertex weights were removed there
-
-			// FIX (Aramis, 07|22|08)
-			// NO! we can't ignore it in this case ... it is possible that
-			// the number of weights did not change, but the weight values did.
-
-			// if( bw.size() == bone->mNumWeights)
-			//	continue;
-
-			// FIX (Aramis, 07|21|08)
-			// It is possible that all weights of a bone have been removed.
-			// This would naturally cause an exception in &bw[0].
-			if ( bw.empty() )
+			if ( !pMesh->mBones[a]->mNumWeights )
 			{
 				abNoNeed[a] = bChanged = true;
-				continue;
 			}
-
-			// copy the weight list. should always be less weights than before, so we don't need a new allocation
-			ai_assert( bw.size() <= bone->mNumWeights);
-			bone->mNumWeights = (unsigned int) bw.size();
-			::memcpy( bone->mWeights, &bw[0], bw.size() * sizeof( aiVertexWeight));
 		}
 
 		if (bChanged)	{
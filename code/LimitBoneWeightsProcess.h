@@ -49,6 +49,7 @@ class LimitBoneWeightsTest;
 
 namespace Assimp
 {
+class VertexInfluences;
 
 // NOTE: If you change these limits, don't forget to change the
 // corresponding values in all Assimp ports
@@ -98,8 +99,10 @@ public:
 	// -------------------------------------------------------------------
 	/** Limits the bone weight count for all vertices in the given mesh.
 	* @param pMesh The mesh to process.
+	* @param pInfluences Bone influences of the mesh, if already known.
+	*   They are modified by the step. If NULL, they are computed locally.
 	*/
-	void ProcessMesh( aiMesh* pMesh);
+	void ProcessMesh( aiMesh* pMesh, VertexInfluences* pInfluences = NULL);
 
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
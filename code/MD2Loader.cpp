@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MD2Loader.h"
 #include "ByteSwap.h"
 #include "MD2NormalTable.h" // shouldn't be included by other units
+#include "MorphTargetHelper.h"
 
 using namespace Assimp;
 using namespace Assimp::MD2;
@@ -81,6 +82,46 @@ void MD2::LookupNormalIndex(uint8_t iNormalIndex,aiVector3D& vOut)
 	vOut = *((const aiVector3D*)(&g_avNormals[iNormalIndex]));
 }
 
+// ------------------------------------------------------------------------------------------------
+// Decode the positions and normals of a frame, given the (validated) vertex index for each
+// output vertex.
+static void DecodeFrame(BE_NCONST MD2::Frame* pcFrame, const std::vector<unsigned int>& vertexIndices,
+	aiVector3D* pcVertices, aiVector3D* pcNormals)
+{
+#ifdef AI_BUILD_BIG_ENDIAN
+	ByteSwap::Swap4( & pcFrame->scale[0] );
+	ByteSwap::Swap4( & pcFrame->scale[1] );
+	ByteSwap::Swap4( & pcFrame->scale[2] );
+	ByteSwap::Swap4( & pcFrame->translate[0] );
+	ByteSwap::Swap4( & pcFrame->translate[1] );
+	ByteSwap::Swap4( & pcFrame->translate[2] );
+#endif
+
+	for (unsigned int i = 0; i < (unsigned int)vertexIndices.size();++i)	{
+		const MD2::Vertex& vert = pcFrame->vertices[vertexIndices[i]];
+
+		// read x,y, and z component of the vertex
+		aiVector3D& vec = pcVertices[i];
+
+		vec.x = (float)vert.vertex[0] * pcFrame->scale[0];
+		vec.x += pcFrame->translate[0];
+
+		vec.y = (float)vert.vertex[1] * pcFrame->scale[1];
+		vec.y += pcFrame->translate[1];
+
+		vec.z = (float)vert.vertex[2] * pcFrame->scale[2];
+		vec.z += pcFrame->translate[2];
+
+		// read the normal vector from the precalculated normal table
+		aiVector3D& vNormal = pcNormals[i];
+		LookupNormalIndex(vert.lightNormalIndex,vNormal);
+
+		// flip z and y to become right-handed
+		std::swap((float&)vNormal.z,(float&)vNormal.y);
+		std::swap((float&)vec.z,(float&)vec.y);
+	}
+}
+
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
@@ -116,6 +157,13 @@ const aiImporterDesc* MD2Importer::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Files start with one of these tokens
+void MD2Importer::GetMagicTokens (std::vector<uint32_t>& tokens) const
+{
+	tokens.push_back(AI_MD2_MAGIC_NUMBER_LE);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties
 void MD2Importer::SetupProperties(const Importer* pImp)
@@ -127,6 +175,9 @@ void MD2Importer::SetupProperties(const Importer* pImp)
 	if(static_cast<unsigned int>(-1) == configFrameID){
 		configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
 	}
+
+	// AI_CONFIG_IMPORT_MORPH_TARGETS
+	configMorphTargets = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MORPH_TARGETS,0));
 }
 // ------------------------------------------------------------------------------------------------
 // Validate the file header
@@ -158,15 +209,23 @@ void MD2Importer::ValidateHeader( )
 	if (m_pcHeader->offsetEnd > (uint32_t)fileSize)
 		throw DeadlyImportError( "Invalid md2 file: File is too small");
 
-	if (m_pcHeader->offsetSkins		+ m_pcHeader->numSkins * sizeof (MD2::Skin)			>= fileSize ||
-		m_pcHeader->offsetTexCoords	+ m_pcHeader->numTexCoords * sizeof (MD2::TexCoord)	>= fileSize ||
-		m_pcHeader->offsetTriangles	+ m_pcHeader->numTriangles * sizeof (MD2::Triangle)	>= fileSize ||
-		m_pcHeader->offsetFrames		+ m_pcHeader->numFrames * sizeof (MD2::Frame)			>= fileSize ||
+	// the values come from the file, compute in 64 bits so they can't wrap around
+	if (m_pcHeader->offsetSkins		+ (uint64_t)m_pcHeader->numSkins * sizeof (MD2::Skin)			>= fileSize ||
+		m_pcHeader->offsetTexCoords	+ (uint64_t)m_pcHeader->numTexCoords * sizeof (MD2::TexCoord)	>= fileSize ||
+		m_pcHeader->offsetTriangles	+ (uint64_t)m_pcHeader->numTriangles * sizeof (MD2::Triangle)	>= fileSize ||
+		m_pcHeader->offsetFrames		+ (uint64_t)m_pcHeader->numFrames * m_pcHeader->frameSize		> fileSize ||
 		m_pcHeader->offsetEnd			> fileSize)
 	{
 		throw DeadlyImportError("Invalid MD2 header: some offsets are outside the file");
 	}
 
+	// each frame is followed by its vertices
+	if (!m_pcHeader->numVertices || 
+		m_pcHeader->frameSize < sizeof(MD2::Frame) + (uint64_t)(m_pcHeader->numVertices-1) * sizeof(MD2::Vertex))
+	{
+		throw DeadlyImportError("Invalid MD2 header: frames are too small to hold all vertices");
+	}
+
 	if (m_pcHeader->numSkins > AI_MD2_MAX_SKINS)
 		DefaultLogger::get()->warn("The model contains more skins than Quake 2 supports");
 	if ( m_pcHeader->numFrames > AI_MD2_MAX_FRAMES)
@@ -241,10 +300,9 @@ void MD2Importer::InternReadFile( const std::string& pFile,
 	pcMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
 
 	// navigate to the begin of the frame data
-	BE_NCONST MD2::Frame* pcFrame = (BE_NCONST MD2::Frame*) ((uint8_t*)
-		m_pcHeader + m_pcHeader->offsetFrames);
-
-	pcFrame += configFrameID;
+	uint8_t* pcFrames = (uint8_t*)m_pcHeader + m_pcHeader->offsetFrames;
+	BE_NCONST MD2::Frame* pcFrame = (BE_NCONST MD2::Frame*) (pcFrames + 
+		configFrameID * m_pcHeader->frameSize);
 
 	// navigate to the begin of the triangle data
 	MD2::Triangle* pcTriangles = (MD2::Triangle*) ((uint8_t*)
@@ -254,9 +312,6 @@ void MD2Importer::InternReadFile( const std::string& pFile,
 	BE_NCONST MD2::TexCoord* pcTexCoords = (BE_NCONST MD2::TexCoord*) ((uint8_t*)
 		m_pcHeader + m_pcHeader->offsetTexCoords);
 
-	// navigate to the begin of the vertex data
-	BE_NCONST MD2::Vertex* pcVerts = (BE_NCONST MD2::Vertex*) (pcFrame->vertices);
-
 #ifdef AI_BUILD_BIG_ENDIAN
 	for (uint32_t i = 0; i< m_pcHeader->numTriangles; ++i)
 	{
@@ -271,12 +326,6 @@ void MD2Importer::InternReadFile( const std::string& pFile,
 		ByteSwap::Swap2(& pcTexCoords[i].s);
 		ByteSwap::Swap2(& pcTexCoords[i].t);
 	}
-	ByteSwap::Swap4( & pcFrame->scale[0] );
-	ByteSwap::Swap4( & pcFrame->scale[1] );
-	ByteSwap::Swap4( & pcFrame->scale[2] );
-	ByteSwap::Swap4( & pcFrame->translate[0] );
-	ByteSwap::Swap4( & pcFrame->translate[1] );
-	ByteSwap::Swap4( & pcFrame->translate[2] );
 #endif
 
 	pcMesh->mNumFaces = m_pcHeader->numTriangles;
@@ -287,6 +336,9 @@ void MD2Importer::InternReadFile( const std::string& pFile,
 	pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
 	pcMesh->mNormals = new aiVector3D[pcMesh->mNumVertices];
 
+	// source vertex for each output vertex, used to decode the frames
+	std::vector<unsigned int> vertexIndices(pcMesh->mNumVertices);
+
 	// Not sure whether there are MD2 files without texture coordinates
 	// NOTE: texture coordinates can be there without a texture,
 	// but a texture can't be there without a valid UV channel
@@ -345,7 +397,7 @@ void MD2Importer::InternReadFile( const std::string& pFile,
 	}
 
 
-	// now read all triangles of the first frame, apply scaling and translation
+	// now read all triangles
 	unsigned int iCurrent = 0;
 
 	float fDivisorU = 1.0f,fDivisorV = 1.0f;
@@ -382,26 +434,7 @@ void MD2Importer::InternReadFile( const std::string& pFile,
 				DefaultLogger::get()->error("MD2: Vertex index is outside the allowed range");
 				iIndex = m_pcHeader->numVertices-1;
 			}
-
-			// read x,y, and z component of the vertex
-			aiVector3D& vec = pcMesh->mVertices[iCurrent];
-
-			vec.x = (float)pcVerts[iIndex].vertex[0] * pcFrame->scale[0];
-			vec.x += pcFrame->translate[0];
-
-			vec.y = (float)pcVerts[iIndex].vertex[1] * pcFrame->scale[1];
-			vec.y += pcFrame->translate[1];
-
-			vec.z = (float)pcVerts[iIndex].vertex[2] * pcFrame->scale[2];
-			vec.z += pcFrame->translate[2];
-
-			// read the normal vector from the precalculated normal table
-			aiVector3D& vNormal = pcMesh->mNormals[iCurrent];
-			LookupNormalIndex(pcVerts[iIndex].lightNormalIndex,vNormal);
-
-			// flip z and y to become right-handed
-			std::swap((float&)vNormal.z,(float&)vNormal.y);
-			std::swap((float&)vec.z,(float&)vec.y);
+			vertexIndices[iCurrent] = iIndex;
 
 			if (m_pcHeader->numTexCoords)	{
 				// validate texture coordinates
@@ -421,6 +454,27 @@ void MD2Importer::InternReadFile( const std::string& pFile,
 			pScene->mMeshes[0]->mFaces[i].mIndices[c] = iCurrent;
 		}
 	}
+
+	// now read all vertices of the requested frame, apply scaling and translation
+	DecodeFrame(pcFrame,vertexIndices,pcMesh->mVertices,pcMesh->mNormals);
+
+	// and those of all other frames, too, if requested
+	if (configMorphTargets) {
+		AllocateMorphTargets(pcMesh,m_pcHeader->numFrames);
+		for (unsigned int i = 0; i < m_pcHeader->numFrames;++i)	{
+			aiAnimMesh* anim = pcMesh->mAnimMeshes[i];
+			if (i == configFrameID)	{
+				std::copy(pcMesh->mVertices,pcMesh->mVertices+pcMesh->mNumVertices,anim->mVertices);
+				std::copy(pcMesh->mNormals,pcMesh->mNormals+pcMesh->mNumVertices,anim->mNormals);
+				continue;
+			}
+			DecodeFrame((BE_NCONST MD2::Frame*)(pcFrames + i * m_pcHeader->frameSize),
+				vertexIndices,anim->mVertices,anim->mNormals);
+		}
+
+		// Quake II plays back vertex animations at 10 frames per second
+		AddMorphTargetAnimation(pScene,10.);
+	}
 }
 
 #endif // !! ASSIMP_BUILD_NO_MD2_IMPORTER
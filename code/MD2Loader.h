@@ -89,6 +89,12 @@ protected:
 	 */
 	const aiImporterDesc* GetInfo () const;
 
+	// -------------------------------------------------------------------
+	/** Return the tokens at the start of files in this format.
+	 * See #BaseImporter::GetMagicTokens for the details
+	 */
+	void GetMagicTokens (std::vector<uint32_t>& tokens) const;
+
 	// -------------------------------------------------------------------
 	/** Imports the given file into the given scene structure. 
 	* See BaseImporter::InternReadFile() for details
@@ -107,6 +113,9 @@ protected:
 	/** Configuration option: frame to be loaded */
 	unsigned int configFrameID;
 
+	/** Configuration option: import all frames as morph targets */
+	bool configMorphTargets;
+
 	/** Header of the MD2 file */
 	BE_NCONST MD2::Header* m_pcHeader;
 
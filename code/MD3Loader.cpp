@@ -58,6 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "RemoveComments.h"
 #include "ParsingUtils.h"
 #include "Importer.h"
+#include "MorphTargetHelper.h"
 
 using namespace Assimp;
 
@@ -349,6 +350,7 @@ void Q3Shader::ConvertShaderToMaterial(aiMaterial* out, const ShaderDataBlock& s
 MD3Importer::MD3Importer()
 : configFrameID  (0)
 , configHandleMP (true)
+, configMorphTargets (false)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -438,6 +440,13 @@ const aiImporterDesc* MD3Importer::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Files start with one of these tokens
+void MD3Importer::GetMagicTokens (std::vector<uint32_t>& tokens) const
+{
+	tokens.push_back(AI_MD3_MAGIC_NUMBER_LE);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties
 void MD3Importer::SetupProperties(const Importer* pImp)
@@ -450,6 +459,9 @@ void MD3Importer::SetupProperties(const Importer* pImp)
 		configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
 	}
 
+	// AI_CONFIG_IMPORT_MORPH_TARGETS
+	configMorphTargets = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MORPH_TARGETS,0));
+
 	// AI_CONFIG_IMPORT_MD3_HANDLE_MULTIPART
 	configHandleMP = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MD3_HANDLE_MULTIPART,1));
 
@@ -526,6 +538,68 @@ void RemoveSingleNodeFromList(aiNode* nd)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+// Tiny helper to remove the animation channels of a node from a scene
+void RemoveNodeAnimChannels(aiScene* scene, const char* name)
+{
+	for (unsigned int a = 0; a < scene->mNumAnimations; ++a) {
+		aiAnimation* anim = scene->mAnimations[a];
+		for (unsigned int i = 0; i < anim->mNumChannels;) {
+			if (anim->mChannels[i]->mNodeName == aiString(name)) {
+				delete anim->mChannels[i];
+				--anim->mNumChannels;
+				for (unsigned int n = i; n < anim->mNumChannels; ++n) {
+					anim->mChannels[n] = anim->mChannels[n+1];
+				}
+			}
+			else ++i;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the transformation of a tag, relative to its parent
+static void TagToMatrix(const MD3::Tag& tag, aiMatrix4x4& out)
+{
+	out = aiMatrix4x4();
+
+	// Copy local origin, again flip z,y
+	out.a4 = tag.origin.x;
+	out.b4 = tag.origin.y;
+	out.c4 = tag.origin.z;
+	AI_SWAP4(out.a4);
+	AI_SWAP4(out.b4);
+	AI_SWAP4(out.c4);
+
+	// Copy rest of transformation (need to transpose to match row-order matrix)
+	for (unsigned int a = 0; a < 3;++a) {
+		for (unsigned int m = 0; m < 3;++m) {
+			out[m][a] = tag.orientation[a][m];
+			AI_SWAP4(out[m][a]);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Decode the positions and normals of a frame, given the (validated) vertex index for each
+// output vertex.
+static void DecodeFrame(const MD3::Vertex* pcVertices, const std::vector<unsigned int>& vertexIndices,
+	aiVector3D* pcPositions, aiVector3D* pcNormals)
+{
+	for (unsigned int i = 0; i < (unsigned int)vertexIndices.size();++i) {
+		const MD3::Vertex& vert = pcVertices[vertexIndices[i]];
+
+		// Read vertices
+		aiVector3D& vec = pcPositions[i];
+		vec.x = vert.X*AI_MD3_XYZ_SCALE;
+		vec.y = vert.Y*AI_MD3_XYZ_SCALE;
+		vec.z = vert.Z*AI_MD3_XYZ_SCALE;
+
+		// Convert the normal vector to uncompressed float3 format
+		LatLngNormalToVec3(vert.NORMAL,(float*)&pcNormals[i]);
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 // Read a multi-part Q3 player model
 bool MD3Importer::ReadMultipartFile()
@@ -558,6 +632,10 @@ bool MD3Importer::ReadMultipartFile()
 		BatchLoader::PropertyMap props;
 		SetGenericProperty( props.ints, AI_CONFIG_IMPORT_MD3_HANDLE_MULTIPART, 0, NULL);
 
+		// but read the same frames
+		SetGenericProperty( props.ints, AI_CONFIG_IMPORT_MD3_KEYFRAME, (int)configFrameID, NULL);
+		SetGenericProperty( props.ints, AI_CONFIG_IMPORT_MORPH_TARGETS, configMorphTargets ? 1 : 0, NULL);
+
 		// now read these three files
 		BatchLoader batch(mIOHandler);
 		const unsigned int _lower = batch.AddLoadRequest(lower,0,&props);
@@ -622,6 +700,10 @@ bool MD3Importer::ReadMultipartFile()
 		RemoveSingleNodeFromList (scene_upper->mRootNode->FindNode("tag_torso"));
 		RemoveSingleNodeFromList (scene_head-> mRootNode->FindNode("tag_head" ));
 
+		// ... and their animation channels, if morph targets are imported.
+		RemoveNodeAnimChannels (scene_upper, "tag_torso");
+		RemoveNodeAnimChannels (scene_head,  "tag_head" );
+
 		// Undo the rotations which we applied to the coordinate systems. We're
 		// working in global Quake space here
 		scene_head->mRootNode->mTransformation  = aiMatrix4x4();
@@ -760,8 +842,14 @@ void MD3Importer::InternReadFile( const std::string& pFile,
 	// Navigate to the list of surfaces
 	BE_NCONST MD3::Surface* pcSurfaces = (BE_NCONST MD3::Surface*)(mBuffer + pcHeader->OFS_SURFACES);
 
-	// Navigate to the list of tags
+	// Number of frames we need to read
+	const unsigned int iNumFrames = configMorphTargets ? pcHeader->NUM_FRAMES : configFrameID+1;
+
+	// Navigate to the list of tags. There's one list for each frame.
 	BE_NCONST MD3::Tag* pcTags = (BE_NCONST MD3::Tag*)(mBuffer + pcHeader->OFS_TAGS);
+	if (pcHeader->NUM_TAGS && pcHeader->OFS_TAGS + iNumFrames * pcHeader->NUM_TAGS * sizeof(MD3::Tag) > fileSize) {
+		throw DeadlyImportError("Invalid MD3 header: tags are outside the file");
+	}
 
 	// Allocate output storage
 	pScene->mNumMeshes = pcHeader->NUM_SURFACES;
@@ -819,6 +907,12 @@ void MD3Importer::InternReadFile( const std::string& pFile,
 		// Validate the surface header
 		ValidateSurfaceHeaderOffsets(pcSurfaces);
 
+		// Each frame has its own list of vertices
+		if (pcSurfaces->OFS_XYZNORMAL + ((uint8_t*)pcSurfaces - mBuffer) + 
+			iNumFrames * pcSurfaces->NUM_VERTICES * sizeof(MD3::Vertex) > fileSize) {
+			throw DeadlyImportError("Invalid MD3 surface header: vertex frames are outside the file");
+		}
+
 		// Navigate to the vertex list of the surface
 		BE_NCONST MD3::Vertex* pcVertices = (BE_NCONST MD3::Vertex*)
 			(((uint8_t*)pcSurfaces) + pcSurfaces->OFS_XYZNORMAL);
@@ -935,12 +1029,13 @@ void MD3Importer::InternReadFile( const std::string& pFile,
 			// Ensure correct endianess
 #ifdef AI_BUILD_BIG_ENDIAN
 
-		for (uint32_t i = 0; i < pcSurfaces->NUM_VERTICES;++i)	{
+		for (uint32_t i = 0; i < pcSurfaces->NUM_VERTICES * iNumFrames;++i)	{
 			AI_SWAP2( pcVertices[i].NORMAL );
 			AI_SWAP2( pcVertices[i].X );
 			AI_SWAP2( pcVertices[i].Y );
 			AI_SWAP2( pcVertices[i].Z );
-
+		}
+		for (uint32_t i = 0; i < pcSurfaces->NUM_VERTICES;++i)	{
 			AI_SWAP4( pcUVs[i].U );
 			AI_SWAP4( pcUVs[i].U );
 		}
@@ -963,6 +1058,9 @@ void MD3Importer::InternReadFile( const std::string& pFile,
 		pcMesh->mTextureCoords[0]	= new aiVector3D[pcMesh->mNumVertices];
 		pcMesh->mNumUVComponents[0] = 2;
 
+		// Source vertex for each output vertex, used to decode the frames
+		std::vector<unsigned int> vertexIndices(pcMesh->mNumVertices);
+
 		// Fill in all triangles
 		unsigned int iCurrent = 0;
 		for (unsigned int i = 0; i < (unsigned int)pcSurfaces->NUM_TRIANGLES;++i)	{
@@ -973,19 +1071,16 @@ void MD3Importer::InternReadFile( const std::string& pFile,
 			for (unsigned int c = 0; c < 3;++c,++iCurrent)	{
 				pcMesh->mFaces[i].mIndices[c] = iCurrent;
 
-				// Read vertices
-				aiVector3D& vec = pcMesh->mVertices[iCurrent];
-				vec.x = pcVertices[ pcTriangles->INDEXES[c]].X*AI_MD3_XYZ_SCALE;
-				vec.y = pcVertices[ pcTriangles->INDEXES[c]].Y*AI_MD3_XYZ_SCALE;
-				vec.z = pcVertices[ pcTriangles->INDEXES[c]].Z*AI_MD3_XYZ_SCALE;
-
-				// Convert the normal vector to uncompressed float3 format
-				aiVector3D& nor = pcMesh->mNormals[iCurrent];
-				LatLngNormalToVec3(pcVertices[pcTriangles->INDEXES[c]].NORMAL,(float*)&nor);
+				unsigned int iIndex = pcTriangles->INDEXES[c];
+				if (iIndex >= pcSurfaces->NUM_VERTICES) {
+					DefaultLogger::get()->error("MD3: Vertex index is outside the allowed range");
+					iIndex = pcSurfaces->NUM_VERTICES-1;
+				}
+				vertexIndices[iCurrent] = iIndex;
 
 				// Read texture coordinates
-				pcMesh->mTextureCoords[0][iCurrent].x = pcUVs[ pcTriangles->INDEXES[c]].U;
-				pcMesh->mTextureCoords[0][iCurrent].y = 1.0f-pcUVs[ pcTriangles->INDEXES[c]].V;
+				pcMesh->mTextureCoords[0][iCurrent].x = pcUVs[iIndex].U;
+				pcMesh->mTextureCoords[0][iCurrent].y = 1.0f-pcUVs[iIndex].V;
 			}
 			// Flip face order if necessary
 			if (!shader || shader->cull == Q3Shader::CULL_CW) {
@@ -993,6 +1088,22 @@ void MD3Importer::InternReadFile( const std::string& pFile,
 			}
 			pcTriangles++;
 		}
+
+		// Read the vertices of the requested frame
+		DecodeFrame(pcVertices + configFrameID * pcSurfaces->NUM_VERTICES,vertexIndices,
+			pcMesh->mVertices,pcMesh->mNormals);
+
+		// ... and those of all frames if requested. Vertex animations
+		// refer to meshes by name, so use the name of the surface.
+		if (configMorphTargets) {
+			pcMesh->mName.Set(pcSurfaces->NAME);
+
+			AllocateMorphTargets(pcMesh,pcHeader->NUM_FRAMES);
+			for (unsigned int f = 0; f < pcHeader->NUM_FRAMES;++f) {
+				DecodeFrame(pcVertices + f * pcSurfaces->NUM_VERTICES,vertexIndices,
+					pcMesh->mAnimMeshes[f]->mVertices,pcMesh->mAnimMeshes[f]->mNormals);
+			}
+		}
 	
 		// Go to the next surface
 		pcSurfaces = (BE_NCONST MD3::Surface*)(((unsigned char*)pcSurfaces) + pcSurfaces->OFS_END);
@@ -1021,27 +1132,41 @@ void MD3Importer::InternReadFile( const std::string& pFile,
 		pScene->mRootNode->mNumChildren = pcHeader->NUM_TAGS;
 		pScene->mRootNode->mChildren = new aiNode*[pcHeader->NUM_TAGS];
 
-		for (unsigned int i = 0; i < pcHeader->NUM_TAGS; ++i, ++pcTags) {
+		const MD3::Tag* pcFrameTags = pcTags + configFrameID * pcHeader->NUM_TAGS;
+		for (unsigned int i = 0; i < pcHeader->NUM_TAGS; ++i) {
 
 			aiNode* nd = pScene->mRootNode->mChildren[i] = new aiNode();
-			nd->mName.Set((const char*)pcTags->NAME);
+			nd->mName.Set((const char*)pcFrameTags[i].NAME);
 			nd->mParent = pScene->mRootNode;
 
-			AI_SWAP4(pcTags->origin.x);
-			AI_SWAP4(pcTags->origin.y);
-			AI_SWAP4(pcTags->origin.z);
+			TagToMatrix(pcFrameTags[i],nd->mTransformation);
+		}
+	}
+
+	// Setup the animation for all frames, this includes the movement of all tags
+	aiAnimation* anim = configMorphTargets ? AddMorphTargetAnimation(pScene,0.) : NULL;
+	if (anim && pcHeader->NUM_TAGS) {
+		anim->mNumChannels = pcHeader->NUM_TAGS;
+		anim->mChannels = new aiNodeAnim*[anim->mNumChannels];
 
-			// Copy local origin, again flip z,y
-			nd->mTransformation.a4 = pcTags->origin.x;
-			nd->mTransformation.b4 = pcTags->origin.y;
-			nd->mTransformation.c4 = pcTags->origin.z;
+		for (unsigned int i = 0; i < pcHeader->NUM_TAGS; ++i) {
+			aiNodeAnim* channel = anim->mChannels[i] = new aiNodeAnim();
+			channel->mNodeName = pScene->mRootNode->mChildren[i]->mName;
 
-			// Copy rest of transformation (need to transpose to match row-order matrix)
-			for (unsigned int a = 0; a < 3;++a) {
-				for (unsigned int m = 0; m < 3;++m) {
-					nd->mTransformation[m][a] = pcTags->orientation[a][m];
-					AI_SWAP4(nd->mTransformation[m][a]);
-				}
+			channel->mNumPositionKeys = channel->mNumRotationKeys = pcHeader->NUM_FRAMES;
+			channel->mPositionKeys = new aiVectorKey[pcHeader->NUM_FRAMES];
+			channel->mRotationKeys = new aiQuatKey[pcHeader->NUM_FRAMES];
+
+			for (unsigned int f = 0; f < pcHeader->NUM_FRAMES; ++f) {
+				aiMatrix4x4 mat;
+				TagToMatrix(pcTags[f * pcHeader->NUM_TAGS + i],mat);
+
+				aiVectorKey& pos = channel->mPositionKeys[f];
+				aiQuatKey& rot = channel->mRotationKeys[f];
+				pos.mTime = rot.mTime = f;
+
+				aiVector3D scaling;
+				mat.Decompose(scaling,rot.mValue,pos.mValue);
 			}
 		}
 	}
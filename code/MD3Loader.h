@@ -240,6 +240,12 @@ protected:
 	 */
 	const aiImporterDesc* GetInfo () const;
 
+	// -------------------------------------------------------------------
+	/** Return the tokens at the start of files in this format.
+	 * See #BaseImporter::GetMagicTokens for the details
+	 */
+	void GetMagicTokens (std::vector<uint32_t>& tokens) const;
+
 	// -------------------------------------------------------------------
 	/** Imports the given file into the given scene structure. 
 	 * See BaseImporter::InternReadFile() for details
@@ -288,6 +294,9 @@ protected:
 	/** Configuration option: process multi-part files */
 	bool configHandleMP;
 
+	/** Configuration option: import all frames as morph targets */
+	bool configMorphTargets;
+
 	/** Configuration option: name of skin file to be read */
 	std::string configSkinFile;
 
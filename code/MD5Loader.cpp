@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "StringComparison.h"
 #include "fast_atof.h"
 #include "SkeletonMeshBuilder.h"
+#include "ParallelFor.h"
 
 using namespace Assimp;
 
@@ -77,6 +78,8 @@ static const aiImporterDesc desc = {
 MD5Importer::MD5Importer()
 : mBuffer()
 , configNoAutoLoad (false)
+, configThreads (1)
+, configParallelThreshold (AI_PARALLEL_DEFAULT_THRESHOLD)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -115,6 +118,12 @@ void MD5Importer::SetupProperties(const Importer* pImp)
 {
 	// AI_CONFIG_IMPORT_MD5_NO_ANIM_AUTOLOAD
 	configNoAutoLoad = (0 !=  pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MD5_NO_ANIM_AUTOLOAD,0));
+
+	// AI_CONFIG_GLOB_MULTITHREADING
+	configThreads = GetWorkerThreadCount(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,-1));
+
+	// AI_CONFIG_GLOB_PARALLEL_THRESHOLD
+	configParallelThreshold = pImp->GetPropertyInteger(AI_CONFIG_GLOB_PARALLEL_THRESHOLD,AI_PARALLEL_DEFAULT_THRESHOLD);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -571,7 +580,7 @@ void MD5Importer::LoadMD5AnimFile ()
 	MD5::MD5Parser parser(mBuffer,fileSize);
 
 	// load the animation information from the parse tree
-	MD5::MD5AnimParser animParser(parser.mSections);
+	MD5::MD5AnimParser animParser(parser.mSections,configThreads,configParallelThreshold);
 
 	// generate and fill the output animation
 	if (animParser.mAnimatedBones.empty() || animParser.mFrames.empty() || 
@@ -183,6 +183,13 @@ protected:
 
 	/** configuration option: prevent anim autoload */
 	bool configNoAutoLoad;
+
+	/** configuration option: number of threads to parse with */
+	unsigned int configThreads;
+
+	/** configuration option: minimum number of frame lines to parse
+	 *  the frames in parallel */
+	unsigned int configParallelThreshold;
 };
 
 } // end of namespace Assimp
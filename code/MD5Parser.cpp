@@ -50,10 +50,43 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fast_atof.h"
 #include "ParsingUtils.h"
 #include "StringComparison.h"
+#include "ParallelFor.h"
 
 using namespace Assimp;
 using namespace Assimp::MD5;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Reads the keyframe values of one frame section per job. Each section writes
+ *  to its own frame, so the jobs can run in parallel. */
+class FrameJob
+{
+public:
+	FrameJob(const std::vector<const Section*>& sections, FrameList& frames)
+		: sections(sections), frames(frames)
+	{}
+
+	void operator() (unsigned int i) {
+		FrameDesc& desc = frames[i];
+
+		// continous list of floats
+		for (ElementList::const_iterator eit = sections[i]->mElements.begin(), eitEnd = sections[i]->mElements.end(); eit != eitEnd; ++eit){
+			const char* sz = (*eit).szStart;
+			while (SkipSpacesAndLineEnd(&sz))	{
+				float f;sz = fast_atoreal_move<float>(sz,f);
+				desc.mValues.push_back(f);
+			}
+		}
+	}
+
+private:
+	const std::vector<const Section*>& sections;
+	FrameList& frames;
+};
+
+} // ! anon namespace
+
 // ------------------------------------------------------------------------------------------------
 // Parse the segment structure fo a MD5 file
 MD5Parser::MD5Parser(char* _buffer, unsigned int _fileSize )
@@ -344,12 +377,17 @@ MD5MeshParser::MD5MeshParser(SectionList& mSections)
 
 // ------------------------------------------------------------------------------------------------
 // .MD5ANIM parsing function
-MD5AnimParser::MD5AnimParser(SectionList& mSections)
+MD5AnimParser::MD5AnimParser(SectionList& mSections, unsigned int numThreads /*= 1*/,
+	unsigned int parallelThreshold /*= AI_PARALLEL_DEFAULT_THRESHOLD*/)
 {
 	DefaultLogger::get()->debug("MD5AnimParser begin");
 
 	fFrameRate = 24.0f;
 	mNumAnimatedComponents = UINT_MAX;
+
+	// frame sections are only collected here and read all at once afterwards
+	std::vector<const Section*> frameSections;
+	unsigned int numFrameLines = 0;
 	for (SectionList::const_iterator iter =  mSections.begin(), iterEnd = mSections.end();iter != iterEnd;++iter) {
 		if ((*iter).mName == "hierarchy")	{
 			// "sheath"	0 63 6 
@@ -402,14 +440,8 @@ MD5AnimParser::MD5AnimParser(SectionList& mSections)
 				desc.mValues.reserve(mNumAnimatedComponents);
 			}
 
-			// now read all elements (continous list of floats)
-			for (ElementList::const_iterator eit = (*iter).mElements.begin(), eitEnd = (*iter).mElements.end(); eit != eitEnd; ++eit){
-				const char* sz = (*eit).szStart;
-				while (SkipSpacesAndLineEnd(&sz))	{
-					float f;sz = fast_atoreal_move<float>(sz,f);
-					desc.mValues.push_back(f);
-				}
-			}
+			frameSections.push_back(&(*iter));
+			numFrameLines += static_cast<unsigned int>((*iter).mElements.size());
 		}
 		else if((*iter).mName == "numFrames")	{
 			mFrames.reserve(strtoul10((*iter).mGlobalValue.c_str()));
@@ -430,6 +462,12 @@ MD5AnimParser::MD5AnimParser(SectionList& mSections)
 			fast_atoreal_move<float>((*iter).mGlobalValue.c_str(),fFrameRate);
 		}
 	}
+
+	// now read all frames. They are independent of each other.
+	FrameJob job(frameSections,mFrames);
+	ParallelFor(static_cast<unsigned int>(frameSections.size()),
+		numFrameLines < parallelThreshold ? 1 : numThreads,job);
+
 	DefaultLogger::get()->debug("MD5AnimParser end");
 }
 
@@ -299,8 +299,13 @@ public:
 	 *  preparsed list of file sections.
 	 *
 	 *  @param mSections List of file sections (output of MD5Parser)
+	 *  @param numThreads Number of threads to parse the frame sections
+	 *    with. They are independent of each other.
+	 *  @param parallelThreshold Minimum number of lines in all frame
+	 *    sections to parse them on multiple threads
 	 */
-	MD5AnimParser(SectionList& mSections);
+	MD5AnimParser(SectionList& mSections, unsigned int numThreads = 1,
+		unsigned int parallelThreshold = AI_PARALLEL_DEFAULT_THRESHOLD);
 
 	
 	//! Output frame rate
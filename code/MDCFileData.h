@@ -193,7 +193,7 @@ struct Shader
 // ---------------------------------------------------------------------------
 /** Build a floating point vertex from the compressed data in MDC files
  */
-void BuildVertex(const Frame& frame,
+void BuildVertex(const aiVector3D& localOrigin,
 	const BaseVertex& bvert,
 	const CompressedVertex& cvert,
 	aiVector3D& vXYZOut, 
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MDCLoader.h"
 #include "MD3FileData.h"
 #include "MDCNormalTable.h" // shouldn't be included by other units
+#include "MorphTargetHelper.h"
 
 using namespace Assimp;
 using namespace Assimp::MDC;
@@ -66,7 +67,7 @@ static const aiImporterDesc desc = {
 };
 
 // ------------------------------------------------------------------------------------------------
-void MDC::BuildVertex(const Frame& frame,
+void MDC::BuildVertex(const aiVector3D& localOrigin,
 	const BaseVertex& bvert,
 	const CompressedVertex& cvert,
 	aiVector3D& vXYZOut, 
@@ -76,9 +77,9 @@ void MDC::BuildVertex(const Frame& frame,
 	const float xd = (cvert.xd - AI_MDC_CVERT_BIAS) * AI_MDC_DELTA_SCALING;
 	const float yd = (cvert.yd - AI_MDC_CVERT_BIAS) * AI_MDC_DELTA_SCALING;
 	const float zd = (cvert.zd - AI_MDC_CVERT_BIAS) * AI_MDC_DELTA_SCALING;
-	vXYZOut.x = frame.localOrigin.x + AI_MDC_BASE_SCALING * (bvert.x + xd);
-	vXYZOut.y = frame.localOrigin.y + AI_MDC_BASE_SCALING * (bvert.y + yd);
-	vXYZOut.z = frame.localOrigin.z + AI_MDC_BASE_SCALING * (bvert.z + zd);
+	vXYZOut.x = localOrigin.x + AI_MDC_BASE_SCALING * (bvert.x + xd);
+	vXYZOut.y = localOrigin.y + AI_MDC_BASE_SCALING * (bvert.y + yd);
+	vXYZOut.z = localOrigin.z + AI_MDC_BASE_SCALING * (bvert.z + zd);
 
 	// compute the normal vector .. ehm ... lookup it in the table :-)
 	vNorOut.x = mdcNormals[cvert.nd][0];
@@ -120,6 +121,13 @@ const aiImporterDesc* MDCImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Files start with one of these tokens
+void MDCImporter::GetMagicTokens (std::vector<uint32_t>& tokens) const
+{
+	tokens.push_back(AI_MDC_MAGIC_NUMBER_LE);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Validate the header of the given MDC file
 void MDCImporter::ValidateHeader()
@@ -202,6 +210,76 @@ void MDCImporter::SetupProperties(const Importer* pImp)
 	if(static_cast<unsigned int>(-1) == (configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MDC_KEYFRAME,-1))){
 		configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
 	}
+
+	// AI_CONFIG_IMPORT_MORPH_TARGETS
+	configMorphTargets = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MORPH_TARGETS,0));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Decode the vertex positions and normals of a surface for a frame
+void MDCImporter::DecodeFrame(const MDC::Surface* pcSurface, unsigned int iFrame,
+	const std::vector<unsigned int>& vertexIndices, aiVector3D* pcPositions, aiVector3D* pcNormals)
+{
+	const unsigned int iMax = fileSize - (unsigned int)((const int8_t*)pcSurface-(const int8_t*)pcHeader);
+
+	// get the local origin of the frame
+	const MDC::Frame* pcFrame = (const MDC::Frame*)(mBuffer + pcHeader->ulOffsetBorderFrames) + iFrame;
+	aiVector3D vOrigin = pcFrame->localOrigin;
+	AI_SWAP4( vOrigin.x );
+	AI_SWAP4( vOrigin.y );
+	AI_SWAP4( vOrigin.z );
+
+	// each frame references a base frame and optionally a compressed frame 
+	// storing the offsets of all vertices from the base frame.
+	if (pcSurface->ulOffsetFrameBaseFrames + (iFrame+1) * sizeof(int16_t) > iMax ||
+		(pcSurface->ulNumCompFrames && pcSurface->ulOffsetFrameCompFrames + (iFrame+1) * sizeof(int16_t) > iMax)) {
+		throw DeadlyImportError("MDC: The frame tables of a surface are outside the file");
+	}
+
+	int16_t iBase = *((const int16_t*) ((const int8_t*) pcSurface + pcSurface->ulOffsetFrameBaseFrames) + iFrame);
+	AI_SWAP2(iBase);
+	if (iBase < 0 || (unsigned int)iBase >= pcSurface->ulNumBaseFrames ||
+		pcSurface->ulOffsetBaseVerts + (iBase+1) * pcSurface->ulNumVertices * sizeof(MDC::BaseVertex) > iMax) {
+		throw DeadlyImportError("MDC: Invalid base frame index");
+	}
+	const MDC::BaseVertex* const pcVerts = (const MDC::BaseVertex*)
+		((const int8_t*)pcSurface+pcSurface->ulOffsetBaseVerts) + iBase * pcSurface->ulNumVertices;
+
+	const MDC::CompressedVertex* pcCVerts = NULL;
+	if (pcSurface->ulNumCompFrames) {
+		int16_t iComp = *((const int16_t*) ((const int8_t*) pcSurface + pcSurface->ulOffsetFrameCompFrames) + iFrame);
+		AI_SWAP2(iComp);
+		if (iComp >= 0) {
+			if ((unsigned int)iComp >= pcSurface->ulNumCompFrames ||
+				pcSurface->ulOffsetCompVerts + (iComp+1) * pcSurface->ulNumVertices * sizeof(MDC::CompressedVertex) > iMax) {
+				throw DeadlyImportError("MDC: Invalid compressed frame index");
+			}
+			pcCVerts = (const MDC::CompressedVertex*)((const int8_t*)pcSurface +
+				pcSurface->ulOffsetCompVerts) + iComp * pcSurface->ulNumVertices;
+		}
+	}
+
+	for (unsigned int i = 0; i < (unsigned int)vertexIndices.size();++i) {
+		MDC::BaseVertex vert = pcVerts[vertexIndices[i]];
+		AI_SWAP2( vert.normal );
+		AI_SWAP2( vert.x );
+		AI_SWAP2( vert.y );
+		AI_SWAP2( vert.z );
+
+		// compressed vertices?
+		if (pcCVerts) {
+			MDC::BuildVertex(vOrigin,vert,pcCVerts[vertexIndices[i]],pcPositions[i],pcNormals[i]);
+		}
+		else {
+			// copy position
+			pcPositions[i].x = vert.x * AI_MDC_BASE_SCALING + vOrigin.x;
+			pcPositions[i].y = vert.y * AI_MDC_BASE_SCALING + vOrigin.y;
+			pcPositions[i].z = vert.z * AI_MDC_BASE_SCALING + vOrigin.z;
+
+			// copy normals
+			MD3::LatLngNormalToVec3( vert.normal, &pcNormals[i].x );
+		}
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -230,16 +308,6 @@ void MDCImporter::InternReadFile(
 
 	std::vector<std::string> aszShaders;
 
-	// get a pointer to the frame we want to read
-	BE_NCONST MDC::Frame* pcFrame = (BE_NCONST MDC::Frame*)(this->mBuffer+
-		this->pcHeader->ulOffsetBorderFrames);
-
-	// no need to swap the other members, we won't need them
-	pcFrame += configFrameID;
-	AI_SWAP4( pcFrame->localOrigin[0] );
-	AI_SWAP4( pcFrame->localOrigin[1] );
-	AI_SWAP4( pcFrame->localOrigin[2] );
-
 	// get the number of valid surfaces
 	BE_NCONST MDC::Surface* pcSurface, *pcSurface2;
 	pcSurface = pcSurface2 = new (mBuffer + pcHeader->ulOffsetSurfaces) MDC::Surface;
@@ -295,10 +363,10 @@ void MDCImporter::InternReadFile(
 		else pcMesh->mMaterialIndex = iDefaultMatIndex;
 
 		// allocate output storage for the mesh
-		aiVector3D* pcVertCur	= pcMesh->mVertices			= new aiVector3D[pcMesh->mNumVertices];
-		aiVector3D* pcNorCur	= pcMesh->mNormals			= new aiVector3D[pcMesh->mNumVertices];
-		aiVector3D* pcUVCur		= pcMesh->mTextureCoords[0] = new aiVector3D[pcMesh->mNumVertices];
-		aiFace* pcFaceCur		= pcMesh->mFaces			= new aiFace[pcMesh->mNumFaces];
+		pcMesh->mVertices			= new aiVector3D[pcMesh->mNumVertices];
+		pcMesh->mNormals			= new aiVector3D[pcMesh->mNumVertices];
+		pcMesh->mTextureCoords[0]	= new aiVector3D[pcMesh->mNumVertices];
+		pcMesh->mFaces				= new aiFace[pcMesh->mNumFaces];
 
 		// create all vertices/faces
 		BE_NCONST MDC::Triangle* pcTriangle = (BE_NCONST MDC::Triangle*)
@@ -307,108 +375,55 @@ void MDCImporter::InternReadFile(
 		BE_NCONST MDC::TexturCoord* const pcUVs = (BE_NCONST MDC::TexturCoord*)
 			((int8_t*)pcSurface+pcSurface->ulOffsetTexCoords);
 
-		// get a pointer to the uncompressed vertices
-		int16_t iOfs = *((int16_t*) ((int8_t*) pcSurface +
-			pcSurface->ulOffsetFrameBaseFrames) +  this->configFrameID);
-
-		AI_SWAP2(iOfs);
-
-		BE_NCONST MDC::BaseVertex* const pcVerts = (BE_NCONST MDC::BaseVertex*)
-			((int8_t*)pcSurface+pcSurface->ulOffsetBaseVerts) +
-			((int)iOfs * pcSurface->ulNumVertices * 4);
-
-		// do the main swapping stuff ...
-#if (defined AI_BUILD_BIG_ENDIAN)
-
-		// swap all triangles
-		for (unsigned int i = 0; i < pcSurface->ulNumTriangles;++i)
-		{
-			AI_SWAP4( pcTriangle[i].aiIndices[0] );
-			AI_SWAP4( pcTriangle[i].aiIndices[1] );
-			AI_SWAP4( pcTriangle[i].aiIndices[2] );
-		}
-
-		// swap all vertices
-		for (unsigned int i = 0; i < pcSurface->ulNumVertices*pcSurface->ulNumBaseFrames;++i)
-		{
-			AI_SWAP2( pcVerts->normal );
-			AI_SWAP2( pcVerts->x );
-			AI_SWAP2( pcVerts->y );
-			AI_SWAP2( pcVerts->z );
-		}
-
-		// swap all texture coordinates
-		for (unsigned int i = 0; i < pcSurface->ulNumVertices;++i)
-		{
-			AI_SWAP4( pcUVs->v );
-			AI_SWAP4( pcUVs->v );
-		}
-
-#endif
-
-		const MDC::CompressedVertex* pcCVerts = NULL;
-		int16_t* mdcCompVert = NULL;
-
-		// access compressed frames for large frame numbers, but never for the first
-		if( this->configFrameID && pcSurface->ulNumCompFrames > 0 )
-		{
-			mdcCompVert = (int16_t*) ((int8_t*)pcSurface+pcSurface->ulOffsetFrameCompFrames) + this->configFrameID;
-			AI_SWAP2P(mdcCompVert);
-			if( *mdcCompVert >= 0 )
-			{
-				pcCVerts = (const MDC::CompressedVertex*)((int8_t*)pcSurface +
-					pcSurface->ulOffsetCompVerts) + *mdcCompVert * pcSurface->ulNumVertices;
-			}
-			else mdcCompVert = NULL;
-		}
+		// source vertex for each output vertex, used to decode the frames
+		std::vector<unsigned int> vertexIndices(pcMesh->mNumVertices);
 
 		// copy all faces
-		for (unsigned int iFace = 0; iFace < pcSurface->ulNumTriangles;++iFace,
-			++pcTriangle,++pcFaceCur)
+		for (unsigned int iFace = 0; iFace < pcSurface->ulNumTriangles;++iFace,++pcTriangle)
 		{
 			const unsigned int iOutIndex = iFace*3;
-			pcFaceCur->mNumIndices = 3;
-			pcFaceCur->mIndices = new unsigned int[3];
+			aiFace& face = pcMesh->mFaces[iFace];
+			face.mNumIndices = 3;
+			face.mIndices = new unsigned int[3];
 
-			for (unsigned int iIndex = 0; iIndex < 3;++iIndex,
-				++pcVertCur,++pcUVCur,++pcNorCur)
+			for (unsigned int iIndex = 0; iIndex < 3;++iIndex)
 			{
 				uint32_t quak = pcTriangle->aiIndices[iIndex];
+				AI_SWAP4(quak);
 				if (quak >= pcSurface->ulNumVertices)
 				{
 					DefaultLogger::get()->error("MDC vertex index is out of range");
 					quak = pcSurface->ulNumVertices-1;
 				}
+				vertexIndices[iOutIndex+iIndex] = quak;
+
+				// copy texture coordinates
+				MDC::TexturCoord uv = pcUVs[quak];
+				AI_SWAP4(uv.u);
+				AI_SWAP4(uv.v);
+				pcMesh->mTextureCoords[0][iOutIndex+iIndex].x = uv.u;
+				pcMesh->mTextureCoords[0][iOutIndex+iIndex].y = 1.0f-uv.v; // DX to OGL
+			}
 
-				// compressed vertices?
-				if (mdcCompVert)
-				{
-					MDC::BuildVertex(*pcFrame,pcVerts[quak],pcCVerts[quak],
-						*pcVertCur,*pcNorCur);
-				}
-				else
-				{
-					// copy position
-					pcVertCur->x = pcVerts[quak].x * AI_MDC_BASE_SCALING;
-					pcVertCur->y = pcVerts[quak].y * AI_MDC_BASE_SCALING;
-					pcVertCur->z = pcVerts[quak].z * AI_MDC_BASE_SCALING;
+			// swap the face order - DX to OGL
+			face.mIndices[0] = iOutIndex + 2;
+			face.mIndices[1] = iOutIndex + 1;
+			face.mIndices[2] = iOutIndex + 0;
+		}
 
-					// copy normals
-					MD3::LatLngNormalToVec3( pcVerts[quak].normal, &pcNorCur->x );
+		// read the vertices of the requested frame
+		DecodeFrame(pcSurface,configFrameID,vertexIndices,pcMesh->mVertices,pcMesh->mNormals);
 
-					// copy texture coordinates
-					pcUVCur->x = pcUVs[quak].u;
-					pcUVCur->y = 1.0f-pcUVs[quak].v; // DX to OGL
-				}
-				pcVertCur->x += pcFrame->localOrigin[0] ;
-				pcVertCur->y += pcFrame->localOrigin[1] ;
-				pcVertCur->z += pcFrame->localOrigin[2] ;
-			}
+		// ... and those of all frames if requested. Vertex animations
+		// refer to meshes by name, so use the name of the surface.
+		if (configMorphTargets) {
+			pcMesh->mName.Set((const char*)pcSurface->ucName);
 
-			// swap the face order - DX to OGL
-			pcFaceCur->mIndices[0] = iOutIndex + 2;
-			pcFaceCur->mIndices[1] = iOutIndex + 1;
-			pcFaceCur->mIndices[2] = iOutIndex + 0;
+			AllocateMorphTargets(pcMesh,pcHeader->ulNumFrames);
+			for (unsigned int f = 0; f < pcHeader->ulNumFrames;++f) {
+				DecodeFrame(pcSurface,f,vertexIndices,
+					pcMesh->mAnimMeshes[f]->mVertices,pcMesh->mAnimMeshes[f]->mNormals);
+			}
 		}
 
 		pcSurface =  new ((int8_t*)pcSurface + pcSurface->ulOffsetEnd) MDC::Surface;
@@ -446,6 +461,11 @@ void MDCImporter::InternReadFile(
 	for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
 		pScene->mMeshes[i]->mTextureCoords[3] = NULL;
 
+	// setup the animation for all frames
+	if (configMorphTargets) {
+		AddMorphTargetAnimation(pScene,0.);
+	}
+
 	// create materials
 	pScene->mNumMaterials = (unsigned int)aszShaders.size();
 	pScene->mMaterials = new aiMaterial*[pScene->mNumMaterials];
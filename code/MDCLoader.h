@@ -86,6 +86,12 @@ protected:
 	 */
 	const aiImporterDesc* GetInfo () const;
 
+	// -------------------------------------------------------------------
+	/** Return the tokens at the start of files in this format.
+	 * See #BaseImporter::GetMagicTokens for the details
+	 */
+	void GetMagicTokens (std::vector<uint32_t>& tokens) const;
+
 	// -------------------------------------------------------------------
 	/** Imports the given file into the given scene structure. 
 	* See BaseImporter::InternReadFile() for details
@@ -106,12 +112,28 @@ protected:
 	*/
 	void ValidateSurfaceHeader(BE_NCONST MDC::Surface* pcSurf);
 
+	// -------------------------------------------------------------------
+	/** Decode the vertex positions and normals of a surface for a frame
+	 *  @param pcSurf Surface header
+	 *  @param iFrame Index of the frame
+	 *  @param vertexIndices Index of the source vertex for each output 
+	 *    vertex, must be valid.
+	 *  @param pcPositions Receives vertexIndices.size() positions
+	 *  @param pcNormals Receives vertexIndices.size() normals
+	 */
+	void DecodeFrame(const MDC::Surface* pcSurf, unsigned int iFrame,
+		const std::vector<unsigned int>& vertexIndices,
+		aiVector3D* pcPositions, aiVector3D* pcNormals);
+
 protected:
 
 
 	/** Configuration option: frame to be loaded */
 	unsigned int configFrameID;
 
+	/** Configuration option: import all frames as morph targets */
+	bool configMorphTargets;
+
 	/** Header of the MDC file */
 	BE_NCONST MDC::Header* pcHeader;
 
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MDLLoader.h"
 #include "MDLDefaultColorMap.h"
 #include "MD2FileData.h" 
+#include "MorphTargetHelper.h"
 
 using namespace Assimp;
 
@@ -123,6 +124,9 @@ void MDLImporter::SetupProperties(const Importer* pImp)
 		configFrameID =  pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
 	}
 
+	// AI_CONFIG_IMPORT_MORPH_TARGETS
+	configMorphTargets = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MORPH_TARGETS,0));
+
 	// AI_CONFIG_IMPORT_MDL_COLORMAP - pallette file
 	configPalette =  pImp->GetPropertyString(AI_CONFIG_IMPORT_MDL_COLORMAP,"colormap.lmp");
 }
@@ -134,6 +138,20 @@ const aiImporterDesc* MDLImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Files start with one of these tokens
+void MDLImporter::GetMagicTokens (std::vector<uint32_t>& tokens) const
+{
+	tokens.push_back(AI_MDL_MAGIC_NUMBER_LE_HL2a);
+	tokens.push_back(AI_MDL_MAGIC_NUMBER_LE_HL2b);
+	tokens.push_back(AI_MDL_MAGIC_NUMBER_LE_GS7);
+	tokens.push_back(AI_MDL_MAGIC_NUMBER_LE_GS5b);
+	tokens.push_back(AI_MDL_MAGIC_NUMBER_LE_GS5a);
+	tokens.push_back(AI_MDL_MAGIC_NUMBER_LE_GS4);
+	tokens.push_back(AI_MDL_MAGIC_NUMBER_LE_GS3);
+	tokens.push_back(AI_MDL_MAGIC_NUMBER_LE);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure. 
 void MDLImporter::InternReadFile( const std::string& pFile, 
@@ -297,6 +315,34 @@ void MDLImporter::ValidateHeader_Quake1(const MDL::Header* pcHeader)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+// Decode the positions and normals of a Quake 1 frame, given the (validated) vertex index for 
+// each output vertex.
+static void DecodeFrame_Quake1(const MDL::Header* pcHeader, const MDL::SimpleFrame* pcFrame,
+	const std::vector<unsigned int>& vertexIndices, aiVector3D* pcPositions, aiVector3D* pcNormals)
+{
+	const MDL::Vertex* pcVertices = (const MDL::Vertex*) ((pcFrame->name) + sizeof(pcFrame->name));
+	for (unsigned int i = 0; i < (unsigned int)vertexIndices.size();++i)
+	{
+		const MDL::Vertex& vert = pcVertices[vertexIndices[i]];
+
+		aiVector3D& vec = pcPositions[i];
+		vec.x = (float)vert.v[0] * pcHeader->scale[0];
+		vec.x += pcHeader->translate[0];
+
+		vec.y = (float)vert.v[1] * pcHeader->scale[1];
+		vec.y += pcHeader->translate[1];
+		//vec.y *= -1.0f;
+
+		vec.z = (float)vert.v[2] * pcHeader->scale[2];
+		vec.z += pcHeader->translate[2];
+
+		// read the normal vector from the precalculated normal table
+		MD2::LookupNormalIndex(vert.normalIndex,pcNormals[i]);
+		//pcNormals[i].y *= -1.0f;
+	}
+}
+
 #ifdef AI_BUILD_BIG_ENDIAN
 // ------------------------------------------------------------------------------------------------
 void FlipQuakeHeader(BE_NCONST MDL::Header* pcHeader)
@@ -383,23 +429,46 @@ void MDLImporter::InternReadFile_Quake1( )
 	szCurrent += sizeof(MDL::Triangle) * pcHeader->num_tris;
 	VALIDATE_FILE_SIZE(szCurrent);
 
-	// now get a pointer to the first frame in the file
-	BE_NCONST MDL::Frame* pcFrames = (BE_NCONST MDL::Frame*)szCurrent;
-	BE_NCONST MDL::SimpleFrame* pcFirstFrame;
+	// now collect all frames we need. Group frames consist of a 
+	// number of simple frames, they're flattened into one list.
+	const unsigned int iFrameSize = sizeof(MDL::Vertex) * (2 + pcHeader->num_verts) + 
+		sizeof(((MDL::SimpleFrame*)0)->name);
 
-	if (0 == pcFrames->type)
+	std::vector<const MDL::SimpleFrame*> frames;
+	for (int i = 0; i < pcHeader->num_frames && (configMorphTargets || frames.size() <= configFrameID);++i)
 	{
-		// get address of single frame
-		pcFirstFrame = &pcFrames->frame;
+		if (szCurrent + sizeof(int32_t) > mBuffer + iFileSize) {
+			DefaultLogger::get()->warn("Q1-MDL: The file contains less frames than specified in the header");
+			break;
+		}
+		int32_t iType = *((const int32_t*)szCurrent);
+		AI_SWAP4(iType);
+		szCurrent += sizeof(int32_t);
+
+		unsigned int iNumSimpleFrames = 1;
+		if (0 != iType)
+		{
+			// skip the number of frames, the bounding box and the frame intervals
+			if (szCurrent + sizeof(int32_t) > mBuffer + iFileSize) {
+				break;
+			}
+			int32_t iNum = *((const int32_t*)szCurrent);
+			AI_SWAP4(iNum);
+			if (iNum < 0 || (unsigned int)iNum > iFileSize) {
+				break;
+			}
+			iNumSimpleFrames = (unsigned int)iNum;
+			szCurrent += sizeof(int32_t) + sizeof(MDL::Vertex) * 2 + sizeof(float) * iNumSimpleFrames;
+		}
+		for (unsigned int n = 0; n < iNumSimpleFrames && szCurrent + iFrameSize <= mBuffer + iFileSize;++n)
+		{
+			frames.push_back((const MDL::SimpleFrame*)szCurrent);
+			szCurrent += iFrameSize;
+		}
 	}
-	else
-	{
-		// get the first frame in the group
-		BE_NCONST MDL::GroupFrame* pcFrames2 = (BE_NCONST MDL::GroupFrame*)pcFrames;
-		pcFirstFrame = (BE_NCONST MDL::SimpleFrame*)(&pcFrames2->time + pcFrames->type);
+	if (frames.size() <= configFrameID) {
+		throw DeadlyImportError("Q1-MDL: The requested frame is not existing the file");
 	}
-	BE_NCONST MDL::Vertex* pcVertices = (BE_NCONST MDL::Vertex*) ((pcFirstFrame->name) + sizeof(pcFirstFrame->name));
-	VALIDATE_FILE_SIZE((const unsigned char*)(pcVertices + pcHeader->num_verts));
 
 #ifdef AI_BUILD_BIG_ENDIAN
 	for (int i = 0; i<pcHeader->num_verts;++i)
@@ -433,6 +502,9 @@ void MDLImporter::InternReadFile_Quake1( )
 	pcMesh->mNormals = new aiVector3D[pcMesh->mNumVertices];
 	pcMesh->mNumUVComponents[0] = 2;
 
+	// source vertex for each output vertex, used to decode the frames
+	std::vector<unsigned int> vertexIndices(pcMesh->mNumVertices);
+
 	// there won't be more than one mesh inside the file
 	pScene->mRootNode = new aiNode();
 	pScene->mRootNode->mNumMeshes = 1;
@@ -461,21 +533,7 @@ void MDLImporter::InternReadFile_Quake1( )
 				iIndex = pcHeader->num_verts-1;
 				DefaultLogger::get()->warn("Index overflow in Q1-MDL vertex list.");
 			}
-
-			aiVector3D& vec = pcMesh->mVertices[iCurrent];
-			vec.x = (float)pcVertices[iIndex].v[0] * pcHeader->scale[0];
-			vec.x += pcHeader->translate[0];
-
-			vec.y = (float)pcVertices[iIndex].v[1] * pcHeader->scale[1];
-			vec.y += pcHeader->translate[1];
-			//vec.y *= -1.0f;
-
-			vec.z = (float)pcVertices[iIndex].v[2] * pcHeader->scale[2];
-			vec.z += pcHeader->translate[2];
-
-			// read the normal vector from the precalculated normal table
-			MD2::LookupNormalIndex(pcVertices[iIndex].normalIndex,pcMesh->mNormals[iCurrent]);
-			//pcMesh->mNormals[iCurrent].y *= -1.0f;
+			vertexIndices[iCurrent] = iIndex;
 
 			// read texture coordinates
 			float s = (float)pcTexCoords[iIndex].s;
@@ -496,7 +554,21 @@ void MDLImporter::InternReadFile_Quake1( )
 		pcMesh->mFaces[i].mIndices[2] = iTemp+0;
 		pcTriangles++;
 	}
-	return;
+
+	// read the vertices of the requested frame
+	DecodeFrame_Quake1(pcHeader,frames[configFrameID],vertexIndices,pcMesh->mVertices,pcMesh->mNormals);
+
+	// ... and those of all frames if requested
+	if (configMorphTargets) {
+		AllocateMorphTargets(pcMesh,(unsigned int)frames.size());
+		for (unsigned int i = 0; i < (unsigned int)frames.size();++i) {
+			DecodeFrame_Quake1(pcHeader,frames[i],vertexIndices,
+				pcMesh->mAnimMeshes[i]->mVertices,pcMesh->mAnimMeshes[i]->mNormals);
+		}
+
+		// Quake plays back vertex animations at 10 frames per second
+		AddMorphTargetAnimation(pScene,10.);
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -112,6 +112,12 @@ protected:
 	 */
 	const aiImporterDesc* GetInfo () const;
 
+	// -------------------------------------------------------------------
+	/** Return the tokens at the start of files in this format.
+	 * See #BaseImporter::GetMagicTokens for the details
+	 */
+	void GetMagicTokens (std::vector<uint32_t>& tokens) const;
+
 	// -------------------------------------------------------------------
 	/** Imports the given file into the given scene structure. 
 	* See BaseImporter::InternReadFile() for details
@@ -431,6 +437,10 @@ protected:
 	/** Configuration option: frame to be loaded */
 	unsigned int configFrameID;
 
+	/** Configuration option: import all frames as morph targets
+	 *  (Quake 1 models only) */
+	bool configMorphTargets;
+
 	/** Configuration option: palette to be used to decode palletized images*/
 	std::string configPalette;
 
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssimpPCH.h"
 #include "MakeVerboseFormat.h"
+#include "ProcessHelper.h"
 
 using namespace Assimp;
 
@@ -82,7 +83,10 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
 	ai_assert(NULL != pcMesh);
 
 	unsigned int iOldNumVertices = pcMesh->mNumVertices;
-	const unsigned int iNumVerts = pcMesh->mNumFaces*3;
+	unsigned int iNumVerts = 0;
+	for (unsigned int a = 0; a < pcMesh->mNumFaces;++a) {
+		iNumVerts += pcMesh->mFaces[a].mNumIndices;
+	}
 
 	aiVector3D* pvPositions = new aiVector3D[ iNumVerts ];
 
@@ -115,6 +119,9 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
 		newWeights[i].reserve(pcMesh->mBones[i]->mNumWeights*3);
 	}
 
+	// source vertex of each output vertex, for the anim meshes
+	std::vector<unsigned int> sourceIndex(pcMesh->mNumAnimMeshes ? iNumVerts : 0);
+
 	// iterate through all faces and build a clean list
 	unsigned int iIndex = 0;
 	for (unsigned int a = 0; a< pcMesh->mNumFaces;++a)
@@ -162,6 +169,9 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
 				apvColorSets[p][iIndex] = pcMesh->mColors[p][pcFace->mIndices[q]];
 				++p;
 			}
+			if (!sourceIndex.empty()) {
+				sourceIndex[iIndex] = pcFace->mIndices[q];
+			}
 			pcFace->mIndices[q] = iIndex;
 		}
 	}
@@ -169,7 +179,8 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
 	// build output vertex weights
 	for (unsigned int i = 0;i < pcMesh->mNumBones;++i) 
 	{
-		delete pcMesh->mBones[i]->mWeights;
+		delete[] pcMesh->mBones[i]->mWeights;
+		pcMesh->mBones[i]->mNumWeights = newWeights[i].size();
 		if (!newWeights[i].empty())
 		{
 			pcMesh->mBones[i]->mWeights = new aiVertexWeight[newWeights[i].size()];
@@ -178,6 +189,7 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
 		}
 		else pcMesh->mBones[i]->mWeights = NULL;
 	}
+	delete[] newWeights;
 
 	// delete the old members
 	delete[] pcMesh->mVertices;
@@ -186,14 +198,14 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
 	p = 0;
 	while (pcMesh->HasTextureCoords(p))
 	{
-		delete pcMesh->mTextureCoords[p];
+		delete[] pcMesh->mTextureCoords[p];
 		pcMesh->mTextureCoords[p] = apvTextureCoords[p];
 		++p;
 	}
 	p = 0;
 	while (pcMesh->HasVertexColors(p))
 	{
-		delete pcMesh->mColors[p];
+		delete[] pcMesh->mColors[p];
 		pcMesh->mColors[p] = apvColorSets[p];
 		++p;
 	}
@@ -211,5 +223,9 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
 		delete[] pcMesh->mBitangents;
 		pcMesh->mBitangents = pvBitangents;
 	}
+
+	if (!sourceIndex.empty()) {
+		RemapAnimMeshes(pcMesh,pcMesh,&sourceIndex[0]);
+	}
 	return (pcMesh->mNumVertices != iOldNumVertices);
 }
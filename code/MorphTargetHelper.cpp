@@ -0,0 +1,126 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  MorphTargetHelper.cpp
+ *  @brief Implementation of the morph target utilities shared by the loaders
+ *    of vertex animated formats.
+ */
+
+#include "AssimpPCH.h"
+#include "MorphTargetHelper.h"
+
+namespace Assimp	{
+
+// ------------------------------------------------------------------------------------------------
+void AllocateMorphTargets(aiMesh* mesh, unsigned int numFrames)
+{
+	ai_assert(NULL != mesh && numFrames && mesh->mNumVertices);
+
+	mesh->mNumAnimMeshes = numFrames;
+	mesh->mAnimMeshes = new aiAnimMesh*[numFrames];
+	for (unsigned int i = 0; i < numFrames; ++i) {
+		aiAnimMesh* anim = mesh->mAnimMeshes[i] = new aiAnimMesh();
+
+		anim->mNumVertices = mesh->mNumVertices;
+		anim->mVertices = new aiVector3D[mesh->mNumVertices];
+		if (mesh->HasNormals()) {
+			anim->mNormals = new aiVector3D[mesh->mNumVertices];
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+aiAnimation* AddMorphTargetAnimation(aiScene* scene, double ticksPerSecond)
+{
+	ai_assert(NULL != scene);
+
+	// collect one representative mesh for each mesh name
+	std::vector<const aiMesh*> channels;
+	unsigned int maxFrames = 0;
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		aiMesh* mesh = scene->mMeshes[i];
+		if (!mesh->mNumAnimMeshes) {
+			continue;
+		}
+		if (!mesh->mName.length) {
+			mesh->mName.length = ::sprintf(mesh->mName.data,"<MorphMesh_%u>",i);
+		}
+		maxFrames = std::max(maxFrames,mesh->mNumAnimMeshes);
+
+		std::vector<const aiMesh*>::const_iterator it = channels.begin();
+		for (; it != channels.end() && (*it)->mName != mesh->mName; ++it);
+		if (it == channels.end()) {
+			channels.push_back(mesh);
+		}
+	}
+	if (channels.empty()) {
+		return NULL;
+	}
+
+	aiAnimation* anim = new aiAnimation();
+	anim->mName.Set("<MorphTargets>");
+	anim->mDuration = maxFrames-1;
+	anim->mTicksPerSecond = ticksPerSecond;
+
+	anim->mNumMeshChannels = static_cast<unsigned int>(channels.size());
+	anim->mMeshChannels = new aiMeshAnim*[anim->mNumMeshChannels];
+	for (unsigned int i = 0; i < anim->mNumMeshChannels; ++i) {
+		aiMeshAnim* channel = anim->mMeshChannels[i] = new aiMeshAnim();
+		channel->mName = channels[i]->mName;
+
+		channel->mNumKeys = channels[i]->mNumAnimMeshes;
+		channel->mKeys = new aiMeshKey[channel->mNumKeys];
+		for (unsigned int n = 0; n < channel->mNumKeys; ++n) {
+			channel->mKeys[n] = aiMeshKey(n,n);
+		}
+	}
+
+	// append the animation to the list of animations of the scene
+	aiAnimation** anims = new aiAnimation*[scene->mNumAnimations+1];
+	for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+		anims[i] = scene->mAnimations[i];
+	}
+	anims[scene->mNumAnimations++] = anim;
+	delete[] scene->mAnimations;
+	scene->mAnimations = anims;
+	return anim;
+}
+
+} // end of namespace Assimp
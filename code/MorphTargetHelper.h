@@ -0,0 +1,81 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MorphTargetHelper.h
+ *  Utilities for the loaders of vertex animated formats to store all 
+ *  frames of a model as morph targets (#AI_CONFIG_IMPORT_MORPH_TARGETS)
+ */
+#ifndef AI_MORPHTARGETHELPER_H_INC
+#define AI_MORPHTARGETHELPER_H_INC
+
+struct aiMesh;
+struct aiScene;
+struct aiAnimation;
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** Allocate the anim meshes for a mesh, one for each frame.
+ *
+ *  Each anim mesh receives storage for the vertex positions and, if the
+ *  host mesh has normals, for the normals. All other vertex components 
+ *  are shared with the host mesh. The vertex count of the host mesh must
+ *  be set already.
+ *  @param mesh Mesh to receive the anim meshes
+ *  @param numFrames Number of frames, at least 1.
+ */
+void AllocateMorphTargets(aiMesh* mesh, unsigned int numFrames);
+
+// ---------------------------------------------------------------------------
+/** Add an animation to play back the anim meshes of all meshes in a scene.
+ *
+ *  Anim mesh n is bound to time n. One aiMeshAnim channel is created for
+ *  each distinct mesh name, meshes without a name are named after their
+ *  index in the scene. The animation has no node channels, the caller 
+ *  may add some.
+ *  @param scene Scene to receive the animation. 
+ *  @param ticksPerSecond Playback rate, 0 if unknown.
+ *  @return The new animation, NULL if there are no anim meshes.
+ */
+aiAnimation* AddMorphTargetAnimation(aiScene* scene, double ticksPerSecond);
+
+} // end of namespace Assimp
+
+#endif // AI_MORPHTARGETHELPER_H_INC
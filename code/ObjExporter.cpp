@@ -53,36 +53,26 @@ namespace Assimp	{
 // Worker function for exporting a scene to Wavefront OBJ. Prototyped and registered in Exporter.cpp
 void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
 {
-	// invoke the exporter 
-	ObjExporter exporter(pFile, pScene);
-
-	// we're still here - export successfully completed. Write both the main OBJ file and the material script
-	{
-		boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-		outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
-	}
-	{
-		boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
-		outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
-	}
+	// invoke the exporter, it writes both the main OBJ file and the material script as it goes
+	ObjExporter exporter(pFile, pIOSystem, pScene);
 }
 
 } // end of namespace Assimp
 
 
 // ------------------------------------------------------------------------------------------------
-ObjExporter :: ObjExporter(const char* _filename, const aiScene* pScene)
+ObjExporter :: ObjExporter(const char* _filename, IOSystem* pIOSystem, const aiScene* pScene)
 : filename(_filename)
 , pScene(pScene)
+, mOutput(pIOSystem,filename)
+, mOutputMat(pIOSystem,GetMaterialLibFileName())
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
-	mOutputMat.imbue(l);
-
 	WriteGeometryFile();
 	WriteMaterialFile();
+
+	mOutput.Flush();
+	mOutputMat.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -105,7 +95,7 @@ std::string ObjExporter :: GetMaterialLibFileName()
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter :: WriteHeader(std::ostringstream& out)
+void ObjExporter :: WriteHeader(StreamWriter& out)
 {
 	out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
 	out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.' << aiGetVersionRevision() << ")" << endl  << endl;
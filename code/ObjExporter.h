@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_OBJEXPORTER_H_INC
 #define AI_OBJEXPORTER_H_INC
 
-#include <sstream>
+#include "StreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -58,18 +58,13 @@ namespace Assimp
 class ObjExporter
 {
 public:
-	/// Constructor for a specific scene to export
-	ObjExporter(const char* filename, const aiScene* pScene);
+	/// Constructor for a specific scene to export, writes both files
+	ObjExporter(const char* filename, IOSystem* pIOSystem, const aiScene* pScene);
 
 public:
 
 	std::string GetMaterialLibName();
 	std::string GetMaterialLibFileName();
-	
-public:
-
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput, mOutputMat;
 
 private:
 
@@ -96,7 +91,7 @@ private:
 		std::vector<Face> faces;
 	};
 
-	void WriteHeader(std::ostringstream& out);
+	void WriteHeader(StreamWriter& out);
 
 	void WriteMaterialFile();
 	void WriteGeometryFile();
@@ -111,6 +106,9 @@ private:
 	const std::string filename;
 	const aiScene* const pScene;
 
+	/// buffered output to the OBJ file and the material script
+	StreamWriter mOutput, mOutputMat;
+
 	std::vector<aiVector3D> vp, vn, vt;
 	std::vector<MeshInstance> meshes;
 
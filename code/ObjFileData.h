@@ -59,50 +59,42 @@ struct Material;
 // ------------------------------------------------------------------------------------------------
 //!	\struct	Face
 //!	\brief	Data structure for a simple obj-face, describes discredit,l.ation and materials
+//!
+//!	The indices of a face are not stored in the face itself, but in the index
+//!	pools of the mesh it belongs to (see Mesh::m_VertexIndices and friends).
 struct Face
 {
-	typedef std::vector<unsigned int> IndexArray;
-
 	//!	Primitive type
 	aiPrimitiveType m_PrimitiveType;
-	//!	Vertex indices
-	IndexArray *m_pVertices;
-	//!	Normal indices
-	IndexArray *m_pNormals;
-	//!	Texture coordinates indices
-	IndexArray *m_pTexturCoords;
+	//!	Offset of the first vertex index in Mesh::m_VertexIndices
+	unsigned int m_uiVertexOffset;
+	//!	Number of vertex indices
+	unsigned int m_uiNumVertices;
+	//!	Offset of the first normal index in Mesh::m_NormalIndices
+	unsigned int m_uiNormalOffset;
+	//!	Number of normal indices, may be 0
+	unsigned int m_uiNumNormals;
+	//!	Offset of the first texture coordinate index in Mesh::m_TexturCoordIndices
+	unsigned int m_uiTexturCoordOffset;
+	//!	Number of texture coordinate indices, may be 0
+	unsigned int m_uiNumTexturCoords;
 	//!	Pointer to assigned material
 	Material *m_pMaterial;
 	
 	//!	\brief	Default constructor
-	//!	\param	pVertices	Pointer to assigned vertex indexbuffer
-	//!	\param	pNormals	Pointer to assigned normals indexbuffer
-	//!	\param	pTexCoords	Pointer to assigned texture indexbuffer
-	Face( std::vector<unsigned int> *pVertices, 
-			std::vector<unsigned int> *pNormals, 
-			std::vector<unsigned int> *pTexCoords,
-			aiPrimitiveType pt = aiPrimitiveType_POLYGON) : 
+	//!	\param	pt	Primitive type of the face
+	Face( aiPrimitiveType pt = aiPrimitiveType_POLYGON) : 
 		m_PrimitiveType( pt ), 
-		m_pVertices( pVertices ), 
-		m_pNormals( pNormals ),
-		m_pTexturCoords( pTexCoords ), 
+		m_uiVertexOffset( 0 ), 
+		m_uiNumVertices( 0 ), 
+		m_uiNormalOffset( 0 ),
+		m_uiNumNormals( 0 ),
+		m_uiTexturCoordOffset( 0 ), 
+		m_uiNumTexturCoords( 0 ), 
 		m_pMaterial( 0L )
 	{
 		// empty
 	}
-	
-	//!	\brief	Destructor	
-	~Face()
-	{	
-		delete m_pVertices;
-		m_pVertices = NULL;
-
-		delete m_pNormals;
-		m_pNormals = NULL;
-
-		delete m_pTexturCoords;
-		m_pTexturCoords = NULL;
-	}
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -201,8 +193,14 @@ struct Mesh
 {
 	static const unsigned int NoMaterial = ~0u;
 
-	///	Array with pointer to all stored faces
-	std::vector<Face*> m_Faces;
+	///	Array with all stored faces
+	std::vector<Face> m_Faces;
+	///	Vertex indices of all faces, see Face::m_uiVertexOffset
+	std::vector<unsigned int> m_VertexIndices;
+	///	Normal indices of all faces, see Face::m_uiNormalOffset
+	std::vector<unsigned int> m_NormalIndices;
+	///	Texture coordinate indices of all faces, see Face::m_uiTexturCoordOffset
+	std::vector<unsigned int> m_TexturCoordIndices;
 	///	Assigned material
 	Material *m_pMaterial;
 	///	Number of stored indices.
@@ -226,11 +224,7 @@ struct Mesh
 	///	Destructor
 	~Mesh() 
 	{
-		for (std::vector<Face*>::iterator it = m_Faces.begin();
-			it != m_Faces.end(); ++it)
-		{
-			delete *it;
-		}
+		// empty
 	}
 };
 
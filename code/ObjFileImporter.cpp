@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileImporter.h"
 #include "ObjFileParser.h"
 #include "ObjFileData.h"
+#include "ParallelFor.h"
+#include "ProcessHelper.h"
 
 static const aiImporterDesc desc = {
 	"Wavefront Object Importer",
@@ -70,7 +72,9 @@ using namespace std;
 ObjFileImporter::ObjFileImporter() :
 	m_Buffer(),	
 	m_pRootObject( NULL ),
-	m_strAbsPath( "" )
+	m_strAbsPath( "" ),
+	m_uiNumThreads( 1 ),
+	m_bSharedFaceIndices( false )
 {
     DefaultIOSystem io;
 	m_strAbsPath = io.getOsSeparator();
@@ -109,6 +113,14 @@ const aiImporterDesc* ObjFileImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+//	Setup configuration properties
+void ObjFileImporter::SetupProperties(const Importer* pImp)
+{
+	m_uiNumThreads = GetWorkerThreadCount( pImp->GetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, -1 ) );
+	m_bSharedFaceIndices = pImp->GetPropertyInteger( AI_CONFIG_GLOB_SHARED_FACE_INDICES, 0 ) != 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 //	Obj-file import implementation
 void ObjFileImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler)
@@ -142,7 +154,8 @@ void ObjFileImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 	}
 	
 	// parse the file into a temporary representation
-	ObjFileParser parser(m_Buffer, strModelName, pIOHandler);
+	ObjFileParser parser(m_Buffer, strModelName, pIOHandler, m_uiNumThreads, this);
+	UpdateImporterProgress(ProgressHandler::Phase_Convert, 0, 1);
 
 	// And create the proper return structures out of it
 	CreateDataFromImport(parser.GetModel(), pScene);
@@ -275,12 +288,12 @@ void ObjFileImporter::createTopology(const ObjFile::Model* pModel,
 	pMesh->mNumFaces = 0;
 	for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++)
 	{
-		ObjFile::Face* const inp = pObjMesh->m_Faces[ index ];
-		if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-			pMesh->mNumFaces += inp->m_pVertices->size() - 1;
+		const ObjFile::Face& inp = pObjMesh->m_Faces[ index ];
+		if (inp.m_PrimitiveType == aiPrimitiveType_LINE) {
+			pMesh->mNumFaces += inp.m_uiNumVertices - 1;
 		}
-		else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-			pMesh->mNumFaces += inp->m_pVertices->size();
+		else if (inp.m_PrimitiveType == aiPrimitiveType_POINT) {
+			pMesh->mNumFaces += inp.m_uiNumVertices;
 		}
 		else {
 			++pMesh->mNumFaces;
@@ -301,31 +314,29 @@ void ObjFileImporter::createTopology(const ObjFile::Model* pModel,
 		// Copy all data from all stored meshes
 		for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++)
 		{
-			ObjFile::Face* const inp = pObjMesh->m_Faces[ index ];
-			if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-				for(size_t i = 0; i < inp->m_pVertices->size() - 1; ++i) {
+			const ObjFile::Face& inp = pObjMesh->m_Faces[ index ];
+			if (inp.m_PrimitiveType == aiPrimitiveType_LINE) {
+				for(size_t i = 0; i < inp.m_uiNumVertices - 1; ++i) {
 					aiFace& f = pMesh->mFaces[ outIndex++ ];
 					uiIdxCount += f.mNumIndices = 2;
-					f.mIndices = new unsigned int[2];
 				}
 				continue;
 			}
-			else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-				for(size_t i = 0; i < inp->m_pVertices->size(); ++i) {
+			else if (inp.m_PrimitiveType == aiPrimitiveType_POINT) {
+				for(size_t i = 0; i < inp.m_uiNumVertices; ++i) {
 					aiFace& f = pMesh->mFaces[ outIndex++ ];
 					uiIdxCount += f.mNumIndices = 1;
-					f.mIndices = new unsigned int[1];
 				}
 				continue;
 			}
 
 			aiFace *pFace = &pMesh->mFaces[ outIndex++ ];
-			const unsigned int uiNumIndices = (unsigned int) pObjMesh->m_Faces[ index ]->m_pVertices->size();
+			const unsigned int uiNumIndices = inp.m_uiNumVertices;
 			uiIdxCount += pFace->mNumIndices = (unsigned int) uiNumIndices;
-			if (pFace->mNumIndices > 0) {
-				pFace->mIndices = new unsigned int[ uiNumIndices ];			
-			}
 		}
+
+		// allocate the indices of all faces, they are filled in by createVertexArray()
+		AllocateFaceIndices(pMesh, m_bSharedFaceIndices);
 	}
 
 	// Create mesh vertices
@@ -372,21 +383,28 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
 	for ( size_t index=0; index < pObjMesh->m_Faces.size(); index++ )
 	{
 		// Get source face
-		ObjFile::Face *pSourceFace = pObjMesh->m_Faces[ index ]; 
+		const ObjFile::Face *pSourceFace = &pObjMesh->m_Faces[ index ]; 
+		const unsigned int *pVertices = pSourceFace->m_uiNumVertices ? &pObjMesh->m_VertexIndices[ pSourceFace->m_uiVertexOffset ] : NULL;
+		const unsigned int *pNormals = pSourceFace->m_uiNumNormals ? &pObjMesh->m_NormalIndices[ pSourceFace->m_uiNormalOffset ] : NULL;
+		const unsigned int *pTexturCoords = pSourceFace->m_uiNumTexturCoords ? &pObjMesh->m_TexturCoordIndices[ pSourceFace->m_uiTexturCoordOffset ] : NULL;
+
+		if ( ( pNormals && pSourceFace->m_uiNumNormals < pSourceFace->m_uiNumVertices ) ||
+			( pTexturCoords && pSourceFace->m_uiNumTexturCoords < pSourceFace->m_uiNumVertices ) )
+			throw DeadlyImportError( "OBJ: inconsistent number of indices in face" );
 
 		// Copy all index arrays
-		for ( size_t vertexIndex = 0, outVertexIndex = 0; vertexIndex < pSourceFace->m_pVertices->size(); vertexIndex++ )
+		for ( size_t vertexIndex = 0, outVertexIndex = 0; vertexIndex < pSourceFace->m_uiNumVertices; vertexIndex++ )
 		{
-			const unsigned int vertex = pSourceFace->m_pVertices->at( vertexIndex );
+			const unsigned int vertex = pVertices[ vertexIndex ];
 			if ( vertex >= pModel->m_Vertices.size() ) 
 				throw DeadlyImportError( "OBJ: vertex index out of range" );
 			
 			pMesh->mVertices[ newIndex ] = pModel->m_Vertices[ vertex ];
 			
 			// Copy all normals 
-			if ( !pSourceFace->m_pNormals->empty() && !pModel->m_Normals.empty())
+			if ( pNormals && !pModel->m_Normals.empty())
 			{
-				const unsigned int normal = pSourceFace->m_pNormals->at( vertexIndex );
+				const unsigned int normal = pNormals[ vertexIndex ];
 				if ( normal >= pModel->m_Normals.size() )
 					throw DeadlyImportError("OBJ: vertex normal index out of range");
 
@@ -396,9 +414,9 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
 			// Copy all texture coordinates
 			if ( !pModel->m_TextureCoord.empty() )
 			{
-				if ( !pSourceFace->m_pTexturCoords->empty() )
+				if ( pTexturCoords )
 				{
-					const unsigned int tex = pSourceFace->m_pTexturCoords->at( vertexIndex );
+					const unsigned int tex = pTexturCoords[ vertexIndex ];
 					ai_assert( tex < pModel->m_TextureCoord.size() );
 					for ( size_t i=0; i < pMesh->GetNumUVChannels(); i++ )
 					{
@@ -416,7 +434,7 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
 			// Get destination face
 			aiFace *pDestFace = &pMesh->mFaces[ outIndex ];
 
-			const bool last = ( vertexIndex == pSourceFace->m_pVertices->size() - 1 ); 
+			const bool last = ( vertexIndex == pSourceFace->m_uiNumVertices - 1 ); 
 			if (pSourceFace->m_PrimitiveType != aiPrimitiveType_LINE || !last) 
 			{
 				pDestFace->mIndices[ outVertexIndex ] = newIndex;
@@ -438,7 +456,7 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
 				if (vertexIndex) {
 					if(!last) {
 						pMesh->mVertices[ newIndex+1 ] = pMesh->mVertices[ newIndex ];
-						if ( !pSourceFace->m_pNormals->empty() && !pModel->m_Normals.empty()) {
+						if ( pNormals && !pModel->m_Normals.empty()) {
 							pMesh->mNormals[ newIndex+1 ] = pMesh->mNormals[newIndex ];
 						}
 						if ( !pModel->m_TextureCoord.empty() ) {
@@ -80,6 +80,9 @@ private:
 	//! \brief	Appends the supported extention.
 	const aiImporterDesc* GetInfo () const;
 
+	//!	\brief	Reads the multithreading configuration.
+	void SetupProperties(const Importer* pImp);
+
 	//!	\brief	File import implementation.
 	void InternReadFile(const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler);
 	
@@ -117,6 +120,10 @@ private:
 	ObjFile::Object *m_pRootObject;
 	//!	Absolute pathname of model in filesystem
 	std::string m_strAbsPath;
+	//!	Number of threads to use for parsing
+	unsigned int m_uiNumThreads;
+	//!	Store the face indices of a mesh in a single array
+	bool m_bSharedFaceIndices;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -49,21 +49,199 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "../include/assimp/types.h"
 #include "DefaultIOSystem.h"
+#include "ParallelFor.h"
 
 namespace Assimp	
 {
 
 // -------------------------------------------------------------------
 const std::string ObjFileParser::DEFAULT_MATERIAL = AI_DEFAULT_MATERIAL_NAME; 
+const size_t ObjFileParser::MIN_CHUNKSIZE;
+
+// -------------------------------------------------------------------
+//	Line-aligned part of the input buffer, for parallel parsing
+struct ObjFileParser::Chunk
+{
+	Chunk() :
+		m_uiNumVertices(0),
+		m_uiNumNormals(0),
+		m_uiNumTexturCoords(0),
+		m_uiVertexBase(0),
+		m_uiNormalBase(0),
+		m_uiTexturCoordBase(0)
+	{
+		// empty
+	}
+
+	//!	Range of the chunk, both ends are at statement boundaries
+	DataArrayIt m_Begin, m_End;
+	//!	Number of v, vn and vt statements in the chunk
+	unsigned int m_uiNumVertices, m_uiNumNormals, m_uiNumTexturCoords;
+	//!	Number of v, vn and vt statements in all preceding chunks
+	unsigned int m_uiVertexBase, m_uiNormalBase, m_uiTexturCoordBase;
+	//!	Faces of the chunk, mesh and material assignment is done in the final pass
+	ObjFile::Mesh m_Faces;
+	//!	All other statements of the chunk which need to be replayed in the final 
+	//!	pass: number of faces preceding the statement, start of the statement
+	std::vector< std::pair<unsigned int, DataArrayIt> > m_Statements;
+};
+
+// -------------------------------------------------------------------
+//	Runs one pass of parseChunk() for a set of chunks
+struct ObjFileParser::ChunkJob
+{
+	ChunkJob(const ObjFileParser &parser, std::vector<Chunk> &chunks, bool bCount) :
+		m_Parser(parser),
+		m_Chunks(chunks),
+		m_bCount(bCount)
+	{
+		// empty
+	}
+
+	void operator() (unsigned int index)
+	{
+		m_Parser.parseChunk(m_Chunks[index], m_bCount);
+	}
+
+	const ObjFileParser &m_Parser;
+	std::vector<Chunk> &m_Chunks;
+	const bool m_bCount;
+};
+
+// -------------------------------------------------------------------
+//	Reads up to uiCount numbers of the current statement. The input 
+//	buffer is zero-terminated and statements end at line ends, so the 
+//	numbers can be parsed in place. Missing components are zero.
+static ObjFileParser::DataArrayIt readFloats(ObjFileParser::DataArrayIt it, 
+	ObjFileParser::DataArrayIt end, float *pValues, unsigned int uiCount)
+{
+	std::fill(pValues, pValues + uiCount, 0.f);
+	if ( it == end )
+		return it;
+
+	const char *pStart = &*it, *pEnd = pStart;
+	fast_atoreal_n<float>(pStart, pValues, uiCount, &pEnd);
+	return it + (pEnd - pStart);
+}
+
+// -------------------------------------------------------------------
+//	Reads the components of a 'v' or 'vn' statement
+static ObjFileParser::DataArrayIt readVector3(ObjFileParser::DataArrayIt it, 
+	ObjFileParser::DataArrayIt end, aiVector3D &vector)
+{
+	float xyz[3];
+	it = readFloats(it, end, xyz, 3);
+	vector.Set(xyz[0], xyz[1], xyz[2]);
+	return it;
+}
+
+// -------------------------------------------------------------------
+//	Reads the components of a 'vt' statement
+static ObjFileParser::DataArrayIt readVector2(ObjFileParser::DataArrayIt it, 
+	ObjFileParser::DataArrayIt end, aiVector2D &vector)
+{
+	float xy[2];
+	it = readFloats(it, end, xy, 2);
+	vector.Set(xy[0], xy[1]);
+	return it;
+}
+
+// -------------------------------------------------------------------
+//	Reads the index tuples of a face, line or point statement into the index 
+//	pools of pools. Relative indices are resolved against the given number 
+//	of vertices, texture coordinates and normals read so far.
+static ObjFileParser::DataArrayIt readFaceIndices(ObjFileParser::DataArrayIt it, 
+	ObjFileParser::DataArrayIt end, aiPrimitiveType type, 
+	unsigned int uiNumVertices, unsigned int uiNumTexturCoords, unsigned int uiNumNormals,
+	ObjFile::Face &face, ObjFile::Mesh &pools)
+{
+	face.m_PrimitiveType = type;
+	face.m_uiVertexOffset = (unsigned int) pools.m_VertexIndices.size();
+	face.m_uiNormalOffset = (unsigned int) pools.m_NormalIndices.size();
+	face.m_uiTexturCoordOffset = (unsigned int) pools.m_TexturCoordIndices.size();
+
+	const bool vt = (0 != uiNumTexturCoords);
+	const bool vn = (0 != uiNumNormals);
+
+	// Skip the statement keyword
+	while ( it != end && !isSeparator( *it ) )
+		++it;
+
+	int iPos = 0;
+	while ( it != end && !IsLineEnd( *it ) )
+	{
+		if ( *it == '/' )
+		{
+			if (type == aiPrimitiveType_POINT) {
+				DefaultLogger::get()->error("Obj: Separator unexpected in point statement");
+			}
+			if (iPos == 0)
+			{
+				//if there are no texture coordinates in the file, but normals
+				if (!vt && vn) {
+					iPos = 1;
+					if ( ++it == end )
+						break;
+				}
+			}
+			iPos++;
+			++it;
+		}
+		else if ( isSeparator( *it ) )
+		{
+			iPos = 0;
+			++it;
+		}
+		else if ( IsNumeric( *it ) || *it == '-' || *it == '+' )
+		{
+			//OBJ USES 1 Base ARRAYS!!!!
+			const char *pStart = &( *it ), *pEnd = pStart;
+			const int iVal = strtol10( pStart, &pEnd );
+			it += pEnd - pStart;
+			if ( 0 == iVal )
+				continue;
+
+			// Negative indices are relative to the current end of the respective array
+			if ( 0 == iPos )
+			{
+				pools.m_VertexIndices.push_back( iVal > 0 ? iVal-1 : (unsigned int) ((int) uiNumVertices + iVal) );
+			}
+			else if ( 1 == iPos )
+			{	
+				pools.m_TexturCoordIndices.push_back( iVal > 0 ? iVal-1 : (unsigned int) ((int) uiNumTexturCoords + iVal) );
+			}
+			else if ( 2 == iPos )
+			{
+				pools.m_NormalIndices.push_back( iVal > 0 ? iVal-1 : (unsigned int) ((int) uiNumNormals + iVal) );
+			}
+			else
+			{
+				DefaultLogger::get()->error("OBJ: Not supported token in face description detected");
+			}
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	face.m_uiNumVertices = (unsigned int) pools.m_VertexIndices.size() - face.m_uiVertexOffset;
+	face.m_uiNumNormals = (unsigned int) pools.m_NormalIndices.size() - face.m_uiNormalOffset;
+	face.m_uiNumTexturCoords = (unsigned int) pools.m_TexturCoordIndices.size() - face.m_uiTexturCoordOffset;
+	return it;
+}
 
 // -------------------------------------------------------------------
 //	Constructor with loaded data and directories.
-ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem *io ) :
+ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem *io, 
+	unsigned int numThreads, const BaseImporter* pImporter ) :
 	m_DataIt(Data.begin()),
 	m_DataItEnd(Data.end()),
 	m_pModel(NULL),
 	m_uiLine(0),
-	m_pIO( io )
+	m_pIO( io ),
+	m_pFaceBuffer( new ObjFile::Mesh() ),
+	m_pImporter( pImporter )
 {
 	std::fill_n(m_buffer,BUFFERSIZE,0);
 
@@ -76,8 +254,20 @@ ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModel
 	m_pModel->m_MaterialLib.push_back( DEFAULT_MATERIAL );
 	m_pModel->m_MaterialMap[ DEFAULT_MATERIAL ] = m_pModel->m_pDefaultMaterial;
 	
-	// Start parsing the file
-	parseFile();
+	// Start parsing the file. The destructor won't run if this throws.
+	try
+	{
+		if ( numThreads > 1 && Data.size() >= 2 * MIN_CHUNKSIZE )
+			parseFileChunked( numThreads );
+		else
+			parseFile();
+	}
+	catch ( ... )
+	{
+		delete m_pModel;
+		delete m_pFaceBuffer;
+		throw;
+	}
 }
 
 // -------------------------------------------------------------------
@@ -89,6 +279,9 @@ ObjFileParser::~ObjFileParser()
 
 	delete m_pModel;
 	m_pModel = NULL;
+
+	delete m_pFaceBuffer;
+	m_pFaceBuffer = NULL;
 }
 
 // -------------------------------------------------------------------
@@ -105,85 +298,278 @@ void ObjFileParser::parseFile()
 	if (m_DataIt == m_DataItEnd)
 		return;
 
-	while (m_DataIt != m_DataItEnd)
+	const DataArrayIt begin = m_DataIt;
+	const unsigned int uiTotal = (unsigned int) std::distance( begin, m_DataItEnd );
+	for (unsigned int uiStatement = 0; m_DataIt != m_DataItEnd; ++uiStatement)
+	{
+		// report progress and check for cancellation once in a while
+		if ( m_pImporter && !(uiStatement & 0x3fff) )
+			m_pImporter->UpdateImporterProgress( ProgressHandler::Phase_Parse, (unsigned int) std::distance( begin, m_DataIt ), uiTotal );
+
+		parseStatement();
+	}
+}
+
+// -------------------------------------------------------------------
+//	Parses the statement at the current position
+void ObjFileParser::parseStatement()
+{
+	switch (*m_DataIt)
 	{
-		switch (*m_DataIt)
+	case 'v': // Parse a vertex texture coordinate
 		{
-		case 'v': // Parse a vertex texture coordinate
+			++m_DataIt;
+			if (*m_DataIt == ' ')
+			{
+				// Read in vertex definition
+				getVector3(m_pModel->m_Vertices);
+			}
+			else if (*m_DataIt == 't')
 			{
+				// Read in texture coordinate (2D)
 				++m_DataIt;
-				if (*m_DataIt == ' ')
-				{
-					// Read in vertex definition
-					getVector3(m_pModel->m_Vertices);
-				}
-				else if (*m_DataIt == 't')
-				{
-					// Read in texture coordinate (2D)
-					++m_DataIt;
-					getVector2(m_pModel->m_TextureCoord);
-				}
-				else if (*m_DataIt == 'n')
-				{
-					// Read in normal vector definition
-					++m_DataIt;
-					getVector3( m_pModel->m_Normals );
-				}
+				getVector2(m_pModel->m_TextureCoord);
 			}
-			break;
-
-		case 'p': // Parse a face, line or point statement
-		case 'l':
-		case 'f':
+			else if (*m_DataIt == 'n')
 			{
-				getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' 
-					? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
+				// Read in normal vector definition
+				++m_DataIt;
+				getVector3( m_pModel->m_Normals );
 			}
-			break;
+		}
+		break;
+
+	case 'p': // Parse a face, line or point statement
+	case 'l':
+	case 'f':
+		{
+			getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' 
+				? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
+		}
+		break;
+
+	case '#': // Parse a comment
+		{
+			getComment();
+		}
+		break;
+
+	case 'u': // Parse a material desc. setter
+		{
+			getMaterialDesc();
+		}
+		break;
+
+	case 'm': // Parse a material library
+		{
+			getMaterialLib();
+		}
+		break;
+
+	case 'g': // Parse group name
+		{
+			getGroupName();
+		}
+		break;
+
+	case 's': // Parse group number
+		{
+			getGroupNumber();
+		}
+		break;
 
-		case '#': // Parse a comment
+	case 'o': // Parse object name
+		{
+			getObjectName();
+		}
+		break;
+	
+	default:
+		{
+			m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+		}
+		break;
+	}
+}
+
+// -------------------------------------------------------------------
+//	Parses the file in three passes. The buffer is split into chunks, 
+//	which are first scanned for the number of vertex data statements
+//	they contain and then decoded, both in parallel. The final pass
+//	assigns the faces to meshes and processes all statements affecting 
+//	the object, group and material state in file order.
+void ObjFileParser::parseFileChunked(unsigned int numThreads)
+{
+	// Chunks may only start at the beginning of a non-indented line,
+	// which is always a statement boundary for the sequential parser, too.
+	const size_t uiChunkSize = std::max( (size_t) std::distance( m_DataIt, m_DataItEnd ) / numThreads, MIN_CHUNKSIZE );
+	std::vector<Chunk> chunks;
+	for ( DataArrayIt begin = m_DataIt; begin != m_DataItEnd; )
+	{
+		DataArrayIt end = m_DataItEnd;
+		if ( (size_t) std::distance( begin, m_DataItEnd ) > uiChunkSize + uiChunkSize / 2 )
+		{
+			end = begin + uiChunkSize;
+			for ( ;; )
 			{
-				getComment();
+				end = std::find( end, m_DataItEnd, '\n' );
+				if ( end == m_DataItEnd || ++end == m_DataItEnd || ( *end != ' ' && *end != '\t' ) )
+					break;
 			}
-			break;
+		}
+
+		chunks.push_back( Chunk() );
+		chunks.back().m_Begin = begin;
+		chunks.back().m_End = end;
+		begin = end;
+	}
+
+	// Progress can only be reported between the parallel passes
+	const unsigned int uiTotal = (unsigned int) std::distance( m_DataIt, m_DataItEnd );
+	if ( m_pImporter )
+		m_pImporter->UpdateImporterProgress( ProgressHandler::Phase_Parse, 0, uiTotal );
+
+	// Count vertex data per chunk and allocate the model arrays
+	ChunkJob count( *this, chunks, true );
+	ParallelFor( (unsigned int) chunks.size(), numThreads, count );
+
+	if ( m_pImporter )
+		m_pImporter->UpdateImporterProgress( ProgressHandler::Phase_Parse, uiTotal / 4, uiTotal );
+
+	unsigned int uiNumVertices = 0, uiNumNormals = 0, uiNumTexturCoords = 0;
+	for ( std::vector<Chunk>::iterator it = chunks.begin(); it != chunks.end(); ++it )
+	{
+		(*it).m_uiVertexBase = uiNumVertices;
+		(*it).m_uiNormalBase = uiNumNormals;
+		(*it).m_uiTexturCoordBase = uiNumTexturCoords;
+		uiNumVertices += (*it).m_uiNumVertices;
+		uiNumNormals += (*it).m_uiNumNormals;
+		uiNumTexturCoords += (*it).m_uiNumTexturCoords;
+	}
+	m_pModel->m_Vertices.resize( uiNumVertices );
+	m_pModel->m_Normals.resize( uiNumNormals );
+	m_pModel->m_TextureCoord.resize( uiNumTexturCoords );
+
+	// Decode vertex data and faces, each chunk writes to its own range of the model arrays
+	ChunkJob decode( *this, chunks, false );
+	ParallelFor( (unsigned int) chunks.size(), numThreads, decode );
+
+	if ( m_pImporter )
+		m_pImporter->UpdateImporterProgress( ProgressHandler::Phase_Parse, uiTotal, uiTotal );
+
+	// Assign faces to meshes, interleaved with all other statements in file order
+	for ( std::vector<Chunk>::iterator it = chunks.begin(); it != chunks.end(); ++it )
+	{
+		Chunk &chunk = *it;
+		const std::vector<ObjFile::Face> &faces = chunk.m_Faces.m_Faces;
+
+		unsigned int uiFace = 0;
+		for ( std::vector< std::pair<unsigned int, DataArrayIt> >::const_iterator st = chunk.m_Statements.begin();
+			st != chunk.m_Statements.end(); ++st )
+		{
+			for ( ; uiFace < (*st).first; ++uiFace )
+				storeFace( faces[ uiFace ], chunk.m_Faces );
 
-		case 'u': // Parse a material desc. setter
+			m_DataIt = (*st).second;
+			parseStatement();
+		}
+		for ( ; uiFace < faces.size(); ++uiFace )
+			storeFace( faces[ uiFace ], chunk.m_Faces );
+
+		// Release the chunk's index pools early
+		std::vector<ObjFile::Face>().swap( chunk.m_Faces.m_Faces );
+		std::vector<unsigned int>().swap( chunk.m_Faces.m_VertexIndices );
+		std::vector<unsigned int>().swap( chunk.m_Faces.m_NormalIndices );
+		std::vector<unsigned int>().swap( chunk.m_Faces.m_TexturCoordIndices );
+	}
+	m_DataIt = m_DataItEnd;
+}
+
+// -------------------------------------------------------------------
+//	Walks the statements of a chunk, using the same dispatch rules as
+//	parseStatement(). May be called concurrently for different chunks.
+void ObjFileParser::parseChunk(Chunk &chunk, bool bCount) const
+{
+	unsigned int uiVertex = 0, uiNormal = 0, uiTexturCoord = 0, uiLine = 0;
+	DataArrayIt it = chunk.m_Begin;
+	const DataArrayIt end = chunk.m_End;
+
+	while ( it != end )
+	{
+		switch ( *it )
+		{
+		case 'v':
+			++it;
+			if ( *it == ' ' )
 			{
-				getMaterialDesc();
+				if ( !bCount )
+					it = readVector3( it, end, m_pModel->m_Vertices[ chunk.m_uiVertexBase + uiVertex ] );
+				++uiVertex;
+				it = skipLine<DataArrayIt>( it, end, uiLine );
 			}
-			break;
-
-		case 'm': // Parse a material library
+			else if ( *it == 't' )
 			{
-				getMaterialLib();
+				++it;
+				if ( !bCount )
+					it = readVector2( it, end, m_pModel->m_TextureCoord[ chunk.m_uiTexturCoordBase + uiTexturCoord ] );
+				++uiTexturCoord;
+				it = skipLine<DataArrayIt>( it, end, uiLine );
 			}
-			break;
-
-		case 'g': // Parse group name
+			else if ( *it == 'n' )
 			{
-				getGroupName();
+				++it;
+				if ( !bCount )
+					it = readVector3( it, end, m_pModel->m_Normals[ chunk.m_uiNormalBase + uiNormal ] );
+				++uiNormal;
+				it = skipLine<DataArrayIt>( it, end, uiLine );
 			}
 			break;
 
-		case 's': // Parse group number
+		case 'p':
+		case 'l':
+		case 'f':
+			if ( !bCount )
 			{
-				getGroupNumber();
+				ObjFile::Face face;
+				it = readFaceIndices( it, end, *it == 'f' ? aiPrimitiveType_POLYGON : ( *it == 'l' 
+					? aiPrimitiveType_LINE : aiPrimitiveType_POINT ),
+					chunk.m_uiVertexBase + uiVertex, chunk.m_uiTexturCoordBase + uiTexturCoord, 
+					chunk.m_uiNormalBase + uiNormal, face, chunk.m_Faces );
+				chunk.m_Faces.m_Faces.push_back( face );
 			}
+			it = skipLine<DataArrayIt>( it, end, uiLine );
 			break;
 
-		case 'o': // Parse object name
+		case '#':
+			// Same as getComment()
+			while ( it != end )
 			{
-				getObjectName();
+				if ( '\n' == *it++ )
+					break;
 			}
 			break;
-		
+
+		case 'u':
+		case 'm':
+		case 'g':
+		case 'o':
+			if ( !bCount )
+				chunk.m_Statements.push_back( std::make_pair( (unsigned int) chunk.m_Faces.m_Faces.size(), it ) );
+			it = skipLine<DataArrayIt>( it, end, uiLine );
+			break;
+
 		default:
-			{
-				m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
-			}
+			it = skipLine<DataArrayIt>( it, end, uiLine );
 			break;
 		}
 	}
+
+	if ( bCount )
+	{
+		chunk.m_uiNumVertices = uiVertex;
+		chunk.m_uiNumNormals = uiNormal;
+		chunk.m_uiNumTexturCoords = uiTexturCoord;
+	}
 }
 
 // -------------------------------------------------------------------
@@ -224,17 +610,10 @@ void ObjFileParser::copyNextLine(char *pBuffer, size_t length)
 //	Get values for a new 3D vector instance
 void ObjFileParser::getVector3(std::vector<aiVector3D> &point3d_array)
 {
-	float x, y, z;
-	copyNextWord(m_buffer, BUFFERSIZE);
-	x = (float) fast_atof(m_buffer);	
-	
-	copyNextWord(m_buffer, BUFFERSIZE);
-	y = (float) fast_atof(m_buffer);
+	aiVector3D vector;
+	m_DataIt = readVector3( m_DataIt, m_DataItEnd, vector );
 
-	copyNextWord(m_buffer, BUFFERSIZE);
-	z = (float) fast_atof(m_buffer);
-
-	point3d_array.push_back( aiVector3D( x, y, z ) );
+	point3d_array.push_back( vector );
 	//skipLine();
 	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
@@ -243,14 +622,10 @@ void ObjFileParser::getVector3(std::vector<aiVector3D> &point3d_array)
 //	Get values for a new 2D vector instance
 void ObjFileParser::getVector2( std::vector<aiVector2D> &point2d_array )
 {
-	float x, y;
-	copyNextWord(m_buffer, BUFFERSIZE);
-	x = (float) fast_atof(m_buffer);	
-	
-	copyNextWord(m_buffer, BUFFERSIZE);
-	y = (float) fast_atof(m_buffer);
+	aiVector2D vector;
+	m_DataIt = readVector2( m_DataIt, m_DataItEnd, vector );
 
-	point2d_array.push_back(aiVector2D(x, y));
+	point2d_array.push_back( vector );
 
 	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
@@ -259,98 +634,31 @@ void ObjFileParser::getVector2( std::vector<aiVector2D> &point2d_array )
 //	Get values for a new face instance
 void ObjFileParser::getFace(aiPrimitiveType type)
 {
-	copyNextLine(m_buffer, BUFFERSIZE);
-	if (m_DataIt == m_DataItEnd)
-		return;
-
-	char *pPtr = m_buffer;
-	char *pEnd = &pPtr[BUFFERSIZE];
-	pPtr = getNextToken<char*>(pPtr, pEnd);
-	if (pPtr == pEnd || *pPtr == '\0')
-		return;
-
-	std::vector<unsigned int> *pIndices = new std::vector<unsigned int>;
-	std::vector<unsigned int> *pTexID = new std::vector<unsigned int>;
-	std::vector<unsigned int> *pNormalID = new std::vector<unsigned int>;
-	bool hasNormal = false;
-
-	const bool vt = (!m_pModel->m_TextureCoord.empty());
-	const bool vn = (!m_pModel->m_Normals.empty());
-	int iStep = 0, iPos = 0;
-	while (pPtr != pEnd)
-	{
-		iStep = 1;
-
-		if (IsLineEnd(*pPtr))
-			break;
+	// Indices are parsed into the reusable buffer pools and then copied to the mesh
+	m_pFaceBuffer->m_VertexIndices.clear();
+	m_pFaceBuffer->m_NormalIndices.clear();
+	m_pFaceBuffer->m_TexturCoordIndices.clear();
 
-		if (*pPtr=='/' )
-		{
-			if (type == aiPrimitiveType_POINT) {
-				DefaultLogger::get()->error("Obj: Separator unexpected in point statement");
-			}
-			if (iPos == 0)
-			{
-				//if there are no texture coordinates in the file, but normals
-				if (!vt && vn) {
-					iPos = 1;
-					iStep++;
-				}
-			}
-			iPos++;
-		}
-		else if ( isSeparator(*pPtr) )
-		{
-			iPos = 0;
-		}
-		else 
-		{
-			//OBJ USES 1 Base ARRAYS!!!!
-			const int iVal = atoi( pPtr );
-			int tmp = iVal;
-			while ( ( tmp = tmp / 10 )!=0 )
-				++iStep;
+	ObjFile::Face face;
+	m_DataIt = readFaceIndices( m_DataIt, m_DataItEnd, type, (unsigned int) m_pModel->m_Vertices.size(),
+		(unsigned int) m_pModel->m_TextureCoord.size(), (unsigned int) m_pModel->m_Normals.size(), 
+		face, *m_pFaceBuffer );
+	storeFace( face, *m_pFaceBuffer );
 
-			if ( iVal > 0 )
-			{
-				// Store parsed index
-				if ( 0 == iPos )
-				{
-					pIndices->push_back( iVal-1 );
-				}
-				else if ( 1 == iPos )
-				{	
-					pTexID->push_back( iVal-1 );
-				}
-				else if ( 2 == iPos )
-				{
-					pNormalID->push_back( iVal-1 );
-					hasNormal = true;
-				}
-				else
-				{
-					reportErrorTokenInFace();
-				}
-			}
-		}
-		pPtr += iStep;
-	}
+	// Skip the rest of the line
+	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+}
 
-	if ( pIndices->empty() ) 
+// -------------------------------------------------------------------
+//	Stores a face, its indices are copied from the pools of source
+void ObjFileParser::storeFace(const ObjFile::Face &face, const ObjFile::Mesh &source)
+{
+	if ( 0 == face.m_uiNumVertices ) 
 	{
 		DefaultLogger::get()->error("Obj: Ignoring empty face");
-		m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 		return;
 	}
 
-	ObjFile::Face *face = new ObjFile::Face( pIndices, pNormalID, pTexID, type );
-	
-	// Set active material, if one set
-	if (NULL != m_pModel->m_pCurrentMaterial) 
-		face->m_pMaterial = m_pModel->m_pCurrentMaterial;
-	else 
-		face->m_pMaterial = m_pModel->m_pDefaultMaterial;
-
 	// Create a default object, if nothing is there
 	if ( NULL == m_pModel->m_pCurrent )
 		createObject( "defaultobject" );
@@ -360,17 +668,43 @@ void ObjFileParser::getFace(aiPrimitiveType type)
 	{
 		createMesh();
 	}
+	ObjFile::Mesh *pMesh = m_pModel->m_pCurrentMesh;
+
+	ObjFile::Face stored( face.m_PrimitiveType );
+	
+	// Set active material, if one set
+	if (NULL != m_pModel->m_pCurrentMaterial) 
+		stored.m_pMaterial = m_pModel->m_pCurrentMaterial;
+	else 
+		stored.m_pMaterial = m_pModel->m_pDefaultMaterial;
+
+	// Copy the indices to the mesh pools
+	stored.m_uiVertexOffset = (unsigned int) pMesh->m_VertexIndices.size();
+	stored.m_uiNumVertices = face.m_uiNumVertices;
+	pMesh->m_VertexIndices.insert( pMesh->m_VertexIndices.end(), 
+		source.m_VertexIndices.begin() + face.m_uiVertexOffset,
+		source.m_VertexIndices.begin() + face.m_uiVertexOffset + face.m_uiNumVertices );
+
+	stored.m_uiNormalOffset = (unsigned int) pMesh->m_NormalIndices.size();
+	stored.m_uiNumNormals = face.m_uiNumNormals;
+	pMesh->m_NormalIndices.insert( pMesh->m_NormalIndices.end(), 
+		source.m_NormalIndices.begin() + face.m_uiNormalOffset,
+		source.m_NormalIndices.begin() + face.m_uiNormalOffset + face.m_uiNumNormals );
+
+	stored.m_uiTexturCoordOffset = (unsigned int) pMesh->m_TexturCoordIndices.size();
+	stored.m_uiNumTexturCoords = face.m_uiNumTexturCoords;
+	pMesh->m_TexturCoordIndices.insert( pMesh->m_TexturCoordIndices.end(), 
+		source.m_TexturCoordIndices.begin() + face.m_uiTexturCoordOffset,
+		source.m_TexturCoordIndices.begin() + face.m_uiTexturCoordOffset + face.m_uiNumTexturCoords );
 	
 	// Store the face
-	m_pModel->m_pCurrentMesh->m_Faces.push_back( face );
-	m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int)face->m_pVertices->size();
-	m_pModel->m_pCurrentMesh->m_uiUVCoordinates[ 0 ] += (unsigned int)face->m_pTexturCoords[0].size(); 
-	if( !m_pModel->m_pCurrentMesh->m_hasNormals && hasNormal ) 
+	pMesh->m_Faces.push_back( stored );
+	pMesh->m_uiNumIndices += face.m_uiNumVertices;
+	pMesh->m_uiUVCoordinates[ 0 ] += face.m_uiNumTexturCoords; 
+	if( !pMesh->m_hasNormals && face.m_uiNumNormals > 0 ) 
 	{
-		m_pModel->m_pCurrentMesh->m_hasNormals = true;
+		pMesh->m_hasNormals = true;
 	}
-	// Skip the rest of the line
-	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
 
 // -------------------------------------------------------------------
@@ -670,14 +1004,6 @@ bool ObjFileParser::needsNewMesh( const std::string &rMaterialName )
 	return newMat;
 }
 
-// -------------------------------------------------------------------
-//	Shows an error in parsing process.
-void ObjFileParser::reportErrorTokenInFace()
-{		
-	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
-	DefaultLogger::get()->error("OBJ: Not supported token in face description detected");
-}
-
 // -------------------------------------------------------------------
 
 }	// Namespace Assimp
@@ -54,10 +54,13 @@ namespace ObjFile
 struct Model;
 struct Object;
 struct Material;
+struct Mesh;
+struct Face;
 struct Point3;
 struct Point2;
 }
 class ObjFileImporter;
+class BaseImporter;
 class IOSystem;
 
 ///	\class	ObjFileParser
@@ -66,21 +69,37 @@ class ObjFileParser
 {
 public:
 	static const size_t BUFFERSIZE = 4096;
+	///	Files smaller than this are never split for parallel parsing.
+	static const size_t MIN_CHUNKSIZE = 1024 * 1024;
 	typedef std::vector<char> DataArray;
 	typedef std::vector<char>::iterator DataArrayIt;
 	typedef std::vector<char>::const_iterator ConstDataArrayIt;
 
 public:
 	///	\brief	Constructor with data array.
-	ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem* io);
+	///	\param	numThreads	Number of threads to use for parsing. If larger than 1, 
+	///		large files are split at line boundaries and parsed in parallel.
+	///	\param	pImporter	Importer to report parsing progress to, may be NULL.
+	ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem* io,
+		unsigned int numThreads = 1, const BaseImporter* pImporter = NULL);
 	///	\brief	Destructor
 	~ObjFileParser();
 	///	\brief	Model getter.
 	ObjFile::Model *GetModel() const;
 
 private:
+	struct Chunk;
+	struct ChunkJob;
+
 	///	Parse the loadedfile
 	void parseFile();
+	///	Parse the single statement starting at the current position.
+	void parseStatement();
+	///	Parse the loaded file in parallel, see ObjFileParser().
+	void parseFileChunked(unsigned int numThreads);
+	///	Walks a chunk of the file. Counts the vertex data statements if bCount
+	///	is true, else decodes them along with all faces and records all other statements.
+	void parseChunk(Chunk &chunk, bool bCount) const;
 	///	Method to copy the new delimited word in the current line.
 	void copyNextWord(char *pBuffer, size_t length);
 	///	Method to copy the new line.
@@ -91,6 +110,8 @@ private:
 	void getVector2(std::vector<aiVector2D> &point2d_array);
 	///	Stores the following face.
 	void getFace(aiPrimitiveType type);
+	///	Adds a face to the current mesh, indices are taken from the index pools of pSource.
+	void storeFace(const ObjFile::Face &rFace, const ObjFile::Mesh &rSource);
 	void getMaterialDesc();
 	///	Gets a comment.
 	void getComment();
@@ -112,8 +133,6 @@ private:
 	void createMesh(); 
 	///	Returns true, if a new mesh instance must be created.
 	bool needsNewMesh( const std::string &rMaterialName );
-	///	Error report in token
-	void reportErrorTokenInFace();
 
 private:
 	///	Default material name
@@ -130,6 +149,10 @@ private:
 	char m_buffer[BUFFERSIZE];
 	///	Pointer to IO system instance.
 	IOSystem *m_pIO;
+	///	Scratch index pools for getFace().
+	ObjFile::Mesh *m_pFaceBuffer;
+	///	Receives progress reports, may be NULL.
+	const BaseImporter *m_pImporter;
 };
 
 }	// Namespace Assimp
@@ -99,8 +99,7 @@ void OgreImporter::InternReadFile(const std::string &pFile, aiScene *pScene, Ass
 		throw DeadlyImportError("Failed to open file "+pFile+".");
 
 	//Read the Mesh File:
-	boost::scoped_ptr<CIrrXML_IOStreamReader> mIOWrapper( new CIrrXML_IOStreamReader( file.get()));
-	boost::scoped_ptr<XmlReader> MeshFile(irr::io::createIrrXMLReader(mIOWrapper.get()));
+	boost::scoped_ptr<XmlReader> MeshFile(CreateIrrXMLReader(file.get()));
 	if(!MeshFile)//parse the xml file
 		throw DeadlyImportError("Failed to create XML Reader for "+pFile);
 
@@ -72,8 +72,8 @@ void OgreImporter::LoadSkeleton(std::string FileName, vector<Bone> &Bones, vecto
 		throw DeadlyImportError("Failed to open skeleton file "+FileName+".");
 
 	//Read the Mesh File:
-	boost::scoped_ptr<CIrrXML_IOStreamReader> mIOWrapper(new CIrrXML_IOStreamReader(File.get()));
-	XmlReader* SkeletonFile = irr::io::createIrrXMLReader(mIOWrapper.get());
+	boost::scoped_ptr<XmlReader> SkeletonReader(CreateIrrXMLReader(File.get()));
+	XmlReader* SkeletonFile = SkeletonReader.get();
 	if(!SkeletonFile)
 		throw DeadlyImportError(string("Failed to create XML Reader for ")+FileName);
 
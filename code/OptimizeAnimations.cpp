@@ -0,0 +1,406 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  OptimizeAnimations.cpp
+ *  @brief Implementation of the aiProcess_OptimizeAnimations step
+ */
+
+#include "AssimpPCH.h"
+#ifndef ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS
+
+#include "OptimizeAnimations.h"
+#include "TinyFormatter.h"
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Interpolation and error metrics for vector and quaternion keys
+inline void Interpolate(aiVector3D& out, const aiVector3D& a, const aiVector3D& b, float f)
+{
+	out = a + (b - a) * f;
+}
+
+inline void Interpolate(aiQuaternion& out, const aiQuaternion& a, const aiQuaternion& b, float f)
+{
+	aiQuaternion::Interpolate(out,a,b,f);
+}
+
+// Continue the path from a to b beyond b, f is measured in multiples of that path
+inline void Extrapolate(aiVector3D& out, const aiVector3D& a, const aiVector3D& b, float f)
+{
+	out = a + (b - a) * f;
+}
+
+// Rotates a by f times the rotation from a to b. Unlike slerp, which blends linearly
+// between close rotations, this stays on the great arc for any f.
+inline void Extrapolate(aiQuaternion& out, const aiQuaternion& a, const aiQuaternion& b, float f)
+{
+	aiQuaternion na = a, nb = b;
+	na.Normalize();
+	nb.Normalize();
+
+	aiQuaternion d = aiQuaternion(na).Conjugate() * nb;
+	if (d.w < 0.f) {
+		d = aiQuaternion(-d.w,-d.x,-d.y,-d.z);
+	}
+	const float s = sqrt(d.x*d.x + d.y*d.y + d.z*d.z);
+	if (s < 1e-10f) {
+		out = na;
+		return;
+	}
+	const float half = atan2(s,d.w) * f, k = sin(half) / s;
+	out = na * aiQuaternion(cos(half),d.x*k,d.y*k,d.z*k);
+}
+
+inline float Distance(const aiVector3D& a, const aiVector3D& b)
+{
+	return (a - b).Length();
+}
+
+// Angle of the rotation between two rotations. Computed from the distance of the unit
+// quaternions rather than their dot product, which is too inaccurate for small angles.
+inline float Distance(const aiQuaternion& a, const aiQuaternion& b)
+{
+	const float la = sqrt(a.x*a.x + a.y*a.y + a.z*a.z + a.w*a.w);
+	const float lb = sqrt(b.x*b.x + b.y*b.y + b.z*b.z + b.w*b.w);
+	if (la < 1e-10f || lb < 1e-10f) {
+		return 0.f;
+	}
+
+	// q and -q are the same rotation
+	const float sb = (a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w < 0.f ? -1.f : 1.f) / lb;
+	const float dx = a.x/la - b.x*sb, dy = a.y/la - b.y*sb, dz = a.z/la - b.z*sb, dw = a.w/la - b.w*sb;
+	return 4.f * asin(std::min(1.f,sqrt(dx*dx + dy*dy + dz*dz + dw*dw) * 0.5f));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replace the keys of a track, if there are fewer
+template <typename KeyType>
+void ReplaceKeys(KeyType*& keys, unsigned int& numKeys, const std::vector<KeyType>& out)
+{
+	if (out.size() == numKeys) {
+		return;
+	}
+	delete[] keys;
+	numKeys = static_cast<unsigned int>(out.size());
+	keys = new KeyType[numKeys];
+	std::copy(out.begin(),out.end(),keys);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether a key continues the path from the first to the last key of a run
+template <typename KeyType>
+bool IsOnPath(const KeyType* keys, unsigned int first, unsigned int last, unsigned int i, float epsilon)
+{
+	const double range = keys[last].mTime - keys[first].mTime;
+	if (range <= 0.) {
+		return false;
+	}
+	typename KeyType::elem_type value;
+	Extrapolate(value,keys[first].mValue,keys[last].mValue,
+		static_cast<float>((keys[i].mTime - keys[first].mTime) / range));
+
+	return Distance(value,keys[i].mValue) <= epsilon;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether all keys between first and last can be dropped
+template <typename KeyType>
+bool CanSkipKeys(const KeyType* keys, unsigned int first, unsigned int last, float epsilon)
+{
+	const double range = keys[last].mTime - keys[first].mTime;
+	if (range <= 0.) {
+		return false;
+	}
+	for (unsigned int i = first+1; i < last; ++i) {
+		typename KeyType::elem_type value;
+		Interpolate(value,keys[first].mValue,keys[last].mValue,
+			static_cast<float>((keys[i].mTime - keys[first].mTime) / range));
+
+		if (Distance(value,keys[i].mValue) > epsilon) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Remove all keys that can be interpolated from their neighbours
+template <typename KeyType>
+void ReduceKeys(KeyType*& keys, unsigned int& numKeys, float epsilon)
+{
+	if (numKeys < 2) {
+		return;
+	}
+
+	std::vector<KeyType> out;
+	out.reserve(numKeys);
+	out.push_back(keys[0]);
+
+	// a constant track is reduced to a single key
+	unsigned int i = 1;
+	for (; i < numKeys; ++i) {
+		if (Distance(keys[i].mValue,keys[0].mValue) > epsilon) {
+			break;
+		}
+	}
+	if (i < numKeys) {
+
+		// Greedily extend each segment as long as its next key continues the
+		// path from its first to its last key. Only the new key is checked, so
+		// long runs take linear time. Slowly curving paths can drift away from 
+		// the keys in between, so the run is verified once and, if that fails, 
+		// cut back to the longest run found by bisection that passes.
+		unsigned int first = 0;
+		while (first + 1 < numKeys) {
+			unsigned int last = first + 1;
+			while (last + 1 < numKeys && IsOnPath(keys,first,last,last + 1,epsilon)) {
+				++last;
+			}
+			if (!CanSkipKeys(keys,first,last,epsilon)) {
+				unsigned int good = first + 1;
+				while (good + 1 < last) {
+					const unsigned int mid = good + (last - good) / 2;
+					if (CanSkipKeys(keys,first,mid,epsilon)) {
+						good = mid;
+					}
+					else last = mid;
+				}
+				last = good;
+			}
+			out.push_back(keys[last]);
+			first = last;
+		}
+	}
+	ReplaceKeys(keys,numKeys,out);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sample a track at regular intervals, starting with the first key
+template <typename KeyType>
+void ResampleKeys(KeyType*& keys, unsigned int& numKeys, double step)
+{
+	if (numKeys < 2) {
+		return;
+	}
+	const double first = keys[0].mTime, last = keys[numKeys-1].mTime;
+	const double count = floor((last - first) / step);
+	if (count > 1e7) {
+		DefaultLogger::get()->warn("OptimizeAnimationsProcess: sample rate too high, skipping channel");
+		return;
+	}
+
+	std::vector<KeyType> out;
+	out.reserve(static_cast<size_t>(count) + 2);
+
+	unsigned int cur = 0;
+	for (unsigned int i = 0; i <= static_cast<unsigned int>(count); ++i) {
+		const double time = first + i * step;
+		while (cur + 2 < numKeys && keys[cur+1].mTime <= time) {
+			++cur;
+		}
+
+		const KeyType& a = keys[cur], &b = keys[cur+1];
+		KeyType key;
+		key.mTime = time;
+		if (b.mTime > a.mTime) {
+			const double f = std::min(1.,std::max(0.,(time - a.mTime) / (b.mTime - a.mTime)));
+			Interpolate(key.mValue,a.mValue,b.mValue,static_cast<float>(f));
+		}
+		else key.mValue = b.mValue;
+		out.push_back(key);
+	}
+
+	// always keep the end of the track
+	if (out.back().mTime < last - step * 1e-3) {
+		out.push_back(keys[numKeys-1]);
+	}
+	else out.back().mValue = keys[numKeys-1].mValue;
+
+	delete[] keys;
+	numKeys = static_cast<unsigned int>(out.size());
+	keys = new KeyType[numKeys];
+	std::copy(out.begin(),out.end(),keys);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replace a rotation by its 'smallest three' encoding with the given number of bits per component
+aiQuaternion QuantizeRotation(const aiQuaternion& q, unsigned int bits)
+{
+	float c[4] = {q.w,q.x,q.y,q.z};
+	const float length = sqrt(c[0]*c[0] + c[1]*c[1] + c[2]*c[2] + c[3]*c[3]);
+	if (length < 1e-10f) {
+		return q;
+	}
+
+	// q and -q are the same rotation, so the largest component can be made positive
+	unsigned int largest = 0;
+	for (unsigned int i = 1; i < 4; ++i) {
+		if (fabs(c[i]) > fabs(c[largest])) {
+			largest = i;
+		}
+	}
+	const float scale = (c[largest] < 0.f ? -1.f : 1.f) / length;
+
+	// the other three components are within [-1/sqrt(2),1/sqrt(2)]
+	static const float range = 0.70710678f;
+	const float steps = static_cast<float>((1u << bits) - 1);
+
+	float sum = 0.f;
+	for (unsigned int i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+		const float v = std::min(range,std::max(-range,c[i] * scale));
+		const float quantized = floor((v + range) / (2.f * range) * steps + 0.5f);
+		c[i] = quantized / steps * 2.f * range - range;
+		sum += c[i]*c[i];
+	}
+	c[largest] = sqrt(std::max(0.f,1.f - sum));
+	return aiQuaternion(c[0],c[1],c[2],c[3]);
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+OptimizeAnimationsProcess::OptimizeAnimationsProcess()
+	: configPositionEpsilon(AI_OA_POSITION_EPSILON)
+	, configRotationEpsilon(AI_OA_ROTATION_EPSILON)
+	, configScalingEpsilon(AI_OA_SCALING_EPSILON)
+	, configSampleRate(0.f)
+	, configQuantizationBits(0)
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+OptimizeAnimationsProcess::~OptimizeAnimationsProcess()
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool OptimizeAnimationsProcess::IsActive( unsigned int pFlags) const
+{
+	return 0 != (pFlags & aiProcess_OptimizeAnimations);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup properties for the postprocessing step
+void OptimizeAnimationsProcess::SetupProperties(const Importer* pImp)
+{
+	configPositionEpsilon = std::max(0.f,pImp->GetPropertyFloat(AI_CONFIG_PP_OA_POSITION_EPSILON,AI_OA_POSITION_EPSILON));
+	configRotationEpsilon = std::max(0.f,pImp->GetPropertyFloat(AI_CONFIG_PP_OA_ROTATION_EPSILON,AI_OA_ROTATION_EPSILON));
+	configScalingEpsilon  = std::max(0.f,pImp->GetPropertyFloat(AI_CONFIG_PP_OA_SCALING_EPSILON,AI_OA_SCALING_EPSILON));
+	configSampleRate      = std::max(0.f,pImp->GetPropertyFloat(AI_CONFIG_PP_OA_SAMPLE_RATE,0.f));
+
+	const int bits = pImp->GetPropertyInteger(AI_CONFIG_PP_OA_QUANTIZE_ROTATIONS,0);
+	if (bits && (bits < 2 || bits > 23)) {
+		DefaultLogger::get()->warn("OptimizeAnimationsProcess: AI_CONFIG_PP_OA_QUANTIZE_ROTATIONS must be "
+			"within 2 and 23, rotations won't be quantized");
+		configQuantizationBits = 0;
+	}
+	else configQuantizationBits = bits;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void OptimizeAnimationsProcess::Execute( aiScene* pScene)
+{
+	DefaultLogger::get()->debug("OptimizeAnimationsProcess begin");
+
+	for (unsigned int a = 0; a < pScene->mNumAnimations; ++a) {
+		ProcessAnimation(pScene->mAnimations[a]);
+	}
+
+	DefaultLogger::get()->debug("OptimizeAnimationsProcess finished");
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::ProcessAnimation(aiAnimation* anim)
+{
+	double step = 0.;
+	if (configSampleRate > 0.f) {
+		step = (anim->mTicksPerSecond != 0. ? anim->mTicksPerSecond : 25.) / configSampleRate;
+	}
+
+	unsigned int before = 0, after = 0;
+	for (unsigned int i = 0; i < anim->mNumChannels; ++i) {
+		aiNodeAnim* channel = anim->mChannels[i];
+		before += channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+
+		ProcessChannel(channel,step);
+		after += channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+	}
+
+	if (!DefaultLogger::isNullLogger() && before) {
+		DefaultLogger::get()->info((Formatter::format(),"OptimizeAnimationsProcess: animation \'",
+			anim->mName.data,"\': ",before," keys -> ",after," keys, compression ratio ",
+			static_cast<float>(before) / std::max(1u,after)));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void OptimizeAnimationsProcess::ProcessChannel(aiNodeAnim* channel, double step)
+{
+	if (step > 0.) {
+		ResampleKeys(channel->mPositionKeys,channel->mNumPositionKeys,step);
+		ResampleKeys(channel->mRotationKeys,channel->mNumRotationKeys,step);
+		ResampleKeys(channel->mScalingKeys,channel->mNumScalingKeys,step);
+	}
+
+	if (configQuantizationBits) {
+		for (unsigned int i = 0; i < channel->mNumRotationKeys; ++i) {
+			aiQuatKey& key = channel->mRotationKeys[i];
+			key.mValue = QuantizeRotation(key.mValue,configQuantizationBits);
+		}
+	}
+
+	ReduceKeys(channel->mPositionKeys,channel->mNumPositionKeys,configPositionEpsilon);
+	ReduceKeys(channel->mRotationKeys,channel->mNumRotationKeys,configRotationEpsilon);
+	ReduceKeys(channel->mScalingKeys,channel->mNumScalingKeys,configScalingEpsilon);
+}
+
+#endif // !! ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS
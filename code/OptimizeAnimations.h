@@ -0,0 +1,135 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  OptimizeAnimations.h
+ *  @brief Declares a post processing step to remove redundant animation keys
+ */
+#ifndef AI_OPTIMIZEANIMATIONS_H_INC
+#define AI_OPTIMIZEANIMATIONS_H_INC
+
+#include "BaseProcess.h"
+#include "../include/assimp/anim.h"
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** @brief Postprocessing step to compress animation channels.
+ *
+ *  Many formats store a key for each frame, with long runs that are constant
+ *  or can be interpolated from their neighbours. This step drops all keys
+ *  which can be reproduced by interpolating between the remaining keys
+ *  within a configurable error. Before, the channels can be resampled to a
+ *  fixed rate and rotations can be quantized.
+ *  @see aiProcess_OptimizeAnimations
+ */
+class OptimizeAnimationsProcess : public BaseProcess
+{
+public:
+
+	OptimizeAnimationsProcess();
+	~OptimizeAnimationsProcess();
+
+public:
+
+	// -------------------------------------------------------------------
+	bool IsActive( unsigned int pFlags) const;
+
+	// -------------------------------------------------------------------
+	void Execute( aiScene* pScene);
+
+	// -------------------------------------------------------------------
+	void SetupProperties(const Importer* pImp);
+
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Set the maximum errors introduced by removing keys.
+	 *  @param position Maximum distance for position keys
+	 *  @param rotation Maximum angle for rotation keys, in radians
+	 *  @param scaling Maximum difference for scaling keys
+	 *  @see AI_CONFIG_PP_OA_POSITION_EPSILON */
+	void SetEpsilons(float position, float rotation, float scaling) {
+		configPositionEpsilon = position;
+		configRotationEpsilon = rotation;
+		configScalingEpsilon = scaling;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Set the rate to resample the channels to.
+	 *  @param rate Keys per second, 0 to keep the original keys.
+	 *  @see AI_CONFIG_PP_OA_SAMPLE_RATE */
+	void SetSampleRate(float rate) {
+		configSampleRate = rate;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Set the precision of quantized rotations.
+	 *  @param bits Bits per quaternion component, 0 to keep the
+	 *    rotations as they are.
+	 *  @see AI_CONFIG_PP_OA_QUANTIZE_ROTATIONS */
+	void SetQuantizationBits(unsigned int bits) {
+		configQuantizationBits = bits;
+	}
+
+protected:
+
+	// -------------------------------------------------------------------
+	/** @brief Compresses all channels of an animation
+	 *  @param anim Animation to work on
+	 */
+	void ProcessAnimation(aiAnimation* anim);
+
+	// -------------------------------------------------------------------
+	/** @brief Compresses one channel
+	 *  @param channel Channel to work on
+	 *  @param step Resampling interval in ticks, 0 to keep the keys
+	 */
+	void ProcessChannel(aiNodeAnim* channel, double step);
+
+private:
+
+	float configPositionEpsilon, configRotationEpsilon, configScalingEpsilon;
+	float configSampleRate;
+	unsigned int configQuantizationBits;
+};
+
+} // end of namespace Assimp
+
+#endif // !! AI_OPTIMIZEANIMATIONS_H_INC
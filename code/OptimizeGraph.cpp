@@ -255,6 +255,9 @@ void OptimizeGraphProcess::Execute( aiScene* pScene)
 #endif
 	}
 
+	// nodes carrying metadata would lose it if they were merged or removed
+	LockMetaDataNodes(pScene->mRootNode);
+
 	for (unsigned int i = 0; i < pScene->mNumAnimations; ++i) {
 		for (unsigned int a = 0; a < pScene->mAnimations[i]->mNumChannels; ++a) {
 		
@@ -349,4 +352,16 @@ void OptimizeGraphProcess::FindInstancedMeshes (aiNode* pNode)
 		FindInstancedMeshes(pNode->mChildren[i]);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Add all nodes with metadata to the blacklist
+void OptimizeGraphProcess::LockMetaDataNodes (aiNode* pNode)
+{
+	if (pNode->mMetaData) {
+		locked.insert(AI_OG_GETKEY(pNode->mName));
+	}
+
+	for (unsigned int i = 0; i < pNode->mNumChildren; ++i)
+		LockMetaDataNodes(pNode->mChildren[i]);
+}
+
 #endif // !! ASSIMP_BUILD_NO_OPTIMIZEGRAPH_PROCESS
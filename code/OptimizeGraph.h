@@ -111,6 +111,7 @@ protected:
 
 	void CollectNewChildren(aiNode* nd, std::list<aiNode*>& nodes);
 	void FindInstancedMeshes (aiNode* pNode);
+	void LockMetaDataNodes (aiNode* pNode);
 
 private:
 
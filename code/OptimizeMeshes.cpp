@@ -215,6 +215,11 @@ bool OptimizeMeshesProcess::CanJoin ( unsigned int a, unsigned int b, unsigned i
 	if (ma->mMaterialIndex != mb->mMaterialIndex || ma->HasBones() != mb->HasBones())
 		return false;
 
+	// Never merge meshes with vertex animations, morph target animations refer 
+	// to their meshes by name and the frames would need to be merged, too.
+	if (ma->mNumAnimMeshes || mb->mNumAnimMeshes)
+		return false;
+
 	// Never merge meshes with different kinds of primitives if SortByPType did already
 	// do its work. We would destroy everything again ...
 	if (pts && ma->mPrimitiveTypes != mb->mPrimitiveTypes)
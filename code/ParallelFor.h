@@ -0,0 +1,179 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ParallelFor.h
+ *  @brief Utility to distribute independent jobs over multiple worker threads
+ */
+#ifndef INCLUDED_AI_PARALLELFOR_H
+#define INCLUDED_AI_PARALLELFOR_H
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/thread.hpp>
+#	include <boost/thread/mutex.hpp>
+#endif
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Resolve a #AI_CONFIG_GLOB_MULTITHREADING policy to the number of threads to use.
+ *
+ *  -1 selects one thread per hardware core, 0 disables multithreading and any 
+ *  larger value is taken as is. Always 1 if Assimp was built without threading
+ *  support (ASSIMP_BUILD_SINGLETHREADED).
+ */
+inline unsigned int GetWorkerThreadCount(int policy)
+{
+#ifdef ASSIMP_BUILD_SINGLETHREADED
+	(void)policy;
+	return 1;
+#else
+	if (policy < 0) {
+		return std::max(1u,boost::thread::hardware_concurrency());
+	}
+	return std::max(1u,static_cast<unsigned int>(policy));
+#endif
+}
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+namespace Intern {
+
+	// --------------------------------------------------------------------------------------------
+	/** Shared state of a ParallelFor() invocation. Jobs are handed out one at a time */
+	template <typename Job>
+	class ParallelForWorker
+	{
+	public:
+		ParallelForWorker(Job& job, unsigned int count)
+			: job(job), count(count), next(), failed()
+		{}
+
+		void operator() () {
+			for(;;) {
+				unsigned int i;
+				{
+					boost::mutex::scoped_lock lock(mutex);
+					if (failed || next >= count) {
+						return;
+					}
+					i = next++;
+				}
+
+				try {
+					job(i);
+				}
+				catch(const std::exception& e) {
+					boost::mutex::scoped_lock lock(mutex);
+					if (!failed) {
+						failed = true;
+						error = e.what();
+					}
+				}
+			}
+		}
+
+		bool Failed() const {
+			return failed;
+		}
+
+		const std::string& GetError() const {
+			return error;
+		}
+
+	private:
+		Job& job;
+		const unsigned int count;
+		unsigned int next;
+		bool failed;
+		std::string error;
+		boost::mutex mutex;
+	};
+
+	template <typename Job>
+	struct ParallelForThread
+	{
+		ParallelForThread(ParallelForWorker<Job>& worker) : worker(worker) {}
+		void operator() () {
+			worker();
+		}
+		ParallelForWorker<Job>& worker;
+	};
+} // ! Intern
+#endif
+
+// ------------------------------------------------------------------------------------------------
+/** Invoke job(i) for each i in [0,count), using up to numThreads threads.
+ *
+ *  The calling thread takes part in the work. Jobs must not depend on each other
+ *  and are not processed in any particular order. If a job throws, no further 
+ *  jobs are started and the first error is rethrown as #DeadlyImportError once
+ *  all threads have finished. Without threading support, or if numThreads 
+ *  is 1, the jobs are simply run in order.
+ */
+template <typename Job>
+void ParallelFor(unsigned int count, unsigned int numThreads, Job& job)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	numThreads = std::min(numThreads,count);
+	if (numThreads > 1) {
+		Intern::ParallelForWorker<Job> worker(job,count);
+		
+		boost::thread_group threads;
+		for (unsigned int i = 1; i < numThreads; ++i) {
+			threads.create_thread(Intern::ParallelForThread<Job>(worker));
+		}
+		worker();
+		threads.join_all();
+
+		if (worker.Failed()) {
+			throw DeadlyImportError(worker.GetError());
+		}
+		return;
+	}
+#else
+	(void)numThreads;
+#endif
+	for (unsigned int i = 0; i < count; ++i) {
+		job(i);
+	}
+}
+
+} // ! Assimp
+
+#endif // !! INCLUDED_AI_PARALLELFOR_H
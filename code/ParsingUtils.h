@@ -172,7 +172,8 @@ AI_FORCE_INLINE bool TokenMatch(char_t*& in, const char* token, unsigned int len
 {
 	if (!::strncmp(token,in,len) && IsSpaceOrNewLine(in[len]))
 	{
-		in += len+1;
+		// don't step over the terminating zero
+		in += in[len] ? len+1 : len;
 		return true;
 	}
 	return false;
@@ -187,7 +188,8 @@ AI_FORCE_INLINE bool TokenMatchI(const char*& in, const char* token, unsigned in
 {
 	if (!ASSIMP_strincmp(token,in,len) && IsSpaceOrNewLine(in[len]))
 	{
-		in += len+1;
+		// don't step over the terminating zero
+		in += in[len] ? len+1 : len;
 		return true;
 	}
 	return false;
@@ -52,12 +52,15 @@ namespace Assimp	{
 // Worker function for exporting a scene to PLY. Prototyped and registered in Exporter.cpp
 void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
 {
-	// invoke the exporter 
-	PlyExporter exporter(pFile, pScene);
+	// invoke the exporter, it writes the file as it goes
+	PlyExporter exporter(pFile, pIOSystem, pScene);
+}
 
-	// we're still here - export successfully completed. Write the file.
-	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+// ------------------------------------------------------------------------------------------------
+// Worker function for exporting a scene to binary PLY. Prototyped and registered in Exporter.cpp
+void ExportScenePlyBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
+{
+	PlyExporter exporter(pFile, pIOSystem, pScene, true);
 }
 
 } // end of namespace Assimp
@@ -68,21 +71,22 @@ void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 #define PLY_EXPORT_HAS_COLORS (PLY_EXPORT_HAS_TEXCOORDS << AI_MAX_NUMBER_OF_TEXTURECOORDS)
 
 // ------------------------------------------------------------------------------------------------
-PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
+PlyExporter :: PlyExporter(const char* _filename, IOSystem* pIOSystem, const aiScene* pScene, bool binary)
 : filename(_filename)
 , pScene(pScene)
+, mOutput(pIOSystem,filename,binary ? "wb" : "wt")
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
-
-	unsigned int faces = 0u, vertices = 0u, components = 0u;
+	unsigned int faces = 0u, vertices = 0u, components = 0u, maxIndices = 0u;
 	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 		const aiMesh& m = *pScene->mMeshes[i];
 		faces += m.mNumFaces;
 		vertices += m.mNumVertices;
 
+		for (unsigned int f = 0; binary && f < m.mNumFaces; ++f) {
+			maxIndices = std::max(maxIndices,m.mFaces[f].mNumIndices);
+		}
+
 		if (m.HasNormals()) {
 			components |= PLY_EXPORT_HAS_NORMALS;
 		}
@@ -98,7 +102,7 @@ PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
 	}
 
 	mOutput << "ply" << endl;
-	mOutput << "format ascii 1.0" << endl;
+	mOutput << (binary ? "format binary_little_endian 1.0" : "format ascii 1.0") << endl;
 	mOutput << "Created by Open Asset Import Library - http://assimp.sf.net (v"
 		<< aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.' 
 		<< aiGetVersionRevision() << ")" << endl;
@@ -154,10 +158,25 @@ PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
 		mOutput << "property float bz" << endl;
 	}
 
+	// binary files use the customary uchar list length unless faces are too large for it
+	const bool shortLists = binary && maxIndices <= 0xff;
+
 	mOutput << "element face " << faces << endl;
-	mOutput << "property list uint uint vertex_indices" << endl;
+	mOutput << (shortLists ? "property list uchar uint vertex_indices" : "property list uint uint vertex_indices") << endl;
 	mOutput << "end_header" << endl;
 
+	if (binary) {
+		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			WriteMeshVertsBinary(pScene->mMeshes[i],components);
+		}
+		for (unsigned int i = 0, ofs = 0; i < pScene->mNumMeshes; ++i) {
+			WriteMeshIndicesBinary(pScene->mMeshes[i],ofs,shortLists);
+			ofs += pScene->mMeshes[i]->mNumVertices;
+		}
+		mOutput.Flush();
+		return;
+	}
+
 	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 		WriteMeshVerts(pScene->mMeshes[i],components);
 	}
@@ -165,6 +184,7 @@ PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
 		WriteMeshIndices(pScene->mMeshes[i],ofs);
 		ofs += pScene->mMeshes[i]->mNumVertices;
 	}
+	mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -239,7 +259,77 @@ void PlyExporter :: WriteMeshIndices(const aiMesh* m, unsigned int offset)
 		const aiFace& f = m->mFaces[i];
 		mOutput << f.mNumIndices << " ";
 		for(unsigned int c = 0; c < f.mNumIndices; ++c) {
-			mOutput << (f.mIndices[c] + offset) << (c == f.mNumIndices-1 ? endl : " ");
+			mOutput << (f.mIndices[c] + offset) << (c == f.mNumIndices-1 ? '\n' : ' ');
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter :: WriteMeshVertsBinary(const aiMesh* m, unsigned int components)
+{
+	// assemble each vertex in the same order as the header declares its properties
+	std::vector<float> vert;
+	vert.reserve(3 + 3 + AI_MAX_NUMBER_OF_TEXTURECOORDS*2 + AI_MAX_NUMBER_OF_COLOR_SETS*4 + 6);
+
+	for (unsigned int i = 0; i < m->mNumVertices; ++i) {
+		vert.clear();
+		vert.push_back(m->mVertices[i].x);
+		vert.push_back(m->mVertices[i].y);
+		vert.push_back(m->mVertices[i].z);
+
+		if(components & PLY_EXPORT_HAS_NORMALS) {
+			const aiVector3D nor = m->HasNormals() ? m->mNormals[i] : aiVector3D();
+			vert.push_back(nor.x);
+			vert.push_back(nor.y);
+			vert.push_back(nor.z);
+		}
+
+		for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
+			const bool has = m->HasTextureCoords(c);
+			vert.push_back(has ? m->mTextureCoords[c][i].x : -1.f);
+			vert.push_back(has ? m->mTextureCoords[c][i].y : -1.f);
+		}
+
+		for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
+			const aiColor4D clr = m->HasVertexColors(c) ? m->mColors[c][i] : aiColor4D(-1.f,-1.f,-1.f,-1.f);
+			vert.push_back(clr.r);
+			vert.push_back(clr.g);
+			vert.push_back(clr.b);
+			vert.push_back(clr.a);
+		}
+
+		if(components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
+			const bool has = m->HasTangentsAndBitangents();
+			const aiVector3D tan = has ? m->mTangents[i] : aiVector3D(), bit = has ? m->mBitangents[i] : aiVector3D();
+			vert.push_back(tan.x);
+			vert.push_back(tan.y);
+			vert.push_back(tan.z);
+			vert.push_back(bit.x);
+			vert.push_back(bit.y);
+			vert.push_back(bit.z);
+		}
+
+		mOutput.PutLE(&vert[0],vert.size());
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter :: WriteMeshIndicesBinary(const aiMesh* m, unsigned int offset, bool shortLists)
+{
+	std::vector<uint32_t> idx;
+	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
+		const aiFace& f = m->mFaces[i];
+		if (shortLists) {
+			mOutput.PutLE(static_cast<uint8_t>(f.mNumIndices));
+		}
+		else mOutput.PutLE(static_cast<uint32_t>(f.mNumIndices));
+
+		idx.resize(f.mNumIndices);
+		for(unsigned int c = 0; c < f.mNumIndices; ++c) {
+			idx[c] = f.mIndices[c] + offset;
+		}
+		if (!idx.empty()) {
+			mOutput.PutLE(&idx[0],idx.size());
 		}
 	}
 }
@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_PLYEXPORTER_H_INC
 #define AI_PLYEXPORTER_H_INC
 
-#include <sstream>
+#include "StreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -53,29 +53,31 @@ namespace Assimp
 {
 
 // ------------------------------------------------------------------------------------------------
-/** Helper class to export a given scene to a Stanford Ply file. */
+/** Helper class to export a given scene to a Stanford Ply file, either
+ *  in ASCII or in binary little-endian encoding. */
 // ------------------------------------------------------------------------------------------------
 class PlyExporter
 {
 public:
-	/// Constructor for a specific scene to export
-	PlyExporter(const char* filename, const aiScene* pScene);
-
-public:
-
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput;
+	/// Constructor for a specific scene to export, writes the file
+	PlyExporter(const char* filename, IOSystem* pIOSystem, const aiScene* pScene, bool binary = false);
 
 private:
 
 	void WriteMeshVerts(const aiMesh* m, unsigned int components);
 	void WriteMeshIndices(const aiMesh* m, unsigned int ofs);
 
+	void WriteMeshVertsBinary(const aiMesh* m, unsigned int components);
+	void WriteMeshIndicesBinary(const aiMesh* m, unsigned int ofs, bool shortLists);
+
 private:
 
 	const std::string filename;
 	const aiScene* const pScene;
 
+	/// buffered output to the file
+	StreamWriter mOutput;
+
 	// obviously, this endl() doesn't flush() the stream 
 	const std::string endl;
 };
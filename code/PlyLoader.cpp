@@ -67,6 +67,7 @@ static const aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 PLYImporter::PLYImporter()
+: bSharedFaceIndices()
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -97,6 +98,13 @@ const aiImporterDesc* PLYImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties
+void PLYImporter::SetupProperties(const Importer* pImp)
+{
+	bSharedFaceIndices = pImp->GetPropertyInteger(AI_CONFIG_GLOB_SHARED_FACE_INDICES,0) != 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure. 
 void PLYImporter::InternReadFile( const std::string& pFile, 
@@ -162,6 +170,10 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 	}
 	this->pcDOM = &sPlyDom;
 
+	// the DOM is complete, the rest is converting it
+	UpdateImporterProgress(ProgressHandler::Phase_Parse,1,1);
+	UpdateImporterProgress(ProgressHandler::Phase_Convert,0,3);
+
 	// now load a list of vertices. This must be sucessfull in order to procede
 	std::vector<aiVector3D> avPositions;
 	this->LoadVertices(&avPositions,false);
@@ -175,6 +187,7 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 	LoadVertices(&avNormals,true);
 
 	// load the face list
+	UpdateImporterProgress(ProgressHandler::Phase_Convert,1,3);
 	std::vector<PLY::Face> avFaces;
 	LoadFaces(&avFaces);
 
@@ -200,6 +213,7 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 	}
 
 	// now load a list of all materials
+	UpdateImporterProgress(ProgressHandler::Phase_Convert,2,3);
 	std::vector<aiMaterial*> avMaterials;
 	LoadMaterial(&avMaterials);
 
@@ -298,14 +312,18 @@ void PLYImporter::ConvertMeshes(std::vector<PLY::Face>* avFaces,
 			if (!avNormals->empty())
 				p_pcOut->mNormals = new aiVector3D[iNum];
 
-			// add all faces
+			// add all faces, there is one index per vertex
 			iNum = 0;
 			unsigned int iVertex = 0;
+			if (bSharedFaceIndices) {
+				p_pcOut->mFaceIndices = new unsigned int[p_pcOut->mNumVertices];
+			}
 			for (std::vector<unsigned int>::const_iterator i =  aiSplit[p].begin();
 				i != aiSplit[p].end();++i,++iNum)
 			{
 				p_pcOut->mFaces[iNum].mNumIndices = (unsigned int)(*avFaces)[*i].mIndices.size(); 
-				p_pcOut->mFaces[iNum].mIndices = new unsigned int[p_pcOut->mFaces[iNum].mNumIndices];
+				p_pcOut->mFaces[iNum].mIndices = p_pcOut->mFaceIndices ? p_pcOut->mFaceIndices + iVertex
+					: new unsigned int[p_pcOut->mFaces[iNum].mNumIndices];
 
 				// build an unique set of vertices/colors for this face
 				for (unsigned int q = 0; q <  p_pcOut->mFaces[iNum].mNumIndices;++q)
@@ -75,6 +75,13 @@ public:
 	bool CanRead( const std::string& pFile, IOSystem* pIOHandler,
 		bool checkSig) const;
 
+	// -------------------------------------------------------------------
+	/** Called prior to ReadFile().
+	 * The function is a request to the importer to update its configuration
+	 * basing on the Importer's configuration property list.
+	 */
+	void SetupProperties(const Importer* pImp);
+
 protected:
 
 	// -------------------------------------------------------------------
@@ -163,6 +170,9 @@ protected:
 
 	/** Document object model representation extracted from the file */
 	PLY::DOM* pcDOM;
+
+	/** Store the face indices in a single array per mesh */
+	bool bSharedFaceIndices;
 };
 
 } // end of namespace Assimp
@@ -120,6 +120,9 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_DEBONE_PROCESS
 #	include "DeboneProcess.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS
+#	include "OptimizeAnimations.h"
+#endif
 
 namespace Assimp {
 
@@ -168,6 +171,9 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_FINDINVALIDDATA_PROCESS)
 	out.push_back( new FindInvalidDataProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_OPTIMIZEANIMATIONS_PROCESS)
+	out.push_back( new OptimizeAnimationsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_FIXINFACINGNORMALS_PROCESS)
 	out.push_back( new FixInfacingNormalsProcess());
 #endif
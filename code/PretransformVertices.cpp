@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PretransformVertices.h"
 #include "ProcessHelper.h"
 #include "SceneCombiner.h"
+#include "VertexTransform.h"
+#include "ParallelFor.h"
 
 using namespace Assimp;
 
@@ -54,10 +56,16 @@ using namespace Assimp;
 #define AI_PTVS_VERTEX 0x0
 #define AI_PTVS_FACE 0x1
 
+// Below this number of output vertices, collecting them on a single thread
+// is faster than starting worker threads.
+static const unsigned int AI_PTV_PARALLEL_THRESHOLD = 50000;
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 PretransformVertices::PretransformVertices()
 :	configKeepHierarchy (false)
+,	configNormalize (false)
+,	configThreads (1)
 {
 }
 
@@ -82,6 +90,7 @@ void PretransformVertices::SetupProperties(const Importer* pImp)
 	// Get the current value of AI_CONFIG_PP_PTV_KEEP_HIERARCHY and AI_CONFIG_PP_PTV_NORMALIZE
 	configKeepHierarchy = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_PTV_KEEP_HIERARCHY,0));
 	configNormalize = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_PTV_NORMALIZE,0));
+	configThreads = GetWorkerThreadCount(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,-1));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -96,209 +105,140 @@ unsigned int PretransformVertices::CountNodes( aiNode* pcNode )
 	return iRet;
 }
 
+namespace {
+
 // ------------------------------------------------------------------------------------------------
-// Get a bitwise combination identifying the vertex format of a mesh
-unsigned int PretransformVertices::GetMeshVFormat(aiMesh* pcMesh)
+// A reference to a mesh by a node and the place its data goes to in the output mesh
+struct MeshInstance
 {
-	// the vertex format is stored in aiMesh::mBones for later retrieval.
-	// there isn't a good reason to compute it a few hundred times
-	// from scratch. The pointer is unused as animations are lost
-	// during PretransformVertices.
-	if (pcMesh->mBones)
-		return (unsigned int)(uint64_t)pcMesh->mBones;
+	const aiNode* node;
+	unsigned int mesh;
 
+	aiMesh* out;
+	unsigned int firstVertex, firstFace;
 
-	const unsigned int iRet = GetMeshVFormatUnique(pcMesh);
-
-	// store the value for later use
-	pcMesh->mBones = (aiBone**)(uint64_t)iRet;
-	return iRet;
-}
+	// true if the face indices of the source mesh have been moved to the output mesh
+	bool reuse;
+};
 
 // ------------------------------------------------------------------------------------------------
-// Count the number of vertices in the whole scene and a given
-// material index
-void PretransformVertices::CountVerticesAndFaces( aiScene* pcScene, aiNode* pcNode, unsigned int iMat,
-	unsigned int iVFormat, unsigned int* piFaces, unsigned int* piVertices)
+// Collect all references to meshes in the node graph, depth-first
+void CollectMeshInstances( const aiNode* pcNode, std::vector<MeshInstance>& instances)
 {
 	for (unsigned int i = 0; i < pcNode->mNumMeshes;++i)
 	{
-		aiMesh* pcMesh = pcScene->mMeshes[ pcNode->mMeshes[i] ]; 
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh))
-		{
-			*piVertices += pcMesh->mNumVertices;
-			*piFaces += pcMesh->mNumFaces;
-		}
+		MeshInstance inst;
+		inst.node = pcNode;
+		inst.mesh = pcNode->mMeshes[i];
+		inst.out = NULL;
+		inst.firstVertex = inst.firstFace = 0;
+		inst.reuse = false;
+		instances.push_back(inst);
 	}
 	for (unsigned int i = 0;i < pcNode->mNumChildren;++i)
 	{
-		CountVerticesAndFaces(pcScene,pcNode->mChildren[i],iMat,
-			iVFormat,piFaces,piVertices);
+		CollectMeshInstances(pcNode->mChildren[i],instances);
 	}
 }
 
 // ------------------------------------------------------------------------------------------------
-// Collect vertex/face data
-void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsigned int iMat,
-	unsigned int iVFormat, aiMesh* pcMeshOut, 
-	unsigned int aiCurrent[2], unsigned int* num_refs)
+// Copy the vertices and faces of a mesh instance to its place in the output mesh, transforming
+// them to worldspace. The index counts of the output faces must have been set up already.
+void CollectData( const aiMesh* pcMesh, const MeshInstance& inst)
 {
+	aiMesh* pcMeshOut = inst.out;
+	const unsigned int iBase = inst.firstVertex, iNum = pcMesh->mNumVertices;
+
 	// No need to multiply if there's no transformation
-	const bool identity = pcNode->mTransformation.IsIdentity();
-	for (unsigned int i = 0; i < pcNode->mNumMeshes;++i)
+	const aiMatrix4x4& mat = inst.node->mTransformation;
+	if (mat.IsIdentity())	{
+		// copy positions, normals and tangents without modifying them
+		::memcpy(pcMeshOut->mVertices + iBase,pcMesh->mVertices,iNum * sizeof(aiVector3D));
+
+		if (pcMeshOut->mNormals) {
+			::memcpy(pcMeshOut->mNormals + iBase,pcMesh->mNormals,iNum * sizeof(aiVector3D));
+		}
+		if (pcMeshOut->mTangents) {
+			::memcpy(pcMeshOut->mTangents + iBase,pcMesh->mTangents,iNum * sizeof(aiVector3D));
+			::memcpy(pcMeshOut->mBitangents + iBase,pcMesh->mBitangents,iNum * sizeof(aiVector3D));
+		}
+	}
+	else
 	{
-		aiMesh* pcMesh = pcScene->mMeshes[ pcNode->mMeshes[i] ]; 
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh))
-		{
-			// Decrement mesh reference counter
-			unsigned int& num_ref = num_refs[pcNode->mMeshes[i]];
-			ai_assert(0 != num_ref);
-			--num_ref;
-
-			if (identity)	{
-				// copy positions without modifying them
-				::memcpy(pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX],
-					pcMesh->mVertices,
-					pcMesh->mNumVertices * sizeof(aiVector3D));
-
-				if (iVFormat & 0x2) {
-					// copy normals without modifying them
-					::memcpy(pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mNormals,
-						pcMesh->mNumVertices * sizeof(aiVector3D));
-				}
-				if (iVFormat & 0x4)
-				{
-					// copy tangents without modifying them
-					::memcpy(pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mTangents,
-						pcMesh->mNumVertices * sizeof(aiVector3D));
-					// copy bitangents without modifying them
-					::memcpy(pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mBitangents,
-						pcMesh->mNumVertices * sizeof(aiVector3D));
-				}
-			}
-			else
-			{
-				// copy positions, transform them to worldspace
-				for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)	{
-					pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX]+n] = pcNode->mTransformation * pcMesh->mVertices[n];
-				}
-				aiMatrix4x4 mWorldIT = pcNode->mTransformation;
-				mWorldIT.Inverse().Transpose();
+		// copy positions, transform them to worldspace
+		TransformPositions(mat,pcMesh->mVertices,pcMeshOut->mVertices + iBase,iNum);
 
-				// TODO: implement Inverse() for aiMatrix3x3
-				aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
+		if (pcMeshOut->mNormals || pcMeshOut->mTangents) {
+			aiMatrix4x4 mWorldIT = mat;
+			mWorldIT.Inverse().Transpose();
 
-				if (iVFormat & 0x2)
-				{
-					// copy normals, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)	{
-						pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX]+n] = 
-							(m * pcMesh->mNormals[n]).Normalize();
-					}
-				}
-				if (iVFormat & 0x4)
-				{
-					// copy tangents and bitangents, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)	{
-						pcMeshOut->mTangents  [aiCurrent[AI_PTVS_VERTEX]+n] = (m * pcMesh->mTangents[n]).Normalize();
-						pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX]+n] = (m * pcMesh->mBitangents[n]).Normalize();
-					}
-				}
+			// TODO: implement Inverse() for aiMatrix3x3
+			const aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
+
+			if (pcMeshOut->mNormals) {
+				TransformDirections(m,pcMesh->mNormals,pcMeshOut->mNormals + iBase,iNum);
 			}
-			unsigned int p = 0;
-			while (iVFormat & (0x100 << p))
-			{
-				// copy texture coordinates
-				memcpy(pcMeshOut->mTextureCoords[p] + aiCurrent[AI_PTVS_VERTEX],
-					pcMesh->mTextureCoords[p],
-					pcMesh->mNumVertices * sizeof(aiVector3D));
-				++p;
+			if (pcMeshOut->mTangents) {
+				TransformDirections(m,pcMesh->mTangents,pcMeshOut->mTangents + iBase,iNum);
+				TransformDirections(m,pcMesh->mBitangents,pcMeshOut->mBitangents + iBase,iNum);
 			}
-			p = 0;
-			while (iVFormat & (0x1000000 << p))
-			{
-				// copy vertex colors
-				memcpy(pcMeshOut->mColors[p] + aiCurrent[AI_PTVS_VERTEX],
-					pcMesh->mColors[p],
-					pcMesh->mNumVertices * sizeof(aiColor4D));
-				++p;
-			}
-			// now we need to copy all faces. since we will delete the source mesh afterwards,
-			// we don't need to reallocate the array of indices except if this mesh is 
-			// referenced multiple times.
-			for (unsigned int planck = 0;planck < pcMesh->mNumFaces;++planck)
-			{
-				aiFace& f_src = pcMesh->mFaces[planck];
-				aiFace& f_dst = pcMeshOut->mFaces[aiCurrent[AI_PTVS_FACE]+planck];
-
-				const unsigned int num_idx = f_src.mNumIndices;
-
-				f_dst.mNumIndices = num_idx; 
+		}
+	}
 
-				unsigned int* pi;
-				if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
-					pi = f_dst.mIndices = f_src.mIndices; 
+	// copy texture coordinates and vertex colors
+	for (unsigned int p = 0; p < AI_MAX_NUMBER_OF_TEXTURECOORDS && pcMeshOut->mTextureCoords[p]; ++p) {
+		::memcpy(pcMeshOut->mTextureCoords[p] + iBase,pcMesh->mTextureCoords[p],iNum * sizeof(aiVector3D));
+	}
+	for (unsigned int p = 0; p < AI_MAX_NUMBER_OF_COLOR_SETS && pcMeshOut->mColors[p]; ++p) {
+		::memcpy(pcMeshOut->mColors[p] + iBase,pcMesh->mColors[p],iNum * sizeof(aiColor4D));
+	}
 
-					// offset all vertex indices
-					for (unsigned int hahn = 0; hahn < num_idx;++hahn){
-						pi[hahn] += aiCurrent[AI_PTVS_VERTEX];
-					}
-				}
-				else {
-					pi = f_dst.mIndices = new unsigned int[num_idx];
-					
-					// copy and offset all vertex indices
-					for (unsigned int hahn = 0; hahn < num_idx;++hahn){
-						pi[hahn] = f_src.mIndices[hahn] + aiCurrent[AI_PTVS_VERTEX];
-					}
-				}
+	// now we need to copy all faces. Indices which have been moved over from the
+	// source mesh are offset in place, all others are copied.
+	for (unsigned int planck = 0;planck < pcMesh->mNumFaces;++planck)
+	{
+		aiFace& f_dst = pcMeshOut->mFaces[inst.firstFace+planck];
+		const unsigned int num_idx = f_dst.mNumIndices;
 
-				// Update the mPrimitiveTypes member of the mesh
-				switch (pcMesh->mFaces[planck].mNumIndices)
-				{
-				case 0x1:
-					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POINT;
-					break;
-				case 0x2:
-					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_LINE;
-					break;
-				case 0x3:
-					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-					break;
-				default:
-					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-					break;
-				};
+		if (inst.reuse) {
+			for (unsigned int hahn = 0; hahn < num_idx;++hahn){
+				f_dst.mIndices[hahn] += iBase;
 			}
-			aiCurrent[AI_PTVS_VERTEX] += pcMesh->mNumVertices;
-			aiCurrent[AI_PTVS_FACE]   += pcMesh->mNumFaces;
 		}
-	}
+		else {
+			const unsigned int* src = pcMesh->mFaces[planck].mIndices;
+			unsigned int* pi = f_dst.mIndices = new unsigned int[num_idx];
 
-	// append all children of us
-	for (unsigned int i = 0;i < pcNode->mNumChildren;++i) {
-		CollectData(pcScene,pcNode->mChildren[i],iMat,
-			iVFormat,pcMeshOut,aiCurrent,num_refs);
+			for (unsigned int hahn = 0; hahn < num_idx;++hahn){
+				pi[hahn] = src[hahn] + iBase;
+			}
+		}
 	}
 }
 
 // ------------------------------------------------------------------------------------------------
-// Get a list of all vertex formats that occur for a given material index
-// The output list contains duplicate elements
-void PretransformVertices::GetVFormatList( aiScene* pcScene, unsigned int iMat,
-	std::list<unsigned int>& aiOut)
+/** Fills the output meshes, one mesh instance per job. Each instance writes to its own 
+ *  range of vertices and faces, so the jobs can run in parallel. */
+class CollectJob
 {
-	for (unsigned int i = 0; i < pcScene->mNumMeshes;++i)
-	{
-		aiMesh* pcMesh = pcScene->mMeshes[ i ]; 
-		if (iMat == pcMesh->mMaterialIndex)	{
-			aiOut.push_back(GetMeshVFormat(pcMesh));
+public:
+	CollectJob(const aiScene* scene, const std::vector<MeshInstance>& instances)
+		: scene(scene), instances(instances)
+	{}
+
+	void operator() (unsigned int i) {
+		const MeshInstance& inst = instances[i];
+		if (inst.out) {
+			CollectData(scene->mMeshes[inst.mesh],inst);
 		}
 	}
-}
+
+private:
+	const aiScene* scene;
+	const std::vector<MeshInstance>& instances;
+};
+
+} // ! anon namespace
 
 // ------------------------------------------------------------------------------------------------
 // Compute the absolute transformation matrices of each node
@@ -319,29 +259,36 @@ void PretransformVertices::ApplyTransform(aiMesh* mesh, const aiMatrix4x4& mat)
 {
 	// Check whether we need to transform the coordinates at all
 	if (!mat.IsIdentity()) {
-		
+		aiMatrix4x4 mWorldIT = mat;
+		mWorldIT.Inverse().Transpose();
+
+		// TODO: implement Inverse() for aiMatrix3x3
+		const aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
+
 		if (mesh->HasPositions()) {
-			for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-				mesh->mVertices[i] = mat * mesh->mVertices[i];
-			}
+			TransformPositions(mat,mesh->mVertices,mesh->mVertices,mesh->mNumVertices);
+		}
+		if (mesh->HasNormals()) {
+			TransformDirections(m,mesh->mNormals,mesh->mNormals,mesh->mNumVertices);
+		}
+		if (mesh->HasTangentsAndBitangents()) {
+			TransformDirections(m,mesh->mTangents,mesh->mTangents,mesh->mNumVertices);
+			TransformDirections(m,mesh->mBitangents,mesh->mBitangents,mesh->mNumVertices);
 		}
-		if (mesh->HasNormals() || mesh->HasTangentsAndBitangents()) {
-			aiMatrix4x4 mWorldIT = mat;
-			mWorldIT.Inverse().Transpose();
-
-			// TODO: implement Inverse() for aiMatrix3x3
-			aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
 
-			if (mesh->HasNormals()) {
-				for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-					mesh->mNormals[i] = (m * mesh->mNormals[i]).Normalize();
-				}
+		// the anim meshes replace the transformed vertex components, so
+		// they need to be transformed as well.
+		for (unsigned int i = 0; i < mesh->mNumAnimMeshes; ++i) {
+			aiAnimMesh* anim = mesh->mAnimMeshes[i];
+			if (anim->HasPositions()) {
+				TransformPositions(mat,anim->mVertices,anim->mVertices,anim->mNumVertices);
 			}
-			if (mesh->HasTangentsAndBitangents()) {
-				for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-					mesh->mTangents[i]   = (m * mesh->mTangents[i]).Normalize();
-					mesh->mBitangents[i] = (m * mesh->mBitangents[i]).Normalize();
-				}
+			if (anim->HasNormals()) {
+				TransformDirections(m,anim->mNormals,anim->mNormals,anim->mNumVertices);
+			}
+			if (anim->HasTangentsAndBitangents()) {
+				TransformDirections(m,anim->mTangents,anim->mTangents,anim->mNumVertices);
+				TransformDirections(m,anim->mBitangents,anim->mBitangents,anim->mNumVertices);
 			}
 		}
 	}
@@ -411,18 +358,6 @@ void PretransformVertices::MakeIdentityTransform(aiNode* nd)
 		MakeIdentityTransform(nd->mChildren[i]);
 }
 
-// ------------------------------------------------------------------------------------------------
-// Build reference counters for all meshes
-void PretransformVertices::BuildMeshRefCountArray(aiNode* nd, unsigned int * refs)
-{
-	for (unsigned int i = 0; i< nd->mNumMeshes;++i)
-		refs[nd->mMeshes[i]]++;
-
-	// call children
-	for (unsigned int i = 0; i < nd->mNumChildren;++i)
-		BuildMeshRefCountArray(nd->mChildren[i],refs);
-}
-
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void PretransformVertices::Execute( aiScene* pScene)
@@ -487,53 +422,116 @@ void PretransformVertices::Execute( aiScene* pScene)
 	}
 	else {
 
-		apcOutMeshes.reserve(pScene->mNumMaterials<<1u);
-		std::list<unsigned int> aiVFormats;
+		// get the vertex format of each mesh
+		std::vector<unsigned int> aiVFormats(pScene->mNumMeshes);
+		for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
+			aiVFormats[i] = GetMeshVFormatUnique(pScene->mMeshes[i]);
+		}
+
+		// find all references to meshes in a single pass over the node graph and sort
+		// them into buckets by material and vertex format. Each bucket yields one output 
+		// mesh, they are ordered by material index first and by vertex format second.
+		// The output meshes have no anim meshes, all animations are removed anyway.
+		std::vector<MeshInstance> instances;
+		CollectMeshInstances(pScene->mRootNode,instances);
 
+		typedef std::map< std::pair<unsigned int, unsigned int>, std::vector<unsigned int> > BucketMap;
+		BucketMap buckets;
 		std::vector<unsigned int> s(pScene->mNumMeshes,0);
-		BuildMeshRefCountArray(pScene->mRootNode,&s[0]);
-
-		for (unsigned int i = 0; i < pScene->mNumMaterials;++i)		{
-			// get the list of all vertex formats for this material
-			aiVFormats.clear();
-			GetVFormatList(pScene,i,aiVFormats);
-			aiVFormats.sort();
-			aiVFormats.unique();
-			for (std::list<unsigned int>::const_iterator j =  aiVFormats.begin();j != aiVFormats.end();++j)	{
-				unsigned int iVertices = 0;
-				unsigned int iFaces = 0; 
-				CountVerticesAndFaces(pScene,pScene->mRootNode,i,*j,&iFaces,&iVertices);
-				if (0 != iFaces && 0 != iVertices)
+		for (unsigned int i = 0; i < instances.size();++i) {
+			const unsigned int mesh = instances[i].mesh;
+			buckets[std::make_pair(pScene->mMeshes[mesh]->mMaterialIndex,aiVFormats[mesh])].push_back(i);
+			++s[mesh];
+		}
+
+		apcOutMeshes.reserve(buckets.size());
+		unsigned int iTotalVertices = 0;
+		for (BucketMap::const_iterator it = buckets.begin(); it != buckets.end(); ++it)	{
+			const std::vector<unsigned int>& bucket = it->second;
+			const unsigned int iVFormat = it->first.second;
+
+			unsigned int iVertices = 0;
+			unsigned int iFaces = 0; 
+			for (unsigned int a = 0; a < bucket.size();++a) {
+				const aiMesh* mesh = pScene->mMeshes[instances[bucket[a]].mesh];
+				iVertices += mesh->mNumVertices;
+				iFaces += mesh->mNumFaces;
+			}
+			if (0 == iFaces || 0 == iVertices) {
+				continue;
+			}
+			iTotalVertices += iVertices;
+
+			apcOutMeshes.push_back(new aiMesh());
+			aiMesh* pcMesh = apcOutMeshes.back();
+			pcMesh->mNumFaces = iFaces;
+			pcMesh->mNumVertices = iVertices;
+			pcMesh->mFaces = new aiFace[iFaces];
+			pcMesh->mVertices = new aiVector3D[iVertices];
+			pcMesh->mMaterialIndex = it->first.first;
+			if (iVFormat & 0x2)pcMesh->mNormals = new aiVector3D[iVertices];
+			if (iVFormat & 0x4)
+			{
+				pcMesh->mTangents    = new aiVector3D[iVertices];
+				pcMesh->mBitangents  = new aiVector3D[iVertices];
+			}
+			iFaces = 0;
+			while (iVFormat & (0x100 << iFaces))
+			{
+				pcMesh->mTextureCoords[iFaces] = new aiVector3D[iVertices];
+				if (iVFormat & (0x10000 << iFaces))pcMesh->mNumUVComponents[iFaces] = 3;
+				else pcMesh->mNumUVComponents[iFaces] = 2;
+				iFaces++;
+			}
+			iFaces = 0;
+			while (iVFormat & (0x1000000 << iFaces))
+				pcMesh->mColors[iFaces++] = new aiColor4D[iVertices];
+
+			// assign each instance its range of vertices and faces and set up the faces.
+			// Since we will delete the source meshes afterwards, we can take over their 
+			// index arrays except if a mesh is referenced multiple times or its faces
+			// don't own their indices.
+			unsigned int aiCurrent[2] = {0,0};
+			for (unsigned int a = 0; a < bucket.size();++a) {
+				MeshInstance& inst = instances[bucket[a]];
+				aiMesh* mesh = pScene->mMeshes[inst.mesh];
+
+				inst.out = pcMesh;
+				inst.firstVertex = aiCurrent[AI_PTVS_VERTEX];
+				inst.firstFace = aiCurrent[AI_PTVS_FACE];
+				inst.reuse = 1 == s[inst.mesh] && !mesh->HasSharedFaceIndices();
+
+				for (unsigned int planck = 0;planck < mesh->mNumFaces;++planck)
 				{
-					apcOutMeshes.push_back(new aiMesh());
-					aiMesh* pcMesh = apcOutMeshes.back();
-					pcMesh->mNumFaces = iFaces;
-					pcMesh->mNumVertices = iVertices;
-					pcMesh->mFaces = new aiFace[iFaces];
-					pcMesh->mVertices = new aiVector3D[iVertices];
-					pcMesh->mMaterialIndex = i;
-					if ((*j) & 0x2)pcMesh->mNormals = new aiVector3D[iVertices];
-					if ((*j) & 0x4)
-					{
-						pcMesh->mTangents    = new aiVector3D[iVertices];
-						pcMesh->mBitangents  = new aiVector3D[iVertices];
-					}
-					iFaces = 0;
-					while ((*j) & (0x100 << iFaces))
-					{
-						pcMesh->mTextureCoords[iFaces] = new aiVector3D[iVertices];
-						if ((*j) & (0x10000 << iFaces))pcMesh->mNumUVComponents[iFaces] = 3;
-						else pcMesh->mNumUVComponents[iFaces] = 2;
-						iFaces++;
+					aiFace& f_src = mesh->mFaces[planck];
+					aiFace& f_dst = pcMesh->mFaces[inst.firstFace+planck];
+
+					const unsigned int num_idx = f_dst.mNumIndices = f_src.mNumIndices;
+					if (inst.reuse) {
+						f_dst.mIndices = f_src.mIndices;
+						f_src.mIndices = NULL;
+						f_src.mNumIndices = 0;
 					}
-					iFaces = 0;
-					while ((*j) & (0x1000000 << iFaces))
-						pcMesh->mColors[iFaces++] = new aiColor4D[iVertices];
 
-					// fill the mesh ...
-					unsigned int aiTemp[2] = {0,0};
-					CollectData(pScene,pScene->mRootNode,i,*j,pcMesh,aiTemp,&s[0]);
+					// Update the mPrimitiveTypes member of the mesh
+					switch (num_idx)
+					{
+					case 0x1:
+						pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
+						break;
+					case 0x2:
+						pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
+						break;
+					case 0x3:
+						pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+						break;
+					default:
+						pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+						break;
+					};
 				}
+				aiCurrent[AI_PTVS_VERTEX] += mesh->mNumVertices;
+				aiCurrent[AI_PTVS_FACE]   += mesh->mNumFaces;
 			}
 		}
 
@@ -541,37 +539,34 @@ void PretransformVertices::Execute( aiScene* pScene)
 		if (apcOutMeshes.empty())	{		
 			throw DeadlyImportError("No output meshes: all meshes are orphaned and are not referenced by any nodes");
 		}
-		else
-		{
-			// now delete all meshes in the scene and build a new mesh list
-			for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
-			{
-				aiMesh* mesh = pScene->mMeshes[i];
-				mesh->mNumBones = 0;
-				mesh->mBones    = NULL;
 
-				// we're reusing the face index arrays. avoid destruction
-				for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
-					mesh->mFaces[a].mNumIndices = 0;
-					mesh->mFaces[a].mIndices = NULL;
-				}
-
-				delete mesh;
+		// fill the output meshes. Small scenes aren't worth starting threads for.
+		CollectJob job(pScene,instances);
+		ParallelFor(static_cast<unsigned int>(instances.size()),
+			iTotalVertices < AI_PTV_PARALLEL_THRESHOLD ? 1 : configThreads,job);
 
-				// Invalidate the contents of the old mesh array. We will most
-				// likely have less output meshes now, so the last entries of 
-				// the mesh array are not overridden. We set them to NULL to 
-				// make sure the developer gets notified when his application
-				// attempts to access these fields ...
-				mesh = NULL;
-			}
+		// now delete all meshes in the scene and build a new mesh list
+		for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
+		{
+			aiMesh* mesh = pScene->mMeshes[i];
+			mesh->mNumBones = 0;
+			mesh->mBones    = NULL;
+
+			delete mesh;
+
+			// Invalidate the contents of the old mesh array. We will most
+			// likely have less output meshes now, so the last entries of 
+			// the mesh array are not overridden. We set them to NULL to 
+			// make sure the developer gets notified when his application
+			// attempts to access these fields ...
+			mesh = NULL;
+		}
 
-			// It is impossible that we have more output meshes than 
-			// input meshes, so we can easily reuse the old mesh array
-			pScene->mNumMeshes = (unsigned int)apcOutMeshes.size();
-			for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
-				pScene->mMeshes[i] = apcOutMeshes[i];
-			}
+		// It is impossible that we have more output meshes than 
+		// input meshes, so we can easily reuse the old mesh array
+		pScene->mNumMeshes = (unsigned int)apcOutMeshes.size();
+		for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
+			pScene->mMeshes[i] = apcOutMeshes[i];
 		}
 	}
 
@@ -54,7 +54,10 @@ namespace Assimp	{
 // ---------------------------------------------------------------------------
 /** The PretransformVertices pretransforms all vertices in the nodegraph
  *  and removes the whole graph. The output is a list of meshes, one for
- *  each material.
+ *  each material and vertex format.
+ *
+ *  Mesh references are bucketed in a single pass over the graph, then 
+ *  the output meshes are filled in parallel, one mesh instance per job.
 */
 class PretransformVertices : public BaseProcess
 {
@@ -100,34 +103,6 @@ private:
 	// Count the number of nodes
 	unsigned int CountNodes( aiNode* pcNode );
 
-	// -------------------------------------------------------------------
-	// Get a bitwise combination identifying the vertex format of a mesh
-	unsigned int GetMeshVFormat(aiMesh* pcMesh);
-
-	// -------------------------------------------------------------------
-	// Count the number of vertices in the whole scene and a given
-	// material index
-	void CountVerticesAndFaces( aiScene* pcScene, aiNode* pcNode, 
-		unsigned int iMat,
-		unsigned int iVFormat, 
-		unsigned int* piFaces,
-		unsigned int* piVertices);
-
-	// -------------------------------------------------------------------
-	// Collect vertex/face data
-	void CollectData( aiScene* pcScene, aiNode* pcNode,
-		unsigned int iMat,
-		unsigned int iVFormat, 
-		aiMesh* pcMeshOut, 
-		unsigned int aiCurrent[2],
-		unsigned int* num_refs);
-
-	// -------------------------------------------------------------------
-	// Get a list of all vertex formats that occur for a given material
-	// The output list contains duplicate elements
-	void GetVFormatList( aiScene* pcScene, unsigned int iMat,
-		std::list<unsigned int>& aiOut);
-
 	// -------------------------------------------------------------------
 	// Compute the absolute transformation matrices of each node
 	void ComputeAbsoluteTransform( aiNode* pcNode );
@@ -145,15 +120,13 @@ private:
 	// Reset transformation matrices to identity
 	void MakeIdentityTransform(aiNode* nd);
 
-	// -------------------------------------------------------------------
-	// Build reference counters for all meshes
-	void BuildMeshRefCountArray(aiNode* nd, unsigned int * refs);
-
-
 
 	//! Configuration option: keep scene hierarchy as long as possible
 	bool configKeepHierarchy, configNormalize;
 
+	//! Configuration option: number of threads used to collect the output meshes
+	unsigned int configThreads;
+
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,252 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ProbeIOWrapper.h
+ *  IOSystem wrapper which serves the head of a single file from memory. 
+ *  Used by Importer::ReadFile so that signature-based format detection 
+ *  reads the beginning of the file only once for all importers. */
+#ifndef AI_PROBEIOWRAPPER_H_INC
+#define AI_PROBEIOWRAPPER_H_INC
+namespace Assimp	{
+
+// Number of bytes read from the beginning of a file for format detection.
+// This covers every header check done by the built-in importers, reads 
+// beyond this limit are forwarded to the file.
+#define AI_PROBEIO_HEAD_SIZE 4096
+
+class ProbeIOSystem;
+
+// ----------------------------------------------------------------------------------
+/** IOStream for the probed file. Reads are served from the cached head and only
+ *  fall back to the underlying file if they exceed it. */
+// ----------------------------------------------------------------------------------
+class ProbeIOStream : public IOStream
+{
+	friend class ProbeIOSystem;
+
+protected:
+	ProbeIOStream (IOSystem* io, const std::string& file, const std::vector<uint8_t>& head, size_t length) 
+		: io(io)
+		, file(file)
+		, head(head)
+		, length(length)
+		, pos((size_t)0)
+		, stream()
+	{
+	}
+
+public:
+
+	~ProbeIOStream ()	{
+		if (stream) {
+			io->Close(stream);
+		}
+	}
+
+	// -------------------------------------------------------------------
+	// Read from stream
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount)	{
+		if (!pSize) {
+			return 0;
+		}
+		const size_t cnt = std::min(pCount,(length-pos)/pSize),ofs = pSize*cnt;
+		if (pos + ofs <= head.size()) {
+			if (ofs) {
+				memcpy(pvBuffer,&head[pos],ofs);
+			}
+			pos += ofs;
+			return cnt;
+		}
+
+		// leave the fast lane and open the file for real
+		if (!stream) {
+			stream = io->Open(file.c_str(),"rb");
+			if (!stream) {
+				return 0;
+			}
+		}
+		if (AI_SUCCESS != stream->Seek(pos,aiOrigin_SET)) {
+			return 0;
+		}
+		const size_t read = stream->Read(pvBuffer,pSize,pCount);
+		pos += read*pSize;
+		return read;
+	}
+
+	// -------------------------------------------------------------------
+	// Write to stream
+	size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/,size_t /*pCount*/)	{
+		ai_assert(false); // won't be needed
+		return 0;
+	}
+
+	// -------------------------------------------------------------------
+	// Seek specific position
+	aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+		if (aiOrigin_SET == pOrigin) {
+			if (pOffset > length) {
+				return AI_FAILURE;
+			}
+			pos = pOffset;
+		}
+		else if (aiOrigin_END == pOrigin) {
+			if (pOffset > length) {
+				return AI_FAILURE;
+			}
+			pos = length-pOffset;
+		}
+		else {
+			if (pOffset+pos > length) {
+				return AI_FAILURE;
+			}
+			pos += pOffset;
+		}
+		return AI_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------
+	// Get current seek position
+	size_t Tell() const {
+		return pos;
+	}
+
+	// -------------------------------------------------------------------
+	// Get size of file
+	size_t FileSize() const {
+		return length;
+	}
+
+	// -------------------------------------------------------------------
+	// Flush file contents
+	void Flush() {
+		ai_assert(false); // won't be needed
+	}
+
+private:
+	IOSystem* io;
+	const std::string& file;
+	const std::vector<uint8_t>& head;
+	size_t length,pos;
+	IOStream* stream;
+};
+
+// ---------------------------------------------------------------------------
+/** IOSystem wrapper which reads the head of one file once and hands out 
+ *  ProbeIOStreams for it. All other requests are passed to the wrapped
+ *  IOSystem. The wrapper must outlive all streams it returned. */
+class ProbeIOSystem : public IOSystem
+{
+public:
+	/** Constructor, reads the head of the file */
+	ProbeIOSystem (IOSystem* io, const std::string& file, size_t headSize = AI_PROBEIO_HEAD_SIZE) 
+		: io(io), file(file), length(), valid() 
+	{
+		ai_assert(NULL != io);
+
+		IOStream* stream = io->Open(file.c_str(),"rb");
+		if (stream) {
+			length = stream->FileSize();
+			head.resize(std::min(length,headSize));
+			if (!head.empty()) {
+				head.resize(stream->Read(&head[0],1,head.size()));
+			}
+			valid = true;
+			io->Close(stream);
+		}
+	}
+
+	/** Destructor. */
+	~ProbeIOSystem() {
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the cached head of the probed file, empty if it could
+	 *  not be opened. */
+	const std::vector<uint8_t>& GetHead() const {
+		return head;
+	}
+
+	// -------------------------------------------------------------------
+	/** Tests for the existence of a file at the given path. */
+	bool Exists( const char* pFile) const {
+		return io->Exists(pFile);
+	}
+
+	// -------------------------------------------------------------------
+	/** Returns the directory separator. */
+	char getOsSeparator() const {
+		return io->getOsSeparator();
+	}
+
+	// -------------------------------------------------------------------
+	/** Open a new file with a given path. */
+	IOStream* Open( const char* pFile, const char* pMode = "rb") {
+		if (valid && *pMode == 'r' && (file == pFile || io->ComparePaths(file.c_str(),pFile))) {
+			return new ProbeIOStream(io,file,head,length);
+		}
+		return io->Open(pFile,pMode);
+	}
+
+	// -------------------------------------------------------------------
+	/** Closes the given file and releases all resources associated with it. */
+	void Close( IOStream* pFile) {
+		if (dynamic_cast<ProbeIOStream*>(pFile)) {
+			delete pFile;
+			return;
+		}
+		io->Close(pFile);
+	}
+
+	// -------------------------------------------------------------------
+	/** Compare two paths */
+	bool ComparePaths (const char* one, const char* second) const {
+		return io->ComparePaths(one,second);
+	}
+
+private:
+	IOSystem* io;
+	const std::string file;
+	std::vector<uint8_t> head;
+	size_t length;
+	bool valid;
+};
+} // end namespace Assimp
+
+#endif
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssimpPCH.h"
 #include "ProcessHelper.h"
+#include "MakeVerboseFormat.h"
 
 
 #include <limits>
@@ -268,6 +269,21 @@ const char* MappingTypeToString(aiTextureMapping in)
 }
 
 
+// -------------------------------------------------------------------------------
+void AllocateFaceIndices(aiMesh* mesh, bool shared)
+{
+	if (shared) {
+		mesh->PackFaceIndices();
+		return;
+	}
+	for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
+		aiFace& face = mesh->mFaces[a];
+		if (!face.mIndices && face.mNumIndices) {
+			face.mIndices = new unsigned int[face.mNumIndices];
+		}
+	}
+}
+
 // -------------------------------------------------------------------------------
 aiMesh* MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags)
 {		
@@ -317,13 +333,15 @@ aiMesh* MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
 
 	// and copy over the data, generating faces with linear indices along the way
 	oMesh->mFaces = new aiFace[numSubFaces];
+	for(unsigned int a = 0; a < numSubFaces; ++a )	{
+		oMesh->mFaces[a].mNumIndices = pMesh->mFaces[subMeshFaces[a]].mNumIndices;
+	}
+	AllocateFaceIndices(oMesh,pMesh->HasSharedFaceIndices());
 	
 	for(unsigned int a = 0; a < numSubFaces; ++a )	{
 
 		const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
 		aiFace& dstFace = oMesh->mFaces[a];
-		dstFace.mNumIndices = srcFace.mNumIndices;
-		dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
 
 		// accumulate linearly all the vertices of the source face
 		for( size_t b = 0; b < dstFace.mNumIndices; ++b )	{
@@ -354,6 +372,17 @@ aiMesh* MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
 		}
 	}
 
+	// the anim meshes are split like the mesh itself
+	if( pMesh->mNumAnimMeshes )	{
+		std::vector<unsigned int> sourceIndex(numSubVerts);
+		for(unsigned int srcIndex = 0; srcIndex < pMesh->mNumVertices; ++srcIndex ) {
+			if(vMap[srcIndex]!=UINT_MAX) {
+				sourceIndex[vMap[srcIndex]] = srcIndex;
+			}
+		}
+		RemapAnimMeshes(oMesh,pMesh,&sourceIndex[0]);
+	}
+
 	if(~subFlags&AI_SUBMESH_FLAGS_SANS_BONES)	{			
 		std::vector<unsigned int> subBones(pMesh->mNumBones,0);
 
@@ -412,4 +441,71 @@ aiMesh* MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
 	return oMesh;
 }
 
+// -------------------------------------------------------------------------------
+template <typename T>
+inline T* GatherVertexData(const T* in, const unsigned int* sourceIndex, unsigned int num)
+{
+	if (!in) {
+		return NULL;
+	}
+	T* out = new T[num];
+	for (unsigned int i = 0; i < num; ++i) {
+		out[i] = in[sourceIndex[i]];
+	}
+	return out;
+}
+
+// -------------------------------------------------------------------------------
+void RemapAnimMeshes(aiMesh* dest, const aiMesh* src, const unsigned int* sourceIndex)
+{
+	const unsigned int numAnimMeshes = src->mNumAnimMeshes;
+	if (!numAnimMeshes) {
+		return;
+	}
+
+	const unsigned int num = dest->mNumVertices;
+	aiAnimMesh** out = new aiAnimMesh*[numAnimMeshes];
+	for (unsigned int i = 0; i < numAnimMeshes; ++i) {
+		const aiAnimMesh* in = src->mAnimMeshes[i];
+		aiAnimMesh* anim = out[i] = new aiAnimMesh();
+		anim->mNumVertices = num;
+
+		anim->mVertices   = GatherVertexData(in->mVertices,sourceIndex,num);
+		anim->mNormals    = GatherVertexData(in->mNormals,sourceIndex,num);
+		anim->mTangents   = GatherVertexData(in->mTangents,sourceIndex,num);
+		anim->mBitangents = GatherVertexData(in->mBitangents,sourceIndex,num);
+		for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+			anim->mTextureCoords[a] = GatherVertexData(in->mTextureCoords[a],sourceIndex,num);
+		}
+		for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+			anim->mColors[a] = GatherVertexData(in->mColors[a],sourceIndex,num);
+		}
+	}
+
+	if (dest->mAnimMeshes) {
+		for (unsigned int i = 0; i < dest->mNumAnimMeshes; ++i) {
+			delete dest->mAnimMeshes[i];
+		}
+		delete[] dest->mAnimMeshes;
+	}
+	dest->mAnimMeshes = out;
+	dest->mNumAnimMeshes = numAnimMeshes;
+}
+
+// -------------------------------------------------------------------------------
+void SplitSharedVertices(aiScene* pScene, SharedPostProcessInfo* shared)
+{
+	MakeVerboseFormatProcess().Execute(pScene);
+
+	// the spatial sort is indexed by vertex, it must not survive the split
+	std::vector<std::pair<SpatialSort,float> >* avf = NULL;
+	if (shared && shared->GetProperty(AI_SPP_SPATIAL_SORT,avf)) {
+		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			const aiMesh* mesh = pScene->mMeshes[i];
+			(*avf)[i].first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
+			(*avf)[i].second = ComputePositionEpsilon(mesh);
+		}
+	}
+}
+
 } // namespace Assimp
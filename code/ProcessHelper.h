@@ -315,6 +315,24 @@ const char* MappingTypeToString(aiTextureMapping in);
 // Split a mesh given a list of faces to be contained in the sub mesh
 aiMesh* MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags);
 
+// -------------------------------------------------------------------------------
+// Allocate the index arrays of all faces of a mesh whose mIndices are NULL and
+// whose mNumIndices are set, either in a single block (see aiMesh::mFaceIndices) 
+// or with one heap array per face
+void AllocateFaceIndices(aiMesh* mesh, bool shared);
+
+// -------------------------------------------------------------------------------
+// Build the anim meshes of a mesh whose vertices have been rearranged. Vertex i of
+// 'dest' takes its data from vertex sourceIndex[i] of the anim meshes of 'src'.
+// dest->mNumVertices must be set already, 'dest' may be 'src'.
+void RemapAnimMeshes(aiMesh* dest, const aiMesh* src, const unsigned int* sourceIndex);
+
+// -------------------------------------------------------------------------------
+// Give each face of a scene flagged AI_SCENE_FLAGS_NON_VERBOSE_FORMAT its own 
+// vertices, for steps which need the verbose format. A spatial sort computed by 
+// a previous step is rebuilt for the new vertices.
+void SplitSharedVertices(aiScene* pScene, SharedPostProcessInfo* shared);
+
 // -------------------------------------------------------------------------------
 // Utility postprocess step to share the spatial sort tree between
 // all steps which use it to speedup its computations.
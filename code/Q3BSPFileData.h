@@ -141,6 +141,51 @@ struct sQ3BSPLightmap
 	}
 };
 
+///	A splitting plane of the BSP tree.
+struct sQ3BSPPlane
+{
+	vec3f vNormal;		///< Plane normal
+	float fDist;		///< Distance from the origin along the normal
+};
+
+///	An inner node of the BSP tree.
+struct sQ3BSPNode
+{
+	int iPlane;			///< Index of the splitting plane
+	int iChildren[ 2 ];	///< Front and back child, negative numbers are leafs: -(leaf + 1)
+	int iMins[ 3 ];		///< Bounding box min
+	int iMaxs[ 3 ];		///< Bounding box max
+};
+
+///	A leaf of the BSP tree.
+struct sQ3BSPLeaf
+{
+	int iCluster;		///< Visibility cluster, -1 if the leaf is outside of the map
+	int iArea;			///< Area portal
+	int iMins[ 3 ];		///< Bounding box min
+	int iMaxs[ 3 ];		///< Bounding box max
+	int iLeafFace;		///< First index into the leaf faces
+	int iNumLeafFaces;	///< Number of leaf faces
+	int iLeafBrush;		///< First index into the leaf brushes
+	int iNumLeafBrushes;///< Number of leaf brushes
+};
+
+///	Potentially visible set, one bit vector per cluster.
+struct sQ3BSPVisData
+{
+	int iNumClusters;					///< Number of bit vectors
+	int iBytesPerCluster;				///< Size of a bit vector in bytes
+	std::vector<unsigned char> bits;	///< Bit c of vector r is set if cluster c is visible from r
+
+	sQ3BSPVisData() :
+		iNumClusters( 0 ),
+		iBytesPerCluster( 0 ),
+		bits()
+	{
+		// empty
+	}
+};
+
 struct SubPatch
 {
 	std::vector<size_t> indices;
@@ -179,6 +224,11 @@ struct Q3BSPModel
 	std::vector<sQ3BSPTexture*> m_Textures;
 	std::vector<sQ3BSPLightmap*> m_Lightmaps;
 	std::vector<char> m_EntityData;
+	std::vector<sQ3BSPPlane> m_Planes;
+	std::vector<sQ3BSPNode> m_Nodes;
+	std::vector<sQ3BSPLeaf> m_Leafs;
+	std::vector<int> m_LeafFaces;
+	sQ3BSPVisData m_VisData;
 	std::string m_ModelName;
 
 	Q3BSPModel() :
@@ -190,6 +240,11 @@ struct Q3BSPModel
 		m_Textures(),
 		m_Lightmaps(),
 		m_EntityData(),
+		m_Planes(),
+		m_Nodes(),
+		m_Leafs(),
+		m_LeafFaces(),
+		m_VisData(),
 		m_ModelName( "" )
 	{
 		// empty
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Q3BSPZipArchive.h"
 #include "Q3BSPFileParser.h"
 #include "Q3BSPFileData.h"
+#include "ProcessHelper.h"
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #	include <zlib.h>
@@ -133,11 +134,115 @@ static void normalizePathName( const std::string &rPath, std::string &rNormalize
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+//	Local helper function to convert an integer vector.
+static aiVector3D toVector( const int *pValues )
+{
+	return aiVector3D( static_cast<float>( pValues[ 0 ] ), static_cast<float>( pValues[ 1 ] ), 
+		static_cast<float>( pValues[ 2 ] ) );
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Local helper function to check whether a face is a valid triangle list.
+static bool isTriangleFace( const Q3BSPModel *pModel, const sQ3BSPFace *pQ3BSPFace )
+{
+	if ( NULL == pQ3BSPFace || pQ3BSPFace->iNumOfFaceVerts <= 0 )
+		return false;
+
+	if ( pQ3BSPFace->iType != Polygon && pQ3BSPFace->iType != TriangleMesh )
+		return false;
+
+	return pQ3BSPFace->iVertexIndex >= 0 && pQ3BSPFace->iNumOfVerts >= 0 &&
+		static_cast<size_t>( pQ3BSPFace->iVertexIndex ) + pQ3BSPFace->iNumOfVerts <= pModel->m_Vertices.size() &&
+		pQ3BSPFace->iFaceVertexIndex >= 0 &&
+		static_cast<size_t>( pQ3BSPFace->iFaceVertexIndex ) + pQ3BSPFace->iNumOfFaceVerts <= pModel->m_Indices.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Local helper function to check whether a triangle references vertices of its face only.
+static bool isValidTriangle( const Q3BSPModel *pModel, const sQ3BSPFace *pQ3BSPFace, int firstIndex )
+{
+	for ( int i = 0; i < 3; i++ )
+	{
+		const int offset = pModel->m_Indices[ pQ3BSPFace->iFaceVertexIndex + firstIndex + i ];
+		if ( offset < 0 || offset >= pQ3BSPFace->iNumOfVerts )
+			return false;
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Local helper function to assign a list of meshes to a node.
+static void setNodeMeshes( aiNode *pNode, const std::vector<unsigned int> &rMeshes )
+{
+	pNode->mNumMeshes = rMeshes.size();
+	if ( !rMeshes.empty() )
+	{
+		pNode->mMeshes = new unsigned int[ pNode->mNumMeshes ];
+		std::copy( rMeshes.begin(), rMeshes.end(), pNode->mMeshes );
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Local helper function to create the node of a BSP tree node or leaf, the children of 
+//	a tree node are its front and its back, in this order. Returns NULL for broken trees.
+static aiNode *createBSPNode( const Q3BSPModel *pModel, int child, std::vector<bool> &rVisited )
+{
+	if ( child < 0 )
+	{
+		const size_t leafIdx = static_cast<size_t>( -( child + 1 ) );
+		if ( leafIdx >= pModel->m_Leafs.size() )
+			return NULL;
+
+		const sQ3BSPLeaf &rLeaf = pModel->m_Leafs[ leafIdx ];
+		aiNode *pNode = new aiNode;
+		pNode->mName.length = ::sprintf( pNode->mName.data, "bsp_leaf_%i", static_cast<int>( leafIdx ) );
+		pNode->mMetaData = new aiMetadata( 3 );
+		pNode->mMetaData->Set( 0, "cluster", rLeaf.iCluster );
+		pNode->mMetaData->Set( 1, "min", toVector( rLeaf.iMins ) );
+		pNode->mMetaData->Set( 2, "max", toVector( rLeaf.iMaxs ) );
+		return pNode;
+	}
+
+	// nodes must not be referenced twice, else the tree would be infinite
+	if ( static_cast<size_t>( child ) >= pModel->m_Nodes.size() || rVisited[ child ] )
+		return NULL;
+	rVisited[ child ] = true;
+
+	const sQ3BSPNode &rBSPNode = pModel->m_Nodes[ child ];
+	if ( rBSPNode.iPlane < 0 || static_cast<size_t>( rBSPNode.iPlane ) >= pModel->m_Planes.size() )
+		return NULL;
+
+	const sQ3BSPPlane &rPlane = pModel->m_Planes[ rBSPNode.iPlane ];
+	aiNode *pNode = new aiNode;
+	pNode->mName.length = ::sprintf( pNode->mName.data, "bsp_node_%i", child );
+	pNode->mMetaData = new aiMetadata( 4 );
+	pNode->mMetaData->Set( 0, "plane_normal", aiVector3D( rPlane.vNormal.x, rPlane.vNormal.y, rPlane.vNormal.z ) );
+	pNode->mMetaData->Set( 1, "plane_distance", rPlane.fDist );
+	pNode->mMetaData->Set( 2, "min", toVector( rBSPNode.iMins ) );
+	pNode->mMetaData->Set( 3, "max", toVector( rBSPNode.iMaxs ) );
+
+	pNode->mChildren = new aiNode*[ 2 ];
+	for ( int i = 0; i < 2; i++ )
+	{
+		aiNode *pChild = createBSPNode( pModel, rBSPNode.iChildren[ i ], rVisited );
+		if ( NULL == pChild )
+		{
+			delete pNode;
+			return NULL;
+		}
+		pChild->mParent = pNode;
+		pNode->mChildren[ pNode->mNumChildren++ ] = pChild;
+	}
+	return pNode;
+}
+
 // ------------------------------------------------------------------------------------------------
 //	Constructor.
 Q3BSPFileImporter::Q3BSPFileImporter() :
 	m_pCurrentMesh( NULL ),
-	m_pCurrentFace( NULL ),
+	m_bSplitByCluster( false ),
+	m_bSharedFaceIndices( false ),
 	m_MaterialLookupMap(),
 	mTextures()
 {
@@ -150,7 +255,6 @@ Q3BSPFileImporter::~Q3BSPFileImporter()
 {
 	// For lint
 	m_pCurrentMesh = NULL;
-	m_pCurrentFace = NULL;
 	
 	// Clear face-to-material map
 	for ( FaceMap::iterator it = m_MaterialLookupMap.begin(); it != m_MaterialLookupMap.end();
@@ -186,11 +290,22 @@ const aiImporterDesc* Q3BSPFileImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+//	Setup configuration properties for the loader.
+void Q3BSPFileImporter::SetupProperties( const Importer* pImp )
+{
+	// AI_CONFIG_IMPORT_Q3BSP_CLUSTERS
+	m_bSplitByCluster = ( 0 != pImp->GetPropertyInteger( AI_CONFIG_IMPORT_Q3BSP_CLUSTERS, 0 ) );
+
+	// AI_CONFIG_GLOB_SHARED_FACE_INDICES
+	m_bSharedFaceIndices = ( 0 != pImp->GetPropertyInteger( AI_CONFIG_GLOB_SHARED_FACE_INDICES, 0 ) );
+}
+
 // ------------------------------------------------------------------------------------------------
 //	Import method.
-void Q3BSPFileImporter::InternReadFile(const std::string &rFile, aiScene* pScene, IOSystem* /*pIOHandler*/)
+void Q3BSPFileImporter::InternReadFile(const std::string &rFile, aiScene* pScene, IOSystem* pIOHandler)
 {
-	Q3BSPZipArchive Archive( rFile );
+	Q3BSPZipArchive Archive( pIOHandler, rFile );
 	if ( !Archive.isOpen() )
 	{
 		throw DeadlyImportError( "Failed to open file " + rFile + "." );
@@ -282,7 +397,21 @@ void Q3BSPFileImporter::CreateDataFromImport( const Q3BSP::Q3BSPModel *pModel, a
 	createMaterialMap( pModel );
 
 	// Create all nodes
-	CreateNodes( pModel, pScene, pScene->mRootNode );
+	if ( m_bSplitByCluster && !pModel->m_Leafs.empty() )
+	{
+		CreateClusterNodes( pModel, pScene, pScene->mRootNode );
+	}
+	else
+	{
+		if ( m_bSplitByCluster )
+		{
+			DefaultLogger::get()->warn( "Q3BSP: Map has no BSP tree, can't split it by clusters" );
+		}
+		CreateNodes( pModel, pScene, pScene->mRootNode );
+	}
+
+	// The vertices of a face are shared by its triangles
+	pScene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
 	
 	// Create the assigned materials
 	createMaterials( pModel, pScene, pArchive );
@@ -305,20 +434,18 @@ void Q3BSPFileImporter::CreateNodes( const Q3BSP::Q3BSPModel *pModel, aiScene* p
 	for ( FaceMapIt it = m_MaterialLookupMap.begin(); it != m_MaterialLookupMap.end(); ++it )
 	{
 		std::vector<Q3BSP::sQ3BSPFace*> *pArray = (*it).second;
-		size_t numVerts = countData( *pArray );
-		if ( 0 != numVerts )
+		aiMesh* pMesh = new aiMesh;
+		if ( CreateTopology( pModel, matIdx, *pArray, pMesh ) )
 		{
-			aiMesh* pMesh = new aiMesh;
-			aiNode *pNode = CreateTopology( pModel, matIdx, *pArray, pMesh );
-			if ( NULL != pNode )
-			{
-				NodeArray.push_back( pNode );
-				MeshArray.push_back( pMesh );
-			}
-			else
-			{
-				delete pMesh;
-			}
+			aiNode *pNode = new aiNode;
+			pNode->mNumMeshes = 1;
+			pNode->mMeshes = new unsigned int[ 1 ];
+			NodeArray.push_back( pNode );
+			MeshArray.push_back( pMesh );
+		}
+		else
+		{
+			delete pMesh;
 		}
 		matIdx++;
 	}
@@ -349,29 +476,213 @@ void Q3BSPFileImporter::CreateNodes( const Q3BSP::Q3BSPModel *pModel, aiScene* p
 }
 
 // ------------------------------------------------------------------------------------------------
-//	Creates the topology.
-aiNode *Q3BSPFileImporter::CreateTopology( const Q3BSP::Q3BSPModel *pModel,
-										  unsigned int materialIdx,
-										  std::vector<sQ3BSPFace*> &rArray, 
-										  aiMesh* pMesh )
+//	Creates one node per visibility cluster and the nodes of the BSP tree.
+void Q3BSPFileImporter::CreateClusterNodes( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, 
+										   aiNode *pParent )
 {
-	size_t numVerts = countData( rArray );
-	if ( 0 == numVerts )
+	ai_assert( NULL != pModel );
+
+	// The materials are created in the order of the lookup map
+	std::map<std::string, unsigned int> materialIndices;
+	for ( FaceMapIt it = m_MaterialLookupMap.begin(); it != m_MaterialLookupMap.end(); ++it )
 	{
-		return NULL;
+		const unsigned int matIdx = materialIndices.size();
+		materialIndices[ (*it).first ] = matIdx;
 	}
-	
-	size_t numFaces = countFaces( rArray );
-	if ( 0 == numFaces )
+
+	// Collect the clusters of all leafs referencing a face. Cluster indices come from
+	// the file, there can't be more clusters than bit vectors or leafs.
+	int numClusters = pModel->m_VisData.iNumClusters;
+	const int maxClusters = numClusters > 0 ? numClusters : static_cast<int>( pModel->m_Leafs.size() );
+	unsigned int numInvalidClusters = 0;
+	std::vector< std::vector<int> > faceClusters( pModel->m_Faces.size() );
+	std::vector<aiVector3D> clusterMin, clusterMax;
+	for ( size_t i = 0; i < pModel->m_Leafs.size(); i++ )
 	{
-		return NULL;
+		const sQ3BSPLeaf &rLeaf = pModel->m_Leafs[ i ];
+		if ( rLeaf.iCluster < 0 )
+		{
+			continue;
+		}
+		if ( rLeaf.iCluster >= maxClusters )
+		{
+			++numInvalidClusters;
+			continue;
+		}
+		numClusters = std::max( numClusters, rLeaf.iCluster + 1 );
+
+		const aiVector3D leafMin = toVector( rLeaf.iMins ), leafMax = toVector( rLeaf.iMaxs );
+		if ( clusterMin.size() <= static_cast<size_t>( rLeaf.iCluster ) )
+		{
+			clusterMin.resize( rLeaf.iCluster + 1, aiVector3D( 1e10f ) );
+			clusterMax.resize( rLeaf.iCluster + 1, aiVector3D( -1e10f ) );
+		}
+		aiVector3D &rMin = clusterMin[ rLeaf.iCluster ], &rMax = clusterMax[ rLeaf.iCluster ];
+		rMin = aiVector3D( std::min( rMin.x, leafMin.x ), std::min( rMin.y, leafMin.y ), std::min( rMin.z, leafMin.z ) );
+		rMax = aiVector3D( std::max( rMax.x, leafMax.x ), std::max( rMax.y, leafMax.y ), std::max( rMax.z, leafMax.z ) );
+
+		for ( int j = 0; j < rLeaf.iNumLeafFaces; j++ )
+		{
+			const size_t leafFace = static_cast<size_t>( rLeaf.iLeafFace ) + j;
+			if ( rLeaf.iLeafFace < 0 || leafFace >= pModel->m_LeafFaces.size() )
+			{
+				break;
+			}
+			const int faceIdx = pModel->m_LeafFaces[ leafFace ];
+			if ( faceIdx >= 0 && static_cast<size_t>( faceIdx ) < faceClusters.size() )
+			{
+				faceClusters[ faceIdx ].push_back( rLeaf.iCluster );
+			}
+		}
+	}
+	if ( numInvalidClusters )
+	{
+		DefaultLogger::get()->warn( "Q3BSP: Leafs with invalid cluster indices, treating them as unclustered" );
+	}
+	clusterMin.resize( numClusters, aiVector3D() );
+	clusterMax.resize( numClusters, aiVector3D() );
+
+	// Group the faces by the set of clusters they are visible from and by material.
+	// A mesh is shared by the nodes of all its clusters, faces outside of any
+	// cluster end up in a separate node which is always visible.
+	typedef std::pair< std::vector<int>, unsigned int > GroupKey;
+	std::map< GroupKey, std::vector<sQ3BSPFace*> > groups;
+	std::string key;
+	for ( size_t i = 0; i < pModel->m_Faces.size(); i++ )
+	{
+		sQ3BSPFace *pQ3BSPFace = pModel->m_Faces[ i ];
+		std::vector<int> &rClusters = faceClusters[ i ];
+		std::sort( rClusters.begin(), rClusters.end() );
+		rClusters.erase( std::unique( rClusters.begin(), rClusters.end() ), rClusters.end() );
+
+		createKey( pQ3BSPFace->iTextureID, pQ3BSPFace->iLightmapID, key );
+		groups[ GroupKey( rClusters, materialIndices[ key ] ) ].push_back( pQ3BSPFace );
+	}
+
+	std::vector<aiMesh*> meshes;
+	std::vector< std::vector<unsigned int> > clusterMeshes( numClusters );
+	std::vector<unsigned int> unclusteredMeshes;
+	for ( std::map< GroupKey, std::vector<sQ3BSPFace*> >::iterator it = groups.begin(); it != groups.end(); ++it )
+	{
+		aiMesh *pMesh = new aiMesh;
+		if ( !CreateTopology( pModel, (*it).first.second, (*it).second, pMesh ) )
+		{
+			delete pMesh;
+			continue;
+		}
+
+		const std::vector<int> &rClusters = (*it).first.first;
+		for ( size_t i = 0; i < rClusters.size(); i++ )
+		{
+			clusterMeshes[ rClusters[ i ] ].push_back( meshes.size() );
+		}
+		if ( rClusters.empty() )
+		{
+			unclusteredMeshes.push_back( meshes.size() );
+		}
+		meshes.push_back( pMesh );
+	}
+
+	pScene->mNumMeshes = meshes.size();
+	if ( pScene->mNumMeshes > 0 )
+	{
+		pScene->mMeshes = new aiMesh*[ pScene->mNumMeshes ];
+		std::copy( meshes.begin(), meshes.end(), pScene->mMeshes );
+	}
+
+	// Setup the cluster nodes
+	const sQ3BSPVisData &rVis = pModel->m_VisData;
+	const bool hasPVS = rVis.iNumClusters > 0 && 2 * static_cast<size_t>( rVis.iBytesPerCluster ) < MAXLEN;
+	if ( rVis.iNumClusters > 0 && !hasPVS )
+	{
+		DefaultLogger::get()->warn( "Q3BSP: Too many clusters, can't export the potentially visible set" );
+	}
+
+	std::vector<aiNode*> nodes;
+	for ( int i = 0; i < numClusters; i++ )
+	{
+		aiNode *pNode = new aiNode;
+		pNode->mName.length = ::sprintf( pNode->mName.data, "cluster_%i", i );
+		setNodeMeshes( pNode, clusterMeshes[ i ] );
+
+		const bool nodeHasPVS = hasPVS && i < rVis.iNumClusters;
+		pNode->mMetaData = new aiMetadata( nodeHasPVS ? 4 : 3 );
+		pNode->mMetaData->Set( 0, "cluster", i );
+		pNode->mMetaData->Set( 1, "min", clusterMin[ i ] );
+		pNode->mMetaData->Set( 2, "max", clusterMax[ i ] );
+		if ( nodeHasPVS )
+		{
+			static const char hexDigits[] = "0123456789abcdef";
+			const unsigned char *pBits = &rVis.bits[ i * rVis.iBytesPerCluster ];
+
+			aiString pvs;
+			for ( int j = 0; j < rVis.iBytesPerCluster; j++ )
+			{
+				pvs.data[ 2 * j ] = hexDigits[ pBits[ j ] >> 4 ];
+				pvs.data[ 2 * j + 1 ] = hexDigits[ pBits[ j ] & 0xf ];
+			}
+			pvs.length = 2 * rVis.iBytesPerCluster;
+			pvs.data[ pvs.length ] = '\0';
+			pNode->mMetaData->Set( 3, "pvs", pvs );
+		}
+		nodes.push_back( pNode );
+	}
+
+	if ( !unclusteredMeshes.empty() )
+	{
+		aiNode *pNode = new aiNode( "unclustered" );
+		setNodeMeshes( pNode, unclusteredMeshes );
+		nodes.push_back( pNode );
+	}
+
+	if ( !pModel->m_Nodes.empty() )
+	{
+		std::vector<bool> visited( pModel->m_Nodes.size(), false );
+		aiNode *pBSPRoot = createBSPNode( pModel, 0, visited );
+		if ( NULL != pBSPRoot )
+		{
+			nodes.push_back( pBSPRoot );
+		}
+		else
+		{
+			DefaultLogger::get()->warn( "Q3BSP: Invalid BSP tree, ignoring it" );
+		}
+	}
+
+	pParent->mNumChildren = nodes.size();
+	pParent->mChildren = new aiNode*[ pParent->mNumChildren ];
+	for ( size_t i = 0; i < nodes.size(); i++ )
+	{
+		nodes[ i ]->mParent = pParent;
+		pParent->mChildren[ i ] = nodes[ i ];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Creates the topology.
+bool Q3BSPFileImporter::CreateTopology( const Q3BSP::Q3BSPModel *pModel,
+									   unsigned int materialIdx,
+									   std::vector<sQ3BSPFace*> &rArray, 
+									   aiMesh* pMesh )
+{
+	size_t numVerts = 0, numTriangles = 0;
+	countData( pModel, rArray, numVerts, numTriangles );
+	if ( 0 == numTriangles )
+	{
+		return false;
 	}
 
-	size_t numTriangles = countTriangles( rArray );
 	pMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
 
 	pMesh->mFaces = new aiFace[ numTriangles ];
 	pMesh->mNumFaces = numTriangles;
+	for ( size_t i = 0; i < numTriangles; i++ )
+	{
+		pMesh->mFaces[ i ].mNumIndices = 3;
+	}
+
+	// allocate the indices of all faces, they are filled in by createTriangleTopology()
+	AllocateFaceIndices( pMesh, m_bSharedFaceIndices );
 	
 	pMesh->mNumVertices = numVerts;
 	pMesh->mVertices = new aiVector3D[ numVerts ];
@@ -384,29 +695,19 @@ aiNode *Q3BSPFileImporter::CreateTopology( const Q3BSP::Q3BSPModel *pModel,
 	unsigned int vertIdx = 0;
 	pMesh->mNumUVComponents[ 0 ] = 2;
 	pMesh->mNumUVComponents[ 1 ] = 2;
+	std::vector<unsigned int> vertexMap;
 	for ( std::vector<sQ3BSPFace*>::const_iterator it = rArray.begin(); it != rArray.end(); ++it )
 	{
 		Q3BSP::sQ3BSPFace *pQ3BSPFace = *it;
 		ai_assert( NULL != pQ3BSPFace );
-		if ( NULL == pQ3BSPFace )
-		{
-			continue;
-		}
-
-		if ( pQ3BSPFace->iNumOfFaceVerts > 0 )
+		if ( isTriangleFace( pModel, pQ3BSPFace ) )
 		{
-			if ( pQ3BSPFace->iType == Polygon || pQ3BSPFace->iType == TriangleMesh )
-			{
-				createTriangleTopology( pModel, pQ3BSPFace, pMesh, faceIdx, vertIdx );
-			}		
+			createTriangleTopology( pModel, pQ3BSPFace, pMesh, faceIdx, vertIdx, vertexMap );
 		}
 	}
+	ai_assert( faceIdx == numTriangles && vertIdx == numVerts );
 
-	aiNode *pNode = new aiNode;
-	pNode->mNumMeshes = 1;
-	pNode->mMeshes = new unsigned int[ 1 ];
-
-	return pNode;
+	return true;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -415,59 +716,39 @@ void Q3BSPFileImporter::createTriangleTopology( const Q3BSP::Q3BSPModel *pModel,
 											  Q3BSP::sQ3BSPFace *pQ3BSPFace, 
 											  aiMesh* pMesh,
 											  unsigned int &rFaceIdx, 
-											  unsigned int &rVertIdx )
+											  unsigned int &rVertIdx,
+											  std::vector<unsigned int> &rVertexMap )
 {
-	ai_assert( rFaceIdx < pMesh->mNumFaces );
-	
-	m_pCurrentFace = getNextFace( pMesh, rFaceIdx );
-	ai_assert( NULL != m_pCurrentFace );
-	if ( NULL == m_pCurrentFace )
-	{
-		return;
-	}
-
-	m_pCurrentFace->mNumIndices = 3;
-	m_pCurrentFace->mIndices = new unsigned int[ m_pCurrentFace->mNumIndices ];
-	
-	size_t idx = 0;
-	for ( size_t i = 0; i < (size_t) pQ3BSPFace->iNumOfFaceVerts; i++ )
+	// Each vertex of the face is copied once, the triangles of the face share them
+	rVertexMap.assign( pQ3BSPFace->iNumOfVerts, UINT_MAX );
+	for ( int i = 0; i + 2 < pQ3BSPFace->iNumOfFaceVerts; i += 3 )
 	{
-		const size_t index = pQ3BSPFace->iVertexIndex + pModel->m_Indices[ pQ3BSPFace->iFaceVertexIndex + i ];
-		ai_assert( index < pModel->m_Vertices.size() );
-		if ( index >= pModel->m_Vertices.size() )
+		if ( !isValidTriangle( pModel, pQ3BSPFace, i ) )
 		{
 			continue;
 		}
 
-		sQ3BSPVertex *pVertex = pModel->m_Vertices[ index ];
-		ai_assert( NULL != pVertex );
-		if ( NULL == pVertex )
+		ai_assert( rFaceIdx < pMesh->mNumFaces );
+		aiFace &rFace = pMesh->mFaces[ rFaceIdx++ ];
+		for ( int j = 0; j < 3; j++ )
 		{
-			continue;
-		}
+			const int offset = pModel->m_Indices[ pQ3BSPFace->iFaceVertexIndex + i + j ];
+			unsigned int &rIndex = rVertexMap[ offset ];
+			if ( UINT_MAX == rIndex )
+			{
+				const sQ3BSPVertex *pVertex = pModel->m_Vertices[ pQ3BSPFace->iVertexIndex + offset ];
+				ai_assert( NULL != pVertex );
 
-		pMesh->mVertices[ rVertIdx ].Set( pVertex->vPosition.x, pVertex->vPosition.y, pVertex->vPosition.z );
-		pMesh->mNormals[ rVertIdx ].Set( pVertex->vNormal.x, pVertex->vNormal.y, pVertex->vNormal.z );
+				rIndex = rVertIdx++;
+				pMesh->mVertices[ rIndex ].Set( pVertex->vPosition.x, pVertex->vPosition.y, pVertex->vPosition.z );
+				pMesh->mNormals[ rIndex ].Set( pVertex->vNormal.x, pVertex->vNormal.y, pVertex->vNormal.z );
 				
-		pMesh->mTextureCoords[ 0 ][ rVertIdx ].Set( pVertex->vTexCoord.x, pVertex->vTexCoord.y, 0.0f );
-		pMesh->mTextureCoords[ 1 ][ rVertIdx ].Set( pVertex->vLightmap.x, pVertex->vLightmap.y, 0.0f );
-		
-		m_pCurrentFace->mIndices[ idx ] = rVertIdx;
-		rVertIdx++;
-		
-		idx++;
-		if ( idx > 2 )
-		{
-			idx = 0;
-			m_pCurrentFace = getNextFace( pMesh, rFaceIdx );
-			if ( NULL != m_pCurrentFace )
-			{
-				m_pCurrentFace->mNumIndices = 3;
-				m_pCurrentFace->mIndices = new unsigned int[ 3 ];
+				pMesh->mTextureCoords[ 0 ][ rIndex ].Set( pVertex->vTexCoord.x, pVertex->vTexCoord.y, 0.0f );
+				pMesh->mTextureCoords[ 1 ][ rIndex ].Set( pVertex->vLightmap.x, pVertex->vLightmap.y, 0.0f );
 			}
+			rFace.mIndices[ j ] = rIndex;
 		}
 	}
-	rFaceIdx--;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -528,59 +809,40 @@ void Q3BSPFileImporter::createMaterials( const Q3BSP::Q3BSPModel *pModel, aiScen
 }
 
 // ------------------------------------------------------------------------------------------------
-//	Counts the number of referenced vertices.
-size_t Q3BSPFileImporter::countData( const std::vector<sQ3BSPFace*> &rArray ) const
+//	Counts the number of referenced vertices and triangles.
+void Q3BSPFileImporter::countData( const Q3BSP::Q3BSPModel *pModel, const std::vector<sQ3BSPFace*> &rArray,
+								  size_t &rNumVerts, size_t &rNumTriangles ) const
 {
-	size_t numVerts = 0;
+	std::vector<bool> used;
 	for ( std::vector<sQ3BSPFace*>::const_iterator it = rArray.begin(); it != rArray.end(); 
 		++it )
 	{
-		sQ3BSPFace *pQ3BSPFace = *it;
-		if ( pQ3BSPFace->iType == Polygon || pQ3BSPFace->iType == TriangleMesh )
+		const sQ3BSPFace *pQ3BSPFace = *it;
+		if ( !isTriangleFace( pModel, pQ3BSPFace ) )
 		{
-			Q3BSP::sQ3BSPFace *pQ3BSPFace = *it;
-			ai_assert( NULL != pQ3BSPFace );
-			numVerts += pQ3BSPFace->iNumOfFaceVerts;
+			continue;
 		}
-	}
 
-	return numVerts;
-}
-
-// ------------------------------------------------------------------------------------------------
-//	Counts the faces with vertices.
-size_t Q3BSPFileImporter::countFaces( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const
-{
-	size_t numFaces = 0;
-	for ( std::vector<sQ3BSPFace*>::const_iterator it = rArray.begin(); it != rArray.end(); 
-		++it )
-	{
-		Q3BSP::sQ3BSPFace *pQ3BSPFace = *it;
-		if ( pQ3BSPFace->iNumOfFaceVerts > 0 )
+		used.assign( pQ3BSPFace->iNumOfVerts, false );
+		for ( int i = 0; i + 2 < pQ3BSPFace->iNumOfFaceVerts; i += 3 )
 		{
-			numFaces++;
-		}
-	}
-
-	return numFaces;
-}
+			if ( !isValidTriangle( pModel, pQ3BSPFace, i ) )
+			{
+				continue;
+			}
 
-// ------------------------------------------------------------------------------------------------
-//	Counts the number of triangles in a Q3-facearray.
-size_t Q3BSPFileImporter::countTriangles( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const
-{
-	size_t numTriangles = 0;
-	for ( std::vector<Q3BSP::sQ3BSPFace*>::const_iterator it = rArray.begin(); it != rArray.end(); 
-		++it )
-	{
-		const Q3BSP::sQ3BSPFace *pQ3BSPFace = *it;
-		if ( NULL != pQ3BSPFace )
-		{
-			numTriangles += pQ3BSPFace->iNumOfFaceVerts / 3;
+			rNumTriangles++;
+			for ( int j = 0; j < 3; j++ )
+			{
+				const int offset = pModel->m_Indices[ pQ3BSPFace->iFaceVertexIndex + i + j ];
+				if ( !used[ offset ] )
+				{
+					used[ offset ] = true;
+					rNumVerts++;
+				}
+			}
 		}
 	}
-
-	return numTriangles;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -613,24 +875,6 @@ void Q3BSPFileImporter::createMaterialMap( const Q3BSP::Q3BSPModel *pModel )
 	}
 }
 
-// ------------------------------------------------------------------------------------------------
-//	Returns the next face.
-aiFace *Q3BSPFileImporter::getNextFace( aiMesh *pMesh, unsigned int &rFaceIdx )
-{
-	aiFace *pFace = NULL;
-	if ( rFaceIdx < pMesh->mNumFaces )
-	{
-		pFace = &pMesh->mFaces[ rFaceIdx ];
-		rFaceIdx++;
-	}
-	else
-	{
-		pFace = NULL;
-	}
-
-	return pFace;
-}
-
 // ------------------------------------------------------------------------------------------------
 //	Imports a texture file.
 bool Q3BSPFileImporter::importTextureFromArchive( const Q3BSP::Q3BSPModel *pModel,
@@ -73,6 +73,10 @@ public:
 	/// @remark	See BaseImporter::CanRead() for details.
 	bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig ) const;
 
+	/// @brief	Called prior to ReadFile() to read the import configuration.
+	/// @remark	See BaseImporter::SetupProperties() for details.
+	void SetupProperties( const Importer* pImp );
+
 private:
 	typedef std::map<std::string, std::vector<Q3BSP::sQ3BSPFace*>*> FaceMap;
 	typedef std::map<std::string, std::vector<Q3BSP::sQ3BSPFace*>* >::iterator FaceMapIt;
@@ -84,16 +88,15 @@ private:
 	bool findFirstMapInArchive( Q3BSP::Q3BSPZipArchive &rArchive, std::string &rMapName );
 	void CreateDataFromImport( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, Q3BSP::Q3BSPZipArchive *pArchive );
 	void CreateNodes( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, aiNode *pParent );
-	aiNode *CreateTopology( const Q3BSP::Q3BSPModel *pModel, unsigned int materialIdx, 
+	void CreateClusterNodes( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, aiNode *pParent );
+	bool CreateTopology( const Q3BSP::Q3BSPModel *pModel, unsigned int materialIdx, 
 		std::vector<Q3BSP::sQ3BSPFace*> &rArray, aiMesh* pMesh );
 	void createTriangleTopology( const Q3BSP::Q3BSPModel *pModel, Q3BSP::sQ3BSPFace *pQ3BSPFace, aiMesh* pMesh, unsigned int &rFaceIdx, 
-		unsigned int &rVertIdx  );
+		unsigned int &rVertIdx, std::vector<unsigned int> &rVertexMap );
 	void createMaterials( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, Q3BSP::Q3BSPZipArchive *pArchive );
-	size_t countData( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const;
-	size_t countFaces( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const;
-	size_t countTriangles( const std::vector<Q3BSP::sQ3BSPFace*> &rArray ) const;
+	void countData( const Q3BSP::Q3BSPModel *pModel, const std::vector<Q3BSP::sQ3BSPFace*> &rArray, 
+		size_t &rNumVerts, size_t &rNumTriangles ) const;
 	void createMaterialMap( const Q3BSP::Q3BSPModel *pModel);
-	aiFace *getNextFace( aiMesh *pMesh, unsigned int &rFaceIdx );
 	bool importTextureFromArchive( const Q3BSP::Q3BSPModel *pModel, Q3BSP::Q3BSPZipArchive *pArchive, aiScene* pScene, 
 		aiMaterial *pMatHelper, int textureId );
 	bool importLightmap( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, aiMaterial *pMatHelper, int lightmapId );
@@ -103,7 +106,8 @@ private:
 
 private:
 	aiMesh *m_pCurrentMesh;
-	aiFace *m_pCurrentFace;
+	bool m_bSplitByCluster;
+	bool m_bSharedFaceIndices;
 	FaceMap m_MaterialLookupMap;
 	std::vector<aiTexture*> mTextures;
 };
@@ -148,6 +148,10 @@ bool Q3BSPFileParser::parseFile()
 	// Load the entities
 	getEntities();
 
+	// Load the bsp tree and the potentially visible set
+	getBSPTree();
+	getVisData();
+
 	return true;
 }
 
@@ -273,6 +277,73 @@ void Q3BSPFileParser::getEntities()
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+void Q3BSPFileParser::getBSPTree()
+{
+	ai_assert( NULL != m_pModel );
+
+	if ( !getLump( kPlanes, m_pModel->m_Planes ) || !getLump( kNodes, m_pModel->m_Nodes ) ||
+		!getLump( kLeafs, m_pModel->m_Leafs ) || !getLump( kLeafFaces, m_pModel->m_LeafFaces ) )
+	{
+		DefaultLogger::get()->warn( "Q3BSP: Invalid BSP tree, ignoring it" );
+		m_pModel->m_Planes.clear();
+		m_pModel->m_Nodes.clear();
+		m_pModel->m_Leafs.clear();
+		m_pModel->m_LeafFaces.clear();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Q3BSPFileParser::getVisData()
+{
+	ai_assert( NULL != m_pModel );
+
+	const sQ3BSPLump *pLump = m_pModel->m_Lumps[ kVisData ];
+	if ( pLump->iSize < 8 )
+		return;
+
+	sQ3BSPVisData &rVis = m_pModel->m_VisData;
+	if ( pLump->iOffset < 0 || static_cast<size_t>( pLump->iOffset ) + pLump->iSize > m_Data.size() )
+	{
+		DefaultLogger::get()->warn( "Q3BSP: Invalid visibility data, ignoring it" );
+		return;
+	}
+
+	int header[ 2 ];
+	memcpy( header, &m_Data[ pLump->iOffset ], sizeof( header ) );
+	if ( header[ 0 ] <= 0 || header[ 1 ] <= 0 || 
+		static_cast<ai_uint64>( header[ 0 ] ) * header[ 1 ] > static_cast<ai_uint64>( pLump->iSize - 8 ) )
+	{
+		DefaultLogger::get()->warn( "Q3BSP: Invalid visibility data, ignoring it" );
+		return;
+	}
+
+	rVis.iNumClusters = header[ 0 ];
+	rVis.iBytesPerCluster = header[ 1 ];
+	rVis.bits.resize( header[ 0 ] * header[ 1 ] );
+	memcpy( &rVis.bits[ 0 ], &m_Data[ pLump->iOffset + 8 ], rVis.bits.size() );
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Copies a lump of plain records, returns false if the lump exceeds the file.
+template <class T>
+bool Q3BSPFileParser::getLump( int lumpIdx, std::vector<T> &rData ) const
+{
+	const sQ3BSPLump *pLump = m_pModel->m_Lumps[ lumpIdx ];
+	if ( pLump->iOffset < 0 || pLump->iSize < 0 || 
+		static_cast<size_t>( pLump->iOffset ) + pLump->iSize > m_Data.size() )
+	{
+		return false;
+	}
+
+	rData.resize( pLump->iSize / sizeof( T ) );
+	if ( !rData.empty() )
+	{
+		memcpy( &rData[ 0 ], &m_Data[ pLump->iOffset ], rData.size() * sizeof( T ) );
+	}
+	return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 
 } // Namespace Assimp
@@ -76,6 +76,11 @@ protected:
 	void getTextures();
 	void getLightMaps();
 	void getEntities();
+	void getBSPTree();
+	void getVisData();
+
+	template <class T>
+	bool getLump( int lumpIdx, std::vector<T> &rData ) const;
 
 private:
 	size_t m_sOffset;
@@ -43,8 +43,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_Q3BSP_IMPORTER
 
 #include "Q3BSPZipArchive.h"
-#include <algorithm>
-#include <cassert>
 
 namespace Assimp
 {
@@ -53,144 +51,35 @@ namespace Q3BSP
 
 // ------------------------------------------------------------------------------------------------
 //	Constructor.
-Q3BSPZipArchive::Q3BSPZipArchive( const std::string& rFile ) :
-	m_ZipFileHandle( NULL ),
-	m_FileList(),
-	m_bDirty( true )
+Q3BSPZipArchive::Q3BSPZipArchive( IOSystem *pIOHandler, const std::string& rFile ) :
+	ZipIOSystem( rFile.c_str(), pIOHandler )
 {
-	if ( !rFile.empty() )
-	{
-		m_ZipFileHandle = unzOpen( rFile.c_str() );
-		if ( NULL != m_ZipFileHandle )
-		{
-			mapArchive();
-		}
-	}
+	// empty
 }
 
 // ------------------------------------------------------------------------------------------------
 //	Destructor.
 Q3BSPZipArchive::~Q3BSPZipArchive()
 {
-	if ( NULL != m_ZipFileHandle )
-	{
-		unzClose( m_ZipFileHandle );
-	}
-	m_ZipFileHandle = NULL;
-	m_FileList.clear();
+	// empty
 }
 
 // ------------------------------------------------------------------------------------------------
 //	Returns true, if the archive is already open.
 bool Q3BSPZipArchive::isOpen() const
 {
-	return ( NULL != m_ZipFileHandle );
-}
-
-// ------------------------------------------------------------------------------------------------
-//	Returns true, if the filename is part of the archive.
-bool Q3BSPZipArchive::Exists( const char* pFile ) const
-{
-	ai_assert( NULL != pFile );
-	if ( NULL == pFile )
-	{
-		return false;
-	}
-
-	std::string rFile( pFile );
-	std::vector<std::string>::const_iterator it = std::find( m_FileList.begin(), m_FileList.end(), rFile );
-	if ( m_FileList.end() == it )
-	{
-		return false;
-	}
-
-	return true;
-}
-
-// ------------------------------------------------------------------------------------------------
-//	Returns the separator delimiter.
-char Q3BSPZipArchive::getOsSeparator() const
-{
-	return '/';
+	return IsOpen();
 }
 
-// ------------------------------------------------------------------------------------------------
-//	Opens a file, which is part of the archive.
-IOStream *Q3BSPZipArchive::Open( const char* pFile, const char* /*pMode*/ )
-{
-	ai_assert( NULL != pFile );
-
-	std::string rItem( pFile );
-	std::vector<std::string>::iterator it = std::find( m_FileList.begin(), m_FileList.end(), rItem );
-	if ( m_FileList.end() == it )
-		return NULL;
-
-	ZipFile *pZipFile = new ZipFile( *it, m_ZipFileHandle );
-	m_ArchiveMap[ rItem ] = pZipFile;
-
-	return pZipFile;
-}
-
-// ------------------------------------------------------------------------------------------------
-//	Close a filestream.
-void Q3BSPZipArchive::Close( IOStream *pFile )
-{
-	ai_assert( NULL != pFile );
-
-	std::map<std::string, IOStream*>::iterator it;
-	for ( it = m_ArchiveMap.begin(); it != m_ArchiveMap.end(); ++it )
-	{
-		if ( (*it).second == pFile )
-		{
-			ZipFile *pZipFile = reinterpret_cast<ZipFile*>( (*it).second ); 
-			delete pZipFile;
-			m_ArchiveMap.erase( it );
-			break;
-		}
-	}
-}
 // ------------------------------------------------------------------------------------------------
 //	Returns the file-list of the archive.
 void Q3BSPZipArchive::getFileList( std::vector<std::string> &rFileList )
 {
-	rFileList = m_FileList;
-}
-
-// ------------------------------------------------------------------------------------------------
-//	Maps the archive content.
-bool Q3BSPZipArchive::mapArchive()
-{
-	if ( NULL == m_ZipFileHandle )
-		return false;
-
-	if ( !m_bDirty )
-		return true;
-
-	if ( !m_FileList.empty() )
-		m_FileList.resize( 0 );
-
-	//	At first ensure file is already open
-	if ( UNZ_OK == unzGoToFirstFile( m_ZipFileHandle ) ) 
+	rFileList.clear();
+	for ( unsigned int i = 0; i < GetNumFiles(); ++i )
 	{
-		char filename[ FileNameSize ];
-		unzGetCurrentFileInfo( m_ZipFileHandle, NULL, filename, FileNameSize, NULL, 0, NULL, 0 );
-		m_FileList.push_back( filename );
-		unzCloseCurrentFile( m_ZipFileHandle );
-			
-		// Loop over all files
-		while ( unzGoToNextFile( m_ZipFileHandle ) != UNZ_END_OF_LIST_OF_FILE )  
-		{
-			char filename[ FileNameSize ];
-			unzGetCurrentFileInfo( m_ZipFileHandle, NULL, filename, FileNameSize, NULL, 0, NULL, 0 );
-			m_FileList.push_back( filename );
-			unzCloseCurrentFile( m_ZipFileHandle );
-		}
+		rFileList.push_back( GetFileName( i ) );
 	}
-	
-	std::sort( m_FileList.begin(), m_FileList.end() );
-	m_bDirty = false;
-
-	return true;
 }
 
 // ------------------------------------------------------------------------------------------------
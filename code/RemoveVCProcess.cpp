@@ -270,6 +270,25 @@ bool RemoveVCProcess::ProcessMesh(aiMesh* pMesh)
 		ret = true;
 	}
 
+	// anim meshes may only replace components the mesh has
+	for (unsigned int i = 0; i < pMesh->mNumAnimMeshes; ++i)
+	{
+		aiAnimMesh* anim = pMesh->mAnimMeshes[i];
+		if (!pMesh->mNormals)
+		{
+			delete[] anim->mNormals;
+			anim->mNormals = NULL;
+		}
+		if (!pMesh->mTangents)
+		{
+			delete[] anim->mTangents;
+			anim->mTangents = NULL;
+
+			delete[] anim->mBitangents;
+			anim->mBitangents = NULL;
+		}
+	}
+
 	// handle texture coordinates
 	register bool b = (0 != (configDeleteFlags & aiComponent_TEXCOORDS));
 	for (unsigned int i = 0, real = 0; real < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++real)
@@ -277,7 +296,7 @@ bool RemoveVCProcess::ProcessMesh(aiMesh* pMesh)
 		if (!pMesh->mTextureCoords[i])break;
 		if (configDeleteFlags & aiComponent_TEXCOORDSn(real) || b)
 		{
-			delete pMesh->mTextureCoords[i];
+			delete[] pMesh->mTextureCoords[i];
 			pMesh->mTextureCoords[i] = NULL;
 			ret = true;
 
@@ -301,7 +320,7 @@ bool RemoveVCProcess::ProcessMesh(aiMesh* pMesh)
 		if (!pMesh->mColors[i])break;
 		if (configDeleteFlags & aiComponent_COLORSn(i) || b)
 		{
-			delete pMesh->mColors[i];
+			delete[] pMesh->mColors[i];
 			pMesh->mColors[i] = NULL;
 			ret = true;
 
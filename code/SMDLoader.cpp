@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SMDLoader.h"
 #include "fast_atof.h"
 #include "SkeletonMeshBuilder.h"
+#include "ParallelFor.h"
 
 using namespace Assimp;
 
@@ -66,9 +67,48 @@ static const aiImporterDesc desc = {
 	"smd vta" 
 };
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Parses one chunk of vertex lines of a triangles section per job. Each line
+ *  writes to its own vertex, so the jobs can run in parallel. */
+class ParseVertexJob
+{
+public:
+	ParseVertexJob(SMDImporter* importer, std::vector<SMD::Face>& faces, 
+		std::vector<SMD::VertexLine>& lines, unsigned int chunk)
+		: importer(importer), faces(faces), lines(lines), chunk(chunk)
+	{}
+
+	unsigned int GetCount() const {
+		return static_cast<unsigned int>((lines.size() + chunk - 1) / chunk);
+	}
+
+	void operator() (unsigned int i) {
+		const size_t end = std::min(lines.size(),static_cast<size_t>(i+1)*chunk);
+		for (size_t n = static_cast<size_t>(i)*chunk; n < end; ++n) {
+			SMD::VertexLine& line = lines[n];
+			line.szError = importer->ParseVertexData(line.szData,
+				faces[line.iFace].avVertices[line.iVertex]);
+		}
+	}
+
+private:
+	SMDImporter* importer;
+	std::vector<SMD::Face>& faces;
+	std::vector<SMD::VertexLine>& lines;
+	unsigned int chunk;
+};
+
+} // ! anon namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 SMDImporter::SMDImporter()
+: configFrameID()
+, configThreads(1)
+, configParallelThreshold(AI_PARALLEL_DEFAULT_THRESHOLD)
+, configParallelChunk(AI_PARALLEL_DEFAULT_CHUNK)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -102,6 +142,9 @@ void SMDImporter::SetupProperties(const Importer* pImp)
 	if(static_cast<unsigned int>(-1) == configFrameID)	{
 		configFrameID = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_GLOBAL_KEYFRAME,0);
 	}
+	configThreads = GetWorkerThreadCount(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,-1));
+	configParallelThreshold = pImp->GetPropertyInteger(AI_CONFIG_GLOB_PARALLEL_THRESHOLD,AI_PARALLEL_DEFAULT_THRESHOLD);
+	configParallelChunk = std::max(1,pImp->GetPropertyInteger(AI_CONFIG_GLOB_PARALLEL_CHUNK,AI_PARALLEL_DEFAULT_CHUNK));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -200,9 +243,15 @@ void SMDImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOS
 // ------------------------------------------------------------------------------------------------
 // Write an error message with line number to the log file
 void SMDImporter::LogErrorNoThrow(const char* msg)
+{
+	LogErrorNoThrow(iLineNumber,msg);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SMDImporter::LogErrorNoThrow(unsigned int line, const char* msg)
 {
 	char szTemp[1024];
-	sprintf(szTemp,"Line %i: %s",iLineNumber,msg);
+	sprintf(szTemp,"Line %i: %s",line,msg);
 	DefaultLogger::get()->error(szTemp);
 }
 
@@ -753,12 +802,8 @@ void SMDImporter::ParseNodesSection(const char* szCurrent,
 	for ( ;; )
 	{
 		// "end\n" - Ends the nodes section
-		if (0 == ASSIMP_strincmp(szCurrent,"end",3) &&
-			IsSpaceOrNewLine(*(szCurrent+3)))
-		{
-			szCurrent += 4;
+		if (TokenMatchI(szCurrent,"end",3))
 			break;
-		}
 		ParseNodeInfo(szCurrent,&szCurrent);
 	}
 	SkipSpacesAndLineEnd(szCurrent,&szCurrent);
@@ -770,8 +815,11 @@ void SMDImporter::ParseNodesSection(const char* szCurrent,
 void SMDImporter::ParseTrianglesSection(const char* szCurrent,
 	const char** szCurrentOut)
 {
-	// Parse a triangle, parse another triangle, parse the next triangle ...
-	// and so on until we reach a token that looks quite similar to "end"
+	// Find a triangle, find another triangle, find the next triangle ...
+	// and so on until we reach a token that looks quite similar to "end".
+	// Texture names are resolved right away as their indices depend
+	// on the order of appearance, the vertex lines are parsed afterwards.
+	std::vector<SMD::VertexLine> lines;
 	for ( ;; )
 	{
 		if(!SkipSpacesAndLineEnd(szCurrent,&szCurrent)) break;
@@ -779,10 +827,20 @@ void SMDImporter::ParseTrianglesSection(const char* szCurrent,
 		// "end\n" - Ends the triangles section
 		if (TokenMatch(szCurrent,"end",3))
 			break;
-		ParseTriangle(szCurrent,&szCurrent);
+		ScanTriangle(szCurrent,&szCurrent,lines);
 	}
 	SkipSpacesAndLineEnd(szCurrent,&szCurrent);
 	*szCurrentOut = szCurrent;
+
+	// The vertex lines are independent of each other, so they can be parsed in parallel
+	ParseVertexJob job(this,asTriangles,lines,configParallelChunk);
+	ParallelFor(job.GetCount(),lines.size() < configParallelThreshold ? 1 : configThreads,job);
+
+	for (std::vector<SMD::VertexLine>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+		if ((*it).szError) {
+			LogErrorNoThrow((*it).iLine,(*it).szError);
+		}
+	}
 }
 // ------------------------------------------------------------------------------------------------
 // Parse the vertex animation section of the file
@@ -991,10 +1049,11 @@ void SMDImporter::ParseSkeletonElement(const char* szCurrent,
 }
 
 // ------------------------------------------------------------------------------------------------
-// Parse a triangle
-void SMDImporter::ParseTriangle(const char* szCurrent,
-	const char** szCurrentOut)
+// Locate a triangle
+void SMDImporter::ScanTriangle(const char* szCurrent,
+	const char** szCurrentOut, std::vector<SMD::VertexLine>& lines)
 {
+	const unsigned int iFace = static_cast<unsigned int>(asTriangles.size());
 	asTriangles.push_back(SMD::Face());
 	SMD::Face& face = asTriangles.back();
 	
@@ -1011,13 +1070,13 @@ void SMDImporter::ParseTriangle(const char* szCurrent,
 	// ... and get the index that belongs to this file name
 	face.iTexture = GetTextureIndex(std::string(szLast,(uintptr_t)szCurrent-(uintptr_t)szLast));
 
-	SkipSpacesAndLineEnd(szCurrent,&szCurrent);
-
-	// load three vertices
+	// remember where the three vertices are. Each occupies a single line,
+	// lines containing only whitespace are skipped.
 	for (unsigned int iVert = 0; iVert < 3;++iVert)
 	{
-		ParseVertex(szCurrent,&szCurrent,
-			face.avVertices[iVert]);
+		SkipSpacesAndLineEnd(szCurrent,&szCurrent);
+		lines.push_back(SMD::VertexLine(iFace,iVert,szCurrent,iLineNumber));
+		SkipLine(szCurrent,&szCurrent);
 	}
 	*szCurrentOut = szCurrent;
 }
@@ -1064,64 +1123,66 @@ void SMDImporter::ParseVertex(const char* szCurrent,
 	const char** szCurrentOut, SMD::Vertex& vertex,
 	bool bVASection /*= false*/)
 {
-	if (SkipSpaces(&szCurrent) && IsLineEnd(*szCurrent))
-	{
-		SkipSpacesAndLineEnd(szCurrent,&szCurrent);
-		return ParseVertex(szCurrent,szCurrentOut,vertex,bVASection);
+	// skip lines containing only whitespace
+	SkipSpacesAndLineEnd(szCurrent,&szCurrent);
+
+	const char* szError = ParseVertexData(szCurrent,vertex,bVASection);
+	if (szError) {
+		LogErrorNoThrow(szError);
 	}
+	// go to the beginning of the next line
+	SMDI_PARSE_RETURN;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Parse the data of a vertex line
+const char* SMDImporter::ParseVertexData(const char* szCurrent,
+	SMD::Vertex& vertex, bool bVASection /*= false*/)
+{
 	if(!ParseSignedInt(szCurrent,&szCurrent,(int&)vertex.iParentNode))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.parent");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.parent";
 	}
 	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.pos.x))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.pos.x");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.pos.x";
 	}
 	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.pos.y))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.pos.y");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.pos.y";
 	}
 	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.pos.z))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.pos.z");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.pos.z";
 	}
 	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.nor.x))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.nor.x");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.nor.x";
 	}
 	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.nor.y))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.nor.y");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.nor.y";
 	}
 	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.nor.z))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.nor.z");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.nor.z";
 	}
 
-	if (bVASection)SMDI_PARSE_RETURN;
+	if (bVASection)return NULL;
 
 	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.uv.x))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.uv.x");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.uv.x";
 	}
 	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.uv.y))
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.uv.y");
-		SMDI_PARSE_RETURN;
+		return "Unexpected EOF/EOL while parsing vertex.uv.y";
 	}
 
 	// now read the number of bones affecting this vertex
 	// all elements from now are fully optional, we don't need them
 	unsigned int iSize = 0;
-	if(!ParseUnsignedInt(szCurrent,&szCurrent,iSize))SMDI_PARSE_RETURN;
+	if(!ParseUnsignedInt(szCurrent,&szCurrent,iSize))return NULL;
 	vertex.aiBoneLinks.resize(iSize,std::pair<unsigned int, float>(0,0.0f));
 
 	for (std::vector<std::pair<unsigned int, float> >::iterator
@@ -1129,13 +1190,12 @@ void SMDImporter::ParseVertex(const char* szCurrent,
 		i != vertex.aiBoneLinks.end();++i)
 	{
 		if(!ParseUnsignedInt(szCurrent,&szCurrent,(*i).first))
-			SMDI_PARSE_RETURN;
+			return NULL;
 		if(!ParseFloat(szCurrent,&szCurrent,(*i).second))
-			SMDI_PARSE_RETURN;
+			return NULL;
 	}
 
-	// go to the beginning of the next line
-	SMDI_PARSE_RETURN;
+	return NULL;
 }
 
 #endif // !! ASSIMP_BUILD_NO_SMD_IMPORTER
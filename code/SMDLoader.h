@@ -100,6 +100,30 @@ struct Face
 	Vertex avVertices[3];
 };
 
+// ---------------------------------------------------------------------------
+/** Position of a not yet parsed vertex line in the triangles section
+*/
+struct VertexLine
+{
+	VertexLine(unsigned int iFace, unsigned int iVertex,
+		const char* szData, unsigned int iLine)
+		: iFace(iFace), iVertex(iVertex), szData(szData)
+		, iLine(iLine), szError()
+	 {}
+
+	//! Index of the face and of the vertex within it
+	unsigned int iFace, iVertex;
+
+	//! Start of the line
+	const char* szData;
+
+	//! Line number, for error messages
+	unsigned int iLine;
+
+	//! Receives the parsing error, if any
+	const char* szError;
+};
+
 // ---------------------------------------------------------------------------
 /** Data structure for a bone in a SMD file
 */
@@ -193,6 +217,16 @@ public:
 	 */
 	void SetupProperties(const Importer* pImp);
 
+	// -------------------------------------------------------------------
+	/** Parse the data of a single vertex line. Doesn't touch any
+	 *  importer state, so it may be called from multiple threads at once.
+	 * \param szCurrent Start of the line
+	 * \param vertex Vertex to be filled
+	 * \return NULL on success, an error message otherwise
+	*/
+	const char* ParseVertexData(const char* szCurrent, SMD::Vertex& vertex,
+		bool bVASection = false);
+
 protected:
 
 
@@ -257,13 +291,15 @@ protected:
 		const char** szCurrentOut);
 
 	// -------------------------------------------------------------------
-	/** Parse a single triangle in the SMD file
+	/** Locate a single triangle in the SMD file and resolve its texture,
+	 *  but don't parse its vertices yet.
 	 * \param szCurrent Current position in the file. Points to the first
-	 * data line of the section.
+	 * data line of the triangle.
 	 * \param szCurrentOut Receives the output cursor position
+	 * \param lines Receives the position of the triangle's vertex lines
 	*/
-	void ParseTriangle(const char* szCurrent,
-		const char** szCurrentOut);
+	void ScanTriangle(const char* szCurrent,
+		const char** szCurrentOut, std::vector<SMD::VertexLine>& lines);
 
 
 	// -------------------------------------------------------------------
@@ -348,6 +384,7 @@ protected:
 	/** Print a log message together with the current line number
 	 */
 	void LogErrorNoThrow(const char* msg);
+	void LogErrorNoThrow(unsigned int line, const char* msg);
 	void LogWarning(const char* msg);
 
 
@@ -370,6 +407,14 @@ private:
 	/** Configuration option: frame to be loaded */
 	unsigned int configFrameID;
 
+	/** Configuration option: number of threads to parse with */
+	unsigned int configThreads;
+
+	/** Configuration option: minimum number of vertex lines to parse
+	 *  them in parallel and number of lines per job */
+	unsigned int configParallelThreshold;
+	unsigned int configParallelChunk;
+
 	/** Buffer to hold the loaded file */
 	const char* mBuffer;
 
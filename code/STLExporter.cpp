@@ -52,26 +52,49 @@ namespace Assimp	{
 // Worker function for exporting a scene to Stereolithograpy. Prototyped and registered in Exporter.cpp
 void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
 {
-	// invoke the exporter 
-	STLExporter exporter(pFile, pScene);
+	// invoke the exporter, it writes the file as it goes
+	STLExporter exporter(pFile, pIOSystem, pScene);
+}
 
-	// we're still here - export successfully completed. Write the file.
-	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+// ------------------------------------------------------------------------------------------------
+// Worker function for exporting a scene to binary Stereolithograpy. Prototyped and registered in Exporter.cpp
+void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
+{
+	STLExporter exporter(pFile, pIOSystem, pScene, true);
 }
 
 } // end of namespace Assimp
 
 
 // ------------------------------------------------------------------------------------------------
-STLExporter :: STLExporter(const char* _filename, const aiScene* pScene)
+STLExporter :: STLExporter(const char* _filename, IOSystem* pIOSystem, const aiScene* pScene, bool binary)
 : filename(_filename)
 , pScene(pScene)
+, mOutput(pIOSystem,filename,binary ? "wb" : "wt")
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
+	if (binary) {
+		// 80 byte header. It must not start with 'solid', readers would take it for an ASCII file. 
+		char header[80] = {0};
+		::strncpy(header,"Binary STL file written by Open Asset Import Library",sizeof(header)-1);
+		mOutput.Write(header,sizeof(header));
+
+		// only triangles can be stored, points and lines are dropped
+		uint32_t triangles = 0;
+		for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			const aiMesh* const m = pScene->mMeshes[i];
+			for (unsigned int a = 0; a < m->mNumFaces; ++a) {
+				triangles += (m->mFaces[a].mNumIndices == 3);
+			}
+		}
+		mOutput.PutLE(triangles);
+
+		for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			WriteMeshBinary(pScene->mMeshes[i]);
+		}
+		mOutput.Flush();
+		return;
+	}
 
 	const std::string& name = "AssimpScene";
 	
@@ -80,6 +103,23 @@ STLExporter :: STLExporter(const char* _filename, const aiScene* pScene)
 		WriteMesh(pScene->mMeshes[i]);
 	}
 	mOutput << "endsolid " << name << endl;
+	mOutput.Flush();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compute the facet normal for a face
+static aiVector3D GetFaceNormal(const aiMesh* m, const aiFace& f)
+{
+	// we need per-face normals. We specified aiProcess_GenNormals as pre-requisite for this exporter,
+	// but nonetheless we have to expect per-vertex normals.
+	aiVector3D nor;
+	if (m->mNormals) {
+		for(unsigned int a = 0; a < f.mNumIndices; ++a) {
+			nor += m->mNormals[f.mIndices[a]];
+		}
+		nor.Normalize();
+	}
+	return nor;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -88,15 +128,7 @@ void STLExporter :: WriteMesh(const aiMesh* m)
 	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
 		const aiFace& f = m->mFaces[i];
 
-		// we need per-face normals. We specified aiProcess_GenNormals as pre-requisite for this exporter,
-		// but nonetheless we have to expect per-vertex normals.
-		aiVector3D nor;
-		if (m->mNormals) {
-			for(unsigned int a = 0; a < f.mNumIndices; ++a) {
-				nor += m->mNormals[f.mIndices[a]];
-			}
-			nor.Normalize();
-		}
+		const aiVector3D nor = GetFaceNormal(m,f);
 		mOutput << " facet normal " << nor.x << " " << nor.y << " " << nor.z << endl;
 		mOutput << "  outer loop" << endl; 
 		for(unsigned int a = 0; a < f.mNumIndices; ++a) {
@@ -109,4 +141,30 @@ void STLExporter :: WriteMesh(const aiMesh* m)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+void STLExporter :: WriteMeshBinary(const aiMesh* m)
+{
+	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
+		const aiFace& f = m->mFaces[i];
+		if (f.mNumIndices != 3) {
+			continue;
+		}
+
+		// normal and three vertices, followed by the 16 bit attribute word
+		float facet[12];
+		const aiVector3D nor = GetFaceNormal(m,f);
+		facet[0] = nor.x; 
+		facet[1] = nor.y; 
+		facet[2] = nor.z;
+		for(unsigned int a = 0; a < 3; ++a) {
+			const aiVector3D& v = m->mVertices[f.mIndices[a]];
+			facet[3+a*3+0] = v.x;
+			facet[3+a*3+1] = v.y;
+			facet[3+a*3+2] = v.z;
+		}
+		mOutput.PutLE(facet,12);
+		mOutput.PutLE(static_cast<uint16_t>(0));
+	}
+}
+
 #endif
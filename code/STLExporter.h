@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STLEXPORTER_H_INC
 #define AI_STLEXPORTER_H_INC
 
-#include <sstream>
+#include "StreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -53,28 +53,28 @@ namespace Assimp
 {
 
 // ------------------------------------------------------------------------------------------------
-/** Helper class to export a given scene to a STL file. */
+/** Helper class to export a given scene to a STL file, either in the
+ *  ASCII or in the binary (little-endian) flavour of the format. */
 // ------------------------------------------------------------------------------------------------
 class STLExporter
 {
 public:
-	/// Constructor for a specific scene to export
-	STLExporter(const char* filename, const aiScene* pScene);
-
-public:
-
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput;
+	/// Constructor for a specific scene to export, writes the file
+	STLExporter(const char* filename, IOSystem* pIOSystem, const aiScene* pScene, bool binary = false);
 
 private:
 
 	void WriteMesh(const aiMesh* m);
+	void WriteMeshBinary(const aiMesh* m);
 
 private:
 
 	const std::string filename;
 	const aiScene* const pScene;
 
+	/// buffered output to the file
+	StreamWriter mOutput;
+
 	// this endl() doesn't flush() the stream
 	const std::string endl;
 };
@@ -67,6 +67,7 @@ static const aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 STLImporter::STLImporter()
+: bSharedFaceIndices()
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -97,6 +98,13 @@ const aiImporterDesc* STLImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties
+void STLImporter::SetupProperties(const Importer* pImp)
+{
+	bSharedFaceIndices = pImp->GetPropertyInteger(AI_CONFIG_GLOB_SHARED_FACE_INDICES,0) != 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure. 
 void STLImporter::InternReadFile( const std::string& pFile, 
@@ -143,12 +151,22 @@ void STLImporter::InternReadFile( const std::string& pFile,
 	}
 	else bMatClr = LoadBinaryFile();
 
-	// now copy faces
+	// now copy faces, optionally with all indices in a single block
 	pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+	unsigned int* pIndices = NULL;
+	if (bSharedFaceIndices) {
+		pIndices = pMesh->mFaceIndices = new unsigned int[pMesh->mNumFaces*3];
+	}
 	for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces;++i)	{
 
 		aiFace& face = pMesh->mFaces[i];
-		face.mIndices = new unsigned int[face.mNumIndices = 3];
+		face.mNumIndices = 3;
+		if (pIndices) {
+			face.mIndices = pIndices;
+			pIndices += 3;
+		}
+		else face.mIndices = new unsigned int[3];
+
 		for (unsigned int o = 0; o < 3;++o,++p) {
 			face.mIndices[o] = p;
 		}
@@ -218,6 +236,9 @@ void STLImporter::LoadASCIIFile()
 			if (3 != curVertex) {
 				DefaultLogger::get()->warn("STL: A new facet begins but the old is not yet complete");
 			}
+			if (!(curFace & 0xfff)) {
+				UpdateImporterProgress(ProgressHandler::Phase_Parse,(unsigned int)(sz-mBuffer),fileSize);
+			}
 			if (pMesh->mNumFaces == curFace)	{
 				ai_assert(pMesh->mNumFaces != 0);
 
@@ -349,6 +370,9 @@ bool STLImporter::LoadBinaryFile()
 	vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
 	for (unsigned int i = 0; i < pMesh->mNumFaces;++i)	{
+		if (!(i & 0x3fff)) {
+			UpdateImporterProgress(ProgressHandler::Phase_Parse,i,pMesh->mNumFaces);
+		}
 
 		// NOTE: Blender sometimes writes empty normals ... this is not
 		// our fault ... the RemoveInvalidData helper step should fix that
@@ -68,6 +68,13 @@ public:
 	bool CanRead( const std::string& pFile, IOSystem* pIOHandler,
 		bool checkSig) const;
 
+	// -------------------------------------------------------------------
+	/** Called prior to ReadFile().
+	 * The function is a request to the importer to update its configuration
+	 * basing on the Importer's configuration property list.
+	 */
+	void SetupProperties(const Importer* pImp);
+
 protected:
 
 	// -------------------------------------------------------------------
@@ -108,6 +115,9 @@ protected:
 
 	/** Default vertex color */
 	aiColor4D clrColorDefault;
+
+	/** Store the face indices in a single array per mesh */
+	bool bSharedFaceIndices;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,573 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SceneArena.cpp
+ *  Implementation of the SceneArena allocator and of the functions to move a 
+ *  scene into an arena and back.
+ */
+
+#include "AssimpPCH.h"
+#include "SceneArena.h"
+#include "ScenePrivate.h"
+#include "ProcessHelper.h"
+
+using namespace Assimp;
+
+// Alignment of all memory handed out by SceneArena, suitable for SSE loads
+#define AI_SCENEARENA_ALIGNMENT 16
+
+// ------------------------------------------------------------------------------------------------
+SceneArena::SceneArena()
+	: pos()
+	, used()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+SceneArena::~SceneArena()
+{
+	Clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void* SceneArena::Allocate(size_t size)
+{
+	// never hand out the same address twice, even for empty arrays
+	size = std::max(size,static_cast<size_t>(1));
+
+	if (!blocks.empty()) {
+		const Block& b = blocks.back();
+
+		// new[] makes no promises beyond the alignment of the largest builtin type,
+		// so align relative to the real address.
+		const size_t misalign = reinterpret_cast<uintptr_t>(b.data + pos) % AI_SCENEARENA_ALIGNMENT;
+		const size_t pad = misalign ? AI_SCENEARENA_ALIGNMENT - misalign : 0;
+
+		if (pos + pad + size <= b.size) {
+			void* const p = b.data + pos + pad;
+			pos  += pad + size;
+			used += pad + size;
+			return p;
+		}
+	}
+
+	// start a new block, at least twice as large as the previous one
+	Block b;
+	b.size = std::max(blocks.empty() ? static_cast<size_t>(AI_SCENEARENA_MIN_BLOCK_SIZE) : blocks.back().size * 2,
+		size + AI_SCENEARENA_ALIGNMENT);
+	b.data = new char[b.size];
+
+	blocks.push_back(b);
+	pos = 0;
+	return Allocate(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::Reset()
+{
+	if (blocks.size() > 1) {
+		// replace all blocks by a single one which is large enough to hold 
+		// everything which has been allocated so far.
+		const size_t total = GetCapacity();
+		Clear();
+
+		Block b;
+		b.size = total;
+		b.data = new char[b.size];
+		blocks.push_back(b);
+	}
+	pos = used = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneArena::Clear()
+{
+	for (std::vector<Block>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+		delete[] (*it).data;
+	}
+	blocks.clear();
+	pos = used = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t SceneArena::GetCapacity() const
+{
+	size_t total = 0;
+	for (std::vector<Block>::const_iterator it = blocks.begin(); it != blocks.end(); ++it) {
+		total += (*it).size;
+	}
+	return total;
+}
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Allocation policy for CopySceneToHeap(). Produces data the destructors of 
+// the aiScene hierarchy can free.
+struct HeapPolicy
+{
+	template <typename T>
+	T* New() {
+		return new T();
+	}
+
+	template <typename T>
+	T* NewArray(size_t num) {
+		return new T[num];
+	}
+
+	aiMaterial* NewMaterial(unsigned int numProperties) {
+		aiMaterial* mat = new aiMaterial();
+
+		// leave some room for the user to add properties
+		if (numProperties > mat->mNumAllocated) {
+			delete[] mat->mProperties;
+			mat->mNumAllocated = numProperties;
+			mat->mProperties = new aiMaterialProperty*[numProperties];
+		}
+		return mat;
+	}
+
+	aiMetadata* CopyMetadata(const aiMetadata* src) {
+		return aiMetadata::Copy(src);
+	}
+
+	void CopyFaces(aiMesh* dest, const aiMesh* src) {
+		dest->mFaces = new aiFace[src->mNumFaces];
+
+		// keep the index layout of the source, see aiMesh::mFaceIndices
+		for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+			dest->mFaces[i].mNumIndices = src->mFaces[i].mNumIndices;
+		}
+		AllocateFaceIndices(dest,src->HasSharedFaceIndices());
+		for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+			std::copy(src->mFaces[i].mIndices,src->mFaces[i].mIndices+src->mFaces[i].mNumIndices,dest->mFaces[i].mIndices);
+		}
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+// Allocation policy for CopySceneToArena(). Except for the scene's private 
+// data, everything is taken from the arena and no destructor is ever called.
+struct ArenaPolicy
+{
+	ArenaPolicy(SceneArena& arena)
+		: arena(arena)
+	{}
+
+	template <typename T>
+	T* New() {
+		return new (arena.Allocate(sizeof(T))) T();
+	}
+
+	template <typename T>
+	T* NewArray(size_t num) {
+		return arena.AllocateArray<T>(num);
+	}
+
+	aiMaterial* NewMaterial(unsigned int numProperties) {
+		aiMaterial* mat = New<aiMaterial>();
+
+		// the material constructor reserves some heap memory, replace it
+		delete[] mat->mProperties;
+		mat->mNumAllocated = numProperties;
+		mat->mProperties = numProperties ? NewArray<aiMaterialProperty*>(numProperties) : NULL;
+		return mat;
+	}
+
+	aiMetadata* CopyMetadata(const aiMetadata* src) {
+		aiMetadata* dest = New<aiMetadata>();
+
+		const unsigned int num = dest->mNumProperties = src->mNumProperties;
+		if (!num) {
+			return dest;
+		}
+		dest->mKeys = NewArray<aiString>(num);
+		std::copy(src->mKeys,src->mKeys+num,dest->mKeys);
+
+		dest->mValues = NewArray<aiMetadataEntry>(num);
+		for (unsigned int i = 0; i < num; ++i) {
+			const aiMetadataEntry& in = src->mValues[i];
+			dest->mValues[i].mType = in.mType;
+			dest->mValues[i].mData = in.mData ? CopyValue(in) : NULL;
+		}
+		return dest;
+	}
+
+	void CopyFaces(aiMesh* dest, const aiMesh* src) {
+		aiFace* const faces = dest->mFaces = NewArray<aiFace>(src->mNumFaces);
+
+		// one contiguous block for all faces of the mesh. It is exposed as 
+		// aiMesh::mFaceIndices only if the source shares its indices, too,
+		// so copying the scene back to the heap keeps the original layout.
+		size_t total = 0;
+		for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+			total += src->mFaces[i].mNumIndices;
+		}
+
+		unsigned int* out = total ? NewArray<unsigned int>(total) : NULL;
+		if (src->HasSharedFaceIndices()) {
+			dest->mFaceIndices = out;
+		}
+		for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+			const aiFace& face = src->mFaces[i];
+			faces[i].mNumIndices = face.mNumIndices;
+			faces[i].mIndices = NULL;
+			if (face.mNumIndices) {
+				faces[i].mIndices = out;
+				out = std::copy(face.mIndices,face.mIndices+face.mNumIndices,out);
+			}
+		}
+	}
+
+private:
+
+	template <typename T>
+	void* NewValue(const void* value) {
+		return new (arena.Allocate(sizeof(T))) T(*static_cast<const T*>(value));
+	}
+
+	void* CopyValue(const aiMetadataEntry& in) {
+		switch (in.mType)
+		{
+		case AI_BOOL:       return NewValue<bool>(in.mData);
+		case AI_INT:        return NewValue<int>(in.mData);
+		case AI_UINT64:     return NewValue<ai_uint64>(in.mData);
+		case AI_FLOAT:      return NewValue<float>(in.mData);
+		case AI_AISTRING:   return NewValue<aiString>(in.mData);
+		case AI_AIVECTOR3D: return NewValue<aiVector3D>(in.mData);
+		default: return NULL;
+		}
+	}
+
+	SceneArena& arena;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Deep copy of a scene, the Policy decides where the memory comes from.
+template <class Policy>
+class SceneCopier
+{
+public:
+
+	SceneCopier(Policy& policy)
+		: policy(policy)
+	{}
+
+public:
+
+	// ----------------------------------------------------------------------
+	aiScene* Copy(const aiScene* src) {
+		aiScene* dest = policy.template New<aiScene>();
+		dest->mFlags = src->mFlags;
+
+		dest->mNumMeshes = src->mNumMeshes;
+		dest->mMeshes = CopyPtrArray(src->mMeshes,src->mNumMeshes);
+
+		dest->mNumMaterials = src->mNumMaterials;
+		dest->mMaterials = CopyPtrArray(src->mMaterials,src->mNumMaterials);
+
+		dest->mNumAnimations = src->mNumAnimations;
+		dest->mAnimations = CopyPtrArray(src->mAnimations,src->mNumAnimations);
+
+		dest->mNumTextures = src->mNumTextures;
+		dest->mTextures = CopyPtrArray(src->mTextures,src->mNumTextures);
+
+		dest->mNumLights = src->mNumLights;
+		dest->mLights = CopyPtrArray(src->mLights,src->mNumLights);
+
+		dest->mNumCameras = src->mNumCameras;
+		dest->mCameras = CopyPtrArray(src->mCameras,src->mNumCameras);
+
+		if (src->mRootNode) {
+			dest->mRootNode = Copy(src->mRootNode,NULL);
+		}
+
+		// keep the post-processing state and the owning importer, if any. 
+		if (ScenePriv(src)) {
+			*ScenePriv(dest) = *ScenePriv(src);
+		}
+		return dest;
+	}
+
+private:
+
+	// ----------------------------------------------------------------------
+	template <typename T>
+	T* CopyArray(const T* src, size_t num) {
+		if (!src || !num) {
+			return NULL;
+		}
+		T* const dest = policy.template NewArray<T>(num);
+		std::copy(src,src+num,dest);
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	template <typename T>
+	T** CopyPtrArray(T* const* src, unsigned int num) {
+		if (!src || !num) {
+			return NULL;
+		}
+		T** const dest = policy.template NewArray<T*>(num);
+		for (unsigned int i = 0; i < num; ++i) {
+			dest[i] = Copy(src[i]);
+		}
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiNode* Copy(const aiNode* src, aiNode* parent) {
+		aiNode* dest = policy.template New<aiNode>();
+		dest->mName = src->mName;
+		dest->mTransformation = src->mTransformation;
+		dest->mParent = parent;
+
+		dest->mNumMeshes = src->mNumMeshes;
+		dest->mMeshes = CopyArray(src->mMeshes,src->mNumMeshes);
+
+		if (src->mMetaData) {
+			dest->mMetaData = policy.CopyMetadata(src->mMetaData);
+		}
+
+		dest->mNumChildren = src->mNumChildren;
+		if (src->mChildren && src->mNumChildren) {
+			dest->mChildren = policy.template NewArray<aiNode*>(src->mNumChildren);
+			for (unsigned int i = 0; i < src->mNumChildren; ++i) {
+				dest->mChildren[i] = Copy(src->mChildren[i],dest);
+			}
+		}
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiMesh* Copy(const aiMesh* src) {
+		aiMesh* dest = policy.template New<aiMesh>();
+		dest->mName = src->mName;
+		dest->mPrimitiveTypes = src->mPrimitiveTypes;
+		dest->mMaterialIndex = src->mMaterialIndex;
+
+		const unsigned int nv = dest->mNumVertices = src->mNumVertices;
+		dest->mVertices   = CopyArray(src->mVertices,nv);
+		dest->mNormals    = CopyArray(src->mNormals,nv);
+		dest->mTangents   = CopyArray(src->mTangents,nv);
+		dest->mBitangents = CopyArray(src->mBitangents,nv);
+
+		for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+			dest->mColors[i] = CopyArray(src->mColors[i],nv);
+		}
+		for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+			dest->mTextureCoords[i] = CopyArray(src->mTextureCoords[i],nv);
+			dest->mNumUVComponents[i] = src->mNumUVComponents[i];
+		}
+
+		dest->mNumFaces = src->mNumFaces;
+		if (src->mFaces && src->mNumFaces) {
+			policy.CopyFaces(dest,src);
+		}
+
+		dest->mNumBones = src->mNumBones;
+		dest->mBones = CopyPtrArray(src->mBones,src->mNumBones);
+
+		dest->mNumAnimMeshes = src->mNumAnimMeshes;
+		dest->mAnimMeshes = CopyPtrArray(src->mAnimMeshes,src->mNumAnimMeshes);
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiAnimMesh* Copy(const aiAnimMesh* src) {
+		aiAnimMesh* dest = policy.template New<aiAnimMesh>();
+
+		const unsigned int nv = dest->mNumVertices = src->mNumVertices;
+		dest->mVertices   = CopyArray(src->mVertices,nv);
+		dest->mNormals    = CopyArray(src->mNormals,nv);
+		dest->mTangents   = CopyArray(src->mTangents,nv);
+		dest->mBitangents = CopyArray(src->mBitangents,nv);
+
+		for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+			dest->mColors[i] = CopyArray(src->mColors[i],nv);
+		}
+		for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+			dest->mTextureCoords[i] = CopyArray(src->mTextureCoords[i],nv);
+		}
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiBone* Copy(const aiBone* src) {
+		aiBone* dest = policy.template New<aiBone>();
+		dest->mName = src->mName;
+		dest->mOffsetMatrix = src->mOffsetMatrix;
+		dest->mNumWeights = src->mNumWeights;
+		dest->mWeights = CopyArray(src->mWeights,src->mNumWeights);
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiMaterial* Copy(const aiMaterial* src) {
+		aiMaterial* dest = policy.NewMaterial(src->mNumProperties);
+		dest->mNumProperties = src->mNumProperties;
+
+		for (unsigned int i = 0; i < src->mNumProperties; ++i) {
+			const aiMaterialProperty* sprop = src->mProperties[i];
+			aiMaterialProperty* prop = dest->mProperties[i] = policy.template New<aiMaterialProperty>();
+
+			prop->mKey = sprop->mKey;
+			prop->mSemantic = sprop->mSemantic;
+			prop->mIndex = sprop->mIndex;
+			prop->mType = sprop->mType;
+			prop->mDataLength = sprop->mDataLength;
+			prop->mData = CopyArray(sprop->mData,sprop->mDataLength);
+		}
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiTexture* Copy(const aiTexture* src) {
+		aiTexture* dest = policy.template New<aiTexture>();
+		dest->mWidth = src->mWidth;
+		dest->mHeight = src->mHeight;
+		std::copy(src->achFormatHint,src->achFormatHint+sizeof(src->achFormatHint),dest->achFormatHint);
+
+		// compressed textures store mWidth bytes of data
+		const size_t num = src->mHeight ? src->mWidth*src->mHeight 
+			: (src->mWidth + sizeof(aiTexel) - 1) / sizeof(aiTexel);
+
+		dest->pcData = CopyArray(src->pcData,num);
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiAnimation* Copy(const aiAnimation* src) {
+		aiAnimation* dest = policy.template New<aiAnimation>();
+		dest->mName = src->mName;
+		dest->mDuration = src->mDuration;
+		dest->mTicksPerSecond = src->mTicksPerSecond;
+
+		dest->mNumChannels = src->mNumChannels;
+		dest->mChannels = CopyPtrArray(src->mChannels,src->mNumChannels);
+
+		dest->mNumMeshChannels = src->mNumMeshChannels;
+		dest->mMeshChannels = CopyPtrArray(src->mMeshChannels,src->mNumMeshChannels);
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiNodeAnim* Copy(const aiNodeAnim* src) {
+		aiNodeAnim* dest = policy.template New<aiNodeAnim>();
+		dest->mNodeName = src->mNodeName;
+		dest->mPreState = src->mPreState;
+		dest->mPostState = src->mPostState;
+
+		dest->mNumPositionKeys = src->mNumPositionKeys;
+		dest->mPositionKeys = CopyArray(src->mPositionKeys,src->mNumPositionKeys);
+
+		dest->mNumRotationKeys = src->mNumRotationKeys;
+		dest->mRotationKeys = CopyArray(src->mRotationKeys,src->mNumRotationKeys);
+
+		dest->mNumScalingKeys = src->mNumScalingKeys;
+		dest->mScalingKeys = CopyArray(src->mScalingKeys,src->mNumScalingKeys);
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiMeshAnim* Copy(const aiMeshAnim* src) {
+		aiMeshAnim* dest = policy.template New<aiMeshAnim>();
+		dest->mName = src->mName;
+		dest->mNumKeys = src->mNumKeys;
+		dest->mKeys = CopyArray(src->mKeys,src->mNumKeys);
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiLight* Copy(const aiLight* src) {
+		aiLight* dest = policy.template New<aiLight>();
+		*dest = *src;
+		return dest;
+	}
+
+	// ----------------------------------------------------------------------
+	aiCamera* Copy(const aiCamera* src) {
+		aiCamera* dest = policy.template New<aiCamera>();
+		*dest = *src;
+		return dest;
+	}
+
+private:
+
+	Policy& policy;
+};
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+aiScene* Assimp::CopySceneToArena(const aiScene* src, SceneArena& arena)
+{
+	ai_assert(NULL != src);
+
+	ArenaPolicy policy(arena);
+	aiScene* dest = SceneCopier<ArenaPolicy>(policy).Copy(src);
+
+	ScenePriv(dest)->mArena = &arena;
+	return dest;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene* Assimp::CopySceneToHeap(const aiScene* src)
+{
+	ai_assert(NULL != src);
+
+	HeapPolicy policy;
+	aiScene* dest = SceneCopier<HeapPolicy>(policy).Copy(src);
+
+	ScenePriv(dest)->mArena = NULL;
+	return dest;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::DestroyArenaScene(aiScene* scene)
+{
+	ai_assert(NULL != scene && ScenePriv(scene)->mArena);
+
+	// the private data is the only part of the scene not allocated from the
+	// arena. Everything else is released when the arena is reset.
+	delete ScenePriv(scene);
+	scene->mPrivate = NULL;
+}
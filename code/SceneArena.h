@@ -0,0 +1,151 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SceneArena.h
+ *  Declares the arena allocator used by Importer to keep the imported scene in 
+ *  a few large memory blocks (#AI_CONFIG_GLOB_SCENE_POOL).
+ */
+#ifndef AI_SCENEARENA_H_INC
+#define AI_SCENEARENA_H_INC
+
+struct aiScene;
+
+namespace Assimp	{
+
+// Minimum size of an arena block, in bytes
+#define AI_SCENEARENA_MIN_BLOCK_SIZE (64 * 1024)
+
+// ---------------------------------------------------------------------------
+/** Growable bump allocator. Memory is taken from large blocks and never freed
+ *  individually, Reset() makes all of it available again at once. After a 
+ *  Reset() the arena keeps a single block as large as all memory used so far,
+ *  so importing files of similar size does not allocate anymore.
+ *
+ *  The arena is only used explicitly by CopySceneToArena(), the scene data 
+ *  structures themselves know nothing about it. It is not thread-safe, each
+ *  Importer owns its own instance. */
+class SceneArena
+{
+public:
+
+	SceneArena();
+	~SceneArena();
+
+
+	// -------------------------------------------------------------------
+	/** Get a memory area of at least the given size, aligned to 16 bytes.
+	 *  The memory is not initialized. */
+	void* Allocate(size_t size);
+
+	// -------------------------------------------------------------------
+	/** Get uninitialized storage for an array of num elements of type T. 
+	 *  Only valid for types whose destructors need not be called. */
+	template <typename T>
+	T* AllocateArray(size_t num) {
+		return static_cast<T*>(Allocate(sizeof(T)*num));
+	}
+
+	// -------------------------------------------------------------------
+	/** Mark all memory as unused. Previously returned pointers become 
+	 *  invalid, no destructors are called. */
+	void Reset();
+
+	// -------------------------------------------------------------------
+	/** Release all memory blocks */
+	void Clear();
+
+	// -------------------------------------------------------------------
+	/** Get the total size of all blocks owned by the arena, in bytes */
+	size_t GetCapacity() const;
+
+	// -------------------------------------------------------------------
+	/** Get the number of bytes handed out since the last Reset() */
+	size_t GetUsed() const {
+		return used;
+	}
+
+private:
+
+	struct Block	{
+		char* data;
+		size_t size;
+	};
+
+	std::vector<Block> blocks;
+
+	// offset of the first free byte in the last block
+	size_t pos;
+
+	// bytes handed out since the last reset, including padding
+	size_t used;
+
+private:
+
+	SceneArena(const SceneArena&);
+	SceneArena& operator= (const SceneArena&);
+};
+
+// ---------------------------------------------------------------------------
+/** Make a deep copy of a scene which lives entirely in an arena, except for
+ *  the scene's private data. The face indices of each mesh are stored in a 
+ *  single block. The copy must be released using DestroyArenaScene(), 
+ *  never with delete.
+ *  @param src Scene to be copied, a regular heap-allocated scene
+ *  @param arena Arena to allocate the copy from
+ *  @return Copy of the scene */
+aiScene* CopySceneToArena(const aiScene* src, SceneArena& arena);
+
+// ---------------------------------------------------------------------------
+/** Make a regular, heap-allocated deep copy of a scene. Handles all data in
+ *  the scene, including vertex animations, mesh animation channels and
+ *  node metadata.
+ *  @param src Scene to be copied, typically a pooled scene
+ *  @return Copy of the scene, to be deleted using the delete operator */
+aiScene* CopySceneToHeap(const aiScene* src);
+
+// ---------------------------------------------------------------------------
+/** Release the parts of a scene created by CopySceneToArena() which do not
+ *  live in the arena. The rest becomes invalid with the next 
+ *  SceneArena::Reset(). */
+void DestroyArenaScene(aiScene* scene);
+
+} // end of namespace Assimp
+
+#endif // AI_SCENEARENA_H_INC
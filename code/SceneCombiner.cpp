@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // ----------------------------------------------------------------------------
 #include "AssimpPCH.h"
 #include "SceneCombiner.h"
+#include "ProcessHelper.h"
 #include "fast_atof.h"
 #include "Hash.h"
 #include "time.h"
@@ -524,6 +525,12 @@ void SceneCombiner::MergeScenes(aiScene** _dest, aiScene* master,
 					}
 					PrefixString(mesh->mBones[a]->mName,(*cur).id,(*cur).idlen);
 				}
+
+				// vertex animation channels refer to meshes by name. Mesh
+				// names aren't hashed, so always rename animated meshes.
+				if (mesh->mNumAnimMeshes) {
+					PrefixString(mesh->mName,(*cur).id,(*cur).idlen);
+				}
 			}
 		}
 
@@ -580,6 +587,12 @@ void SceneCombiner::MergeScenes(aiScene** _dest, aiScene* master,
 
 			// Add name prefixes?
 			if (flags & AI_INT_MERGE_SCENE_GEN_UNIQUE_NAMES) {
+
+				// mesh animation channels must match the mesh names, see above
+				for (unsigned int a = 0; a < (*ppAnims)->mNumMeshChannels;++a) {
+					PrefixString((*ppAnims)->mMeshChannels[a]->mName,(*cur).id,(*cur).idlen);
+				}
+
 				if (flags & AI_INT_MERGE_SCENE_GEN_UNIQUE_NAMES_IF_NECESSARY) {
 					if (!FindNameMatch((*ppAnims)->mName,src,n))
 						continue;
@@ -849,23 +862,26 @@ void SceneCombiner::MergeMeshes(aiMesh** _out,unsigned int /*flags*/,
 
 	if (out->mNumFaces) // just for safety
 	{
-		// copy faces
+		// copy faces, with the indices of all of them in a single block if the first input mesh shares its indices
 		out->mFaces = new aiFace[out->mNumFaces];
 		aiFace* pf2 = out->mFaces;
 
+		for (std::vector<aiMesh*>::const_iterator it = begin; it != end;++it)	{
+			for (unsigned int m = 0; m < (*it)->mNumFaces;++m,++pf2)	{
+				pf2->mNumIndices = (*it)->mFaces[m].mNumIndices;
+			}
+		}
+		AllocateFaceIndices(out,(*begin)->HasSharedFaceIndices());
+
+		pf2 = out->mFaces;
 		unsigned int ofs = 0;
 		for (std::vector<aiMesh*>::const_iterator it = begin; it != end;++it)	{
 			for (unsigned int m = 0; m < (*it)->mNumFaces;++m,++pf2)	{
-				aiFace& face = (*it)->mFaces[m];
-				pf2->mNumIndices = face.mNumIndices;
-				pf2->mIndices = face.mIndices;
-
-				if (ofs)	{
-					// add the offset to the vertex
-					for (unsigned int q = 0; q < face.mNumIndices; ++q)
-						face.mIndices[q] += ofs;	
-				}
-				face.mIndices = NULL;
+				const aiFace& face = (*it)->mFaces[m];
+
+				// add the offset to the vertex
+				for (unsigned int q = 0; q < face.mNumIndices; ++q)
+					pf2->mIndices[q] = face.mIndices[q] + ofs;	
 			}
 			ofs += (*it)->mNumVertices;
 		}
@@ -997,12 +1013,33 @@ void SceneCombiner::Copy     (aiMesh** _dest, const aiMesh* src)
 	// make a deep copy of all bones
 	CopyPtrArray(dest->mBones,dest->mBones,dest->mNumBones);
 
+	// and of all vertex animation attachments
+	CopyPtrArray(dest->mAnimMeshes,src->mAnimMeshes,dest->mNumAnimMeshes);
+
 	// make a deep copy of all faces
 	GetArrayCopy(dest->mFaces,dest->mNumFaces);
-	for (unsigned int i = 0; i < dest->mNumFaces;++i)
+	if (src->HasSharedFaceIndices() && dest->mFaces)
+	{
+		// keep the indices in a single block
+		dest->mFaceIndices = NULL;
+		for (unsigned int i = 0; i < dest->mNumFaces;++i)
+			dest->mFaces[i].mIndices = NULL;
+
+		dest->PackFaceIndices();
+		for (unsigned int i = 0; i < dest->mNumFaces;++i)
+		{
+			aiFace& f = dest->mFaces[i];
+			::memcpy(f.mIndices,src->mFaces[i].mIndices,f.mNumIndices*sizeof(unsigned int));
+		}
+	}
+	else 
 	{
-		aiFace& f = dest->mFaces[i];
-		GetArrayCopy(f.mIndices,f.mNumIndices);
+		dest->mFaceIndices = NULL;
+		for (unsigned int i = 0; i < dest->mNumFaces;++i)
+		{
+			aiFace& f = dest->mFaces[i];
+			GetArrayCopy(f.mIndices,f.mNumIndices);
+		}
 	}
 }
 
@@ -1073,6 +1110,7 @@ void SceneCombiner::Copy     (aiAnimation** _dest, const aiAnimation* src)
 
 	// and reallocate all arrays
 	CopyPtrArray( dest->mChannels, src->mChannels, dest->mNumChannels );
+	CopyPtrArray( dest->mMeshChannels, src->mMeshChannels, dest->mNumMeshChannels );
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1091,6 +1129,43 @@ void SceneCombiner::Copy     (aiNodeAnim** _dest, const aiNodeAnim* src)
 	GetArrayCopy( dest->mRotationKeys, dest->mNumRotationKeys );
 }
 
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy     (aiMeshAnim** _dest, const aiMeshAnim* src)
+{
+	ai_assert(NULL != _dest && NULL != src);
+
+	aiMeshAnim* dest = *_dest = new aiMeshAnim();
+
+	// get a flat copy
+	::memcpy(dest,src,sizeof(aiMeshAnim));
+
+	// and reallocate all arrays
+	GetArrayCopy( dest->mKeys, dest->mNumKeys );
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy     (aiAnimMesh** _dest, const aiAnimMesh* src)
+{
+	ai_assert(NULL != _dest && NULL != src);
+
+	aiAnimMesh* dest = *_dest = new aiAnimMesh();
+
+	// get a flat copy
+	::memcpy(dest,src,sizeof(aiAnimMesh));
+
+	// and reallocate all arrays
+	GetArrayCopy( dest->mVertices,   dest->mNumVertices );
+	GetArrayCopy( dest->mNormals ,   dest->mNumVertices );
+	GetArrayCopy( dest->mTangents,   dest->mNumVertices );
+	GetArrayCopy( dest->mBitangents, dest->mNumVertices );
+
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n)
+		GetArrayCopy( dest->mTextureCoords[n], dest->mNumVertices );
+
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n)
+		GetArrayCopy( dest->mColors[n], dest->mNumVertices );
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy   (aiCamera** _dest,const  aiCamera* src)
 {
@@ -1140,6 +1215,10 @@ void SceneCombiner::Copy     (aiNode** _dest, const aiNode* src)
 	// and reallocate all arrays
 	GetArrayCopy( dest->mMeshes, dest->mNumMeshes );
 	CopyPtrArray( dest->mChildren, src->mChildren,dest->mNumChildren);
+
+	if (src->mMetaData) {
+		dest->mMetaData = aiMetadata::Copy(src->mMetaData);
+	}
 }
 
 
@@ -47,12 +47,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace Assimp	{
 
 	class Importer;
+	class SceneArena;
 
 struct ScenePrivateData {
 	
 	ScenePrivateData()
 		: mOrigImporter()
 		, mPPStepsApplied()
+		, mArena()
 	{}
 
 	// Importer that originally loaded the scene though the C-API
@@ -61,6 +63,10 @@ struct ScenePrivateData {
 
 	// List of postprocessing steps already applied to the scene.
 	unsigned int mPPStepsApplied;
+
+	// Arena the scene has been allocated from (see CopySceneToArena()). 
+	// NULL for regular scenes, which are released using delete.
+	SceneArena* mArena;
 };
 
 // Access private data stored in the scene
@@ -0,0 +1,125 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file  SkinningStream.cpp
+ *  @brief Implementation of the Assimp::SkinningStream class.
+ */
+
+#include "AssimpPCH.h"
+#include "../include/assimp/SkinningStream.hpp"
+#include "VertexInfluences.h"
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Sorts bone influences by descending weight
+bool IsHeavierInfluence(const VertexInfluences::Influence& a, const VertexInfluences::Influence& b)
+{
+	return a.mWeight > b.mWeight;
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+SkinningStream::SkinningStream(const aiMesh* pMesh, unsigned int pNumInfluences)
+: mNumVertices()
+, mNumInfluences(pNumInfluences)
+, mNumDropped()
+, mIndices()
+, mWeights()
+{
+	ai_assert(NULL != pMesh && pNumInfluences && pMesh->mNumBones <= 0x10000);
+	if (!pMesh->mNumVertices) {
+		return;
+	}
+
+	VertexInfluences influences(pMesh);
+
+	mNumVertices = pMesh->mNumVertices;
+	mIndices = new unsigned short[mNumVertices * mNumInfluences];
+	mWeights = new unsigned short[mNumVertices * mNumInfluences];
+
+	unsigned short* outIndices = mIndices;
+	unsigned short* outWeights = mWeights;
+	for (unsigned int v = 0; v < mNumVertices; ++v, outIndices += mNumInfluences, outWeights += mNumInfluences) {
+		VertexInfluences::Influence* inf = influences.GetInfluences(v);
+		unsigned int count = influences.GetNumInfluences(v);
+
+		// keep the most important influences only
+		if (count > mNumInfluences) {
+			std::sort(inf, inf + count, &IsHeavierInfluence);
+			mNumDropped += count - mNumInfluences;
+			count = mNumInfluences;
+		}
+
+		float sum = 0.f;
+		for (unsigned int i = 0; i < count; ++i) {
+			sum += inf[i].mWeight;
+		}
+
+		// quantize the normalized weights and put the rounding error on the largest one
+		unsigned int total = 0, largest = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			const float w = sum > 0.f ? inf[i].mWeight / sum : 0.f;
+
+			outIndices[i] = static_cast<unsigned short>(inf[i].mBone);
+			outWeights[i] = static_cast<unsigned short>(std::min(std::max(w,0.f),1.f) * 65535.f + 0.5f);
+			total += outWeights[i];
+			if (outWeights[i] > outWeights[largest]) {
+				largest = i;
+			}
+		}
+		if (total) {
+			outWeights[largest] = static_cast<unsigned short>(outWeights[largest] + 65535 - static_cast<int>(total));
+		}
+
+		for (unsigned int i = count; i < mNumInfluences; ++i) {
+			outIndices[i] = outWeights[i] = 0;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+SkinningStream::~SkinningStream()
+{
+	delete[] mIndices;
+	delete[] mWeights;
+}
@@ -234,6 +234,15 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
 
 			out->mNumVertices = (3 == real ? numPolyVerts : out->mNumFaces * (real+1));
 
+			// the output is unindexed, so there is one index per vertex. Meshes
+			// with shared indices keep them in a single block, others take over
+			// the index arrays of the input faces.
+			const bool shared = mesh->HasSharedFaceIndices();
+			unsigned int* outIndices = NULL;
+			if (shared) {
+				outIndices = out->mFaceIndices = new unsigned int[out->mNumVertices];
+			}
+
 			aiVector3D *vert(NULL), *nor(NULL), *tan(NULL), *bit(NULL);
 			aiVector3D *uv   [AI_MAX_NUMBER_OF_TEXTURECOORDS];
 			aiColor4D  *cols [AI_MAX_NUMBER_OF_COLOR_SETS];
@@ -266,6 +275,9 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
 				else cols[i] = NULL;
 			}
 
+			// source vertex for each output vertex, needed to split the anim meshes
+			std::vector<unsigned int> sourceIndex(mesh->mNumAnimMeshes ? out->mNumVertices : 0);
+
 			typedef std::vector< aiVertexWeight > TempBoneInfo;
 			std::vector< TempBoneInfo > tempBones(mesh->mNumBones);
 
@@ -285,7 +297,11 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
 				}
 				
 				outFaces->mNumIndices = in.mNumIndices;
-				outFaces->mIndices    = in.mIndices;
+				if (shared) {
+					outFaces->mIndices = outIndices;
+					outIndices += in.mNumIndices;
+				}
+				else outFaces->mIndices = in.mIndices;
 
 				for (unsigned int q = 0; q < in.mNumIndices; ++q)
 				{
@@ -326,14 +342,24 @@ void SortByPTypeProcess::Execute( aiScene* pScene)
 						*cols[pp]++ = mesh->mColors[pp][idx];
 					}
 
-					in.mIndices[q] = outIdx++;
+					if (!sourceIndex.empty()) {
+						sourceIndex[outIdx] = idx;
+					}
+					outFaces->mIndices[q] = outIdx++;
 				}
 
-				in.mIndices = NULL;
+				if (!shared) {
+					in.mIndices = NULL;
+				}
 				++outFaces;
 			}
 			ai_assert(outFaces == out->mFaces + out->mNumFaces);
 
+			// the anim meshes are split like the mesh itself
+			if (!sourceIndex.empty()) {
+				RemapAnimMeshes(out,mesh,&sourceIndex[0]);
+			}
+
 			// now generate output bones
 			for (unsigned int q = 0; q < mesh->mNumBones;++q)
 				if (!tempBones[q].empty())++out->mNumBones;
@@ -46,17 +46,201 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers of the post-processing framework
 #include "SplitByBoneCountProcess.h"
+#include "VertexInfluences.h"
+#include "ProcessHelper.h"
 
 #include <limits>
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// A set of bones, one bit per bone of the source mesh
+typedef std::vector<uint32_t> BoneSet;
+
+// Counts the bones in a set
+inline size_t CountBones( const BoneSet& a)
+{
+	size_t count = 0;
+	for( size_t i = 0; i < a.size(); ++i)
+	{
+		for( uint32_t bits = a[i]; bits; bits &= bits - 1)
+			++count;
+	}
+	return count;
+}
+
+// Counts the bones in b which are not part of a
+inline size_t CountNewBones( const BoneSet& a, const BoneSet& b)
+{
+	size_t count = 0;
+	for( size_t i = 0; i < a.size(); ++i)
+	{
+		for( uint32_t bits = b[i] & ~a[i]; bits; bits &= bits - 1)
+			++count;
+	}
+	return count;
+}
+
+// All faces affected by the very same set of bones
+struct FaceGroup
+{
+	BoneSet bones;
+	size_t numBones;
+	std::vector<size_t> faces;
+};
+
+// A submesh-to-be: groups whose bones fit into the limit together
+struct FaceBin
+{
+	BoneSet bones;
+	size_t numBones;
+	std::vector<size_t> groups;
+};
+
+// Orders groups by descending bone count, then by their first face
+struct GroupOrder
+{
+	GroupOrder( const std::vector<FaceGroup>& pGroups) : groups( pGroups) {}
+
+	bool operator() ( size_t a, size_t b) const
+	{
+		if( groups[a].numBones != groups[b].numBones )
+			return groups[a].numBones > groups[b].numBones;
+		return groups[a].faces[0] < groups[b].faces[0];
+	}
+
+	const std::vector<FaceGroup>& groups;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Partitions the faces of a mesh into sets which each use at most pMaxBones bones. 
+//
+// Faces affected by the same bones are grouped first. The groups are then packed into bins,
+// largest bone sets first, each group going to the bin it shares most bones with (best fit
+// decreasing). Finally bins are merged where their bones still fit together. The faces of each
+// partition are returned in their original order. A face affected by more than pMaxBones bones
+// can't be split, it ends up in a partition of its own and exceeds the limit.
+void PartitionFaces( const aiMesh* pMesh, const VertexInfluences& pInfluences, size_t pMaxBones, 
+	std::vector< std::vector<size_t> >& poPartitions)
+{
+	const size_t numWords = (pMesh->mNumBones + 31) / 32;
+
+	// build the bone set of each face and group faces with identical sets
+	std::vector<FaceGroup> groups;
+	std::map<BoneSet, size_t> groupIndex;
+	BoneSet faceBones( numWords, 0);
+	for( size_t a = 0; a < pMesh->mNumFaces; ++a)
+	{
+		const aiFace& face = pMesh->mFaces[a];
+		for( size_t b = 0; b < face.mNumIndices; ++b )
+		{
+			const VertexInfluences::Influence* vb = pInfluences.GetInfluences( face.mIndices[b]);
+			for( size_t c = 0, cnt = pInfluences.GetNumInfluences( face.mIndices[b]); c < cnt; ++c)
+				faceBones[vb[c].mBone >> 5] |= 1u << (vb[c].mBone & 31);
+		}
+
+		std::map<BoneSet, size_t>::iterator it = groupIndex.find( faceBones);
+		if( it == groupIndex.end() )
+		{
+			it = groupIndex.insert( std::make_pair( faceBones, groups.size())).first;
+			groups.push_back( FaceGroup());
+			groups.back().bones = faceBones;
+			groups.back().numBones = CountBones( faceBones);
+		}
+		groups[it->second].faces.push_back( a);
+		std::fill( faceBones.begin(), faceBones.end(), 0);
+	}
+
+	std::vector<size_t> order( groups.size());
+	for( size_t a = 0; a < order.size(); ++a)
+		order[a] = a;
+	std::sort( order.begin(), order.end(), GroupOrder( groups));
+
+	// pack the groups into bins
+	std::vector<FaceBin> bins;
+	for( size_t a = 0; a < order.size(); ++a)
+	{
+		const FaceGroup& group = groups[order[a]];
+
+		size_t best = bins.size(), bestNewBones = std::numeric_limits<size_t>::max();
+		if( group.numBones <= pMaxBones )
+		{
+			for( size_t b = 0; b < bins.size() && bestNewBones; ++b)
+			{
+				if( bins[b].numBones > pMaxBones )
+					continue;
+
+				const size_t newBones = CountNewBones( bins[b].bones, group.bones);
+				if( bins[b].numBones + newBones <= pMaxBones && newBones < bestNewBones )
+				{
+					best = b;
+					bestNewBones = newBones;
+				}
+			}
+		}
+		else DefaultLogger::get()->warn( boost::str( boost::format( "SplitByBoneCountProcess: a face is affected by %d bones, more than the limit of %d.") % group.numBones % pMaxBones));
+
+		if( best == bins.size() )
+		{
+			bins.push_back( FaceBin());
+			bins.back().bones.resize( numWords, 0);
+			bins.back().numBones = 0;
+		}
+
+		FaceBin& bin = bins[best];
+		for( size_t b = 0; b < numWords; ++b)
+			bin.bones[b] |= group.bones[b];
+		bin.numBones = CountBones( bin.bones);
+		bin.groups.push_back( order[a]);
+	}
+
+	// merge bins which fit together after all
+	for( size_t a = 0; a < bins.size(); ++a)
+	{
+		for( size_t b = a + 1; b < bins.size(); )
+		{
+			if( bins[a].numBones + CountNewBones( bins[a].bones, bins[b].bones) > pMaxBones )
+			{
+				++b;
+				continue;
+			}
+
+			for( size_t c = 0; c < numWords; ++c)
+				bins[a].bones[c] |= bins[b].bones[c];
+			bins[a].numBones = CountBones( bins[a].bones);
+			bins[a].groups.insert( bins[a].groups.end(), bins[b].groups.begin(), bins[b].groups.end());
+			bins.erase( bins.begin() + b);
+		}
+	}
+
+	// collect the faces of each bin, keeping the original face order
+	poPartitions.resize( bins.size());
+	for( size_t a = 0; a < bins.size(); ++a)
+	{
+		std::vector<size_t>& faces = poPartitions[a];
+		for( size_t b = 0; b < bins[a].groups.size(); ++b)
+		{
+			const std::vector<size_t>& groupFaces = groups[bins[a].groups[b]].faces;
+			faces.insert( faces.end(), groupFaces.begin(), groupFaces.end());
+		}
+		std::sort( faces.begin(), faces.end());
+	}
+
+	// and emit the partitions in the order of their first face
+	std::sort( poPartitions.begin(), poPartitions.end());
+}
+
+} // ! anon namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor
 SplitByBoneCountProcess::SplitByBoneCountProcess()
 {
 	// set default, might be overriden by importer config
 	mMaxBoneCount = AI_SBBC_DEFAULT_MAX_BONES;
+	mNumDrawCalls = mNumDuplicatedVertices = 0;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -86,6 +270,9 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("SplitByBoneCountProcess begin");
 
+	mNumDrawCalls = pScene->mNumMeshes;
+	mNumDuplicatedVertices = 0;
+
 	// early out 
 	bool isNecessary = false;
 	for( size_t a = 0; a < pScene->mNumMeshes; ++a)
@@ -105,12 +292,22 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
 	// build a new array of meshes for the scene
 	std::vector<aiMesh*> meshes;
 
+	// and the bone influences of all submeshes along with it. They are kept for
+	// LimitBoneWeights, the tables of meshes which are not split remain empty.
+	std::vector<VertexInfluences>* influences = new std::vector<VertexInfluences>();
+
 	for( size_t a = 0; a < pScene->mNumMeshes; ++a)
 	{
 		aiMesh* srcMesh = pScene->mMeshes[a];
 
 		std::vector<aiMesh*> newMeshes;
-		SplitMesh( pScene->mMeshes[a], newMeshes);
+		if( srcMesh->mNumBones > mMaxBoneCount )
+		{
+			const VertexInfluences srcInfluences( srcMesh);
+			size_t numDuplicated;
+			SplitMesh( srcMesh, srcInfluences, newMeshes, *influences, numDuplicated);
+			mNumDuplicatedVertices += numDuplicated;
+		}
 
 		// mesh was split
 		if( !newMeshes.empty() )
@@ -130,8 +327,14 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
 			// Mesh is kept unchanged - store it's new place in the mesh array
 			mSubMeshIndices[a].push_back( meshes.size());
 			meshes.push_back( srcMesh);
+			influences->push_back( VertexInfluences());
 		}
 	}
+	ai_assert( influences->size() == meshes.size() );
+
+	if( shared )
+		shared->AddProperty( AI_SPP_BONE_INFLUENCES, influences);
+	else delete influences;
 
 	// rebuild the scene's mesh array
 	pScene->mNumMeshes = meshes.size();
@@ -142,97 +345,76 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
 	// recurse through all nodes and translate the node's mesh indices to fit the new mesh array
 	UpdateNode( pScene->mRootNode);
 
-	DefaultLogger::get()->debug( boost::str( boost::format( "SplitByBoneCountProcess end: split %d meshes into %d submeshes.") % mSubMeshIndices.size() % meshes.size()));
+	mNumDrawCalls = meshes.size();
+	DefaultLogger::get()->info( boost::str( boost::format( "SplitByBoneCountProcess finished: %d meshes in, %d out, %d vertices duplicated at submesh borders.") 
+		% mSubMeshIndices.size() % meshes.size() % mNumDuplicatedVertices));
 }
 
 // ------------------------------------------------------------------------------------------------
 // Splits the given mesh by bone count.
-void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh*>& poNewMeshes) const
+void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, const VertexInfluences& pInfluences, std::vector<aiMesh*>& poNewMeshes, 
+	std::vector<VertexInfluences>& poNewInfluences, size_t& poNumDuplicatedVertices) const
 {
+	poNumDuplicatedVertices = 0;
+
 	// skip if not necessary
 	if( pMesh->mNumBones <= mMaxBoneCount )
 		return;
 
-	// necessary optimisation: build a list of all affecting bones for each vertex
-	// TODO: (thom) maybe add a custom allocator here to avoid allocating tens of thousands of small arrays
-	typedef std::pair<size_t, float> BoneWeight;
-	std::vector< std::vector<BoneWeight> > vertexBones( pMesh->mNumVertices);
-	for( size_t a = 0; a < pMesh->mNumBones; ++a)
-	{
-		const aiBone* bone = pMesh->mBones[a];
-		for( size_t b = 0; b < bone->mNumWeights; ++b)
-			vertexBones[ bone->mWeights[b].mVertexId ].push_back( BoneWeight( a, bone->mWeights[b].mWeight));
-	}
+	// the list of all affecting bones for each vertex is given by pInfluences
+	typedef VertexInfluences::Influence BoneWeight;
+
+	// group the faces into sets which fit into the bone limit
+	std::vector< std::vector<size_t> > partitions;
+	PartitionFaces( pMesh, pInfluences, mMaxBoneCount, partitions);
+
+	// count the vertices which are going to be duplicated because they're used by multiple submeshes
+	std::vector<size_t> lastPartition( pMesh->mNumVertices, std::numeric_limits<size_t>::max());
 
-	size_t numFacesHandled = 0;
-	std::vector<bool> isFaceHandled( pMesh->mNumFaces, false);
-	while( numFacesHandled < pMesh->mNumFaces )
+	for( size_t p = 0; p < partitions.size(); ++p)
 	{
+		// indices of the faces which are going to go into this submesh
+		const std::vector<size_t>& subMeshFaces = partitions[p];
+
 		// which bones are used in the current submesh
 		size_t numBones = 0;
 		std::vector<bool> isBoneUsed( pMesh->mNumBones, false);
-		// indices of the faces which are going to go into this submesh
-		std::vector<size_t> subMeshFaces;
-		subMeshFaces.reserve( pMesh->mNumFaces);
 		// accumulated vertex count of all the faces in this submesh
 		size_t numSubMeshVertices = 0;
-		// a small local array of new bones for the current face. State of all used bones for that face
-		// can only be updated AFTER the face is completely analysed. Thanks to imre for the fix.
-		std::vector<size_t> newBonesAtCurrentFace;
 
-		// add faces to the new submesh as long as all bones affecting the faces' vertices fit in the limit
-		for( size_t a = 0; a < pMesh->mNumFaces; ++a)
+		for( size_t a = 0; a < subMeshFaces.size(); ++a)
 		{
-			// skip if the face is already stored in a submesh
-			if( isFaceHandled[a] )
-				continue;
-
-			const aiFace& face = pMesh->mFaces[a];
-			// check every vertex if its bones would still fit into the current submesh
+			const aiFace& face = pMesh->mFaces[subMeshFaces[a]];
 			for( size_t b = 0; b < face.mNumIndices; ++b )
 			{
-				const std::vector<BoneWeight>& vb = vertexBones[face.mIndices[b]];
-				for( size_t c = 0; c < vb.size(); ++c)
+				const unsigned int vertex = face.mIndices[b];
+				if( lastPartition[vertex] != p )
 				{
-					size_t boneIndex = vb[c].first;
-					// if the bone is already used in this submesh, it's ok
-					if( isBoneUsed[boneIndex] )
-						continue;
-
-					// if it's not used, yet, we would need to add it. Store its bone index
-					if( std::find( newBonesAtCurrentFace.begin(), newBonesAtCurrentFace.end(), boneIndex) == newBonesAtCurrentFace.end() )
-						newBonesAtCurrentFace.push_back( boneIndex);
+					if( lastPartition[vertex] != std::numeric_limits<size_t>::max() )
+						++poNumDuplicatedVertices;
+					lastPartition[vertex] = p;
 				}
-			}
 
-			// leave out the face if the new bones required for this face don't fit the bone count limit anymore
-			if( numBones + newBonesAtCurrentFace.size() > mMaxBoneCount )
-				continue;
-
-			// mark all new bones as necessary
-			while( !newBonesAtCurrentFace.empty() )
-			{
-				size_t newIndex = newBonesAtCurrentFace.back();
-				newBonesAtCurrentFace.pop_back(); // this also avoids the deallocation which comes with a clear()
-				if( isBoneUsed[newIndex] ) 
-					continue;
-
-				isBoneUsed[newIndex] = true;
-				numBones++;
+				const BoneWeight* vb = pInfluences.GetInfluences( vertex);
+				for( size_t c = 0, cnt = pInfluences.GetNumInfluences( vertex); c < cnt; ++c)
+				{
+					if( !isBoneUsed[vb[c].mBone] )
+					{
+						isBoneUsed[vb[c].mBone] = true;
+						numBones++;
+					}
+				}
 			}
-
-			// store the face index and the vertex count
-			subMeshFaces.push_back( a);
 			numSubMeshVertices += face.mNumIndices;
-
-			// remember that this face is handled
-			isFaceHandled[a] = true;
-			numFacesHandled++;
 		}
 
 		// create a new mesh to hold this subset of the source mesh
 		aiMesh* newMesh = new aiMesh;
-		if( pMesh->mName.length > 0 )
+		// morph target animations refer to their meshes by name, so the submeshes of a mesh 
+		// with anim meshes keep its name.
+		if( pMesh->mNumAnimMeshes )
+			newMesh->mName = pMesh->mName;
+		else if( pMesh->mName.length > 0 )
 			newMesh->mName.Set( boost::str( boost::format( "%s_sub%d") % pMesh->mName.data % poNewMeshes.size()));
 		newMesh->mMaterialIndex = pMesh->mMaterialIndex;
 		newMesh->mPrimitiveTypes = pMesh->mPrimitiveTypes;
@@ -263,19 +445,21 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
 
 		// and copy over the data, generating faces with linear indices along the way
 		newMesh->mFaces = new aiFace[subMeshFaces.size()];
+		if( pMesh->HasSharedFaceIndices() )
+			newMesh->mFaceIndices = new unsigned int[numSubMeshVertices]; // one index per new vertex
 		size_t nvi = 0; // next vertex index
-		std::vector<size_t> previousVertexIndices( numSubMeshVertices, std::numeric_limits<size_t>::max()); // per new vertex: its index in the source mesh
+		std::vector<unsigned int> previousVertexIndices( numSubMeshVertices, std::numeric_limits<unsigned int>::max()); // per new vertex: its index in the source mesh
 		for( size_t a = 0; a < subMeshFaces.size(); ++a )
 		{
 			const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
 			aiFace& dstFace = newMesh->mFaces[a];
 			dstFace.mNumIndices = srcFace.mNumIndices;
-			dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
+			dstFace.mIndices = newMesh->mFaceIndices ? newMesh->mFaceIndices + nvi : new unsigned int[dstFace.mNumIndices];
 
 			// accumulate linearly all the vertices of the source face
 			for( size_t b = 0; b < dstFace.mNumIndices; ++b )
 			{
-				size_t srcIndex = srcFace.mIndices[b];
+				unsigned int srcIndex = srcFace.mIndices[b];
 				dstFace.mIndices[b] = nvi;
 				previousVertexIndices[nvi] = srcIndex;
 
@@ -304,6 +488,10 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
 
 		ai_assert( nvi == numSubMeshVertices );
 
+		// the anim meshes are split like the mesh itself
+		if( pMesh->mNumAnimMeshes )
+			RemapAnimMeshes( newMesh, pMesh, &previousVertexIndices[0]);
+
 		// Create the bones for the new submesh: first create the bone array
 		newMesh->mNumBones = 0;
 		newMesh->mBones = new aiBone*[numBones];
@@ -326,49 +514,37 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
 
 		ai_assert( newMesh->mNumBones == numBones );
 
-		// iterate over all new vertices and count which bones affected its old vertex in the source mesh
+		// build the influence table of the new submesh: all of the bones affecting its vertices 
+		// should be present in the new submesh, or else the face it comprises shouldn't be present
+		size_t numSubMeshInfluences = 0;
 		for( size_t a = 0; a < numSubMeshVertices; ++a )
-		{
-			size_t oldIndex = previousVertexIndices[a];
-			const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[oldIndex];
+			numSubMeshInfluences += pInfluences.GetNumInfluences( previousVertexIndices[a]);
 
-			for( size_t b = 0; b < bonesOnThisVertex.size(); ++b )
-			{
-				size_t newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
-				if( newBoneIndex != std::numeric_limits<size_t>::max() )
-					newMesh->mBones[newBoneIndex]->mNumWeights++;
-			}
-		}
+		poNewInfluences.push_back( VertexInfluences());
+		VertexInfluences& newInfluences = poNewInfluences.back();
+		newInfluences.Reset( numSubMeshVertices, numSubMeshInfluences);
 
-		// allocate all bone weight arrays accordingly
-		for( size_t a = 0; a < newMesh->mNumBones; ++a )
-		{
-			aiBone* bone = newMesh->mBones[a];
-			ai_assert( bone->mNumWeights > 0 );
-			bone->mWeights = new aiVertexWeight[bone->mNumWeights];
-			bone->mNumWeights = 0; // for counting up in the next step
-		}
-
-		// now copy all the bone vertex weights for all the vertices which made it into the new submesh
 		for( size_t a = 0; a < numSubMeshVertices; ++a)
 		{
 			// find the source vertex for it in the source mesh
 			size_t previousIndex = previousVertexIndices[a];
 			// these bones were affecting it
-			const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[previousIndex];
-			// all of the bones affecting it should be present in the new submesh, or else
-			// the face it comprises shouldn't be present
-			for( size_t b = 0; b < bonesOnThisVertex.size(); ++b)
+			const unsigned int numBonesOnThisVertex = pInfluences.GetNumInfluences( previousIndex);
+			const BoneWeight* bonesOnThisVertex = pInfluences.GetInfluences( previousIndex);
+
+			BoneWeight* dstWeights = newInfluences.AddVertex( numBonesOnThisVertex);
+			for( size_t b = 0; b < numBonesOnThisVertex; ++b)
 			{
-				size_t newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
+				size_t newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].mBone ];
 				ai_assert( newBoneIndex != std::numeric_limits<size_t>::max() );
-				aiVertexWeight* dstWeight = newMesh->mBones[newBoneIndex]->mWeights + newMesh->mBones[newBoneIndex]->mNumWeights;
-				newMesh->mBones[newBoneIndex]->mNumWeights++;
-
-				dstWeight->mVertexId = a;
-				dstWeight->mWeight = bonesOnThisVertex[b].second;
+				dstWeights[b].mBone = newBoneIndex;
+				dstWeights[b].mWeight = bonesOnThisVertex[b].mWeight;
 			}
 		}
+		newInfluences.SetMesh( newMesh);
+
+		// and copy the bone vertex weights from there
+		newInfluences.WriteBoneWeights( newMesh);
 
 		// I have the strange feeling that this will break apart at some point in time...
 	}
@@ -389,7 +565,7 @@ void SplitByBoneCountProcess::UpdateNode( aiNode* pNode) const
 			newMeshList.insert( newMeshList.end(), replaceMeshes.begin(), replaceMeshes.end());
 		}
 
-		delete pNode->mMeshes;
+		delete [] pNode->mMeshes;
 		pNode->mNumMeshes = newMeshList.size();
 		pNode->mMeshes = new unsigned int[pNode->mNumMeshes];
 		std::copy( newMeshList.begin(), newMeshList.end(), pNode->mMeshes);
@@ -51,15 +51,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp
 {
+class VertexInfluences;
 
 
 /** Postprocessing filter to split meshes with many bones into submeshes
  * so that each submesh has a certain max bone count.
  *
+ * Faces are grouped by the bones affecting them rather than by their order
+ * in the mesh, so that as few submeshes (draw calls) as possible are needed
+ * and few vertices end up in more than one submesh.
+ *
  * Applied BEFORE the JoinVertices-Step occurs.
  * Returns NON-UNIQUE vertices, splits by bone count.
 */
-class SplitByBoneCountProcess : public BaseProcess
+class ASSIMP_API_WINONLY SplitByBoneCountProcess : public BaseProcess
 {
 public:
 
@@ -81,17 +86,23 @@ public:
 	*/
 	virtual void SetupProperties(const Importer* pImp);
 
-protected:
 	/** Executes the post processing step on the given imported data.
 	* At the moment a process is not supposed to fail.
 	* @param pScene The imported data to work at.
 	*/
 	void Execute( aiScene* pScene);
 
+protected:
+
 	/// Splits the given mesh by bone count.
 	/// @param pMesh the Mesh to split. Is not changed at all, but might be superfluous in case it was split.
+	/// @param pInfluences Bone influences of pMesh.
 	/// @param poNewMeshes Array of submeshes created in the process. Empty if splitting was not necessary.
-	void SplitMesh( const aiMesh* pMesh, std::vector<aiMesh*>& poNewMeshes) const;
+	/// @param poNewInfluences Receives the bone influences of each new submesh.
+	/// @param poNumDuplicatedVertices Receives the number of vertices which are used by more than
+	///   one submesh and thus end up in several of them.
+	void SplitMesh( const aiMesh* pMesh, const VertexInfluences& pInfluences, std::vector<aiMesh*>& poNewMeshes, 
+		std::vector<VertexInfluences>& poNewInfluences, size_t& poNumDuplicatedVertices) const;
 
 	/// Recursively updates the node's mesh list to account for the changed mesh list
 	void UpdateNode( aiNode* pNode) const;
@@ -102,6 +113,12 @@ public:
 
 	/// Per mesh index: Array of indices of the new submeshes.
 	std::vector< std::vector<size_t> > mSubMeshIndices;
+
+	/// Number of meshes in the scene after the last run, i.e. the number of draw calls needed.
+	size_t mNumDrawCalls;
+
+	/// Number of vertices the last run had to copy to more than one submesh.
+	size_t mNumDuplicatedVertices;
 };
 
 } // end of namespace Assimp
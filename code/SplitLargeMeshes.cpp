@@ -128,7 +128,7 @@ void SplitLargeMeshesProcess_Triangle::UpdateNode(aiNode* pcNode,
 	}
 
 	// now build the new list
-	delete pcNode->mMeshes;
+	delete[] pcNode->mMeshes;
 	pcNode->mNumMeshes = (unsigned int)aiEntries.size();
 	pcNode->mMeshes = new unsigned int[pcNode->mNumMeshes];
 
@@ -271,8 +271,15 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 				}
 			}
 
-			// (we will also need to copy the array of indices)
+			// source vertex for each output vertex, needed to split the anim meshes
+			std::vector<unsigned int> sourceIndex(pMesh->mNumAnimMeshes ? iCnt : 0);
+
+			// (we will also need to copy the array of indices, in one block if the source shares them)
 			unsigned int iCurrent = 0;
+			unsigned int* piIndices = NULL;
+			if (pMesh->HasSharedFaceIndices()) {
+				piIndices = pcMesh->mFaceIndices = new unsigned int[iCnt];
+			}
 			for (unsigned int p = 0; p < pcMesh->mNumFaces;++p)
 			{
 				pcMesh->mFaces[p].mNumIndices = 3;
@@ -283,7 +290,12 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 				// setup face type and number of indices
 				pcMesh->mFaces[p].mNumIndices = iNumIndices;
 				unsigned int* pi = pMesh->mFaces[iTemp].mIndices;
-				unsigned int* piOut = pcMesh->mFaces[p].mIndices = new unsigned int[iNumIndices];
+				unsigned int* piOut;
+				if (piIndices) {
+					piOut = pcMesh->mFaces[p].mIndices = piIndices;
+					piIndices += iNumIndices;
+				}
+				else piOut = pcMesh->mFaces[p].mIndices = new unsigned int[iNumIndices];
 
 				// need to update the output primitive types
 				switch (iNumIndices)
@@ -308,6 +320,10 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 					unsigned int iIndexOut = iCurrent++;
 					piOut[v] = iIndexOut;
 
+					if (!sourceIndex.empty()) {
+						sourceIndex[iIndexOut] = iIndex;
+					}
+
 					// copy positions
 					if (pMesh->mVertices != NULL)
 						pcMesh->mVertices[iIndexOut] = pMesh->mVertices[iIndex];
@@ -338,6 +354,11 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 				}
 			}
 
+			// the anim meshes are split like the mesh itself
+			if (!sourceIndex.empty()) {
+				RemapAnimMeshes(pcMesh,pMesh,&sourceIndex[0]);
+			}
+
 			// add the newly created mesh to the list
 			avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
 		}
@@ -467,8 +488,12 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 				}
 			}
 
-			// output vectors
-			std::vector<aiFace> vFaces;
+			// output vectors, the indices of all faces are kept in a single array
+			std::vector<unsigned int> vFaceSizes;
+			std::vector<unsigned int> vIndices;
+
+			// source vertex for each output vertex, needed to split the anim meshes
+			std::vector<unsigned int> sourceIndex;
 
 			// reserve enough storage for most cases
 			if (pMesh->HasPositions())
@@ -493,7 +518,8 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 				pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
 				pcMesh->mTextureCoords[c] = new aiVector3D[iOutVertexNum];
 			}
-			vFaces.reserve(iEstimatedSize);
+			vFaceSizes.reserve(iEstimatedSize);
+			vIndices.reserve(iEstimatedSize * 3);
 
 			// (we will also need to copy the array of indices)
 			while (iBase < pMesh->mNumFaces)
@@ -519,15 +545,13 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 					break;
 				}
 
-				vFaces.push_back(aiFace());
-				aiFace& rFace = vFaces.back();
-
 				// setup face type and number of indices
-				rFace.mNumIndices = iNumIndices;
-				rFace.mIndices = new unsigned int[iNumIndices];
+				vFaceSizes.push_back(iNumIndices);
+				const size_t iFirstIndex = vIndices.size();
+				vIndices.resize(iFirstIndex + iNumIndices);
 
 				// need to update the output primitive types
-				switch (rFace.mNumIndices)
+				switch (iNumIndices)
 				{
 				case 1:
 					pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
@@ -550,7 +574,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 					// check whether we do already have this vertex
 					if (0xFFFFFFFF != avWasCopied[iIndex])
 					{
-						rFace.mIndices[v] = avWasCopied[iIndex];
+						vIndices[iFirstIndex + v] = avWasCopied[iIndex];
 						continue;
 					}
 
@@ -587,7 +611,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 						}
 					}
 					// check whether we have bone weights assigned to this vertex
-					rFace.mIndices[v] = pcMesh->mNumVertices;
+					vIndices[iFirstIndex + v] = pcMesh->mNumVertices;
 					if (avPerVertexWeights)
 					{
 						VertexWeightTable& table = avPerVertexWeights[ pcMesh->mNumVertices ];
@@ -608,6 +632,9 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 						}
 					}
 
+					if (pMesh->mNumAnimMeshes) {
+						sourceIndex.push_back(iIndex);
+					}
 					avWasCopied[iIndex] = pcMesh->mNumVertices;
 					pcMesh->mNumVertices++;
 				}
@@ -649,11 +676,22 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 			}
 
 			// copy the face list to the mesh
-			pcMesh->mFaces = new aiFace[vFaces.size()];
-			pcMesh->mNumFaces = (unsigned int)vFaces.size();
+			pcMesh->mFaces = new aiFace[vFaceSizes.size()];
+			pcMesh->mNumFaces = (unsigned int)vFaceSizes.size();
 
 			for (unsigned int p = 0; p < pcMesh->mNumFaces;++p)
-				pcMesh->mFaces[p] = vFaces[p];
+				pcMesh->mFaces[p].mNumIndices = vFaceSizes[p];
+
+			AllocateFaceIndices(pcMesh,pMesh->HasSharedFaceIndices());
+			for (unsigned int p = 0, q = 0; p < pcMesh->mNumFaces;++p)	{
+				::memcpy(pcMesh->mFaces[p].mIndices,&vIndices[q],vFaceSizes[p]*sizeof(unsigned int));
+				q += vFaceSizes[p];
+			}
+
+			// the anim meshes are split like the mesh itself
+			if (!sourceIndex.empty()) {
+				RemapAnimMeshes(pcMesh,pMesh,&sourceIndex[0]);
+			}
 
 			// add the newly created mesh to the list
 			avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
@@ -0,0 +1,426 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file StreamWriter.h
+ *  Defines the StreamWriter class which writes text or binary output to an
+ *  IOStream through a fixed-size buffer. Used by the exporters.
+ */
+#ifndef AI_STREAMWRITER_H_INCLUDED
+#define AI_STREAMWRITER_H_INCLUDED
+
+#include "ByteSwap.h"
+
+namespace Assimp {
+
+// Default size of the buffer of a StreamWriter, in bytes
+#define AI_STREAMWRITER_BUFFER_SIZE (64 * 1024)
+
+// Minimum number of bytes FormatFloat() and FormatUInt() may write
+#define AI_FORMAT_NUMBER_MAX_LEN 32
+
+// --------------------------------------------------------------------------------------------
+/** Write an unsigned integer in decimal notation.
+ *  @param out Output buffer, at least #AI_FORMAT_NUMBER_MAX_LEN bytes
+ *  @param value Value to be written
+ *  @return Number of characters written, no terminal zero is appended */
+// --------------------------------------------------------------------------------------------
+inline unsigned int FormatUInt(char* out, uint64_t value)
+{
+	char tmp[24], *p = tmp + sizeof(tmp);
+	do {
+		*--p = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+	while (value);
+
+	const unsigned int len = static_cast<unsigned int>(tmp + sizeof(tmp) - p);
+	::memcpy(out,p,len);
+	return len;
+}
+
+// --------------------------------------------------------------------------------------------
+/** Write a signed integer in decimal notation, see FormatUInt() */
+// --------------------------------------------------------------------------------------------
+inline unsigned int FormatInt(char* out, int64_t value)
+{
+	if (value < 0) {
+		*out = '-';
+		return FormatUInt(out+1,static_cast<uint64_t>(-(value+1))+1)+1;
+	}
+	return FormatUInt(out,static_cast<uint64_t>(value));
+}
+
+// --------------------------------------------------------------------------------------------
+/** Write a float the same way printf("%g") or a default std::ostream would do, that is
+ *  with six significant digits. The decimal separator is always '.', regardless of the
+ *  C and C++ locales. 
+ *
+ *  Values in the range [1e-7,1e18) are converted with integer arithmetic only, all other
+ *  values are passed to snprintf. The rounding is exact in both cases, so the output is 
+ *  identical to what the C library produces.
+ *  @param out Output buffer, at least #AI_FORMAT_NUMBER_MAX_LEN bytes
+ *  @param value Value to be written
+ *  @return Number of characters written, no terminal zero is appended */
+// --------------------------------------------------------------------------------------------
+inline unsigned int FormatFloat(char* out, float value)
+{
+	// 1e13 is only used when the exponent estimate is off by one, the result
+	// is discarded then.
+	static const double pow10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13
+	};
+
+	char* p = out;
+
+	uint32_t bits;
+	::memcpy(&bits,&value,4);
+	if ((bits & 0x7f800000) == 0x7f800000) {
+		// inf and nan
+		p += ::sprintf(p,"%g",value);
+		return static_cast<unsigned int>(p-out);
+	}
+
+	if (bits & 0x80000000) {
+		*p++ = '-';
+	}
+
+	const double v = ::fabs(static_cast<double>(value));
+	if (v == 0.0) {
+		*p++ = '0';
+		return static_cast<unsigned int>(p-out);
+	}
+
+	if (v < 1e-7 || v >= 1e18) {
+		const int len = ::sprintf(p,"%g",v);
+		for (int i = 0; i < len; ++i) {
+			// in case the C locale has been changed
+			if (p[i] == ',') {
+				p[i] = '.';
+			}
+		}
+		return static_cast<unsigned int>(p-out+len);
+	}
+
+	// estimate the decimal exponent, the loop below corrects it if needed
+	int be;
+	::frexp(v,&be);
+	int e = static_cast<int>(::floor((be-1) * 0.30102999566398));
+
+	uint64_t n;
+	for (;;) {
+		const int k = 5 - e;
+		if (k >= 0) {
+			// v has at most 24 significant bits, 10^k at most 28 for k <= 12, 
+			// the product is thus exact and so is the fractional part.
+			const double m = k ? v * pow10[k] : v;
+			const double fl = ::floor(m), frac = m - fl;
+
+			n = static_cast<uint64_t>(fl);
+			if (frac > 0.5 || (frac == 0.5 && (n & 1))) {
+				++n;
+			}
+		}
+		else {
+			// v >= 2^19 here, so 16*v is an integer
+			const uint64_t V = static_cast<uint64_t>(v * 16.0);
+			const uint64_t D = static_cast<uint64_t>(pow10[-k]) * 16;
+
+			n = V / D;
+			const uint64_t r = V % D;
+			if (r*2 > D || (r*2 == D && (n & 1))) {
+				++n;
+			}
+		}
+
+		if (n >= 1000000) {
+			++e;
+		}
+		else if (n < 100000) {
+			--e;
+		}
+		else break;
+	}
+
+	// six significant digits, strip trailing zeros
+	char digits[6];
+	for (int i = 5; i >= 0; --i) {
+		digits[i] = static_cast<char>('0' + n % 10);
+		n /= 10;
+	}
+	int nd = 6;
+	while (nd > 1 && digits[nd-1] == '0') {
+		--nd;
+	}
+
+	if (e < -4 || e >= 6) {
+		*p++ = digits[0];
+		if (nd > 1) {
+			*p++ = '.';
+			for (int i = 1; i < nd; ++i) {
+				*p++ = digits[i];
+			}
+		}
+		*p++ = 'e';
+		*p++ = e < 0 ? '-' : '+';
+
+		const int ae = e < 0 ? -e : e;
+		*p++ = static_cast<char>('0' + ae / 10);
+		*p++ = static_cast<char>('0' + ae % 10);
+	}
+	else if (e >= 0) {
+		for (int i = 0; i <= e; ++i) {
+			*p++ = digits[i];
+		}
+		if (nd > e+1) {
+			*p++ = '.';
+			for (int i = e+1; i < nd; ++i) {
+				*p++ = digits[i];
+			}
+		}
+	}
+	else {
+		*p++ = '0';
+		*p++ = '.';
+		for (int i = -1; i > e; --i) {
+			*p++ = '0';
+		}
+		for (int i = 0; i < nd; ++i) {
+			*p++ = digits[i];
+		}
+	}
+	return static_cast<unsigned int>(p-out);
+}
+
+// --------------------------------------------------------------------------------------------
+/** Buffered text output to a file of an IOSystem. 
+ *
+ *  Output is collected in a fixed-size buffer which is written to the file whenever it
+ *  is full, so memory usage does not depend on the size of the output. The insertion 
+ *  operators format numbers exactly like a std::ostream imbued with the "C" locale
+ *  would do, but without the overhead of iostreams. 
+ *
+ *  The file is opened upon construction and closed by the destructor. */
+// --------------------------------------------------------------------------------------------
+class StreamWriter
+{
+public:
+
+	// ---------------------------------------------------------------------
+	/** Open a file for writing.
+	 *  @param io IOSystem to open the file with
+	 *  @param file Name of the file
+	 *  @param mode File mode, "wt" or "wb"
+	 *  @param bufferSize Size of the output buffer, in bytes
+	 *  @throw DeadlyExportError if the file cannot be opened */
+	StreamWriter(IOSystem* io, const std::string& file, const char* mode = "wt", 
+		size_t bufferSize = AI_STREAMWRITER_BUFFER_SIZE)
+		: io(io)
+		, stream(io->Open(file.c_str(),mode))
+		, buffer()
+		, size(std::max(bufferSize,static_cast<size_t>(AI_FORMAT_NUMBER_MAX_LEN)))
+		, cursor()
+	{
+		if (!stream) {
+			throw DeadlyExportError("Could not open output file " + file);
+		}
+		buffer = new char[size];
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write all pending output and close the file. Errors are ignored
+	 *  at this point, call Flush() first to check for them. */
+	~StreamWriter() {
+		if (cursor) {
+			stream->Write(buffer,cursor,1);
+		}
+		io->Close(stream);
+		delete[] buffer;
+	}
+
+public:
+
+	// ---------------------------------------------------------------------
+	/** Write all pending output to the file.
+	 *  @throw DeadlyExportError if writing fails */
+	void Flush() {
+		if (cursor) {
+			const size_t n = cursor;
+			cursor = 0;
+			if (stream->Write(buffer,n,1) != 1) {
+				throw DeadlyExportError("Failed to write to output file");
+			}
+		}
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write raw data */
+	void Write(const void* data, size_t len) {
+		if (cursor + len > size) {
+			Flush();
+			if (len > size) {
+				if (stream->Write(data,len,1) != 1) {
+					throw DeadlyExportError("Failed to write to output file");
+				}
+				return;
+			}
+		}
+		::memcpy(buffer+cursor,data,len);
+		cursor += len;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write a binary value in little-endian byte order */
+	template <typename T>
+	void PutLE(T value) {
+#ifdef AI_BUILD_BIG_ENDIAN
+		ByteSwap::Swap(&value);
+#endif
+		Write(&value,sizeof(T));
+	}
+
+	// ---------------------------------------------------------------------
+	void PutLE(uint8_t value) {
+		Write(&value,1);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write an array of binary values in little-endian byte order */
+	template <typename T>
+	void PutLE(const T* values, size_t count) {
+#ifdef AI_BUILD_BIG_ENDIAN
+		for (size_t i = 0; i < count; ++i) {
+			PutLE(values[i]);
+		}
+#else
+		Write(values,count*sizeof(T));
+#endif
+	}
+
+public:
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (const char* s) {
+		Write(s,::strlen(s));
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (const std::string& s) {
+		Write(s.c_str(),s.length());
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (char c) {
+		if (cursor == size) {
+			Flush();
+		}
+		buffer[cursor++] = c;
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (float f) {
+		cursor += FormatFloat(Reserve(),f);
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (int i) {
+		cursor += FormatInt(Reserve(),i);
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (unsigned int i) {
+		cursor += FormatUInt(Reserve(),i);
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (long i) {
+		cursor += FormatInt(Reserve(),i);
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (unsigned long i) {
+		cursor += FormatUInt(Reserve(),i);
+		return *this;
+	}
+
+#ifdef _WIN64
+	// ---------------------------------------------------------------------
+	// size_t is a distinct 64 bit type on Win64
+	StreamWriter& operator << (unsigned long long i) {
+		cursor += FormatUInt(Reserve(),i);
+		return *this;
+	}
+#endif
+
+private:
+
+	// ---------------------------------------------------------------------
+	/** Make sure a formatted number fits into the buffer */
+	char* Reserve() {
+		if (size - cursor < AI_FORMAT_NUMBER_MAX_LEN) {
+			Flush();
+		}
+		return buffer + cursor;
+	}
+
+private:
+
+	IOSystem* const io;
+	IOStream* const stream;
+
+	char* buffer;
+	const size_t size;
+	size_t cursor;
+
+private:
+
+	StreamWriter(const StreamWriter&);
+	StreamWriter& operator= (const StreamWriter&);
+};
+
+} // end namespace Assimp
+
+#endif // !! AI_STREAMWRITER_H_INCLUDED
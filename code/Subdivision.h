@@ -47,7 +47,7 @@ namespace Assimp	{
 /** Helper class to evaluate subdivision surfaces. Different algorithms
  *  are provided for choice. */
 // ------------------------------------------------------------------------------
-class Subdivider
+class ASSIMP_API Subdivider
 {
 public:
 
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifndef ASSIMP_BUILD_NO_TERRAGEN_IMPORTER
 #include "TerragenLoader.h"
+#include "TerrainMeshBuilder.h"
 
 using namespace Assimp;
 
@@ -65,6 +66,8 @@ static const aiImporterDesc desc = {
 // Constructor to be privately used by Importer
 TerragenImporter::TerragenImporter()
 : configComputeUVs (false)
+, configTileSize (0)
+, configLODLevels (0)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -107,6 +110,10 @@ void TerragenImporter::SetupProperties(const Importer* pImp)
 {
 	// AI_CONFIG_IMPORT_TER_MAKE_UVS
 	configComputeUVs = ( 0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_TER_MAKE_UVS,0) );
+
+	// AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE, AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS
+	configTileSize  = std::max(0,pImp->GetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE,0));
+	configLODLevels = std::max(0,pImp->GetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS,0));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -203,13 +210,14 @@ void TerragenImporter::InternReadFile( const std::string& pFile,
 			if (x <= 1 || y <= 1)
 				throw DeadlyImportError("TER: Invalid terrain size");
 
-			// Allocate the output mesh
+			if (pScene->mNumMeshes)
+				throw DeadlyImportError("TER: Multiple ALTW chunks");
+
+			// Allocate a mesh to hold the grid of vertices, the output 
+			// meshes are built from it by TerrainMeshBuilder
 			pScene->mMeshes = new aiMesh*[pScene->mNumMeshes = 1];
 			aiMesh* m = pScene->mMeshes[0] = new aiMesh();
-
-			// We return quads
-			aiFace* f = m->mFaces = new aiFace[m->mNumFaces = (x-1)*(y-1)];
-			aiVector3D* pv = m->mVertices = new aiVector3D[m->mNumVertices = m->mNumFaces*4];
+			aiVector3D* pv = m->mVertices = new aiVector3D[m->mNumVertices = x*y];
 			
 			aiVector3D *uv( NULL );
 			float step_y( 0.0f ), step_x( 0.0f );
@@ -220,35 +228,21 @@ void TerragenImporter::InternReadFile( const std::string& pFile,
 			}
 			const int16_t* data = (const int16_t*)reader.GetPtr();
 
-			for (unsigned int yy = 0, t = 0; yy < y-1;++yy)	{
-				for (unsigned int xx = 0; xx < x-1;++xx,++f)	{
+			for (unsigned int yy = 0; yy < y;++yy)	{
+				for (unsigned int xx = 0; xx < x;++xx)	{
 
 					// make verts
-					const float fy = (float)yy, fx = (float)xx;
-					register unsigned tmp,tmp2;
-					*pv++ = aiVector3D(fx,fy,    (float)data[(tmp2=x*yy)    + xx] * hscale + bheight);
-					*pv++ = aiVector3D(fx,fy+1,  (float)data[(tmp=x*(yy+1)) + xx] * hscale + bheight);
-					*pv++ = aiVector3D(fx+1,fy+1,(float)data[tmp  + xx+1]         * hscale + bheight);
-					*pv++ = aiVector3D(fx+1,fy,  (float)data[tmp2 + xx+1]         * hscale + bheight);
+					*pv++ = aiVector3D((float)xx,(float)yy,(float)data[x*yy + xx] * hscale + bheight);
 
 					// also make texture coordinates, if necessary
 					if (configComputeUVs) {
-						*uv++ = aiVector3D( step_x*xx,     step_y*yy,     0.f );
-						*uv++ = aiVector3D( step_x*xx,     step_y*(yy+1), 0.f );
-						*uv++ = aiVector3D( step_x*(xx+1), step_y*(yy+1), 0.f );
-						*uv++ = aiVector3D( step_x*(xx+1), step_y*yy,     0.f );
+						*uv++ = aiVector3D( step_x*xx, step_y*yy, 0.f );
 					}
-
-					// make indices
-					f->mIndices = new unsigned int[f->mNumIndices = 4];
-					for (unsigned int i = 0; i < 4;++i)
-						f->mIndices[i] = t++;
 				}
 			}
 
-			// Add the mesh to the root node
-			root->mMeshes = new unsigned int[root->mNumMeshes = 1];
-			root->mMeshes[0] = 0;
+			// Build quads, either a single mesh or tiles, and add them to the root node
+			TerrainMeshBuilder(configTileSize,configLODLevels).Build(pScene,x,y,root);
 		}
 
 		// Get to the next chunk (4 byte aligned)
@@ -258,7 +252,7 @@ void TerragenImporter::InternReadFile( const std::string& pFile,
 	}
 
 	// Check whether we have a mesh now
-	if (pScene->mNumMeshes != 1)
+	if (!pScene->mNumMeshes)
 		throw DeadlyImportError("TER: Unable to load terrain");
 
 	// Set the AI_SCENE_FLAGS_TERRAIN bit
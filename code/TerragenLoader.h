@@ -95,6 +95,7 @@ protected:
 private:
 
 	bool configComputeUVs;
+	unsigned int configTileSize, configLODLevels;
 
 }; //! class TerragenImporter
 
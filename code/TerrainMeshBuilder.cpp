@@ -0,0 +1,269 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file TerrainMeshBuilder.cpp
+ *  @brief Implementation of the TerrainMeshBuilder helper class
+ */
+
+#include "AssimpPCH.h"
+#include "TerrainMeshBuilder.h"
+#include "ProcessHelper.h"
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+TerrainMeshBuilder::TerrainMeshBuilder( unsigned int pTileSize, unsigned int pNumLODLevels)
+: mTileSize (pTileSize)
+, mNumLODLevels (pNumLODLevels)
+{}
+
+// ------------------------------------------------------------------------------------------------
+void TerrainMeshBuilder::Build( aiScene* pScene, unsigned int pWidth, unsigned int pHeight, aiNode* pNode) const
+{
+	ai_assert(1 == pScene->mNumMeshes && pWidth > 1 && pHeight > 1);
+	ai_assert(!pNode->mNumMeshes && !pNode->mNumChildren);
+
+	aiMesh* grid = pScene->mMeshes[0];
+	ai_assert(grid->mNumVertices >= pWidth*pHeight);
+
+	if (!mTileSize)	{
+		BuildSingleMesh(grid,pWidth,pHeight);
+
+		pNode->mMeshes = new unsigned int[pNode->mNumMeshes = 1];
+		pNode->mMeshes[0] = 0;
+		return;
+	}
+
+	// tiles along the right and bottom borders of the terrain may be smaller
+	const unsigned int numTilesX = (pWidth-2)  / mTileSize + 1;
+	const unsigned int numTilesY = (pHeight-2) / mTileSize + 1;
+
+	std::vector<aiMesh*> meshes;
+	pNode->mChildren = new aiNode*[pNode->mNumChildren = numTilesX*numTilesY];
+	for (unsigned int y = 0; y < numTilesY;++y)	{
+		for (unsigned int x = 0; x < numTilesX;++x)	{
+
+			const unsigned int x0 = x*mTileSize, y0 = y*mTileSize;
+			pNode->mChildren[y*numTilesX+x] = BuildTile(grid,pWidth,x0,y0,
+				std::min(x0+mTileSize,pWidth-1),std::min(y0+mTileSize,pHeight-1),meshes,pNode);
+		}
+	}
+
+	// replace the grid by the meshes of the tiles
+	delete grid;
+	delete[] pScene->mMeshes;
+	pScene->mMeshes = new aiMesh*[pScene->mNumMeshes = static_cast<unsigned int>(meshes.size())];
+	std::copy(meshes.begin(),meshes.end(),pScene->mMeshes);
+
+	// the tiles share their vertices between faces
+	pScene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
+
+	DefaultLogger::get()->debug(boost::str(boost::format("Terrain: split %dx%d vertices into %d tiles, %d meshes") 
+		% pWidth % pHeight % pNode->mNumChildren % pScene->mNumMeshes));
+}
+
+// ------------------------------------------------------------------------------------------------
+void TerrainMeshBuilder::BuildSingleMesh( aiMesh* pcMesh, unsigned int width, unsigned int height) const
+{
+	// Allocate enough storage
+	pcMesh->mNumFaces = (width-1) * (height-1);
+	pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+
+	pcMesh->mNumVertices   = pcMesh->mNumFaces*4;
+	aiVector3D* pcVertices = new aiVector3D[pcMesh->mNumVertices];
+	aiVector3D* pcNormals  = pcMesh->mNormals ? new aiVector3D[pcMesh->mNumVertices] : NULL;
+	aiVector3D* pcUVs = pcMesh->mTextureCoords[0] ? new aiVector3D[pcMesh->mNumVertices] : NULL;
+
+	aiFace* pcFaceOut(pcMesh->mFaces);
+	aiVector3D* pcVertOut = pcVertices;
+	aiVector3D* pcNorOut = pcNormals;
+	aiVector3D* pcUVOut(pcUVs);
+
+	// Build the terrain square
+	unsigned int iCurrent = 0;
+	for (unsigned int y = 0; y < height-1;++y)	{
+		for (unsigned int x = 0; x < width-1;++x,++pcFaceOut)	{
+			pcFaceOut->mNumIndices = 4;
+			pcFaceOut->mIndices = new unsigned int[4];
+
+			const unsigned int corners[4] = {y*width+x, (y+1)*width+x, (y+1)*width+x+1, y*width+x+1};
+			for (unsigned int i = 0; i < 4;++i)	{
+				*pcVertOut++ = pcMesh->mVertices[corners[i]];
+				if (pcNormals) {
+					*pcNorOut++ = pcMesh->mNormals[corners[i]];
+				}
+				if (pcUVs) {
+					*pcUVOut++ = pcMesh->mTextureCoords[0][corners[i]];
+				}
+				pcFaceOut->mIndices[i] = iCurrent++;
+			}
+		}
+	}
+	delete[] pcMesh->mVertices;
+	pcMesh->mVertices = pcVertices;
+
+	delete[] pcMesh->mNormals;
+	pcMesh->mNormals = pcNormals;
+
+	delete[] pcMesh->mTextureCoords[0];
+	pcMesh->mTextureCoords[0] = pcUVs;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiNode* TerrainMeshBuilder::BuildTile( const aiMesh* pGrid, unsigned int pWidth, unsigned int pX0, unsigned int pY0,
+	unsigned int pX1, unsigned int pY1, std::vector<aiMesh*>& poMeshes, aiNode* pNode) const
+{
+	aiNode* tile = new aiNode();
+	tile->mParent = pNode;
+	tile->mName.length = ::snprintf(tile->mName.data,MAXLEN,"tile_%u_%u",pX0 / mTileSize,pY0 / mTileSize);
+
+	// each level of detail skips every second row and column of the previous one,
+	// but always keeps the last row and column so that neighbouring tiles match
+	const unsigned int firstMesh = static_cast<unsigned int>(poMeshes.size());
+	std::vector<unsigned int> columns, rows;
+	for (unsigned int level = 0; level <= mNumLODLevels;++level)	{
+		const unsigned int step = 1u << level;
+
+		columns.clear();
+		for (unsigned int x = pX0; x < pX1; x += step) {
+			columns.push_back(x);
+		}
+		columns.push_back(pX1);
+
+		rows.clear();
+		for (unsigned int y = pY0; y < pY1; y += step) {
+			rows.push_back(y);
+		}
+		rows.push_back(pY1);
+
+		aiMesh* mesh = BuildTileMesh(pGrid,pWidth,columns,rows);
+		mesh->mName = tile->mName;
+		poMeshes.push_back(mesh);
+
+		// a single quad can't get any coarser
+		if (2 == columns.size() && 2 == rows.size()) {
+			break;
+		}
+	}
+	const unsigned int numLevels = static_cast<unsigned int>(poMeshes.size()) - firstMesh;
+
+	// compute the bounding box of the tile from the full resolution mesh
+	const aiMesh* full = poMeshes[firstMesh];
+	aiVector3D min,max;
+	ArrayBounds(full->mVertices,full->mNumVertices,min,max);
+
+	tile->mMetaData = new aiMetadata(2);
+	tile->mMetaData->Set(0,"min",min);
+	tile->mMetaData->Set(1,"max",max);
+
+	// a child node for each level of detail if there are multiple
+	if (numLevels > 1)	{
+		tile->mChildren = new aiNode*[tile->mNumChildren = numLevels];
+		for (unsigned int i = 0; i < numLevels;++i)	{
+			aiNode* nd = tile->mChildren[i] = new aiNode();
+			nd->mParent = tile;
+			nd->mName.length = ::snprintf(nd->mName.data,MAXLEN,"%s_lod%u",tile->mName.data,i);
+			nd->mMeshes = new unsigned int[nd->mNumMeshes = 1];
+			nd->mMeshes[0] = firstMesh+i;
+			poMeshes[firstMesh+i]->mName = nd->mName;
+		}
+	}
+	else {
+		tile->mMeshes = new unsigned int[tile->mNumMeshes = 1];
+		tile->mMeshes[0] = firstMesh;
+	}
+	return tile;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiMesh* TerrainMeshBuilder::BuildTileMesh( const aiMesh* pGrid, unsigned int pWidth, 
+	const std::vector<unsigned int>& pColumns, const std::vector<unsigned int>& pRows) const
+{
+	const unsigned int numColumns = static_cast<unsigned int>(pColumns.size());
+	const unsigned int numRows = static_cast<unsigned int>(pRows.size());
+
+	aiMesh* mesh = new aiMesh();
+	mesh->mMaterialIndex = pGrid->mMaterialIndex;
+	mesh->mNumVertices = numColumns*numRows;
+	mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+	if (pGrid->mNormals) {
+		mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+	}
+	if (pGrid->mTextureCoords[0]) {
+		mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+		mesh->mNumUVComponents[0] = pGrid->mNumUVComponents[0];
+	}
+
+	// copy the vertices, row by row
+	unsigned int n = 0;
+	for (unsigned int y = 0; y < numRows;++y)	{
+		for (unsigned int x = 0; x < numColumns;++x,++n)	{
+			const unsigned int src = pRows[y]*pWidth + pColumns[x];
+
+			mesh->mVertices[n] = pGrid->mVertices[src];
+			if (mesh->mNormals) {
+				mesh->mNormals[n] = pGrid->mNormals[src];
+			}
+			if (mesh->mTextureCoords[0]) {
+				mesh->mTextureCoords[0][n] = pGrid->mTextureCoords[0][src];
+			}
+		}
+	}
+
+	// build quads with the same winding as BuildSingleMesh() does. 
+	// All indices are allocated at once if the grid shares its indices.
+	mesh->mNumFaces = (numColumns-1)*(numRows-1);
+	mesh->mFaces = new aiFace[mesh->mNumFaces];
+	for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+		mesh->mFaces[i].mNumIndices = 4;
+	}
+	AllocateFaceIndices(mesh,pGrid->HasSharedFaceIndices());
+
+	aiFace* face = mesh->mFaces;
+	for (unsigned int y = 0; y < numRows-1;++y)	{
+		for (unsigned int x = 0; x < numColumns-1;++x,++face)	{
+			face->mIndices[0] = y*numColumns + x;
+			face->mIndices[1] = (y+1)*numColumns + x;
+			face->mIndices[2] = (y+1)*numColumns + x+1;
+			face->mIndices[3] = y*numColumns + x+1;
+		}
+	}
+	return mesh;
+}
@@ -0,0 +1,135 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file TerrainMeshBuilder.h
+ *  Declares TerrainMeshBuilder, a utility shared by the terrain importers
+ *  to turn a regular grid of vertices into output meshes.
+ */
+#ifndef AI_TERRAINMESHBUILDER_H_INC
+#define AI_TERRAINMESHBUILDER_H_INC
+
+#include <vector>
+
+struct aiScene;
+struct aiNode;
+struct aiMesh;
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** Builds the meshes for a heightfield given as a grid of vertices.
+ *
+ *  By default the whole terrain becomes a single mesh of quads with four
+ *  unshared vertices each, which is what the terrain importers have always
+ *  returned. With a tile size set, the terrain is split into square tiles 
+ *  of indexed quads sharing their vertices, each with an own node, a
+ *  node describing its bounding box and optionally coarser levels of detail.
+ *  The scene is flagged as #AI_SCENE_FLAGS_NON_VERBOSE_FORMAT then.
+ *  See #AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE and 
+ *  #AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS.
+ */
+class TerrainMeshBuilder
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** @param pTileSize Maximum number of quads along each edge of a 
+	 *    tile. 0 builds a single mesh with unshared vertices.
+	 *  @param pNumLODLevels Number of coarser levels of detail to build
+	 *    per tile in addition to the full resolution one.
+	 */
+	TerrainMeshBuilder( unsigned int pTileSize = 0, unsigned int pNumLODLevels = 0);
+
+	// -------------------------------------------------------------------
+	/** Builds the output meshes of a terrain.
+	 *
+	 * @param pScene Scene containing a single mesh, which holds the 
+	 *   vertices of the grid row by row, optionally with normals and
+	 *   texture coordinates in the first channel, but no faces. This mesh
+	 *   is replaced by the output meshes.
+	 * @param pWidth Number of vertices in each row, at least 2.
+	 * @param pHeight Number of rows, at least 2.
+	 * @param pNode Node to receive the output: the single mesh or a child
+	 *   node per tile. 
+	 */
+	void Build( aiScene* pScene, unsigned int pWidth, unsigned int pHeight, aiNode* pNode) const;
+
+protected:
+
+	// -------------------------------------------------------------------
+	/** Expands the grid in place into a list of quads with four vertices
+	 *  each, the traditional output of the terrain importers. */
+	void BuildSingleMesh( aiMesh* pGrid, unsigned int pWidth, unsigned int pHeight) const;
+
+	// -------------------------------------------------------------------
+	/** Builds a mesh of shared vertices for a part of the grid. 
+	 * @param pGrid The grid mesh
+	 * @param pWidth Number of vertices in each row of the grid
+	 * @param pColumns Grid columns to take vertices from, ascending
+	 * @param pRows Grid rows to take vertices from, ascending
+	 */
+	aiMesh* BuildTileMesh( const aiMesh* pGrid, unsigned int pWidth, 
+		const std::vector<unsigned int>& pColumns, const std::vector<unsigned int>& pRows) const;
+
+	// -------------------------------------------------------------------
+	/** Builds the meshes and the nodes of a single tile.
+	 * @param pGrid The grid mesh
+	 * @param pWidth Number of vertices in each row of the grid
+	 * @param pX0, pY0 First column and row of the tile
+	 * @param pX1, pY1 Last column and row of the tile
+	 * @param poMeshes Receives the meshes of the tile
+	 * @param pNode Parent node for the tile node
+	 * @return The node of the tile
+	 */
+	aiNode* BuildTile( const aiMesh* pGrid, unsigned int pWidth, unsigned int pX0, unsigned int pY0,
+		unsigned int pX1, unsigned int pY1, std::vector<aiMesh*>& poMeshes, aiNode* pNode) const;
+
+protected:
+
+	/** Maximum number of quads along each edge of a tile, 0 for no tiling */
+	unsigned int mTileSize;
+
+	/** Number of coarser levels of detail per tile */
+	unsigned int mNumLODLevels;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_TERRAINMESHBUILDER_H_INC
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssimpPCH.h"
 #include "TextureTransform.h"
+#include "VertexTransform.h"
 
 using namespace Assimp;
 
@@ -500,8 +501,7 @@ void TextureTransformStep::Execute( aiScene* pScene)
 			else mesh->mTextureCoords[n] = new aiVector3D[mesh->mNumVertices];
 
 			aiVector3D* src = old[(*it).uvIndex];
-			aiVector3D* dest, *end;
-			dest = mesh->mTextureCoords[n];
+			aiVector3D* dest = mesh->mTextureCoords[n];
 
 			ai_assert(NULL != src);
 
@@ -509,8 +509,6 @@ void TextureTransformStep::Execute( aiScene* pScene)
 			if (dest != src)
 				::memcpy(dest,src,sizeof(aiVector3D)*mesh->mNumVertices);
 
-			end = dest + mesh->mNumVertices;
-
 			// Build a transformation matrix and transform all UV coords with it
 			if (!(*it).IsUntransformed()) {
 				const aiVector2D& trl = (*it).mTranslation;
@@ -534,13 +532,7 @@ void TextureTransformStep::Execute( aiScene* pScene)
 				m5.a3 += trl.x; m5.b3 += trl.y;
 				matrix = m2 * m4 * matrix * m3 * m5;
 				
-				for (src = dest; src != end; ++src)	{ /* manual homogenious divide */
-					src->z = 1.f;
-					*src = matrix * *src;
-					src->x /= src->z;
-					src->y /= src->z;
-					src->z = 0.f;
-				}
+				TransformUVCoords(matrix,dest,mesh->mNumVertices);
 			}
 
 			// Update all UV indices
@@ -75,6 +75,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Get storage for the indices of an output face, from the shared index block if there is one
+static inline unsigned int* NewFaceIndices(unsigned int*& cur, unsigned int num)
+{
+	if (!cur) {
+		return new unsigned int[num];
+	}
+	unsigned int* const ret = cur;
+	cur += num;
+	return ret;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 TriangulateProcess::TriangulateProcess()
@@ -105,6 +117,7 @@ void TriangulateProcess::Execute( aiScene* pScene)
 	bool bHas = false;
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
 	{
+		CheckImportCancelled();
 		if(	TriangulateMesh( pScene->mMeshes[a]))
 			bHas = true;
 	}
@@ -135,8 +148,9 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 		return false;
 	}
 
-	// Find out how many output faces we'll get
+	// Find out how many output faces and indices we'll get
 	unsigned int numOut = 0, max_out = 0;
+	size_t numOutIndices = 0;
 	bool get_normals = true;
 	for( unsigned int a = 0; a < pMesh->mNumFaces; a++)	{
 		aiFace& face = pMesh->mFaces[a];
@@ -145,10 +159,11 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 		}
 		if( face.mNumIndices <= 3) {
 			numOut++;
-
+			numOutIndices += face.mNumIndices;
 		}	
 		else {
 			numOut += face.mNumIndices-2;
+			numOutIndices += (face.mNumIndices-2)*3;
 			max_out = std::max(max_out,face.mNumIndices);
 		}
 	}
@@ -169,7 +184,12 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 	pMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
 	pMesh->mPrimitiveTypes &= ~aiPrimitiveType_POLYGON;
 
+	// if the input shares its indices, all output indices go to a single block, see 
+	// aiMesh::mFaceIndices. Slots of triangles dropped later are not reused, so this
+	// is an upper bound. Otherwise each output face gets its own array as usual.
+	const bool shared = pMesh->HasSharedFaceIndices();
 	aiFace* out = new aiFace[numOut](), *curOut = out;
+	unsigned int* outIndices = shared ? new unsigned int[numOutIndices] : NULL, *curIndices = outIndices;
 	std::vector<aiVector3D> temp_verts3d(max_out+2); /* temporary storage for vertices */
 	std::vector<aiVector2D> temp_verts(max_out+2);
 
@@ -214,9 +234,14 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 		{
 			aiFace& nface = *curOut++;
 			nface.mNumIndices = face.mNumIndices;
-			nface.mIndices    = face.mIndices;
-
-			face.mIndices = NULL;
+			if (shared) {
+				nface.mIndices = NewFaceIndices(curIndices,face.mNumIndices);
+				::memcpy(nface.mIndices,face.mIndices,face.mNumIndices*sizeof(unsigned int));
+			}
+			else {
+				nface.mIndices = face.mIndices;
+				face.mIndices = NULL;
+			}
 			continue;
 		}  
 		// optimized code for quadrilaterals
@@ -253,7 +278,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 	
 			aiFace& nface = *curOut++;
 			nface.mNumIndices = 3;
-			nface.mIndices = face.mIndices;
+			nface.mIndices = NewFaceIndices(curIndices,3);
 
 			nface.mIndices[0] = temp[start_vertex];
 			nface.mIndices[1] = temp[(start_vertex + 1) % 4];
@@ -261,14 +286,11 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 
 			aiFace& sface = *curOut++;
 			sface.mNumIndices = 3;
-			sface.mIndices = new unsigned int[3];
+			sface.mIndices = NewFaceIndices(curIndices,3);
 
 			sface.mIndices[0] = temp[start_vertex];
 			sface.mIndices[1] = temp[(start_vertex + 2) % 4];
 			sface.mIndices[2] = temp[(start_vertex + 3) % 4];
-		
-			// prevent double deletion of the indices field
-			face.mIndices = NULL;
 			continue;
 		} 
 		else
@@ -422,8 +444,9 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 						aiFace& nface = *curOut++;
 
 						nface.mNumIndices = 3;
-						if (!nface.mIndices)
-							nface.mIndices = new unsigned int[3];
+						if (!nface.mIndices) {
+							nface.mIndices = NewFaceIndices(curIndices,3);
+						}
 
 						nface.mIndices[0] = 0;
 						nface.mIndices[1] = tmp+1;
@@ -438,7 +461,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 				nface.mNumIndices = 3;
 
 				if (!nface.mIndices) {
-					nface.mIndices = new unsigned int[3];
+					nface.mIndices = NewFaceIndices(curIndices,3);
 				}
 
 				// setup indices for the new triangle ...
@@ -455,7 +478,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 				aiFace& nface = *curOut++;
 				nface.mNumIndices = 3;
 				if (!nface.mIndices) {
-					nface.mIndices = new unsigned int[3];
+					nface.mIndices = NewFaceIndices(curIndices,3);
 				}
 
 				for (tmp = 0; done[tmp]; ++tmp);
@@ -490,7 +513,10 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 				DefaultLogger::get()->debug("Dropping triangle with area 0");
 				--curOut;
 
-				delete[] f->mIndices;
+				// a slot in the shared block is simply left unused
+				if (!shared) {
+					delete[] f->mIndices;
+				}
 				f->mIndices = NULL;
 
 				for(aiFace* ff = f; ff != curOut; ++ff) {
@@ -506,9 +532,6 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 			i[2] = idx[i[2]];
 			++f;
 		}
-
-		delete[] face.mIndices;
-		face.mIndices = NULL; 
 	}
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -516,10 +539,11 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 #endif
 
 	// kill the old faces
-	delete [] pMesh->mFaces;
+	pMesh->DeleteFaces();
 
 	// ... and store the new ones
 	pMesh->mFaces    = out;
+	pMesh->mFaceIndices = outIndices;
 	pMesh->mNumFaces = (unsigned int)(curOut-out); /* not necessarily equal to numOut */
 	return true;
 }
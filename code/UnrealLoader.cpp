@@ -55,6 +55,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "fast_atof.h"
 #include "ConvertToLHProcess.h"
+#include "MorphTargetHelper.h"
 
 using namespace Assimp;
 
@@ -77,6 +78,7 @@ static const aiImporterDesc desc = {
 UnrealImporter::UnrealImporter()
 :	configFrameID	(0)
 ,	configHandleFlags (true)
+,	configMorphTargets (false)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -112,6 +114,9 @@ void UnrealImporter::SetupProperties(const Importer* pImp)
 
 	// AI_CONFIG_IMPORT_UNREAL_HANDLE_FLAGS, default is true
 	configHandleFlags = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_UNREAL_HANDLE_FLAGS,1));
+
+	// AI_CONFIG_IMPORT_MORPH_TARGETS
+	configMorphTargets = (0 != pImp->GetPropertyInteger(AI_CONFIG_IMPORT_MORPH_TARGETS,0));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -170,7 +175,7 @@ void UnrealImporter::InternReadFile( const std::string& pFile,
 		for (unsigned int i = 0; i < 3;++i)	{
 
 			tri.mVertex[i] = d_reader.GetI2();
-			if (tri.mVertex[i] >= numTris)	{
+			if (tri.mVertex[i] >= numVert)	{
 				DefaultLogger::get()->warn("UNREAL: vertex index out of range");
 				tri.mVertex[i] = 0;
 			}
@@ -210,15 +215,17 @@ void UnrealImporter::InternReadFile( const std::string& pFile,
 	if (st != numVert*4)
 		throw DeadlyImportError("UNREAL: Unexpected aniv file length");
 
-	// skip to our frame
-	a_reader.IncPtr(configFrameID *numVert*4);
+	// skip to our frame - or read all of them
+	const uint32_t firstFrame = configMorphTargets ? 0 : configFrameID;
+	a_reader.IncPtr(firstFrame *numVert*4);
 
 	// collect vertices
-	std::vector<aiVector3D> vertices(numVert);
+	std::vector<aiVector3D> vertices(numVert * (configMorphTargets ? numFrames : 1));
 	for (std::vector<aiVector3D>::iterator it = vertices.begin(), end = vertices.end(); it != end; ++it)	{
 		int32_t val = a_reader.GetI4();
 		Unreal::DecompressVertex(*it,val);
 	}
+	const aiVector3D* baseVertices = &vertices[(configFrameID - firstFrame) * numVert];
 
 	// list of textures. 
 	std::vector< std::pair<unsigned int, std::string> > textures; 
@@ -410,6 +417,9 @@ void UnrealImporter::InternReadFile( const std::string& pFile,
 		}
 	}
 
+	// source vertex for each output vertex, used to setup the morph targets
+	std::vector< std::vector<unsigned int> > vertexIndices(configMorphTargets ? pScene->mNumMeshes : 0);
+
 	// fill them.
 	for (std::vector<Unreal::Triangle>::iterator it = triangles.begin(), end = triangles.end();it != end; ++it)	{
 		Unreal::Triangle& tri = *it;
@@ -423,9 +433,28 @@ void UnrealImporter::InternReadFile( const std::string& pFile,
 		for (unsigned int i = 0; i < 3;++i,mesh->mNumVertices++) {
 			f.mIndices[i] = mesh->mNumVertices;
 
-			mesh->mVertices[mesh->mNumVertices] = vertices[ tri.mVertex[i] ];
+			mesh->mVertices[mesh->mNumVertices] = baseVertices[ tri.mVertex[i] ];
 			mesh->mTextureCoords[0][mesh->mNumVertices] = aiVector3D( tri.mTex[i][0] / 255.f, 1.f - tri.mTex[i][1] / 255.f, 0.f);
+
+			if (configMorphTargets) {
+				vertexIndices[nt-materials.begin()].push_back(tri.mVertex[i]);
+			}
+		}
+	}
+
+	// copy the vertices of all frames to the anim meshes, if requested
+	if (configMorphTargets) {
+		for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
+			aiMesh* mesh = pScene->mMeshes[i];
+
+			AllocateMorphTargets(mesh,numFrames);
+			for (unsigned int f = 0; f < numFrames;++f) {
+				for (unsigned int a = 0; a < mesh->mNumVertices;++a) {
+					mesh->mAnimMeshes[f]->mVertices[a] = vertices[f * numVert + vertexIndices[i][a]];
+				}
+			}
 		}
+		AddMorphTargetAnimation(pScene,0.);
 	}
 
 	// convert to RH
@@ -194,6 +194,9 @@ private:
 	//! process surface flags
 	bool configHandleFlags;
 
+	//! import all frames as morph targets
+	bool configMorphTargets;
+
 }; // !class UnrealImporter
 
 } // end of namespace Assimp
@@ -51,15 +51,161 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BaseImporter.h"
 #include "fast_atof.h"
 #include "ProcessHelper.h"
+#include "ParallelFor.h"
+#include "TinyFormatter.h"
 
 // CRT headers
 #include <stdarg.h>
 
 using namespace Assimp;
 
+// Below this number of faces, bone weights and animation keys in total
+// validating on a single thread is faster than starting worker threads.
+static const unsigned int AI_VDS_PARALLEL_THRESHOLD = 50000;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Enumerates the indices of the array elements to be checked.
+ *
+ *  If samples is 0 or not smaller than the array size, all elements are visited in order.
+ *  Otherwise the array is split into 'samples' ranges of equal size and one pseudo-random
+ *  element of each range is picked, except for the last range, which yields the last 
+ *  element of the array. The choice only depends on the array size, so the validation
+ *  of a given scene is reproducible.
+ */
+class SampleIterator
+{
+public:
+	SampleIterator(unsigned int size, unsigned int samples)
+		: size(size)
+		, samples(samples < size ? samples : 0)
+		, range()
+		, seed(size)
+		, cur()
+	{
+		if (this->samples) {
+			Pick();
+		}
+	}
+
+	bool End() const {
+		return cur >= size;
+	}
+
+	unsigned int operator* () const {
+		return cur;
+	}
+
+	void Next() {
+		if (!samples) {
+			++cur;
+		}
+		else if (++range == samples) {
+			cur = size;
+		}
+		else Pick();
+	}
+
+private:
+
+	void Pick() {
+		const unsigned int begin = static_cast<unsigned int>(static_cast<ai_uint64>(size) * range / samples);
+		const unsigned int end = static_cast<unsigned int>(static_cast<ai_uint64>(size) * (range+1) / samples);
+		if (range+1 == samples) {
+			cur = end-1;
+			return;
+		}
+		seed = seed * 1664525u + 1013904223u;
+		cur = begin + (seed >> 8) % (end-begin);
+	}
+
+	const unsigned int size, samples;
+	unsigned int range, seed, cur;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Estimate the work to validate a mesh or an animation, in checked elements. This runs
+// before the data has been validated, so NULL arrays and entries are simply skipped -
+// Validate() reports them later.
+inline unsigned int GetValidationWork(const aiMesh* mesh, unsigned int samples)
+{
+	unsigned int work = samples ? std::min(samples,mesh->mNumFaces) : mesh->mNumFaces;
+	for (unsigned int i = 0; mesh->mBones && i < mesh->mNumBones; ++i) {
+		if (!mesh->mBones[i]) {
+			continue;
+		}
+		const unsigned int n = mesh->mBones[i]->mNumWeights;
+		work += samples ? std::min(samples,n) : n;
+	}
+	return work;
+}
+
+inline unsigned int GetValidationWork(const aiAnimation* anim, unsigned int samples)
+{
+	unsigned int work = 0;
+	for (unsigned int i = 0; anim->mChannels && i < anim->mNumChannels; ++i) {
+		const aiNodeAnim* chan = anim->mChannels[i];
+		if (!chan) {
+			continue;
+		}
+		const unsigned int n = chan->mNumPositionKeys + chan->mNumRotationKeys + chan->mNumScalingKeys;
+		work += samples ? std::min(3*samples,n) : n;
+	}
+	return work;
+}
+
+} // ! anon namespace
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Validates one entry of a mesh or animation array for ParallelFor(). Each job runs 
+ *  on its own ValidateDSProcess and collects its warnings, as the logger may only be used
+ *  from one thread at a time. */
+template <typename T>
+class ValidateDSJob
+{
+public:
+	ValidateDSJob(const ValidateDSProcess& parent, T** array, unsigned int size)
+		: parent(parent)
+		, array(array)
+		, warnings(size)
+	{}
+
+	void operator() (unsigned int i) {
+		ValidateDSProcess ctx;
+		ctx.mScene = parent.mScene;
+		ctx.configSamples = parent.configSamples;
+		ctx.mWarnings = &warnings[i];
+		ctx.Validate(array[i]);
+	}
+
+	// log all warnings in the order of the array entries
+	void FlushWarnings() {
+		for (std::vector< std::vector<std::string> >::const_iterator it = warnings.begin(); it != warnings.end(); ++it) {
+			for (std::vector<std::string>::const_iterator it2 = (*it).begin(); it2 != (*it).end(); ++it2) {
+				DefaultLogger::get()->warn(*it2);
+			}
+		}
+		warnings.clear();
+	}
+
+private:
+	const ValidateDSProcess& parent;
+	T** const array;
+	std::vector< std::vector<std::string> > warnings;
+};
+
+} // ! Assimp
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ValidateDSProcess::ValidateDSProcess()
+	: mScene()
+	, configSamples()
+	, configThreads(1)
+	, mWarnings()
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -73,6 +219,15 @@ bool ValidateDSProcess::IsActive( unsigned int pFlags) const
 {
 	return (pFlags & aiProcess_ValidateDataStructure) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup import configuration
+void ValidateDSProcess::SetupProperties(const Importer* pImp)
+{
+	configSamples = pImp->GetPropertyInteger(AI_CONFIG_PP_VDS_SAMPLES,0);
+	configThreads = GetWorkerThreadCount(pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,-1));
+}
+
 // ------------------------------------------------------------------------------------------------
 AI_WONT_RETURN void ValidateDSProcess::ReportError(const char* msg,...)
 {
@@ -104,6 +259,10 @@ void ValidateDSProcess::ReportWarning(const char* msg,...)
 	ai_assert(iLen > 0);
 
 	va_end(args);
+	if (mWarnings) {
+		mWarnings->push_back("Validation warning: " + std::string(szBuffer,iLen));
+		return;
+	}
 	DefaultLogger::get()->warn("Validation warning: " + std::string(szBuffer,iLen));
 }
 
@@ -199,19 +358,64 @@ inline void ValidateDSProcess::DoValidationWithNameCheck(T** array,
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+inline void ValidateDSProcess::DoParallelValidation(T** parray, unsigned int size, 
+	const char* firstName, const char* secondName)
+{
+	if (!parray)	{
+		ReportError("aiScene::%s is NULL (aiScene::%s is %i)",
+			firstName, secondName, size);
+	}
+	unsigned int work = 0;
+	for (unsigned int i = 0; i < size;++i)
+	{
+		if (!parray[i])
+		{
+			ReportError("aiScene::%s[%i] is NULL (aiScene::%s is %i)",
+				firstName,i,secondName,size);
+		}
+		// the estimate is only needed to decide whether to use worker threads
+		if (configThreads > 1) {
+			work += GetValidationWork(parray[i],configSamples);
+		}
+	}
+
+	if (configThreads <= 1 || size == 1 || work < AI_VDS_PARALLEL_THRESHOLD) {
+		for (unsigned int i = 0; i < size;++i) {
+			Validate(parray[i]);
+		}
+		return;
+	}
+
+	ValidateDSJob<T> job(*this,parray,size);
+	try {
+		ParallelFor(size,configThreads,job);
+	}
+	catch (const DeadlyImportError&) {
+		job.FlushWarnings();
+		throw;
+	}
+	job.FlushWarnings();
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void ValidateDSProcess::Execute( aiScene* pScene)
 {
 	this->mScene = pScene;
 	DefaultLogger::get()->debug("ValidateDataStructureProcess begin");
+	if (configSamples) {
+		DefaultLogger::get()->debug((Formatter::format("ValidateDataStructureProcess: checking "),
+			configSamples," samples per mesh, bone and animation channel"));
+	}
 	
 	// validate the node graph of the scene
 	Validate(pScene->mRootNode);
 	
 	// validate all meshes
 	if (pScene->mNumMeshes) {
-		DoValidation(pScene->mMeshes,pScene->mNumMeshes,"mMeshes","mNumMeshes");
+		DoParallelValidation(pScene->mMeshes,pScene->mNumMeshes,"mMeshes","mNumMeshes");
 	}
 	else if (!(mScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE))	{
 		ReportError("aiScene::mNumMeshes is 0. At least one mesh must be there");
@@ -222,7 +426,7 @@ void ValidateDSProcess::Execute( aiScene* pScene)
 	
 	// validate all animations
 	if (pScene->mNumAnimations) {
-		DoValidation(pScene->mAnimations,pScene->mNumAnimations,
+		DoParallelValidation(pScene->mAnimations,pScene->mNumAnimations,
 			"mAnimations","mNumAnimations");
 	}
 	else if (pScene->mAnimations)	{
@@ -320,8 +524,15 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 
 	Validate(&pMesh->mName);
 
-	for (unsigned int i = 0; i < pMesh->mNumFaces; ++i)
+	// faces, too
+	if (!pMesh->mNumFaces || (!pMesh->mFaces && !mScene->mFlags))	{
+		ReportError("Mesh contains no faces");
+	}
+
+	// in the fast mode only some of the faces are looked at
+	for (SampleIterator it(pMesh->mFaces ? pMesh->mNumFaces : 0,configSamples); !it.End(); it.Next())
 	{
+		const unsigned int i = *it;
 		aiFace& face = pMesh->mFaces[i];
 
 		if (pMesh->mPrimitiveTypes)
@@ -382,17 +593,16 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 		ReportError("If there are tangents, bitangent vectors must be present as well");
 	}
 
-	// faces, too
-	if (!pMesh->mNumFaces || (!pMesh->mFaces && !mScene->mFlags))	{
-		ReportError("Mesh contains no faces");
-	}
-
 	// now check whether the face indexing layout is correct:
-	// unique vertices, pseudo-indexed.
+	// unique vertices, pseudo-indexed. This needs to look at
+	// all faces, so the fast mode just checks the index range.
 	std::vector<bool> abRefList;
-	abRefList.resize(pMesh->mNumVertices,false);
-	for (unsigned int i = 0; i < pMesh->mNumFaces;++i)
+	if (!configSamples) {
+		abRefList.resize(pMesh->mNumVertices,false);
+	}
+	for (SampleIterator it(pMesh->mFaces ? pMesh->mNumFaces : 0,configSamples); !it.End(); it.Next())
 	{
+		const unsigned int i = *it;
 		aiFace& face = pMesh->mFaces[i];
 		if (face.mNumIndices > AI_MAX_FACE_INDICES) {
 			ReportError("Face %u has too many faces: %u, but the limit is %u",i,face.mNumIndices,AI_MAX_FACE_INDICES);
@@ -403,6 +613,9 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 			if (face.mIndices[a] >= pMesh->mNumVertices)	{
 				ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range",i,a);
 			}
+			if (configSamples) {
+				continue;
+			}
 			// the MSB flag is temporarily used by the extra verbose
 			// mode to tell us that the JoinVerticesProcess might have 
 			// been executed already.
@@ -416,12 +629,14 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 	}
 
 	// check whether there are vertices that aren't referenced by a face
-	bool b = false;
-	for (unsigned int i = 0; i < pMesh->mNumVertices;++i)	{
-		if (!abRefList[i])b = true;
+	if (!configSamples) {
+		bool b = false;
+		for (unsigned int i = 0; i < pMesh->mNumVertices;++i)	{
+			if (!abRefList[i])b = true;
+		}
+		abRefList.clear();
+		if (b)ReportWarning("There are unreferenced vertices");
 	}
-	abRefList.clear();
-	if (b)ReportWarning("There are unreferenced vertices");
 
 	// texture channel 2 may not be set if channel 1 is zero ...
 	{
@@ -461,8 +676,9 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 			ReportError("aiMesh::mBones is NULL (aiMesh::mNumBones is %i)",
 				pMesh->mNumBones);
 		}
+		// the weight sums are only checked in the full mode
 		boost::scoped_array<float> afSum(NULL);
-		if (pMesh->mNumVertices)
+		if (pMesh->mNumVertices && !configSamples)
 		{
 			afSum.reset(new float[pMesh->mNumVertices]);
 			for (unsigned int i = 0; i < pMesh->mNumVertices;++i)
@@ -473,17 +689,19 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 		for (unsigned int i = 0; i < pMesh->mNumBones;++i)
 		{
 			const aiBone* bone = pMesh->mBones[i];
-			if (bone->mNumWeights > AI_MAX_BONE_WEIGHTS) {
-				ReportError("Bone %u has too many weights: %u, but the limit is %u",i,bone->mNumWeights,AI_MAX_BONE_WEIGHTS);
-			}
-
-			if (!pMesh->mBones[i])
+			if (!bone)
 			{
 				ReportError("aiMesh::mBones[%i] is NULL (aiMesh::mNumBones is %i)",
 					i,pMesh->mNumBones);
 			}
-			Validate(pMesh,pMesh->mBones[i],afSum.get());
+			if (bone->mNumWeights > AI_MAX_BONE_WEIGHTS) {
+				ReportError("Bone %u has too many weights: %u, but the limit is %u",i,bone->mNumWeights,AI_MAX_BONE_WEIGHTS);
+			}
+			Validate(pMesh,bone,afSum.get());
 
+			if (configSamples) {
+				continue;
+			}
 			for (unsigned int a = i+1; a < pMesh->mNumBones;++a)
 			{
 				if (pMesh->mBones[i]->mName == pMesh->mBones[a]->mName)
@@ -494,7 +712,7 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 			}
 		}
 		// check whether all bone weights for a vertex sum to 1.0 ...
-		for (unsigned int i = 0; i < pMesh->mNumVertices;++i)
+		for (unsigned int i = 0; afSum && i < pMesh->mNumVertices;++i)
 		{
 			if (afSum[i] && (afSum[i] <= 0.94 || afSum[i] >= 1.05))	{
 				ReportWarning("aiMesh::mVertices[%i]: bone weight sum != 1.0 (sum is %f)",i,afSum[i]);
@@ -505,6 +723,51 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 	{
 		ReportError("aiMesh::mBones is non-null although there are no bones");
 	}
+
+	// validate all vertex animation attachments
+	if (pMesh->mNumAnimMeshes)
+	{
+		if (!pMesh->mAnimMeshes)
+		{
+			ReportError("aiMesh::mAnimMeshes is NULL (aiMesh::mNumAnimMeshes is %i)",
+				pMesh->mNumAnimMeshes);
+		}
+		for (unsigned int i = 0; i < pMesh->mNumAnimMeshes;++i)
+		{
+			const aiAnimMesh* anim = pMesh->mAnimMeshes[i];
+			if (!anim)
+			{
+				ReportError("aiMesh::mAnimMeshes[%i] is NULL (aiMesh::mNumAnimMeshes is %i)",
+					i,pMesh->mNumAnimMeshes);
+			}
+			if (anim->mNumVertices != pMesh->mNumVertices)
+			{
+				ReportError("aiMesh::mAnimMeshes[%i]::mNumVertices (%i) is not equal to "
+					"aiMesh::mNumVertices (%i)",i,anim->mNumVertices,pMesh->mNumVertices);
+			}
+			// anim meshes may only replace existing vertex components
+			if ((anim->HasNormals() && !pMesh->HasNormals()) ||
+				(anim->HasTangentsAndBitangents() && !pMesh->HasTangentsAndBitangents()))
+			{
+				ReportError("aiMesh::mAnimMeshes[%i] has vertex components which the mesh "
+					"doesn't have",i);
+			}
+			for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS;++a) {
+				if (anim->HasTextureCoords(a) && !pMesh->HasTextureCoords(a)) {
+					ReportError("aiMesh::mAnimMeshes[%i] has UV channel %i, the mesh doesn't",i,a);
+				}
+			}
+			for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS;++a) {
+				if (anim->HasVertexColors(a) && !pMesh->HasVertexColors(a)) {
+					ReportError("aiMesh::mAnimMeshes[%i] has vertex color channel %i, the mesh doesn't",i,a);
+				}
+			}
+		}
+	}
+	else if (pMesh->mAnimMeshes)
+	{
+		ReportError("aiMesh::mAnimMeshes is non-null although there are no anim meshes");
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -518,15 +781,18 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh,
 	}
 
 	// check whether all vertices affected by this bone are valid
-	for (unsigned int i = 0; i < pBone->mNumWeights;++i)
+	for (SampleIterator it(pBone->mNumWeights,configSamples); !it.End(); it.Next())
 	{
+		const unsigned int i = *it;
 		if (pBone->mWeights[i].mVertexId >= pMesh->mNumVertices)	{
 			ReportError("aiBone::mWeights[%i].mVertexId is out of range",i);
 		}
 		else if (!pBone->mWeights[i].mWeight || pBone->mWeights[i].mWeight > 1.0f)	{
 			ReportWarning("aiBone::mWeights[%i].mWeight has an invalid value",i);
 		}
-		afSum[pBone->mWeights[i].mVertexId] += pBone->mWeights[i].mWeight;
+		if (afSum) {
+			afSum[pBone->mWeights[i].mVertexId] += pBone->mWeights[i].mWeight;
+		}
 	}
 }
 
@@ -552,7 +818,35 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation)
 			Validate(pAnimation, pAnimation->mChannels[i]);
 		}
 	}
-	else ReportError("aiAnimation::mNumChannels is 0. At least one node animation channel must be there.");
+	else if (pAnimation->mChannels) {
+		ReportError("aiAnimation::mChannels is non-null although there are no node animation channels");
+	}
+
+	// validate all mesh animation channels
+	if (pAnimation->mNumMeshChannels)
+	{
+		if (!pAnimation->mMeshChannels)	{
+			ReportError("aiAnimation::mMeshChannels is NULL (aiAnimation::mNumMeshChannels is %i)",
+				pAnimation->mNumMeshChannels);
+		}
+		for (unsigned int i = 0; i < pAnimation->mNumMeshChannels;++i)
+		{
+			if (!pAnimation->mMeshChannels[i])
+			{
+				ReportError("aiAnimation::mMeshChannels[%i] is NULL (aiAnimation::mNumMeshChannels is %i)",
+					i, pAnimation->mNumMeshChannels);
+			}
+			Validate(pAnimation, pAnimation->mMeshChannels[i]);
+		}
+	}
+	else if (pAnimation->mMeshChannels) {
+		ReportError("aiAnimation::mMeshChannels is non-null although there are no mesh animation channels");
+	}
+
+	if (!pAnimation->mNumChannels && !pAnimation->mNumMeshChannels) {
+		ReportError("aiAnimation::mNumChannels and aiAnimation::mNumMeshChannels are 0. "
+			"At least one animation channel must be there.");
+	}
 
 	// Animation duration is allowed to be zero in cases where the anim contains only a single key frame.
 	// if (!pAnimation->mDuration)this->ReportError("aiAnimation::mDuration is zero");
@@ -795,6 +1089,75 @@ void ValidateDSProcess::Validate( const aiTexture* pTexture)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void ValidateDSProcess::ValidateKeys( const aiAnimation* pAnimation,
+	const T* keys, unsigned int numKeys, const char* name)
+{
+	for (SampleIterator it(numKeys,configSamples); !it.End(); it.Next())
+	{
+		const unsigned int i = *it;
+
+		// ScenePreprocessor will compute the duration if still the default value
+		// (Aramis) Add small epsilon, comparison tended to fail if max_time == duration,
+		//  seems to be due the compilers register usage/width.
+		if (pAnimation->mDuration > 0. && keys[i].mTime > pAnimation->mDuration+0.001)
+		{
+			ReportError("aiNodeAnim::%s[%i].mTime (%.5f) is larger "
+				"than aiAnimation::mDuration (which is %.5f)",name,i,
+				(float)keys[i].mTime,
+				(float)pAnimation->mDuration);
+		}
+		if (i && keys[i].mTime <= keys[i-1].mTime)
+		{
+			ReportWarning("aiNodeAnim::%s[%i].mTime (%.5f) is smaller "
+				"than aiAnimation::%s[%i] (which is %.5f)",name,i,
+				(float)keys[i].mTime,
+				name,i-1, (float)keys[i-1].mTime);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
+	 const aiMeshAnim* pMeshAnim)
+{
+	Validate(&pMeshAnim->mName);
+	if (!pMeshAnim->mName.length) {
+		ReportError("aiMeshAnim::mName is empty, animated meshes must be named");
+	}
+
+	if (!pMeshAnim->mNumKeys) {
+		ReportError("Empty mesh animation channel");
+	}
+	if (!pMeshAnim->mKeys) {
+		ReportError("aiMeshAnim::mKeys is NULL (aiMeshAnim::mNumKeys is %i)",
+			pMeshAnim->mNumKeys);
+	}
+	ValidateKeys(pAnimation,pMeshAnim->mKeys,pMeshAnim->mNumKeys,"mKeys");
+
+	// all keys must refer to existing anim meshes of all meshes with this name
+	bool found = false;
+	for (unsigned int i = 0; i < mScene->mNumMeshes;++i)
+	{
+		const aiMesh* mesh = mScene->mMeshes[i];
+		if (mesh->mName != pMeshAnim->mName) {
+			continue;
+		}
+		found = true;
+		for (SampleIterator it(pMeshAnim->mNumKeys,configSamples); !it.End(); it.Next()) {
+			const unsigned int a = *it;
+			if (pMeshAnim->mKeys[a].mValue >= mesh->mNumAnimMeshes) {
+				ReportError("aiMeshAnim::mKeys[%i].mValue (%i) is out of range, aiMesh::mNumAnimMeshes of "
+					"mesh %i is %i",a,pMeshAnim->mKeys[a].mValue,i,mesh->mNumAnimMeshes);
+			}
+		}
+	}
+	if (!found) {
+		ReportWarning("aiMeshAnim %s refers to no existing mesh",pMeshAnim->mName.data);
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
 	 const aiNodeAnim* pNodeAnim)
@@ -812,28 +1175,7 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
 			this->ReportError("aiNodeAnim::mPositionKeys is NULL (aiNodeAnim::mNumPositionKeys is %i)",
 				pNodeAnim->mNumPositionKeys);
 		}
-		double dLast = -10e10;
-		for (unsigned int i = 0; i < pNodeAnim->mNumPositionKeys;++i)
-		{
-			// ScenePreprocessor will compute the duration if still the default value
-			// (Aramis) Add small epsilon, comparison tended to fail if max_time == duration,
-			//  seems to be due the compilers register usage/width.
-			if (pAnimation->mDuration > 0. && pNodeAnim->mPositionKeys[i].mTime > pAnimation->mDuration+0.001)
-			{
-				ReportError("aiNodeAnim::mPositionKeys[%i].mTime (%.5f) is larger "
-					"than aiAnimation::mDuration (which is %.5f)",i,
-					(float)pNodeAnim->mPositionKeys[i].mTime,
-					(float)pAnimation->mDuration);
-			}
-			if (i && pNodeAnim->mPositionKeys[i].mTime <= dLast)
-			{
-				ReportWarning("aiNodeAnim::mPositionKeys[%i].mTime (%.5f) is smaller "
-					"than aiAnimation::mPositionKeys[%i] (which is %.5f)",i,
-					(float)pNodeAnim->mPositionKeys[i].mTime,
-					i-1, (float)dLast);
-			}
-			dLast = pNodeAnim->mPositionKeys[i].mTime;
-		}
+		ValidateKeys(pAnimation,pNodeAnim->mPositionKeys,pNodeAnim->mNumPositionKeys,"mPositionKeys");
 	}
 	// rotation keys
 	if (pNodeAnim->mNumRotationKeys)
@@ -843,25 +1185,7 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
 			this->ReportError("aiNodeAnim::mRotationKeys is NULL (aiNodeAnim::mNumRotationKeys is %i)",
 				pNodeAnim->mNumRotationKeys);
 		}
-		double dLast = -10e10;
-		for (unsigned int i = 0; i < pNodeAnim->mNumRotationKeys;++i)
-		{
-			if (pAnimation->mDuration > 0. && pNodeAnim->mRotationKeys[i].mTime > pAnimation->mDuration+0.001)
-			{
-				ReportError("aiNodeAnim::mRotationKeys[%i].mTime (%.5f) is larger "
-					"than aiAnimation::mDuration (which is %.5f)",i,
-					(float)pNodeAnim->mRotationKeys[i].mTime,
-					(float)pAnimation->mDuration);
-			}
-			if (i && pNodeAnim->mRotationKeys[i].mTime <= dLast)
-			{
-				ReportWarning("aiNodeAnim::mRotationKeys[%i].mTime (%.5f) is smaller "
-					"than aiAnimation::mRotationKeys[%i] (which is %.5f)",i,
-					(float)pNodeAnim->mRotationKeys[i].mTime,
-					i-1, (float)dLast);
-			}
-			dLast = pNodeAnim->mRotationKeys[i].mTime;
-		}
+		ValidateKeys(pAnimation,pNodeAnim->mRotationKeys,pNodeAnim->mNumRotationKeys,"mRotationKeys");
 	}
 	// scaling keys
 	if (pNodeAnim->mNumScalingKeys)
@@ -870,25 +1194,7 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
 			ReportError("aiNodeAnim::mScalingKeys is NULL (aiNodeAnim::mNumScalingKeys is %i)",
 				pNodeAnim->mNumScalingKeys);
 		}
-		double dLast = -10e10;
-		for (unsigned int i = 0; i < pNodeAnim->mNumScalingKeys;++i)
-		{
-			if (pAnimation->mDuration > 0. && pNodeAnim->mScalingKeys[i].mTime > pAnimation->mDuration+0.001)
-			{
-				ReportError("aiNodeAnim::mScalingKeys[%i].mTime (%.5f) is larger "
-					"than aiAnimation::mDuration (which is %.5f)",i,
-					(float)pNodeAnim->mScalingKeys[i].mTime,
-					(float)pAnimation->mDuration);
-			}
-			if (i && pNodeAnim->mScalingKeys[i].mTime <= dLast)
-			{
-				ReportWarning("aiNodeAnim::mScalingKeys[%i].mTime (%.5f) is smaller "
-					"than aiAnimation::mScalingKeys[%i] (which is %.5f)",i,
-					(float)pNodeAnim->mScalingKeys[i].mTime,
-					i-1, (float)dLast);
-			}
-			dLast = pNodeAnim->mScalingKeys[i].mTime;
-		}
+		ValidateKeys(pAnimation,pNodeAnim->mScalingKeys,pNodeAnim->mNumScalingKeys,"mScalingKeys");
 	}
 
 	if (!pNodeAnim->mNumScalingKeys && !pNodeAnim->mNumRotationKeys &&
@@ -51,6 +51,7 @@ struct aiBone;
 struct aiMesh;
 struct aiAnimation;
 struct aiNodeAnim;
+struct aiMeshAnim;
 struct aiTexture;
 struct aiMaterial;
 struct aiNode;
@@ -76,6 +77,34 @@ public:
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 
+	// -------------------------------------------------------------------
+	void SetupProperties(const Importer* pImp);
+
+	// -------------------------------------------------------------------
+	/** @brief Enable the fast validation mode (#AI_CONFIG_PP_VDS_SAMPLES)
+	 *  @param samples Number of faces, bone weights and animation keys
+	 *    to be checked per mesh, bone and animation channel. 0 checks 
+	 *    all of them, which is the default.
+	 */
+	void SetSampleCount(unsigned int samples) {
+		configSamples = samples;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Get the current sample count, 0 for full validation
+	 */
+	unsigned int GetSampleCount() const {
+		return configSamples;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Set the number of threads used to validate meshes and
+	 *   animations. Usually taken from #AI_CONFIG_GLOB_MULTITHREADING.
+	 */
+	void SetThreadCount(unsigned int threads) {
+		configThreads = threads ? threads : 1;
+	}
+
 protected:
 
 	// -------------------------------------------------------------------
@@ -144,6 +173,23 @@ protected:
 	void Validate( const aiAnimation* pAnimation,
 		const aiNodeAnim* pBoneAnim);
 
+	// -------------------------------------------------------------------
+	/** Validates a mesh animation channel
+	 * @param pAnimation Animation channel.
+	 * @param pMeshAnim Input mesh animation */
+	void Validate( const aiAnimation* pAnimation,
+		const aiMeshAnim* pMeshAnim);
+
+	// -------------------------------------------------------------------
+	/** Validates the keys of an animation channel
+	 * @param pAnimation Animation channel.
+	 * @param keys Key array of the channel
+	 * @param numKeys Number of keys in the array
+	 * @param name Name of the key array, i.e. "mPositionKeys" */
+	template <typename T>
+	void ValidateKeys( const aiAnimation* pAnimation,
+		const T* keys, unsigned int numKeys, const char* name);
+
 	// -------------------------------------------------------------------
 	/** Validates a node and all of its subnodes
 	 * @param Node Input node*/
@@ -172,7 +218,24 @@ private:
 	inline void DoValidationWithNameCheck(T** array, unsigned int size, 
 		const char* firstName, const char* secondName);
 
+	// version of the first template that validates the entries
+	// on multiple threads, used for meshes and animations
+	template <typename T>
+	inline void DoParallelValidation(T** array, unsigned int size, 
+		const char* firstName, const char* secondName);
+
+	template <typename T> friend class ValidateDSJob;
+
 	aiScene* mScene;
+
+	//! Configuration option: number of samples, 0 for full validation
+	unsigned int configSamples;
+
+	//! Configuration option: number of worker threads
+	unsigned int configThreads;
+
+	//! Warnings are collected here instead of being logged if non-NULL
+	std::vector<std::string>* mWarnings;
 };
 
 
@@ -0,0 +1,214 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file  VertexInfluences.cpp
+ *  @brief Implementation of the per-vertex bone influence table
+ */
+
+#include "AssimpPCH.h"
+#include "VertexInfluences.h"
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+VertexInfluences::VertexInfluences()
+: mMesh()
+, mNumBones()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+VertexInfluences::VertexInfluences(const aiMesh* pMesh)
+: mMesh()
+, mNumBones()
+{
+	Build(pMesh);
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexInfluences::Build(const aiMesh* pMesh)
+{
+	ai_assert(NULL != pMesh);
+	const unsigned int numVertices = pMesh->mNumVertices;
+
+	// first pass: count the influences on each vertex
+	mRanges.assign(numVertices,Range());
+	for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+		const aiBone* bone = pMesh->mBones[a];
+		for (unsigned int b = 0; b < bone->mNumWeights; ++b) {
+			const unsigned int v = bone->mWeights[b].mVertexId;
+			if (v < numVertices) {
+				++mRanges[v].mCount;
+			}
+		}
+	}
+
+	unsigned int total = 0;
+	for (std::vector<Range>::iterator it = mRanges.begin(), end = mRanges.end(); it != end; ++it) {
+		(*it).mFirst = total;
+		total += (*it).mCount;
+		(*it).mCount = 0;
+	}
+
+	// second pass: scatter the weights, counting up again
+	mInfluences.resize(total);
+	for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+		const aiBone* bone = pMesh->mBones[a];
+		for (unsigned int b = 0; b < bone->mNumWeights; ++b) {
+			const aiVertexWeight& w = bone->mWeights[b];
+			if (w.mVertexId < numVertices) {
+				Range& r = mRanges[w.mVertexId];
+				Influence& inf = mInfluences[r.mFirst + r.mCount++];
+				inf.mBone = a;
+				inf.mWeight = w.mWeight;
+			}
+		}
+	}
+	SetMesh(pMesh);
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexInfluences::Reset(unsigned int pNumVertices, unsigned int pNumInfluences)
+{
+	Clear();
+	mRanges.reserve(pNumVertices);
+	mInfluences.reserve(pNumInfluences);
+}
+
+// ------------------------------------------------------------------------------------------------
+VertexInfluences::Influence* VertexInfluences::AddVertex(unsigned int pCount)
+{
+	Range r;
+	r.mFirst = static_cast<unsigned int>(mInfluences.size());
+	r.mCount = pCount;
+	mRanges.push_back(r);
+
+	if (!pCount) {
+		return NULL;
+	}
+	mInfluences.resize(r.mFirst + pCount);
+	return &mInfluences[r.mFirst];
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexInfluences::SetMesh(const aiMesh* pMesh)
+{
+	ai_assert(!pMesh || pMesh->mNumVertices == mRanges.size());
+	mMesh = pMesh;
+	mNumBones = pMesh ? pMesh->mNumBones : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexInfluences::Clear()
+{
+	mRanges.clear();
+	mInfluences.clear();
+	SetMesh(NULL);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool VertexInfluences::IsValidFor(const aiMesh* pMesh) const
+{
+	return pMesh && mMesh == pMesh && pMesh->mNumVertices == mRanges.size() && pMesh->mNumBones == mNumBones;
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexInfluences::Remap(const std::vector<unsigned int>& pSource)
+{
+	// the influences stay where they are, only the ranges are moved
+	std::vector<Range> ranges(pSource.size());
+	for (unsigned int i = 0; i < ranges.size(); ++i) {
+		ranges[i] = mRanges[pSource[i]];
+	}
+	mRanges.swap(ranges);
+	mMesh = NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexInfluences::WriteBoneWeights(aiMesh* pMesh) const
+{
+	ai_assert(NULL != pMesh);
+
+	// count the weights of each bone
+	std::vector<unsigned int> counts(pMesh->mNumBones,0);
+	for (std::vector<Range>::const_iterator it = mRanges.begin(), end = mRanges.end(); it != end; ++it) {
+		const Influence* inf = mInfluences.empty() ? NULL : &mInfluences[(*it).mFirst];
+		for (unsigned int i = 0; i < (*it).mCount; ++i) {
+			ai_assert(inf[i].mBone < pMesh->mNumBones);
+			++counts[inf[i].mBone];
+		}
+	}
+
+	// make room for them, reusing the old arrays if possible
+	for (unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+		aiBone* bone = pMesh->mBones[a];
+		if (!counts[a]) {
+			delete[] bone->mWeights;
+			bone->mWeights = NULL;
+		}
+		else if (!bone->mWeights || counts[a] > bone->mNumWeights) {
+			delete[] bone->mWeights;
+			bone->mWeights = new aiVertexWeight[counts[a]];
+		}
+		bone->mNumWeights = 0;
+	}
+
+	// and fill them in vertex order
+	for (unsigned int v = 0; v < mRanges.size(); ++v) {
+		const Range& r = mRanges[v];
+		for (unsigned int i = 0; i < r.mCount; ++i) {
+			const Influence& inf = mInfluences[r.mFirst + i];
+			aiBone* bone = pMesh->mBones[inf.mBone];
+
+			aiVertexWeight& w = bone->mWeights[bone->mNumWeights++];
+			w.mVertexId = v;
+			w.mWeight = inf.mWeight;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int VertexInfluences::GetMaxInfluences() const
+{
+	unsigned int m = 0;
+	for (std::vector<Range>::const_iterator it = mRanges.begin(), end = mRanges.end(); it != end; ++it) {
+		m = std::max(m,(*it).mCount);
+	}
+	return m;
+}
@@ -0,0 +1,191 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file VertexInfluences.h
+ *  Flat per-vertex table of the bone influences of a mesh, shared by 
+ *  the post processing steps working on bone weights.
+ */
+#ifndef AI_VERTEXINFLUENCES_H_INC
+#define AI_VERTEXINFLUENCES_H_INC
+
+#include <vector>
+
+struct aiMesh;
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** Stores the bone weights of a mesh per vertex rather than per bone.
+ *
+ *  All influences are kept in a single array, vertex by vertex, each vertex
+ *  refers to its range in this array (compressed sparse rows). Within a
+ *  vertex, influences are ordered by bone index unless a step reorders them.
+ *  Building the table takes two passes over the bones and exactly one 
+ *  allocation per array, no matter how many vertices there are.
+ *
+ *  The table remembers the mesh it was built for, #IsValidFor() rejects it
+ *  once the vertex or bone count of the mesh has changed. Steps which 
+ *  change the bone weights of a mesh in other ways must update or drop the 
+ *  shared tables (#AI_SPP_BONE_INFLUENCES).
+ */
+class VertexInfluences
+{
+public:
+
+	//! A single bone influence on a vertex
+	struct Influence
+	{
+		unsigned int mBone;  ///< Index of the bone in aiMesh::mBones
+		float mWeight;       ///< Weight of the bone on the vertex
+	};
+
+	//! Range of a vertex in the influence array
+	struct Range
+	{
+		unsigned int mFirst;
+		unsigned int mCount;
+	};
+
+public:
+
+	//! Construct an empty table
+	VertexInfluences();
+
+	//! Construct the table for a mesh, see #Build()
+	explicit VertexInfluences(const aiMesh* pMesh);
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Fill the table from the bones of a mesh. Weights referring to
+	 *  vertices out of range are ignored. */
+	void Build(const aiMesh* pMesh);
+
+	// -------------------------------------------------------------------
+	/** Prepare filling the table vertex by vertex using #AddVertex().
+	 *  @param pNumVertices Number of vertices to be added
+	 *  @param pNumInfluences Expected total number of influences */
+	void Reset(unsigned int pNumVertices, unsigned int pNumInfluences);
+
+	// -------------------------------------------------------------------
+	/** Append a vertex to the table.
+	 *  @param pCount Number of influences on the vertex
+	 *  @return Storage for the influences, valid until the next call */
+	Influence* AddVertex(unsigned int pCount);
+
+	// -------------------------------------------------------------------
+	/** Bind the table to a mesh after filling it or after changing the
+	 *  mesh's vertex or bone count accordingly. */
+	void SetMesh(const aiMesh* pMesh);
+
+	// -------------------------------------------------------------------
+	/** Remove all data from the table */
+	void Clear();
+
+	// -------------------------------------------------------------------
+	/** Check whether the table describes a mesh */
+	bool IsValidFor(const aiMesh* pMesh) const;
+
+	// -------------------------------------------------------------------
+	/** Rebuild the table after the vertices of its mesh have been 
+	 *  rearranged. No influences are copied. The table must be bound to
+	 *  the mesh again using #SetMesh() afterwards.
+	 *  @param pSource For each new vertex the index of the old vertex 
+	 *    whose influences it takes over. */
+	void Remap(const std::vector<unsigned int>& pSource);
+
+	// -------------------------------------------------------------------
+	/** Write the table back to the bones of a mesh. 
+	 *
+	 *  The weights of each bone are ordered by vertex index. Weight arrays
+	 *  are only reallocated if they grow. Bones without weights are kept,
+	 *  with mNumWeights set to 0.
+	 *  @param pMesh Mesh to receive the weights. mNumBones must be larger
+	 *    than any bone index in the table. */
+	void WriteBoneWeights(aiMesh* pMesh) const;
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Get the number of vertices in the table */
+	unsigned int GetNumVertices() const {
+		return static_cast<unsigned int>(mRanges.size());
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the number of influences on a vertex */
+	unsigned int GetNumInfluences(unsigned int pVertex) const {
+		return mRanges[pVertex].mCount;
+	}
+
+	// -------------------------------------------------------------------
+	/** Shrink the number of influences on a vertex, the first pCount 
+	 *  influences of the vertex are kept */
+	void SetNumInfluences(unsigned int pVertex, unsigned int pCount) {
+		ai_assert(pCount <= mRanges[pVertex].mCount);
+		mRanges[pVertex].mCount = pCount;
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the influences on a vertex */
+	Influence* GetInfluences(unsigned int pVertex) {
+		return mInfluences.empty() ? NULL : &mInfluences[0] + mRanges[pVertex].mFirst;
+	}
+
+	const Influence* GetInfluences(unsigned int pVertex) const {
+		return mInfluences.empty() ? NULL : &mInfluences[0] + mRanges[pVertex].mFirst;
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the largest number of influences on a single vertex */
+	unsigned int GetMaxInfluences() const;
+
+private:
+
+	std::vector<Range> mRanges;
+	std::vector<Influence> mInfluences;
+
+	// the mesh the table belongs to
+	const aiMesh* mMesh;
+	unsigned int mNumBones;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_VERTEXINFLUENCES_H_INC
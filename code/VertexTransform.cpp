@@ -0,0 +1,254 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file VertexTransform.cpp
+ *  @brief Implementation of the vertex array transformation helpers
+ */
+
+#include "AssimpPCH.h"
+#include "VertexTransform.h"
+
+#if !defined(ASSIMP_BUILD_NO_SSE) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#	define AI_VT_USE_SSE
+#	include <xmmintrin.h>
+#endif
+
+using namespace Assimp;
+
+#ifdef AI_VT_USE_SSE
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Loads four consecutive triples of floats and splits them into one register per element
+inline void LoadVectors(const float* f, __m128& x, __m128& y, __m128& z)
+{
+	// a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+	const __m128 a = _mm_loadu_ps(f), b = _mm_loadu_ps(f+4), c = _mm_loadu_ps(f+8);
+
+	x = _mm_shuffle_ps(a,_mm_shuffle_ps(b,c,_MM_SHUFFLE(1,1,2,2)),_MM_SHUFFLE(2,0,3,0));
+	y = _mm_shuffle_ps(_mm_shuffle_ps(a,b,_MM_SHUFFLE(0,0,1,1)),_mm_shuffle_ps(b,c,_MM_SHUFFLE(2,2,3,3)),_MM_SHUFFLE(2,0,2,0));
+	z = _mm_shuffle_ps(_mm_shuffle_ps(a,b,_MM_SHUFFLE(1,1,2,2)),_mm_shuffle_ps(c,c,_MM_SHUFFLE(3,3,0,0)),_MM_SHUFFLE(2,0,2,0));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void LoadVectors(const aiVector3D* in, __m128& x, __m128& y, __m128& z)
+{
+	LoadVectors(&in->x,x,y,z);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Inverse of LoadVectors()
+inline void StoreVectors(float* f, __m128 x, __m128 y, __m128 z)
+{
+	_mm_storeu_ps(f,  _mm_shuffle_ps(_mm_shuffle_ps(x,y,_MM_SHUFFLE(0,0,0,0)),_mm_shuffle_ps(z,x,_MM_SHUFFLE(1,1,0,0)),_MM_SHUFFLE(2,0,2,0)));
+	_mm_storeu_ps(f+4,_mm_shuffle_ps(_mm_shuffle_ps(y,z,_MM_SHUFFLE(1,1,1,1)),_mm_shuffle_ps(x,y,_MM_SHUFFLE(2,2,2,2)),_MM_SHUFFLE(2,0,2,0)));
+	_mm_storeu_ps(f+8,_mm_shuffle_ps(_mm_shuffle_ps(z,x,_MM_SHUFFLE(3,3,2,2)),_mm_shuffle_ps(y,z,_MM_SHUFFLE(3,3,3,3)),_MM_SHUFFLE(2,0,2,0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void StoreVectors(aiVector3D* out, __m128 x, __m128 y, __m128 z)
+{
+	StoreVectors(&out->x,x,y,z);
+}
+
+// ------------------------------------------------------------------------------------------------
+// r1*x + r2*y + r3*z, summed in the same order as the scalar operators do
+inline __m128 Dot3(const __m128 r[3], __m128 x, __m128 y, __m128 z)
+{
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0],x),_mm_mul_ps(r[1],y)),_mm_mul_ps(r[2],z));
+}
+
+} // ! anon namespace
+#endif // !! AI_VT_USE_SSE
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// v*pScale + pOffset for each component. Adding -0.0f leaves any value unchanged, so that is
+// the offset to be used for components which are only to be scaled.
+void ScaleAndOffset(const aiVector3D& pScale, const aiVector3D& pOffset, aiVector3D* pVectors, 
+	unsigned int pNum)
+{
+	unsigned int i = 0;
+#ifdef AI_VT_USE_SSE
+	// four vectors span three registers, so the component pattern repeats every three registers
+	const __m128 s0 = _mm_setr_ps(pScale.x,pScale.y,pScale.z,pScale.x);
+	const __m128 s1 = _mm_setr_ps(pScale.y,pScale.z,pScale.x,pScale.y);
+	const __m128 s2 = _mm_setr_ps(pScale.z,pScale.x,pScale.y,pScale.z);
+	const __m128 o0 = _mm_setr_ps(pOffset.x,pOffset.y,pOffset.z,pOffset.x);
+	const __m128 o1 = _mm_setr_ps(pOffset.y,pOffset.z,pOffset.x,pOffset.y);
+	const __m128 o2 = _mm_setr_ps(pOffset.z,pOffset.x,pOffset.y,pOffset.z);
+
+	for (; i + 4 <= pNum; i += 4) {
+		float* f = &pVectors[i].x;
+		_mm_storeu_ps(f,  _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(f),  s0),o0));
+		_mm_storeu_ps(f+4,_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(f+4),s1),o1));
+		_mm_storeu_ps(f+8,_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(f+8),s2),o2));
+	}
+#endif
+	for (; i < pNum; ++i) {
+		aiVector3D& v = pVectors[i];
+		v.x = v.x * pScale.x + pOffset.x;
+		v.y = v.y * pScale.y + pOffset.y;
+		v.z = v.z * pScale.z + pOffset.z;
+	}
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::TransformPositions(const aiMatrix4x4& pMat, const aiVector3D* pIn, 
+	aiVector3D* pOut, unsigned int pNum)
+{
+	unsigned int i = 0;
+#ifdef AI_VT_USE_SSE
+	const __m128 rx[3] = {_mm_set1_ps(pMat.a1),_mm_set1_ps(pMat.a2),_mm_set1_ps(pMat.a3)};
+	const __m128 ry[3] = {_mm_set1_ps(pMat.b1),_mm_set1_ps(pMat.b2),_mm_set1_ps(pMat.b3)};
+	const __m128 rz[3] = {_mm_set1_ps(pMat.c1),_mm_set1_ps(pMat.c2),_mm_set1_ps(pMat.c3)};
+	const __m128 tx = _mm_set1_ps(pMat.a4), ty = _mm_set1_ps(pMat.b4), tz = _mm_set1_ps(pMat.c4);
+
+	for (; i + 4 <= pNum; i += 4) {
+		__m128 x, y, z;
+		LoadVectors(pIn+i,x,y,z);
+		StoreVectors(pOut+i,_mm_add_ps(Dot3(rx,x,y,z),tx),_mm_add_ps(Dot3(ry,x,y,z),ty),
+			_mm_add_ps(Dot3(rz,x,y,z),tz));
+	}
+#endif
+	for (; i < pNum; ++i) {
+		pOut[i] = pMat * pIn[i];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::TransformDirections(const aiMatrix3x3& pMat, const aiVector3D* pIn, 
+	aiVector3D* pOut, unsigned int pNum, bool pNormalize)
+{
+	unsigned int i = 0;
+#ifdef AI_VT_USE_SSE
+	const __m128 rx[3] = {_mm_set1_ps(pMat.a1),_mm_set1_ps(pMat.a2),_mm_set1_ps(pMat.a3)};
+	const __m128 ry[3] = {_mm_set1_ps(pMat.b1),_mm_set1_ps(pMat.b2),_mm_set1_ps(pMat.b3)};
+	const __m128 rz[3] = {_mm_set1_ps(pMat.c1),_mm_set1_ps(pMat.c2),_mm_set1_ps(pMat.c3)};
+
+	for (; i + 4 <= pNum; i += 4) {
+		__m128 x, y, z;
+		LoadVectors(pIn+i,x,y,z);
+
+		__m128 nx = Dot3(rx,x,y,z), ny = Dot3(ry,x,y,z), nz = Dot3(rz,x,y,z);
+		if (pNormalize) {
+			// divide rather than multiply with the reciprocal to match aiVector3D::Normalize()
+			const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx,nx),_mm_mul_ps(ny,ny)),_mm_mul_ps(nz,nz)));
+			nx = _mm_div_ps(nx,len);
+			ny = _mm_div_ps(ny,len);
+			nz = _mm_div_ps(nz,len);
+		}
+		StoreVectors(pOut+i,nx,ny,nz);
+	}
+#endif
+	if (pNormalize) {
+		for (; i < pNum; ++i) {
+			pOut[i] = (pMat * pIn[i]).Normalize();
+		}
+	}
+	else {
+		for (; i < pNum; ++i) {
+			pOut[i] = pMat * pIn[i];
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::ScaleComponents(const aiVector3D& pFactors, aiVector3D* pVectors, unsigned int pNum)
+{
+	ScaleAndOffset(pFactors,aiVector3D(-0.f,-0.f,-0.f),pVectors,pNum);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::FlipUVCoords(aiVector3D* pUV, unsigned int pNum)
+{
+	// -v+1 is exactly 1-v
+	ScaleAndOffset(aiVector3D(1.f,-1.f,1.f),aiVector3D(-0.f,1.f,-0.f),pUV,pNum);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::TransformUVCoords(const aiMatrix3x3& pMat, aiVector3D* pUV, unsigned int pNum)
+{
+	unsigned int i = 0;
+#ifdef AI_VT_USE_SSE
+	const __m128 rx[3] = {_mm_set1_ps(pMat.a1),_mm_set1_ps(pMat.a2),_mm_set1_ps(pMat.a3)};
+	const __m128 ry[3] = {_mm_set1_ps(pMat.b1),_mm_set1_ps(pMat.b2),_mm_set1_ps(pMat.b3)};
+	const __m128 rz[3] = {_mm_set1_ps(pMat.c1),_mm_set1_ps(pMat.c2),_mm_set1_ps(pMat.c3)};
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (; i + 4 <= pNum; i += 4) {
+		__m128 x, y, z;
+		LoadVectors(pUV+i,x,y,z);
+
+		const __m128 w = Dot3(rz,x,y,one);
+		StoreVectors(pUV+i,_mm_div_ps(Dot3(rx,x,y,one),w),_mm_div_ps(Dot3(ry,x,y,one),w),_mm_setzero_ps());
+	}
+#endif
+	for (; i < pNum; ++i) {
+		aiVector3D& uv = pUV[i];
+		uv.z = 1.f;
+		uv = pMat * uv;
+		uv.x /= uv.z;
+		uv.y /= uv.z;
+		uv.z = 0.f;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Assimp::ReverseTriangles(unsigned int* pIndices, unsigned int pNum)
+{
+	unsigned int i = 0;
+#ifdef AI_VT_USE_SSE
+	// the shuffles only move the bits around, so the indices may well pass as floats
+	for (; i + 4 <= pNum; i += 4) {
+		float* f = reinterpret_cast<float*>(pIndices + i*3);
+
+		__m128 a, b, c;
+		LoadVectors(f,a,b,c);
+		StoreVectors(f,c,b,a);
+	}
+#endif
+	for (; i < pNum; ++i) {
+		std::swap(pIndices[i*3],pIndices[i*3+2]);
+	}
+}
@@ -0,0 +1,129 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file VertexTransform.h
+ *  Helpers to transform whole arrays of positions, direction vectors,
+ *  texture coordinates and triangle indices, using SSE where available.
+ */
+#ifndef AI_VERTEXTRANSFORM_H_INC
+#define AI_VERTEXTRANSFORM_H_INC
+
+#include "../include/assimp/vector3.h"
+#include "../include/assimp/matrix3x3.h"
+#include "../include/assimp/matrix4x4.h"
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** Transform an array of positions by an affine matrix.
+ *
+ *  The results are bitwise identical to computing pMat * pIn[i] one by one.
+ *  pIn and pOut may point to the same array.
+ *  @param pMat Transformation matrix
+ *  @param pIn Source positions
+ *  @param pOut Receives the transformed positions
+ *  @param pNum Number of positions
+ */
+void TransformPositions(const aiMatrix4x4& pMat, const aiVector3D* pIn, 
+	aiVector3D* pOut, unsigned int pNum);
+
+// ---------------------------------------------------------------------------
+/** Transform an array of direction vectors (normals, tangents) by a 3x3 
+ *  matrix and optionally normalize them.
+ *
+ *  The results are bitwise identical to computing (pMat * pIn[i]).Normalize()
+ *  (or just pMat * pIn[i]) one by one. pIn and pOut may point to the same array.
+ *  @param pMat Transformation matrix, usually the inverse transpose of the
+ *    matrix the positions are transformed with
+ *  @param pIn Source vectors
+ *  @param pOut Receives the transformed vectors
+ *  @param pNum Number of vectors
+ *  @param pNormalize Normalize the results?
+ */
+void TransformDirections(const aiMatrix3x3& pMat, const aiVector3D* pIn, 
+	aiVector3D* pOut, unsigned int pNum, bool pNormalize = true);
+
+// ---------------------------------------------------------------------------
+/** Multiply each component of an array of vectors by a constant factor,
+ *  i.e. mirror them along some axes if the factors are 1 and -1.
+ *
+ *  The results are bitwise identical to scaling the components one by one.
+ *  Only the sign of NaNs may differ from code which negates a component 
+ *  rather than multiplying it with -1.
+ *  @param pFactors Factors for the x, y and z components
+ *  @param pVectors Vectors to be scaled in place
+ *  @param pNum Number of vectors
+ */
+void ScaleComponents(const aiVector3D& pFactors, aiVector3D* pVectors, 
+	unsigned int pNum);
+
+// ---------------------------------------------------------------------------
+/** Flip an array of texture coordinates vertically, v becomes 1-v.
+ *
+ *  The results are bitwise identical to computing 1-v one by one.
+ *  @param pUV Texture coordinates to be flipped in place
+ *  @param pNum Number of texture coordinates
+ */
+void FlipUVCoords(aiVector3D* pUV, unsigned int pNum);
+
+// ---------------------------------------------------------------------------
+/** Transform an array of 2D texture coordinates by a homogeneous 3x3 matrix.
+ *
+ *  Each coordinate is extended to (u,v,1), multiplied by the matrix and
+ *  divided by the resulting z, which is set to 0 afterwards. The results 
+ *  are bitwise identical to doing so one by one.
+ *  @param pMat Transformation matrix
+ *  @param pUV Texture coordinates to be transformed in place
+ *  @param pNum Number of texture coordinates
+ */
+void TransformUVCoords(const aiMatrix3x3& pMat, aiVector3D* pUV, 
+	unsigned int pNum);
+
+// ---------------------------------------------------------------------------
+/** Reverse the winding order of triangles stored back to back in a single
+ *  index array, i.e. swap the first and the last index of each triangle.
+ *  @param pIndices Triangle indices, 3 per triangle
+ *  @param pNum Number of triangles
+ */
+void ReverseTriangles(unsigned int* pIndices, unsigned int pNum);
+
+} // end of namespace Assimp
+
+#endif // AI_VERTEXTRANSFORM_H_INC
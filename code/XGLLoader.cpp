@@ -204,8 +204,7 @@ void XGLImporter::InternReadFile( const std::string& pFile,
 	}
 
 	// construct the irrXML parser
-	CIrrXML_IOStreamReader st(stream.get());
-	boost::scoped_ptr<IrrXMLReader> read( createIrrXMLReader((IFileReadCallBack*) &st) );
+	boost::scoped_ptr<IrrXMLReader> read( CreateIrrXMLReader(stream.get()) );
 	reader = read.get();
 
 	// parse the XML file
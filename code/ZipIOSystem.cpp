@@ -0,0 +1,548 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ZipIOSystem.cpp
+ *  @brief Implementation of the ZipIOSystem class
+ */
+
+#include "AssimpPCH.h"
+#include "../include/assimp/ZipIOSystem.hpp"
+
+#include "DefaultIOSystem.h"
+#include "MemoryIOWrapper.h"
+#include "TinyFormatter.h"
+#include "../contrib/unzip/unzip.h"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/mutex.hpp>
+#endif
+
+using namespace Assimp;
+
+namespace Assimp	{
+
+// ------------------------------------------------------------------------------------------------
+/** A member of the archive, as found in its central directory */
+struct ZipEntry
+{
+	std::string name;
+	unz_file_pos pos;
+	size_t size;
+
+	bool operator < (const ZipEntry& o) const {
+		return name < o.name;
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Internal state of a ZipIOSystem.
+ *
+ *  The index is immutable once the archive has been mapped. unzip handles carry the state of
+ *  the member currently being read, so every open member gets its own handle. Handles which
+ *  are not in use are kept in a pool, only the pool itself needs to be locked. */
+class ZipIOSystemPimpl
+{
+public:
+	ZipIOSystemPimpl()
+		: io()
+		, defaultIO()
+		, threshold(4*1024*1024)
+		, open()
+	{}
+
+	~ZipIOSystemPimpl()	{
+		for (std::vector<unzFile>::iterator it = handles.begin(); it != handles.end(); ++it) {
+			unzClose(*it);
+		}
+		delete defaultIO;
+	}
+
+	/** Build the index from the central directory of the archive */
+	void MapArchive(unzFile handle);
+
+	/** Lookup a member by name, NULL if there is none */
+	const ZipEntry* Find(const char* name) const;
+
+	/** Get an unzip handle to the archive, either from the pool or a newly opened one */
+	unzFile AcquireHandle();
+
+	/** Return an unzip handle to the pool */
+	void ReleaseHandle(unzFile handle);
+
+	/** Inflate a member into memory and return a stream to read it */
+	IOStream* OpenInflated(const ZipEntry& entry);
+
+	/** Return a stream which inflates a member while being read */
+	IOStream* OpenStreamed(const ZipEntry& entry);
+
+public:
+
+	std::string archive;
+	IOSystem* io;
+	IOSystem* defaultIO;
+	zlib_filefunc_def funcs;
+	size_t threshold;
+	bool open;
+
+	std::vector<ZipEntry> entries;
+	std::map<std::string,unsigned int> names, lowerNames;
+
+	std::vector<unzFile> handles;
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex mutex;
+#endif
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Stream which inflates an archive member while it is read. The stream owns the unzip
+ *  handle it reads from until it is closed. */
+class ZipStream : public IOStream
+{
+public:
+	ZipStream(ZipIOSystemPimpl* owner, unzFile handle, size_t size)
+		: owner(owner)
+		, handle(handle)
+		, size(size)
+		, pos()
+	{}
+
+	~ZipStream()	{
+		unzCloseCurrentFile(handle);
+		owner->ReleaseHandle(handle);
+	}
+
+public:
+
+	// -------------------------------------------------------------------
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount)	{
+		if (!pSize) {
+			return 0;
+		}
+		const size_t cnt = std::min(pCount,(size-pos)/pSize);
+		return Inflate(pvBuffer,cnt*pSize) / pSize;
+	}
+
+	// -------------------------------------------------------------------
+	size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/)	{
+		return 0;
+	}
+
+	// -------------------------------------------------------------------
+	aiReturn Seek(size_t pOffset, aiOrigin pOrigin)	{
+		size_t target = pOffset;
+		if (aiOrigin_CUR == pOrigin) {
+			target = pos + pOffset;
+		}
+		else if (aiOrigin_END == pOrigin) {
+			target = pOffset > size ? size+1 : size - pOffset;
+		}
+		if (target > size) {
+			return AI_FAILURE;
+		}
+
+		// deflate streams can't be rewound, restart from the beginning instead
+		if (target < pos) {
+			unzCloseCurrentFile(handle);
+			pos = 0;
+			if (UNZ_OK != unzOpenCurrentFile(handle)) {
+				pos = size;
+				return AI_FAILURE;
+			}
+		}
+
+		char scratch[4096];
+		while (pos < target) {
+			if (!Inflate(scratch,std::min(sizeof(scratch),target-pos))) {
+				return AI_FAILURE;
+			}
+		}
+		return AI_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------
+	size_t Tell() const	{
+		return pos;
+	}
+
+	// -------------------------------------------------------------------
+	size_t FileSize() const	{
+		return size;
+	}
+
+	// -------------------------------------------------------------------
+	void Flush()	{
+	}
+
+private:
+
+	// -------------------------------------------------------------------
+	size_t Inflate(void* out, size_t bytes)	{
+		size_t total = 0;
+		while (total < bytes) {
+			const unsigned int chunk = static_cast<unsigned int>(std::min(bytes-total,static_cast<size_t>(0x40000000)));
+			const int ret = unzReadCurrentFile(handle,static_cast<char*>(out)+total,chunk);
+			if (ret <= 0) {
+				break;
+			}
+			total += ret;
+		}
+		pos += total;
+		return total;
+	}
+
+	ZipIOSystemPimpl* const owner;
+	unzFile handle;
+	const size_t size;
+	size_t pos;
+};
+
+} //!ns Assimp
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// unzip file access callbacks, routed to the IOSystem passed as opaque pointer
+voidpf ZCALLBACK IOOpen(voidpf opaque, const char* filename, int /*mode*/)
+{
+	return reinterpret_cast<IOSystem*>(opaque)->Open(filename,"rb");
+}
+
+uLong ZCALLBACK IORead(voidpf /*opaque*/, voidpf stream, void* buf, uLong size)
+{
+	return static_cast<uLong>(reinterpret_cast<IOStream*>(stream)->Read(buf,1,size));
+}
+
+uLong ZCALLBACK IOWrite(voidpf /*opaque*/, voidpf /*stream*/, const void* /*buf*/, uLong /*size*/)
+{
+	return 0;
+}
+
+long ZCALLBACK IOTell(voidpf /*opaque*/, voidpf stream)
+{
+	return static_cast<long>(reinterpret_cast<IOStream*>(stream)->Tell());
+}
+
+long ZCALLBACK IOSeek(voidpf /*opaque*/, voidpf stream, uLong offset, int origin)
+{
+	aiOrigin o = aiOrigin_SET;
+	if (ZLIB_FILEFUNC_SEEK_CUR == origin) {
+		o = aiOrigin_CUR;
+	}
+	else if (ZLIB_FILEFUNC_SEEK_END == origin) {
+		o = aiOrigin_END;
+	}
+	return aiReturn_SUCCESS == reinterpret_cast<IOStream*>(stream)->Seek(offset,o) ? 0 : -1;
+}
+
+int ZCALLBACK IOClose(voidpf opaque, voidpf stream)
+{
+	reinterpret_cast<IOSystem*>(opaque)->Close(reinterpret_cast<IOStream*>(stream));
+	return 0;
+}
+
+int ZCALLBACK IOTestError(voidpf /*opaque*/, voidpf /*stream*/)
+{
+	return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Make a path relative to the archive root, with '/' separators and '.', '..' resolved
+std::string NormalizePath(const char* path)
+{
+	std::string out;
+	for (const char* s = path; *s; ) {
+		const char* e = s;
+		while (*e && *e != '/' && *e != '\\') {
+			++e;
+		}
+
+		const size_t len = e-s;
+		if (len == 2 && s[0] == '.' && s[1] == '.') {
+			// '..' above the root is ignored
+			const std::string::size_type p = out.find_last_of('/');
+			out.erase(std::string::npos == p ? 0 : p);
+		}
+		else if (len && !(len == 1 && s[0] == '.')) {
+			if (!out.empty()) {
+				out += '/';
+			}
+			out.append(s,len);
+		}
+		s = *e ? e+1 : e;
+	}
+	return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ToLower(std::string s)
+{
+	for (std::string::iterator it = s.begin(); it != s.end(); ++it) {
+		*it = static_cast<char>(::tolower(static_cast<unsigned char>(*it)));
+	}
+	return s;
+}
+
+} // end of anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+void ZipIOSystemPimpl::MapArchive(unzFile handle)
+{
+	std::vector<char> name;
+	for (int res = unzGoToFirstFile(handle); UNZ_OK == res; res = unzGoToNextFile(handle)) {
+		unz_file_info info;
+		if (UNZ_OK != unzGetCurrentFileInfo(handle,&info,NULL,0,NULL,0,NULL,0)) {
+			break;
+		}
+		name.resize(info.size_filename+1);
+		unzGetCurrentFileInfo(handle,NULL,&name[0],static_cast<uLong>(name.size()),NULL,0,NULL,0);
+
+		// skip directory entries
+		const char last = info.size_filename ? name[info.size_filename-1] : '/';
+		if (last == '/' || last == '\\') {
+			continue;
+		}
+
+		ZipEntry entry;
+		entry.name = NormalizePath(&name[0]);
+		entry.size = info.uncompressed_size;
+		unzGetFilePos(handle,&entry.pos);
+		entries.push_back(entry);
+	}
+
+	std::sort(entries.begin(),entries.end());
+	for (unsigned int i = 0; i < entries.size(); ++i) {
+		names.insert(std::make_pair(entries[i].name,i));
+		lowerNames.insert(std::make_pair(ToLower(entries[i].name),i));
+	}
+	DefaultLogger::get()->debug((Formatter::format("ZipIOSystem: "),entries.size()," files in ",archive));
+}
+
+// ------------------------------------------------------------------------------------------------
+const ZipEntry* ZipIOSystemPimpl::Find(const char* name) const
+{
+	const std::string path = NormalizePath(name);
+
+	std::map<std::string,unsigned int>::const_iterator it = names.find(path);
+	if (it == names.end()) {
+		it = lowerNames.find(ToLower(path));
+		if (it == lowerNames.end()) {
+			return NULL;
+		}
+	}
+	return &entries[(*it).second];
+}
+
+// ------------------------------------------------------------------------------------------------
+unzFile ZipIOSystemPimpl::AcquireHandle()
+{
+	{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		boost::mutex::scoped_lock lock(mutex);
+#endif
+		if (!handles.empty()) {
+			unzFile handle = handles.back();
+			handles.pop_back();
+			return handle;
+		}
+	}
+	return unzOpen2(archive.c_str(),&funcs);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZipIOSystemPimpl::ReleaseHandle(unzFile handle)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex::scoped_lock lock(mutex);
+#endif
+	handles.push_back(handle);
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* ZipIOSystemPimpl::OpenInflated(const ZipEntry& entry)
+{
+	unzFile handle = AcquireHandle();
+	if (!handle) {
+		return NULL;
+	}
+
+	unz_file_pos pos = entry.pos;
+	uint8_t* buff = new uint8_t[entry.size];
+
+	bool ok = UNZ_OK == unzGoToFilePos(handle,&pos) && UNZ_OK == unzOpenCurrentFile(handle);
+	if (ok) {
+		// members larger than 4 GB are not supported by unzip anyway
+		const int ret = unzReadCurrentFile(handle,buff,static_cast<unsigned int>(entry.size));
+		ok = ret >= 0 && static_cast<size_t>(ret) == entry.size;
+
+		// this also verifies the CRC of the member
+		ok = UNZ_OK == unzCloseCurrentFile(handle) && ok;
+	}
+	ReleaseHandle(handle);
+
+	if (!ok) {
+		delete[] buff;
+		DefaultLogger::get()->error("ZipIOSystem: failed to inflate " + entry.name);
+		return NULL;
+	}
+	return new MemoryIOStream(buff,entry.size,true);
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* ZipIOSystemPimpl::OpenStreamed(const ZipEntry& entry)
+{
+	unzFile handle = AcquireHandle();
+	if (!handle) {
+		return NULL;
+	}
+
+	unz_file_pos pos = entry.pos;
+	if (UNZ_OK != unzGoToFilePos(handle,&pos) || UNZ_OK != unzOpenCurrentFile(handle)) {
+		ReleaseHandle(handle);
+		DefaultLogger::get()->error("ZipIOSystem: failed to open " + entry.name);
+		return NULL;
+	}
+	return new ZipStream(this,handle,entry.size);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Constructor.
+ZipIOSystem::ZipIOSystem(const char* pArchive, IOSystem* pIOHandler)
+	: pimpl(new ZipIOSystemPimpl())
+{
+	ai_assert(NULL != pArchive);
+	pimpl->archive = pArchive;
+
+	if (!pIOHandler) {
+		pIOHandler = pimpl->defaultIO = new DefaultIOSystem();
+	}
+	pimpl->io = pIOHandler;
+
+	zlib_filefunc_def& funcs = pimpl->funcs;
+	funcs.zopen_file  = IOOpen;
+	funcs.zread_file  = IORead;
+	funcs.zwrite_file = IOWrite;
+	funcs.ztell_file  = IOTell;
+	funcs.zseek_file  = IOSeek;
+	funcs.zclose_file = IOClose;
+	funcs.zerror_file = IOTestError;
+	funcs.opaque      = pIOHandler;
+
+	unzFile handle = unzOpen2(pArchive,&funcs);
+	if (!handle) {
+		DefaultLogger::get()->error(std::string("ZipIOSystem: failed to open archive ") + pArchive);
+		return;
+	}
+
+	pimpl->MapArchive(handle);
+	pimpl->handles.push_back(handle);
+	pimpl->open = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor.
+ZipIOSystem::~ZipIOSystem()
+{
+	delete pimpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ZipIOSystem::IsOpen() const
+{
+	return pimpl->open;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ZipIOSystem::GetNumFiles() const
+{
+	return static_cast<unsigned int>(pimpl->entries.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* ZipIOSystem::GetFileName(unsigned int pIndex) const
+{
+	return pIndex < pimpl->entries.size() ? pimpl->entries[pIndex].name.c_str() : NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZipIOSystem::SetStreamingThreshold(size_t pBytes)
+{
+	pimpl->threshold = pBytes;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ZipIOSystem::Exists( const char* pFile) const
+{
+	ai_assert(NULL != pFile);
+	return NULL != pimpl->Find(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+char ZipIOSystem::getOsSeparator() const
+{
+	return '/';
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* ZipIOSystem::Open(const char* pFile, const char* pMode)
+{
+	ai_assert(NULL != pFile && NULL != pMode);
+	if (::strchr(pMode,'w') || ::strchr(pMode,'a') || ::strchr(pMode,'+')) {
+		DefaultLogger::get()->warn("ZipIOSystem: archives can only be read");
+		return NULL;
+	}
+
+	const ZipEntry* entry = pimpl->Find(pFile);
+	if (!entry) {
+		return NULL;
+	}
+	return entry->size > pimpl->threshold ? pimpl->OpenStreamed(*entry) : pimpl->OpenInflated(*entry);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZipIOSystem::Close( IOStream* pFile)
+{
+	delete pFile;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ZipIOSystem::ComparePaths (const char* one, const char* second) const
+{
+	return !ASSIMP_stricmp(NormalizePath(one),NormalizePath(second));
+}
@@ -9,6 +9,9 @@
 // Changes:
 //  22nd October 08 (Aramis_acg): Added temporary cast to double, added strtoul10_64
 //     to ensure long numbers are handled correctly
+//  Rewrote fast_atoreal_move to accumulate all significant digits in one integer and
+//     to scale it once by an exact power of ten, results are correctly rounded now.
+//     Added fast_atoreal_n to parse several numbers at once.
 // ------------------------------------------------------------------------------------
 
 
@@ -16,27 +19,22 @@
 #define __FAST_A_TO_F_H_INCLUDED__
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 namespace Assimp
 {
 
-const float fast_atof_table[16] =	{  // we write [16] here instead of [] to work around a swig bug
-	0.f,
-	0.1f,
-	0.01f,
-	0.001f,
-	0.0001f,
-	0.00001f,
-	0.000001f,
-	0.0000001f,
-	0.00000001f,
-	0.000000001f,
-	0.0000000001f,
-	0.00000000001f,
-	0.000000000001f,
-	0.0000000000001f,
-	0.00000000000001f,
-	0.000000000000001f
+// Powers of ten which are exactly representable as double
+const double fast_atof_pow10[23] =	{
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Negative powers of ten, rounded to double
+const double fast_atof_pow10_inv[23] =	{
+	1e-0,  1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8,  1e-9,  1e-10, 1e-11,
+	1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18, 1e-19, 1e-20, 1e-21, 1e-22
 };
 
 
@@ -214,46 +212,224 @@ inline uint64_t strtoul10_64( const char* in, const char** out=0, unsigned int*
 	return value;
 }
 
-// Number of relevant decimals for floating-point parsing.
-#define AI_FAST_ATOF_RELAVANT_DECIMALS 15
+// Maximum number of significant digits accumulated by fast_atoreal_move. 18 decimal
+// digits always fit into an int64_t, further digits only matter for rounding.
+#define AI_FAST_ATOF_MAX_DIGITS 18
+
+// ------------------------------------------------------------------------------------
+// Write a decimal mantissa (begin..end, digits and at most one decimal separator) times
+// 10^exponent to 'buffer' as digits followed by an exponent, i.e. without decimal
+// separator to be independent of the C locale. 'buffer' must hold 816 characters.
+// Returns false if the number is zero.
+// ------------------------------------------------------------------------------------
+inline bool fast_atoreal_normalize(const char* begin, const char* end, int exponent, char* buffer)
+{
+	// 800 digits are enough to decide the rounding of any double
+	unsigned int cur = 0;
+
+	bool fraction = false;
+	for (; begin != end; ++begin) {
+		if (*begin < '0' || *begin > '9') {
+			fraction = true;
+			continue;
+		}
+		if (cur == 800) {
+			if (!fraction) {
+				++exponent;
+			}
+			continue;
+		}
+		if (cur || *begin != '0') {
+			buffer[cur++] = *begin;
+		}
+		if (fraction) {
+			--exponent;
+		}
+	}
+	if (!cur) {
+		return false;
+	}
+
+	buffer[cur++] = 'e';
+	if (exponent < 0) {
+		buffer[cur++] = '-';
+		exponent = -exponent;
+	}
+
+	char digits[16];
+	unsigned int num = 0;
+	do {
+		digits[num++] = static_cast<char>('0' + exponent % 10);
+		exponent /= 10;
+	}
+	while (exponent);
+
+	while (num) {
+		buffer[cur++] = digits[--num];
+	}
+	buffer[cur] = '\0';
+	return true;
+}
+
+// ------------------------------------------------------------------------------------
+// Correctly rounded conversion through the C library, only used if the fast paths of
+// fast_atoreal_move don't apply. See fast_atoreal_normalize for the parameters.
+// ------------------------------------------------------------------------------------
+inline void fast_atoreal_exact(const char* begin, const char* end, int exponent, double& out)
+{
+	char buffer[800+16];
+	out = fast_atoreal_normalize(begin,end,exponent,buffer) ? ::strtod(buffer,NULL) : 0.0;
+}
+
+inline void fast_atoreal_exact(const char* begin, const char* end, int exponent, float& out)
+{
+	char buffer[800+16];
+	if (!fast_atoreal_normalize(begin,end,exponent,buffer)) {
+		out = 0.f;
+		return;
+	}
+#if defined(_MSC_VER) && _MSC_VER < 1800
+	// no strtof, rounding twice may be off by one unit in the last place
+	out = static_cast<float>(::strtod(buffer,NULL));
+#else
+	out = ::strtof(buffer,NULL);
+#endif
+}
+
+// ------------------------------------------------------------------------------------
+// Fast paths for mantissa * 10^exponent. They return false if the result can't be
+// guaranteed to be correctly rounded, which is only the case for numbers with more
+// than 15 significant digits or very large or small exponents.
+// ------------------------------------------------------------------------------------
+inline bool fast_atoreal_fast_path(uint64_t mantissa, int exponent, bool truncated, double& out)
+{
+	// Both operands are exact, IEEE 754 guarantees the result of a single
+	// multiplication or division to be correctly rounded.
+	if (truncated || mantissa > (static_cast<uint64_t>(1) << 53) || exponent < -22 || exponent > 22) {
+		return false;
+	}
+	out = exponent < 0 ? static_cast<double>(static_cast<int64_t>(mantissa)) / fast_atof_pow10[-exponent] 
+		: static_cast<double>(static_cast<int64_t>(mantissa)) * fast_atof_pow10[exponent];
+	return true;
+}
+
+inline bool fast_atoreal_fast_path(uint64_t mantissa, int exponent, bool truncated, float& out)
+{
+	if (exponent < -22 || exponent > 22) {
+		return false;
+	}
+
+	// Compute in double precision, multiplying by the rounded reciprocal is a lot faster 
+	// than dividing. The result is off by less than two units in the last place, so
+	// rounding it to float gives the correctly rounded result unless it is too close
+	// to the midpoint between two floats.
+	double d = static_cast<double>(static_cast<int64_t>(mantissa)) * (exponent < 0 ? fast_atof_pow10_inv[-exponent] : fast_atof_pow10[exponent]);
+	if (d < 1.1754944e-38 || d > 3.4028234e38) {
+		// denormal or out of range
+		return false;
+	}
+
+	uint64_t bits;
+	::memcpy(&bits,&d,sizeof bits);
+
+	// distance to the midpoint in the 29 mantissa bits dropped by the conversion to float
+	int64_t rest = static_cast<int64_t>(bits & ((1u << 29) - 1)) - (1 << 28);
+	if (rest >= -8 && rest <= 8) {
+		// retry with exact operands, the result is then ambiguous only if it is exactly the midpoint
+		if (!fast_atoreal_fast_path(mantissa,exponent,truncated,d)) {
+			return false;
+		}
+		::memcpy(&bits,&d,sizeof bits);
+		rest = static_cast<int64_t>(bits & ((1u << 29) - 1)) - (1 << 28);
+		if (!rest) {
+			return false;
+		}
+	}
+	out = static_cast<float>(d);
+	return true;
+}
 
 // ------------------------------------------------------------------------------------
 //! Provides a fast function for converting a string into a float,
 //! about 6 times faster than atof in win32.
 // If you find any bugs, please send them to me, niko (at) irrlicht3d.org.
+//
+// All significant digits are accumulated in one 64 bit integer which is scaled by
+// an exact power of ten at the end. The result is correctly rounded, numbers with
+// very long mantissas or exponents are passed on to fast_atoreal_exact.
 // ------------------------------------------------------------------------------------
 template <typename Real>
 inline const char* fast_atoreal_move( const char* c, Real& out)
 {
-	Real f;
-
 	bool inv = (*c=='-');
 	if (inv || *c=='+') {
 		++c;
 	}
 
-	f = static_cast<Real>( strtoul10_64 ( c, &c) );
+	const char* const begin = c;
+	uint64_t mantissa = 0;
+	int exponent = 0;
+	bool truncated = false;
+
+	// Common case first: accumulate all digits, this is fine as long as there are
+	// no more than AI_FAST_ATOF_MAX_DIGITS of them.
+	for (;*c >= '0' && *c <= '9'; ++c) {
+		mantissa = mantissa * 10 + (*c - '0');
+	}
+	const char* const intEnd = c;
 	if (*c == '.' || (c[0] == ',' && c[1] >= '0' && c[1] <= '9')) // allow for commas, too
 	{
 		++c;
+		for (;*c >= '0' && *c <= '9'; ++c) {
+			mantissa = mantissa * 10 + (*c - '0');
+		}
+		exponent = -static_cast<int>(c - intEnd - 1);
+	}
 
-		// NOTE: The original implementation is highly inaccurate here. The precision of a single
-		// IEEE 754 float is not high enough, everything behind the 6th digit tends to be more 
-		// inaccurate than it would need to be. Casting to double seems to solve the problem.
-		// strtol_64 is used to prevent integer overflow.
+	if (c - begin > AI_FAST_ATOF_MAX_DIGITS) {
+		// Too many digits. Start over, skipping leading zeros, which are not 
+		// significant, and ignoring the digits which don't fit.
+		c = begin;
+		mantissa = 0;
+		exponent = 0;
 
-		// Another fix: this tends to become 0 for long numbers if we don't limit the maximum 
-		// number of digits to be read. AI_FAST_ATOF_RELAVANT_DECIMALS can be a value between
-		// 1 and 15.
-		unsigned int diff = AI_FAST_ATOF_RELAVANT_DECIMALS;
-		double pl = static_cast<double>( strtoul10_64 ( c, &c, &diff ));
+		while (*c == '0') {
+			++c;
+		}
+
+		// integer part, digits beyond AI_FAST_ATOF_MAX_DIGITS only scale the result
+		unsigned int digits = 0;
+		for (;*c >= '0' && *c <= '9' && digits < AI_FAST_ATOF_MAX_DIGITS; ++c, ++digits) {
+			mantissa = mantissa * 10 + (*c - '0');
+		}
+		for (;*c >= '0' && *c <= '9'; ++c) {
+			truncated = truncated || *c != '0';
+			++exponent;
+		}
 
-		pl *= fast_atof_table[diff];
-		f += static_cast<Real>( pl );
+		if (*c == '.' || (c[0] == ',' && c[1] >= '0' && c[1] <= '9'))
+		{
+			++c;
+			if (!digits) {
+				for (;*c == '0'; ++c) {
+					--exponent;
+				}
+			}
+
+			for (;*c >= '0' && *c <= '9' && digits < AI_FAST_ATOF_MAX_DIGITS; ++c, ++digits) {
+				mantissa = mantissa * 10 + (*c - '0');
+				--exponent;
+			}
+			for (;*c >= '0' && *c <= '9'; ++c) {
+				truncated = truncated || *c != '0';
+			}
+		}
 	}
+	const char* const end = c;
 
 	// A major 'E' must be allowed. Necessary for proper reading of some DXF files.
 	// Thanks to Zhao Lei to point out that this if() must be outside the if (*c == '.' ..)
+	int exp = 0;
 	if (*c == 'e' || *c == 'E')	{
 
 		++c;
@@ -262,14 +438,23 @@ inline const char* fast_atoreal_move( const char* c, Real& out)
 			++c;
 		}
 
-		// The reason float constants are used here is that we've seen cases where compilers
-		// would perform such casts on compile-time constants at runtime, which would be
-		// bad considering how frequently fast_atoreal_move<float> is called in Assimp.
-		Real exp = static_cast<Real>( strtoul10_64(c, &c) );
+		// saturate, anything beyond is zero or infinity anyway
+		for (;*c >= '0' && *c <= '9'; ++c) {
+			if (exp < 100000) {
+				exp = exp * 10 + (*c - '0');
+			}
+		}
 		if (einv) {
 			exp = -exp;
 		}
-		f *= pow(static_cast<Real>(10.0f), exp);
+	}
+
+	Real f;
+	if (!mantissa) {
+		f = static_cast<Real>(0.0f);
+	}
+	else if (!fast_atoreal_fast_path(mantissa,exponent + exp,truncated,f)) {
+		fast_atoreal_exact(begin,end,exp,f);
 	}
 
 	if (inv) {
@@ -279,6 +464,35 @@ inline const char* fast_atoreal_move( const char* c, Real& out)
 	return c;
 }
 
+// ------------------------------------------------------------------------------------
+// Parse up to 'count' numbers separated by spaces or tabs. Parsing stops at the end of
+// the line or of the string. Each token is read by fast_atoreal_move, trailing garbage
+// is skipped. Returns the number of values written to 'out'; 'cout', if given, 
+// receives the position after the last token read.
+// ------------------------------------------------------------------------------------
+template <typename Real>
+inline unsigned int fast_atoreal_n( const char* c, Real* out, unsigned int count, const char** cout=0)
+{
+	unsigned int num = 0;
+	for (; num < count; ++num) {
+		while (*c == ' ' || *c == '\t') {
+			++c;
+		}
+		if (*c == '\0' || *c == '\n' || *c == '\r' || *c == '\f') {
+			break;
+		}
+
+		c = fast_atoreal_move<Real>(c,out[num]);
+		while (*c != '\0' && *c != ' ' && *c != '\t' && *c != '\n' && *c != '\r' && *c != '\f') {
+			++c;
+		}
+	}
+	if (cout) {
+		*cout = c;
+	}
+	return num;
+}
+
 // ------------------------------------------------------------------------------------
 // The same but more human.
 inline float fast_atof(const char* c)
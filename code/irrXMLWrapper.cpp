@@ -0,0 +1,630 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+---------------------------------------------------------------------------
+*/
+
+/** @file  irrXMLWrapper.cpp
+ *  @brief Implementation of the streaming XML reader used by the XML-based importers
+ */
+
+#include "AssimpPCH.h"
+#include "irrXMLWrapper.h"
+#include "ParsingUtils.h"
+#include "fast_atof.h"
+
+using namespace Assimp;
+using namespace irr::io;
+
+// ------------------------------------------------------------------------------------------------
+CIrrXML_StreamingReader::CIrrXML_StreamingReader(IOStream* stream, size_t chunkSize)
+: stream		(stream)
+, chunkSize		(std::max(chunkSize,static_cast<size_t>(16u)))
+, pos			()
+, avail			()
+, eof			()
+, tagPending	()
+, nodeType		(EXN_NONE)
+, nodeName		("")
+, nodeLength	()
+, emptyElement	()
+{
+	ai_assert(stream);
+	buffer.resize(this->chunkSize+1);
+	buffer[0] = '\0';
+
+	// skip over UTF-8 BOM, if present
+	Refill();
+	if (avail >= 3 && (uint8_t)buffer[0] == 0xEF && (uint8_t)buffer[1] == 0xBB && (uint8_t)buffer[2] == 0xBF) {
+		DefaultLogger::get()->debug("Found UTF-8 BOM ...");
+		pos = 3;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+CIrrXML_StreamingReader::~CIrrXML_StreamingReader()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+// Discard everything in front of pos and read the next chunk from the stream.
+// Returns false if no more data could be read.
+bool CIrrXML_StreamingReader::Refill()
+{
+	if (eof) {
+		return false;
+	}
+
+	if (pos) {
+		::memmove(&buffer[0],&buffer[pos],avail-pos);
+		avail -= pos;
+		pos = 0;
+	}
+
+	// grow geometrically if a single node exceeds the buffer
+	if (buffer.size() < avail+chunkSize+1) {
+		buffer.resize(std::max(buffer.size()*2,avail+chunkSize+1));
+	}
+
+	const size_t read = stream->Read(&buffer[avail],1,chunkSize);
+	avail += read;
+	buffer[avail] = '\0';
+
+	if (read < chunkSize) {
+		eof = true;
+	}
+	return read > 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Find the next occurrence of c, starting at pos+rel. rel receives the offset relative to pos.
+bool CIrrXML_StreamingReader::ScanUntil(char c, size_t& rel)
+{
+	for(;;) {
+		const size_t have = avail-pos;
+		if (rel < have) {
+			const char* const begin = &buffer[pos];
+			const char* const hit = static_cast<const char*>(::memchr(begin+rel,c,have-rel));
+			if (hit) {
+				rel = static_cast<size_t>(hit-begin);
+				return true;
+			}
+			rel = have;
+		}
+		if (!Refill()) {
+			return false;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Find the next occurrence of a terminating sequence, rel receives the offset of its last character.
+bool CIrrXML_StreamingReader::ScanUntilSequence(const char* seq, size_t& rel)
+{
+	const size_t len = ::strlen(seq);
+	ai_assert(len);
+
+	for(rel += len-1;ScanUntil(seq[len-1],rel);++rel) {
+		if (!::strncmp(&buffer[pos+rel-(len-1)],seq,len-1)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Find the closing '>' of a tag, skipping over quoted attribute values.
+bool CIrrXML_StreamingReader::ScanTag(size_t& rel)
+{
+	char quote = '\0';
+	for(;;++rel) {
+		if (pos+rel >= avail && !Refill()) {
+			return false;
+		}
+		const char c = buffer[pos+rel];
+		if (quote) {
+			if (c == quote) {
+				quote = '\0';
+			}
+		}
+		else if (c == '\"' || c == '\'') {
+			quote = c;
+		}
+		else if (c == '>') {
+			return true;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replace XML entities in-place, returns the new end of the string.
+char* CIrrXML_StreamingReader::DecodeEntities(char* begin, char* end)
+{
+	char* const first = static_cast<char*>(::memchr(begin,'&',end-begin));
+	if (!first) {
+		return end;
+	}
+
+	static const struct {
+		const char* name;
+		size_t len;
+		char c;
+	} entities[] = {
+		{"&amp;",5,'&'},
+		{"&lt;",4,'<'},
+		{"&gt;",4,'>'},
+		{"&quot;",6,'\"'},
+		{"&apos;",6,'\''}
+	};
+
+	char* out = first;
+	for (const char* in = first; in < end;) {
+		if (*in != '&') {
+			*out++ = *in++;
+			continue;
+		}
+
+		bool found = false;
+		for (size_t i = 0; i < sizeof(entities)/sizeof(entities[0]); ++i) {
+			if (static_cast<size_t>(end-in) >= entities[i].len && !::strncmp(in,entities[i].name,entities[i].len)) {
+				*out++ = entities[i].c;
+				in += entities[i].len;
+				found = true;
+				break;
+			}
+		}
+
+		// numeric character references, encoded as UTF-8
+		if (!found && end-in > 3 && in[1] == '#') {
+			const char* cur = in+2;
+			unsigned int code = 0;
+			if (*cur == 'x' || *cur == 'X') {
+				for (++cur; cur < end && ::isxdigit(static_cast<unsigned char>(*cur)); ++cur) {
+					code = code*16 + HexDigitToDecimal(*cur);
+				}
+			}
+			else {
+				for (; cur < end && IsNumeric(*cur); ++cur) {
+					code = code*10 + (*cur - '0');
+				}
+			}
+
+			if (cur < end && *cur == ';' && code && code <= 0x10FFFF) {
+				if (code < 0x80) {
+					*out++ = static_cast<char>(code);
+				}
+				else if (code < 0x800) {
+					*out++ = static_cast<char>(0xC0 | (code >> 6));
+					*out++ = static_cast<char>(0x80 | (code & 0x3F));
+				}
+				else if (code < 0x10000) {
+					*out++ = static_cast<char>(0xE0 | (code >> 12));
+					*out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+					*out++ = static_cast<char>(0x80 | (code & 0x3F));
+				}
+				else {
+					*out++ = static_cast<char>(0xF0 | (code >> 18));
+					*out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+					*out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+					*out++ = static_cast<char>(0x80 | (code & 0x3F));
+				}
+				in = cur+1;
+				found = true;
+			}
+		}
+
+		if (!found) {
+			// not a known entity, leave it as is
+			*out++ = *in++;
+		}
+	}
+	return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Parse character data up to the next tag. Short whitespace-only runs are not
+// reported, same as IrrXML does. Returns false if the end of the file is reached.
+bool CIrrXML_StreamingReader::ParseText(bool& skipped)
+{
+	size_t rel = 0;
+	if (!ScanUntil('<',rel)) {
+		// trailing text after the last tag is dropped
+		pos = avail;
+		return false;
+	}
+
+	char* const begin = &buffer[pos];
+	char* const end = begin+rel;
+
+	skipped = false;
+	if (rel < 3) {
+		const char* p = begin;
+		while (p != end && IsSpaceOrNewLine(*p)) {
+			++p;
+		}
+		if (p == end) {
+			skipped = true;
+			pos += rel;
+			return true;
+		}
+	}
+
+	char* const last = DecodeEntities(begin,end);
+	*last = '\0';
+
+	nodeType = EXN_TEXT;
+	nodeName = begin;
+	nodeLength = static_cast<size_t>(last-begin);
+	emptyElement = false;
+	attributes.clear();
+
+	// if the terminator overwrote the '<', remember to restore it
+	pos += rel;
+	tagPending = (last == end);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Parse an opening tag in [pos,pos+end], buffer[pos+end] is the closing '>'
+void CIrrXML_StreamingReader::ParseElement(size_t end)
+{
+	char* cur = &buffer[pos+1];
+	char* const last = &buffer[pos+end];
+
+	nodeType = EXN_ELEMENT;
+	emptyElement = false;
+	attributes.clear();
+
+	char* const name = cur;
+	while (cur != last && !IsSpaceOrNewLine(*cur) && *cur != '/') {
+		++cur;
+	}
+	char* nameEnd = cur;
+
+	while (cur != last) {
+		if (IsSpaceOrNewLine(*cur)) {
+			++cur;
+			continue;
+		}
+		if (*cur == '/') {
+			emptyElement = true;
+			++cur;
+			continue;
+		}
+
+		// attribute name
+		char* const attrName = cur;
+		while (cur != last && !IsSpaceOrNewLine(*cur) && *cur != '=') {
+			++cur;
+		}
+		char* const attrNameEnd = cur;
+
+		// attribute value, may be enclosed in single or double quotes
+		while (cur != last && *cur != '\"' && *cur != '\'') {
+			++cur;
+		}
+		if (cur == last) {
+			break; // malformed, ignore the rest of the tag
+		}
+		const char quote = *cur++;
+		char* const value = cur;
+		while (cur != last && *cur != quote) {
+			++cur;
+		}
+		char* const valueEnd = cur;
+		if (cur != last) {
+			++cur;
+		}
+
+		*attrNameEnd = '\0';
+		*DecodeEntities(value,valueEnd) = '\0';
+
+		Attribute attr;
+		attr.name = attrName;
+		attr.value = value;
+		attributes.push_back(attr);
+	}
+
+	*nameEnd = '\0';
+	nodeName = name;
+	nodeLength = static_cast<size_t>(nameEnd-name);
+
+	pos += end+1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Parse a closing tag in [pos,pos+end], buffer[pos+end] is the closing '>'
+void CIrrXML_StreamingReader::ParseClosingElement(size_t end)
+{
+	char* const name = &buffer[pos+2];
+	char* nameEnd = &buffer[pos+end];
+
+	// remove trailing whitespace, if any
+	while (nameEnd > name && IsSpaceOrNewLine(nameEnd[-1])) {
+		--nameEnd;
+	}
+	*nameEnd = '\0';
+
+	nodeType = EXN_ELEMENT_END;
+	nodeName = name;
+	nodeLength = static_cast<size_t>(nameEnd-name);
+	emptyElement = false;
+	attributes.clear();
+
+	pos += end+1;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CIrrXML_StreamingReader::read()
+{
+	// all pointers handed out for the previous node are invalidated from here on
+	if (tagPending) {
+		buffer[pos] = '<';
+		tagPending = false;
+	}
+
+	for(;;) {
+		if (pos >= avail && !Refill()) {
+			return false;
+		}
+		if (buffer[pos] != '<') {
+			bool skipped;
+			if (!ParseText(skipped)) {
+				return false;
+			}
+			if (!skipped) {
+				return true;
+			}
+			continue;
+		}
+
+		// we need at least the first few characters of the tag to decide on its type
+		while (avail-pos < 9 && Refill());
+
+		size_t rel = 1;
+		if (buffer[pos+1] == '/') {
+			if (!ScanUntil('>',rel)) {
+				return false;
+			}
+			ParseClosingElement(rel);
+		}
+		else if (buffer[pos+1] == '?') {
+			if (!ScanUntil('>',rel)) {
+				return false;
+			}
+			nodeType = EXN_UNKNOWN;
+			nodeName = "";
+			nodeLength = 0;
+			attributes.clear();
+			pos += rel+1;
+		}
+		else if (!::strncmp(&buffer[pos+1],"![CDATA[",8)) {
+			rel = 9;
+			if (!ScanUntilSequence("]]>",rel)) {
+				return false;
+			}
+			buffer[pos+rel-2] = '\0';
+
+			nodeType = EXN_CDATA;
+			nodeName = &buffer[pos+9];
+			nodeLength = rel-11;
+			attributes.clear();
+			pos += rel+1;
+		}
+		else if (!::strncmp(&buffer[pos+1],"!--",3)) {
+			rel = 4;
+			if (!ScanUntilSequence("-->",rel)) {
+				return false;
+			}
+			buffer[pos+rel-2] = '\0';
+
+			nodeType = EXN_COMMENT;
+			nodeName = &buffer[pos+4];
+			nodeLength = rel-6;
+			attributes.clear();
+			pos += rel+1;
+		}
+		else if (buffer[pos+1] == '!') {
+			// <!DOCTYPE ...>, possibly with an internal subset containing nested tags
+			unsigned int depth = 1;
+			for (;;++rel) {
+				if (pos+rel >= avail && !Refill()) {
+					return false;
+				}
+				if (buffer[pos+rel] == '<') {
+					++depth;
+				}
+				else if (buffer[pos+rel] == '>' && !--depth) {
+					break;
+				}
+			}
+			buffer[pos+rel] = '\0';
+
+			nodeType = EXN_COMMENT;
+			nodeName = &buffer[pos+2];
+			nodeLength = rel-2;
+			attributes.clear();
+			pos += rel+1;
+		}
+		else {
+			if (!ScanTag(rel)) {
+				return false;
+			}
+			ParseElement(rel);
+		}
+		return true;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+const CIrrXML_StreamingReader::Attribute* CIrrXML_StreamingReader::FindAttribute(const char* name) const
+{
+	if (!name) {
+		return NULL;
+	}
+	for (std::vector<Attribute>::const_iterator it = attributes.begin(), end = attributes.end(); it != end; ++it) {
+		if (!::strcmp((*it).name,name)) {
+			return &*it;
+		}
+	}
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+EXML_NODE CIrrXML_StreamingReader::getNodeType() const
+{
+	return nodeType;
+}
+
+// ------------------------------------------------------------------------------------------------
+int CIrrXML_StreamingReader::getAttributeCount() const
+{
+	return static_cast<int>(attributes.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* CIrrXML_StreamingReader::getAttributeName(int idx) const
+{
+	if (idx < 0 || idx >= static_cast<int>(attributes.size())) {
+		return NULL;
+	}
+	return attributes[idx].name;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* CIrrXML_StreamingReader::getAttributeValue(int idx) const
+{
+	if (idx < 0 || idx >= static_cast<int>(attributes.size())) {
+		return NULL;
+	}
+	return attributes[idx].value;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* CIrrXML_StreamingReader::getAttributeValue(const char* name) const
+{
+	const Attribute* const attr = FindAttribute(name);
+	return attr ? attr->value : NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* CIrrXML_StreamingReader::getAttributeValueSafe(const char* name) const
+{
+	const Attribute* const attr = FindAttribute(name);
+	return attr ? attr->value : "";
+}
+
+// ------------------------------------------------------------------------------------------------
+int CIrrXML_StreamingReader::getAttributeValueAsInt(const char* name) const
+{
+	return static_cast<int>(getAttributeValueAsFloat(name));
+}
+
+// ------------------------------------------------------------------------------------------------
+int CIrrXML_StreamingReader::getAttributeValueAsInt(int idx) const
+{
+	return static_cast<int>(getAttributeValueAsFloat(idx));
+}
+
+// ------------------------------------------------------------------------------------------------
+float CIrrXML_StreamingReader::getAttributeValueAsFloat(const char* name) const
+{
+	const char* const value = getAttributeValue(name);
+	return value ? fast_atof(value) : 0.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+float CIrrXML_StreamingReader::getAttributeValueAsFloat(int idx) const
+{
+	const char* const value = getAttributeValue(idx);
+	return value ? fast_atof(value) : 0.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* CIrrXML_StreamingReader::getNodeName() const
+{
+	return nodeName;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* CIrrXML_StreamingReader::getNodeData() const
+{
+	return nodeName;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CIrrXML_StreamingReader::isEmptyElement() const
+{
+	return emptyElement;
+}
+
+// ------------------------------------------------------------------------------------------------
+ETEXT_FORMAT CIrrXML_StreamingReader::getSourceFormat() const
+{
+	return ETF_UTF8;
+}
+
+// ------------------------------------------------------------------------------------------------
+ETEXT_FORMAT CIrrXML_StreamingReader::getParserFormat() const
+{
+	return ETF_UTF8;
+}
+
+// ------------------------------------------------------------------------------------------------
+IrrXMLReader* Assimp::CreateIrrXMLReader(IOStream* stream)
+{
+	ai_assert(stream);
+
+	// peek at the BOM to see if we need to convert to UTF-8 first
+	uint8_t bom[4] = {0};
+	const size_t got = stream->Read(bom,1,4);
+	stream->Seek(0,aiOrigin_SET);
+
+	const bool wide = got >= 2 && (
+		(bom[0] == 0xFF && bom[1] == 0xFE) ||
+		(bom[0] == 0xFE && bom[1] == 0xFF) ||
+		(got == 4 && !bom[0] && !bom[1] && bom[2] == 0xFE && bom[3] == 0xFF));
+
+	if (wide) {
+		// IrrXML reads the whole file during construction, so the wrapper needn't outlive this scope
+		CIrrXML_IOStreamReader wrapper(stream);
+		return createIrrXMLReader(&wrapper);
+	}
+	return new CIrrXML_StreamingReader(stream);
+}
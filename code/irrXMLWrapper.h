@@ -126,6 +126,123 @@ private:
 
 }; // ! class CIrrXML_IOStreamReader
 
+#define AI_IRRXML_STREAM_CHUNK_SIZE (1u << 16u)
+
+// ---------------------------------------------------------------------------------
+/** @brief Incremental, in-place XML reader implementing IrrXML's reader interface.
+ *
+ *  Unlike IrrXML's own reader, the file is not mapped into memory as a whole.
+ *  It is pulled from the IOStream in chunks of #AI_IRRXML_STREAM_CHUNK_SIZE
+ *  bytes and parsed in place, so the memory footprint is bounded by the size
+ *  of the largest single node, not by the size of the file. Names, attribute
+ *  values and text returned by the reader point directly into the read buffer
+ *  and stay valid until the next call to read().
+ *
+ *  Only ASCII and UTF-8 input is accepted. Use CreateIrrXMLReader() to get a
+ *  reader for arbitrary files, it falls back to IrrXML for UTF-16/32 input.
+ **/
+class CIrrXML_StreamingReader
+	: public irr::io::IrrXMLReader
+{
+public:
+
+	// ----------------------------------------------------------------------------------
+	/** Construction from an existing IOStream. The stream is not owned
+	 *  by the reader and must stay alive as long as the reader is used. */
+	CIrrXML_StreamingReader(IOStream* stream, 
+		size_t chunkSize = AI_IRRXML_STREAM_CHUNK_SIZE);
+
+	virtual ~CIrrXML_StreamingReader();
+
+public:
+
+	// IrrXMLReader interface
+	virtual bool read();
+	virtual irr::io::EXML_NODE getNodeType() const;
+	virtual int getAttributeCount() const;
+	virtual const char* getAttributeName(int idx) const;
+	virtual const char* getAttributeValue(int idx) const;
+	virtual const char* getAttributeValue(const char* name) const;
+	virtual const char* getAttributeValueSafe(const char* name) const;
+	virtual int getAttributeValueAsInt(const char* name) const;
+	virtual int getAttributeValueAsInt(int idx) const;
+	virtual float getAttributeValueAsFloat(const char* name) const;
+	virtual float getAttributeValueAsFloat(int idx) const;
+	virtual const char* getNodeName() const;
+	virtual const char* getNodeData() const;
+	virtual bool isEmptyElement() const;
+	virtual irr::io::ETEXT_FORMAT getSourceFormat() const;
+	virtual irr::io::ETEXT_FORMAT getParserFormat() const;
+
+	// ----------------------------------------------------------------------------------
+	/** Length of the string returned by getNodeData(), in bytes. Allows
+	 *  callers to process large text nodes as a [begin,end) range. */
+	size_t getNodeDataLength() const {
+		return nodeLength;
+	}
+
+private:
+
+	struct Attribute 
+	{
+		const char* name;
+		const char* value;
+	};
+
+	bool Refill();
+	bool ScanUntil(char c, size_t& rel);
+	bool ScanUntilSequence(const char* seq, size_t& rel);
+	bool ScanTag(size_t& rel);
+
+	bool ParseText(bool& skipped);
+	void ParseElement(size_t end);
+	void ParseClosingElement(size_t end);
+	char* DecodeEntities(char* begin, char* end);
+
+	const Attribute* FindAttribute(const char* name) const;
+
+private:
+	IOStream* stream;
+	const size_t chunkSize;
+
+	// read buffer, always zero-terminated at buffer[avail].
+	// pos is the offset of the first byte not yet consumed.
+	std::vector<char> buffer;
+	size_t pos, avail;
+	bool eof;
+
+	// true if buffer[pos] held a '<' which has been replaced by
+	// the terminating zero of the current text node.
+	bool tagPending;
+
+	irr::io::EXML_NODE nodeType;
+	const char* nodeName;
+	size_t nodeLength;
+	bool emptyElement;
+	std::vector<Attribute> attributes;
+
+}; // ! class CIrrXML_StreamingReader
+
+
+// ---------------------------------------------------------------------------------
+/** @brief Create a XML reader for a stream.
+ *
+ *  This is the preferred way for importers to obtain a XML reader:
+ *  @code
+ *  boost::scoped_ptr<IOStream> file( pIOHandler->Open( pFile));
+ *  if( file.get() == NULL) {
+ *	  throw DeadlyImportError( "Failed to open file " + pFile + ".");
+ *  }
+ *  boost::scoped_ptr<irr::io::IrrXMLReader> reader( CreateIrrXMLReader( file.get()));
+ *  @endcode
+ *
+ *  ASCII and UTF-8 files are parsed incrementally by CIrrXML_StreamingReader,
+ *  the stream must therefore outlive the reader. Files with an UTF-16 or 
+ *  UTF-32 BOM are converted to UTF-8 and handed to IrrXML as before.
+ *  @param stream Stream to read from, positioned at the start of the file.
+ *  @return A new reader, to be deleted by the caller. */
+irr::io::IrrXMLReader* CreateIrrXMLReader(IOStream* stream);
+
 } // ! Assimp
 
 #endif // !! INCLUDED_AI_IRRXML_WRAPPER
@@ -1351,7 +1351,10 @@ with 'slow' file formats like X or Collada might scale well with multiple concur
 
 @section automt Internal threading
 
-Internal multi-threading is not currently implemented.
+If Assimp is built with the <tt>ASSIMP_BUILD_MULTITHREADED</tt> CMake option (which requires boost.thread),
+some importers and post processing steps split their work across several threads. The number of threads 
+used by an #Assimp::Importer is controlled by the #AI_CONFIG_GLOB_MULTITHREADING property. By default,
+Assimp is built single-threaded and the property is ignored.
 */
 
 /**
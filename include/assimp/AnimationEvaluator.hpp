@@ -0,0 +1,243 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file AnimationEvaluator.hpp
+ *  @brief Samples the animated node transformations and bone matrices
+ *   of a scene.
+*/
+
+#ifndef AI_ANIMATIONEVALUATOR_H_INC
+#define AI_ANIMATIONEVALUATOR_H_INC
+
+#ifndef __cplusplus
+#	error This header requires C++ to be used.
+#endif
+
+#include "scene.h"
+
+namespace Assimp	{
+class AnimationEvaluatorPimpl;
+
+// ---------------------------------------------------------------------------
+/** @brief CPP-API: Computes the pose of a scene at a given time of one of
+ *  its animations.
+ *
+ *  A pose consists of a local and a global transformation matrix for each
+ *  node of the scene. The nodes are numbered in depth-first order, parents 
+ *  before their children, see #GetNodeIndex(). Nodes without animation 
+ *  channel keep their aiNode::mTransformation. For skinned meshes, 
+ *  #GetBonePalette() turns a pose into the matrices to be uploaded to 
+ *  the vertex shader.
+ *
+ *  Times are given in seconds and converted to ticks using 
+ *  aiAnimation::mTicksPerSecond (25 if not specified). By default the
+ *  animation loops, i.e. the time is wrapped into the duration of the
+ *  animation first. Outside of the time range of its keys, each channel
+ *  behaves as specified by aiNodeAnim::mPreState and aiNodeAnim::mPostState,
+ *  except that a single key holds at all times. Tracks without keys use the
+ *  node's own transformation.
+ *  Position and scaling keys are interpolated linearly, rotation keys 
+ *  spherically.
+ *
+ *  The keys are stored in a layout suited for evaluating many channels at
+ *  once. #SamplePose() and #SamplePoses() don't modify the evaluator, so 
+ *  they can be called from several threads at a time. #SamplePoses() can 
+ *  also use multiple threads itself. #Evaluate() and the getters working 
+ *  on the pose kept by the evaluator are the simple way to go if this is
+ *  not needed:
+ *
+ *  @code
+ *  Assimp::AnimationEvaluator eval(scene,0);
+ *  eval.Evaluate(time);
+ *  const aiMatrix4x4* bones = eval.GetBoneMatrices(node,0);
+ *  @endcode
+ *
+ *  The evaluator keeps a reference to the scene, which must not be modified
+ *  or destroyed while the evaluator is in use.
+ */
+class ASSIMP_API AnimationEvaluator
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Prepares the evaluation of an animation of a scene.
+	 *
+	 *  @param pScene Scene to be animated.
+	 *  @param pAnimIndex Index of the animation, see #SetAnimation().
+	 */
+	AnimationEvaluator(const aiScene* pScene, unsigned int pAnimIndex = 0);
+
+	~AnimationEvaluator();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Selects the animation to be evaluated.
+	 *
+	 *  @param pAnimIndex Index into aiScene::mAnimations. An index out of
+	 *    range selects no animation at all, which yields the bind pose 
+	 *    of the scene at any time.
+	 */
+	void SetAnimation(unsigned int pAnimIndex);
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the animation selected by #SetAnimation(), NULL if
+	 *    there is none. */
+	const aiAnimation* GetAnimation() const;
+
+	// -------------------------------------------------------------------
+	/** @brief Specifies whether the time is wrapped into the duration of
+	 *    the animation. Enabled by default. */
+	void SetLooping(bool pLoop);
+
+	// -------------------------------------------------------------------
+	/** @brief Returns whether looping is enabled. */
+	bool IsLooping() const;
+
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the number of nodes in the scene, which is the
+	 *    number of matrices in a pose. */
+	unsigned int GetNumNodes() const;
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the index of a node in a pose.
+	 *
+	 *  @param pNode Node of the scene.
+	 *  @return UINT_MAX if the node is not part of the scene.
+	 */
+	unsigned int GetNodeIndex(const aiNode* pNode) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the node with the given index in a pose. */
+	const aiNode* GetNode(unsigned int pIndex) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Computes the pose at a given time.
+	 *
+	 *  @param pTime Time in seconds.
+	 *  @param pLocal Receives #GetNumNodes() local transformations,
+	 *    relative to the parent node. May be NULL.
+	 *  @param pGlobal Receives #GetNumNodes() global transformations,
+	 *    relative to the root node's parent. May be NULL.
+	 */
+	void SamplePose(double pTime, aiMatrix4x4* pLocal, 
+		aiMatrix4x4* pGlobal) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Computes the poses at several points in time.
+	 *
+	 *  @param pTimes Array of times in seconds.
+	 *  @param pNumTimes Number of times in the array.
+	 *  @param pLocal Receives pNumTimes * #GetNumNodes() local 
+	 *    transformations, pose by pose. May be NULL.
+	 *  @param pGlobal Same for the global transformations. May be NULL.
+	 *  @param pNumThreads Number of threads to use, with the same 
+	 *    meaning as #AI_CONFIG_GLOB_MULTITHREADING. 
+	 */
+	void SamplePoses(const double* pTimes, unsigned int pNumTimes, 
+		aiMatrix4x4* pLocal, aiMatrix4x4* pGlobal, 
+		int pNumThreads = -1) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Computes the skinning matrices of a mesh in a given pose.
+	 *
+	 *  Each matrix transforms from mesh space in bind pose to mesh space
+	 *  in the given pose. The mesh's own global transformation is not 
+	 *  included, so the usual matrix chain in the vertex shader is
+	 *  @code
+	 *  boneMatrix * worldMatrix * viewMatrix * projMatrix
+	 *  @endcode
+	 *  Bones whose node cannot be found keep their bind pose.
+	 *  @param pGlobal Global transformations of a pose.
+	 *  @param pNode The node referencing the mesh.
+	 *  @param pMeshIndex Index into the node's mesh array, not into 
+	 *    the scene's mesh array.
+	 *  @param pOut Receives aiMesh::mNumBones matrices.
+	 */
+	void GetBonePalette(const aiMatrix4x4* pGlobal, const aiNode* pNode,
+		unsigned int pMeshIndex, aiMatrix4x4* pOut) const;
+
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Computes the pose at a given time and keeps it for the
+	 *    getters below.
+	 *
+	 *  Before the first call, the evaluator holds the bind pose.
+	 *  @param pTime Time in seconds.
+	 */
+	void Evaluate(double pTime);
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the local transformation of a node in the pose
+	 *    computed by #Evaluate(). The identity matrix is returned for 
+	 *    nodes which are not part of the scene. */
+	const aiMatrix4x4& GetLocalTransform(const aiNode* pNode) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the global transformation of a node in the pose
+	 *    computed by #Evaluate(). The identity matrix is returned for 
+	 *    nodes which are not part of the scene. */
+	const aiMatrix4x4& GetGlobalTransform(const aiNode* pNode) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Computes the skinning matrices of a mesh in the pose 
+	 *    computed by #Evaluate(), see #GetBonePalette().
+	 *
+	 *  @return aiMesh::mNumBones matrices, valid until the next call.
+	 *    NULL if the mesh has no bones.
+	 */
+	const aiMatrix4x4* GetBoneMatrices(const aiNode* pNode, 
+		unsigned int pMeshIndex = 0);
+
+private:
+
+	// not copyable
+	AnimationEvaluator(const AnimationEvaluator&);
+	AnimationEvaluator& operator = (const AnimationEvaluator&);
+
+	AnimationEvaluatorPimpl* pimpl;
+};
+
+} //!ns Assimp
+
+#endif //AI_ANIMATIONEVALUATOR_H_INC
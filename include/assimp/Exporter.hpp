@@ -107,6 +107,27 @@ public:
 		ExportFormatEntry() : mExportFunction(), mEnforcePP() {}
 	};
 
+	/** One output file of #ExportMultiple */
+	struct ExportTarget
+	{
+		/// Id of the export format to use, see #aiExportFormatDesc
+		const char* mFormatId;
+
+		/// Full target file name
+		const char* mPath;
+
+		/// Set by #ExportMultiple: AI_SUCCESS if this file has been written
+		aiReturn mResult;
+
+		/// Set by #ExportMultiple: error description if the export failed
+		std::string mError;
+
+		ExportTarget(const char* pFormatId, const char* pPath)
+			: mFormatId(pFormatId), mPath(pPath), mResult(aiReturn_FAILURE) {}
+
+		ExportTarget() : mFormatId(), mPath(), mResult(aiReturn_FAILURE) {}
+	};
+
 
 public:
 
@@ -201,6 +222,31 @@ public:
 	inline aiReturn Export( const aiScene* pScene, const std::string& pFormatId, const std::string& pPath,  unsigned int pPreprocessing = 0u);
 
 
+	// -------------------------------------------------------------------
+	/** Export a scene to multiple files, possibly in different formats, 
+	 *  at once. 
+	 *
+	 *  This is equivalent to calling #Export for each target, but cheaper:
+	 *  targets which need the same preprocessing share a single processed 
+	 *  copy of the scene, and the export functions are then run concurrently.
+	 *  Each target writes to its own output stream, obtained from the 
+	 *  #IOSystem set via #SetIOHandler. Calls to IOSystem::Open and 
+	 *  IOSystem::Close are serialized, but a custom IOSystem must allow
+	 *  different streams to be written from different threads.
+	 * @param pScene The scene to export. Stays in possession of the caller.
+	 * @param pTargets Array of output files. The mResult and mError fields
+	 *   of each target receive the outcome of the export.
+	 * @param pNumTargets Number of entries in pTargets
+	 * @param pPreprocessing Post processing steps to apply, see #Export
+	 * @param pNumThreads Maximum number of threads to use. -1 selects one
+	 *   thread per hardware core, 0 or 1 export sequentially on the calling
+	 *   thread. Ignored if Assimp was built without threading support.
+	 * @return AI_SUCCESS if all targets were written successfully. Otherwise
+	 *   the error of the first failed target is available via #GetErrorString.*/
+	aiReturn ExportMultiple( const aiScene* pScene, ExportTarget* pTargets, size_t pNumTargets, 
+		unsigned int pPreprocessing = 0u, int pNumThreads = -1);
+
+
 	// -------------------------------------------------------------------
 	/** Returns an error description of an error that occurred in #Export
 	 *    or #ExportToBlob
@@ -210,7 +256,8 @@ public:
 	 *   error occurred. The string is never NULL.
 	 *
 	 * @note The returned function remains valid until one of the 
-	 * following methods is called: #Export, #ExportToBlob, #FreeBlob */
+	 * following methods is called: #Export, #ExportMultiple, #ExportToBlob,
+	 * #FreeBlob */
 	const char* GetErrorString() const;
 
 
@@ -451,6 +451,51 @@ public:
 		const std::string& pFile, 
 		unsigned int pFlags);
 
+	// -------------------------------------------------------------------
+	/** @brief Starts reading the given file on a background thread.
+	 *
+	 * The function returns immediately. The import behaves exactly like
+	 * #ReadFile, the result can be obtained from #WaitForReadFile. 
+	 * #ProgressHandler::ReadFileFinished is invoked from the worker 
+	 * thread as soon as the import is done. Use #CancelReadFile to 
+	 * abandon the import early. While the import is running, only 
+	 * #IsReadFileDone, #WaitForReadFile and #CancelReadFile may be
+	 * called, and the #ProgressHandler and #IOSystem must not be
+	 * replaced. Destroying the #Importer cancels a pending import.
+	 *
+	 * If Assimp was built without threading support, the file is
+	 * read synchronously before the function returns.
+	 * @param pFile Path and filename to the file to be imported.
+	 * @param pFlags Optional post processing steps, see #ReadFile
+	 * @return false if a previous asynchronous import has not yet been
+	 *   collected by #WaitForReadFile. */
+	bool ReadFileAsync(
+		const char* pFile, 
+		unsigned int pFlags);
+
+	// -------------------------------------------------------------------
+	/** @brief Checks whether the import started by #ReadFileAsync has 
+	 *  finished, without blocking.
+	 *  @return true if the import is done or no import is running. */
+	bool IsReadFileDone() const;
+
+	// -------------------------------------------------------------------
+	/** @brief Waits for the import started by #ReadFileAsync to finish.
+	 *  @return The imported scene, or NULL if the import failed or has
+	 *    been cancelled (see #GetErrorString). If no asynchronous import 
+	 *    is pending, the current scene is returned. */
+	const aiScene* WaitForReadFile();
+
+	// -------------------------------------------------------------------
+	/** @brief Requests the running import to be cancelled.
+	 *
+	 *  Importers and post processing steps check for cancellation
+	 *  regularly and stop at the next possible occasion, #ReadFile
+	 *  respectively #WaitForReadFile then return NULL. This may be called
+	 *  from any thread, also while a synchronous #ReadFile is running. 
+	 *  Returning false from #ProgressHandler::Update has the same effect. */
+	void CancelReadFile();
+
 	// -------------------------------------------------------------------
 	/** Frees the current scene.
 	 *
@@ -595,6 +640,44 @@ public:
 	 *   is (naturally) not included.*/
 	void GetMemoryRequirements(aiMemoryInfo& in) const;
 
+	// -------------------------------------------------------------------
+	/** Returns a detailed breakdown of the storage allocated by ASSIMP 
+	 * to hold the scene data in memory.
+	 *
+	 * This refers to the currently loaded file, see #ReadFile(). Unlike
+	 * aiMemoryInfo, the sizes are 64 bit wide and faces are accounted
+	 * with their actual number of indices.
+	 * @param in Data structure to be filled, zeroed if no scene is loaded.*/
+	void GetMemoryRequirements(aiSceneMemoryInfo& in) const;
+
+	// -------------------------------------------------------------------
+	/** Returns a detailed breakdown of the storage needed by any scene,
+	 * whether it has been imported by an Importer or not.
+	 *
+	 * @param pScene Scene to be measured, may be NULL.
+	 * @param in Data structure to be filled. */
+	static void GetMemoryRequirements(const aiScene* pScene, aiSceneMemoryInfo& in);
+
+	// -------------------------------------------------------------------
+	/** Returns the number of per-step memory records of the last import.
+	 *
+	 * Records are only kept if #AI_CONFIG_GLOB_MEASURE_MEMORY is set. 
+	 * There is one for the import itself, followed by one for each
+	 * post-processing step that has been executed, in order, including
+	 * internal helper steps (see aiStepMemoryInfo::step). Later
+	 * calls to #ApplyPostProcessing() append to the list. */
+	size_t GetStepMemoryInfoCount() const;
+
+	// -------------------------------------------------------------------
+	/** Returns a per-step memory record of the last import.
+	 *
+	 * @param iIndex Index of the record, less than 
+	 *   #GetStepMemoryInfoCount().
+	 * @return NULL if the index is out of range. The pointer remains 
+	 *   valid until the next call to #ReadFile(), #FreeScene() or 
+	 *   #ApplyPostProcessing(). */
+	const aiStepMemoryInfo* GetStepMemoryInfo(size_t iIndex) const;
+
 	// -------------------------------------------------------------------
 	/** Enables "extra verbose" mode. 
 	 *
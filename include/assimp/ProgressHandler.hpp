@@ -44,15 +44,44 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_PROGRESSHANDLER_H
 #define INCLUDED_AI_PROGRESSHANDLER_H
 #include "types.h"
+
+struct aiScene;
 namespace Assimp	{
 
 // ------------------------------------------------------------------------------------
 /** @brief CPP-API: Abstract interface for custom progress report receivers.
  *
  *  Each #Importer instance maintains its own #ProgressHandler. The default 
- *  implementation provided by Assimp doesn't do anything at all. */
+ *  implementation provided by Assimp doesn't do anything at all. 
+ *
+ *  Progress is reported per phase of the import through #UpdatePhase, 
+ *  which by default maps it onto a single percentage and forwards it to
+ *  #Update. If an import is running asynchronously (see 
+ *  #Importer::ReadFileAsync), all callbacks are invoked from the worker 
+ *  thread. 
+ *
+ *  #UpdatePhase and #ReadFileFinished have been added to the interface
+ *  after Assimp 3.0. Custom handlers compiled against older headers 
+ *  are not binary compatible and must be rebuilt. */
 class ASSIMP_API ProgressHandler 
 	: public Intern::AllocateFromAssimpHeap	{
+public:
+
+	/** Phases of an import, as reported to #UpdatePhase */
+	enum Phase {
+		/** Loading the file contents from the #IOSystem */
+		Phase_Read = 0,
+
+		/** Parsing the file contents */
+		Phase_Parse,
+
+		/** Converting the parsed data to an aiScene */
+		Phase_Convert,
+
+		/** Running the requested post processing steps */
+		Phase_PostProcess
+	};
+
 protected:
 	/** @brief	Default constructor	*/
 	ProgressHandler () {
@@ -79,11 +108,59 @@ public:
 	 *   caller). If the loading is aborted, #Importer::ReadFile()
 	 *   returns always NULL.
 	 *
-	 *  @note Currently, percentage is always -1.f because there is 
-	 *   no reliable way to compute it.
+	 *  @note The percentage is a rough estimate derived from the 
+	 *   progress of the individual phases, see #UpdatePhase. 
+	 *
+	 *  @note Earlier versions of Assimp ignored the return value and
+	 *   always completed the import. Implementations which return false
+	 *   without meaning to cancel must be changed to return true.
 	 *   */
 	virtual bool Update(float percentage = -1.f) = 0;
 
+	// -------------------------------------------------------------------
+	/** @brief Progress callback for a single phase of the import.
+	 *  @param phase Current phase
+	 *  @param current Number of units of work completed in this phase.
+	 *    During #Phase_PostProcess this is the number of steps which
+	 *    have been completed.
+	 *  @param total Total number of units of work in this phase, 0 if
+	 *    this is not known.
+	 *
+	 *  The same restrictions as for #Update apply. Phases may be skipped 
+	 *  and not every importer reports progress while parsing.
+	 *  The default implementation estimates the overall progress and
+	 *  passes it on to #Update, or -1.f for an unknown phase.
+	 *
+	 *  @return Return false to abort loading at the next possible 
+	 *    occasion, see #Update.
+	 */
+	virtual bool UpdatePhase(Phase phase, unsigned int current, unsigned int total) {
+		// share of each phase in the overall progress, in percent
+		static const float start[] = {0.f,10.f,40.f,50.f};
+		static const float range[] = {10.f,30.f,10.f,50.f};
+
+		// no estimate for phases this version doesn't know about
+		if (static_cast<unsigned int>(phase) >= sizeof(start)/sizeof(start[0])) {
+			return Update();
+		}
+
+		const float f = total ? (current < total ? current / static_cast<float>(total) : 1.f) : 0.f;
+		return Update(start[phase] + f * range[phase]);
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Called when an import started via #Importer::ReadFileAsync
+	 *    has finished, from the worker thread.
+	 *  @param pScene The imported scene, NULL if the import failed or has
+	 *    been cancelled. #Importer::WaitForReadFile returns the same value.
+	 *
+	 *  Do not call any #Importer methods from within this callback.
+	 *  The default implementation does nothing.
+	 */
+	virtual void ReadFileFinished(const aiScene* pScene) {
+		(void)pScene;
+	}
+
 
 
 }; // !class ProgressHandler 
@@ -0,0 +1,150 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file SkinningStream.hpp
+ *  @brief Packs the bone weights of a mesh into per-vertex arrays
+ *   suitable for hardware skinning.
+*/
+
+#ifndef AI_SKINNINGSTREAM_H_INC
+#define AI_SKINNINGSTREAM_H_INC
+
+#ifndef __cplusplus
+#	error This header requires C++ to be used.
+#endif
+
+#include "mesh.h"
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** @brief CPP-API: Converts the bone weights of a mesh to a fixed number of
+ *  influences per vertex, ready to be uploaded as vertex attributes.
+ *
+ *  Assimp stores bone weights per bone (aiBone::mWeights). A vertex shader
+ *  needs them per vertex instead: a fixed number of bone indices and 
+ *  weights for each vertex. The stream holds two arrays of 
+ *  #GetNumVertices() * #GetNumInfluences() 16 bit values:
+ *
+ *  - the bone indices, referring to aiMesh::mBones (and thus to the 
+ *    matrices of AnimationEvaluator::GetBonePalette()),
+ *  - the weights as normalized unsigned integers, 65535 being 1.0.
+ *
+ *  If a vertex is affected by more bones than that, the least important
+ *  weights are dropped, just like #aiProcess_LimitBoneWeights does. The
+ *  remaining weights are renormalized and quantized so that they sum up to
+ *  exactly 65535. Unused slots receive bone index 0 and weight 0, as do all
+ *  slots of vertices without any bone weights.
+ *
+ *  @code
+ *  Assimp::SkinningStream stream(mesh,4);
+ *  upload(stream.GetBoneIndices(), stream.GetBoneWeights());
+ *  @endcode
+ *
+ *  The stream is a snapshot, it does not refer to the mesh after 
+ *  construction.
+ */
+class ASSIMP_API SkinningStream
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Builds the stream for a mesh.
+	 *
+	 *  @param pMesh Mesh with at most 65536 bones. 
+	 *  @param pNumInfluences Number of influences per vertex, usually 4
+	 *    or 8. Must not be 0.
+	 */
+	SkinningStream(const aiMesh* pMesh, unsigned int pNumInfluences = 4);
+
+	~SkinningStream();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the number of vertices, which is the vertex count
+	 *    of the mesh. */
+	unsigned int GetNumVertices() const {
+		return mNumVertices;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the number of influences per vertex. */
+	unsigned int GetNumInfluences() const {
+		return mNumInfluences;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the bone indices, #GetNumInfluences() per vertex.
+	 *    NULL if the mesh has no vertices. */
+	const unsigned short* GetBoneIndices() const {
+		return mIndices;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the weights, #GetNumInfluences() per vertex.
+	 *    NULL if the mesh has no vertices. */
+	const unsigned short* GetBoneWeights() const {
+		return mWeights;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the number of bone weights of the mesh which did
+	 *    not fit into the stream. */
+	unsigned int GetNumDroppedInfluences() const {
+		return mNumDropped;
+	}
+
+private:
+
+	// not copyable
+	SkinningStream(const SkinningStream&);
+	SkinningStream& operator = (const SkinningStream&);
+
+	unsigned int mNumVertices;
+	unsigned int mNumInfluences;
+	unsigned int mNumDropped;
+
+	unsigned short* mIndices;
+	unsigned short* mWeights;
+};
+
+} //!ns Assimp
+
+#endif //AI_SKINNINGSTREAM_H_INC
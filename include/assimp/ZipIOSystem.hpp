@@ -0,0 +1,163 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ZipIOSystem.hpp
+ *  @brief IOSystem implementation which serves the files stored in a
+ *   zip archive (.zip, .pk3).
+*/
+
+#ifndef AI_ZIPIOSYSTEM_H_INC
+#define AI_ZIPIOSYSTEM_H_INC
+
+#ifndef __cplusplus
+#	error This header requires C++ to be used.
+#endif
+
+#include "IOSystem.hpp"
+
+namespace Assimp	{
+class ZipIOSystemPimpl;
+
+// ---------------------------------------------------------------------------
+/** @brief CPP-API: File system which reads from a zip archive.
+ *
+ *  The central directory of the archive is indexed once when the archive is
+ *  opened, members are only decompressed when they are opened. Members up to
+ *  the streaming threshold are inflated into memory as a whole, larger ones
+ *  are decompressed while they are being read, so they never need to be held
+ *  in memory completely.
+ *
+ *  Files can be opened, read and closed from several threads concurrently as
+ *  long as each stream is used by one thread at a time. The IOSystem used to
+ *  access the archive file itself must be thread-safe in this case (the
+ *  default implementation is).
+ *
+ *  Paths are relative to the root of the archive. Both slashes and backslashes
+ *  are accepted as separators, '.' and '..' are resolved. If no member with
+ *  exactly the requested name exists, the lookup is repeated ignoring case.
+ *
+ *  @code
+ *  Assimp::Importer importer;
+ *  importer.SetIOHandler(new Assimp::ZipIOSystem("bundle.zip"));
+ *  const aiScene* scene = importer.ReadFile("models/house.dae",0);
+ *  @endcode
+ */
+class ASSIMP_API ZipIOSystem : public IOSystem
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Opens an archive and indexes its contents.
+	 *
+	 *  @param pArchive Path to the archive.
+	 *  @param pIOHandler IOSystem to access the archive with. The default
+	 *    file system is used if NULL is passed. It is not owned by the
+	 *    ZipIOSystem and must outlive it.
+	 *  @note Check #IsOpen() to see whether the archive could be read.
+	 */
+	ZipIOSystem(const char* pArchive, IOSystem* pIOHandler = NULL);
+
+	// -------------------------------------------------------------------
+	/** @brief Closes the archive. All streams opened from it must have
+	 *    been closed before. */
+	~ZipIOSystem();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Returns whether the archive has been opened successfully. */
+	bool IsOpen() const;
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the number of files in the archive. Directory
+	 *    entries are not counted. */
+	unsigned int GetNumFiles() const;
+
+	// -------------------------------------------------------------------
+	/** @brief Returns the name of a file in the archive.
+	 *
+	 *  The files are sorted by name.
+	 *  @param pIndex Index of the file, must be smaller than #GetNumFiles().
+	 *  @return Name of the file, NULL if the index is out of range.
+	 */
+	const char* GetFileName(unsigned int pIndex) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Sets the size above which members are decompressed while
+	 *    they are read instead of being inflated into memory on open.
+	 *
+	 *  Streaming members can be seeked, but seeking backwards restarts
+	 *  the decompression. The default threshold is 4 MB. Set it before
+	 *  opening any files.
+	 *  @param pBytes Uncompressed size in bytes.
+	 */
+	void SetStreamingThreshold(size_t pBytes);
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Tests for the existence of a file in the archive. */
+	bool Exists( const char* pFile) const;
+
+	// -------------------------------------------------------------------
+	/** Returns '/', the separator used by zip archives. */
+	char getOsSeparator() const;
+
+	// -------------------------------------------------------------------
+	/** Opens a file in the archive. Only reading is supported, NULL is
+	 *  returned if a write mode is requested. */
+	IOStream* Open(const char* pFile, const char* pMode = "rb");
+
+	// -------------------------------------------------------------------
+	/** Closes a file previously opened by #Open(). */
+	void Close( IOStream* pFile);
+
+	// -------------------------------------------------------------------
+	/** Compares two paths after resolving them as #Open() does. */
+	bool ComparePaths (const char* one, const char* second) const;
+
+private:
+
+	ZipIOSystemPimpl* pimpl;
+};
+
+} //!ns Assimp
+
+#endif //AI_ZIPIOSYSTEM_H_INC
@@ -330,6 +330,16 @@ ASSIMP_API void aiGetMemoryRequirements(
 	const C_STRUCT aiScene* pIn,
 	C_STRUCT aiMemoryInfo* in);
 
+// --------------------------------------------------------------------------------
+/** Get a detailed breakdown of the storage required by a scene
+ * @param pIn Input scene. Unlike aiGetMemoryRequirements(), it need not 
+ *   have been imported by Assimp.
+ * @param in Data structure to be filled. 
+ */
+ASSIMP_API void aiGetSceneMemoryRequirements(
+	const C_STRUCT aiScene* pIn,
+	C_STRUCT aiSceneMemoryInfo* in);
+
 
 
 // --------------------------------------------------------------------------------
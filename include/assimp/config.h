@@ -77,12 +77,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CONFIG_GLOB_MEASURE_TIME  \
 	"GLOB_MEASURE_TIME"
 
-# if 0 // not implemented yet
+// ---------------------------------------------------------------------------
+/** @brief Enables per-step scene memory accounting.
+ *
+ *  If enabled, the size of the scene is computed after the import and
+ *  after each post-processing step. The records, including the high-water
+ *  mark reached so far, can be queried via Importer::GetStepMemoryInfo()
+ *  and are dumped to the DefaultLogger. Computing them walks the whole 
+ *  scene twice per step, so don't enable this in production.
+ * 
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_GLOB_MEASURE_MEMORY  \
+	"GLOB_MEASURE_MEMORY"
+
 // ---------------------------------------------------------------------------
 /** @brief Set Assimp's multithreading policy.
  *
  * This setting is ignored if Assimp was built without boost.thread
- * support (ASSIMP_BUILD_NO_THREADING, which is implied by ASSIMP_BUILD_BOOST_WORKAROUND).
+ * support (i.e. without ASSIMP_BUILD_MULTITHREADED, which is not available
+ * with ASSIMP_BUILD_BOOST_WORKAROUND).
  * Possible values are: -1 to let Assimp decide what to do, 0 to disable
  * multithreading entirely and any number larger than 0 to force a specific
  * number of threads. Assimp is always free to ignore this settings, which is
@@ -95,8 +109,79 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #define AI_CONFIG_GLOB_MULTITHREADING  \
 	"GLOB_MULTITHREADING"
+
+// ---------------------------------------------------------------------------
+/** @brief Minimum number of records for a text loader to parse them on
+ *  multiple threads.
+ *
+ * The SMD, ASE and MD5 loaders split their largest sections (SMD vertex 
+ * lines, ASE faces and MD5 animation frame lines) into independent records.
+ * Sections with at least this many records are parsed on the threads given
+ * by #AI_CONFIG_GLOB_MULTITHREADING, smaller ones on the calling thread. 
+ * Lowering it is mostly useful to test the parallel code paths with small
+ * files.
+ * @note The default value is AI_PARALLEL_DEFAULT_THRESHOLD
+ * Property type: integer.
+ */
+#define AI_CONFIG_GLOB_PARALLEL_THRESHOLD  \
+	"GLOB_PARALLEL_THRESHOLD"
+
+// default value for AI_CONFIG_GLOB_PARALLEL_THRESHOLD
+#if (!defined AI_PARALLEL_DEFAULT_THRESHOLD)
+#	define AI_PARALLEL_DEFAULT_THRESHOLD		10000
+#endif
+
+// ---------------------------------------------------------------------------
+/** @brief Number of records handed out to a worker thread at once if a 
+ *  text loader parses a section on multiple threads.
+ *
+ * See #AI_CONFIG_GLOB_PARALLEL_THRESHOLD. The MD5 loader always hands out
+ * whole frames and ignores this setting.
+ * @note The default value is AI_PARALLEL_DEFAULT_CHUNK
+ * Property type: integer, must be at least 1.
+ */
+#define AI_CONFIG_GLOB_PARALLEL_CHUNK  \
+	"GLOB_PARALLEL_CHUNK"
+
+// default value for AI_CONFIG_GLOB_PARALLEL_CHUNK
+#if (!defined AI_PARALLEL_DEFAULT_CHUNK)
+#	define AI_PARALLEL_DEFAULT_CHUNK		2048
 #endif
 
+// ---------------------------------------------------------------------------
+/** @brief Keep the imported scene in a memory pool owned by the Importer.
+ *
+ * If enabled, the final scene is copied into a few large memory blocks after
+ * post-processing, with the face indices of each mesh stored contiguously. 
+ * Loaders and post-processing steps still work on the heap, and the scene
+ * data structures are unchanged. Importer::FreeScene() (and the next 
+ * ReadFile()) then only reset the pool, which keeps its memory for the next
+ * file. This is useful if a single Importer instance is used to read many
+ * files in a row. 
+ * The scene must not be modified structurally while it is in the pool. 
+ * Importer::GetOrphanedScene() and Importer::ApplyPostProcessing() move it
+ * back to regular heap memory first.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_GLOB_SCENE_POOL  \
+	"GLOB_SCENE_POOL"
+
+// ---------------------------------------------------------------------------
+/** @brief Store the face indices of a mesh in a single shared array.
+ *
+ * If enabled, the OBJ, STL, PLY, 3DS and Q3BSP loaders put the indices of
+ * all faces of a mesh into one allocation, aiMesh::mFaceIndices, and every
+ * aiFace::mIndices points into it. This saves one heap allocation per
+ * face. Post-processing steps keep the layout of the meshes they get, 
+ * so meshes from other loaders are not affected.
+ * The faces of such meshes do not own their indices: never assign to, 
+ * delete or reallocate a single face or the aiMesh::mFaces array of them.
+ * Use aiMesh::DeleteFaces() instead. Reading the faces works as usual.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_GLOB_SHARED_FACE_INDICES  \
+	"GLOB_SHARED_FACE_INDICES"
+
 // ###########################################################################
 // POST PROCESSING SETTINGS
 // Various stuff to fine-tune the behavior of a specific post processing step.
@@ -453,6 +538,94 @@ enum aiComponent
 #define AI_CONFIG_PP_FID_ANIM_ACCURACY				\
 	"PP_FID_ANIM_ACCURACY"
 
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_ValidateDataStructure step:
+ *  Enables the fast validation mode and specifies the number of faces, 
+ *  bone weights and animation keys to be checked per mesh, bone and
+ *  animation channel.
+ *
+ *  All other structural checks are still done for every mesh, bone, 
+ *  animation channel, material and node, but the checks that require
+ *  to look at all faces or weights of a mesh (vertices referenced twice
+ *  or not at all, bone weight sums, duplicate bone names) are skipped. 
+ *  The samples are picked pseudo-randomly, but always include the last
+ *  element of each array. This is cheap enough to keep the validation 
+ *  enabled for all imports. 0 checks all elements.
+ *  This is an integer property, its default value is 0.
+ */
+#define AI_CONFIG_PP_VDS_SAMPLES				\
+	"PP_VDS_SAMPLES"
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_OptimizeAnimations step:
+ *  Specifies the maximum distance between a position key that is removed
+ *  and the position interpolated from the remaining keys at its time. 
+ *
+ *  The distance is measured in the coordinate space of the animated node,
+ *  keep in mind that errors add up along the node hierarchy.
+ *  This is a float property, its default value is #AI_OA_POSITION_EPSILON.
+ */
+#define AI_CONFIG_PP_OA_POSITION_EPSILON		\
+	"PP_OA_POSITION_EPSILON"
+
+#if (!defined AI_OA_POSITION_EPSILON)
+#	define AI_OA_POSITION_EPSILON	1e-4f
+#endif // !! AI_OA_POSITION_EPSILON
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_OptimizeAnimations step:
+ *  Specifies the maximum angle, in radians, between a rotation key that 
+ *  is removed and the rotation interpolated from the remaining keys.
+ *  This is a float property, its default value is #AI_OA_ROTATION_EPSILON.
+ */
+#define AI_CONFIG_PP_OA_ROTATION_EPSILON		\
+	"PP_OA_ROTATION_EPSILON"
+
+#if (!defined AI_OA_ROTATION_EPSILON)
+#	define AI_OA_ROTATION_EPSILON	1e-4f
+#endif // !! AI_OA_ROTATION_EPSILON
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_OptimizeAnimations step:
+ *  Specifies the maximum difference between a scaling key that is removed
+ *  and the scaling interpolated from the remaining keys.
+ *  This is a float property, its default value is #AI_OA_SCALING_EPSILON.
+ */
+#define AI_CONFIG_PP_OA_SCALING_EPSILON		\
+	"PP_OA_SCALING_EPSILON"
+
+#if (!defined AI_OA_SCALING_EPSILON)
+#	define AI_OA_SCALING_EPSILON	1e-4f
+#endif // !! AI_OA_SCALING_EPSILON
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_OptimizeAnimations step:
+ *  Resamples all animation channels to the given number of keys per 
+ *  second before redundant keys are removed.
+ *
+ *  Each channel is sampled at regular intervals from its first to its
+ *  last key. Resampling to a rate below the one of the source data 
+ *  smoothes out details. This is a float property, its default value
+ *  is 0, which keeps the original keys.
+ */
+#define AI_CONFIG_PP_OA_SAMPLE_RATE			\
+	"PP_OA_SAMPLE_RATE"
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_OptimizeAnimations step:
+ *  Quantizes rotation keys to the given number of bits per component.
+ *
+ *  Rotations are replaced by the values an application decodes when 
+ *  storing the three smallest quaternion components with the given 
+ *  precision (the largest one follows from the unit length). 16 bits 
+ *  are accurate to less than 0.0001 radians. The rotation error configured
+ *  with #AI_CONFIG_PP_OA_ROTATION_EPSILON should not be lower than that.
+ *  This is an integer property, valid values are 2 to 23. The default
+ *  value is 0, which keeps the rotations as they are.
+ */
+#define AI_CONFIG_PP_OA_QUANTIZE_ROTATIONS		\
+	"PP_OA_QUANTIZE_ROTATIONS"
+
 
 // TransformUVCoords evaluates UV scalings
 #define AI_UVTRAFO_SCALING 0x1
@@ -499,9 +672,9 @@ enum aiComponent
 // ---------------------------------------------------------------------------
 /** @brief  Set the vertex animation keyframe to be imported
  *
- * ASSIMP does not support vertex keyframes (only bone animation is supported).
- * The library reads only one frame of models with vertex animations.
- * By default this is the first frame.
+ * The library reads only one frame of models with vertex animations into
+ * the regular mesh data, by default this is the first frame. See 
+ * #AI_CONFIG_IMPORT_MORPH_TARGETS to import the other frames as well.
  * \note The default value is 0. This option applies to all importers.
  *   However, it is also possible to override the global setting
  *   for a specific loader. You can use the AI_CONFIG_IMPORT_XXX_KEYFRAME
@@ -518,6 +691,26 @@ enum aiComponent
 #define AI_CONFIG_IMPORT_SMD_KEYFRAME		"IMPORT_SMD_KEYFRAME"
 #define AI_CONFIG_IMPORT_UNREAL_KEYFRAME	"IMPORT_UNREAL_KEYFRAME"
 
+// ---------------------------------------------------------------------------
+/** @brief  Import all frames of models with vertex animations as morph targets.
+ *
+ * If enabled, the MD2, MD3, MDC, Quake 1 MDL and Unreal loaders decode all 
+ * frames of the file in a single pass. The frame selected by 
+ * #AI_CONFIG_IMPORT_GLOBAL_KEYFRAME remains the base pose of the mesh, each
+ * frame (the base frame included) is stored in aiMesh::mAnimMeshes. The
+ * anim meshes replace the vertex positions and normals only, all other
+ * vertex components are shared with the host mesh. A single aiAnimation
+ * with one aiMeshAnim channel per mesh binds frame n to time n.
+ * Steps which split meshes or reorder their vertices split the anim meshes
+ * alongside, aiProcess_OptimizeMeshes does not join meshes with anim meshes
+ * and aiProcess_PreTransformVertices drops them unless
+ * #AI_CONFIG_PP_PTV_KEEP_HIERARCHY is set. Steps which compute new vertex
+ * components, such as aiProcess_GenSmoothNormals, leave the anim meshes
+ * untouched.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_IMPORT_MORPH_TARGETS		"IMPORT_MORPH_TARGETS"
+
 
 // ---------------------------------------------------------------------------
 /** @brief  Configures the AC loader to collect all surfaces which have the
@@ -561,6 +754,41 @@ enum aiComponent
 #define AI_CONFIG_IMPORT_TER_MAKE_UVS \
 	"IMPORT_TER_MAKE_UVS"
 
+// ---------------------------------------------------------------------------
+/** @brief Configures the terrain importers (Terragen, 3D GameStudio HMP) to
+ *  split terrains into tiles with shared vertices.
+ *
+ * By default, a terrain is returned as a single mesh with four unshared
+ * vertices per quad. If this is set to a value larger than 0, the terrain
+ * is divided into square tiles of at most this many quads along each edge
+ * instead. Each tile is a mesh of quads sharing their vertices and gets a
+ * node named 'tile_<x>_<y>' below the root node of the terrain. Tile nodes
+ * carry aiMetadata 'min' and 'max' (aiVector3D), the axis-aligned bounding
+ * box of the tile in the space of the tile node, which is useful to cull
+ * or stream tiles. 
+ * See #AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS for levels of detail.
+ * Property type: integer. Default value: 0.
+ */
+#define AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE \
+	"IMPORT_TERRAIN_TILE_SIZE"
+
+// ---------------------------------------------------------------------------
+/** @brief Configures the terrain importers to build coarser levels of 
+ *  detail for each terrain tile.
+ *
+ * This is only used if #AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE is set. Each 
+ * level skips every second row and column of vertices of the previous
+ * one, but keeps the borders of the tile so tiles of the same level match.
+ * If a tile has multiple levels, its meshes are attached to child nodes
+ * named 'tile_<x>_<y>_lod<n>' rather than to the tile node, n = 0 being
+ * the full resolution. Selecting the level to render is up to the
+ * application. Fewer levels are built for tiles which are down to a
+ * single quad earlier.
+ * Property type: integer. Default value: 0.
+ */
+#define AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS \
+	"IMPORT_TERRAIN_LOD_LEVELS"
+
 // ---------------------------------------------------------------------------
 /** @brief  Configures the ASE loader to always reconstruct normal vectors
  *	basing on the smoothing groups loaded from the file.
@@ -673,6 +901,29 @@ enum aiComponent
 #define AI_CONFIG_IMPORT_IRR_ANIM_FPS				\
 	"IMPORT_IRR_ANIM_FPS"
 
+// ---------------------------------------------------------------------------
+/** @brief Specifies whether the Q3BSP loader splits the level by the
+ *  visibility clusters of its BSP tree.
+ *
+ * If enabled, the root node gets one child 'cluster_<n>' per cluster with
+ * the meshes of all faces in that cluster. Faces in several clusters form
+ * meshes of their own which are shared by the respective nodes. Faces outside
+ * of any cluster are placed in a node 'unclustered'. Cluster nodes carry 
+ * aiMetadata: 'cluster' (int), 'min' and 'max' (aiVector3D, bounding box) and
+ * 'pvs' (aiString), the potentially visible set as hex string. Cluster c 
+ * is visible from this cluster if bit (c & 7) of byte (c >> 3) is set.
+ * Because of the length limit of aiString, 'pvs' is omitted for levels with
+ * 512 or more bytes per bit vector (more than 4088 clusters).<br>
+ * The BSP tree itself is appended to the root node as well, starting with
+ * 'bsp_node_0'. Inner nodes have the metadata 'plane_normal' (aiVector3D),
+ * 'plane_distance' (float), 'min' and 'max' and two children - the front
+ * and the back side. Leafs are named 'bsp_leaf_<n>' and have the metadata 
+ * 'cluster', 'min' and 'max'.<br>
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_IMPORT_Q3BSP_CLUSTERS				\
+	"IMPORT_Q3BSP_CLUSTERS"
+
 
 // ---------------------------------------------------------------------------
 /** @brief Ogre Importer will try to load this Materialfile.
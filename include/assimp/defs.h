@@ -213,10 +213,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 	/* Define ASSIMP_BUILD_SINGLETHREADED to compile assimp
 	 * without threading support. The library doesn't utilize
 	 * threads then and is itself not threadsafe.
-	 * If this flag is specified boost::threads is *not* required. */
+	 * If this flag is specified boost::threads is *not* required.
+	 * This is the default unless ASSIMP_BUILD_MULTITHREADED is defined. */
 	//////////////////////////////////////////////////////////////////////////
-#ifndef ASSIMP_BUILD_SINGLETHREADED
-#	define ASSIMP_BUILD_SINGLETHREADED
+#ifndef ASSIMP_BUILD_MULTITHREADED
+#	ifndef ASSIMP_BUILD_SINGLETHREADED
+#		define ASSIMP_BUILD_SINGLETHREADED
+#	endif
 #endif
 
 #ifndef ASSIMP_BUILD_SINGLETHREADED
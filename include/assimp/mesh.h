@@ -325,7 +325,7 @@ enum aiPrimitiveType
 
 
 // ---------------------------------------------------------------------------
-/** @brief NOT CURRENTLY IN USE. An AnimMesh is an attachment to an #aiMesh stores per-vertex 
+/** @brief An AnimMesh is an attachment to an #aiMesh stores per-vertex 
  *  animations for a particular frame.
  *  
  *  You may think of an #aiAnimMesh as a `patch` for the host mesh, which
@@ -334,6 +334,9 @@ enum aiPrimitiveType
  *  The actual relationship between the time line and anim meshes is 
  *  established by #aiMeshAnim, which references singular mesh attachments
  *  by their ID and binds them to a time offset.
+ *
+ *  Anim meshes are currently generated by the loaders for formats
+ *  with vertex animations if #AI_CONFIG_IMPORT_MORPH_TARGETS is set.
 */
 struct aiAnimMesh
 {
@@ -591,14 +594,26 @@ struct aiMesh
 	C_STRUCT aiString mName;
 
 
-	/** NOT CURRENTLY IN USE. The number of attachment meshes */
+	/** The number of attachment meshes */
 	unsigned int mNumAnimMeshes;
 
-	/** NOT CURRENTLY IN USE. Attachment meshes for this mesh, for vertex-based animation. 
+	/** Attachment meshes for this mesh, for vertex-based animation. 
 	 *  Attachment meshes carry replacement data for some of the
 	 *  mesh'es vertex components (usually positions, normals). */
 	C_STRUCT aiAnimMesh** mAnimMeshes;
 
+	/** Shared index storage of all faces, NULL if each face owns its
+	 *  own aiFace::mIndices array.
+	 *  If present, the indices of all faces are stored in this single
+	 *  array and each aiFace::mIndices points into it. The faces do not 
+	 *  own their indices then, so never delete or reallocate the index
+	 *  array of a single face of such a mesh. Reading the faces works
+	 *  the same in both cases. Loaders only produce such meshes if
+	 *  #AI_CONFIG_GLOB_SHARED_FACE_INDICES is set. This member has been 
+	 *  appended to keep the offsets of all other members unchanged, but
+	 *  it does change sizeof(aiMesh). */
+	unsigned int* mFaceIndices;
+
 
 #ifdef __cplusplus
 
@@ -627,6 +642,7 @@ struct aiMesh
 		mMaterialIndex = 0;
 		mNumAnimMeshes = 0;
 		mAnimMeshes = NULL;
+		mFaceIndices = NULL;
 	}
 
 	//! Deletes all storage allocated for the mesh
@@ -658,7 +674,54 @@ struct aiMesh
 			delete [] mAnimMeshes;
 		}
 
+		DeleteFaces();
+	}
+
+	//! Check whether all face indices are stored in #mFaceIndices
+	bool HasSharedFaceIndices() const 
+		{ return mFaceIndices != NULL; }
+
+	//! Move the indices of all faces into a single #mFaceIndices array. 
+	//! Faces whose mIndices is NULL get uninitialized room for mNumIndices
+	//! indices, so a mesh can be built by allocating mFaces, setting the
+	//! index counts and calling this function before writing the indices.
+	//! Nothing happens if the indices are shared already.
+	void PackFaceIndices()
+	{
+		if (mFaceIndices || !mFaces) {
+			return;
+		}
+		size_t total = 0;
+		for( unsigned int a = 0; a < mNumFaces; a++) {
+			total += mFaces[a].mNumIndices;
+		}
+		if (!total) {
+			return;
+		}
+		unsigned int* out = mFaceIndices = new unsigned int[total];
+		for( unsigned int a = 0; a < mNumFaces; a++) {
+			aiFace& f = mFaces[a];
+			if (f.mIndices) {
+				::memcpy(out,f.mIndices,f.mNumIndices * sizeof(unsigned int));
+				delete [] f.mIndices;
+			}
+			f.mIndices = f.mNumIndices ? out : NULL;
+			out += f.mNumIndices;
+		}
+	}
+
+	//! Delete all faces and their indices, whether they are shared or not
+	void DeleteFaces()
+	{
+		if (mFaceIndices && mFaces) {
+			for( unsigned int a = 0; a < mNumFaces; a++) {
+				mFaces[a].mIndices = NULL;
+			}
+		}
+		delete [] mFaceIndices;
 		delete [] mFaces;
+		mFaceIndices = NULL;
+		mFaces = NULL;
 	}
 
 	//! Check whether the mesh contains positions. Provided no special
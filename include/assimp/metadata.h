@@ -0,0 +1,239 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file metadata.h
+ *  @brief Defines the data structures for holding node meta information.
+ */
+
+#ifndef __AI_METADATA_H_INC__
+#define __AI_METADATA_H_INC__
+
+#include "types.h"
+
+// -------------------------------------------------------------------------------
+/** Enumerates the types of values which can be stored in an #aiMetadata.
+ */
+// -------------------------------------------------------------------------------
+enum aiMetadataType
+{
+	AI_BOOL       = 0,
+	AI_INT        = 1,
+	AI_UINT64     = 2,
+	AI_FLOAT      = 3,
+	AI_AISTRING   = 4,
+	AI_AIVECTOR3D = 5,
+
+	/** This value is not used. It is just there to force the
+	 *  compiler to map this enum to a 32 Bit integer.
+	 */
+#ifndef SWIG
+	_aiMetadataType_Force32Bit = 0x7fffffff
+#endif
+};
+
+// -------------------------------------------------------------------------------
+/** A single value of an #aiMetadata container.
+ *
+ *  mData points to a single value of the type given by mType, i.e. to 
+ *  a bool, int, ai_uint64, float, aiString or aiVector3D.
+ */
+// -------------------------------------------------------------------------------
+struct aiMetadataEntry
+{
+	C_ENUM aiMetadataType mType;
+	void* mData;
+};
+
+#ifdef __cplusplus
+
+// -------------------------------------------------------------------------------
+/** Helpers to map C++ types to their #aiMetadataType.
+ */
+// -------------------------------------------------------------------------------
+inline aiMetadataType GetAiType( bool )                { return AI_BOOL; }
+inline aiMetadataType GetAiType( int )                 { return AI_INT; }
+inline aiMetadataType GetAiType( ai_uint64 )           { return AI_UINT64; }
+inline aiMetadataType GetAiType( float )               { return AI_FLOAT; }
+inline aiMetadataType GetAiType( const aiString& )     { return AI_AISTRING; }
+inline aiMetadataType GetAiType( const aiVector3D& )   { return AI_AIVECTOR3D; }
+
+#endif
+
+// -------------------------------------------------------------------------------
+/** Container for holding metadata.
+ *
+ *  Metadata is a key-value store of typed values attached to an #aiNode.
+ *  Loaders use it to pass on information which has no other place in the 
+ *  data structure, such as the visibility information of a BSP level.
+ *  Keys are not required to be unique, but usually are.
+ */
+// -------------------------------------------------------------------------------
+struct aiMetadata 
+{
+	/** Length of the mKeys and mValues arrays, respectively */
+	unsigned int mNumProperties;
+
+	/** Arrays of keys, may not be NULL. Entries in this array may not be NULL as well. */
+	C_STRUCT aiString* mKeys;
+
+	/** Arrays of values, may not be NULL. Entries in this array may be NULL if the
+	  * corresponding property key has no assigned value. */
+	C_STRUCT aiMetadataEntry* mValues;
+
+#ifdef __cplusplus
+
+	/** Allocates storage for a given number of (yet unassigned) properties */
+	explicit aiMetadata(unsigned int numProperties = 0)
+		: mNumProperties(numProperties)
+		, mKeys(numProperties ? new aiString[numProperties] : NULL)
+		, mValues(numProperties ? new aiMetadataEntry[numProperties] : NULL)
+	{
+		for (unsigned int i = 0; i < mNumProperties; ++i) {
+			mValues[i].mType = AI_BOOL;
+			mValues[i].mData = NULL;
+		}
+	}
+
+	/** Destructor */
+	~aiMetadata()
+	{
+		for (unsigned int i = 0; i < mNumProperties; ++i) {
+			FreeValue(mValues[i]);
+		}
+		delete[] mKeys;
+		delete[] mValues;
+	}
+
+	/** Assigns the key and value of a property, replacing whatever was stored there */
+	template<typename T>
+	inline void Set(unsigned int index, const std::string& key, const T& value)
+	{
+		if (index >= mNumProperties) {
+			return;
+		}
+		FreeValue(mValues[index]);
+		mKeys[index].Set(key);
+		mValues[index].mType = GetAiType(value);
+		mValues[index].mData = new T(value);
+	}
+
+	/** Retrieves the value of a property by index. Returns false if there
+	 *  is no such property or if its type does not match T */
+	template<typename T>
+	inline bool Get(unsigned int index, T& value) const
+	{
+		if (index >= mNumProperties || !mValues[index].mData || 
+			GetAiType(value) != mValues[index].mType) {
+			return false;
+		}
+		value = *static_cast<T*>(mValues[index].mData);
+		return true;
+	}
+
+	/** Retrieves the value of the first property with a given key */
+	template<typename T>
+	inline bool Get(const aiString& key, T& value) const
+	{
+		for (unsigned int i = 0; i < mNumProperties; ++i) {
+			if (mKeys[i] == key) {
+				return Get(i, value);
+			}
+		}
+		return false;
+	}
+
+	/** @override */
+	template<typename T>
+	inline bool Get(const std::string& key, T& value) const
+	{
+		return Get(aiString(key), value);
+	}
+
+	/** Deep copy of another metadata container */
+	static aiMetadata* Copy(const aiMetadata* src)
+	{
+		aiMetadata* dest = new aiMetadata(src->mNumProperties);
+		for (unsigned int i = 0; i < src->mNumProperties; ++i) {
+			const aiMetadataEntry& in = src->mValues[i];
+			dest->mKeys[i] = src->mKeys[i];
+			dest->mValues[i].mType = in.mType;
+			if (!in.mData) {
+				continue;
+			}
+			switch (in.mType)
+			{
+			case AI_BOOL:       dest->mValues[i].mData = new bool(*static_cast<bool*>(in.mData)); break;
+			case AI_INT:        dest->mValues[i].mData = new int(*static_cast<int*>(in.mData)); break;
+			case AI_UINT64:     dest->mValues[i].mData = new ai_uint64(*static_cast<ai_uint64*>(in.mData)); break;
+			case AI_FLOAT:      dest->mValues[i].mData = new float(*static_cast<float*>(in.mData)); break;
+			case AI_AISTRING:   dest->mValues[i].mData = new aiString(*static_cast<aiString*>(in.mData)); break;
+			case AI_AIVECTOR3D: dest->mValues[i].mData = new aiVector3D(*static_cast<aiVector3D*>(in.mData)); break;
+			default: break;
+			}
+		}
+		return dest;
+	}
+
+private:
+
+	static void FreeValue(aiMetadataEntry& entry)
+	{
+		switch (entry.mType)
+		{
+		case AI_BOOL:       delete static_cast<bool*>(entry.mData); break;
+		case AI_INT:        delete static_cast<int*>(entry.mData); break;
+		case AI_UINT64:     delete static_cast<ai_uint64*>(entry.mData); break;
+		case AI_FLOAT:      delete static_cast<float*>(entry.mData); break;
+		case AI_AISTRING:   delete static_cast<aiString*>(entry.mData); break;
+		case AI_AIVECTOR3D: delete static_cast<aiVector3D*>(entry.mData); break;
+		default: break;
+		}
+		entry.mData = NULL;
+	}
+
+	// no copying, use Copy() instead
+	aiMetadata(const aiMetadata&);
+	aiMetadata& operator= (const aiMetadata&);
+
+#endif // __cplusplus
+};
+
+#endif // __AI_METADATA_H_INC__
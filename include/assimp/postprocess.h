@@ -228,7 +228,8 @@ enum aiPostProcessSteps
 	* supply your own limit to the post processing step.
 	*
 	* If you intend to perform the skinning in hardware, this post processing 
-	* step might be of interest to you.
+	* step might be of interest to you. Assimp::SkinningStream converts the
+	* result to per-vertex bone indices and weights.
 	*/
 	aiProcess_LimitBoneWeights = 0x200,
 
@@ -256,7 +257,9 @@ enum aiPostProcessSteps
 	 * </ul>
 	 *
 	 * This post-processing step is not time-consuming. Its use is not
-	 * compulsory, but recommended. 
+	 * compulsory, but recommended. For very large scenes, 
+	 * <tt>#AI_CONFIG_PP_VDS_SAMPLES</tt> limits the checks to a sample 
+	 * of all faces, bone weights and animation keys.
 	*/
 	aiProcess_ValidateDataStructure = 0x400,
 
@@ -520,10 +523,28 @@ enum aiPostProcessSteps
 	 *  Use <tt>#AI_CONFIG_PP_DB_ALL_OR_NONE</tt> if you want bones removed if and 
 	 *	only if all bones within the scene qualify for removal.
     */
-	aiProcess_Debone  = 0x4000000
+	aiProcess_Debone  = 0x4000000,
+
+	// -------------------------------------------------------------------------
+	/** <hr>This step removes redundant keys from animation channels.
+	 *
+	 *  Many exporters write a key for each frame, even if the value is 
+	 *  constant or changes linearly over long ranges. This step removes all
+	 *  keys which can be reproduced by interpolating between the remaining
+	 *  keys (linearly for positions and scalings, spherically for rotations)
+	 *  within a given error. Tracks with a constant value are reduced to
+	 *  a single key. The compression ratio of each animation is logged.
+	 *
+	 *  Use <tt>#AI_CONFIG_PP_OA_POSITION_EPSILON</tt>, 
+	 *  <tt>#AI_CONFIG_PP_OA_ROTATION_EPSILON</tt> and
+	 *  <tt>#AI_CONFIG_PP_OA_SCALING_EPSILON</tt> to set the allowed errors.
+	 *  Channels can be resampled to a fixed rate first 
+	 *  (<tt>#AI_CONFIG_PP_OA_SAMPLE_RATE</tt>), rotations can be quantized
+	 *  (<tt>#AI_CONFIG_PP_OA_QUANTIZE_ROTATIONS</tt>).
+	*/
+	aiProcess_OptimizeAnimations  = 0x8000000
 
 	// aiProcess_GenEntityMeshes = 0x100000,
-	// aiProcess_OptimizeAnimations = 0x200000
 	// aiProcess_FixTexturePaths = 0x200000
 };
 
@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "camera.h"
 #include "material.h"
 #include "anim.h"
+#include "metadata.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -102,6 +103,10 @@ struct aiNode
 	/** The meshes of this node. Each entry is an index into the mesh */
 	unsigned int* mMeshes;
 
+	/** Metadata associated with this node or NULL if there is no metadata.
+	  *  Whether any metadata is generated depends on the source file format. */
+	C_STRUCT aiMetadata* mMetaData;
+
 #ifdef __cplusplus
 	/** Constructor */
 	aiNode() 
@@ -110,6 +115,7 @@ struct aiNode
 		mParent = NULL; 
 		mNumChildren = 0; mChildren = NULL;
 		mNumMeshes = 0; mMeshes = NULL;
+		mMetaData = NULL;
 	}
 
 	/** Construction from a specific name */
@@ -119,6 +125,7 @@ struct aiNode
 		mParent = NULL; 
 		mNumChildren = 0; mChildren = NULL;
 		mNumMeshes = 0; mMeshes = NULL;
+		mMetaData = NULL;
 		mName = name;
 	}
 
@@ -134,6 +141,7 @@ struct aiNode
 		}
 		delete [] mChildren;
 		delete [] mMeshes;
+		delete mMetaData;
 	}
 
 	/** Searches for a node with a specific name, beginning at this
@@ -54,6 +54,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Our compile configuration
 #include "defs.h"
 
+// 64 bit integers for memory statistics
+#ifdef _MSC_VER
+	typedef unsigned __int64 ai_uint64;
+#else
+#	include <stdint.h>
+	typedef uint64_t ai_uint64;
+#endif
+
 // Some types moved to separate header due to size of operators
 #include "vector3.h"
 #include "vector2.h"
@@ -485,6 +493,143 @@ struct aiMemoryInfo
 	unsigned int total;
 }; // !struct aiMemoryInfo 
 
+// ----------------------------------------------------------------------------------
+/** Stores the detailed memory requirements of a scene, broken down by the kind
+ *  of data. All sizes are in bytes. Each category includes the structures
+ *  holding the data as well as the pointer arrays referencing them.
+ *  @see Importer::GetMemoryRequirements(const aiScene*,aiSceneMemoryInfo&)
+*/
+struct aiSceneMemoryInfo
+{
+#ifdef __cplusplus
+
+	/** Default constructor */
+	aiSceneMemoryInfo()
+		: meshes        (0)
+		, positions     (0)
+		, normals       (0)
+		, tangents      (0)
+		, colors        (0)
+		, textureCoords (0)
+		, faces         (0)
+		, indices       (0)
+		, bones         (0)
+		, boneWeights   (0)
+		, animMeshes    (0)
+		, animations    (0)
+		, animationKeys (0)
+		, materials     (0)
+		, materialData  (0)
+		, textures      (0)
+		, texels        (0)
+		, nodes         (0)
+		, cameras       (0)
+		, lights        (0)
+		, total         (0)
+	{}
+
+#endif
+
+	/** aiMesh structures */
+	ai_uint64 meshes;
+
+	/** Vertex positions */
+	ai_uint64 positions;
+
+	/** Vertex normals */
+	ai_uint64 normals;
+
+	/** Vertex tangents and bitangents */
+	ai_uint64 tangents;
+
+	/** Vertex colors, all channels */
+	ai_uint64 colors;
+
+	/** Texture coordinates, all channels */
+	ai_uint64 textureCoords;
+
+	/** aiFace structures */
+	ai_uint64 faces;
+
+	/** Face indices */
+	ai_uint64 indices;
+
+	/** aiBone structures */
+	ai_uint64 bones;
+
+	/** Vertex weights of all bones */
+	ai_uint64 boneWeights;
+
+	/** Vertex animation targets (aiAnimMesh), including their vertex data */
+	ai_uint64 animMeshes;
+
+	/** aiAnimation, aiNodeAnim and aiMeshAnim structures */
+	ai_uint64 animations;
+
+	/** Position, rotation, scaling and mesh keys of all animation channels */
+	ai_uint64 animationKeys;
+
+	/** aiMaterial and aiMaterialProperty structures */
+	ai_uint64 materials;
+
+	/** Values of all material properties */
+	ai_uint64 materialData;
+
+	/** aiTexture structures */
+	ai_uint64 textures;
+
+	/** Texel data of embedded textures, compressed or not */
+	ai_uint64 texels;
+
+	/** aiNode structures, including their mesh and child lists */
+	ai_uint64 nodes;
+
+	/** Camera data */
+	ai_uint64 cameras;
+
+	/** Light data */
+	ai_uint64 lights;
+
+	/** Total storage allocated for the scene, including the aiScene itself */
+	ai_uint64 total;
+}; // !struct aiSceneMemoryInfo
+
+// ----------------------------------------------------------------------------------
+/** Memory statistics of a single import or post-processing step. They are
+ *  recorded if #AI_CONFIG_GLOB_MEASURE_MEMORY is set.
+ *  @see Importer::GetStepMemoryInfo()
+*/
+struct aiStepMemoryInfo
+{
+#ifdef __cplusplus
+
+	/** Default constructor */
+	aiStepMemoryInfo()
+		: step      (0)
+		, before    (0)
+		, after     (0)
+		, highWater (0)
+	{}
+
+#endif
+
+	/** The #aiPostProcessSteps flag of the step, 0 for the import itself. 
+	 *  Internal helper steps shared by several post-processing steps
+	 *  carry the flags of all of them. */
+	unsigned int step;
+
+	/** Total size of the scene before and after the step. The difference
+	 *  tells how much the step inflated or reduced the scene. */
+	ai_uint64 before, after;
+
+	/** Largest total size of the scene since it has been imported, up to
+	 *  and including this step */
+	ai_uint64 highWater;
+
+	/** Breakdown of the scene after the step */
+	C_STRUCT aiSceneMemoryInfo detail;
+}; // !struct aiStepMemoryInfo
+
 #ifdef __cplusplus
 }
 #endif //!  __cplusplus
@@ -432,8 +432,19 @@ aiProcess_SplitByBoneCount  = 0x2000000
 #
 aiProcess_Debone  = 0x4000000
 
+## <hr>This step removes redundant keys from animation channels.
+#
+#  All keys which can be reproduced by interpolating between the remaining
+#  keys within a given error are removed, constant tracks are reduced to a
+#  single key. Use <tt>#AI_CONFIG_PP_OA_POSITION_EPSILON<tt>, 
+#  <tt>#AI_CONFIG_PP_OA_ROTATION_EPSILON<tt> and 
+#  <tt>#AI_CONFIG_PP_OA_SCALING_EPSILON<tt> to set the allowed errors,
+#  <tt>#AI_CONFIG_PP_OA_SAMPLE_RATE<tt> to resample the channels first and
+#  <tt>#AI_CONFIG_PP_OA_QUANTIZE_ROTATIONS<tt> to quantize rotations.
+#
+aiProcess_OptimizeAnimations  = 0x8000000
+
 aiProcess_GenEntityMeshes = 0x100000
-aiProcess_OptimizeAnimations = 0x200000
 aiProcess_FixTexturePaths = 0x200000
 
 ## @def aiProcess_ConvertToLeftHanded
@@ -0,0 +1,230 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  Benchmark.h
+ *  @brief Shared declarations of the importer/post-processing/exporter
+ *    benchmark suite.
+ */
+#ifndef AI_BENCHMARK_H_INC
+#define AI_BENCHMARK_H_INC
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "../../include/assimp/Importer.hpp"
+#include "../../include/assimp/Exporter.hpp"
+#include "../../include/assimp/scene.h"
+#include "../../include/assimp/postprocess.h"
+
+namespace Benchmark {
+
+// ------------------------------------------------------------------------------------------------
+// Platform.cpp
+
+/** Returns a monotonic wall clock time stamp, in milliseconds */
+double GetTimeMs();
+
+/** Returns the peak resident set size of the process so far, in bytes
+ *  or 0 if the platform doesn't tell. */
+ai_uint64 GetPeakResidentSetSize();
+
+/** Returns true if the given path names a directory */
+bool IsDirectory(const std::string& path);
+
+/** Recursively collects all regular files below a directory. Hidden
+ *  files and directories (leading dot) are skipped. The output is
+ *  sorted so that consecutive runs process files in the same order. */
+void ListFiles(const std::string& dir, std::vector<std::string>& out);
+
+
+// ------------------------------------------------------------------------------------------------
+// HeapTracker.cpp
+//
+// The benchmark replaces the global operator new/delete to count the heap
+// memory in use. This covers allocations made by the Assimp library unless
+// it is a Windows DLL, which has its own copy of the C++ runtime.
+
+/** Heap memory currently allocated through operator new, in bytes */
+size_t GetHeapInUse();
+
+/** Largest value of #GetHeapInUse since the last #ResetHeapPeak */
+size_t GetHeapPeak();
+
+/** Total number of allocations so far */
+size_t GetHeapAllocations();
+
+/** Sets the heap high-water mark to the amount currently in use */
+void ResetHeapPeak();
+
+
+// ------------------------------------------------------------------------------------------------
+// SyntheticScenes.cpp
+
+/** File extension handled by the importer returned by
+ *  #CreateSyntheticImporter. The contents of such a file is just the
+ *  name of the scene to be generated. */
+extern const char* SYNTHETIC_EXTENSION;
+
+/** Returns the names of all procedurally generated scenes */
+void GetSyntheticSceneNames(std::vector<std::string>& out);
+
+/** Creates a loader which generates synthetic scenes. Pass it to
+ *  Importer::RegisterLoader, the importer takes ownership. */
+Assimp::BaseImporter* CreateSyntheticImporter();
+
+
+// ------------------------------------------------------------------------------------------------
+/** Something which can be imported: either a file or an in-memory buffer
+ *  along with a format hint. */
+struct Input
+{
+	Input() {}
+
+	/** Label used in the report */
+	std::string name;
+
+	/** Path to the file, empty for in-memory inputs */
+	std::string path;
+
+	/** Contents and format hint (file extension) for in-memory inputs */
+	std::vector<char> buffer;
+	std::string hint;
+
+	/** Import the input using the given post-processing flags */
+	const aiScene* Read(Assimp::Importer& imp, unsigned int flags) const {
+		if (!path.empty()) {
+			return imp.ReadFile(path,flags);
+		}
+		return imp.ReadFileFromMemory(&buffer[0],static_cast<unsigned int>(buffer.size()),flags,hint.c_str());
+	}
+
+	/** Extension of the input, used to look up the importer */
+	std::string GetExtension() const {
+		if (path.empty()) {
+			return hint;
+		}
+		const std::string::size_type pos = path.find_last_of('.');
+		return pos == std::string::npos ? std::string() : path.substr(pos+1);
+	}
+};
+
+
+// ------------------------------------------------------------------------------------------------
+/** A single benchmark case. Setup() and Teardown() are called around each
+ *  run and are not measured, Run() is timed and its heap usage tracked. */
+class Case
+{
+public:
+
+	virtual ~Case() {}
+
+	/** Prepare the next run. Return false to skip the case. */
+	virtual bool Setup() {
+		return true;
+	}
+
+	/** Do the work to be measured. Return false on failure. */
+	virtual bool Run() = 0;
+
+	/** Cleanup after a run */
+	virtual void Teardown() {
+	}
+
+	/** Description of the last error */
+	virtual std::string GetError() const {
+		return std::string();
+	}
+
+	/** Size of the data produced by the last run, in bytes, or 0 */
+	virtual ai_uint64 GetOutputSize() const {
+		return 0;
+	}
+};
+
+
+// ------------------------------------------------------------------------------------------------
+/** Measurements taken for a case */
+struct Result
+{
+	Result()
+		: skipped()
+		, failed()
+		, minMs()
+		, medianMs()
+		, meanMs()
+		, maxMs()
+		, heapPeak()
+		, allocations()
+		, outputSize()
+	{}
+
+	/** "import", "postprocess" or "export" */
+	std::string phase;
+
+	/** Importer, post-processing step or export format */
+	std::string name;
+
+	/** Input label */
+	std::string input;
+
+	bool skipped, failed;
+	std::string error;
+
+	/** Timed runs, the statistics below are computed from them */
+	std::vector<double> runs;
+	double minMs, medianMs, meanMs, maxMs;
+
+	/** Largest additional heap memory held during a run */
+	size_t heapPeak;
+
+	/** Fewest allocations made by a run */
+	size_t allocations;
+
+	/** Size of the scene after an import or post-processing step, 
+	 *  or of the exported blobs */
+	ai_uint64 outputSize;
+};
+
+} // end namespace Benchmark
+
+#endif // !! AI_BENCHMARK_H_INC
@@ -0,0 +1,246 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  HeapTracker.cpp
+ *  @brief Replacement of the global operator new/delete to track the heap
+ *    usage of the benchmarked code.
+ *
+ *  Each block is prefixed with a small header holding its size. The
+ *  counters are updated atomically if Assimp is built multithreaded.
+ */
+
+#include "Benchmark.h"
+
+#include <stdlib.h>
+#include <new>
+
+#if !defined(ASSIMP_BUILD_SINGLETHREADED) && defined(_MSC_VER)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#endif
+
+// dynamic exception specifications are gone in C++17
+#if __cplusplus >= 201103L
+#	define AI_BENCH_THROW_BAD_ALLOC
+#	define AI_BENCH_NOTHROW noexcept
+#else
+#	define AI_BENCH_THROW_BAD_ALLOC throw (std::bad_alloc)
+#	define AI_BENCH_NOTHROW throw ()
+#endif
+
+namespace {
+
+// header size, large enough to keep the alignment of the returned blocks
+const size_t HEADER_SIZE = 16;
+
+volatile size_t heapInUse = 0;
+volatile size_t heapPeak = 0;
+volatile size_t heapAllocations = 0;
+
+// ------------------------------------------------------------------------------------------------
+// Add a (two's complement) delta to a counter and return the new value
+inline size_t AtomicAdd(volatile size_t& counter, size_t delta)
+{
+#if defined(ASSIMP_BUILD_SINGLETHREADED)
+	return counter += delta;
+#elif defined(_MSC_VER) && defined(_WIN64)
+	return static_cast<size_t>(::InterlockedExchangeAdd64(reinterpret_cast<volatile LONGLONG*>(&counter),
+		static_cast<LONGLONG>(delta))) + delta;
+#elif defined(_MSC_VER)
+	return static_cast<size_t>(::InterlockedExchangeAdd(reinterpret_cast<volatile LONG*>(&counter),
+		static_cast<LONG>(delta))) + delta;
+#else
+	return __sync_add_and_fetch(&counter,delta);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// Raise the high-water mark to at least the given value
+inline void AtomicMax(volatile size_t& counter, size_t value)
+{
+#if defined(ASSIMP_BUILD_SINGLETHREADED)
+	if (value > counter) {
+		counter = value;
+	}
+#else
+	for (size_t cur = counter; value > cur; cur = counter) {
+#	if defined(_MSC_VER) && defined(_WIN64)
+		if (static_cast<size_t>(::InterlockedCompareExchange64(reinterpret_cast<volatile LONGLONG*>(&counter),
+			static_cast<LONGLONG>(value),static_cast<LONGLONG>(cur))) == cur) {
+			break;
+		}
+#	elif defined(_MSC_VER)
+		if (static_cast<size_t>(::InterlockedCompareExchange(reinterpret_cast<volatile LONG*>(&counter),
+			static_cast<LONG>(value),static_cast<LONG>(cur))) == cur) {
+			break;
+		}
+#	else
+		if (__sync_bool_compare_and_swap(&counter,cur,value)) {
+			break;
+		}
+#	endif
+	}
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void* TrackedAlloc(size_t size)
+{
+	char* p = static_cast<char*>(::malloc(size + HEADER_SIZE));
+	if (!p) {
+		return NULL;
+	}
+	*reinterpret_cast<size_t*>(p) = size;
+
+	AtomicMax(heapPeak,AtomicAdd(heapInUse,size));
+	AtomicAdd(heapAllocations,1);
+	return p + HEADER_SIZE;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void TrackedFree(void* ptr)
+{
+	if (!ptr) {
+		return;
+	}
+	char* p = static_cast<char*>(ptr) - HEADER_SIZE;
+	AtomicAdd(heapInUse,0 - *reinterpret_cast<size_t*>(p));
+	::free(p);
+}
+
+} // end anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+void* operator new (size_t size) AI_BENCH_THROW_BAD_ALLOC
+{
+	void* p = TrackedAlloc(size);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+// ------------------------------------------------------------------------------------------------
+void* operator new[] (size_t size) AI_BENCH_THROW_BAD_ALLOC
+{
+	void* p = TrackedAlloc(size);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+// ------------------------------------------------------------------------------------------------
+void* operator new (size_t size, const std::nothrow_t&) AI_BENCH_NOTHROW
+{
+	return TrackedAlloc(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void* operator new[] (size_t size, const std::nothrow_t&) AI_BENCH_NOTHROW
+{
+	return TrackedAlloc(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete (void* p) AI_BENCH_NOTHROW
+{
+	TrackedFree(p);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete[] (void* p) AI_BENCH_NOTHROW
+{
+	TrackedFree(p);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete (void* p, const std::nothrow_t&) AI_BENCH_NOTHROW
+{
+	TrackedFree(p);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete[] (void* p, const std::nothrow_t&) AI_BENCH_NOTHROW
+{
+	TrackedFree(p);
+}
+
+#ifdef __cpp_sized_deallocation
+// ------------------------------------------------------------------------------------------------
+void operator delete (void* p, size_t) AI_BENCH_NOTHROW
+{
+	TrackedFree(p);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete[] (void* p, size_t) AI_BENCH_NOTHROW
+{
+	TrackedFree(p);
+}
+#endif
+
+namespace Benchmark {
+
+// ------------------------------------------------------------------------------------------------
+size_t GetHeapInUse()
+{
+	return heapInUse;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t GetHeapPeak()
+{
+	return heapPeak;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t GetHeapAllocations()
+{
+	return heapAllocations;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ResetHeapPeak()
+{
+	heapPeak = heapInUse;
+}
+
+} // end namespace Benchmark
@@ -0,0 +1,725 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  Main.cpp
+ *  @brief Benchmark suite for Assimp's importers, post-processing steps
+ *    and exporters.
+ *
+ *  Each importer, post-processing step and exporter is timed separately on
+ *  the test models and on a set of procedurally generated large scenes.
+ *  Every case is repeated after some warmup runs, the heap high-water mark
+ *  of each run is tracked and the results are written as JSON so they can
+ *  be compared between builds.
+ */
+
+#include "Benchmark.h"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <map>
+
+#include "../../include/assimp/config.h"
+#include "../../include/assimp/version.h"
+#include "../../include/assimp/importerdesc.h"
+
+using namespace Benchmark;
+
+#ifndef ASSIMP_BENCHMARK_MODELS
+#	define ASSIMP_BENCHMARK_MODELS "../../test/models"
+#endif
+
+const char* AIBENCH_MSG_HELP =
+"benchmark [options] [files or directories]\n\n"
+" Times Assimp's importers, post-processing steps and exporters.\n"
+" Inputs default to the test models in " ASSIMP_BENCHMARK_MODELS ".\n\n"
+" options:\n"
+" \t-r <n>       Number of timed runs per case (default: 3)\n"
+" \t-w <n>       Number of warmup runs per case (default: 1)\n"
+" \t-o <file>    Write the JSON report to a file instead of stdout\n"
+" \t-p <list>    Comma-separated phases to run: import,postprocess,export\n"
+" \t-s <list>    Comma-separated post-processing steps, i.e. Triangulate\n"
+" \t-f <text>    Only run inputs whose name contains the given text\n"
+" \t-d <n>       Detail of the synthetic scenes, each step quadruples\n"
+" \t             their size (default: 0)\n"
+" \t--no-synthetic  Skip the procedurally generated scenes\n"
+" \t--no-models     Skip the test models\n"
+;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Post-processing steps to be timed. Each step runs on a scene which has
+ *  been imported using the given setup flags, so it finds something to do. */
+struct StepEntry
+{
+	const char* name;
+	unsigned int flag;
+	unsigned int setup;
+};
+
+const StepEntry steps[] = {
+	{"CalcTangentSpace",         aiProcess_CalcTangentSpace,         aiProcess_Triangulate | aiProcess_GenSmoothNormals},
+	{"JoinIdenticalVertices",    aiProcess_JoinIdenticalVertices,    0},
+	{"MakeLeftHanded",           aiProcess_MakeLeftHanded,           0},
+	{"Triangulate",              aiProcess_Triangulate,              0},
+	{"RemoveComponent",          aiProcess_RemoveComponent,          0},
+	{"GenNormals",               aiProcess_GenNormals,               aiProcess_RemoveComponent},
+	{"GenSmoothNormals",         aiProcess_GenSmoothNormals,         aiProcess_RemoveComponent},
+	{"SplitLargeMeshes",         aiProcess_SplitLargeMeshes,         0},
+	{"PreTransformVertices",     aiProcess_PreTransformVertices,     0},
+	{"LimitBoneWeights",         aiProcess_LimitBoneWeights,         0},
+	{"ValidateDataStructure",    aiProcess_ValidateDataStructure,    0},
+	{"ImproveCacheLocality",     aiProcess_ImproveCacheLocality,     aiProcess_Triangulate | aiProcess_JoinIdenticalVertices},
+	{"RemoveRedundantMaterials", aiProcess_RemoveRedundantMaterials, 0},
+	{"FixInfacingNormals",       aiProcess_FixInfacingNormals,       0},
+	{"SortByPType",              aiProcess_SortByPType,              0},
+	{"FindDegenerates",          aiProcess_FindDegenerates,          0},
+	{"FindInvalidData",          aiProcess_FindInvalidData,          0},
+	{"GenUVCoords",              aiProcess_GenUVCoords,              0},
+	{"TransformUVCoords",        aiProcess_TransformUVCoords,        0},
+	{"FindInstances",            aiProcess_FindInstances,            0},
+	{"OptimizeMeshes",           aiProcess_OptimizeMeshes,           0},
+	{"OptimizeGraph",            aiProcess_OptimizeGraph,            0},
+	{"FlipUVs",                  aiProcess_FlipUVs,                  0},
+	{"FlipWindingOrder",         aiProcess_FlipWindingOrder,         0},
+	{"SplitByBoneCount",         aiProcess_SplitByBoneCount,         0},
+	{"Debone",                   aiProcess_Debone,                   0},
+	{"OptimizeAnimations",       aiProcess_OptimizeAnimations,       0}
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Command line settings */
+struct Settings
+{
+	Settings()
+		: repetitions(3)
+		, warmup(1)
+		, detail(0)
+		, synthetic(true)
+		, models(true)
+		, doImport(true)
+		, doPostProcess(true)
+		, doExport(true)
+	{}
+
+	unsigned int repetitions, warmup, detail;
+	bool synthetic, models;
+	bool doImport, doPostProcess, doExport;
+
+	std::string output, filter;
+	std::vector<std::string> paths, steps;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Prepare an importer for the benchmark
+void SetupImporter(Assimp::Importer& imp, const Settings& settings)
+{
+	imp.RegisterLoader(CreateSyntheticImporter());
+	imp.SetPropertyInteger("BENCHMARK_SYNTHETIC_DETAIL",settings.detail);
+
+	// aiProcess_RemoveComponent is used to strip normals before they're regenerated
+	imp.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS,aiComponent_NORMALS);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Import a file, measure the scene size
+class ImportCase : public Case
+{
+public:
+
+	ImportCase(Assimp::Importer& imp, const Input& input)
+		: imp(imp)
+		, input(input)
+	{}
+
+	bool Setup() {
+		imp.FreeScene();
+		return true;
+	}
+
+	bool Run() {
+		return NULL != input.Read(imp,0);
+	}
+
+	void Teardown() {
+		imp.FreeScene();
+	}
+
+	std::string GetError() const {
+		return imp.GetErrorString();
+	}
+
+	ai_uint64 GetOutputSize() const {
+		aiSceneMemoryInfo mem;
+		imp.GetMemoryRequirements(mem);
+		return mem.total;
+	}
+
+private:
+
+	Assimp::Importer& imp;
+	const Input& input;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Run a single post-processing step on a freshly imported scene
+class PostProcessCase : public Case
+{
+public:
+
+	PostProcessCase(Assimp::Importer& imp, const Input& input, const StepEntry& step)
+		: imp(imp)
+		, input(input)
+		, step(step)
+	{}
+
+	bool Setup() {
+		imp.FreeScene();
+		return NULL != input.Read(imp,step.setup);
+	}
+
+	bool Run() {
+		return NULL != imp.ApplyPostProcessing(step.flag);
+	}
+
+	void Teardown() {
+		imp.FreeScene();
+	}
+
+	std::string GetError() const {
+		return imp.GetErrorString();
+	}
+
+	ai_uint64 GetOutputSize() const {
+		aiSceneMemoryInfo mem;
+		imp.GetMemoryRequirements(mem);
+		return mem.total;
+	}
+
+private:
+
+	Assimp::Importer& imp;
+	const Input& input;
+	const StepEntry& step;
+};
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+// ------------------------------------------------------------------------------------------------
+// Export a scene to memory
+class ExportCase : public Case
+{
+public:
+
+	ExportCase(Assimp::Exporter& exp, const aiScene* scene, const char* format)
+		: exp(exp)
+		, scene(scene)
+		, format(format)
+	{}
+
+	bool Run() {
+		return NULL != exp.ExportToBlob(scene,format);
+	}
+
+	void Teardown() {
+		exp.FreeBlob();
+	}
+
+	std::string GetError() const {
+		return exp.GetErrorString();
+	}
+
+	ai_uint64 GetOutputSize() const {
+		ai_uint64 size = 0;
+		for (const aiExportDataBlob* blob = exp.GetBlob(); blob; blob = blob->next) {
+			size += blob->size;
+		}
+		return size;
+	}
+
+private:
+
+	Assimp::Exporter& exp;
+	const aiScene* scene;
+	const char* format;
+};
+#endif
+
+// ------------------------------------------------------------------------------------------------
+// Run a case repeatedly and collect its timings and memory statistics
+Result Measure(Case& c, const Settings& settings, const char* phase, const std::string& name, const std::string& input)
+{
+	Result res;
+	res.phase = phase;
+	res.name = name;
+	res.input = input;
+
+	for (unsigned int i = 0; i < settings.warmup + settings.repetitions; ++i) {
+		if (!c.Setup()) {
+			// the input can't be prepared for this case, nothing to measure
+			res.skipped = true;
+			res.error = c.GetError();
+			c.Teardown();
+			break;
+		}
+
+		const size_t heapBase = GetHeapInUse(), allocBase = GetHeapAllocations();
+		ResetHeapPeak();
+
+		bool ok = false;
+		const double start = GetTimeMs();
+		try {
+			ok = c.Run();
+		}
+		catch (const std::exception& e) {
+			res.error = e.what();
+		}
+		const double ms = GetTimeMs() - start;
+
+		const size_t heapPeak = GetHeapPeak() - heapBase, allocs = GetHeapAllocations() - allocBase;
+		if (ok) {
+			res.outputSize = c.GetOutputSize();
+		}
+		else if (res.error.empty()) {
+			res.error = c.GetError();
+		}
+		c.Teardown();
+
+		if (!ok) {
+			res.failed = true;
+			break;
+		}
+		if (i < settings.warmup) {
+			continue;
+		}
+
+		res.runs.push_back(ms);
+		res.heapPeak = std::max(res.heapPeak,heapPeak);
+		res.allocations = res.runs.size() == 1 ? allocs : std::min(res.allocations,allocs);
+	}
+
+	if (!res.runs.empty()) {
+		std::vector<double> sorted = res.runs;
+		std::sort(sorted.begin(),sorted.end());
+
+		const size_t n = sorted.size();
+		res.minMs = sorted.front();
+		res.maxMs = sorted.back();
+		res.medianMs = n % 2 ? sorted[n/2] : (sorted[n/2-1] + sorted[n/2]) * 0.5;
+		for (size_t i = 0; i < n; ++i) {
+			res.meanMs += sorted[i];
+		}
+		res.meanMs /= n;
+	}
+
+	fprintf(stderr,"[%s] %-28s %-40s %s\n",phase,name.c_str(),input.c_str(),
+		res.skipped ? "skipped" : (res.failed ? "FAILED" : "ok"));
+	return res;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the name of the importer handling a particular input
+std::string GetImporterName(const Assimp::Importer& imp, const Input& input)
+{
+	const size_t idx = imp.GetImporterIndex(input.GetExtension().c_str());
+	const aiImporterDesc* desc = idx == static_cast<size_t>(-1) ? NULL : imp.GetImporterInfo(idx);
+	if (!desc) {
+		return input.GetExtension();
+	}
+
+	// some descriptions continue with an URL on the next line
+	std::string name = desc->mName;
+	name = name.substr(0,name.find_first_of("\r\n"));
+	return name.substr(0,name.find_last_not_of(' ') + 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collect the inputs to be benchmarked. Only inputs which can be imported
+// are returned, so the post-processing and export phases have something to
+// work on. Import failures are still reported by the import phase.
+void CollectInputs(const Settings& settings, std::vector<Input>& inputs, std::vector<Input>& broken)
+{
+	Assimp::Importer imp;
+	SetupImporter(imp,settings);
+
+	if (settings.synthetic) {
+		std::vector<std::string> names;
+		GetSyntheticSceneNames(names);
+
+		for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it) {
+			Input in;
+			in.name = "synthetic/" + *it;
+			in.buffer.assign((*it).begin(),(*it).end());
+			in.hint = SYNTHETIC_EXTENSION;
+			inputs.push_back(in);
+		}
+	}
+
+	if (settings.models) {
+		std::vector<std::string> paths = settings.paths;
+		if (paths.empty()) {
+			paths.push_back(ASSIMP_BENCHMARK_MODELS);
+		}
+
+		for (std::vector<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++it) {
+			std::vector<std::string> files;
+			size_t prefix = 0;
+			if (IsDirectory(*it)) {
+				ListFiles(*it,files);
+				prefix = (*it).length() + 1;
+			}
+			else files.push_back(*it);
+
+			for (std::vector<std::string>::const_iterator fit = files.begin(); fit != files.end(); ++fit) {
+				Input in;
+				in.path = *fit;
+				in.name = (*fit).substr(prefix);
+
+				if (imp.GetImporterIndex(in.GetExtension().c_str()) == static_cast<size_t>(-1)) {
+					continue;
+				}
+				inputs.push_back(in);
+			}
+		}
+	}
+
+	std::vector<Input> loadable;
+	for (std::vector<Input>::const_iterator it = inputs.begin(); it != inputs.end(); ++it) {
+		if (!settings.filter.empty() && (*it).name.find(settings.filter) == std::string::npos) {
+			continue;
+		}
+		((*it).Read(imp,0) ? loadable : broken).push_back(*it);
+		imp.FreeScene();
+	}
+	inputs.swap(loadable);
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunImports(const Settings& settings, const std::vector<Input>& inputs, const std::vector<Input>& broken,
+	std::vector<Result>& results)
+{
+	Assimp::Importer imp;
+	SetupImporter(imp,settings);
+
+	std::vector<Input> all;
+	for (std::vector<Input>::const_iterator it = inputs.begin(); it != inputs.end(); ++it) {
+		if ((*it).hint != SYNTHETIC_EXTENSION) {
+			all.push_back(*it);
+			continue;
+		}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+		// synthetic scenes are imported from each format we can write and read
+		if (!(*it).Read(imp,0)) {
+			continue;
+		}
+		Assimp::Exporter exp;
+		for (size_t i = 0; i < exp.GetExportFormatCount(); ++i) {
+			const aiExportFormatDesc* desc = exp.GetExportFormatDescription(i);
+			if (imp.GetImporterIndex(desc->fileExtension) == static_cast<size_t>(-1)) {
+				continue;
+			}
+
+			const aiExportDataBlob* blob = exp.ExportToBlob(imp.GetScene(),desc->id);
+			if (!blob) {
+				continue;
+			}
+
+			Input in;
+			in.name = (*it).name + "." + desc->id;
+			in.buffer.assign(static_cast<const char*>(blob->data),static_cast<const char*>(blob->data) + blob->size);
+			in.hint = desc->fileExtension;
+			all.push_back(in);
+		}
+		imp.FreeScene();
+#endif
+	}
+	all.insert(all.end(),broken.begin(),broken.end());
+
+	for (std::vector<Input>::const_iterator it = all.begin(); it != all.end(); ++it) {
+		ImportCase c(imp,*it);
+		results.push_back(Measure(c,settings,"import",GetImporterName(imp,*it),(*it).name));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunPostProcessing(const Settings& settings, const std::vector<Input>& inputs, std::vector<Result>& results)
+{
+	Assimp::Importer imp;
+	SetupImporter(imp,settings);
+
+	for (size_t s = 0; s < sizeof(steps)/sizeof(steps[0]); ++s) {
+		if (!settings.steps.empty() && std::find(settings.steps.begin(),settings.steps.end(),steps[s].name) == settings.steps.end()) {
+			continue;
+		}
+		for (std::vector<Input>::const_iterator it = inputs.begin(); it != inputs.end(); ++it) {
+			PostProcessCase c(imp,*it,steps[s]);
+			results.push_back(Measure(c,settings,"postprocess",steps[s].name,(*it).name));
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void RunExports(const Settings& settings, const std::vector<Input>& inputs, std::vector<Result>& results)
+{
+#ifndef ASSIMP_BUILD_NO_EXPORT
+	Assimp::Importer imp;
+	SetupImporter(imp,settings);
+	Assimp::Exporter exp;
+
+	for (std::vector<Input>::const_iterator it = inputs.begin(); it != inputs.end(); ++it) {
+		const aiScene* scene = (*it).Read(imp,0);
+		if (!scene) {
+			continue;
+		}
+		for (size_t i = 0; i < exp.GetExportFormatCount(); ++i) {
+			const aiExportFormatDesc* desc = exp.GetExportFormatDescription(i);
+
+			ExportCase c(exp,scene,desc->id);
+			results.push_back(Measure(c,settings,"export",desc->id,(*it).name));
+		}
+	}
+#else
+	(void)settings; (void)inputs; (void)results;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Totals for an importer, post-processing step or exporter */
+struct Summary
+{
+	Summary()
+		: cases()
+		, failed()
+		, totalMedianMs()
+		, heapPeak()
+	{}
+
+	unsigned int cases, failed;
+	double totalMedianMs;
+	size_t heapPeak;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Write a string as quoted JSON string literal
+void WriteString(FILE* out, const std::string& s)
+{
+	fputc('\"',out);
+	for (std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+		const unsigned char c = static_cast<unsigned char>(*it);
+		if (c == '\"' || c == '\\') {
+			fprintf(out,"\\%c",c);
+		}
+		else if (c < 0x20) {
+			fprintf(out,"\\u%04x",c);
+		}
+		else fputc(c,out);
+	}
+	fputc('\"',out);
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteReport(FILE* out, const Settings& settings, const std::vector<Result>& results)
+{
+	const unsigned int flags = aiGetCompileFlags();
+	fprintf(out,"{\n  \"version\": \"%u.%u.%u\",\n",aiGetVersionMajor(),aiGetVersionMinor(),aiGetVersionRevision());
+	fprintf(out,"  \"debug\": %s,\n  \"multithreaded\": %s,\n",
+		flags & ASSIMP_CFLAGS_DEBUG ? "true" : "false",
+		flags & ASSIMP_CFLAGS_SINGLETHREADED ? "false" : "true");
+	fprintf(out,"  \"repetitions\": %u,\n  \"warmup\": %u,\n  \"synthetic_detail\": %u,\n",
+		settings.repetitions,settings.warmup,settings.detail);
+
+	// per-case measurements
+	fprintf(out,"  \"cases\": [");
+	for (std::vector<Result>::const_iterator it = results.begin(); it != results.end(); ++it) {
+		const Result& r = *it;
+		fprintf(out,"%s\n    {\"phase\": ",it == results.begin() ? "" : ",");
+		WriteString(out,r.phase);
+		fprintf(out,", \"name\": ");
+		WriteString(out,r.name);
+		fprintf(out,", \"input\": ");
+		WriteString(out,r.input);
+		fprintf(out,", \"status\": \"%s\"",r.skipped ? "skipped" : (r.failed ? "failed" : "ok"));
+
+		if (!r.error.empty()) {
+			fprintf(out,", \"error\": ");
+			WriteString(out,r.error);
+		}
+		if (!r.runs.empty()) {
+			fprintf(out,",\n     \"runs_ms\": [");
+			for (size_t i = 0; i < r.runs.size(); ++i) {
+				fprintf(out,"%s%.4f",i ? ", " : "",r.runs[i]);
+			}
+			fprintf(out,"], \"min_ms\": %.4f, \"median_ms\": %.4f, \"mean_ms\": %.4f, \"max_ms\": %.4f,\n",
+				r.minMs,r.medianMs,r.meanMs,r.maxMs);
+			fprintf(out,"     \"heap_peak_bytes\": %.0f, \"allocations\": %.0f, \"output_bytes\": %.0f",
+				static_cast<double>(r.heapPeak),static_cast<double>(r.allocations),static_cast<double>(r.outputSize));
+		}
+		fprintf(out,"}");
+	}
+	fprintf(out,"\n  ],\n");
+
+	// totals per importer, step and exporter
+	typedef std::map<std::pair<std::string,std::string>,Summary> SummaryMap;
+	SummaryMap summary;
+	for (std::vector<Result>::const_iterator it = results.begin(); it != results.end(); ++it) {
+		Summary& s = summary[std::make_pair((*it).phase,(*it).name)];
+		++s.cases;
+		s.failed += (*it).failed ? 1 : 0;
+		s.totalMedianMs += (*it).medianMs;
+		s.heapPeak = std::max(s.heapPeak,(*it).heapPeak);
+	}
+
+	fprintf(out,"  \"summary\": [");
+	for (SummaryMap::const_iterator it = summary.begin(); it != summary.end(); ++it) {
+		const Summary& s = (*it).second;
+		fprintf(out,"%s\n    {\"phase\": ",it == summary.begin() ? "" : ",");
+		WriteString(out,(*it).first.first);
+		fprintf(out,", \"name\": ");
+		WriteString(out,(*it).first.second);
+		fprintf(out,", \"cases\": %u, \"failed\": %u, \"total_median_ms\": %.4f, \"heap_peak_bytes\": %.0f}",
+			s.cases,s.failed,s.totalMedianMs,static_cast<double>(s.heapPeak));
+	}
+	fprintf(out,"\n  ],\n");
+
+	fprintf(out,"  \"peak_rss_bytes\": %.0f\n}\n",static_cast<double>(GetPeakResidentSetSize()));
+}
+
+// ------------------------------------------------------------------------------------------------
+void SplitList(const char* list, std::vector<std::string>& out)
+{
+	std::string cur;
+	for (; ; ++list) {
+		if (!*list || *list == ',') {
+			if (!cur.empty()) {
+				out.push_back(cur);
+			}
+			cur.clear();
+			if (!*list) {
+				break;
+			}
+		}
+		else cur += *list;
+	}
+}
+
+} // end anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+// Application entry point
+int main (int argc, char* argv[])
+{
+	Settings settings;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+
+		if (arg == "-h" || arg == "--help") {
+			printf("%s",AIBENCH_MSG_HELP);
+			return 0;
+		}
+		else if (arg == "--no-synthetic") {
+			settings.synthetic = false;
+		}
+		else if (arg == "--no-models") {
+			settings.models = false;
+		}
+		else if (arg == "-r" && hasValue) {
+			settings.repetitions = std::max(1,atoi(argv[++i]));
+		}
+		else if (arg == "-w" && hasValue) {
+			settings.warmup = std::max(0,atoi(argv[++i]));
+		}
+		else if (arg == "-d" && hasValue) {
+			settings.detail = std::max(0,atoi(argv[++i]));
+		}
+		else if (arg == "-o" && hasValue) {
+			settings.output = argv[++i];
+		}
+		else if (arg == "-f" && hasValue) {
+			settings.filter = argv[++i];
+		}
+		else if (arg == "-s" && hasValue) {
+			SplitList(argv[++i],settings.steps);
+		}
+		else if (arg == "-p" && hasValue) {
+			std::vector<std::string> phases;
+			SplitList(argv[++i],phases);
+
+			settings.doImport = std::find(phases.begin(),phases.end(),"import") != phases.end();
+			settings.doPostProcess = std::find(phases.begin(),phases.end(),"postprocess") != phases.end();
+			settings.doExport = std::find(phases.begin(),phases.end(),"export") != phases.end();
+		}
+		else if (arg[0] == '-') {
+			fprintf(stderr,"benchmark: unknown or incomplete option %s, use --help for a list\n",arg.c_str());
+			return 1;
+		}
+		else settings.paths.push_back(arg);
+	}
+
+	std::vector<Input> inputs, broken;
+	CollectInputs(settings,inputs,broken);
+	if (inputs.empty() && broken.empty()) {
+		fprintf(stderr,"benchmark: no inputs found\n");
+		return 1;
+	}
+
+	std::vector<Result> results;
+	if (settings.doImport) {
+		RunImports(settings,inputs,broken,results);
+	}
+	if (settings.doPostProcess) {
+		RunPostProcessing(settings,inputs,results);
+	}
+	if (settings.doExport) {
+		RunExports(settings,inputs,results);
+	}
+
+	FILE* out = stdout;
+	if (!settings.output.empty() && !(out = fopen(settings.output.c_str(),"wt"))) {
+		fprintf(stderr,"benchmark: failed to open %s for writing\n",settings.output.c_str());
+		return 1;
+	}
+	WriteReport(out,settings,results);
+	if (out != stdout) {
+		fclose(out);
+	}
+
+	return 0;
+}
@@ -0,0 +1,170 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  Platform.cpp
+ *  @brief Timer, memory statistics and directory traversal for the
+ *    benchmark suite.
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#	include <psapi.h>
+#else
+#	include <sys/types.h>
+#	include <sys/stat.h>
+#	include <sys/time.h>
+#	include <sys/resource.h>
+#	include <dirent.h>
+#	include <time.h>
+#endif
+
+namespace Benchmark {
+
+// ------------------------------------------------------------------------------------------------
+double GetTimeMs()
+{
+#if defined(_WIN32)
+	static LARGE_INTEGER freq = {0};
+	if (!freq.QuadPart) {
+		::QueryPerformanceFrequency(&freq);
+	}
+	LARGE_INTEGER now;
+	::QueryPerformanceCounter(&now);
+	return now.QuadPart * 1000.0 / freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+	timespec now;
+	::clock_gettime(CLOCK_MONOTONIC,&now);
+	return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+#else
+	timeval now;
+	::gettimeofday(&now,NULL);
+	return now.tv_sec * 1000.0 + now.tv_usec / 1000.0;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+ai_uint64 GetPeakResidentSetSize()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (::GetProcessMemoryInfo(::GetCurrentProcess(),&counters,sizeof counters)) {
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	rusage usage;
+	if (::getrusage(RUSAGE_SELF,&usage)) {
+		return 0;
+	}
+#	ifdef __APPLE__
+	// bytes on OS X, kilobytes everywhere else
+	return static_cast<ai_uint64>(usage.ru_maxrss);
+#	else
+	return static_cast<ai_uint64>(usage.ru_maxrss) * 1024;
+#	endif
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+bool IsDirectory(const std::string& path)
+{
+#ifdef _WIN32
+	const DWORD attr = ::GetFileAttributesA(path.c_str());
+	return attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY);
+#else
+	struct stat st;
+	return !::stat(path.c_str(),&st) && S_ISDIR(st.st_mode);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+static void ListFilesRecursive(const std::string& dir, std::vector<std::string>& out)
+{
+#ifdef _WIN32
+	WIN32_FIND_DATAA data;
+	HANDLE h = ::FindFirstFileA((dir + "\\*").c_str(),&data);
+	if (h == INVALID_HANDLE_VALUE) {
+		return;
+	}
+	do {
+		if (data.cFileName[0] == '.') {
+			continue;
+		}
+		const std::string path = dir + "/" + data.cFileName;
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			ListFilesRecursive(path,out);
+		}
+		else out.push_back(path);
+	}
+	while (::FindNextFileA(h,&data));
+	::FindClose(h);
+#else
+	DIR* d = ::opendir(dir.c_str());
+	if (!d) {
+		return;
+	}
+	while (dirent* ent = ::readdir(d)) {
+		if (ent->d_name[0] == '.') {
+			continue;
+		}
+		const std::string path = dir + "/" + ent->d_name;
+		if (IsDirectory(path)) {
+			ListFilesRecursive(path,out);
+		}
+		else out.push_back(path);
+	}
+	::closedir(d);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void ListFiles(const std::string& dir, std::vector<std::string>& out)
+{
+	const size_t first = out.size();
+	ListFilesRecursive(dir,out);
+	std::sort(out.begin()+first,out.end());
+}
+
+} // end namespace Benchmark
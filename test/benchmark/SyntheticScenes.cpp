@@ -0,0 +1,355 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SyntheticScenes.cpp
+ *  @brief Procedurally generated test scenes for the benchmark suite.
+ *
+ *  The scenes are produced by a regular importer plugin so that they
+ *  travel through the same pipeline as any file loaded from disk and can
+ *  be post-processed and exported using the public API.
+ */
+
+#include "Benchmark.h"
+
+#include <math.h>
+#include <algorithm>
+#include <set>
+
+#include <boost/scoped_ptr.hpp>
+
+#include "BaseImporter.h"
+#include "StandardShapes.h"
+#include "Subdivision.h"
+#include "../../include/assimp/IOSystem.hpp"
+#include "../../include/assimp/IOStream.hpp"
+#include "../../include/assimp/importerdesc.h"
+
+using namespace Assimp;
+
+namespace Benchmark {
+
+/*extern*/ const char* SYNTHETIC_EXTENSION = "synthetic";
+
+namespace {
+
+const aiImporterDesc desc = {
+	"Synthetic scene generator (benchmark)",
+	"",
+	"",
+	"",
+	aiImporterFlags_SupportTextFlavour,
+	0,
+	0,
+	0,
+	0,
+	"synthetic"
+};
+
+// ------------------------------------------------------------------------------------------------
+// Build a node referencing a single mesh
+aiNode* MakeMeshNode(const char* name, unsigned int mesh, aiNode* parent)
+{
+	aiNode* nd = new aiNode();
+	nd->mName.Set(name);
+	nd->mParent = parent;
+	nd->mMeshes = new unsigned int[nd->mNumMeshes = 1];
+	nd->mMeshes[0] = mesh;
+	return nd;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Assign normals and spherical texture coordinates to a mesh centered at the origin
+void AddSphericalAttributes(aiMesh* mesh)
+{
+	const float pi = 3.14159265358979f;
+
+	mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+	mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+	mesh->mNumUVComponents[0] = 2;
+
+	for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+		const aiVector3D n = aiVector3D(mesh->mVertices[i]).Normalize();
+		mesh->mNormals[i] = n;
+		mesh->mTextureCoords[0][i] = aiVector3D(0.5f + atan2(n.z,n.x) / (2.f*pi),0.5f + asin(n.y) / pi,0.f);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Allocate a given number of materials with distinct diffuse colors
+void MakeMaterials(aiScene* pScene, unsigned int num)
+{
+	pScene->mMaterials = new aiMaterial*[pScene->mNumMaterials = num];
+	for (unsigned int i = 0; i < num; ++i) {
+		aiMaterial* mat = pScene->mMaterials[i] = new aiMaterial();
+
+		aiString name;
+		name.length = ::sprintf(name.data,"material_%u",i);
+		mat->AddProperty(&name,AI_MATKEY_NAME);
+
+		const aiColor3D diffuse(static_cast<float>(i+1)/num,0.5f,1.f-static_cast<float>(i)/num);
+		mat->AddProperty(&diffuse,1,AI_MATKEY_COLOR_DIFFUSE);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// A finely tesselated sphere with normals and texture coordinates
+void MakeSphere(aiScene* pScene, unsigned int detail)
+{
+	aiMesh* mesh = StandardShapes::MakeMesh(6 + detail,&StandardShapes::MakeSphere);
+	AddSphericalAttributes(mesh);
+
+	pScene->mMeshes = new aiMesh*[pScene->mNumMeshes = 1];
+	pScene->mMeshes[0] = mesh;
+
+	MakeMaterials(pScene,1);
+	pScene->mRootNode = MakeMeshNode("sphere",0,NULL);
+}
+
+// ------------------------------------------------------------------------------------------------
+// A cube made of quads, smoothed using Catmull-Clark subdivision
+void MakeSubdividedCube(aiScene* pScene, unsigned int detail)
+{
+	aiMesh* cube = StandardShapes::MakeMesh(&StandardShapes::MakeHexahedron);
+
+	aiMesh* mesh = NULL;
+	boost::scoped_ptr<Subdivider> subd(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+	subd->Subdivide(cube,mesh,7 + detail,true);
+
+	pScene->mMeshes = new aiMesh*[pScene->mNumMeshes = 1];
+	pScene->mMeshes[0] = mesh;
+
+	MakeMaterials(pScene,1);
+	pScene->mRootNode = MakeMeshNode("cube",0,NULL);
+}
+
+// ------------------------------------------------------------------------------------------------
+// A deep node hierarchy referencing a few small meshes many times, as
+// produced by architectural or CAD formats
+void MakeConeGrid(aiScene* pScene, unsigned int detail)
+{
+	const unsigned int numMeshes = 16, numRows = 32 << detail, numCols = 32;
+
+	pScene->mMeshes = new aiMesh*[pScene->mNumMeshes = numMeshes];
+	for (unsigned int i = 0; i < numMeshes; ++i) {
+		std::vector<aiVector3D> positions;
+		StandardShapes::MakeCone(1.f + i * 0.1f,0.5f,0.1f * (i % 4),8 + i * 4,positions);
+
+		aiMesh* mesh = pScene->mMeshes[i] = StandardShapes::MakeMesh(positions,3);
+		mesh->mMaterialIndex = i % 8;
+	}
+	MakeMaterials(pScene,8);
+
+	aiNode* root = pScene->mRootNode = new aiNode();
+	root->mName.Set("grid");
+	root->mChildren = new aiNode*[root->mNumChildren = numRows];
+
+	char name[64];
+	for (unsigned int r = 0; r < numRows; ++r) {
+		aiNode* row = root->mChildren[r] = new aiNode();
+		::sprintf(name,"row_%u",r);
+		row->mName.Set(name);
+		row->mParent = root;
+		aiMatrix4x4::Translation(aiVector3D(0.f,0.f,r * 2.f),row->mTransformation);
+
+		row->mChildren = new aiNode*[row->mNumChildren = numCols];
+		for (unsigned int c = 0; c < numCols; ++c) {
+			::sprintf(name,"cone_%u_%u",r,c);
+			aiNode* nd = row->mChildren[c] = MakeMeshNode(name,(r * 7 + c) % numMeshes,row);
+
+			aiMatrix4x4 rot;
+			aiMatrix4x4::RotationY(c * 0.1f,rot);
+			aiMatrix4x4::Translation(aiVector3D(c * 2.f,0.f,0.f),nd->mTransformation);
+			nd->mTransformation *= rot;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// A sphere skinned to many bones with more influences per vertex than most
+// engines support, to give the bone weight steps something to do
+void MakeSkinnedSphere(aiScene* pScene, unsigned int detail)
+{
+	const unsigned int numBones = 64, numInfluences = 6;
+
+	aiMesh* mesh = StandardShapes::MakeMesh(5 + detail,&StandardShapes::MakeSphere);
+	AddSphericalAttributes(mesh);
+
+	// distribute the bones evenly over the sphere (golden spiral)
+	std::vector<aiVector3D> centers(numBones);
+	for (unsigned int b = 0; b < numBones; ++b) {
+		const float y = 1.f - (b + 0.5f) * 2.f / numBones, r = sqrt(1.f - y*y), phi = b * 2.39996323f;
+		centers[b] = aiVector3D(r * cos(phi),y,r * sin(phi));
+	}
+
+	// weight each vertex by its nearest bones
+	std::vector< std::vector<aiVertexWeight> > weights(numBones);
+	std::vector< std::pair<float,unsigned int> > nearest(numBones);
+	for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+		for (unsigned int b = 0; b < numBones; ++b) {
+			nearest[b] = std::make_pair((mesh->mNormals[i] - centers[b]).SquareLength(),b);
+		}
+		std::partial_sort(nearest.begin(),nearest.begin() + numInfluences,nearest.end());
+
+		float sum = 0.f;
+		for (unsigned int n = 0; n < numInfluences; ++n) {
+			sum += 1.f / (1.f + nearest[n].first);
+		}
+		for (unsigned int n = 0; n < numInfluences; ++n) {
+			weights[nearest[n].second].push_back(aiVertexWeight(i,1.f / (1.f + nearest[n].first) / sum));
+		}
+	}
+
+	aiNode* root = pScene->mRootNode = MakeMeshNode("skinned_sphere",0,NULL);
+	aiNode* armature = new aiNode();
+	armature->mName.Set("armature");
+	armature->mParent = root;
+	root->mChildren = new aiNode*[root->mNumChildren = 1];
+	root->mChildren[0] = armature;
+	armature->mChildren = new aiNode*[armature->mNumChildren = numBones];
+
+	mesh->mBones = new aiBone*[mesh->mNumBones = numBones];
+	for (unsigned int b = 0; b < numBones; ++b) {
+		aiBone* bone = mesh->mBones[b] = new aiBone();
+		bone->mName.length = ::sprintf(bone->mName.data,"bone_%u",b);
+		aiMatrix4x4::Translation(-centers[b],bone->mOffsetMatrix);
+
+		bone->mWeights = new aiVertexWeight[bone->mNumWeights = static_cast<unsigned int>(weights[b].size())];
+		std::copy(weights[b].begin(),weights[b].end(),bone->mWeights);
+
+		aiNode* nd = armature->mChildren[b] = new aiNode();
+		nd->mName = bone->mName;
+		nd->mParent = armature;
+		aiMatrix4x4::Translation(centers[b],nd->mTransformation);
+	}
+
+	pScene->mMeshes = new aiMesh*[pScene->mNumMeshes = 1];
+	pScene->mMeshes[0] = mesh;
+	MakeMaterials(pScene,1);
+}
+
+// ------------------------------------------------------------------------------------------------
+struct SceneEntry
+{
+	const char* name;
+	void (*generate)(aiScene*, unsigned int);
+};
+
+const SceneEntry scenes[] = {
+	{"sphere",          &MakeSphere},
+	{"subdivided_cube", &MakeSubdividedCube},
+	{"cone_grid",       &MakeConeGrid},
+	{"skinned_sphere",  &MakeSkinnedSphere}
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Loader for files with the #SYNTHETIC_EXTENSION extension. The file
+ *  contains the name of the scene to be generated. The level of detail
+ *  is taken from the BENCHMARK_SYNTHETIC_DETAIL property. */
+class SyntheticImporter : public BaseImporter
+{
+public:
+
+	SyntheticImporter()
+		: detail()
+	{}
+
+public:
+
+	// -------------------------------------------------------------------
+	bool CanRead(const std::string& pFile, IOSystem* /*pIOHandler*/, bool /*checkSig*/) const {
+		return SimpleExtensionCheck(pFile,SYNTHETIC_EXTENSION);
+	}
+
+	// -------------------------------------------------------------------
+	const aiImporterDesc* GetInfo() const {
+		return &desc;
+	}
+
+	// -------------------------------------------------------------------
+	void SetupProperties(const Importer* pImp) {
+		detail = static_cast<unsigned int>(std::max(0,pImp->GetPropertyInteger("BENCHMARK_SYNTHETIC_DETAIL",0)));
+	}
+
+protected:
+
+	// -------------------------------------------------------------------
+	void InternReadFile(const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler) {
+		boost::scoped_ptr<IOStream> file(pIOHandler->Open(pFile,"rb"));
+		if (!file) {
+			throw DeadlyImportError("Failed to open " + pFile);
+		}
+
+		std::string name(file->FileSize(),'\0');
+		if (!name.empty()) {
+			file->Read(&name[0],1,name.size());
+		}
+		name = name.substr(0,name.find_first_of("\r\n"));
+
+		for (size_t i = 0; i < sizeof(scenes)/sizeof(scenes[0]); ++i) {
+			if (name == scenes[i].name) {
+				scenes[i].generate(pScene,detail);
+				return;
+			}
+		}
+		throw DeadlyImportError("Unknown synthetic scene: " + name);
+	}
+
+private:
+
+	unsigned int detail;
+};
+
+} // end anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+void GetSyntheticSceneNames(std::vector<std::string>& out)
+{
+	for (size_t i = 0; i < sizeof(scenes)/sizeof(scenes[0]); ++i) {
+		out.push_back(scenes[i].name);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+BaseImporter* CreateSyntheticImporter()
+{
+	return new SyntheticImporter();
+}
+
+} // end namespace Benchmark
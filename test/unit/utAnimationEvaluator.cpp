@@ -0,0 +1,250 @@
+
+#include "UnitTestPCH.h"
+#include "utAnimationEvaluator.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (AnimationEvaluatorTest);
+
+// builds a transformation matrix from its components
+static aiMatrix4x4 compose(const aiVector3D& scaling, const aiQuaternion& rotation, const aiVector3D& position)
+{
+	aiMatrix4x4 mat = aiMatrix4x4(rotation.GetMatrix()), scale;
+	aiMatrix4x4::Scaling(scaling,scale);
+	mat = mat * scale;
+	mat.a4 = position.x; mat.b4 = position.y; mat.c4 = position.z;
+	return mat;
+}
+
+void AnimationEvaluatorTest :: setUp (void)
+{
+	// root -> arm -> hand, the arm is animated and the hand
+	// is the only bone of the mesh attached to the root
+	scene = new aiScene();
+	scene->mRootNode = new aiNode("root");
+	scene->mRootNode->mTransformation = compose(aiVector3D(1.f,1.f,1.f),aiQuaternion(1.f,0.f,0.f,0.f),aiVector3D(0.f,5.f,0.f));
+	scene->mRootNode->mNumMeshes = 1;
+	scene->mRootNode->mMeshes = new unsigned int[1];
+	scene->mRootNode->mMeshes[0] = 0;
+
+	aiNode* arm = new aiNode("arm");
+	arm->mTransformation = compose(aiVector3D(1.f,1.f,1.f),aiQuaternion(1.f,0.f,0.f,0.f),aiVector3D(3.f,0.f,0.f));
+	arm->mParent = scene->mRootNode;
+	scene->mRootNode->mNumChildren = 1;
+	scene->mRootNode->mChildren = new aiNode*[1];
+	scene->mRootNode->mChildren[0] = arm;
+
+	aiNode* hand = new aiNode("hand");
+	hand->mTransformation = compose(aiVector3D(1.f,1.f,1.f),aiQuaternion(1.f,0.f,0.f,0.f),aiVector3D(1.f,0.f,0.f));
+	hand->mParent = arm;
+	arm->mNumChildren = 1;
+	arm->mChildren = new aiNode*[1];
+	arm->mChildren[0] = hand;
+
+	scene->mNumMeshes = 1;
+	scene->mMeshes = new aiMesh*[1];
+	aiMesh* mesh = scene->mMeshes[0] = new aiMesh();
+	mesh->mNumBones = 1;
+	mesh->mBones = new aiBone*[1];
+	mesh->mBones[0] = new aiBone();
+	mesh->mBones[0]->mName.Set("hand");
+	mesh->mBones[0]->mOffsetMatrix = compose(aiVector3D(1.f,1.f,1.f),aiQuaternion(1.f,0.f,0.f,0.f),aiVector3D(-4.f,0.f,0.f));
+
+	scene->mNumAnimations = 1;
+	scene->mAnimations = new aiAnimation*[1];
+	aiAnimation* anim = scene->mAnimations[0] = new aiAnimation();
+	anim->mDuration = 10.;
+	anim->mTicksPerSecond = 2.;
+	anim->mNumChannels = 1;
+	anim->mChannels = new aiNodeAnim*[1];
+	channel = anim->mChannels[0] = new aiNodeAnim();
+	channel->mNodeName.Set("arm");
+
+	channel->mNumPositionKeys = 2;
+	channel->mPositionKeys = new aiVectorKey[2];
+	channel->mPositionKeys[0] = aiVectorKey(1.,aiVector3D(3.f,0.f,0.f));
+	channel->mPositionKeys[1] = aiVectorKey(9.,aiVector3D(3.f,4.f,-2.f));
+
+	channel->mNumRotationKeys = 4;
+	channel->mRotationKeys = new aiQuatKey[4];
+	channel->mRotationKeys[0] = aiQuatKey(0.,aiQuaternion(1.f,0.f,0.f,0.f));
+	channel->mRotationKeys[1] = aiQuatKey(2.,aiQuaternion(aiVector3D(0.f,0.f,1.f),1.5f));
+	channel->mRotationKeys[2] = aiQuatKey(7.,aiQuaternion(aiVector3D(0.f,0.f,1.f),-2.8f));
+	channel->mRotationKeys[3] = aiQuatKey(10.,aiQuaternion(aiVector3D(0.f,0.6f,0.8f),0.3f));
+
+	channel->mNumScalingKeys = 1;
+	channel->mScalingKeys = new aiVectorKey[1];
+	channel->mScalingKeys[0] = aiVectorKey(0.,aiVector3D(2.f,2.f,2.f));
+}
+
+void AnimationEvaluatorTest :: tearDown (void)
+{
+	delete scene;
+}
+
+aiMatrix4x4 AnimationEvaluatorTest :: referenceTransform (double time)
+{
+	// time in ticks, the channel's pre and post states are aiAnimBehaviour_DEFAULT
+	aiVector3D position = channel->mPositionKeys[0].mValue;
+	for (unsigned int i = 0; i+1 < channel->mNumPositionKeys; ++i) {
+		const aiVectorKey& a = channel->mPositionKeys[i], &b = channel->mPositionKeys[i+1];
+		if (time >= a.mTime && time <= b.mTime) {
+			const float f = static_cast<float>((time - a.mTime) / (b.mTime - a.mTime));
+			position = a.mValue + (b.mValue - a.mValue) * f;
+		}
+	}
+	if (time < channel->mPositionKeys[0].mTime || time > channel->mPositionKeys[channel->mNumPositionKeys-1].mTime) {
+		position = aiVector3D(3.f,0.f,0.f);
+	}
+
+	aiQuaternion rotation = channel->mRotationKeys[0].mValue;
+	for (unsigned int i = 0; i+1 < channel->mNumRotationKeys; ++i) {
+		const aiQuatKey& a = channel->mRotationKeys[i], &b = channel->mRotationKeys[i+1];
+		if (time >= a.mTime && time <= b.mTime) {
+			const float f = static_cast<float>((time - a.mTime) / (b.mTime - a.mTime));
+			aiQuaternion::Interpolate(rotation,a.mValue,b.mValue,f);
+		}
+	}
+	return compose(channel->mScalingKeys[0].mValue,rotation,position);
+}
+
+bool AnimationEvaluatorTest :: equal (const aiMatrix4x4& a, const aiMatrix4x4& b, float epsilon)
+{
+	for (unsigned int i = 0; i < 4; ++i) {
+		for (unsigned int n = 0; n < 4; ++n) {
+			if (!(fabs(a[i][n] - b[i][n]) <= epsilon)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void AnimationEvaluatorTest :: testInterpolation (void)
+{
+	AnimationEvaluator eval(scene);
+	CPPUNIT_ASSERT(eval.GetNumNodes() == 3);
+	CPPUNIT_ASSERT(eval.GetNode(0) == scene->mRootNode);
+
+	const aiNode* arm = scene->mRootNode->mChildren[0];
+	CPPUNIT_ASSERT(eval.GetNodeIndex(arm) == 1);
+
+	// before the first call, the bind pose is held
+	CPPUNIT_ASSERT(eval.GetLocalTransform(arm) == arm->mTransformation);
+
+	// the interpolated transformations must match the reference 
+	// implementation, between and right on the keys
+	for (double time = 0.; time < 5.; time += 0.0625) {
+		eval.Evaluate(time);
+		CPPUNIT_ASSERT(equal(eval.GetLocalTransform(arm),referenceTransform(time*2.)));
+
+		// the root isn't animated
+		CPPUNIT_ASSERT(eval.GetLocalTransform(scene->mRootNode) == scene->mRootNode->mTransformation);
+	}
+}
+
+void AnimationEvaluatorTest :: testBehaviour (void)
+{
+	AnimationEvaluator eval(scene);
+	const aiNode* arm = scene->mRootNode->mChildren[0];
+
+	// looping is on by default
+	CPPUNIT_ASSERT(eval.IsLooping());
+	eval.Evaluate(6.);
+	CPPUNIT_ASSERT(equal(eval.GetLocalTransform(arm),referenceTransform(2.)));
+
+	eval.SetLooping(false);
+	std::vector<aiMatrix4x4> pose(eval.GetNumNodes());
+	const aiMatrix4x4& mat = pose[1];
+
+	// before the first position key, the default is to use the node's transformation.
+	// The single scaling key holds at all times.
+	aiQuaternion expected;
+	aiQuaternion::Interpolate(expected,channel->mRotationKeys[0].mValue,channel->mRotationKeys[1].mValue,0.25f);
+	channel->mPositionKeys[0].mValue.x = 1.f;
+	eval.SetAnimation(0);
+	eval.SamplePose(0.25,&pose[0],NULL);
+	CPPUNIT_ASSERT(equal(mat,compose(aiVector3D(2.f,2.f,2.f),expected,aiVector3D(3.f,0.f,0.f))));
+	channel->mPositionKeys[0].mValue.x = 3.f;
+
+	// keep the last key
+	channel->mPostState = aiAnimBehaviour_CONSTANT;
+	eval.SetAnimation(0);
+	eval.SamplePose(8.,&pose[0],NULL);
+	CPPUNIT_ASSERT(equal(mat,compose(aiVector3D(2.f,2.f,2.f),channel->mRotationKeys[3].mValue,aiVector3D(3.f,4.f,-2.f))));
+
+	// go on with the first and last two keys
+	channel->mPreState = channel->mPostState = aiAnimBehaviour_LINEAR;
+	eval.SetAnimation(0);
+	eval.SamplePose(0.,&pose[0],NULL);
+	aiVector3D scaling, position;
+	aiQuaternion rotation;
+	mat.Decompose(scaling,rotation,position);
+	CPPUNIT_ASSERT(fabs(position.y + 0.5f) < 1e-4f && fabs(position.z - 0.25f) < 1e-4f);
+
+	eval.SamplePose(5.5,&pose[0],NULL);
+	aiQuaternion::Interpolate(expected,channel->mRotationKeys[2].mValue,channel->mRotationKeys[3].mValue,4.f/3.f);
+	CPPUNIT_ASSERT(equal(mat,compose(aiVector3D(2.f,2.f,2.f),expected,aiVector3D(3.f,5.f,-2.5f))));
+
+	// repeat the keys of each track independently
+	channel->mPreState = channel->mPostState = aiAnimBehaviour_REPEAT;
+	eval.SetAnimation(0);
+	eval.SamplePose(0.25,&pose[0],NULL);
+	mat.Decompose(scaling,rotation,position);
+	CPPUNIT_ASSERT(fabs(position.y - 3.75f) < 1e-4f);
+
+	// no animation at all: the bind pose
+	eval.SetAnimation(1);
+	CPPUNIT_ASSERT(NULL == eval.GetAnimation());
+	eval.Evaluate(1.);
+	CPPUNIT_ASSERT(eval.GetLocalTransform(arm) == arm->mTransformation);
+}
+
+void AnimationEvaluatorTest :: testHierarchy (void)
+{
+	AnimationEvaluator eval(scene);
+	const aiNode* root = scene->mRootNode, *arm = root->mChildren[0], *hand = arm->mChildren[0];
+
+	// in bind pose, the bone matrices are identity matrices
+	const aiMatrix4x4* bones = eval.GetBoneMatrices(root);
+	CPPUNIT_ASSERT(NULL != bones);
+	CPPUNIT_ASSERT(equal(bones[0],aiMatrix4x4()));
+
+	eval.Evaluate(1.7);
+	const aiMatrix4x4 global = root->mTransformation * eval.GetLocalTransform(arm) * hand->mTransformation;
+	CPPUNIT_ASSERT(equal(eval.GetGlobalTransform(hand),global));
+
+	aiMatrix4x4 inverse = root->mTransformation;
+	inverse.Inverse();
+	bones = eval.GetBoneMatrices(root);
+	CPPUNIT_ASSERT(equal(bones[0],inverse * global * scene->mMeshes[0]->mBones[0]->mOffsetMatrix));
+
+	// the same, from a pose sampled without changing the evaluator's state
+	std::vector<aiMatrix4x4> pose(eval.GetNumNodes());
+	aiMatrix4x4 palette;
+	eval.SamplePose(1.7,NULL,&pose[0]);
+	eval.GetBonePalette(&pose[0],root,0,&palette);
+	CPPUNIT_ASSERT(palette == bones[0]);
+}
+
+void AnimationEvaluatorTest :: testBatchSampling (void)
+{
+	AnimationEvaluator eval(scene);
+	const unsigned int numNodes = eval.GetNumNodes(), numTimes = 100;
+
+	std::vector<double> times(numTimes);
+	for (unsigned int i = 0; i < numTimes; ++i) {
+		times[i] = i * 0.173 - 3.;
+	}
+
+	std::vector<aiMatrix4x4> local(numTimes*numNodes), global(numTimes*numNodes);
+	eval.SamplePoses(&times[0],numTimes,&local[0],&global[0],4);
+
+	// must be exactly the same as sampling one pose after another
+	std::vector<aiMatrix4x4> l(numNodes), g(numNodes);
+	for (unsigned int i = 0; i < numTimes; ++i) {
+		eval.SamplePose(times[i],&l[0],&g[0]);
+		for (unsigned int n = 0; n < numNodes; ++n) {
+			CPPUNIT_ASSERT(l[n] == local[i*numNodes+n]);
+			CPPUNIT_ASSERT(g[n] == global[i*numNodes+n]);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#ifndef TESTANIMEVAL_H
+#define TESTANIMEVAL_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/scene.h>
+#include <assimp/AnimationEvaluator.hpp>
+
+using namespace std;
+using namespace Assimp;
+
+class AnimationEvaluatorTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (AnimationEvaluatorTest);
+    CPPUNIT_TEST (testInterpolation);
+    CPPUNIT_TEST (testBehaviour);
+    CPPUNIT_TEST (testHierarchy);
+    CPPUNIT_TEST (testBatchSampling);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testInterpolation (void);
+        void  testBehaviour (void);
+        void  testHierarchy (void);
+        void  testBatchSampling (void);
+
+	private:
+
+		// local transformation of the animated node, computed key by key
+		aiMatrix4x4 referenceTransform (double time);
+
+		bool equal (const aiMatrix4x4& a, const aiMatrix4x4& b, float epsilon = 1e-4f);
+
+		aiScene* scene;
+		aiNodeAnim* channel;
+};
+
+#endif 
@@ -0,0 +1,224 @@
+#include "UnitTestPCH.h"
+#include "utBlenderBulkConvert.h"
+
+#include "BlenderScene.h"
+#include "BlenderSceneGen.h"
+#include "MemoryIOWrapper.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (BlenderBulkConvertTest);
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+bool Equal(const MVert& a, const MVert& b)
+{
+	for (unsigned int i = 0; i < 3; ++i) {
+		if (a.co[i] != b.co[i] || a.no[i] != b.no[i]) {
+			return false;
+		}
+	}
+	return a.flag == b.flag && a.mat_nr == b.mat_nr && a.bweight == b.bweight;
+}
+
+bool Equal(const MEdge& a, const MEdge& b)
+{
+	return a.v1 == b.v1 && a.v2 == b.v2 && a.crease == b.crease && a.bweight == b.bweight && a.flag == b.flag;
+}
+
+bool Equal(const MFace& a, const MFace& b)
+{
+	return a.v1 == b.v1 && a.v2 == b.v2 && a.v3 == b.v3 && a.v4 == b.v4 && a.mat_nr == b.mat_nr && a.flag == b.flag;
+}
+
+bool Equal(const MTFace& a, const MTFace& b)
+{
+	for (unsigned int i = 0; i < 4; ++i) {
+		if (a.uv[i][0] != b.uv[i][0] || a.uv[i][1] != b.uv[i][1]) {
+			return false;
+		}
+	}
+	return a.flag == b.flag && a.mode == b.mode && a.tile == b.tile && a.unwrap == b.unwrap;
+}
+
+bool Equal(const MCol& a, const MCol& b)
+{
+	return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+void BlenderBulkConvertTest :: setUp (void)
+{
+	importer = new Importer();
+}
+
+// ------------------------------------------------------------------------------------------------
+void BlenderBulkConvertTest :: tearDown (void)
+{
+	delete importer;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Parse the header, the file blocks and the DNA of an uncompressed BLEND file like BlenderImporter
+void BlenderBulkConvertTest :: ReadBlendFile(const char* file, FileDatabase& db)
+{
+	boost::shared_ptr<IOStream> stream(importer->GetIOHandler()->Open(file,"rb"));
+	CPPUNIT_ASSERT(NULL != stream);
+
+	char magic[8] = {0};
+	stream->Read(magic,7,1);
+	CPPUNIT_ASSERT(!strcmp(magic,"BLENDER"));
+
+	db.i64bit = (stream->Read(magic,1,1),magic[0]=='-');
+	db.little = (stream->Read(magic,1,1),magic[0]=='v');
+	stream->Read(magic,3,1);
+
+	db.reader = boost::shared_ptr<StreamReaderAny>(new StreamReaderAny(stream,db.little));
+	db.num_threads = 4;
+
+	DNAParser dna_reader(db);
+	SectionParser parser(*db.reader.get(),db.i64bit);
+	for (parser.Next(); parser.GetCurrent().id != "ENDB"; parser.Next()) {
+		const FileBlockHead& head = parser.GetCurrent();
+		if (head.id == "DNA1") {
+			dna_reader.Parse();
+			continue;
+		}
+		db.entries.push_back(head);
+	}
+	CPPUNIT_ASSERT(!db.dna.structures.empty());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Decode `num` instances of `s` at `start` in bulk and one by one, the results must be identical
+template <typename T> 
+void BlenderBulkConvertTest :: CompareArrays(const FileDatabase& db, const Structure& s, size_t start, size_t num)
+{
+	std::vector<T> bulk(num), single(num);
+
+	db.reader->SetCurrentPos(start);
+	s.ConvertArray(&bulk[0],num,db);
+	const int end = db.reader->GetCurrentPos();
+
+	db.reader->SetCurrentPos(start);
+	for (size_t i = 0; i < num; ++i) {
+		s.Convert(single[i],db);
+	}
+	CPPUNIT_ASSERT_EQUAL(db.reader->GetCurrentPos(),end);
+
+	for (size_t i = 0; i < num; ++i) {
+		CPPUNIT_ASSERT(Equal(bulk[i],single[i]));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compare all file blocks holding arrays of the given structure, returns the number of elements
+template <typename T> 
+size_t BlenderBulkConvertTest :: CompareBlocks(const FileDatabase& db, const char* name)
+{
+	std::map<std::string,size_t>::const_iterator it = db.dna.indices.find(name);
+	CPPUNIT_ASSERT(it != db.dna.indices.end());
+	const Structure& s = db.dna.structures[(*it).second];
+
+	size_t total = 0;
+	for (std::vector<FileBlockHead>::const_iterator bl = db.entries.begin(); bl != db.entries.end(); ++bl) {
+		if ((*bl).dna_index == (*it).second) {
+			CompareArrays<T>(db,s,(*bl).start,(*bl).num);
+			total += (*bl).num;
+		}
+	}
+	return total;
+}
+
+// ------------------------------------------------------------------------------------------------
+void  BlenderBulkConvertTest :: testLittleEndian (void)
+{
+	// 32 bit pointers
+	FileDatabase db;
+	ReadBlendFile("../../test/models/BLEND/TexturedPlane_ImageUv_248.blend",db);
+	CPPUNIT_ASSERT(db.little && !db.i64bit);
+
+	CPPUNIT_ASSERT(CompareBlocks<MVert>(db,"MVert") > 0);
+	CPPUNIT_ASSERT(CompareBlocks<MEdge>(db,"MEdge") > 0);
+	CPPUNIT_ASSERT(CompareBlocks<MFace>(db,"MFace") > 0);
+	CPPUNIT_ASSERT(CompareBlocks<MTFace>(db,"MTFace") > 0);
+	CompareBlocks<MCol>(db,"MCol");
+
+	// 64 bit pointers
+	FileDatabase db64;
+	ReadBlendFile("../../test/models/BLEND/BlenderDefault_262.blend",db64);
+	CPPUNIT_ASSERT(db64.little && db64.i64bit);
+
+	CPPUNIT_ASSERT(CompareBlocks<MVert>(db64,"MVert") > 0);
+	CPPUNIT_ASSERT(CompareBlocks<MEdge>(db64,"MEdge") > 0);
+	CompareBlocks<MFace>(db64,"MFace");
+}
+
+// ------------------------------------------------------------------------------------------------
+void  BlenderBulkConvertTest :: testBigEndian (void)
+{
+	FileDatabase db;
+	ReadBlendFile("../../test/models/BLEND/yxa_1.blend",db);
+	CPPUNIT_ASSERT(!db.little);
+
+	CPPUNIT_ASSERT(CompareBlocks<MVert>(db,"MVert") > 0);
+	CPPUNIT_ASSERT(CompareBlocks<MEdge>(db,"MEdge") > 0);
+	CompareBlocks<MFace>(db,"MFace");
+	CompareBlocks<MTFace>(db,"MTFace");
+	CompareBlocks<MCol>(db,"MCol");
+}
+
+// ------------------------------------------------------------------------------------------------
+void  BlenderBulkConvertTest :: testMultipleBlocks (void)
+{
+	FileDatabase db;
+	ReadBlendFile("../../test/models/BLEND/HUMAN.blend",db);
+
+	std::map<std::string,size_t>::const_iterator it = db.dna.indices.find("MVert");
+	CPPUNIT_ASSERT(it != db.dna.indices.end());
+	const Structure& s = db.dna.structures[(*it).second];
+
+	std::vector<FileBlockHead>::const_iterator bl = db.entries.begin();
+	for (; bl != db.entries.end() && (*bl).dna_index != (*it).second; ++bl);
+	CPPUNIT_ASSERT(bl != db.entries.end());
+
+	// repeat the vertices of the file until the array is decoded in several parallel jobs
+	const size_t size = (*bl).num * s.size, num = 100000 / (*bl).num * (*bl).num;
+	db.reader->SetCurrentPos((*bl).start);
+
+	uint8_t* const buffer = new uint8_t[num * s.size];
+	for (size_t i = 0; i < num * s.size; i += size) {
+		::memcpy(buffer + i,db.reader->GetPtr(),size);
+	}
+	boost::shared_ptr<IOStream> stream(new MemoryIOStream(buffer,num * s.size,true));
+	db.reader = boost::shared_ptr<StreamReaderAny>(new StreamReaderAny(stream,db.little));
+
+	CompareArrays<MVert>(db,s,0,num);
+	db.num_threads = 1;
+	CompareArrays<MVert>(db,s,0,num);
+}
+
+// ------------------------------------------------------------------------------------------------
+void  BlenderBulkConvertTest :: testMissingField (void)
+{
+	FileDatabase db;
+	ReadBlendFile("../../test/models/BLEND/TexturedPlane_ImageUv_248.blend",db);
+
+	// optional fields are zeroed by both paths
+	Structure& s = db.dna.structures[db.dna.indices["MVert"]];
+	s.indices.erase("bweight");
+	s.indices.erase("mat_nr");
+	CPPUNIT_ASSERT(CompareBlocks<MVert>(db,"MVert") > 0);
+
+	// a missing mandatory field leaves the array to the generic path, which fails
+	s.indices.erase("co");
+	bool failed = false;
+	try {
+		CompareBlocks<MVert>(db,"MVert");
+	}
+	catch (const DeadlyImportError&) {
+		failed = true;
+	}
+	CPPUNIT_ASSERT(failed);
+}
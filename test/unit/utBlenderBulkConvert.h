@@ -0,0 +1,47 @@
+#ifndef TESTBLENDERBULKCONVERT_H
+#define TESTBLENDERBULKCONVERT_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+#include "BlenderDNA.h"
+
+using namespace std;
+using namespace Assimp;
+using namespace Assimp::Blender;
+
+class BlenderBulkConvertTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (BlenderBulkConvertTest);
+    CPPUNIT_TEST (testLittleEndian);
+    CPPUNIT_TEST (testBigEndian);
+    CPPUNIT_TEST (testMultipleBlocks);
+    CPPUNIT_TEST (testMissingField);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testLittleEndian (void);
+        void  testBigEndian (void);
+        void  testMultipleBlocks (void);
+        void  testMissingField (void);
+
+	private:
+
+		void ReadBlendFile(const char* file, FileDatabase& db);
+
+		template <typename T> 
+		void CompareArrays(const FileDatabase& db, const Structure& s, size_t start, size_t num);
+
+		template <typename T> 
+		size_t CompareBlocks(const FileDatabase& db, const char* name);
+
+		Importer* importer;
+};
+
+#endif 
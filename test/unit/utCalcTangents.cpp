@@ -0,0 +1,113 @@
+
+#include "UnitTestPCH.h"
+#include "utCalcTangents.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (CalcTangentsTest);
+
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsTest :: setUp (void)
+{
+	// a quad made of two triangles sharing an edge. The texture is mirrored
+	// along the u axis on the second triangle, so the two triangles have 
+	// opposite tangents at the shared vertices.
+	aiMesh* mesh = new aiMesh();
+	mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+	mesh->mNumVertices = 4;
+	mesh->mVertices = new aiVector3D[4];
+	mesh->mNormals = new aiVector3D[4];
+	mesh->mTextureCoords[0] = new aiVector3D[4];
+	mesh->mNumUVComponents[0] = 2;
+
+	mesh->mVertices[0] = aiVector3D(0.f,0.f,0.f);
+	mesh->mVertices[1] = aiVector3D(1.f,0.f,0.f);
+	mesh->mVertices[2] = aiVector3D(0.f,1.f,0.f);
+	mesh->mVertices[3] = aiVector3D(1.f,1.f,0.f);
+	mesh->mTextureCoords[0][0] = aiVector3D(0.f,0.f,0.f);
+	mesh->mTextureCoords[0][1] = aiVector3D(1.f,0.f,0.f);
+	mesh->mTextureCoords[0][2] = aiVector3D(0.f,1.f,0.f);
+	mesh->mTextureCoords[0][3] = aiVector3D(-1.f,1.f,0.f);
+	for (unsigned int i = 0; i < 4; ++i) {
+		mesh->mNormals[i] = aiVector3D(0.f,0.f,1.f);
+	}
+
+	mesh->mNumFaces = 2;
+	mesh->mFaces = new aiFace[2];
+	for (unsigned int i = 0; i < 2; ++i) {
+		mesh->mFaces[i].mNumIndices = 3;
+		mesh->mFaces[i].mIndices = new unsigned int[3];
+	}
+	mesh->mFaces[0].mIndices[0] = 0;
+	mesh->mFaces[0].mIndices[1] = 1;
+	mesh->mFaces[0].mIndices[2] = 2;
+	mesh->mFaces[1].mIndices[0] = 1;
+	mesh->mFaces[1].mIndices[1] = 3;
+	mesh->mFaces[1].mIndices[2] = 2;
+
+	scene = new aiScene();
+	scene->mNumMeshes = 1;
+	scene->mMeshes = new aiMesh*[1];
+	scene->mMeshes[0] = mesh;
+
+	process = new CalcTangentsProcess();
+}
+
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsTest :: tearDown (void)
+{
+	delete process;
+	delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsTest :: CheckTangents()
+{
+	const aiMesh* mesh = scene->mMeshes[0];
+	CPPUNIT_ASSERT(mesh->HasTangentsAndBitangents());
+
+	for (unsigned int i = 0; i < 2; ++i) {
+		const aiFace& face = mesh->mFaces[i];
+		for (unsigned int a = 0; a < 3; ++a) {
+			const aiVector3D& t = mesh->mTangents[face.mIndices[a]];
+			CPPUNIT_ASSERT(i ? t.x < -0.99f : t.x > 0.99f);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void  CalcTangentsTest :: testVerboseInput (void)
+{
+	// give each face its own vertices
+	aiMesh* mesh = scene->mMeshes[0];
+	aiVector3D* vertices = new aiVector3D[6];
+	aiVector3D* normals = new aiVector3D[6];
+	aiVector3D* uvs = new aiVector3D[6];
+	for (unsigned int i = 0; i < 6; ++i) {
+		unsigned int& idx = mesh->mFaces[i/3].mIndices[i%3];
+		vertices[i] = mesh->mVertices[idx];
+		normals[i] = mesh->mNormals[idx];
+		uvs[i] = mesh->mTextureCoords[0][idx];
+		idx = i;
+	}
+	delete[] mesh->mVertices;
+	delete[] mesh->mNormals;
+	delete[] mesh->mTextureCoords[0];
+	mesh->mVertices = vertices;
+	mesh->mNormals = normals;
+	mesh->mTextureCoords[0] = uvs;
+	mesh->mNumVertices = 6;
+
+	process->Execute(scene);
+	CheckTangents();
+}
+
+// ------------------------------------------------------------------------------------------------
+void  CalcTangentsTest :: testIndexedInput (void)
+{
+	// the shared vertices must be split instead of receiving the tangent of the last face
+	scene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
+	process->Execute(scene);
+
+	CPPUNIT_ASSERT_EQUAL(6u,scene->mMeshes[0]->mNumVertices);
+	CPPUNIT_ASSERT(0 == (scene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT));
+	CheckTangents();
+}
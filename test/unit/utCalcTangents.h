@@ -0,0 +1,39 @@
+#ifndef TESTCALCTANGENTS_H
+#define TESTCALCTANGENTS_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/scene.h>
+#include <CalcTangentsProcess.h>
+
+using namespace std;
+using namespace Assimp;
+
+class CalcTangentsTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (CalcTangentsTest);
+    CPPUNIT_TEST (testVerboseInput);
+    CPPUNIT_TEST (testIndexedInput);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testVerboseInput (void);
+        void  testIndexedInput (void);
+
+	private:
+
+		// checks the sign of the tangents of each face
+		void CheckTangents();
+
+		aiScene* scene;
+		// Execute() is protected in CalcTangentsProcess
+		BaseProcess* process;
+};
+
+#endif 
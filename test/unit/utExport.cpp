@@ -73,4 +73,79 @@ void  ExporterTest :: testCExportInterface (void)
 	}
 }
 
+
+void  ExporterTest :: CompareBinaryToText (const char* textFormat, const char* binaryFormat, const char* ext)
+{
+	// export both flavours and read them back, they must yield the same geometry
+	Assimp::Importer textImporter, binaryImporter;
+
+	const aiExportDataBlob* blob = ex->ExportToBlob(pTest,textFormat);
+	CPPUNIT_ASSERT(blob);
+	const aiScene* text = textImporter.ReadFileFromMemory(blob->data,blob->size,0,ext);
+	CPPUNIT_ASSERT(text);
+
+	blob = ex->ExportToBlob(pTest,binaryFormat);
+	CPPUNIT_ASSERT(blob);
+	const aiScene* binary = binaryImporter.ReadFileFromMemory(blob->data,blob->size,0,ext);
+	CPPUNIT_ASSERT(binary);
+
+	CPPUNIT_ASSERT_EQUAL(text->mNumMeshes,binary->mNumMeshes);
+	for (unsigned int i = 0; i < text->mNumMeshes; ++i) {
+		const aiMesh* const a = text->mMeshes[i], *const b = binary->mMeshes[i];
+		CPPUNIT_ASSERT(a->mNumVertices > 0);
+		CPPUNIT_ASSERT_EQUAL(a->mNumVertices,b->mNumVertices);
+		CPPUNIT_ASSERT_EQUAL(a->mNumFaces,b->mNumFaces);
+
+		for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+			// the text formats only keep six significant digits
+			const aiVector3D d = a->mVertices[v] - b->mVertices[v];
+			CPPUNIT_ASSERT(d.SquareLength() < 1e-6f * std::max(1.f,a->mVertices[v].SquareLength()));
+		}
+		for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+			CPPUNIT_ASSERT_EQUAL(a->mFaces[f].mNumIndices,b->mFaces[f].mNumIndices);
+			for (unsigned int n = 0; n < a->mFaces[f].mNumIndices; ++n) {
+				CPPUNIT_ASSERT_EQUAL(a->mFaces[f].mIndices[n],b->mFaces[f].mIndices[n]);
+			}
+		}
+	}
+}
+
+
+void  ExporterTest :: testBinarySTLRoundtrip (void)
+{
+	CompareBinaryToText("stl","stlb","stl");
+}
+
+
+void  ExporterTest :: testBinaryPLYRoundtrip (void)
+{
+	CompareBinaryToText("ply","plyb","ply");
+}
+
+
+void  ExporterTest :: testExportMultiple (void)
+{
+	Exporter::ExportTarget targets[] = {
+		Exporter::ExportTarget("collada","unittest_multiple.dae"),
+		Exporter::ExportTarget("obj","unittest_multiple.obj"),
+		Exporter::ExportTarget("stl","unittest_multiple.stl"),
+		Exporter::ExportTarget("plyb","unittest_multiple.ply"),
+		Exporter::ExportTarget("no_such_format","unittest_multiple.nsf")
+	};
+	const size_t count = sizeof(targets)/sizeof(targets[0]);
+
+	// the unknown format must not prevent the others from being written
+	CPPUNIT_ASSERT_EQUAL(AI_FAILURE,ex->ExportMultiple(pTest,targets,count));
+	CPPUNIT_ASSERT(strlen(ex->GetErrorString()));
+	CPPUNIT_ASSERT_EQUAL(AI_FAILURE,targets[count-1].mResult);
+
+	for (size_t i = 0; i < count-1; ++i) {
+		CPPUNIT_ASSERT_EQUAL(AI_SUCCESS,targets[i].mResult);
+		CPPUNIT_ASSERT(targets[i].mError.empty());
+
+		// check if we can read it again
+		CPPUNIT_ASSERT(im->ReadFile(targets[i].mPath,0));
+	}
+}
+
 #endif
@@ -15,6 +15,9 @@ class ExporterTest : public CPPUNIT_NS :: TestFixture
 	CPPUNIT_TEST (testExportToBlob);
 	CPPUNIT_TEST (testCppExportInterface);
 	CPPUNIT_TEST (testCExportInterface);
+	CPPUNIT_TEST (testBinarySTLRoundtrip);
+	CPPUNIT_TEST (testBinaryPLYRoundtrip);
+	CPPUNIT_TEST (testExportMultiple);
     CPPUNIT_TEST_SUITE_END ();
 
     public:
@@ -27,6 +30,11 @@ class ExporterTest : public CPPUNIT_NS :: TestFixture
 		void  testExportToBlob (void);
 		void  testCppExportInterface (void);
 		void  testCExportInterface (void);
+		void  testBinarySTLRoundtrip (void);
+		void  testBinaryPLYRoundtrip (void);
+		void  testExportMultiple (void);
+
+		void  CompareBinaryToText (const char* textFormat, const char* binaryFormat, const char* ext);
    
 	private:
 
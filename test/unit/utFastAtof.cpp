@@ -0,0 +1,64 @@
+
+#include "UnitTestPCH.h"
+#include "utFastAtof.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (FastAtofTest);
+
+// the compiler rounds literals correctly, so they can serve as reference
+#define CHECK_FLOAT(s,v) CPPUNIT_ASSERT_EQUAL(v##f,fast_atof(s))
+#define CHECK_DOUBLE(s,v) CPPUNIT_ASSERT_EQUAL(v,fast_atod(s))
+
+void  FastAtofTest :: testRounding (void)
+{
+	CHECK_FLOAT("1.320705",1.320705);
+	CHECK_FLOAT("0.1",0.1);
+	CHECK_FLOAT("-123.456789",-123.456789);
+	CHECK_FLOAT("3.4028234e38",3.4028234e38);
+	CHECK_FLOAT("1.17549435e-38",1.17549435e-38);
+	CHECK_FLOAT("1e-30",1e-30);
+
+	// midpoint between two floats, ties go to even
+	CHECK_FLOAT("1.000000059604644775390625",1.000000059604644775390625);
+	CHECK_FLOAT("1.0000000596046447753906251",1.0000000596046447753906251);
+
+	CHECK_DOUBLE("0.1",0.1);
+	CHECK_DOUBLE("0.30000000000000004",0.30000000000000004);
+	CHECK_DOUBLE("9007199254740993",9007199254740993.0);
+	CHECK_DOUBLE("123456789012345678901234567890",123456789012345678901234567890.0);
+	CHECK_DOUBLE("0.000000000000000000000000000001234",0.000000000000000000000000000001234);
+	CHECK_DOUBLE("2.2250738585072011e-308",2.2250738585072011e-308);
+	CHECK_DOUBLE("1.7976931348623157e308",1.7976931348623157e308);
+}
+
+void  FastAtofTest :: testSyntax (void)
+{
+	const char* end;
+	CPPUNIT_ASSERT_EQUAL(0.5f,fast_atof(".5"));
+	CPPUNIT_ASSERT_EQUAL(5.f,fast_atof("5."));
+	CPPUNIT_ASSERT_EQUAL(-2.5f,fast_atof("-2,5"));
+	CPPUNIT_ASSERT_EQUAL(1e10f,fast_atof("+1E+10"));
+	CPPUNIT_ASSERT_EQUAL(0.f,fast_atof("abc"));
+
+	// a comma is only taken as decimal separator if followed by a digit
+	CPPUNIT_ASSERT_EQUAL(3.f,fast_atof("3,x",&end));
+	CPPUNIT_ASSERT(*end == ',');
+
+	CPPUNIT_ASSERT_EQUAL(1.25e-3f,fast_atof("1.25e-3 4",&end));
+	CPPUNIT_ASSERT(*end == ' ');
+}
+
+void  FastAtofTest :: testBatch (void)
+{
+	float values[4] = {9.f,9.f,9.f,9.f};
+	const char* end;
+
+	// trailing garbage of a token is skipped, parsing stops at the line end
+	CPPUNIT_ASSERT_EQUAL(3u,fast_atoreal_n<float>(" 1.5\t-2 3e1xyz\n4",values,4,&end));
+	CPPUNIT_ASSERT(values[0] == 1.5f && values[1] == -2.f && values[2] == 30.f && values[3] == 9.f);
+	CPPUNIT_ASSERT(*end == '\n');
+
+	double d[2];
+	CPPUNIT_ASSERT_EQUAL(2u,fast_atoreal_n<double>("0.1 0.2 0.3",d,2,&end));
+	CPPUNIT_ASSERT(d[0] == 0.1 && d[1] == 0.2);
+	CPPUNIT_ASSERT(*end == ' ');
+}
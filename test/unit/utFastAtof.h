@@ -0,0 +1,23 @@
+#ifndef INCLUDED_UT_FASTATOF_H
+#define INCLUDED_UT_FASTATOF_H
+
+#include "fast_atof.h"
+
+using namespace Assimp;
+
+class FastAtofTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (FastAtofTest);
+	CPPUNIT_TEST (testRounding);
+	CPPUNIT_TEST (testSyntax);
+	CPPUNIT_TEST (testBatch);
+    CPPUNIT_TEST_SUITE_END ();
+
+    protected:
+
+        void  testRounding (void);
+		void  testSyntax (void);
+		void  testBatch (void);
+};
+
+#endif 
@@ -2,6 +2,9 @@
 #include "UnitTestPCH.h"
 #include "utImporter.h"
 
+#include "SceneArena.h"
+#include "ScenePrivate.h"
+
 #define InputData_BLOCK_SIZE 1310
 
 // test data for Importer::ReadFileFromMemory() - ./test/3DS/CameraRollAnim.3ds
@@ -186,6 +189,111 @@ void ImporterTest :: testExtensionCheck (void)
 	//  TODO
 }
 
+static const uint32_t LOOKUP_TOKEN = AI_MAKE_MAGIC("LKUP");
+
+// Importer for *.lookup files starting with 'LKUP', counts how often it is asked
+class LookupPlugin : public BaseImporter
+{
+public:
+	LookupPlugin() : extensionChecks(), signatureChecks() {}
+
+	bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const {
+		if (!checkSig) {
+			++extensionChecks;
+			return GetExtension(pFile) == "lookup" && CheckMagicToken(pIOHandler,pFile,&LOOKUP_TOKEN,1);
+		}
+		++signatureChecks;
+		return CheckMagicToken(pIOHandler,pFile,&LOOKUP_TOKEN,1);
+	}
+
+	const aiImporterDesc* GetInfo () const {
+		static const aiImporterDesc desc = {"UNIT TEST - LOOKUP","","","",0,0,0,0,0,"lookup"};
+		return &desc;
+	}
+
+	void GetMagicTokens(std::vector<uint32_t>& tokens) const {
+		tokens.push_back(LOOKUP_TOKEN);
+	}
+
+	void InternReadFile( const std::string& /*pFile*/, aiScene* pScene, IOSystem* /*pIOHandler*/) {
+		pScene->mRootNode = new aiNode("lookup");
+		pScene->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
+	}
+
+	mutable unsigned int extensionChecks, signatureChecks;
+};
+
+// Importer accepting any file during signature-based detection
+class GreedyPlugin : public BaseImporter
+{
+public:
+	bool CanRead( const std::string& /*pFile*/, IOSystem* /*pIOHandler*/, bool checkSig) const {
+		return checkSig;
+	}
+
+	const aiImporterDesc* GetInfo () const {
+		static const aiImporterDesc desc = {"UNIT TEST - GREEDY","","","",0,0,0,0,0,"greedy"};
+		return &desc;
+	}
+
+	void InternReadFile( const std::string& /*pFile*/, aiScene* pScene, IOSystem* /*pIOHandler*/) {
+		pScene->mRootNode = new aiNode("greedy");
+		pScene->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
+	}
+};
+
+static void WriteLookupFile(IOSystem* io, const char* file, const char* head)
+{
+	IOStream* stream = io->Open(file,"wb");
+	CPPUNIT_ASSERT(NULL != stream);
+	char data[16] = {0};
+	::memcpy(data,head,4);
+	stream->Write(data,1,sizeof(data));
+	io->Close(stream);
+}
+
+void  ImporterTest :: testImporterLookup (void)
+{
+	// the greedy importer comes first, so it wins unless the other one is 
+	// found through its extension or its signature
+	pImp->RegisterLoader(new GreedyPlugin());
+	LookupPlugin* lookup = new LookupPlugin();
+	pImp->RegisterLoader(lookup);
+
+	WriteLookupFile(pImp->GetIOHandler(),"unittest_lookup.lookup","LKUP");
+	WriteLookupFile(pImp->GetIOHandler(),"unittest_lookup_nope.lookup","NOPE");
+	WriteLookupFile(pImp->GetIOHandler(),"unittest_lookup.unknownext","LKUP");
+	WriteLookupFile(pImp->GetIOHandler(),"unittest_lookup_noext","LKUP");
+
+	// extension hit, no signature-based detection
+	const aiScene* sc = pImp->ReadFile("unittest_lookup.lookup",0);
+	CPPUNIT_ASSERT(sc != NULL && sc->mRootNode->mName == aiString("lookup"));
+	CPPUNIT_ASSERT(1 == lookup->extensionChecks && 0 == lookup->signatureChecks);
+
+	// the importer for the extension declines, it is not asked again before 
+	// falling back to signature-based detection, where the greedy one comes first
+	lookup->extensionChecks = lookup->signatureChecks = 0;
+	sc = pImp->ReadFile("unittest_lookup_nope.lookup",0);
+	CPPUNIT_ASSERT(sc != NULL && sc->mRootNode->mName == aiString("greedy"));
+	CPPUNIT_ASSERT(1 == lookup->extensionChecks && 0 == lookup->signatureChecks);
+
+	// unknown extension, the signature table finds the importer before the greedy one
+	lookup->extensionChecks = lookup->signatureChecks = 0;
+	sc = pImp->ReadFile("unittest_lookup.unknownext",0);
+	CPPUNIT_ASSERT(sc != NULL && sc->mRootNode->mName == aiString("lookup"));
+	CPPUNIT_ASSERT(1 == lookup->extensionChecks && 1 == lookup->signatureChecks);
+
+	// no extension, signature-based detection only
+	lookup->extensionChecks = lookup->signatureChecks = 0;
+	sc = pImp->ReadFile("unittest_lookup_noext",0);
+	CPPUNIT_ASSERT(sc != NULL && sc->mRootNode->mName == aiString("lookup"));
+	CPPUNIT_ASSERT(0 == lookup->extensionChecks && 1 == lookup->signatureChecks);
+
+	// built-in importers with magic tokens, without extension
+	sc = pImp->ReadFileFromMemory(InputData_abRawBlock,InputData_BLOCK_SIZE,0);
+	CPPUNIT_ASSERT(sc != NULL && sc->mRootNode->mName == aiString("<3DSRoot>"));
+}
+
 void  ImporterTest :: testMultipleReads (void)
 {
 	// see http://sourceforge.net/projects/assimp/forums/forum/817654/topic/3591099
@@ -216,3 +324,93 @@ void  ImporterTest :: testMultipleReads (void)
 	CPPUNIT_ASSERT(pImp->ReadFile("../../test/models/X/bcn_epileptic.x",flags));
 	//CPPUNIT_ASSERT(pImp->ReadFile("../../test/models/X/dwarf.x",flags)); # is in nonbsd
 }
+
+// Progress handler that abandons the import after a given number of callbacks
+class CancellingProgressHandler : public ProgressHandler
+{
+public:
+	CancellingProgressHandler(int limit)
+		: limit(limit), calls(0), finished(false) {}
+
+	bool Update(float /*percentage*/) {
+		return limit < 0 || ++calls <= limit;
+	}
+
+	void ReadFileFinished(const aiScene* /*scene*/) {
+		finished = true;
+	}
+
+	int limit, calls;
+	bool finished;
+};
+
+void  ImporterTest :: testCancelReadFile (void)
+{
+	const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals;
+
+	// a handler returning false must abort the import, whatever the phase
+	for (int i = 0; i < 4; ++i) {
+		CancellingProgressHandler* handler = new CancellingProgressHandler(i);
+		pImp->SetProgressHandler(handler);
+
+		CPPUNIT_ASSERT(NULL == pImp->ReadFile("../../test/models/X/test.x",flags));
+		CPPUNIT_ASSERT(NULL == pImp->GetScene());
+	}
+
+	// the importer must be reusable after a cancelled import
+	CancellingProgressHandler* handler = new CancellingProgressHandler(-1);
+	pImp->SetProgressHandler(handler);
+	CPPUNIT_ASSERT(NULL != pImp->ReadFile("../../test/models/X/test.x",flags));
+
+	// asynchronous read, waited for
+	CPPUNIT_ASSERT(pImp->ReadFileAsync("../../test/models/X/test.x",flags));
+	const aiScene* sc = pImp->WaitForReadFile();
+	CPPUNIT_ASSERT(sc != NULL && pImp->IsReadFileDone() && handler->finished);
+
+	// asynchronous read, cancelled. Depending on timing the import may have finished already.
+	CPPUNIT_ASSERT(pImp->ReadFileAsync("../../test/models/X/test.x",flags));
+	pImp->CancelReadFile();
+	pImp->WaitForReadFile();
+	CPPUNIT_ASSERT(pImp->IsReadFileDone());
+	pImp->SetProgressHandler(NULL);
+}
+
+void  ImporterTest :: testScenePool (void)
+{
+	pImp->SetPropertyInteger(AI_CONFIG_GLOB_SCENE_POOL,1);
+
+	// read several times to make sure the pool is properly reset in between
+	size_t capacity = 0;
+	for (unsigned int i = 0; i < 3; ++i) {
+		const aiScene* sc = pImp->ReadFileFromMemory(InputData_abRawBlock,InputData_BLOCK_SIZE,
+			aiProcessPreset_TargetRealtime_Quality,"3ds");
+
+		CPPUNIT_ASSERT(sc != NULL);
+		CPPUNIT_ASSERT(sc->mRootNode->mName == aiString("<3DSRoot>"));
+		CPPUNIT_ASSERT(sc->mNumMeshes == 1 && sc->mMeshes[0]->mNumVertices ==24 && sc->mMeshes[0]->mNumFaces ==12);
+
+		// the final scene lives in the pool, with all face indices in one block
+		const aiMesh* mesh = sc->mMeshes[0];
+		const SceneArena* arena = ScenePriv(sc)->mArena;
+		CPPUNIT_ASSERT(arena != NULL && arena->GetUsed() > 0);
+		for (unsigned int f = 1; f < mesh->mNumFaces; ++f) {
+			CPPUNIT_ASSERT(mesh->mFaces[f].mIndices == mesh->mFaces[f-1].mIndices + mesh->mFaces[f-1].mNumIndices);
+		}
+
+		// reading the same file again does not need more memory
+		CPPUNIT_ASSERT(!i || arena->GetCapacity() == capacity);
+		capacity = arena->GetCapacity();
+	}
+
+	// further post-processing must be possible
+	const aiScene* sc = pImp->ApplyPostProcessing(aiProcess_FlipWindingOrder);
+	CPPUNIT_ASSERT(sc != NULL && sc->mNumMeshes == 1 && sc->mMeshes[0]->mNumFaces ==12);
+	CPPUNIT_ASSERT(ScenePriv(sc)->mArena != NULL);
+
+	// an orphaned scene is owned by the caller and must be deletable
+	aiScene* orphan = pImp->GetOrphanedScene();
+	CPPUNIT_ASSERT(orphan != NULL && orphan->mNumMeshes == 1 && orphan->mMeshes[0]->mNumVertices ==24);
+	CPPUNIT_ASSERT(orphan->mRootNode->mName == aiString("<3DSRoot>"));
+	CPPUNIT_ASSERT(ScenePriv(orphan)->mArena == NULL && !orphan->mMeshes[0]->HasSharedFaceIndices());
+	delete orphan;
+}
@@ -18,8 +18,11 @@ class ImporterTest : public CPPUNIT_NS :: TestFixture
 	CPPUNIT_TEST (testStringProperty);
 	CPPUNIT_TEST (testPluginInterface);
 	CPPUNIT_TEST (testExtensionCheck);
+	CPPUNIT_TEST (testImporterLookup);
 	CPPUNIT_TEST (testMemoryRead);
 	CPPUNIT_TEST (testMultipleReads);
+	CPPUNIT_TEST (testScenePool);
+	CPPUNIT_TEST (testCancelReadFile);
     CPPUNIT_TEST_SUITE_END ();
 
     public:
@@ -34,9 +37,12 @@ class ImporterTest : public CPPUNIT_NS :: TestFixture
 		
 		void  testPluginInterface (void);
 		void  testExtensionCheck (void);
+		void  testImporterLookup (void);
 		void  testMemoryRead (void);
 
 		void  testMultipleReads (void);
+		void  testScenePool (void);
+		void  testCancelReadFile (void);
 
 	private:
 
@@ -87,3 +87,51 @@ void JoinVerticesTest :: testProcess(void)
 	CPPUNIT_ASSERT(fSum == 150.f*299.f*3.f); // gaussian sum equation
 }
 
+// ------------------------------------------------------------------------------------------------
+void JoinVerticesTest :: testAnimMeshes(void)
+{
+	// give the mesh two morph targets. In the first one all copies of a vertex
+	// are identical, in the second one the third copy of vertices 0..99 moves.
+	pcMesh->mNumAnimMeshes = 2;
+	pcMesh->mAnimMeshes = new aiAnimMesh*[2];
+	for (unsigned int n = 0; n < 2;++n)
+	{
+		aiAnimMesh* anim = pcMesh->mAnimMeshes[n] = new aiAnimMesh();
+		anim->mNumVertices = 900;
+		anim->mVertices = new aiVector3D[900];
+		for (unsigned int i = 0; i < 900;++i)
+		{
+			anim->mVertices[i] = pcMesh->mVertices[i] * 2.f;
+			if (n == 1 && i >= 600 && i < 700)
+				anim->mVertices[i].y += 1000.f;
+		}
+	}
+	piProcess->ProcessMesh(pcMesh,0);
+
+	CPPUNIT_ASSERT(pcMesh->mNumVertices == 400);
+	CPPUNIT_ASSERT(pcMesh->mNumAnimMeshes == 2);
+
+	// the anim meshes must have been remapped along with the mesh itself
+	unsigned int moved = 0;
+	for (unsigned int n = 0; n < 2;++n)
+	{
+		const aiAnimMesh* anim = pcMesh->mAnimMeshes[n];
+		CPPUNIT_ASSERT(anim->mNumVertices == 400);
+
+		for (unsigned int i = 0; i < 400;++i)
+		{
+			const aiVector3D& v = anim->mVertices[i];
+			CPPUNIT_ASSERT(v.x == pcMesh->mVertices[i].x * 2.f);
+			if (v.y != v.x) {
+				CPPUNIT_ASSERT(n == 1 && v.y == v.x + 1000.f);
+				++moved;
+			}
+		}
+	}
+	CPPUNIT_ASSERT(moved == 100);
+
+	// all faces must still reference valid vertices
+	for (unsigned int i = 0; i < pcMesh->mNumFaces;++i)
+		for (unsigned int a = 0; a < 3;++a)
+			CPPUNIT_ASSERT(pcMesh->mFaces[i].mIndices[a] < 400);
+}
@@ -15,6 +15,7 @@ class JoinVerticesTest : public CPPUNIT_NS :: TestFixture
 {
     CPPUNIT_TEST_SUITE (JoinVerticesTest);
     CPPUNIT_TEST (testProcess);
+    CPPUNIT_TEST (testAnimMeshes);
     CPPUNIT_TEST_SUITE_END ();
 
     public:
@@ -24,6 +25,7 @@ class JoinVerticesTest : public CPPUNIT_NS :: TestFixture
     protected:
 
         void  testProcess (void);
+        void  testAnimMeshes (void);
 		
    
 	private:
@@ -0,0 +1,139 @@
+
+#include "UnitTestPCH.h"
+#include "utMemoryInfo.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MemoryInfoTest);
+
+void MemoryInfoTest :: setUp (void)
+{
+	// a single mesh with a quad and a triangle, referenced by the root node
+	scene = new aiScene();
+	scene->mNumMeshes = 1;
+	scene->mMeshes = new aiMesh*[1];
+
+	aiMesh* mesh = scene->mMeshes[0] = new aiMesh();
+	mesh->mNumVertices = 4;
+	mesh->mVertices = new aiVector3D[4];
+	mesh->mNormals = new aiVector3D[4];
+
+	mesh->mNumFaces = 2;
+	mesh->mFaces = new aiFace[2];
+	mesh->mFaces[0].mNumIndices = 4;
+	mesh->mFaces[0].mIndices = new unsigned int[4];
+	mesh->mFaces[1].mNumIndices = 3;
+	mesh->mFaces[1].mIndices = new unsigned int[3];
+	for (unsigned int i = 0; i < 4; ++i) {
+		mesh->mFaces[0].mIndices[i] = i;
+		if (i < 3) {
+			mesh->mFaces[1].mIndices[i] = i;
+		}
+	}
+
+	scene->mRootNode = new aiNode();
+	scene->mRootNode->mNumMeshes = 1;
+	scene->mRootNode->mMeshes = new unsigned int[1];
+	scene->mRootNode->mMeshes[0] = 0;
+}
+
+void MemoryInfoTest :: tearDown (void)
+{
+	delete scene;
+}
+
+void  MemoryInfoTest :: testSceneBreakdown (void)
+{
+	aiSceneMemoryInfo info;
+	Importer::GetMemoryRequirements(scene,info);
+
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(sizeof(void*) + sizeof(aiMesh)),info.meshes);
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(4 * sizeof(aiVector3D)),info.positions);
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(4 * sizeof(aiVector3D)),info.normals);
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(0),info.tangents);
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(0),info.textureCoords);
+
+	// faces are accounted with their real number of indices
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(2 * sizeof(aiFace)),info.faces);
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(7 * sizeof(unsigned int)),info.indices);
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(sizeof(aiNode) + sizeof(unsigned int)),info.nodes);
+
+	CPPUNIT_ASSERT_EQUAL(sizeof(aiScene) + info.meshes + info.positions + info.normals + 
+		info.faces + info.indices + info.nodes,info.total);
+
+	// no scene, no memory
+	Importer::GetMemoryRequirements(NULL,info);
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(0),info.total);
+}
+
+void  MemoryInfoTest :: testLegacyInfo (void)
+{
+	Importer imp;
+	CPPUNIT_ASSERT(imp.ReadFile("../../test/models/OBJ/spider.obj",0));
+
+	aiSceneMemoryInfo info;
+	imp.GetMemoryRequirements(info);
+	CPPUNIT_ASSERT(info.positions && info.faces && info.indices && info.materials && info.nodes);
+
+	aiMemoryInfo legacy;
+	imp.GetMemoryRequirements(legacy);
+	CPPUNIT_ASSERT_EQUAL(info.total,static_cast<ai_uint64>(legacy.total));
+	CPPUNIT_ASSERT_EQUAL(info.materials + info.materialData,static_cast<ai_uint64>(legacy.materials));
+
+	imp.FreeScene();
+	imp.GetMemoryRequirements(info);
+	CPPUNIT_ASSERT_EQUAL(static_cast<ai_uint64>(0),info.total);
+}
+
+void  MemoryInfoTest :: testStepRecords (void)
+{
+	Importer imp;
+
+	// nothing is recorded unless requested
+	CPPUNIT_ASSERT(imp.ReadFile("../../test/models/OBJ/spider.obj",aiProcess_Triangulate));
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0),imp.GetStepMemoryInfoCount());
+
+	imp.SetPropertyInteger(AI_CONFIG_GLOB_MEASURE_MEMORY,1);
+	CPPUNIT_ASSERT(imp.ReadFile("../../test/models/OBJ/spider.obj",
+		aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices));
+
+	// the import itself, followed by the three steps and their helpers
+	const size_t count = imp.GetStepMemoryInfoCount();
+	CPPUNIT_ASSERT(count >= 4);
+	CPPUNIT_ASSERT(!imp.GetStepMemoryInfo(count));
+
+	const aiStepMemoryInfo* rec = imp.GetStepMemoryInfo(0);
+	CPPUNIT_ASSERT_EQUAL(0u,rec->step);
+	CPPUNIT_ASSERT_EQUAL(rec->after,rec->highWater);
+
+	ai_uint64 highWater = rec->highWater;
+	unsigned int seen = 0;
+	for (size_t i = 1; i < count; ++i) {
+		const aiStepMemoryInfo* prev = rec;
+		rec = imp.GetStepMemoryInfo(i);
+
+		// each step starts with the scene left by its predecessor
+		CPPUNIT_ASSERT_EQUAL(prev->after,rec->before);
+		CPPUNIT_ASSERT_EQUAL(rec->after,rec->detail.total);
+
+		highWater = std::max(highWater,rec->after);
+		CPPUNIT_ASSERT_EQUAL(highWater,rec->highWater);
+
+		if (rec->step == aiProcess_CalcTangentSpace) {
+			CPPUNIT_ASSERT(rec->detail.tangents);
+			CPPUNIT_ASSERT(rec->after > rec->before);
+		}
+		if (rec->step == aiProcess_JoinIdenticalVertices) {
+			CPPUNIT_ASSERT(rec->after < rec->before);
+		}
+		seen |= rec->step;
+	}
+	CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(aiProcess_Triangulate | 
+		aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices),seen);
+
+	// the final record matches the scene we got
+	aiSceneMemoryInfo info;
+	imp.GetMemoryRequirements(info);
+	CPPUNIT_ASSERT_EQUAL(info.total,rec->after);
+
+	imp.FreeScene();
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0),imp.GetStepMemoryInfoCount());
+}
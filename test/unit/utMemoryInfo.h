@@ -0,0 +1,32 @@
+#ifndef INCLUDED_UT_MEMORYINFO_H
+#define INCLUDED_UT_MEMORYINFO_H
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class MemoryInfoTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (MemoryInfoTest);
+	CPPUNIT_TEST (testSceneBreakdown);
+	CPPUNIT_TEST (testLegacyInfo);
+	CPPUNIT_TEST (testStepRecords);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testSceneBreakdown (void);
+		void  testLegacyInfo (void);
+		void  testStepRecords (void);
+
+	private:
+
+		aiScene* scene;
+};
+
+#endif 
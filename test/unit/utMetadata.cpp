@@ -0,0 +1,102 @@
+#include "UnitTestPCH.h"
+#include "utMetadata.h"
+
+#include <SceneCombiner.h>
+#include <SceneArena.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MetadataTest);
+
+// ------------------------------------------------------------------------------------------------
+void MetadataTest :: setUp (void)
+{
+	pcData = new aiMetadata(4);
+	pcData->Set(0,"cluster",42);
+	pcData->Set(1,"distance",1.5f);
+	pcData->Set(2,"min",aiVector3D(1.f,2.f,3.f));
+	pcData->Set(3,"pvs",aiString("ff01"));
+}
+
+// ------------------------------------------------------------------------------------------------
+void MetadataTest :: tearDown (void)
+{
+	delete pcData;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MetadataTest :: testGetSet (void)
+{
+	int cluster = 0;
+	CPPUNIT_ASSERT(pcData->Get(std::string("cluster"),cluster));
+	CPPUNIT_ASSERT_EQUAL(42,cluster);
+	CPPUNIT_ASSERT_EQUAL(AI_INT,pcData->mValues[0].mType);
+
+	float distance = 0.f;
+	CPPUNIT_ASSERT(pcData->Get(1,distance));
+	CPPUNIT_ASSERT_EQUAL(1.5f,distance);
+
+	aiVector3D min;
+	CPPUNIT_ASSERT(pcData->Get(std::string("min"),min));
+	CPPUNIT_ASSERT(aiVector3D(1.f,2.f,3.f) == min);
+
+	// wrong types, keys and indices are rejected
+	CPPUNIT_ASSERT(!pcData->Get(std::string("cluster"),distance));
+	CPPUNIT_ASSERT(!pcData->Get(std::string("max"),min));
+	CPPUNIT_ASSERT(!pcData->Get(4,cluster));
+
+	// replacing a value changes its type as well
+	pcData->Set(0,"cluster",true);
+	bool b = false;
+	CPPUNIT_ASSERT(pcData->Get(0,b) && b);
+	CPPUNIT_ASSERT(!pcData->Get(0,cluster));
+}
+
+// ------------------------------------------------------------------------------------------------
+void MetadataTest :: testNodeCopy (void)
+{
+	aiNode* node = new aiNode("node");
+	node->mMetaData = pcData;
+	pcData = NULL;
+
+	aiNode* copy = NULL;
+	Assimp::SceneCombiner::Copy(&copy,node);
+	CPPUNIT_ASSERT(copy->mMetaData && copy->mMetaData != node->mMetaData);
+	CPPUNIT_ASSERT_EQUAL(4u,copy->mMetaData->mNumProperties);
+
+	// the copy must be independent from the source
+	delete node;
+
+	aiString pvs;
+	CPPUNIT_ASSERT(copy->mMetaData->Get(std::string("pvs"),pvs));
+	CPPUNIT_ASSERT(aiString("ff01") == pvs);
+	delete copy;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MetadataTest :: testPooledSceneCopy (void)
+{
+	// pooled scenes carry their metadata, and Importer::GetOrphanedScene() 
+	// copies them back to the heap
+	aiScene* scene = new aiScene();
+	scene->mRootNode = new aiNode("root");
+	scene->mRootNode->mMetaData = pcData;
+	pcData = NULL;
+
+	Assimp::SceneArena arena;
+	aiScene* pooled = Assimp::CopySceneToArena(scene,arena);
+	delete scene;
+
+	int cluster = 0;
+	CPPUNIT_ASSERT(pooled->mRootNode->mMetaData);
+	CPPUNIT_ASSERT(pooled->mRootNode->mMetaData->Get(std::string("cluster"),cluster) && cluster == 42);
+
+	aiScene* copy = Assimp::CopySceneToHeap(pooled);
+	CPPUNIT_ASSERT(copy->mRootNode->mMetaData && copy->mRootNode->mMetaData != pooled->mRootNode->mMetaData);
+	Assimp::DestroyArenaScene(pooled);
+	arena.Reset();
+
+	cluster = 0;
+	aiVector3D min;
+	CPPUNIT_ASSERT(copy->mRootNode->mMetaData->Get(std::string("cluster"),cluster) && cluster == 42);
+	CPPUNIT_ASSERT(copy->mRootNode->mMetaData->Get(std::string("min"),min) && aiVector3D(1.f,2.f,3.f) == min);
+	delete copy;
+}
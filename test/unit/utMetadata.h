@@ -0,0 +1,34 @@
+#ifndef TESTMETADATA_H
+#define TESTMETADATA_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/scene.h>
+
+using namespace std;
+
+class MetadataTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (MetadataTest);
+    CPPUNIT_TEST (testGetSet);
+    CPPUNIT_TEST (testNodeCopy);
+    CPPUNIT_TEST (testPooledSceneCopy);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testGetSet (void);
+        void  testNodeCopy (void);
+        void  testPooledSceneCopy (void);
+
+	private:
+
+		aiMetadata* pcData;
+};
+
+#endif 
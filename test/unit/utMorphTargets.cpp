@@ -0,0 +1,431 @@
+#include "UnitTestPCH.h"
+#include "utMorphTargets.h"
+
+#include "MD2FileData.h"
+#include "MD3FileData.h"
+#include "MDCFileData.h"
+#include "MDLFileData.h"
+#include "UnrealLoader.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MorphTargetsTest);
+
+// ------------------------------------------------------------------------------------------------
+void MorphTargetsTest :: setUp (void)
+{
+	importer = new Importer();
+}
+
+// ------------------------------------------------------------------------------------------------
+void MorphTargetsTest :: tearDown (void)
+{
+	delete importer;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MorphTargetsTest :: ReadModel(const char* file, std::vector<uint8_t>& data)
+{
+	IOStream* stream = importer->GetIOHandler()->Open(file,"rb");
+	CPPUNIT_ASSERT(NULL != stream);
+
+	data.resize(stream->FileSize());
+	CPPUNIT_ASSERT_EQUAL(data.size(),stream->Read(&data[0],1,data.size()));
+	importer->GetIOHandler()->Close(stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+void MorphTargetsTest :: WriteModel(const char* file, const std::vector<uint8_t>& data)
+{
+	IOStream* stream = importer->GetIOHandler()->Open(file,"wb");
+	CPPUNIT_ASSERT(NULL != stream);
+
+	CPPUNIT_ASSERT_EQUAL(data.size(),stream->Write(&data[0],1,data.size()));
+	importer->GetIOHandler()->Close(stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+void  MorphTargetsTest :: testMD2Keyframe (void)
+{
+	const char* file = "../../test/models/MD2/sydney.md2";
+	std::vector<uint8_t> data;
+	ReadModel(file,data);
+
+	// frames are frameSize bytes apart, not sizeof(MD2::Frame)
+	const MD2::Header* header = (const MD2::Header*)&data[0];
+	CPPUNIT_ASSERT(header->numFrames > 5 && header->frameSize != sizeof(MD2::Frame));
+	const MD2::Frame* frame = (const MD2::Frame*)&data[header->offsetFrames + 5*header->frameSize];
+	const MD2::Triangle* triangles = (const MD2::Triangle*)&data[header->offsetTriangles];
+
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_MD2_KEYFRAME,5);
+	const aiScene* scene = importer->ReadFile(file,0);
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+
+	const aiMesh* mesh = scene->mMeshes[0];
+	CPPUNIT_ASSERT_EQUAL(header->numTriangles,mesh->mNumFaces);
+	for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+		for (unsigned int c = 0; c < 3; ++c) {
+			const MD2::Vertex& vert = frame->vertices[triangles[i].vertexIndices[c]];
+
+			// y and z are swapped to become right-handed
+			const aiVector3D& vec = mesh->mVertices[mesh->mFaces[i].mIndices[c]];
+			CPPUNIT_ASSERT_EQUAL(vert.vertex[0] * frame->scale[0] + frame->translate[0],vec.x);
+			CPPUNIT_ASSERT_EQUAL(vert.vertex[1] * frame->scale[1] + frame->translate[1],vec.z);
+			CPPUNIT_ASSERT_EQUAL(vert.vertex[2] * frame->scale[2] + frame->translate[2],vec.y);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void  MorphTargetsTest :: testMD2FrameSizeOverflow (void)
+{
+	std::vector<uint8_t> data;
+	ReadModel("../../test/models/MD2/sydney.md2",data);
+
+	// 2 * 0x80000028 wraps around to 0x50 in 32 bits, the header must be rejected 
+	// instead of reading the frames from far outside the file
+	MD2::Header* header = (MD2::Header*)&data[0];
+	CPPUNIT_ASSERT(header->offsetFrames + 0x50 <= data.size());
+	header->numFrames = 2;
+	header->frameSize = 0x80000028;
+
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_MD2_KEYFRAME,1);
+	CPPUNIT_ASSERT(NULL == importer->ReadFileFromMemory(&data[0],data.size(),0,"md2"));
+}
+
+// ------------------------------------------------------------------------------------------------
+void  MorphTargetsTest :: testMD3Keyframe (void)
+{
+	// a single surface with three vertices in two frames, the second triangle 
+	// refers to a vertex which is not existing.
+	const unsigned int numVertices = 3, numFrames = 2;
+	const unsigned int ofsTriangles = sizeof(MD3::Surface);
+	const unsigned int ofsST = ofsTriangles + 2*sizeof(MD3::Triangle);
+	const unsigned int ofsXYZ = ofsST + numVertices*sizeof(MD3::TexCoord);
+	const unsigned int surfaceSize = ofsXYZ + numFrames*numVertices*sizeof(MD3::Vertex);
+
+	std::vector<uint8_t> data(sizeof(MD3::Header) + surfaceSize,0);
+	MD3::Header* header = (MD3::Header*)&data[0];
+	::memcpy(&header->IDENT,"IDP3",4);
+	header->VERSION = AI_MD3_VERSION;
+	header->NUM_FRAMES = numFrames;
+	header->NUM_SURFACES = 1;
+	header->OFS_FRAMES = header->OFS_TAGS = header->OFS_SURFACES = sizeof(MD3::Header);
+	header->OFS_EOF = (uint32_t)data.size();
+
+	MD3::Surface* surface = (MD3::Surface*)&data[sizeof(MD3::Header)];
+	::memcpy(&surface->IDENT,"IDP3",4);
+	::strcpy(surface->NAME,"surface");
+	surface->NUM_FRAMES = numFrames;
+	surface->NUM_VERTICES = numVertices;
+	surface->NUM_TRIANGLES = 2;
+	surface->OFS_TRIANGLES = surface->OFS_SHADERS = ofsTriangles;
+	surface->OFS_ST = ofsST;
+	surface->OFS_XYZNORMAL = ofsXYZ;
+	surface->OFS_END = surfaceSize;
+
+	MD3::Triangle* triangles = (MD3::Triangle*)((uint8_t*)surface + ofsTriangles);
+	for (unsigned int c = 0; c < 3; ++c) {
+		triangles[0].INDEXES[c] = c;
+		triangles[1].INDEXES[c] = c+5;
+	}
+	MD3::Vertex* vertices = (MD3::Vertex*)((uint8_t*)surface + ofsXYZ);
+	for (unsigned int f = 0; f < numFrames; ++f) {
+		for (unsigned int i = 0; i < numVertices; ++i) {
+			vertices[f*numVertices+i].X = (int16_t)(64*i);
+			vertices[f*numVertices+i].Y = (int16_t)(64*f);
+			vertices[f*numVertices+i].Z = 32;
+		}
+	}
+
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_MD3_KEYFRAME,1);
+	const aiScene* scene = importer->ReadFileFromMemory(&data[0],data.size(),0,"md3");
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+
+	// vertex i of triangle t becomes output vertex 3*t+i, invalid indices are 
+	// clamped to the last vertex
+	const aiMesh* mesh = scene->mMeshes[0];
+	CPPUNIT_ASSERT_EQUAL(6u,mesh->mNumVertices);
+	for (unsigned int i = 0; i < 6; ++i) {
+		const unsigned int index = i < 3 ? i : numVertices-1;
+		CPPUNIT_ASSERT(aiVector3D(index,1.f,0.5f) == mesh->mVertices[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void  MorphTargetsTest :: testMDCFrames (void)
+{
+	// a single triangle in two frames. The first frame uses base frame 0 only, the 
+	// second one base frame 1 and the compressed frame 0.
+	const unsigned int numVertices = 3, numFrames = 2;
+	const unsigned int ofsSurface = sizeof(MDC::Header) + numFrames*sizeof(MDC::Frame);
+	const unsigned int ofsTriangles = sizeof(MDC::Surface);
+	const unsigned int ofsTexCoords = ofsTriangles + sizeof(MDC::Triangle);
+	const unsigned int ofsBaseVerts = ofsTexCoords + numVertices*sizeof(MDC::TexturCoord);
+	const unsigned int ofsCompVerts = ofsBaseVerts + 2*numVertices*sizeof(MDC::BaseVertex);
+	const unsigned int ofsBaseFrames = ofsCompVerts + numVertices*sizeof(MDC::CompressedVertex);
+	const unsigned int ofsCompFrames = ofsBaseFrames + numFrames*sizeof(int16_t);
+	const unsigned int surfaceSize = ofsCompFrames + numFrames*sizeof(int16_t);
+
+	std::vector<uint8_t> data(ofsSurface + surfaceSize,0);
+	MDC::Header* header = (MDC::Header*)&data[0];
+	::memcpy(&header->ulIdent,"IDPC",4);
+	header->ulVersion = AI_MDC_VERSION;
+	header->ulNumFrames = numFrames;
+	header->ulNumSurfaces = 1;
+	header->ulOffsetBorderFrames = sizeof(MDC::Header);
+	header->ulOffsetSurfaces = ofsSurface;
+	header->ulOffsetEnd = (uint32_t)data.size();
+
+	MDC::Frame* frames = (MDC::Frame*)&data[sizeof(MDC::Header)];
+	frames[0].localOrigin = aiVector3D(1.f,2.f,3.f);
+	frames[1].localOrigin = aiVector3D(10.f,20.f,30.f);
+
+	uint8_t* surfaceData = &data[ofsSurface];
+	MDC::Surface* surface = (MDC::Surface*)surfaceData;
+	::memcpy(&surface->ulIdent,"IDPC",4);
+	::strcpy(surface->ucName,"surface");
+	surface->ulNumCompFrames = 1;
+	surface->ulNumBaseFrames = 2;
+	surface->ulNumVertices = numVertices;
+	surface->ulNumTriangles = 1;
+	surface->ulOffsetTriangles = surface->ulOffsetShaders = ofsTriangles;
+	surface->ulOffsetTexCoords = ofsTexCoords;
+	surface->ulOffsetBaseVerts = ofsBaseVerts;
+	surface->ulOffsetCompVerts = ofsCompVerts;
+	surface->ulOffsetFrameBaseFrames = ofsBaseFrames;
+	surface->ulOffsetFrameCompFrames = ofsCompFrames;
+	surface->ulOffsetEnd = surfaceSize;
+
+	MDC::Triangle* triangle = (MDC::Triangle*)(surfaceData + ofsTriangles);
+	MDC::TexturCoord* uvs = (MDC::TexturCoord*)(surfaceData + ofsTexCoords);
+	MDC::BaseVertex* baseVerts = (MDC::BaseVertex*)(surfaceData + ofsBaseVerts);
+	MDC::CompressedVertex* compVerts = (MDC::CompressedVertex*)(surfaceData + ofsCompVerts);
+	for (unsigned int i = 0; i < numVertices; ++i) {
+		triangle->aiIndices[i] = i;
+		uvs[i].u = 0.25f*i;
+		uvs[i].v = 0.5f;
+
+		baseVerts[i].z = (int16_t)(64*i);
+		baseVerts[numVertices+i].x = (int16_t)(64*i);
+		baseVerts[numVertices+i].y = 128;
+
+		// the deltas are biased by 127 and scaled by 4
+		compVerts[i].xd = compVerts[i].zd = 127;
+		compVerts[i].yd = 127+16;
+	}
+	int16_t* baseFrames = (int16_t*)(surfaceData + ofsBaseFrames);
+	baseFrames[0] = 0;
+	baseFrames[1] = 1;
+	int16_t* compFrames = (int16_t*)(surfaceData + ofsCompFrames);
+	compFrames[0] = -1;
+	compFrames[1] = 0;
+
+	// the origin of the frame is added once, to uncompressed and compressed vertices
+	for (unsigned int f = 0; f < numFrames; ++f) {
+		importer->SetPropertyInteger(AI_CONFIG_IMPORT_MDC_KEYFRAME,f);
+		const aiScene* scene = importer->ReadFileFromMemory(&data[0],data.size(),0,"mdc");
+		CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+
+		const aiMesh* mesh = scene->mMeshes[0];
+		CPPUNIT_ASSERT_EQUAL(3u,mesh->mNumVertices);
+		CPPUNIT_ASSERT(mesh->HasTextureCoords(0));
+		for (unsigned int i = 0; i < numVertices; ++i) {
+			const aiVector3D expected = f ? aiVector3D(10.f+i,23.f,30.f) : aiVector3D(1.f,2.f,3.f+i);
+			CPPUNIT_ASSERT(expected == mesh->mVertices[i]);
+			CPPUNIT_ASSERT(aiVector3D(0.25f*i,0.5f,0.f) == mesh->mTextureCoords[0][i]);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void  MorphTargetsTest :: testMDLGroupFrames (void)
+{
+	// a single triangle. The first frame is a simple frame, the second one 
+	// a group of two simple frames, which gives three frames in total.
+	const unsigned int numVertices = 3, numFrames = 3;
+	const unsigned int simpleFrameSize = 2*sizeof(MDL::Vertex) + 16 + numVertices*sizeof(MDL::Vertex);
+	const unsigned int ofsFrames = sizeof(MDL::Header) + numVertices*sizeof(MDL::TexCoord) + sizeof(MDL::Triangle);
+	const unsigned int ofsGroup = ofsFrames + sizeof(int32_t) + simpleFrameSize;
+	const unsigned int groupSize = 2*sizeof(int32_t) + 2*sizeof(MDL::Vertex) + 2*sizeof(float);
+
+	std::vector<uint8_t> data(ofsGroup + groupSize + 2*simpleFrameSize,0);
+	MDL::Header* header = (MDL::Header*)&data[0];
+	::memcpy(&header->ident,"IDPO",4);
+	header->version = AI_MDL_VERSION;
+	header->scale = aiVector3D(1.f,1.f,1.f);
+	header->skinwidth = header->skinheight = 8;
+	header->num_verts = numVertices;
+	header->num_tris = 1;
+	header->num_frames = 2;
+
+	MDL::Triangle* triangle = (MDL::Triangle*)&data[ofsFrames - sizeof(MDL::Triangle)];
+	triangle->facesfront = 1;
+	for (unsigned int i = 0; i < numVertices; ++i) {
+		triangle->vertex[i] = i;
+	}
+
+	// frame headers are zero, except for the type and size of the group
+	*((int32_t*)&data[ofsGroup]) = 1;
+	*((int32_t*)&data[ofsGroup + sizeof(int32_t)]) = 2;
+
+	const unsigned int offsets[numFrames] = {ofsFrames + sizeof(int32_t),
+		ofsGroup + groupSize,ofsGroup + groupSize + simpleFrameSize};
+	for (unsigned int f = 0; f < numFrames; ++f) {
+		MDL::Vertex* vertices = (MDL::Vertex*)&data[offsets[f] + simpleFrameSize - numVertices*sizeof(MDL::Vertex)];
+		for (unsigned int i = 0; i < numVertices; ++i) {
+			vertices[i].v[0] = i;
+			vertices[i].v[1] = f;
+			vertices[i].v[2] = 10+f;
+		}
+	}
+
+	for (unsigned int f = 0; f < numFrames; ++f) {
+		importer->SetPropertyInteger(AI_CONFIG_IMPORT_MDL_KEYFRAME,f);
+		const aiScene* scene = importer->ReadFileFromMemory(&data[0],data.size(),0,"mdl");
+		CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+
+		const aiMesh* mesh = scene->mMeshes[0];
+		CPPUNIT_ASSERT_EQUAL(3u,mesh->mNumVertices);
+		for (unsigned int i = 0; i < numVertices; ++i) {
+			CPPUNIT_ASSERT(aiVector3D(i,f,10.f+f) == mesh->mVertices[i]);
+		}
+	}
+
+	// there is no fourth frame
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_MDL_KEYFRAME,numFrames);
+	CPPUNIT_ASSERT(NULL == importer->ReadFileFromMemory(&data[0],data.size(),0,"mdl"));
+}
+
+// ------------------------------------------------------------------------------------------------
+void  MorphTargetsTest :: testUnrealIndices (void)
+{
+	// two triangles with three vertices in two frames. There are more vertices 
+	// than triangles, the second triangle refers to a vertex which is not existing.
+	const unsigned int numVertices = 3, numTriangles = 2, numFrames = 2;
+
+	std::vector<uint8_t> data(48 + numTriangles*16,0);
+	*((uint16_t*)&data[0]) = numTriangles;
+	*((uint16_t*)&data[2]) = numVertices;
+	for (unsigned int t = 0; t < numTriangles; ++t) {
+		uint16_t* indices = (uint16_t*)&data[48 + t*16];
+		for (unsigned int c = 0; c < 3; ++c) {
+			indices[c] = t ? c+5 : c;
+		}
+	}
+	WriteModel("unittest_unreal_d.3d",data);
+
+	data.assign(4 + numFrames*numVertices*4,0);
+	*((uint16_t*)&data[0]) = numFrames;
+	*((uint16_t*)&data[2]) = numVertices*4;
+	for (unsigned int f = 0; f < numFrames; ++f) {
+		for (unsigned int i = 0; i < numVertices; ++i) {
+			Unreal::CompressVertex(aiVector3D(i,f,10.f+f),*((uint32_t*)&data[4 + (f*numVertices+i)*4]));
+		}
+	}
+	WriteModel("unittest_unreal_a.3d",data);
+
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_UNREAL_KEYFRAME,1);
+	const aiScene* scene = importer->ReadFile("unittest_unreal_d.3d",0);
+	::remove("unittest_unreal_d.3d");
+	::remove("unittest_unreal_a.3d");
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+
+	// vertex i of triangle t becomes output vertex 3*t+i, invalid indices are replaced 
+	// by the first vertex. The loader converts to a right-handed coordinate system.
+	const aiMesh* mesh = scene->mMeshes[0];
+	CPPUNIT_ASSERT_EQUAL(6u,mesh->mNumVertices);
+	for (unsigned int i = 0; i < 6; ++i) {
+		const unsigned int index = i < 3 ? i : 0;
+		CPPUNIT_ASSERT(aiVector3D(index,1.f,-11.f) == mesh->mVertices[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void  MorphTargetsTest :: testImportMorphTargets (void)
+{
+	const char* file = "../../test/models/MD2/sydney.md2";
+
+	// get the vertices of the first frame for comparison
+	const aiScene* scene = importer->ReadFile(file,0);
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes && !scene->mMeshes[0]->mNumAnimMeshes);
+	const std::vector<aiVector3D> first(scene->mMeshes[0]->mVertices,
+		scene->mMeshes[0]->mVertices+scene->mMeshes[0]->mNumVertices);
+
+	// the keyframe selects the base pose, all frames are imported as anim meshes
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_MD2_KEYFRAME,5);
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_MORPH_TARGETS,1);
+	scene = importer->ReadFile(file,aiProcess_ValidateDataStructure);
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+
+	const aiMesh* mesh = scene->mMeshes[0];
+	CPPUNIT_ASSERT(mesh->mNumAnimMeshes > 5);
+	for (unsigned int i = 0; i < mesh->mNumAnimMeshes; ++i) {
+		const aiAnimMesh* anim = mesh->mAnimMeshes[i];
+		CPPUNIT_ASSERT_EQUAL(mesh->mNumVertices,anim->mNumVertices);
+		CPPUNIT_ASSERT(anim->HasPositions() && anim->HasNormals() && !anim->HasTextureCoords(0));
+	}
+	for (unsigned int a = 0; a < mesh->mNumVertices; ++a) {
+		CPPUNIT_ASSERT(first[a] == mesh->mAnimMeshes[0]->mVertices[a]);
+		CPPUNIT_ASSERT(mesh->mVertices[a] == mesh->mAnimMeshes[5]->mVertices[a]);
+		CPPUNIT_ASSERT(mesh->mNormals[a] == mesh->mAnimMeshes[5]->mNormals[a]);
+	}
+
+	// a single animation binds frame n to time n
+	CPPUNIT_ASSERT_EQUAL(1u,scene->mNumAnimations);
+	const aiAnimation* anim = scene->mAnimations[0];
+	CPPUNIT_ASSERT(0 == anim->mNumChannels && 1 == anim->mNumMeshChannels);
+	CPPUNIT_ASSERT_EQUAL(mesh->mNumAnimMeshes-1.,anim->mDuration);
+
+	const aiMeshAnim* channel = anim->mMeshChannels[0];
+	CPPUNIT_ASSERT(channel->mName == mesh->mName);
+	CPPUNIT_ASSERT_EQUAL(mesh->mNumAnimMeshes,channel->mNumKeys);
+	for (unsigned int i = 0; i < channel->mNumKeys; ++i) {
+		CPPUNIT_ASSERT(channel->mKeys[i].mTime == i && channel->mKeys[i].mValue == i);
+	}
+
+	// joining vertices keeps those which differ in any frame
+	const unsigned int numVertices = mesh->mNumVertices;
+	scene = importer->ReadFile(file,aiProcess_JoinIdenticalVertices | aiProcess_ValidateDataStructure);
+	CPPUNIT_ASSERT(NULL != scene);
+	mesh = scene->mMeshes[0];
+	CPPUNIT_ASSERT(mesh->mNumVertices < numVertices);
+	CPPUNIT_ASSERT_EQUAL(mesh->mNumVertices,mesh->mAnimMeshes[0]->mNumVertices);
+}
+
+// ------------------------------------------------------------------------------------------------
+void  MorphTargetsTest :: testPostProcessing (void)
+{
+	const char* file = "../../test/models/MD2/sydney.md2";
+
+	// the first frame is the base pose, so the first anim mesh must equal the mesh
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_MORPH_TARGETS,1);
+	importer->SetPropertyInteger(AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,100);
+	importer->SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT,100);
+	importer->SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS,aiComponent_NORMALS);
+	importer->SetPropertyInteger(AI_CONFIG_PP_PTV_KEEP_HIERARCHY,1);
+
+	const unsigned int steps[] = {
+		aiProcess_SortByPType | aiProcess_SplitLargeMeshes,
+		aiProcess_JoinIdenticalVertices | aiProcess_SplitLargeMeshes | aiProcess_OptimizeMeshes,
+		aiProcess_PreTransformVertices,
+		aiProcess_RemoveComponent
+	};
+	for (unsigned int s = 0; s < sizeof(steps)/sizeof(steps[0]); ++s) {
+		const aiScene* scene = importer->ReadFile(file,steps[s] | aiProcess_ValidateDataStructure);
+		CPPUNIT_ASSERT(NULL != scene && scene->mNumMeshes);
+
+		for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+			const aiMesh* mesh = scene->mMeshes[i];
+			CPPUNIT_ASSERT(mesh->mNumAnimMeshes > 1);
+			CPPUNIT_ASSERT(mesh->mNumVertices <= 100 || !(steps[s] & aiProcess_SplitLargeMeshes));
+
+			const aiAnimMesh* anim = mesh->mAnimMeshes[0];
+			CPPUNIT_ASSERT_EQUAL(mesh->mNumVertices,anim->mNumVertices);
+			CPPUNIT_ASSERT_EQUAL(mesh->HasNormals(),anim->HasNormals());
+			for (unsigned int a = 0; a < mesh->mNumVertices; ++a) {
+				CPPUNIT_ASSERT(mesh->mVertices[a] == anim->mVertices[a]);
+				CPPUNIT_ASSERT(!mesh->HasNormals() || mesh->mNormals[a] == anim->mNormals[a]);
+			}
+		}
+		CPPUNIT_ASSERT(scene->mNumMeshes > 1 || !(steps[s] & aiProcess_SplitLargeMeshes));
+	}
+}
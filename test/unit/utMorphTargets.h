@@ -0,0 +1,49 @@
+#ifndef TESTMORPHTARGETS_H
+#define TESTMORPHTARGETS_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+using namespace std;
+using namespace Assimp;
+
+class MorphTargetsTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (MorphTargetsTest);
+    CPPUNIT_TEST (testMD2Keyframe);
+    CPPUNIT_TEST (testMD2FrameSizeOverflow);
+    CPPUNIT_TEST (testMD3Keyframe);
+    CPPUNIT_TEST (testMDCFrames);
+    CPPUNIT_TEST (testMDLGroupFrames);
+    CPPUNIT_TEST (testUnrealIndices);
+    CPPUNIT_TEST (testImportMorphTargets);
+    CPPUNIT_TEST (testPostProcessing);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testMD2Keyframe (void);
+        void  testMD2FrameSizeOverflow (void);
+        void  testMD3Keyframe (void);
+        void  testMDCFrames (void);
+        void  testMDLGroupFrames (void);
+        void  testUnrealIndices (void);
+        void  testImportMorphTargets (void);
+        void  testPostProcessing (void);
+
+	private:
+
+		void ReadModel(const char* file, std::vector<uint8_t>& data);
+		void WriteModel(const char* file, const std::vector<uint8_t>& data);
+
+		Importer* importer;
+};
+
+#endif 
@@ -0,0 +1,185 @@
+#include "UnitTestPCH.h"
+#include "utObjParser.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ObjParserTest);
+
+// ------------------------------------------------------------------------------------------------
+void ObjParserTest :: setUp (void)
+{
+	serial = new Importer();
+	serial->SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,0);
+
+	parallel = new Importer();
+	parallel->SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,4);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjParserTest :: tearDown (void)
+{
+	delete parallel;
+	delete serial;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* ObjParserTest :: ReadString(Importer* importer, const std::string& obj)
+{
+	return importer->ReadFileFromMemory(obj.c_str(),obj.length(),0,"obj");
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjParserTest :: CompareNodes(const aiNode* a, const aiNode* b)
+{
+	CPPUNIT_ASSERT(a->mName == b->mName);
+	CPPUNIT_ASSERT_EQUAL(a->mNumMeshes,b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		CPPUNIT_ASSERT_EQUAL(a->mMeshes[i],b->mMeshes[i]);
+	}
+	CPPUNIT_ASSERT_EQUAL(a->mNumChildren,b->mNumChildren);
+	for (unsigned int i = 0; i < a->mNumChildren; ++i) {
+		CompareNodes(a->mChildren[i],b->mChildren[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjParserTest :: CompareScenes(const aiScene* a, const aiScene* b)
+{
+	CPPUNIT_ASSERT(NULL != a && NULL != b);
+	CPPUNIT_ASSERT_EQUAL(a->mNumMaterials,b->mNumMaterials);
+	CPPUNIT_ASSERT_EQUAL(a->mNumMeshes,b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		const aiMesh* ma = a->mMeshes[i], *mb = b->mMeshes[i];
+		CPPUNIT_ASSERT_EQUAL(ma->mMaterialIndex,mb->mMaterialIndex);
+		CPPUNIT_ASSERT_EQUAL(ma->mPrimitiveTypes,mb->mPrimitiveTypes);
+		CPPUNIT_ASSERT_EQUAL(ma->mNumVertices,mb->mNumVertices);
+		CPPUNIT_ASSERT_EQUAL(ma->mNumFaces,mb->mNumFaces);
+		CPPUNIT_ASSERT(ma->HasNormals() == mb->HasNormals() && ma->HasTextureCoords(0) == mb->HasTextureCoords(0));
+
+		for (unsigned int v = 0; v < ma->mNumVertices; ++v) {
+			CPPUNIT_ASSERT(ma->mVertices[v] == mb->mVertices[v]);
+			CPPUNIT_ASSERT(!ma->HasNormals() || ma->mNormals[v] == mb->mNormals[v]);
+			CPPUNIT_ASSERT(!ma->HasTextureCoords(0) || ma->mTextureCoords[0][v] == mb->mTextureCoords[0][v]);
+		}
+		for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+			CPPUNIT_ASSERT_EQUAL(ma->mFaces[f].mNumIndices,mb->mFaces[f].mNumIndices);
+			for (unsigned int n = 0; n < ma->mFaces[f].mNumIndices; ++n) {
+				CPPUNIT_ASSERT_EQUAL(ma->mFaces[f].mIndices[n],mb->mFaces[f].mIndices[n]);
+			}
+		}
+	}
+	CompareNodes(a->mRootNode,b->mRootNode);
+}
+
+// ------------------------------------------------------------------------------------------------
+void  ObjParserTest :: testChunkedParsing (void)
+{
+	// several megabytes of objects, groups and material changes, with all kinds of
+	// face statements, so that chunk boundaries fall into each of them
+	std::string obj = "# generated by utObjParser\nmtllib missing.mtl\n";
+	char line[256];
+	unsigned int numVertices = 0;
+	for (unsigned int o = 0; obj.length() < 3 * 1024 * 1024; ++o) {
+		::sprintf(line,"o object%u\ng group%u\nusemtl material%u\ns %u\n",o,o%7,o%3,o%2);
+		obj += line;
+
+		for (unsigned int i = 0; i < 64; ++i) {
+			::sprintf(line,"v %u.5 %u.25 -%u\nvt 0.%u 0.%u\nvn 0 %u 1\n",o,i,o+i,i,o%10,i%2);
+			obj += line;
+		}
+		for (unsigned int i = 1; i < 63; ++i) {
+			const unsigned int a = numVertices+i, b = a+1, c = numVertices+64;
+			switch (i % 6)
+			{
+			case 0:
+				::sprintf(line,"f %u %u %u\n",a,b,c);
+				break;
+			case 1:
+				::sprintf(line,"f %u/%u %u/%u %u/%u\n",a,a,b,b,c,c);
+				break;
+			case 2:
+				::sprintf(line,"f %u//%u %u//%u %u//%u\n",a,a,b,b,c,c);
+				break;
+			case 3:
+				::sprintf(line,"f -%u/-%u/-%u -%u/-%u/-%u -1/-1/-1\n",65-i,65-i,65-i,64-i,64-i,64-i);
+				break;
+			case 4:
+				::sprintf(line,"l %u %u\n\t# indented comment\n",a,b);
+				break;
+			default:
+				::sprintf(line,"f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n",a,a,a,b,b,b,c,c,c,a+2,a+2,a+2);
+			};
+			obj += line;
+		}
+		numVertices += 64;
+	}
+
+	CompareScenes(ReadString(serial,obj),ReadString(parallel,obj));
+	CPPUNIT_ASSERT(serial->GetScene()->mNumMeshes > 100);
+}
+
+// ------------------------------------------------------------------------------------------------
+void  ObjParserTest :: testRelativeIndices (void)
+{
+	static const char head[] = 
+		"v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\n"
+		"vn 0 0 1\nvn 0 1 0\n";
+
+	const aiScene* absolute = ReadString(serial,std::string(head) + "f 2//1 3//1 4//2\n");
+	CPPUNIT_ASSERT(NULL != absolute && 1 == absolute->mNumMeshes);
+
+	Importer importer;
+	CompareScenes(absolute,ReadString(&importer,std::string(head) + "f -3//-2 -2//-2 -1//-1\n"));
+}
+
+// ------------------------------------------------------------------------------------------------
+void  ObjParserTest :: testLongLines (void)
+{
+	// a polygon longer than the old 4096 character line limit, on an unterminated last line
+	std::string obj;
+	char line[64];
+	for (unsigned int i = 0; i < 2000; ++i) {
+		::sprintf(line,"v %u 0 %u\n",i,i%2);
+		obj += line;
+	}
+	obj += "f";
+	for (unsigned int i = 1; i <= 2000; ++i) {
+		::sprintf(line," %u",i);
+		obj += line;
+	}
+	CPPUNIT_ASSERT(obj.length() - obj.rfind('\n') > 4096);
+
+	const aiScene* scene = ReadString(serial,obj);
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+	CPPUNIT_ASSERT_EQUAL(1u,scene->mMeshes[0]->mNumFaces);
+	CPPUNIT_ASSERT_EQUAL(2000u,scene->mMeshes[0]->mFaces[0].mNumIndices);
+	CPPUNIT_ASSERT(aiVector3D(1999.f,0.f,1.f) == scene->mMeshes[0]->mVertices[1999]);
+}
+
+// ------------------------------------------------------------------------------------------------
+void  ObjParserTest :: testSharedFaceIndices (void)
+{
+	static const char obj[] = 
+		"v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\n"
+		"f 1 2 3 4\nf 2 5 3\nl 1 5\n";
+
+	// each face owns its indices unless the shared layout is requested
+	const aiScene* scene = ReadString(serial,obj);
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+	CPPUNIT_ASSERT(!scene->mMeshes[0]->HasSharedFaceIndices());
+
+	Importer importer;
+	importer.SetPropertyInteger(AI_CONFIG_GLOB_SHARED_FACE_INDICES,1);
+	CompareScenes(scene,ReadString(&importer,obj));
+	CPPUNIT_ASSERT(importer.GetScene()->mMeshes[0]->HasSharedFaceIndices());
+
+	// post-processing keeps the layout of each mesh
+	scene = serial->ApplyPostProcessing(aiProcess_Triangulate | aiProcess_SortByPType);
+	CPPUNIT_ASSERT(NULL != scene && 2 == scene->mNumMeshes);
+	CPPUNIT_ASSERT(!scene->mMeshes[0]->HasSharedFaceIndices());
+	CPPUNIT_ASSERT(!scene->mMeshes[1]->HasSharedFaceIndices());
+
+	const aiScene* shared = importer.ApplyPostProcessing(aiProcess_Triangulate | aiProcess_SortByPType);
+	CPPUNIT_ASSERT(NULL != shared && 2 == shared->mNumMeshes);
+	CPPUNIT_ASSERT(shared->mMeshes[0]->HasSharedFaceIndices());
+	CPPUNIT_ASSERT(shared->mMeshes[1]->HasSharedFaceIndices());
+	CompareScenes(scene,shared);
+}
@@ -0,0 +1,46 @@
+#ifndef TESTOBJPARSER_H
+#define TESTOBJPARSER_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+using namespace std;
+using namespace Assimp;
+
+class ObjParserTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (ObjParserTest);
+    CPPUNIT_TEST (testChunkedParsing);
+    CPPUNIT_TEST (testRelativeIndices);
+    CPPUNIT_TEST (testLongLines);
+    CPPUNIT_TEST (testSharedFaceIndices);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testChunkedParsing (void);
+        void  testRelativeIndices (void);
+        void  testLongLines (void);
+        void  testSharedFaceIndices (void);
+
+	private:
+
+		const aiScene* ReadString(Importer* importer, const std::string& obj);
+		void CompareNodes(const aiNode* a, const aiNode* b);
+		void CompareScenes(const aiScene* a, const aiScene* b);
+
+		// parses on the calling thread
+		Importer* serial;
+
+		// splits large files into chunks parsed in parallel
+		Importer* parallel;
+};
+
+#endif 
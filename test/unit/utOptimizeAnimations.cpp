@@ -0,0 +1,151 @@
+
+#include "UnitTestPCH.h"
+#include "utOptimizeAnimations.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (OptimizeAnimationsTest);
+
+static const unsigned int NUM_KEYS = 101;
+
+void OptimizeAnimationsTest :: setUp (void)
+{
+	// one channel with a key per tick: a linear movement, a constant
+	// speed rotation and a constant scaling
+	scene = new aiScene();
+	scene->mNumAnimations = 1;
+	scene->mAnimations = new aiAnimation*[1];
+	aiAnimation* anim = scene->mAnimations[0] = new aiAnimation();
+	anim->mDuration = NUM_KEYS-1;
+	anim->mTicksPerSecond = 100.;
+	anim->mNumChannels = 1;
+	anim->mChannels = new aiNodeAnim*[1];
+	channel = anim->mChannels[0] = new aiNodeAnim();
+
+	channel->mNumPositionKeys = channel->mNumRotationKeys = channel->mNumScalingKeys = NUM_KEYS;
+	channel->mPositionKeys = new aiVectorKey[NUM_KEYS];
+	channel->mRotationKeys = new aiQuatKey[NUM_KEYS];
+	channel->mScalingKeys = new aiVectorKey[NUM_KEYS];
+
+	const aiQuaternion end(aiVector3D(0.f,1.f,0.f),1.5f);
+	for (unsigned int i = 0; i < NUM_KEYS; ++i) {
+		const float f = i / static_cast<float>(NUM_KEYS-1);
+		channel->mPositionKeys[i] = aiVectorKey(i,aiVector3D(10.f,20.f,30.f) * f);
+		channel->mScalingKeys[i] = aiVectorKey(i,aiVector3D(1.f,1.f,1.f));
+
+		channel->mRotationKeys[i].mTime = i;
+		aiQuaternion::Interpolate(channel->mRotationKeys[i].mValue,aiQuaternion(1.f,0.f,0.f,0.f),end,f);
+	}
+
+	process = new OptimizeAnimationsProcess();
+}
+
+void OptimizeAnimationsTest :: tearDown (void)
+{
+	delete process;
+	delete scene;
+}
+
+void OptimizeAnimationsTest :: testReduction (void)
+{
+	// a kink in the movement must be kept
+	for (unsigned int i = 51; i < NUM_KEYS; ++i) {
+		channel->mPositionKeys[i].mValue.z = 30.f - channel->mPositionKeys[i].mValue.z;
+	}
+	process->Execute(scene);
+
+	CPPUNIT_ASSERT(channel->mNumPositionKeys == 3);
+	CPPUNIT_ASSERT(channel->mPositionKeys[1].mTime == 50.);
+	CPPUNIT_ASSERT(channel->mPositionKeys[2].mTime == 100.);
+
+	CPPUNIT_ASSERT(channel->mNumRotationKeys == 2);
+	CPPUNIT_ASSERT(channel->mRotationKeys[0].mTime == 0. && channel->mRotationKeys[1].mTime == 100.);
+
+	CPPUNIT_ASSERT(channel->mNumScalingKeys == 1);
+	CPPUNIT_ASSERT(channel->mScalingKeys[0].mValue == aiVector3D(1.f,1.f,1.f));
+}
+
+void OptimizeAnimationsTest :: testAccuracy (void)
+{
+	// a curved path: all original keys must be reproduced within the 
+	// given error by interpolating between the remaining keys
+	std::vector<aiVectorKey> original(NUM_KEYS);
+	for (unsigned int i = 0; i < NUM_KEYS; ++i) {
+		channel->mPositionKeys[i].mValue.y = sin(i * 0.1f) * 5.f;
+		original[i] = channel->mPositionKeys[i];
+	}
+
+	const float epsilon = 0.01f;
+	process->SetEpsilons(epsilon,epsilon,epsilon);
+	process->Execute(scene);
+	CPPUNIT_ASSERT(channel->mNumPositionKeys > 2 && channel->mNumPositionKeys < NUM_KEYS);
+
+	unsigned int k = 0;
+	for (unsigned int i = 0; i < NUM_KEYS; ++i) {
+		while (channel->mPositionKeys[k+1].mTime < original[i].mTime) {
+			++k;
+		}
+		const aiVectorKey& a = channel->mPositionKeys[k], &b = channel->mPositionKeys[k+1];
+		const float f = static_cast<float>((original[i].mTime - a.mTime) / (b.mTime - a.mTime));
+		const aiVector3D value = a.mValue + (b.mValue - a.mValue) * f;
+		CPPUNIT_ASSERT((value - original[i].mValue).Length() <= epsilon * 1.001f);
+	}
+}
+
+void OptimizeAnimationsTest :: testLongTrack (void)
+{
+	// long linear runs must not take quadratic time
+	const unsigned int numKeys = 200000;
+	delete[] channel->mPositionKeys;
+	delete[] channel->mRotationKeys;
+	channel->mNumPositionKeys = channel->mNumRotationKeys = numKeys;
+	channel->mPositionKeys = new aiVectorKey[numKeys];
+	channel->mRotationKeys = new aiQuatKey[numKeys];
+
+	for (unsigned int i = 0; i < numKeys; ++i) {
+		channel->mPositionKeys[i] = aiVectorKey(i,aiVector3D(1.f,2.f,3.f) * (i * 1e-5f));
+		channel->mRotationKeys[i] = aiQuatKey(i,aiQuaternion(aiVector3D(0.f,0.f,1.f),i * 1e-5f));
+	}
+	process->Execute(scene);
+
+	CPPUNIT_ASSERT(channel->mNumPositionKeys == 2);
+	CPPUNIT_ASSERT(channel->mNumRotationKeys == 2);
+	CPPUNIT_ASSERT(channel->mRotationKeys[1].mTime == numKeys-1);
+}
+
+void OptimizeAnimationsTest :: testResampling (void)
+{
+	for (unsigned int i = 0; i < NUM_KEYS; ++i) {
+		channel->mPositionKeys[i].mValue.y = sin(i * 0.1f) * 5.f;
+	}
+
+	// 100 ticks per second, so one key every 10 ticks
+	process->SetEpsilons(0.f,0.f,0.f);
+	process->SetSampleRate(10.f);
+	process->Execute(scene);
+
+	CPPUNIT_ASSERT(channel->mNumPositionKeys == 11);
+	for (unsigned int i = 0; i < 11; ++i) {
+		const aiVectorKey& key = channel->mPositionKeys[i];
+		CPPUNIT_ASSERT(fabs(key.mTime - i * 10.) < 1e-6);
+		CPPUNIT_ASSERT(fabs(key.mValue.y - sin(i * 1.f) * 5.f) < 1e-4f);
+	}
+}
+
+void OptimizeAnimationsTest :: testQuantization (void)
+{
+	std::vector<aiQuatKey> original(channel->mRotationKeys,channel->mRotationKeys + NUM_KEYS);
+
+	process->SetEpsilons(0.f,0.f,0.f);
+	process->SetQuantizationBits(12);
+	process->Execute(scene);
+
+	// with 12 bits, each component is within 1/5790 of its original value
+	CPPUNIT_ASSERT(channel->mNumRotationKeys > 2);
+	for (unsigned int i = 0; i < channel->mNumRotationKeys; ++i) {
+		const aiQuaternion& q = channel->mRotationKeys[i].mValue;
+		CPPUNIT_ASSERT(fabs(q.x*q.x + q.y*q.y + q.z*q.z + q.w*q.w - 1.f) < 1e-5f);
+
+		const aiQuaternion& o = original[static_cast<unsigned int>(channel->mRotationKeys[i].mTime)].mValue;
+		const float dot = fabs(q.x*o.x + q.y*o.y + q.z*o.z + q.w*o.w);
+		CPPUNIT_ASSERT(2.f * acos(std::min(1.f,dot)) < 0.002f);
+	}
+}
@@ -0,0 +1,42 @@
+#ifndef TESTOPTIMIZEANIMS_H
+#define TESTOPTIMIZEANIMS_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/scene.h>
+#include <OptimizeAnimations.h>
+
+using namespace std;
+using namespace Assimp;
+
+class OptimizeAnimationsTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (OptimizeAnimationsTest);
+    CPPUNIT_TEST (testReduction);
+    CPPUNIT_TEST (testAccuracy);
+    CPPUNIT_TEST (testLongTrack);
+    CPPUNIT_TEST (testResampling);
+    CPPUNIT_TEST (testQuantization);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testReduction (void);
+        void  testAccuracy (void);
+        void  testLongTrack (void);
+        void  testResampling (void);
+        void  testQuantization (void);
+
+	private:
+
+		aiScene* scene;
+		aiNodeAnim* channel;
+		OptimizeAnimationsProcess* process;
+};
+
+#endif 
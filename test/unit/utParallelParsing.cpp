@@ -0,0 +1,139 @@
+#include "UnitTestPCH.h"
+#include "utParallelParsing.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ParallelParsingTest);
+
+// ------------------------------------------------------------------------------------------------
+void ParallelParsingTest :: setUp (void)
+{
+	serial = new Importer();
+	serial->SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,0);
+
+	parallel = new Importer();
+	parallel->SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,4);
+	parallel->SetPropertyInteger(AI_CONFIG_GLOB_PARALLEL_THRESHOLD,0);
+	parallel->SetPropertyInteger(AI_CONFIG_GLOB_PARALLEL_CHUNK,7);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ParallelParsingTest :: tearDown (void)
+{
+	delete parallel;
+	delete serial;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ParallelParsingTest :: CompareScenes(const aiScene* a, const aiScene* b)
+{
+	CPPUNIT_ASSERT(NULL != a && NULL != b);
+	CPPUNIT_ASSERT_EQUAL(a->mNumMeshes,b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		const aiMesh* ma = a->mMeshes[i], *mb = b->mMeshes[i];
+		CPPUNIT_ASSERT_EQUAL(ma->mNumVertices,mb->mNumVertices);
+		CPPUNIT_ASSERT_EQUAL(ma->mNumFaces,mb->mNumFaces);
+		CPPUNIT_ASSERT_EQUAL(ma->mNumBones,mb->mNumBones);
+		CPPUNIT_ASSERT_EQUAL(ma->mMaterialIndex,mb->mMaterialIndex);
+		CPPUNIT_ASSERT(ma->HasNormals() == mb->HasNormals() && ma->HasTextureCoords(0) == mb->HasTextureCoords(0));
+
+		for (unsigned int v = 0; v < ma->mNumVertices; ++v) {
+			CPPUNIT_ASSERT(ma->mVertices[v] == mb->mVertices[v]);
+			CPPUNIT_ASSERT(!ma->HasNormals() || ma->mNormals[v] == mb->mNormals[v]);
+			CPPUNIT_ASSERT(!ma->HasTextureCoords(0) || ma->mTextureCoords[0][v] == mb->mTextureCoords[0][v]);
+		}
+		for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+			CPPUNIT_ASSERT_EQUAL(ma->mFaces[f].mNumIndices,mb->mFaces[f].mNumIndices);
+			for (unsigned int n = 0; n < ma->mFaces[f].mNumIndices; ++n) {
+				CPPUNIT_ASSERT_EQUAL(ma->mFaces[f].mIndices[n],mb->mFaces[f].mIndices[n]);
+			}
+		}
+		for (unsigned int n = 0; n < ma->mNumBones; ++n) {
+			CPPUNIT_ASSERT_EQUAL(ma->mBones[n]->mNumWeights,mb->mBones[n]->mNumWeights);
+		}
+	}
+
+	CPPUNIT_ASSERT_EQUAL(a->mNumAnimations,b->mNumAnimations);
+	for (unsigned int i = 0; i < a->mNumAnimations; ++i) {
+		const aiAnimation* aa = a->mAnimations[i], *ab = b->mAnimations[i];
+		CPPUNIT_ASSERT_EQUAL(aa->mNumChannels,ab->mNumChannels);
+
+		for (unsigned int c = 0; c < aa->mNumChannels; ++c) {
+			const aiNodeAnim* ca = aa->mChannels[c], *cb = ab->mChannels[c];
+			CPPUNIT_ASSERT(ca->mNodeName == cb->mNodeName);
+			CPPUNIT_ASSERT_EQUAL(ca->mNumPositionKeys,cb->mNumPositionKeys);
+			CPPUNIT_ASSERT_EQUAL(ca->mNumRotationKeys,cb->mNumRotationKeys);
+
+			for (unsigned int k = 0; k < ca->mNumPositionKeys; ++k) {
+				CPPUNIT_ASSERT(ca->mPositionKeys[k] == cb->mPositionKeys[k]);
+			}
+			for (unsigned int k = 0; k < ca->mNumRotationKeys; ++k) {
+				CPPUNIT_ASSERT(ca->mRotationKeys[k] == cb->mRotationKeys[k]);
+			}
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ParallelParsingTest :: CompareFile(const char* file)
+{
+	CompareScenes(serial->ReadFile(file,0),parallel->ReadFile(file,0));
+}
+
+// ------------------------------------------------------------------------------------------------
+void  ParallelParsingTest :: testSMD (void)
+{
+	CompareFile("../../test/models/SMD/WusonSMD.smd");
+	CompareFile("../../test/models/SMD/triangle.smd");
+}
+
+// ------------------------------------------------------------------------------------------------
+void  ParallelParsingTest :: testSMDBlankLines (void)
+{
+	// the file ends right after the last token
+	static const char clean[] = 
+		"version 1\n"
+		"nodes\n0 \"root\" -1\nend\n"
+		"skeleton\ntime 0\n0 0 0 0 0 0 0\nend\n"
+		"triangles\n"
+		"tex.bmp\n"
+		"0 0 0 0 0 0 1 0 0\n"
+		"0 1 0 0 0 0 1 1 0\n"
+		"0 0 1 0 0 0 1 0 1\n"
+		"end";
+
+	// lines containing only whitespace in front of the vertices are skipped
+	static const char blank[] = 
+		"version 1\n"
+		"nodes\n0 \"root\" -1\nend\n"
+		"skeleton\ntime 0\n0 0 0 0 0 0 0\nend\n"
+		"triangles\n"
+		"tex.bmp\n"
+		"0 0 0 0 0 0 1 0 0\n"
+		"  \t\n"
+		"0 1 0 0 0 0 1 1 0\n"
+		"\n \r\n"
+		"0 0 1 0 0 0 1 0 1\n"
+		"end";
+
+	const aiScene* scene = serial->ReadFileFromMemory(clean,sizeof(clean)-1,0,"smd");
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes && 3 == scene->mMeshes[0]->mNumVertices);
+	CompareScenes(scene,parallel->ReadFileFromMemory(blank,sizeof(blank)-1,0,"smd"));
+
+	// .. both in parallel and on the calling thread
+	Importer other;
+	CompareScenes(scene,other.ReadFileFromMemory(blank,sizeof(blank)-1,0,"smd"));
+}
+
+// ------------------------------------------------------------------------------------------------
+void  ParallelParsingTest :: testASE (void)
+{
+	CompareFile("../../test/models/ASE/MotionCaptureROM.ase");
+	CompareFile("../../test/models/ASE/ThreeCubesGreen.ASE");
+	CompareFile("../../test/models/ASE/anim.ASE");
+}
+
+// ------------------------------------------------------------------------------------------------
+void  ParallelParsingTest :: testMD5 (void)
+{
+	// loads Bob.md5anim as well
+	CompareFile("../../test/models-nonbsd/MD5/Bob.md5mesh");
+}
@@ -0,0 +1,45 @@
+#ifndef TESTPARALLELPARSING_H
+#define TESTPARALLELPARSING_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+using namespace std;
+using namespace Assimp;
+
+class ParallelParsingTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (ParallelParsingTest);
+    CPPUNIT_TEST (testSMD);
+    CPPUNIT_TEST (testSMDBlankLines);
+    CPPUNIT_TEST (testASE);
+    CPPUNIT_TEST (testMD5);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testSMD (void);
+        void  testSMDBlankLines (void);
+        void  testASE (void);
+        void  testMD5 (void);
+
+	private:
+
+		void CompareFile(const char* file);
+		void CompareScenes(const aiScene* a, const aiScene* b);
+
+		// parses on the calling thread
+		Importer* serial;
+
+		// parses every section on multiple threads, in small chunks
+		Importer* parallel;
+};
+
+#endif 
@@ -1,6 +1,7 @@
 
 #include "UnitTestPCH.h"
 #include "utPretransformVertices.h"
+#include "SceneCombiner.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION (PretransformVerticesTest);
 
@@ -94,4 +95,73 @@ void PretransformVerticesTest :: testProcess_KeepHierarchy (void)
 	CPPUNIT_ASSERT(scene->mNumMaterials == 5);
 	CPPUNIT_ASSERT(scene->mNumMeshes == 49); // see note on mesh 12 above
 	
+}
+
+// ------------------------------------------------------------------------------------------------
+void PretransformVerticesTest :: testProcess_Parallel (void)
+{
+	// enlarge all meshes so the output exceeds the threshold for collecting
+	// the vertices on multiple threads (50 mesh references * 2000 vertices)
+	for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
+		aiMesh* mesh = scene->mMeshes[i];
+		delete[] mesh->mFaces;
+		delete[] mesh->mVertices;
+		delete[] mesh->mNormals;
+
+		mesh->mFaces = new aiFace[ mesh->mNumFaces = 2000 ];
+		mesh->mVertices = new aiVector3D[mesh->mNumVertices = mesh->mNumFaces];
+		mesh->mNormals = i % 2 ? new aiVector3D[mesh->mNumVertices] : NULL;
+		for (unsigned int a = 0; a < mesh->mNumFaces; ++a ) {
+			aiFace& f = mesh->mFaces[a];
+			f.mIndices = new unsigned int [f.mNumIndices = 1];
+			f.mIndices[0] = a;
+
+			mesh->mVertices[a] = aiVector3D((float)i,(float)a,1.f);
+			if (mesh->mNormals) {
+				mesh->mNormals[a] = aiVector3D(0.f,0.f,1.f);
+			}
+		}
+	}
+
+	// the parallel result must match the one computed on a single thread
+	aiScene* serial;
+	SceneCombiner::CopyScene(&serial,scene);
+
+	for (unsigned int i = 0; i < 2; ++i) {
+		const bool keepHierarchy = i != 0;
+		aiScene* parallel;
+		SceneCombiner::CopyScene(&parallel,serial);
+		aiScene* reference;
+		SceneCombiner::CopyScene(&reference,serial);
+
+		Importer imp;
+		imp.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,4);
+		process->SetupProperties(&imp);
+		process->KeepHierarchy(keepHierarchy);
+		process->Execute(parallel);
+
+		imp.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,1);
+		process->SetupProperties(&imp);
+		process->KeepHierarchy(keepHierarchy);
+		process->Execute(reference);
+
+		CPPUNIT_ASSERT(parallel->mNumMeshes == reference->mNumMeshes);
+		for (unsigned int m = 0; m < parallel->mNumMeshes; ++m) {
+			const aiMesh* a = parallel->mMeshes[m], *b = reference->mMeshes[m];
+			CPPUNIT_ASSERT(a->mNumVertices == b->mNumVertices && a->mNumFaces == b->mNumFaces);
+			CPPUNIT_ASSERT(a->HasNormals() == b->HasNormals());
+
+			for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+				CPPUNIT_ASSERT(a->mVertices[v] == b->mVertices[v]);
+				CPPUNIT_ASSERT(!a->HasNormals() || a->mNormals[v] == b->mNormals[v]);
+			}
+			for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+				CPPUNIT_ASSERT(a->mFaces[f].mNumIndices == 1);
+				CPPUNIT_ASSERT(a->mFaces[f].mIndices[0] == b->mFaces[f].mIndices[0]);
+			}
+		}
+		delete parallel;
+		delete reference;
+	}
+	delete serial;
 }
\ No newline at end of file
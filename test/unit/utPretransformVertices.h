@@ -16,6 +16,7 @@ class PretransformVerticesTest : public CPPUNIT_NS :: TestFixture
     CPPUNIT_TEST_SUITE (PretransformVerticesTest);
     CPPUNIT_TEST (testProcess_CollapseHierarchy);
 	CPPUNIT_TEST (testProcess_KeepHierarchy);
+	CPPUNIT_TEST (testProcess_Parallel);
     CPPUNIT_TEST_SUITE_END ();
 
     public:
@@ -26,6 +27,7 @@ class PretransformVerticesTest : public CPPUNIT_NS :: TestFixture
 
         void  testProcess_CollapseHierarchy (void);
 		void  testProcess_KeepHierarchy (void);
+		void  testProcess_Parallel (void);
 		
    
 	private:
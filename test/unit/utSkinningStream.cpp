@@ -0,0 +1,87 @@
+#include "UnitTestPCH.h"
+#include "utSkinningStream.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SkinningStreamTest);
+
+// ------------------------------------------------------------------------------------------------
+void SkinningStreamTest :: setUp (void)
+{
+	// vertex 0 is affected by bones 0..5 with increasing weights,
+	// vertex 1 by bones 1 and 2 and vertex 2 by no bone at all
+	pcMesh = new aiMesh();
+	pcMesh->mNumVertices = 3;
+	pcMesh->mVertices = new aiVector3D[3];
+
+	pcMesh->mNumBones = 6;
+	pcMesh->mBones = new aiBone*[6];
+	for (unsigned int i = 0; i < 6;++i)
+	{
+		aiBone* bone = pcMesh->mBones[i] = new aiBone();
+		bone->mNumWeights = (i == 1 || i == 2) ? 2 : 1;
+		bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+		bone->mWeights[0].mVertexId = 0;
+		bone->mWeights[0].mWeight = (i+1) / 21.f;
+
+		if (bone->mNumWeights == 2)
+		{
+			bone->mWeights[1].mVertexId = 1;
+			bone->mWeights[1].mWeight = 0.5f;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void SkinningStreamTest :: tearDown (void)
+{
+	delete pcMesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SkinningStreamTest :: testPacking (void)
+{
+	SkinningStream stream(pcMesh,4);
+	CPPUNIT_ASSERT(stream.GetNumVertices() == 3);
+	CPPUNIT_ASSERT(stream.GetNumInfluences() == 4);
+	CPPUNIT_ASSERT(stream.GetNumDroppedInfluences() == 2);
+
+	const unsigned short* idx = stream.GetBoneIndices();
+	const unsigned short* w = stream.GetBoneWeights();
+
+	// the four heaviest bones of vertex 0, renormalized
+	unsigned int sum = 0;
+	for (unsigned int i = 0; i < 4;++i)
+	{
+		CPPUNIT_ASSERT(idx[i] == 5-i);
+		CPPUNIT_ASSERT(fabs(w[i] / 65535.f - (6.f-i) / 18.f) < 1e-4f);
+		sum += w[i];
+	}
+	CPPUNIT_ASSERT(sum == 65535);
+
+	// vertex 1 needs two slots, the rounding error goes to one of them
+	CPPUNIT_ASSERT(idx[4] == 1 && idx[5] == 2);
+	CPPUNIT_ASSERT(w[4] + w[5] == 65535);
+	CPPUNIT_ASSERT(w[4] >= 32767 && w[5] >= 32767);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SkinningStreamTest :: testPadding (void)
+{
+	SkinningStream stream(pcMesh,8);
+	CPPUNIT_ASSERT(stream.GetNumDroppedInfluences() == 0);
+
+	const unsigned short* idx = stream.GetBoneIndices();
+	const unsigned short* w = stream.GetBoneWeights();
+
+	// unused slots and vertices without bones are zero
+	CPPUNIT_ASSERT(!idx[6] && !idx[7] && !w[6] && !w[7]);
+	for (unsigned int i = 10; i < 24;++i)
+	{
+		CPPUNIT_ASSERT(!idx[i] && !w[i]);
+	}
+
+	// no reordering if nothing is dropped
+	for (unsigned int i = 0; i < 6;++i)
+	{
+		CPPUNIT_ASSERT(idx[i] == i);
+	}
+}
@@ -0,0 +1,34 @@
+#ifndef TESTSKINNINGSTREAM_H
+#define TESTSKINNINGSTREAM_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/scene.h>
+#include <assimp/SkinningStream.hpp>
+
+using namespace std;
+using namespace Assimp;
+
+class SkinningStreamTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (SkinningStreamTest);
+    CPPUNIT_TEST (testPacking);
+    CPPUNIT_TEST (testPadding);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testPacking (void);
+        void  testPadding (void);
+
+	private:
+
+		aiMesh* pcMesh;
+};
+
+#endif 
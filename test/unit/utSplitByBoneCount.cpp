@@ -0,0 +1,138 @@
+#include "UnitTestPCH.h"
+#include "utSplitByBoneCount.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SplitByBoneCountTest);
+
+// bones affecting each vertex, -1 terminated
+static const int vertexBones[10][3] = {
+	{0,1,-1}, {-1}, {0,-1}, {2,-1}, {3,-1}, {4,-1}, {5,-1}, {2,3,-1}, {6,-1}, {7,-1}
+};
+
+// ------------------------------------------------------------------------------------------------
+void SplitByBoneCountTest :: setUp (void)
+{
+	piProcess = new SplitByBoneCountProcess();
+	piProcess->mMaxBoneCount = 4;
+
+	// Four faces using the bone sets {0,1}, {2,3}, {0,1,4,5} and {2,3,6,7}. Splitting them
+	// in face order takes three submeshes, grouping them by their bones needs only two.
+	// The first two faces share vertex 1, which isn't affected by any bone.
+	aiMesh* mesh = new aiMesh();
+	mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+	mesh->mNumVertices = 10;
+	mesh->mVertices = new aiVector3D[10];
+	for (unsigned int i = 0; i < 10;++i)
+		mesh->mVertices[i] = aiVector3D((float)i,0.f,0.f);
+
+	static const unsigned int indices[4][3] = {{0,1,2},{1,3,4},{0,5,6},{7,8,9}};
+	mesh->mNumFaces = 4;
+	mesh->mFaces = new aiFace[4];
+	for (unsigned int i = 0; i < 4;++i)
+	{
+		aiFace& face = mesh->mFaces[i];
+		face.mIndices = new unsigned int[face.mNumIndices = 3];
+		for (unsigned int a = 0; a < 3;++a)
+			face.mIndices[a] = indices[i][a];
+	}
+
+	mesh->mNumBones = 8;
+	mesh->mBones = new aiBone*[8];
+	for (unsigned int b = 0; b < 8;++b)
+	{
+		aiBone* bone = mesh->mBones[b] = new aiBone();
+		bone->mName.length = ::sprintf(bone->mName.data,"bone%i",b);
+
+		std::vector<aiVertexWeight> weights;
+		for (unsigned int v = 0; v < 10;++v)
+		{
+			unsigned int n = 0;
+			bool affected = false;
+			for (; vertexBones[v][n] != -1;++n)
+				affected = affected || vertexBones[v][n] == (int)b;
+			if (affected)
+				weights.push_back(aiVertexWeight(v,1.f/n));
+		}
+		bone->mNumWeights = (unsigned int)weights.size();
+		bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+		std::copy(weights.begin(),weights.end(),bone->mWeights);
+	}
+
+	pcScene = new aiScene();
+	pcScene->mNumMeshes = 1;
+	pcScene->mMeshes = new aiMesh*[1];
+	pcScene->mMeshes[0] = mesh;
+	pcScene->mRootNode = new aiNode();
+	pcScene->mRootNode->mNumMeshes = 1;
+	pcScene->mRootNode->mMeshes = new unsigned int[1];
+	pcScene->mRootNode->mMeshes[0] = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SplitByBoneCountTest :: tearDown (void)
+{
+	delete pcScene;
+	delete piProcess;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SplitByBoneCountTest :: testPartitioning (void)
+{
+	piProcess->Execute(pcScene);
+
+	CPPUNIT_ASSERT(pcScene->mNumMeshes == 2);
+	CPPUNIT_ASSERT(piProcess->mNumDrawCalls == 2);
+	CPPUNIT_ASSERT(piProcess->mNumDuplicatedVertices == 1);
+	CPPUNIT_ASSERT(pcScene->mRootNode->mNumMeshes == 2);
+
+	// the first submesh takes the faces 0 and 2, the second one the faces 1 and 3
+	static const float firstVertex[2][2] = {{0.f,0.f},{1.f,7.f}};
+	for (unsigned int i = 0; i < 2;++i)
+	{
+		const aiMesh* mesh = pcScene->mMeshes[i];
+		CPPUNIT_ASSERT(mesh->mNumFaces == 2);
+		CPPUNIT_ASSERT(mesh->mNumVertices == 6);
+		CPPUNIT_ASSERT(mesh->mNumBones == 4);
+
+		CPPUNIT_ASSERT(mesh->mVertices[mesh->mFaces[0].mIndices[0]].x == firstVertex[i][0]);
+		CPPUNIT_ASSERT(mesh->mVertices[mesh->mFaces[1].mIndices[0]].x == firstVertex[i][1]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void SplitByBoneCountTest :: testWeights (void)
+{
+	piProcess->Execute(pcScene);
+
+	for (unsigned int i = 0; i < pcScene->mNumMeshes;++i)
+	{
+		const aiMesh* mesh = pcScene->mMeshes[i];
+
+		// every vertex must keep the bones of its source vertex, with the same weights
+		std::vector<float> sum(mesh->mNumVertices,0.f);
+		std::vector<unsigned int> count(mesh->mNumVertices,0);
+		for (unsigned int b = 0; b < mesh->mNumBones;++b)
+		{
+			const aiBone* bone = mesh->mBones[b];
+			const int srcBone = bone->mName.data[4] - '0';
+			for (unsigned int w = 0; w < bone->mNumWeights;++w)
+			{
+				const aiVertexWeight& vw = bone->mWeights[w];
+				const int srcVertex = (int)mesh->mVertices[vw.mVertexId].x;
+
+				bool found = false;
+				for (unsigned int n = 0; vertexBones[srcVertex][n] != -1;++n)
+					found = found || vertexBones[srcVertex][n] == srcBone;
+				CPPUNIT_ASSERT(found);
+
+				sum[vw.mVertexId] += vw.mWeight;
+				++count[vw.mVertexId];
+			}
+		}
+		for (unsigned int v = 0; v < mesh->mNumVertices;++v)
+		{
+			const int srcVertex = (int)mesh->mVertices[v].x;
+			CPPUNIT_ASSERT(count[v] == (srcVertex == 1 ? 0 : (srcVertex == 0 || srcVertex == 7 ? 2 : 1)));
+			CPPUNIT_ASSERT(!count[v] || fabs(sum[v] - 1.f) < 1e-5f);
+		}
+	}
+}
@@ -0,0 +1,35 @@
+#ifndef TESTSPLITBYBONECOUNT_H
+#define TESTSPLITBYBONECOUNT_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/scene.h>
+#include <SplitByBoneCountProcess.h>
+
+using namespace std;
+using namespace Assimp;
+
+class SplitByBoneCountTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (SplitByBoneCountTest);
+    CPPUNIT_TEST (testPartitioning);
+    CPPUNIT_TEST (testWeights);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testPartitioning (void);
+        void  testWeights (void);
+
+	private:
+
+		SplitByBoneCountProcess* piProcess;
+		aiScene* pcScene;
+};
+
+#endif 
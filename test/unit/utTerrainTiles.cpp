@@ -0,0 +1,112 @@
+
+#include "UnitTestPCH.h"
+#include "utTerrainTiles.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TerrainTilesTest);
+
+// ------------------------------------------------------------------------------------------------
+void TerrainTilesTest :: setUp (void)
+{
+	importer = new Importer();
+}
+
+// ------------------------------------------------------------------------------------------------
+void TerrainTilesTest :: tearDown (void)
+{
+	delete importer;
+}
+
+// ------------------------------------------------------------------------------------------------
+void  TerrainTilesTest :: testTileNodes (void)
+{
+	// RealisticTerrain.ter is a grid of 257x257 vertices, thus 16x16 tiles of 16x16 quads
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE,16);
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS,2);
+	const aiScene* scene = importer->ReadFile("../../test/models/TER/RealisticTerrain.ter",0);
+	CPPUNIT_ASSERT(NULL != scene);
+	CPPUNIT_ASSERT(0 != (scene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT));
+
+	aiNode* tile = scene->mRootNode->FindNode("tile_0_0");
+	CPPUNIT_ASSERT(NULL != tile);
+	CPPUNIT_ASSERT(NULL != scene->mRootNode->FindNode("tile_15_15"));
+
+	// the bounding box of the tile is stored in its metadata
+	aiVector3D min,max;
+	CPPUNIT_ASSERT(NULL != tile->mMetaData);
+	CPPUNIT_ASSERT(tile->mMetaData->Get(std::string("min"),min));
+	CPPUNIT_ASSERT(tile->mMetaData->Get(std::string("max"),max));
+	const aiMesh* full = scene->mMeshes[tile->FindNode("tile_0_0_lod0")->mMeshes[0]];
+	for (unsigned int i = 0; i < full->mNumVertices; ++i) {
+		const aiVector3D& v = full->mVertices[i];
+		CPPUNIT_ASSERT(v.x >= min.x && v.y >= min.y && v.z >= min.z);
+		CPPUNIT_ASSERT(v.x <= max.x && v.y <= max.y && v.z <= max.z);
+	}
+
+	// each level of detail halves the number of quads along the edges of the tile
+	unsigned int quads = 16*16;
+	for (unsigned int i = 0; i <= 2; ++i, quads /= 4) {
+		char name[32];
+		::sprintf(name,"tile_0_0_lod%u",i);
+		const aiNode* lod = tile->FindNode(name);
+		CPPUNIT_ASSERT(NULL != lod && 1 == lod->mNumMeshes);
+
+		const aiMesh* mesh = scene->mMeshes[lod->mMeshes[0]];
+		CPPUNIT_ASSERT_EQUAL(quads,mesh->mNumFaces);
+		CPPUNIT_ASSERT(mesh->mNumVertices < mesh->mNumFaces*4);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void  TerrainTilesTest :: testTileCoverage (void)
+{
+	const aiScene* scene = importer->ReadFile("../../test/models/HMP/terrain.hmp",0);
+	CPPUNIT_ASSERT(NULL != scene && 1 == scene->mNumMeshes);
+	const unsigned int faces = scene->mMeshes[0]->mNumFaces;
+	const unsigned int vertices = scene->mMeshes[0]->mNumVertices;
+
+	// without levels of detail, the tiles cover exactly the quads of the untiled terrain
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE,5);
+	scene = importer->ReadFile("../../test/models/HMP/terrain.hmp",aiProcess_ValidateDataStructure);
+	CPPUNIT_ASSERT(NULL != scene && scene->mNumMeshes > 1);
+
+	unsigned int tiledFaces = 0, tiledVertices = 0;
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		tiledFaces += scene->mMeshes[i]->mNumFaces;
+		tiledVertices += scene->mMeshes[i]->mNumVertices;
+	}
+	CPPUNIT_ASSERT_EQUAL(faces,tiledFaces);
+	CPPUNIT_ASSERT(tiledVertices < vertices);
+}
+
+// ------------------------------------------------------------------------------------------------
+void  TerrainTilesTest :: testSmoothNormals (void)
+{
+	const unsigned int flags = aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices | 
+		aiProcess_ValidateDataStructure;
+
+	// the untiled terrain tells which side the height field faces
+	const aiScene* scene = importer->ReadFile("../../test/models/TER/RealisticTerrain.ter",flags);
+	CPPUNIT_ASSERT(NULL != scene && scene->mMeshes[0]->HasNormals());
+	const float up = scene->mMeshes[0]->mNormals[0].z > 0.f ? 1.f : -1.f;
+
+	// the shared vertices of the tiles are split before normals are smoothed, the 
+	// spatial sort computed for the indexed vertices must not be used afterwards.
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_TILE_SIZE,16);
+	importer->SetPropertyInteger(AI_CONFIG_IMPORT_TERRAIN_LOD_LEVELS,1);
+	scene = importer->ReadFile("../../test/models/TER/RealisticTerrain.ter",flags);
+	CPPUNIT_ASSERT(NULL != scene && scene->mNumMeshes > 1);
+
+	// a height field faces up everywhere, there are no normals averaging to zero
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		const aiMesh* mesh = scene->mMeshes[i];
+		CPPUNIT_ASSERT(mesh->HasNormals());
+
+		// joining the split vertices again gives back the indexed tile
+		CPPUNIT_ASSERT(mesh->mNumVertices < mesh->mNumFaces*4);
+		for (unsigned int a = 0; a < mesh->mNumVertices; ++a) {
+			const aiVector3D& n = mesh->mNormals[a];
+			CPPUNIT_ASSERT(fabs(n.Length()-1.f) < 1e-3f);
+			CPPUNIT_ASSERT(n.z * up > 0.f);
+		}
+	}
+}
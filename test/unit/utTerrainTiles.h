@@ -0,0 +1,36 @@
+#ifndef TESTTERRAINTILES_H
+#define TESTTERRAINTILES_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+using namespace std;
+using namespace Assimp;
+
+class TerrainTilesTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (TerrainTilesTest);
+    CPPUNIT_TEST (testTileNodes);
+    CPPUNIT_TEST (testTileCoverage);
+    CPPUNIT_TEST (testSmoothNormals);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testTileNodes (void);
+        void  testTileCoverage (void);
+        void  testSmoothNormals (void);
+
+	private:
+
+		Importer* importer;
+};
+
+#endif 
@@ -53,6 +53,26 @@ void TriangulateProcessTest :: tearDown (void)
 void  TriangulateProcessTest :: testTriangulation (void)
 {
 	piProcess->TriangulateMesh(pcMesh);
+	checkTriangulation(false);
+}
+
+void  TriangulateProcessTest :: testSharedIndices (void)
+{
+	// move the indices of all faces into a single block
+	pcMesh->PackFaceIndices();
+	CPPUNIT_ASSERT(pcMesh->HasSharedFaceIndices());
+	CPPUNIT_ASSERT(pcMesh->mFaces[0].mIndices == pcMesh->mFaceIndices);
+	CPPUNIT_ASSERT(pcMesh->mFaces[1].mIndices == pcMesh->mFaceIndices + 1);
+	CPPUNIT_ASSERT(pcMesh->mFaces[1].mIndices[1] == 2);
+
+	piProcess->TriangulateMesh(pcMesh);
+	checkTriangulation(true);
+}
+
+void  TriangulateProcessTest :: checkTriangulation (bool shared)
+{
+	// the output keeps the index layout of the input
+	CPPUNIT_ASSERT(pcMesh->HasSharedFaceIndices() == shared);
 
 	for (unsigned int m = 0, t = 0, q = 4, max = 1000, idx = 0; m < max;++m)
 	{
@@ -15,6 +15,7 @@ class TriangulateProcessTest : public CPPUNIT_NS :: TestFixture
 {
     CPPUNIT_TEST_SUITE (TriangulateProcessTest);
 	CPPUNIT_TEST (testTriangulation);
+	CPPUNIT_TEST (testSharedIndices);
     CPPUNIT_TEST_SUITE_END ();
 
     public:
@@ -24,9 +25,12 @@ class TriangulateProcessTest : public CPPUNIT_NS :: TestFixture
     protected:
 
         void  testTriangulation (void);
+		void  testSharedIndices (void);
    
 	private:
 
+		void  checkTriangulation (bool shared);
+
 		
 		aiMesh* pcMesh;
 		TriangulateProcess* piProcess;
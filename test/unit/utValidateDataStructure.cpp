@@ -0,0 +1,145 @@
+
+#include "UnitTestPCH.h"
+#include "utValidateDataStructure.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ValidateDataStructureTest);
+
+// number of meshes in the test scene and triangles per mesh. Large
+// enough to make the step distribute the meshes over multiple threads.
+static const unsigned int NUM_MESHES = 8;
+static const unsigned int NUM_FACES  = 10000;
+
+void ValidateDataStructureTest :: setUp (void)
+{
+	// a few large triangle soups, each with a bone whose weights 
+	// don't sum up to one at a single vertex, and an animation
+	scene = new aiScene();
+	scene->mNumMeshes = NUM_MESHES;
+	scene->mMeshes = new aiMesh*[NUM_MESHES];
+
+	scene->mRootNode = new aiNode();
+	scene->mRootNode->mName.Set("root");
+	scene->mRootNode->mNumMeshes = NUM_MESHES;
+	scene->mRootNode->mMeshes = new unsigned int[NUM_MESHES];
+
+	for (unsigned int m = 0; m < NUM_MESHES; ++m) {
+		aiMesh* mesh = scene->mMeshes[m] = new aiMesh();
+		scene->mRootNode->mMeshes[m] = m;
+
+		mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+		mesh->mNumVertices = NUM_FACES*3;
+		mesh->mVertices = new aiVector3D[NUM_FACES*3];
+		mesh->mNumFaces = NUM_FACES;
+		mesh->mFaces = new aiFace[NUM_FACES];
+		for (unsigned int i = 0; i < NUM_FACES; ++i) {
+			aiFace& face = mesh->mFaces[i];
+			face.mNumIndices = 3;
+			face.mIndices = new unsigned int[3];
+			for (unsigned int a = 0; a < 3; ++a) {
+				face.mIndices[a] = i*3+a;
+			}
+		}
+
+		mesh->mNumBones = 1;
+		mesh->mBones = new aiBone*[1];
+		aiBone* bone = mesh->mBones[0] = new aiBone();
+		bone->mName.Set("root");
+		bone->mNumWeights = 1;
+		bone->mWeights = new aiVertexWeight[1];
+		bone->mWeights[0].mVertexId = m;
+		bone->mWeights[0].mWeight = 0.5f;
+	}
+
+	scene->mNumAnimations = 1;
+	scene->mAnimations = new aiAnimation*[1];
+	aiAnimation* anim = scene->mAnimations[0] = new aiAnimation();
+	anim->mDuration = 10.;
+	anim->mNumChannels = 1;
+	anim->mChannels = new aiNodeAnim*[1];
+	aiNodeAnim* chan = anim->mChannels[0] = new aiNodeAnim();
+	chan->mNodeName.Set("root");
+	chan->mNumPositionKeys = 100;
+	chan->mPositionKeys = new aiVectorKey[100];
+	for (unsigned int i = 0; i < 100; ++i) {
+		chan->mPositionKeys[i].mTime = i * 0.1;
+	}
+
+	process = new ValidateDSProcess();
+
+	stream = new WarningStream();
+	DefaultLogger::get()->attachStream(stream,Logger::Warn);
+}
+
+void ValidateDataStructureTest :: tearDown (void)
+{
+	DefaultLogger::get()->detatchStream(stream,Logger::Warn);
+	delete stream;
+	delete process;
+	delete scene;
+}
+
+void  ValidateDataStructureTest :: testFullValidation (void)
+{
+	process->Execute(scene);
+
+	// one warning per mesh for the weight sum, in the order of the meshes
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(NUM_MESHES),stream->warnings.size());
+	for (unsigned int m = 0; m < NUM_MESHES; ++m) {
+		char buffer[64];
+		::sprintf(buffer,"aiMesh::mVertices[%u]",m);
+		CPPUNIT_ASSERT(std::string::npos != stream->warnings[m].find(buffer));
+	}
+}
+
+void  ValidateDataStructureTest :: testParallelValidation (void)
+{
+	process->Execute(scene);
+	const std::vector<std::string> serial = stream->warnings;
+	stream->warnings.clear();
+
+	// the warnings of the worker threads are logged in the same order
+	process->SetThreadCount(4);
+	process->Execute(scene);
+	CPPUNIT_ASSERT(serial == stream->warnings);
+}
+
+void  ValidateDataStructureTest :: testSampledValidation (void)
+{
+	process->SetSampleCount(16);
+	process->SetThreadCount(4);
+	process->Execute(scene);
+
+	// weight sums are not checked if only a few weights are looked at
+	CPPUNIT_ASSERT(stream->warnings.empty());
+	CPPUNIT_ASSERT_EQUAL(16u,process->GetSampleCount());
+}
+
+unsigned int ValidateDataStructureTest :: CountFailures()
+{
+	unsigned int failures = 0;
+	for (unsigned int threads = 1; threads <= 4; threads += 3) {
+		process->SetThreadCount(threads);
+		try {
+			process->Execute(scene);
+		}
+		catch (const DeadlyImportError&) {
+			++failures;
+		}
+	}
+	return failures;
+}
+
+void  ValidateDataStructureTest :: testNullBone (void)
+{
+	// must be reported, not dereferenced while estimating the work per mesh
+	delete scene->mMeshes[3]->mBones[0];
+	scene->mMeshes[3]->mBones[0] = NULL;
+	CPPUNIT_ASSERT_EQUAL(2u,CountFailures());
+}
+
+void  ValidateDataStructureTest :: testNullChannel (void)
+{
+	delete scene->mAnimations[0]->mChannels[0];
+	scene->mAnimations[0]->mChannels[0] = NULL;
+	CPPUNIT_ASSERT_EQUAL(2u,CountFailures());
+}
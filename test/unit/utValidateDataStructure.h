@@ -0,0 +1,55 @@
+#ifndef TESTVDS_H
+#define TESTVDS_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/scene.h>
+#include <assimp/LogStream.hpp>
+#include <ValidateDataStructure.h>
+
+using namespace std;
+using namespace Assimp;
+
+class ValidateDataStructureTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (ValidateDataStructureTest);
+    CPPUNIT_TEST (testFullValidation);
+    CPPUNIT_TEST (testParallelValidation);
+    CPPUNIT_TEST (testSampledValidation);
+    CPPUNIT_TEST (testNullBone);
+    CPPUNIT_TEST (testNullChannel);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testFullValidation (void);
+        void  testParallelValidation (void);
+        void  testSampledValidation (void);
+        void  testNullBone (void);
+        void  testNullChannel (void);
+
+	private:
+
+		// runs the step single- and multithreaded, returns how often it failed
+		unsigned int CountFailures();
+
+		// collects all warnings written to the log
+		struct WarningStream : public LogStream
+		{
+			void write(const char* message) {
+				warnings.push_back(message);
+			}
+			std::vector<std::string> warnings;
+		};
+
+		aiScene* scene;
+		ValidateDSProcess* process;
+		WarningStream* stream;
+};
+
+#endif 
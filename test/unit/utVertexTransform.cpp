@@ -0,0 +1,85 @@
+#include "UnitTestPCH.h"
+#include "utVertexTransform.h"
+
+#include <VertexTransform.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (VertexTransformTest);
+
+// ------------------------------------------------------------------------------------------------
+void VertexTransformTest :: setUp (void)
+{
+	for (unsigned int i = 0; i < NUM; ++i) {
+		vectors[i] = aiVector3D(i * 0.25f - 1.f, 0.1f * i, i % 2 ? -0.f : 2.f - i);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexTransformTest :: tearDown (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexTransformTest :: testScaleComponents (void)
+{
+	aiVector3D expected[NUM];
+	for (unsigned int i = 0; i < NUM; ++i) {
+		expected[i] = vectors[i];
+		expected[i].x *= -1.f;
+		expected[i].z *= 2.f;
+	}
+
+	ScaleComponents(aiVector3D(-1.f,1.f,2.f),vectors,NUM);
+	CPPUNIT_ASSERT(0 == ::memcmp(expected,vectors,sizeof(vectors)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexTransformTest :: testFlipUVCoords (void)
+{
+	aiVector3D expected[NUM];
+	for (unsigned int i = 0; i < NUM; ++i) {
+		expected[i] = vectors[i];
+		expected[i].y = 1.f - expected[i].y;
+	}
+
+	FlipUVCoords(vectors,NUM);
+	CPPUNIT_ASSERT(0 == ::memcmp(expected,vectors,sizeof(vectors)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexTransformTest :: testTransformUVCoords (void)
+{
+	aiMatrix3x3 mat;
+	aiMatrix3x3::RotationZ(0.3f,mat);
+	mat.a3 = 0.5f;
+	mat.b3 = -0.25f;
+	mat.c1 = 0.125f;
+
+	aiVector3D expected[NUM];
+	for (unsigned int i = 0; i < NUM; ++i) {
+		expected[i] = vectors[i];
+		expected[i].z = 1.f;
+		expected[i] = mat * expected[i];
+		expected[i].x /= expected[i].z;
+		expected[i].y /= expected[i].z;
+		expected[i].z = 0.f;
+	}
+
+	TransformUVCoords(mat,vectors,NUM);
+	CPPUNIT_ASSERT(0 == ::memcmp(expected,vectors,sizeof(vectors)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void VertexTransformTest :: testReverseTriangles (void)
+{
+	unsigned int indices[NUM*3];
+	for (unsigned int i = 0; i < NUM*3; ++i) {
+		indices[i] = i;
+	}
+
+	ReverseTriangles(indices,NUM);
+	for (unsigned int i = 0; i < NUM; ++i) {
+		CPPUNIT_ASSERT_EQUAL(i*3+2,indices[i*3]);
+		CPPUNIT_ASSERT_EQUAL(i*3+1,indices[i*3+1]);
+		CPPUNIT_ASSERT_EQUAL(i*3,indices[i*3+2]);
+	}
+}
@@ -0,0 +1,39 @@
+#ifndef TESTVERTEXTRANSFORM_H
+#define TESTVERTEXTRANSFORM_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/scene.h>
+
+using namespace std;
+using namespace Assimp;
+
+class VertexTransformTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (VertexTransformTest);
+    CPPUNIT_TEST (testScaleComponents);
+    CPPUNIT_TEST (testFlipUVCoords);
+    CPPUNIT_TEST (testTransformUVCoords);
+    CPPUNIT_TEST (testReverseTriangles);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testScaleComponents (void);
+        void  testFlipUVCoords (void);
+        void  testTransformUVCoords (void);
+        void  testReverseTriangles (void);
+
+	private:
+
+		// not a multiple of four, so the SSE and the scalar code paths are both taken
+		enum { NUM = 7 };
+		aiVector3D vectors[NUM];
+};
+
+#endif 
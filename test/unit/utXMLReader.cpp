@@ -0,0 +1,151 @@
+#include "UnitTestPCH.h"
+#include "utXMLReader.h"
+
+#include "irrXMLWrapper.h"
+#include "MemoryIOWrapper.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (XMLReaderTest);
+
+using namespace irr::io;
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest :: setUp (void)
+{
+	importer = new Importer();
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest :: tearDown (void)
+{
+	delete importer;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Read a file with IrrXML and with the streaming reader, both must report the same nodes
+void XMLReaderTest :: CompareReaders(const char* file, size_t chunkSize)
+{
+	boost::scoped_ptr<IOStream> a(importer->GetIOHandler()->Open(file,"rb"));
+	boost::scoped_ptr<IOStream> b(importer->GetIOHandler()->Open(file,"rb"));
+	CPPUNIT_ASSERT(NULL != a && NULL != b);
+
+	boost::scoped_ptr<IrrXMLReader> expected;
+	{
+		CIrrXML_IOStreamReader wrapper(a.get());
+		expected.reset(createIrrXMLReader(&wrapper));
+	}
+	CIrrXML_StreamingReader reader(b.get(),chunkSize);
+
+	unsigned int nodes = 0;
+	while (expected->read()) {
+		if (!reader.read()) {
+			// IrrXML reports the closing tag twice if whitespace follows it
+			CPPUNIT_ASSERT(EXN_ELEMENT_END == expected->getNodeType() && !expected->read());
+			break;
+		}
+		CPPUNIT_ASSERT_EQUAL(expected->getNodeType(),reader.getNodeType());
+
+		switch (expected->getNodeType())
+		{
+		case EXN_ELEMENT:
+			CPPUNIT_ASSERT_EQUAL(expected->isEmptyElement(),reader.isEmptyElement());
+			CPPUNIT_ASSERT_EQUAL(expected->getAttributeCount(),reader.getAttributeCount());
+			for (int i = 0; i < expected->getAttributeCount(); ++i) {
+				CPPUNIT_ASSERT_EQUAL(std::string(expected->getAttributeName(i)),std::string(reader.getAttributeName(i)));
+				CPPUNIT_ASSERT_EQUAL(std::string(expected->getAttributeValue(i)),std::string(reader.getAttributeValue(i)));
+			}
+			// fall through
+
+		case EXN_ELEMENT_END:
+			CPPUNIT_ASSERT_EQUAL(std::string(expected->getNodeName()),std::string(reader.getNodeName()));
+			break;
+
+		case EXN_TEXT:
+		case EXN_CDATA:
+			CPPUNIT_ASSERT_EQUAL(std::string(expected->getNodeData()),std::string(reader.getNodeData()));
+			CPPUNIT_ASSERT_EQUAL(strlen(reader.getNodeData()),reader.getNodeDataLength());
+			break;
+
+		default:
+			break;
+		};
+		++nodes;
+	}
+	CPPUNIT_ASSERT(!reader.read());
+	CPPUNIT_ASSERT(nodes > 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+void  XMLReaderTest :: testColladaFiles (void)
+{
+	const char* files[] = {
+		"../../test/models/Collada/duck.dae",
+		"../../test/models/Collada/cube_emptyTags.dae",
+		"../../test/models/Collada/cube_UTF8BOM.dae",
+		"../../test/models/Collada/teapots.DAE",
+		"../../test/models/Collada/kwxport_test_vcolors.dae"
+	};
+	for (unsigned int i = 0; i < sizeof(files)/sizeof(files[0]); ++i) {
+		// a small chunk size makes nodes straddle chunk boundaries
+		CompareReaders(files[i],AI_IRRXML_STREAM_CHUNK_SIZE);
+		CompareReaders(files[i],61);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void  XMLReaderTest :: testOtherFiles (void)
+{
+	// the IRR and IRRMESH test files are UTF-16, see testWideFiles()
+	const char* files[] = {
+		"../../test/models/Collada/AsXML.xml",
+		"../../test/models/XGL/sample_official.xgl",
+		"../../test/models/Ogre/TheThing/Mesh.mesh.xml"
+	};
+	for (unsigned int i = 0; i < sizeof(files)/sizeof(files[0]); ++i) {
+		CompareReaders(files[i],AI_IRRXML_STREAM_CHUNK_SIZE);
+		CompareReaders(files[i],61);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void  XMLReaderTest :: testCharacterReferences (void)
+{
+	// unlike IrrXML, the streaming reader decodes numeric character references
+	static const char xml[] = "<a v=\"&#65;&#x42;&amp;\">x&#67;y&lt;</a>";
+	MemoryIOStream stream(reinterpret_cast<const uint8_t*>(xml),sizeof(xml)-1);
+	CIrrXML_StreamingReader reader(&stream,16);
+
+	CPPUNIT_ASSERT(reader.read() && EXN_ELEMENT == reader.getNodeType());
+	CPPUNIT_ASSERT_EQUAL(std::string("AB&"),std::string(reader.getAttributeValue("v")));
+
+	CPPUNIT_ASSERT(reader.read() && EXN_TEXT == reader.getNodeType());
+	CPPUNIT_ASSERT_EQUAL(std::string("xCy<"),std::string(reader.getNodeData()));
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4),reader.getNodeDataLength());
+
+	CPPUNIT_ASSERT(reader.read() && EXN_ELEMENT_END == reader.getNodeType());
+	CPPUNIT_ASSERT(!reader.read());
+}
+
+// ------------------------------------------------------------------------------------------------
+void  XMLReaderTest :: testWideFiles (void)
+{
+	// UTF-16 input is left to IrrXML, the result must match the UTF-8 version
+	boost::scoped_ptr<IOStream> a(importer->GetIOHandler()->Open("../../test/models/Collada/cube_UTF16LE.dae","rb"));
+	boost::scoped_ptr<IOStream> b(importer->GetIOHandler()->Open("../../test/models/Collada/cube.dae","rb"));
+	CPPUNIT_ASSERT(NULL != a && NULL != b);
+
+	boost::scoped_ptr<IrrXMLReader> wide(CreateIrrXMLReader(a.get()));
+	boost::scoped_ptr<IrrXMLReader> narrow(CreateIrrXMLReader(b.get()));
+	CPPUNIT_ASSERT(NULL == dynamic_cast<CIrrXML_StreamingReader*>(wide.get()));
+	CPPUNIT_ASSERT(NULL != dynamic_cast<CIrrXML_StreamingReader*>(narrow.get()));
+
+	unsigned int elements = 0;
+	while (narrow->read()) {
+		if (EXN_ELEMENT != narrow->getNodeType()) {
+			continue;
+		}
+		while (wide->read() && EXN_ELEMENT != wide->getNodeType());
+		CPPUNIT_ASSERT_EQUAL(std::string(narrow->getNodeName()),std::string(wide->getNodeName()));
+		++elements;
+	}
+	CPPUNIT_ASSERT(elements > 0);
+}
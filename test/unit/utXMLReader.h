@@ -0,0 +1,39 @@
+#ifndef TESTXMLREADER_H
+#define TESTXMLREADER_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+
+using namespace std;
+using namespace Assimp;
+
+class XMLReaderTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (XMLReaderTest);
+    CPPUNIT_TEST (testColladaFiles);
+    CPPUNIT_TEST (testOtherFiles);
+    CPPUNIT_TEST (testCharacterReferences);
+    CPPUNIT_TEST (testWideFiles);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testColladaFiles (void);
+        void  testOtherFiles (void);
+        void  testCharacterReferences (void);
+        void  testWideFiles (void);
+
+	private:
+
+		void CompareReaders(const char* file, size_t chunkSize);
+
+		Importer* importer;
+};
+
+#endif 
@@ -0,0 +1,88 @@
+
+#include "UnitTestPCH.h"
+#include "utZipIOSystem.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ZipIOSystemTest);
+
+void ZipIOSystemTest :: setUp (void)
+{
+	zip = new ZipIOSystem("../../test/models/ZIP/spider.zip");
+}
+
+void ZipIOSystemTest :: tearDown (void)
+{
+	delete zip;
+}
+
+void  ZipIOSystemTest :: testIndex (void)
+{
+	CPPUNIT_ASSERT(zip->IsOpen());
+
+	// directory entries are not listed, files are sorted by name
+	CPPUNIT_ASSERT_EQUAL(2u,zip->GetNumFiles());
+	CPPUNIT_ASSERT(!strcmp(zip->GetFileName(0),"models/spider.mtl"));
+	CPPUNIT_ASSERT(!strcmp(zip->GetFileName(1),"models/spider.obj"));
+	CPPUNIT_ASSERT(NULL == zip->GetFileName(2));
+
+	CPPUNIT_ASSERT(zip->Exists("models/spider.obj"));
+	CPPUNIT_ASSERT(zip->Exists("./models/../models\\spider.mtl"));
+	CPPUNIT_ASSERT(zip->Exists("Models/Spider.OBJ"));
+	CPPUNIT_ASSERT(!zip->Exists("models"));
+	CPPUNIT_ASSERT(!zip->Exists("spider.obj"));
+
+	// archives are read-only
+	CPPUNIT_ASSERT(NULL == zip->Open("models/spider.obj","wb"));
+
+	ZipIOSystem missing("../../test/models/ZIP/missing.zip");
+	CPPUNIT_ASSERT(!missing.IsOpen());
+	CPPUNIT_ASSERT(!missing.Exists("models/spider.obj"));
+}
+
+void  ZipIOSystemTest :: testStreamedRead (void)
+{
+	IOStream* file = zip->Open("models/spider.obj");
+	CPPUNIT_ASSERT(file);
+	std::vector<char> inflated(file->FileSize());
+	CPPUNIT_ASSERT_EQUAL(inflated.size(),file->Read(&inflated[0],1,inflated.size()));
+	zip->Close(file);
+
+	// force decompression while reading, the contents must be the same
+	zip->SetStreamingThreshold(0);
+	file = zip->Open("models/spider.obj");
+	CPPUNIT_ASSERT(file);
+	CPPUNIT_ASSERT_EQUAL(inflated.size(),file->FileSize());
+
+	std::vector<char> streamed(inflated.size());
+	CPPUNIT_ASSERT_EQUAL(streamed.size()/2,file->Read(&streamed[0],2,streamed.size()/2));
+	CPPUNIT_ASSERT(!memcmp(&streamed[0],&inflated[0],streamed.size()/2*2));
+
+	// seeking backwards restarts decompression
+	CPPUNIT_ASSERT_EQUAL(aiReturn_SUCCESS,file->Seek(100,aiOrigin_SET));
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(100),file->Tell());
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(50),file->Read(&streamed[0],1,50));
+	CPPUNIT_ASSERT(!memcmp(&streamed[0],&inflated[100],50));
+
+	CPPUNIT_ASSERT_EQUAL(aiReturn_SUCCESS,file->Seek(10,aiOrigin_END));
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10),file->Read(&streamed[0],1,50));
+	CPPUNIT_ASSERT(!memcmp(&streamed[0],&inflated[inflated.size()-10],10));
+	zip->Close(file);
+}
+
+void  ZipIOSystemTest :: testImport (void)
+{
+	Importer ref;
+	const aiScene* expected = ref.ReadFile("../../test/models/OBJ/spider.obj",0);
+	CPPUNIT_ASSERT(expected);
+
+	// the importer takes ownership of the IOSystem
+	Importer imp;
+	imp.SetIOHandler(zip);
+	zip = NULL;
+
+	const aiScene* sc = imp.ReadFile("models/spider.obj",0);
+	CPPUNIT_ASSERT(sc);
+	CPPUNIT_ASSERT_EQUAL(expected->mNumMeshes,sc->mNumMeshes);
+
+	// the material library is loaded from the archive as well
+	CPPUNIT_ASSERT_EQUAL(expected->mNumMaterials,sc->mNumMaterials);
+}
@@ -0,0 +1,32 @@
+#ifndef INCLUDED_UT_ZIPIOSYSTEM_H
+#define INCLUDED_UT_ZIPIOSYSTEM_H
+
+#include <assimp/ZipIOSystem.hpp>
+#include <assimp/IOStream.hpp>
+
+using namespace Assimp;
+
+class ZipIOSystemTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (ZipIOSystemTest);
+	CPPUNIT_TEST (testIndex);
+	CPPUNIT_TEST (testStreamedRead);
+	CPPUNIT_TEST (testImport);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void  testIndex (void);
+		void  testStreamedRead (void);
+		void  testImport (void);
+
+	private:
+
+		ZipIOSystem* zip;
+};
+
+#endif 
@@ -383,6 +383,7 @@ int ProcessStandardArguments(
 	// -om     --optimize-meshes
 	// -db     --debone
 	// -sbc    --split-by-bone-count
+	// -oa     --optimize-animations
 	//
 	// -c<file> --config-file=<file>
 
@@ -463,6 +464,9 @@ int ProcessStandardArguments(
 		else if (! strcmp(params[i], "-sbc") || ! strcmp(params[i], "--split-by-bone-count")) {
 			fill.ppFlags |= aiProcess_SplitByBoneCount;
 		}
+		else if (! strcmp(params[i], "-oa") || ! strcmp(params[i], "--optimize-animations")) {
+			fill.ppFlags |= aiProcess_OptimizeAnimations;
+		}
 
 
 		else if (! strncmp(params[i], "-c",2) || ! strncmp(params[i], "--config=",9)) {